@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * Timing functions measuring host time.
+ *
+ * The counter is the host monotonic clock in nanoseconds, so it keeps
+ * running while simulated time is stopped.
+ */
+
+#include <stdint.h>
+#include <time.h>
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+
+#define NSEC_PER_SEC_HOST 1000000000ULL
+
+void board_timing_init(void)
+{
+}
+
+void board_timing_start(void)
+{
+}
+
+void board_timing_stop(void)
+{
+}
+
+timing_t board_timing_counter_get(void)
+{
+	struct timespec tv;
+
+#if defined(CLOCK_MONOTONIC_RAW)
+	clock_gettime(CLOCK_MONOTONIC_RAW, &tv);
+#else
+	clock_gettime(CLOCK_MONOTONIC, &tv);
+#endif
+
+	return (uint64_t)tv.tv_sec * NSEC_PER_SEC_HOST + tv.tv_nsec;
+}
+
+uint64_t board_timing_cycles_get(volatile timing_t *const start,
+				 volatile timing_t *const end)
+{
+	return *end - *start;
+}
+
+uint64_t board_timing_freq_get(void)
+{
+	return NSEC_PER_SEC_HOST;
+}
+
+uint64_t board_timing_cycles_to_ns(uint64_t cycles)
+{
+	return cycles;
+}
+
+uint64_t board_timing_cycles_to_ns_avg(uint64_t cycles, uint32_t count)
+{
+	return cycles / count;
+}
+
+uint32_t board_timing_freq_get_mhz(void)
+{
+	return (uint32_t)(NSEC_PER_SEC_HOST / 1000000);
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/drivers/flash.h>
+
+/* Requests of drivers without asynchronous operations. A single work queue
+ * executes them one at a time, in the order of submission.
+ */
+static struct k_work_q flash_async_work_q;
+static K_KERNEL_STACK_DEFINE(flash_async_stack, CONFIG_FLASH_ASYNC_STACK_SIZE);
+
+static void flash_async_work_handler(struct k_work *work)
+{
+	struct flash_async_req *req =
+		CONTAINER_OF(work, struct flash_async_req, work);
+	const struct device *dev = req->dev;
+	int rc;
+
+	switch (req->op) {
+	case FLASH_ASYNC_READ:
+		rc = flash_read(dev, req->offset, req->data, req->len);
+		break;
+	case FLASH_ASYNC_WRITE:
+		rc = flash_write(dev, req->offset, req->data, req->len);
+		break;
+	case FLASH_ASYNC_ERASE:
+		rc = flash_erase(dev, req->offset, req->len);
+		break;
+	default:
+		rc = -ENOTSUP;
+		break;
+	}
+
+	req->cb(dev, req, rc);
+}
+
+int flash_submit(const struct device *dev, struct flash_async_req *req)
+{
+	const struct flash_driver_api *api =
+		(const struct flash_driver_api *)dev->api;
+
+	if ((req->cb == NULL) || (req->op > FLASH_ASYNC_ERASE)) {
+		return -EINVAL;
+	}
+
+	req->dev = dev;
+
+	if (api->submit != NULL) {
+		return api->submit(dev, req);
+	}
+
+	k_work_init(&req->work, flash_async_work_handler);
+
+	return (k_work_submit_to_queue(&flash_async_work_q, &req->work) == 1) ?
+	       0 : -EBUSY;
+}
+
+static int flash_async_init(const struct device *unused)
+{
+	ARG_UNUSED(unused);
+
+	k_work_queue_start(&flash_async_work_q, flash_async_stack,
+			   K_KERNEL_STACK_SIZEOF(flash_async_stack),
+			   CONFIG_FLASH_ASYNC_THREAD_PRIORITY, NULL);
+	k_thread_name_set(&flash_async_work_q.thread, "flash_async");
+
+	return 0;
+}
+
+SYS_INIT(flash_async_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
@@ -159,6 +159,23 @@ static const struct flash_parameters flash_sim_parameters = {
 	.erase_value = FLASH_SIMULATOR_ERASE_VALUE
 };
 
+#ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
+#define FLASH_SIM_READ_TIME_US CONFIG_FLASH_SIMULATOR_MIN_READ_TIME_US
+#define FLASH_SIM_WRITE_TIME_US CONFIG_FLASH_SIMULATOR_MIN_WRITE_TIME_US
+#define FLASH_SIM_ERASE_TIME_US CONFIG_FLASH_SIMULATOR_MIN_ERASE_TIME_US
+#else
+#define FLASH_SIM_READ_TIME_US 0
+#define FLASH_SIM_WRITE_TIME_US 0
+#define FLASH_SIM_ERASE_TIME_US 0
+#endif
+
+static inline void flash_sim_wait(uint32_t time_us)
+{
+	if (time_us > 0) {
+		k_busy_wait(time_us);
+	}
+}
+
 static int flash_range_is_valid(const struct device *dev, off_t offset,
 				size_t len)
 {
@@ -172,9 +189,8 @@ static int flash_range_is_valid(const struct device *dev, off_t offset,
 	return 1;
 }
 
-static int flash_sim_read(const struct device *dev, const off_t offset,
-			  void *data,
-			  const size_t len)
+static int flash_sim_read_op(const struct device *dev, const off_t offset,
+			     void *data, const size_t len)
 {
 	ARG_UNUSED(dev);
 
@@ -195,7 +211,6 @@ static int flash_sim_read(const struct device *dev, const off_t offset,
 	FLASH_SIM_STATS_INCN(flash_sim_stats, bytes_read, len);
 
 #ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
-	k_busy_wait(CONFIG_FLASH_SIMULATOR_MIN_READ_TIME_US);
 	FLASH_SIM_STATS_INCN(flash_sim_stats, flash_read_time_us,
 		   CONFIG_FLASH_SIMULATOR_MIN_READ_TIME_US);
 #endif
@@ -203,8 +218,21 @@ static int flash_sim_read(const struct device *dev, const off_t offset,
 	return 0;
 }
 
-static int flash_sim_write(const struct device *dev, const off_t offset,
-			   const void *data, const size_t len)
+static int flash_sim_read(const struct device *dev, const off_t offset,
+			  void *data,
+			  const size_t len)
+{
+	int rc = flash_sim_read_op(dev, offset, data, len);
+
+	if (rc == 0) {
+		flash_sim_wait(FLASH_SIM_READ_TIME_US);
+	}
+
+	return rc;
+}
+
+static int flash_sim_write_op(const struct device *dev, const off_t offset,
+			      const void *data, const size_t len)
 {
 	uint8_t buf[FLASH_SIMULATOR_PROG_UNIT];
 	ARG_UNUSED(dev);
@@ -269,8 +297,6 @@ static int flash_sim_write(const struct device *dev, const off_t offset,
 	FLASH_SIM_STATS_INCN(flash_sim_stats, bytes_written, len);
 
 #ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
-	/* wait before returning */
-	k_busy_wait(CONFIG_FLASH_SIMULATOR_MIN_WRITE_TIME_US);
 	FLASH_SIM_STATS_INCN(flash_sim_stats, flash_write_time_us,
 		   CONFIG_FLASH_SIMULATOR_MIN_WRITE_TIME_US);
 #endif
@@ -278,6 +304,19 @@ static int flash_sim_write(const struct device *dev, const off_t offset,
 	return 0;
 }
 
+static int flash_sim_write(const struct device *dev, const off_t offset,
+			   const void *data, const size_t len)
+{
+	int rc = flash_sim_write_op(dev, offset, data, len);
+
+	if (rc == 0) {
+		/* wait before returning */
+		flash_sim_wait(FLASH_SIM_WRITE_TIME_US);
+	}
+
+	return rc;
+}
+
 static void unit_erase(const uint32_t unit)
 {
 	const off_t unit_addr = FLASH_SIMULATOR_BASE_OFFSET +
@@ -288,8 +327,8 @@ static void unit_erase(const uint32_t unit)
 	       FLASH_SIMULATOR_ERASE_UNIT);
 }
 
-static int flash_sim_erase(const struct device *dev, const off_t offset,
-			   const size_t len)
+static int flash_sim_erase_op(const struct device *dev, const off_t offset,
+			      const size_t len)
 {
 	ARG_UNUSED(dev);
 
@@ -323,8 +362,6 @@ static int flash_sim_erase(const struct device *dev, const off_t offset,
 	}
 
 #ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
-	/* wait before returning */
-	k_busy_wait(CONFIG_FLASH_SIMULATOR_MIN_ERASE_TIME_US);
 	FLASH_SIM_STATS_INCN(flash_sim_stats, flash_erase_time_us,
 		   CONFIG_FLASH_SIMULATOR_MIN_ERASE_TIME_US);
 #endif
@@ -332,6 +369,117 @@ static int flash_sim_erase(const struct device *dev, const off_t offset,
 	return 0;
 }
 
+static int flash_sim_erase(const struct device *dev, const off_t offset,
+			   const size_t len)
+{
+	int rc = flash_sim_erase_op(dev, offset, len);
+
+	if (rc == 0) {
+		/* wait before returning */
+		flash_sim_wait(FLASH_SIM_ERASE_TIME_US);
+	}
+
+	return rc;
+}
+
+#ifdef CONFIG_FLASH_ASYNC
+/* Asynchronous requests are executed one at a time, in the order of
+ * submission. Each one takes effect and completes once its simulated
+ * duration elapsed, without the caller busy waiting for it. The timer
+ * only hands the request over to the system work queue: the operation
+ * and the completion callback run in thread context.
+ */
+static sys_slist_t flash_sim_queue = SYS_SLIST_STATIC_INIT(&flash_sim_queue);
+static struct k_spinlock flash_sim_queue_lock;
+static void flash_sim_async_expiry(struct k_timer *timer);
+static void flash_sim_async_work_handler(struct k_work *work);
+static K_TIMER_DEFINE(flash_sim_async_timer, flash_sim_async_expiry, NULL);
+static K_WORK_DEFINE(flash_sim_async_work, flash_sim_async_work_handler);
+
+static void flash_sim_async_start(const struct flash_async_req *req)
+{
+	uint32_t time_us;
+
+	switch (req->op) {
+	case FLASH_ASYNC_READ:
+		time_us = FLASH_SIM_READ_TIME_US;
+		break;
+	case FLASH_ASYNC_WRITE:
+		time_us = FLASH_SIM_WRITE_TIME_US;
+		break;
+	default:
+		time_us = FLASH_SIM_ERASE_TIME_US;
+		break;
+	}
+
+	k_timer_start(&flash_sim_async_timer, K_USEC(time_us), K_NO_WAIT);
+}
+
+static void flash_sim_async_expiry(struct k_timer *timer)
+{
+	ARG_UNUSED(timer);
+
+	k_work_submit(&flash_sim_async_work);
+}
+
+static void flash_sim_async_work_handler(struct k_work *work)
+{
+	struct flash_async_req *req, *next;
+	k_spinlock_key_t key;
+	int rc;
+
+	ARG_UNUSED(work);
+
+	key = k_spin_lock(&flash_sim_queue_lock);
+	req = CONTAINER_OF(sys_slist_get(&flash_sim_queue),
+			   struct flash_async_req, node);
+	k_spin_unlock(&flash_sim_queue_lock, key);
+
+	switch (req->op) {
+	case FLASH_ASYNC_READ:
+		rc = flash_sim_read_op(req->dev, req->offset, req->data,
+				       req->len);
+		break;
+	case FLASH_ASYNC_WRITE:
+		rc = flash_sim_write_op(req->dev, req->offset, req->data,
+					req->len);
+		break;
+	default:
+		rc = flash_sim_erase_op(req->dev, req->offset, req->len);
+		break;
+	}
+
+	/* A request submitted by the callback to the empty queue is already
+	 * started, starting it again only restarts its timer.
+	 */
+	req->cb(req->dev, req, rc);
+
+	key = k_spin_lock(&flash_sim_queue_lock);
+	next = SYS_SLIST_PEEK_HEAD_CONTAINER(&flash_sim_queue, next, node);
+	if (next != NULL) {
+		flash_sim_async_start(next);
+	}
+	k_spin_unlock(&flash_sim_queue_lock, key);
+}
+
+static int flash_sim_submit(const struct device *dev,
+			    struct flash_async_req *req)
+{
+	k_spinlock_key_t key;
+
+	ARG_UNUSED(dev);
+
+	key = k_spin_lock(&flash_sim_queue_lock);
+	sys_slist_append(&flash_sim_queue, &req->node);
+	if (sys_slist_peek_head(&flash_sim_queue) == &req->node) {
+		flash_sim_async_start(req);
+	}
+	k_spin_unlock(&flash_sim_queue_lock, key);
+
+	return 0;
+}
+#endif /* CONFIG_FLASH_ASYNC */
+
 #ifdef CONFIG_FLASH_PAGE_LAYOUT
 static const struct flash_pages_layout flash_sim_pages_layout = {
 	.pages_count = FLASH_SIMULATOR_PAGE_COUNT,
@@ -363,6 +511,9 @@ static const struct flash_driver_api flash_sim_api = {
 #ifdef CONFIG_FLASH_PAGE_LAYOUT
 	.page_layout = flash_sim_page_layout,
 #endif
+#ifdef CONFIG_FLASH_ASYNC
+	.submit = flash_sim_submit,
+#endif
 };
 
 #ifdef CONFIG_ARCH_POSIX
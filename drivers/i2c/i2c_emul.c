@@ -98,6 +98,28 @@ static int i2c_emul_transfer(const struct device *dev, struct i2c_msg *msgs, uin
 	return 0;
 }
 
+#ifdef CONFIG_I2C_RTIO
+/* Emulators do not block: transactions are done as soon as submitted */
+static void i2c_emul_iodev_submit(const struct device *dev, const struct rtio_sqe *sqe,
+				  struct rtio *r)
+{
+	const struct i2c_iodev_data *data = sqe->iodev->data;
+	struct i2c_msg msgs[CONFIG_I2C_RTIO_TXN_MAX];
+	int ret;
+
+	ret = i2c_iodev_txn_msgs(r, sqe, msgs, ARRAY_SIZE(msgs));
+	if (ret > 0) {
+		ret = i2c_emul_transfer(dev, msgs, ret, data->spec.addr);
+	}
+
+	if (ret < 0) {
+		rtio_sqe_err(r, sqe, ret);
+	} else {
+		rtio_sqe_ok(r, sqe, 0);
+	}
+}
+#endif /* CONFIG_I2C_RTIO */
+
 /**
  * Set up a new emulator and add it to the list
  *
@@ -136,6 +158,9 @@ static struct i2c_driver_api i2c_emul_api = {
 	.configure = i2c_emul_configure,
 	.get_config = i2c_emul_get_config,
 	.transfer = i2c_emul_transfer,
+#ifdef CONFIG_I2C_RTIO
+	.iodev_submit = i2c_emul_iodev_submit,
+#endif
 };
 
 #define EMUL_LINK_AND_COMMA(node_id)                                                               \
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/drivers/i2c.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/rtio/rtio_blocking.h>
+
+int i2c_iodev_txn_msgs(struct rtio *r, const struct rtio_sqe *sqe,
+		       struct i2c_msg *msgs, size_t max)
+{
+	size_t count = 0;
+	struct i2c_msg *msg;
+
+	for (; sqe != NULL; sqe = rtio_txn_next(r, sqe)) {
+		if (sqe->op == RTIO_OP_NOP) {
+			continue;
+		}
+
+		if (count == max) {
+			return -ENOMEM;
+		}
+
+		msg = &msgs[count];
+		switch (sqe->op) {
+		case RTIO_OP_RX:
+			msg->buf = sqe->buf;
+			msg->len = sqe->buf_len;
+			msg->flags = I2C_MSG_READ;
+			break;
+		case RTIO_OP_TX:
+			msg->buf = sqe->buf;
+			msg->len = sqe->buf_len;
+			msg->flags = I2C_MSG_WRITE;
+			break;
+		case RTIO_OP_TINY_TX:
+			msg->buf = (uint8_t *)sqe->tiny_buf;
+			msg->len = sqe->tiny_buf_len;
+			msg->flags = I2C_MSG_WRITE;
+			break;
+		default:
+			return -ENOTSUP;
+		}
+
+		if (count > 0 &&
+		    (msg->flags & I2C_MSG_RW_MASK) != (msgs[count - 1].flags & I2C_MSG_RW_MASK)) {
+			msg->flags |= I2C_MSG_RESTART;
+		}
+
+		count++;
+	}
+
+	if (count > 0) {
+		msgs[count - 1].flags |= I2C_MSG_STOP;
+	}
+
+	return count;
+}
+
+int z_i2c_iodev_transfer(const struct rtio_sqe *sqe, struct rtio *r)
+{
+	const struct i2c_iodev_data *data = sqe->iodev->data;
+	struct i2c_msg msgs[CONFIG_I2C_RTIO_TXN_MAX];
+	int count;
+
+	count = i2c_iodev_txn_msgs(r, sqe, msgs, ARRAY_SIZE(msgs));
+	if (count <= 0) {
+		return count;
+	}
+
+	return i2c_transfer_dt(&data->spec, msgs, count);
+}
+
+static void i2c_iodev_submit(const struct rtio_sqe *sqe, struct rtio *r)
+{
+	struct i2c_iodev_data *data = sqe->iodev->data;
+	const struct i2c_driver_api *api = data->spec.bus->api;
+
+	if (api->iodev_submit != NULL) {
+		api->iodev_submit(data->spec.bus, sqe, r);
+		return;
+	}
+
+	rtio_blocking_submit(&data->blocking, sqe, r);
+}
+
+const struct rtio_iodev_api i2c_iodev_api = {
+	.submit = i2c_iodev_submit,
+};
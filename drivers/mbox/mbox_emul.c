@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/drivers/mbox.h>
+#include <zephyr/drivers/mbox/mbox_emul.h>
+#include <zephyr/kernel.h>
+
+#define LOG_LEVEL CONFIG_MBOX_LOG_LEVEL
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(mbox_emul);
+
+#define DT_DRV_COMPAT zephyr_mbox_emul
+
+struct mbox_emul_data {
+	struct k_spinlock lock;
+	mbox_callback_t cb[MBOX_EMUL_CHANNELS];
+	void *user_data[MBOX_EMUL_CHANNELS];
+	uint32_t signals[MBOX_EMUL_CHANNELS];
+	uint32_t enabled_mask;
+	uint32_t pending_mask;
+};
+
+static void mbox_emul_deliver(const struct device *dev, uint32_t channel)
+{
+	struct mbox_emul_data *data = dev->data;
+	mbox_callback_t cb;
+	void *user_data;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&data->lock);
+	cb = data->cb[channel];
+	user_data = data->user_data[channel];
+	k_spin_unlock(&data->lock, key);
+
+	if (cb != NULL) {
+		cb(dev, channel, user_data, NULL);
+	}
+}
+
+static int mbox_emul_send(const struct device *dev, uint32_t channel,
+			  const struct mbox_msg *msg)
+{
+	struct mbox_emul_data *data = dev->data;
+	k_spinlock_key_t key;
+	bool enabled;
+
+	if (channel >= MBOX_EMUL_CHANNELS) {
+		return -EINVAL;
+	}
+
+	if (msg != NULL && msg->size > 0) {
+		/* We only support signalling */
+		return -EMSGSIZE;
+	}
+
+	key = k_spin_lock(&data->lock);
+	data->signals[channel]++;
+	enabled = (data->enabled_mask & BIT(channel)) != 0;
+	if (!enabled) {
+		data->pending_mask |= BIT(channel);
+	}
+	k_spin_unlock(&data->lock, key);
+
+	if (enabled) {
+		mbox_emul_deliver(dev, channel);
+	}
+
+	return 0;
+}
+
+static int mbox_emul_register_callback(const struct device *dev, uint32_t channel,
+				       mbox_callback_t cb, void *user_data)
+{
+	struct mbox_emul_data *data = dev->data;
+	k_spinlock_key_t key;
+
+	if (channel >= MBOX_EMUL_CHANNELS) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&data->lock);
+	data->cb[channel] = cb;
+	data->user_data[channel] = user_data;
+	k_spin_unlock(&data->lock, key);
+
+	return 0;
+}
+
+static int mbox_emul_mtu_get(const struct device *dev)
+{
+	/* We only support signalling */
+	return 0;
+}
+
+static uint32_t mbox_emul_max_channels_get(const struct device *dev)
+{
+	return MBOX_EMUL_CHANNELS;
+}
+
+static int mbox_emul_set_enabled(const struct device *dev, uint32_t channel, bool enable)
+{
+	struct mbox_emul_data *data = dev->data;
+	k_spinlock_key_t key;
+	bool pending = false;
+
+	if (channel >= MBOX_EMUL_CHANNELS) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&data->lock);
+
+	if (enable == ((data->enabled_mask & BIT(channel)) != 0)) {
+		k_spin_unlock(&data->lock, key);
+		return -EALREADY;
+	}
+
+	if (enable) {
+		data->enabled_mask |= BIT(channel);
+		pending = (data->pending_mask & BIT(channel)) != 0;
+		data->pending_mask &= ~BIT(channel);
+	} else {
+		data->enabled_mask &= ~BIT(channel);
+	}
+
+	k_spin_unlock(&data->lock, key);
+
+	if (enable && data->cb[channel] == NULL) {
+		LOG_WRN("Enabling channel without a registered callback");
+	}
+
+	/* Signals sent while the channel was disabled are received now */
+	if (pending) {
+		mbox_emul_deliver(dev, channel);
+	}
+
+	return 0;
+}
+
+uint32_t mbox_emul_signals_get(const struct device *dev, uint32_t channel)
+{
+	struct mbox_emul_data *data = dev->data;
+
+	if (channel >= MBOX_EMUL_CHANNELS) {
+		return 0;
+	}
+
+	return data->signals[channel];
+}
+
+static const struct mbox_driver_api mbox_emul_driver_api = {
+	.send = mbox_emul_send,
+	.register_callback = mbox_emul_register_callback,
+	.mtu_get = mbox_emul_mtu_get,
+	.max_channels_get = mbox_emul_max_channels_get,
+	.set_enabled = mbox_emul_set_enabled,
+};
+
+#define MBOX_EMUL_DEFINE(i)							\
+	static struct mbox_emul_data mbox_emul_data_##i;			\
+										\
+	DEVICE_DT_INST_DEFINE(i, NULL, NULL, &mbox_emul_data_##i, NULL,		\
+			      POST_KERNEL, CONFIG_MBOX_INIT_PRIORITY,		\
+			      &mbox_emul_driver_api);
+
+DT_INST_FOREACH_STATUS_OKAY(MBOX_EMUL_DEFINE)
@@ -293,10 +293,18 @@ static int bmi160_acc_odr_set(const struct device *dev, uint16_t freq_int,
 		return -ENOTSUP;
 	}
 
-	return bmi160_reg_field_update(dev, BMI160_REG_ACC_CONF,
-				       BMI160_ACC_CONF_ODR_POS,
-				       BMI160_ACC_CONF_ODR_MASK,
-				       (uint8_t) odr);
+	if (bmi160_reg_field_update(dev, BMI160_REG_ACC_CONF,
+				    BMI160_ACC_CONF_ODR_POS,
+				    BMI160_ACC_CONF_ODR_MASK,
+				    (uint8_t) odr) < 0) {
+		return -EIO;
+	}
+
+#if defined(CONFIG_SENSOR_STREAM) && defined(CONFIG_BMI160_GYRO_PMU_SUSPEND)
+	data->fifo_odr = odr;
+#endif
+
+	return 0;
 }
 #endif
 
@@ -527,6 +535,9 @@ static int bmi160_acc_config(const struct device *dev,
 static int bmi160_gyr_odr_set(const struct device *dev, uint16_t freq_int,
 			      uint16_t freq_milli)
 {
+#ifdef CONFIG_SENSOR_STREAM
+	struct bmi160_data *data = dev->data;
+#endif
 	int odr = bmi160_freq_to_odr_val(freq_int, freq_milli);
 
 	if (odr < 0) {
@@ -537,10 +548,18 @@ static int bmi160_gyr_odr_set(const struct device *dev, uint16_t freq_int,
 		return -ENOTSUP;
 	}
 
-	return bmi160_reg_field_update(dev, BMI160_REG_GYR_CONF,
-				       BMI160_GYR_CONF_ODR_POS,
-				       BMI160_GYR_CONF_ODR_MASK,
-				       (uint8_t) odr);
+	if (bmi160_reg_field_update(dev, BMI160_REG_GYR_CONF,
+				    BMI160_GYR_CONF_ODR_POS,
+				    BMI160_GYR_CONF_ODR_MASK,
+				    (uint8_t) odr) < 0) {
+		return -EIO;
+	}
+
+#ifdef CONFIG_SENSOR_STREAM
+	data->fifo_odr = odr;
+#endif
+
+	return 0;
 }
 #endif
 
@@ -863,6 +882,161 @@ static int bmi160_channel_get(const struct device *dev,
 	return 0;
 }
 
+#ifdef CONFIG_SENSOR_STREAM
+/* Frames are preceded by the scales in effect when they were read */
+struct bmi160_frame_header {
+	struct sensor_frame_header hdr;
+	struct bmi160_scale scale;
+};
+
+static uint32_t bmi160_odr_to_period_ns(uint8_t odr)
+{
+	/* ODRs are powers of 2 around 100Hz */
+	if (odr >= BMI160_ODR_100) {
+		return (10U * NSEC_PER_MSEC) >> (odr - BMI160_ODR_100);
+	}
+
+	return (10U * NSEC_PER_MSEC) << (BMI160_ODR_100 - odr);
+}
+
+static int bmi160_read_frames(const struct device *dev, uint8_t *buf,
+			      uint32_t buf_len)
+{
+	struct bmi160_data *data = dev->data;
+	struct bmi160_frame_header *fh = (struct bmi160_frame_header *)buf;
+	uint8_t *frames = buf + sizeof(*fh);
+	uint16_t fifo_len;
+	uint32_t count, len, chunk, i;
+	uint64_t now, age;
+
+	if (buf_len < sizeof(*fh) + BMI160_SAMPLE_SIZE) {
+		return -ENOMEM;
+	}
+
+	if (bmi160_word_read(dev, BMI160_REG_FIFO_LENGTH0, &fifo_len) < 0) {
+		return -EIO;
+	}
+
+	count = MIN((fifo_len & BMI160_FIFO_LENGTH_MASK) / BMI160_SAMPLE_SIZE,
+		    (buf_len - sizeof(*fh)) / BMI160_SAMPLE_SIZE);
+	len = count * BMI160_SAMPLE_SIZE;
+
+	for (i = 0; i < len; i += chunk) {
+		chunk = MIN(len - i, BMI160_FIFO_READ_MAX);
+		if (bmi160_read(dev, BMI160_REG_FIFO_DATA, &frames[i],
+				chunk) < 0) {
+			return -EIO;
+		}
+	}
+
+	/* the last frame was sampled at most one period ago */
+	now = k_ticks_to_ns_floor64(k_uptime_ticks());
+	fh->hdr.period_ns = bmi160_odr_to_period_ns(data->fifo_odr);
+	age = count > 0 ? (uint64_t)(count - 1) * fh->hdr.period_ns : 0;
+	fh->hdr.timestamp_ns = now > age ? now - age : 0;
+	fh->hdr.frame_count = count;
+	fh->hdr.frame_size = BMI160_SAMPLE_SIZE;
+	fh->hdr.offset = sizeof(*fh);
+	fh->scale = data->scale;
+
+	return sizeof(*fh) + len;
+}
+
+static int bmi160_decode(const uint8_t *buf, enum sensor_channel chan,
+			 uint16_t first, uint16_t count, int32_t *values,
+			 int8_t *shift)
+{
+	const struct bmi160_frame_header *fh =
+		(const struct bmi160_frame_header *)buf;
+	uint16_t scale;
+	uint8_t ofs, axes;
+	uint16_t i, j;
+
+	switch (chan) {
+#if !defined(CONFIG_BMI160_GYRO_PMU_SUSPEND)
+	case SENSOR_CHAN_GYRO_X:
+	case SENSOR_CHAN_GYRO_Y:
+	case SENSOR_CHAN_GYRO_Z:
+	case SENSOR_CHAN_GYRO_XYZ:
+		scale = fh->scale.gyr;
+		ofs = offsetof(union bmi160_sample, gyr);
+		break;
+#endif
+#if !defined(CONFIG_BMI160_ACCEL_PMU_SUSPEND)
+	case SENSOR_CHAN_ACCEL_X:
+	case SENSOR_CHAN_ACCEL_Y:
+	case SENSOR_CHAN_ACCEL_Z:
+	case SENSOR_CHAN_ACCEL_XYZ:
+		scale = fh->scale.acc;
+		ofs = offsetof(union bmi160_sample, acc);
+		break;
+#endif
+	default:
+		return -ENOTSUP;
+	}
+
+	switch (chan) {
+	case SENSOR_CHAN_ACCEL_XYZ:
+	case SENSOR_CHAN_GYRO_XYZ:
+		axes = BMI160_AXES;
+		break;
+	case SENSOR_CHAN_ACCEL_Y:
+	case SENSOR_CHAN_GYRO_Y:
+		ofs += sizeof(uint16_t);
+		axes = 1U;
+		break;
+	case SENSOR_CHAN_ACCEL_Z:
+	case SENSOR_CHAN_GYRO_Z:
+		ofs += 2 * sizeof(uint16_t);
+		axes = 1U;
+		break;
+	default:
+		axes = 1U;
+		break;
+	}
+
+	if (first >= fh->hdr.frame_count) {
+		return 0;
+	}
+
+	count = MIN(count, fh->hdr.frame_count - first);
+
+	/*
+	 * Full scale is below 256 for every range (16g is 157 m/s^2), so a
+	 * shift of 8 keeps a resolution finer than the micro units of the
+	 * scale: q31 = raw * scale * 2^23 / 10^6.
+	 */
+	*shift = 8;
+
+	for (i = 0; i < count; i++) {
+		const uint8_t *frame = sensor_frame_get(buf, first + i);
+
+		for (j = 0; j < axes; j++) {
+			int16_t raw = sys_get_le16(&frame[ofs + j * 2]);
+			int64_t micro = (int64_t)raw * scale;
+
+			*values++ = (int32_t)(micro * (INT64_C(1) << 23) / 1000000);
+		}
+	}
+
+	return count;
+}
+
+static const struct sensor_decoder_api bmi160_decoder = {
+	.decode = bmi160_decode,
+};
+
+static int bmi160_get_decoder(const struct device *dev,
+			      const struct sensor_decoder_api **decoder)
+{
+	ARG_UNUSED(dev);
+
+	*decoder = &bmi160_decoder;
+
+	return 0;
+}
+#endif /* CONFIG_SENSOR_STREAM */
+
 static const struct sensor_driver_api bmi160_api = {
 	.attr_set = bmi160_attr_set,
 #ifdef CONFIG_BMI160_TRIGGER
@@ -870,6 +1044,10 @@ static const struct sensor_driver_api bmi160_api = {
 #endif
 	.sample_fetch = bmi160_sample_fetch,
 	.channel_get = bmi160_channel_get,
+#ifdef CONFIG_SENSOR_STREAM
+	.read_frames = bmi160_read_frames,
+	.get_decoder = bmi160_get_decoder,
+#endif
 };
 
 int bmi160_init(const struct device *dev)
@@ -965,6 +1143,19 @@ int bmi160_init(const struct device *dev)
 		return -EIO;
 	}
 
+#ifdef CONFIG_SENSOR_STREAM
+	data->fifo_odr = BMI160_DEFAULT_ODR_FIFO;
+
+	/* headerless mode, frames have the layout of a sample */
+	if (bmi160_byte_write(dev, BMI160_REG_FIFO_CONFIG1,
+			      BMI160_FIFO_CONFIG) < 0 ||
+	    bmi160_byte_write(dev, BMI160_REG_CMD,
+			      BMI160_CMD_FIFO_FLUSH) < 0) {
+		LOG_DBG("Cannot set up FIFO.");
+		return -EIO;
+	}
+#endif
+
 #ifdef CONFIG_BMI160_TRIGGER
 	if (bmi160_trigger_mode_init(dev) < 0) {
 		LOG_DBG("Cannot set up trigger mode.");
@@ -208,6 +208,7 @@
 #define BMI160_CMD_PMU_ACC		0x10
 #define BMI160_CMD_PMU_GYR		0x14
 #define BMI160_CMD_PMU_MAG		0x18
+#define BMI160_CMD_FIFO_FLUSH		0xB0
 #define BMI160_CMD_SOFT_RESET		0xB6
 
 #define BMI160_CMD_PMU_BIT		0x10
@@ -215,6 +216,15 @@
 #define BMI160_CMD_PMU_SHIFT		2
 #define BMI160_CMD_PMU_VAL_MASK		0x3
 
+/* BMI160_REG_FIFO_LENGTH0 */
+#define BMI160_FIFO_LENGTH_MASK		0x7FF
+
+/* BMI160_REG_FIFO_CONFIG1 */
+#define BMI160_FIFO_GYR_EN		BIT(7)
+#define BMI160_FIFO_ACC_EN		BIT(6)
+#define BMI160_FIFO_MAG_EN		BIT(5)
+#define BMI160_FIFO_HEADER_EN		BIT(4)
+
 /* BMI160_REG_FOC_CONF */
 #define BMI160_FOC_ACC_Z_POS		0
 #define BMI160_FOC_ACC_Y_POS		2
@@ -464,6 +474,26 @@ union bmi160_pmu_status {
 
 #define BMI160_BUF_SIZE			(BMI160_SAMPLE_SIZE)
 
+/*
+ * Headerless FIFO frames have the same layout as a sample. The FIFO length
+ * register only has 11 bits, and bus reads are limited to 255 bytes, so the
+ * FIFO is drained in chunks of whole frames.
+ */
+#if defined(CONFIG_BMI160_GYRO_PMU_SUSPEND)
+#	define BMI160_FIFO_CONFIG	BMI160_FIFO_ACC_EN
+#	define BMI160_DEFAULT_ODR_FIFO	BMI160_DEFAULT_ODR_ACC
+#elif defined(CONFIG_BMI160_ACCEL_PMU_SUSPEND)
+#	define BMI160_FIFO_CONFIG	BMI160_FIFO_GYR_EN
+#	define BMI160_DEFAULT_ODR_FIFO	BMI160_DEFAULT_ODR_GYR
+#else
+#	define BMI160_FIFO_CONFIG	(BMI160_FIFO_GYR_EN | BMI160_FIFO_ACC_EN)
+#	define BMI160_DEFAULT_ODR_FIFO	BMI160_DEFAULT_ODR_GYR
+#endif
+
+#define BMI160_FIFO_SIZE		1024
+#define BMI160_FIFO_READ_MAX		((UINT8_MAX / BMI160_SAMPLE_SIZE) * \
+					 BMI160_SAMPLE_SIZE)
+
 /* Each sample has X, Y and Z */
 union bmi160_sample {
 	uint8_t raw[BMI160_BUF_SIZE];
@@ -492,6 +522,10 @@ struct bmi160_data {
 	union bmi160_pmu_status pmu_sts;
 	union bmi160_sample sample;
 	struct bmi160_scale scale;
+#ifdef CONFIG_SENSOR_STREAM
+	/* ODR the FIFO is filled at, see BMI160_DEFAULT_ODR_FIFO */
+	uint8_t fifo_odr;
+#endif
 
 #ifdef CONFIG_BMI160_TRIGGER_OWN_THREAD
 	struct k_sem sem;
@@ -57,3 +57,25 @@ static inline int z_vrfy_sensor_channel_get(const struct device *dev,
 					 (struct sensor_value *)val);
 }
 #include <syscalls/sensor_channel_get_mrsh.c>
+
+#ifdef CONFIG_SENSOR_STREAM
+static inline int z_vrfy_sensor_read_frames(const struct device *dev,
+					    uint8_t *buf, uint32_t buf_len)
+{
+	Z_OOPS(Z_SYSCALL_DRIVER_SENSOR(dev, read_frames));
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(buf, buf_len));
+	return z_impl_sensor_read_frames((const struct device *)dev,
+					 (uint8_t *)buf, buf_len);
+}
+#include <syscalls/sensor_read_frames_mrsh.c>
+
+static inline int z_vrfy_sensor_get_decoder(const struct device *dev,
+					    const struct sensor_decoder_api **decoder)
+{
+	Z_OOPS(Z_SYSCALL_DRIVER_SENSOR(dev, get_decoder));
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(decoder, sizeof(*decoder)));
+	return z_impl_sensor_get_decoder((const struct device *)dev,
+					 (const struct sensor_decoder_api **)decoder);
+}
+#include <syscalls/sensor_get_decoder_mrsh.c>
+#endif /* CONFIG_SENSOR_STREAM */
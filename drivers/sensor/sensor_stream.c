@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/rtio/rtio_blocking.h>
+
+int z_sensor_stream_iodev_read(const struct rtio_sqe *sqe, struct rtio *r)
+{
+	const struct sensor_stream_iodev_data *data = sqe->iodev->data;
+
+	ARG_UNUSED(r);
+
+	if (sqe->op != RTIO_OP_RX) {
+		return -ENOTSUP;
+	}
+
+	return sensor_read_frames(data->dev, sqe->buf, sqe->buf_len);
+}
+
+static void sensor_stream_iodev_submit(const struct rtio_sqe *sqe, struct rtio *r)
+{
+	struct sensor_stream_iodev_data *data = sqe->iodev->data;
+
+	rtio_blocking_submit(&data->blocking, sqe, r);
+}
+
+const struct rtio_iodev_api sensor_stream_iodev_api = {
+	.submit = sensor_stream_iodev_submit,
+};
@@ -81,6 +81,32 @@ static int spi_emul_io(const struct device *dev, const struct spi_config *config
 	return api->io(emul->target, config, tx_bufs, rx_bufs);
 }
 
+#ifdef CONFIG_SPI_RTIO
+/* Emulators do not block: transactions are done as soon as submitted */
+static void spi_emul_iodev_submit(const struct device *dev, const struct rtio_sqe *sqe,
+				  struct rtio *r)
+{
+	const struct spi_iodev_data *data = sqe->iodev->data;
+	struct spi_buf tx[CONFIG_SPI_RTIO_TXN_MAX];
+	struct spi_buf rx[CONFIG_SPI_RTIO_TXN_MAX];
+	int ret;
+
+	ret = spi_iodev_txn_bufs(r, sqe, tx, rx, ARRAY_SIZE(tx));
+	if (ret > 0) {
+		const struct spi_buf_set tx_set = { .buffers = tx, .count = ret };
+		const struct spi_buf_set rx_set = { .buffers = rx, .count = ret };
+
+		ret = spi_emul_io(dev, &data->spec.config, &tx_set, &rx_set);
+	}
+
+	if (ret < 0) {
+		rtio_sqe_err(r, sqe, ret);
+	} else {
+		rtio_sqe_ok(r, sqe, 0);
+	}
+}
+#endif /* CONFIG_SPI_RTIO */
+
 /**
  * Set up a new emulator and add it to the list
  *
@@ -111,6 +137,9 @@ int spi_emul_register(const struct device *dev, struct spi_emul *emul)
 
 static struct spi_driver_api spi_emul_api = {
 	.transceive = spi_emul_io,
+#ifdef CONFIG_SPI_RTIO
+	.iodev_submit = spi_emul_iodev_submit,
+#endif
 };
 
 #define EMUL_LINK_AND_COMMA(node_id)                                                               \
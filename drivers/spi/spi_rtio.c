@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/drivers/spi.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/rtio/rtio_blocking.h>
+
+int spi_iodev_txn_bufs(struct rtio *r, const struct rtio_sqe *sqe,
+		       struct spi_buf *tx_bufs, struct spi_buf *rx_bufs, size_t max)
+{
+	size_t count = 0;
+
+	for (; sqe != NULL; sqe = rtio_txn_next(r, sqe)) {
+		struct spi_buf *tx, *rx;
+
+		if (sqe->op == RTIO_OP_NOP) {
+			continue;
+		}
+
+		if (count == max) {
+			return -ENOMEM;
+		}
+
+		tx = &tx_bufs[count];
+		rx = &rx_bufs[count];
+
+		switch (sqe->op) {
+		case RTIO_OP_RX:
+			tx->buf = NULL;
+			rx->buf = sqe->buf;
+			tx->len = rx->len = sqe->buf_len;
+			break;
+		case RTIO_OP_TX:
+			tx->buf = sqe->buf;
+			rx->buf = NULL;
+			tx->len = rx->len = sqe->buf_len;
+			break;
+		case RTIO_OP_TINY_TX:
+			tx->buf = (uint8_t *)sqe->tiny_buf;
+			rx->buf = NULL;
+			tx->len = rx->len = sqe->tiny_buf_len;
+			break;
+		case RTIO_OP_TXRX:
+			tx->buf = sqe->tx_buf;
+			rx->buf = sqe->rx_buf;
+			tx->len = rx->len = sqe->txrx_buf_len;
+			break;
+		default:
+			return -ENOTSUP;
+		}
+
+		count++;
+	}
+
+	return count;
+}
+
+int z_spi_iodev_transceive(const struct rtio_sqe *sqe, struct rtio *r)
+{
+	const struct spi_iodev_data *data = sqe->iodev->data;
+	struct spi_buf tx[CONFIG_SPI_RTIO_TXN_MAX];
+	struct spi_buf rx[CONFIG_SPI_RTIO_TXN_MAX];
+	int count;
+
+	count = spi_iodev_txn_bufs(r, sqe, tx, rx, ARRAY_SIZE(tx));
+	if (count <= 0) {
+		return count;
+	}
+
+	const struct spi_buf_set tx_set = { .buffers = tx, .count = count };
+	const struct spi_buf_set rx_set = { .buffers = rx, .count = count };
+
+	return spi_transceive_dt(&data->spec, &tx_set, &rx_set);
+}
+
+static void spi_iodev_submit(const struct rtio_sqe *sqe, struct rtio *r)
+{
+	struct spi_iodev_data *data = sqe->iodev->data;
+	const struct spi_driver_api *api = data->spec.bus->api;
+
+	if (api->iodev_submit != NULL) {
+		api->iodev_submit(data->spec.bus, sqe, r);
+		return;
+	}
+
+	rtio_blocking_submit(&data->blocking, sqe, r);
+}
+
+const struct rtio_iodev_api spi_iodev_api = {
+	.submit = spi_iodev_submit,
+};
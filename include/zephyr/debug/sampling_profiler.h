@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_DEBUG_SAMPLING_PROFILER_H_
+#define ZEPHYR_INCLUDE_DEBUG_SAMPLING_PROFILER_H_
+
+#include <zephyr/kernel.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @defgroup sampling_profiler Sampling profiler
+ *  @brief Statistical CPU profiler driven by the system timer
+ *
+ *  The profiler periodically samples the program counter of the code
+ *  interrupted by the system timer and aggregates samples into a hashed
+ *  histogram keyed by thread and call stack.
+ *  @{
+ */
+
+/** Maximum length of the thread name stored with every record. */
+#define SAMPLING_PROFILER_NAME_LEN 16
+
+/** Magic number at the start of an exported binary histogram ("ZSPF"). */
+#define SAMPLING_PROFILER_EXPORT_MAGIC 0x4650535aU
+
+/** Version of the exported binary histogram format. */
+#define SAMPLING_PROFILER_EXPORT_VERSION 1
+
+/** @brief Aggregated histogram entry */
+struct sampling_profiler_record {
+	/** Thread that was interrupted, NULL if unknown. */
+	const struct k_thread *thread;
+	/** Name of the thread at the time of the first sample. */
+	char name[SAMPLING_PROFILER_NAME_LEN];
+	/** Number of samples hitting this thread and call stack. */
+	uint32_t count;
+	/** Number of valid entries in @a frames. */
+	uint8_t depth;
+	/** Sampled call stack, innermost frame (the PC) first. */
+	uintptr_t frames[CONFIG_SAMPLING_PROFILER_MAX_FRAMES];
+};
+
+/** @brief Profiler statistics */
+struct sampling_profiler_stats {
+	/** Total number of samples taken. */
+	uint32_t samples;
+	/** Samples lost because the histogram was full. */
+	uint32_t dropped;
+	/** Number of histogram records in use. */
+	uint32_t records;
+};
+
+/** @brief Header of an exported binary histogram
+ *
+ * The header is followed by @a records entries, each made of a
+ * @a frame_size bytes thread identifier, a SAMPLING_PROFILER_NAME_LEN
+ * bytes thread name, a 32-bit count, a 32-bit depth and
+ * @a max_frames frames of @a frame_size bytes each. All fields are in
+ * target byte order.
+ */
+struct sampling_profiler_export_hdr {
+	uint32_t magic;
+	uint8_t version;
+	uint8_t frame_size;
+	uint8_t max_frames;
+	uint8_t reserved;
+	uint32_t records;
+	uint32_t samples;
+	uint32_t dropped;
+};
+
+/** @brief Callback used to walk the histogram
+ *
+ * @param record Histogram record.
+ * @param user_data User data passed to sampling_profiler_foreach().
+ */
+typedef void (*sampling_profiler_cb_t)(const struct sampling_profiler_record *record,
+				       void *user_data);
+
+/** @brief Start sampling
+ *
+ * @param frequency Sampling frequency in Hz, 0 to use
+ *		    CONFIG_SAMPLING_PROFILER_FREQUENCY. The effective rate is
+ *		    limited by the system tick rate.
+ *
+ * @retval 0 on success.
+ * @retval -EALREADY if the profiler is already running.
+ * @retval -EINVAL if the frequency cannot be honored.
+ */
+int sampling_profiler_start(uint32_t frequency);
+
+/** @brief Stop sampling
+ *
+ * The collected histogram is kept until sampling_profiler_reset() is called.
+ */
+void sampling_profiler_stop(void);
+
+/** @brief Check if the profiler is sampling */
+bool sampling_profiler_is_running(void);
+
+/** @brief Clear the histogram and the statistics */
+void sampling_profiler_reset(void);
+
+/** @brief Add one sample to the histogram
+ *
+ * Called by the timer based sampler. It may also be called from any
+ * other interrupt source (e.g. a hardware counter) or by architectures
+ * which can unwind the interrupted context by themselves. Safe to call
+ * from ISR context.
+ *
+ * @param thread Interrupted thread.
+ * @param frames Call stack, innermost frame first. May be NULL if
+ *		 @a depth is 0.
+ * @param depth Number of frames, truncated to
+ *		CONFIG_SAMPLING_PROFILER_MAX_FRAMES.
+ */
+void sampling_profiler_record(const struct k_thread *thread,
+			      const uintptr_t *frames, size_t depth);
+
+/** @brief Walk the histogram
+ *
+ * The callback is invoked with interrupts unlocked on a snapshot of
+ * each record.
+ *
+ * @param cb Callback called for every record in use.
+ * @param user_data User data passed to the callback.
+ */
+void sampling_profiler_foreach(sampling_profiler_cb_t cb, void *user_data);
+
+/** @brief Get profiler statistics
+ *
+ * @param stats Statistics output.
+ */
+void sampling_profiler_stats_get(struct sampling_profiler_stats *stats);
+
+/** @brief Export the histogram in binary form
+ *
+ * The output can be stored in a file or retrieved with a debugger and
+ * converted to folded stacks with scripts/profiling/sampling_profiler.py.
+ *
+ * @param buf Output buffer.
+ * @param len Size of the output buffer.
+ *
+ * @return Number of bytes written on success.
+ * @retval -ENOMEM if the buffer cannot hold the header and all records.
+ */
+int sampling_profiler_export(uint8_t *buf, size_t len);
+
+/** @brief Size of the buffer needed by sampling_profiler_export() */
+size_t sampling_profiler_export_size(void);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_DEBUG_SAMPLING_PROFILER_H_ */
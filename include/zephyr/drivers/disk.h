@@ -63,6 +63,24 @@ extern "C" {
 
 struct disk_operations;
 
+/**
+ * @brief Disk block cache statistics
+ */
+struct disk_cache_stats {
+	/** Sectors read from the cache */
+	uint32_t hits;
+	/** Sectors read from the disk */
+	uint32_t misses;
+	/** Read-ahead disk reads */
+	uint32_t read_ahead;
+	/** Sector writes kept in the cache */
+	uint32_t writes_deferred;
+	/** Cached sectors written back to the disk */
+	uint32_t write_backs;
+	/** Cached sectors evicted to cache other ones */
+	uint32_t evictions;
+};
+
 /**
  * @brief Disk info
  */
@@ -75,6 +93,16 @@ struct disk_info {
 	const struct disk_operations *ops;
 	/** Device associated to this disk */
 	const struct device *dev;
+#if defined(CONFIG_DISK_CACHE)
+	/** @cond INTERNAL_HIDDEN */
+	/* Sector size and count, 0 until known */
+	uint32_t cache_sector_size;
+	uint32_t cache_sector_count;
+	/* Sector following the last one read, to detect sequential reads */
+	uint32_t cache_next_sector;
+	struct disk_cache_stats cache_stats;
+	/** @endcond */
+#endif
 };
 
 /**
@@ -26,6 +26,9 @@
 #include <stddef.h>
 #include <sys/types.h>
 #include <zephyr/device.h>
+#ifdef CONFIG_FLASH_ASYNC
+#include <zephyr/kernel.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -63,6 +66,68 @@ struct flash_parameters {
  * @}
  */
 
+#if defined(CONFIG_FLASH_ASYNC) || defined(__DOXYGEN__)
+/**
+ * @addtogroup flash_interface
+ * @{
+ */
+
+/** Operation of an asynchronous flash request */
+enum flash_async_op {
+	FLASH_ASYNC_READ,
+	FLASH_ASYNC_WRITE,
+	FLASH_ASYNC_ERASE,
+};
+
+struct flash_async_req;
+
+/**
+ * @brief Completion callback of an asynchronous flash request
+ *
+ * The callback may be called from an interrupt or from a thread of the
+ * flash subsystem; it must not block. The request may be submitted again
+ * from the callback.
+ *
+ * @param dev Flash device
+ * @param req Completed request
+ * @param result 0 on success, negative errno code on fail
+ */
+typedef void (*flash_async_cb_t)(const struct device *dev,
+				 struct flash_async_req *req, int result);
+
+/**
+ * @brief Asynchronous flash request
+ *
+ * The request and the buffer it points to belong to the flash device from
+ * submission until the callback is called.
+ */
+struct flash_async_req {
+	/** @cond INTERNAL_HIDDEN */
+	union {
+		struct k_work work;
+		sys_snode_t node;
+	};
+	const struct device *dev;
+	/** @endcond */
+	/** Operation to perform */
+	enum flash_async_op op;
+	/** Offset in the flash device */
+	off_t offset;
+	/** Buffer to read to or to write from, unused by an erase */
+	void *data;
+	/** Number of bytes to read, write or erase */
+	size_t len;
+	/** Completion callback */
+	flash_async_cb_t cb;
+	/** User data, not used by the flash device */
+	void *user_data;
+};
+
+/**
+ * @}
+ */
+#endif /* CONFIG_FLASH_ASYNC */
+
 /**
  * @addtogroup flash_internal_interface
  * @{
@@ -126,6 +191,15 @@ typedef int (*flash_api_sfdp_read)(const struct device *dev, off_t offset,
 				   void *data, size_t len);
 typedef int (*flash_api_read_jedec_id)(const struct device *dev, uint8_t *id);
 
+#if defined(CONFIG_FLASH_ASYNC)
+/**
+ * Queue an asynchronous request. Requests submitted to a device must
+ * complete in the order of submission.
+ */
+typedef int (*flash_api_submit)(const struct device *dev,
+				struct flash_async_req *req);
+#endif /* CONFIG_FLASH_ASYNC */
+
 __subsystem struct flash_driver_api {
 	flash_api_read read;
 	flash_api_write write;
@@ -138,6 +212,9 @@ __subsystem struct flash_driver_api {
 	flash_api_sfdp_read sfdp_read;
 	flash_api_read_jedec_id read_jedec_id;
 #endif /* CONFIG_FLASH_JESD216_API */
+#if defined(CONFIG_FLASH_ASYNC)
+	flash_api_submit submit;
+#endif /* CONFIG_FLASH_ASYNC */
 };
 
 /**
@@ -422,6 +499,109 @@ static inline const struct flash_parameters *z_impl_flash_get_parameters(const s
 	return api->get_parameters(dev);
 }
 
+#if defined(CONFIG_FLASH_ASYNC) || defined(__DOXYGEN__)
+/**
+ *  @brief  Submit an asynchronous flash request
+ *
+ *  The request is executed by the driver if it supports asynchronous
+ *  operations, otherwise by a work queue calling flash_read(),
+ *  flash_write() or flash_erase(). Requests submitted to a device complete
+ *  in the order of submission, so that a write submitted after an erase
+ *  sees the erased area. The same alignment rules as for the synchronous
+ *  operations apply.
+ *
+ *  @param  dev             : flash device
+ *  @param  req             : request, with op, offset, data, len and cb set
+ *
+ *  @return  0 if the request is queued, negative errno code on fail, in
+ *           which case the callback is not called.
+ */
+int flash_submit(const struct device *dev, struct flash_async_req *req);
+
+/**
+ *  @brief  Read data from flash asynchronously
+ *
+ *  @param  dev             : flash device
+ *  @param  req             : request to use
+ *  @param  offset          : Offset (byte aligned) to read
+ *  @param  data            : Buffer to store read data
+ *  @param  len             : Number of bytes to read.
+ *  @param  cb              : Completion callback
+ *
+ *  @return  0 if the request is queued, negative errno code on fail.
+ *
+ *  @see flash_submit()
+ */
+static inline int flash_read_async(const struct device *dev,
+				   struct flash_async_req *req, off_t offset,
+				   void *data, size_t len, flash_async_cb_t cb)
+{
+	req->op = FLASH_ASYNC_READ;
+	req->offset = offset;
+	req->data = data;
+	req->len = len;
+	req->cb = cb;
+
+	return flash_submit(dev, req);
+}
+
+/**
+ *  @brief  Write buffer into flash memory asynchronously
+ *
+ *  The buffer must not be modified until the callback is called.
+ *
+ *  @param  dev             : flash device
+ *  @param  req             : request to use
+ *  @param  offset          : starting offset for the write
+ *  @param  data            : data to write
+ *  @param  len             : Number of bytes to write
+ *  @param  cb              : Completion callback
+ *
+ *  @return  0 if the request is queued, negative errno code on fail.
+ *
+ *  @see flash_submit()
+ */
+static inline int flash_write_async(const struct device *dev,
+				    struct flash_async_req *req, off_t offset,
+				    const void *data, size_t len,
+				    flash_async_cb_t cb)
+{
+	req->op = FLASH_ASYNC_WRITE;
+	req->offset = offset;
+	req->data = (void *)data;
+	req->len = len;
+	req->cb = cb;
+
+	return flash_submit(dev, req);
+}
+
+/**
+ *  @brief  Erase part or all of a flash memory asynchronously
+ *
+ *  @param  dev             : flash device
+ *  @param  req             : request to use
+ *  @param  offset          : erase area starting offset
+ *  @param  size            : size of area to be erased
+ *  @param  cb              : Completion callback
+ *
+ *  @return  0 if the request is queued, negative errno code on fail.
+ *
+ *  @see flash_submit()
+ */
+static inline int flash_erase_async(const struct device *dev,
+				    struct flash_async_req *req, off_t offset,
+				    size_t size, flash_async_cb_t cb)
+{
+	req->op = FLASH_ASYNC_ERASE;
+	req->offset = offset;
+	req->data = NULL;
+	req->len = size;
+	req->cb = cb;
+
+	return flash_submit(dev, req);
+}
+#endif /* CONFIG_FLASH_ASYNC */
+
 #ifdef __cplusplus
 }
 #endif
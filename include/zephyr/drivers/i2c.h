@@ -25,6 +25,10 @@
 #include <zephyr/device.h>
 #include <zephyr/kernel.h>
 #include <zephyr/sys/slist.h>
+#ifdef CONFIG_I2C_RTIO
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/rtio/rtio_blocking.h>
+#endif /* CONFIG_I2C_RTIO */
 
 #ifdef __cplusplus
 extern "C" {
@@ -230,6 +234,11 @@ typedef int (*i2c_api_transfer_cb_t)(const struct device *dev,
 				 void *userdata);
 #endif /* CONFIG_I2C_CALLBACK */
 typedef int (*i2c_api_recover_bus_t)(const struct device *dev);
+#ifdef CONFIG_I2C_RTIO
+typedef void (*i2c_api_iodev_submit_t)(const struct device *dev,
+				       const struct rtio_sqe *sqe,
+				       struct rtio *r);
+#endif /* CONFIG_I2C_RTIO */
 
 __subsystem struct i2c_driver_api {
 	i2c_api_configure_t configure;
@@ -239,6 +248,9 @@ __subsystem struct i2c_driver_api {
 	i2c_api_target_unregister_t target_unregister;
 #ifdef CONFIG_I2C_CALLBACK
 	i2c_api_transfer_cb_t transfer_cb;
+#endif
+#ifdef CONFIG_I2C_RTIO
+	i2c_api_iodev_submit_t iodev_submit;
 #endif
 	i2c_api_recover_bus_t recover_bus;
 };
@@ -755,6 +767,67 @@ static inline int i2c_transfer_dt(const struct i2c_dt_spec *spec,
 	return i2c_transfer(spec->bus, msgs, num_msgs, spec->addr);
 }
 
+#if defined(CONFIG_I2C_RTIO) || defined(__DOXYGEN__)
+
+/**
+ * @brief Data of an I2C iodev
+ *
+ * Each transaction submitted to the iodev is an I2C transfer, ended with
+ * a stop condition. A transaction is a single request, or requests linked
+ * with RTIO_SQE_TRANSACTION, of the RTIO_OP_TX, RTIO_OP_TINY_TX and
+ * RTIO_OP_RX operations, each one being a message. A restart condition is
+ * generated when the direction changes.
+ *
+ * Drivers without an iodev_submit function do the transactions with
+ * i2c_transfer(), through a blocking adapter.
+ */
+struct i2c_iodev_data {
+	/** I2C bus and address */
+	struct i2c_dt_spec spec;
+
+	/** Adapter for drivers without native RTIO support */
+	struct rtio_blocking blocking;
+};
+
+/** @cond INTERNAL_HIDDEN */
+extern const struct rtio_iodev_api i2c_iodev_api;
+
+int z_i2c_iodev_transfer(const struct rtio_sqe *sqe, struct rtio *r);
+/** @endcond */
+
+/**
+ * @brief Define an iodev for an I2C device from devicetree
+ *
+ * @param name Name of the iodev
+ * @param node_id Devicetree node identifier of the I2C device
+ */
+#define I2C_DT_IODEV_DEFINE(name, node_id)                                                         \
+	static struct i2c_iodev_data _i2c_iodev_data_##name = {                                    \
+		.spec = I2C_DT_SPEC_GET(node_id),                                                  \
+		.blocking = RTIO_BLOCKING_INITIALIZER(z_i2c_iodev_transfer),                       \
+	};                                                                                         \
+	RTIO_IODEV_DEFINE(name, &i2c_iodev_api, CONFIG_I2C_RTIO_SQ_SIZE,                           \
+			  &_i2c_iodev_data_##name)
+
+/**
+ * @brief Get the messages of an I2C transaction
+ *
+ * For drivers implementing iodev_submit.
+ *
+ * @param r RTIO context
+ * @param sqe First request of the transaction
+ * @param msgs Filled with the messages, one per request
+ * @param max Number of entries in @p msgs
+ *
+ * @return Number of messages, 0 if the transaction has nothing to transfer
+ * @retval -ENOMEM if the transaction has more than @p max requests
+ * @retval -ENOTSUP if a request is not a read or a write
+ */
+int i2c_iodev_txn_msgs(struct rtio *r, const struct rtio_sqe *sqe,
+		       struct i2c_msg *msgs, size_t max);
+
+#endif /* CONFIG_I2C_RTIO */
+
 /**
  * @brief Recover the I2C bus
  *
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Backend API for emulated MBOX
+ */
+
+#ifndef ZEPHYR_INCLUDE_DRIVERS_MBOX_MBOX_EMUL_H_
+#define ZEPHYR_INCLUDE_DRIVERS_MBOX_MBOX_EMUL_H_
+
+#include <zephyr/types.h>
+#include <zephyr/device.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Emulated MBOX backend API
+ * @defgroup mbox_emul Emulated MBOX
+ * @ingroup mbox_interface
+ * @{
+ *
+ * A signal sent on a channel is received on the same channel of the same
+ * controller. The callback is called from the context of the sender, like
+ * an interrupt would preempt it. A signal sent to a disabled channel stays
+ * pending until the channel is enabled.
+ */
+
+/** Number of channels of an emulated MBOX controller. */
+#define MBOX_EMUL_CHANNELS 32
+
+/**
+ * @brief Get the number of signals sent on a channel
+ *
+ * @param dev Emulated MBOX controller.
+ * @param channel Channel.
+ *
+ * @return Number of signals sent on @p channel since initialization.
+ */
+uint32_t mbox_emul_signals_get(const struct device *dev, uint32_t channel);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_DRIVERS_MBOX_MBOX_EMUL_H_ */
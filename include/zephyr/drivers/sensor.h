@@ -23,6 +23,11 @@
 #include <zephyr/device.h>
 #include <errno.h>
 
+#ifdef CONFIG_SENSOR_STREAM
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/rtio/rtio_blocking.h>
+#endif /* CONFIG_SENSOR_STREAM */
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -394,12 +399,91 @@ typedef int (*sensor_channel_get_t)(const struct device *dev,
 				    enum sensor_channel chan,
 				    struct sensor_value *val);
 
+/* Also referenced by the system call stubs without CONFIG_SENSOR_STREAM */
+struct sensor_decoder_api;
+
+#if defined(CONFIG_SENSOR_STREAM) || defined(__DOXYGEN__)
+/**
+ * @brief Header at the start of a buffer of raw sensor frames
+ *
+ * A streaming read fills a caller provided buffer with this header followed
+ * by @a frame_count raw frames of @a frame_size bytes each, oldest first.
+ * Drivers may place private data (e.g. the scale in effect when the frames
+ * were captured) between the header and the first frame, which is why the
+ * frames are located with @a offset rather than sizeof(header). The frames
+ * are only meaningful to the decoder of the device that produced them.
+ */
+struct sensor_frame_header {
+	/** Capture time of the first frame in nanoseconds since boot */
+	uint64_t timestamp_ns;
+	/** Time between consecutive frames in nanoseconds */
+	uint32_t period_ns;
+	/** Number of frames in the buffer */
+	uint16_t frame_count;
+	/** Size of one raw frame in bytes */
+	uint8_t frame_size;
+	/** Offset of the first frame from the start of the header */
+	uint8_t offset;
+};
+
+/**
+ * @brief Decoder for raw frames produced by sensor_read_frames()
+ *
+ * Decoding is done on the consumer side, so the producer only moves bytes
+ * and the conversion cost is paid only for the channels actually used.
+ */
+struct sensor_decoder_api {
+	/**
+	 * @brief Decode a channel from a range of frames
+	 *
+	 * Values are written as Q31 fixed point numbers scaled by 2^shift,
+	 * i.e. value = q31 * 2^(shift - 31). Channels with an X, Y and Z
+	 * component (e.g. SENSOR_CHAN_ACCEL_XYZ) produce three consecutive
+	 * values per frame.
+	 *
+	 * @param buf Buffer filled by sensor_read_frames().
+	 * @param chan Channel to decode.
+	 * @param first Index of the first frame to decode.
+	 * @param count Number of frames to decode.
+	 * @param values Output values.
+	 * @param shift Output shift shared by all @a values.
+	 *
+	 * @return Number of frames decoded, or negative errno code on failure.
+	 */
+	int (*decode)(const uint8_t *buf, enum sensor_channel chan,
+		      uint16_t first, uint16_t count, int32_t *values,
+		      int8_t *shift);
+};
+
+/**
+ * @typedef sensor_read_frames_t
+ * @brief Callback API for reading buffered frames from a sensor
+ *
+ * See sensor_read_frames() for argument description
+ */
+typedef int (*sensor_read_frames_t)(const struct device *dev, uint8_t *buf,
+				    uint32_t buf_len);
+
+/**
+ * @typedef sensor_get_decoder_t
+ * @brief Callback API for getting the frame decoder of a sensor
+ *
+ * See sensor_get_decoder() for argument description
+ */
+typedef int (*sensor_get_decoder_t)(const struct device *dev,
+				    const struct sensor_decoder_api **decoder);
+#endif /* CONFIG_SENSOR_STREAM */
+
 __subsystem struct sensor_driver_api {
 	sensor_attr_set_t attr_set;
 	sensor_attr_get_t attr_get;
 	sensor_trigger_set_t trigger_set;
 	sensor_sample_fetch_t sample_fetch;
 	sensor_channel_get_t channel_get;
+#if defined(CONFIG_SENSOR_STREAM) || defined(__DOXYGEN__)
+	sensor_read_frames_t read_frames;
+	sensor_get_decoder_t get_decoder;
+#endif
 };
 
 /**
@@ -696,6 +780,162 @@ static inline int sensor_value_from_double(struct sensor_value *val, double inp)
 	return 0;
 }
 
+#if defined(CONFIG_SENSOR_STREAM) || defined(__DOXYGEN__)
+
+/**
+ * @brief Drain buffered samples from a sensor into raw frames
+ *
+ * Reads as many frames as are pending in the sensor (typically its hardware
+ * FIFO) and fit in @a buf, which starts with a struct sensor_frame_header.
+ * Unlike sensor_sample_fetch() a single call moves a whole batch of samples
+ * across the bus, and no conversion to struct sensor_value takes place.
+ * Use the decoder returned by sensor_get_decoder() to interpret the frames.
+ *
+ * @param dev Pointer to the sensor device
+ * @param buf Buffer to fill, must be suitably aligned for the header
+ * @param buf_len Size of @a buf in bytes
+ *
+ * @retval >=0 Number of bytes of @a buf used (header included)
+ * @retval -ENOSYS If the driver does not support streaming
+ * @retval -ENOMEM If @a buf cannot hold the header and one frame
+ * @retval <0 Other negative errno code on failure
+ */
+__syscall int sensor_read_frames(const struct device *dev, uint8_t *buf,
+				 uint32_t buf_len);
+
+static inline int z_impl_sensor_read_frames(const struct device *dev,
+					    uint8_t *buf, uint32_t buf_len)
+{
+	const struct sensor_driver_api *api =
+		(const struct sensor_driver_api *)dev->api;
+
+	if (api->read_frames == NULL) {
+		return -ENOSYS;
+	}
+
+	return api->read_frames(dev, buf, buf_len);
+}
+
+/**
+ * @brief Get the decoder for frames produced by a sensor
+ *
+ * @param dev Pointer to the sensor device
+ * @param decoder Set to the decoder of @a dev
+ *
+ * @retval 0 On success
+ * @retval -ENOSYS If the driver does not support streaming
+ */
+__syscall int sensor_get_decoder(const struct device *dev,
+				 const struct sensor_decoder_api **decoder);
+
+static inline int z_impl_sensor_get_decoder(const struct device *dev,
+					    const struct sensor_decoder_api **decoder)
+{
+	const struct sensor_driver_api *api =
+		(const struct sensor_driver_api *)dev->api;
+
+	if (api->get_decoder == NULL) {
+		return -ENOSYS;
+	}
+
+	return api->get_decoder(dev, decoder);
+}
+
+/**
+ * @brief Get a pointer to a raw frame in a frame buffer
+ *
+ * @param buf Buffer filled by sensor_read_frames()
+ * @param idx Frame index
+ * @return Pointer to the first byte of frame @a idx
+ */
+static inline const uint8_t *sensor_frame_get(const uint8_t *buf, uint16_t idx)
+{
+	const struct sensor_frame_header *hdr =
+		(const struct sensor_frame_header *)buf;
+
+	return buf + hdr->offset + (size_t)idx * hdr->frame_size;
+}
+
+/**
+ * @brief Get the capture time of a frame in a frame buffer
+ *
+ * @param buf Buffer filled by sensor_read_frames()
+ * @param idx Frame index
+ * @return Capture time of frame @a idx in nanoseconds since boot
+ */
+static inline uint64_t sensor_frame_timestamp(const uint8_t *buf, uint16_t idx)
+{
+	const struct sensor_frame_header *hdr =
+		(const struct sensor_frame_header *)buf;
+
+	return hdr->timestamp_ns + (uint64_t)idx * hdr->period_ns;
+}
+
+/**
+ * @brief Helper function for converting a decoded Q31 value to float.
+ *
+ * @param q Value produced by a sensor decoder.
+ * @param shift Shift produced by the same decode call.
+ * @return The converted value.
+ */
+static inline float sensor_q31_to_float(int32_t q, int8_t shift)
+{
+	return ((float)q / (float)(1U << 31)) *
+	       (shift >= 0 ? (float)(1U << shift) : 1.0f / (float)(1U << -shift));
+}
+
+/**
+ * @brief Helper function for converting a decoded Q31 value to micro units.
+ *
+ * @param q Value produced by a sensor decoder.
+ * @param shift Shift produced by the same decode call.
+ * @return The converted value in millionths of the channel unit.
+ */
+static inline int64_t sensor_q31_to_micro(int32_t q, int8_t shift)
+{
+	int64_t v = (int64_t)q * 1000000LL;
+
+	return shift >= 31 ? v << (shift - 31) : v >> (31 - shift);
+}
+
+/**
+ * @brief Data of a sensor stream iodev
+ *
+ * Each RTIO_OP_RX request submitted to the iodev is completed with the
+ * result of sensor_read_frames() on the request buffer. Reads are done by
+ * the system work queue through a blocking adapter, so submitting never
+ * waits on the sensor bus.
+ */
+struct sensor_stream_iodev_data {
+	/** Sensor device */
+	const struct device *dev;
+
+	/** Adapter doing the reads */
+	struct rtio_blocking blocking;
+};
+
+/** @cond INTERNAL_HIDDEN */
+extern const struct rtio_iodev_api sensor_stream_iodev_api;
+
+int z_sensor_stream_iodev_read(const struct rtio_sqe *sqe, struct rtio *r);
+/** @endcond */
+
+/**
+ * @brief Define an iodev streaming frames from a sensor in devicetree
+ *
+ * @param name Name of the iodev
+ * @param node_id Devicetree node identifier of the sensor
+ */
+#define SENSOR_DT_STREAM_IODEV_DEFINE(name, node_id)                                               \
+	static struct sensor_stream_iodev_data _sensor_stream_iodev_data_##name = {                \
+		.dev = DEVICE_DT_GET(node_id),                                                     \
+		.blocking = RTIO_BLOCKING_INITIALIZER(z_sensor_stream_iodev_read),                 \
+	};                                                                                         \
+	RTIO_IODEV_DEFINE(name, &sensor_stream_iodev_api, CONFIG_SENSOR_STREAM_SQ_SIZE,            \
+			  &_sensor_stream_iodev_data_##name)
+
+#endif /* CONFIG_SENSOR_STREAM */
+
 #ifdef CONFIG_SENSOR_INFO
 
 struct sensor_info {
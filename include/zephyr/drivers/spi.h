@@ -25,6 +25,10 @@
 #include <zephyr/dt-bindings/spi/spi.h>
 #include <zephyr/drivers/gpio.h>
 #include <zephyr/kernel.h>
+#ifdef CONFIG_SPI_RTIO
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/rtio/rtio_blocking.h>
+#endif /* CONFIG_SPI_RTIO */
 
 #ifdef __cplusplus
 extern "C" {
@@ -487,6 +491,19 @@ typedef int (*spi_api_io_async)(const struct device *dev,
 typedef int (*spi_api_release)(const struct device *dev,
 			       const struct spi_config *config);
 
+#if defined(CONFIG_SPI_RTIO) || defined(__DOXYGEN__)
+/**
+ * @typedef spi_api_iodev_submit
+ * @brief Callback API for RTIO requests
+ *
+ * Does the transaction starting with @p sqe, see struct spi_iodev_data,
+ * and reports its result with rtio_sqe_ok() or rtio_sqe_err(), possibly
+ * before returning.
+ */
+typedef void (*spi_api_iodev_submit)(const struct device *dev,
+				     const struct rtio_sqe *sqe,
+				     struct rtio *r);
+#endif /* CONFIG_SPI_RTIO */
 
 /**
  * @brief SPI driver API
@@ -497,6 +514,9 @@ __subsystem struct spi_driver_api {
 #ifdef CONFIG_SPI_ASYNC
 	spi_api_io_async transceive_async;
 #endif /* CONFIG_SPI_ASYNC */
+#ifdef CONFIG_SPI_RTIO
+	spi_api_iodev_submit iodev_submit;
+#endif /* CONFIG_SPI_RTIO */
 	spi_api_release release;
 };
 
@@ -903,6 +923,71 @@ static inline int spi_release_dt(const struct spi_dt_spec *spec)
 	return spi_release(spec->bus, &spec->config);
 }
 
+#if defined(CONFIG_SPI_RTIO) || defined(__DOXYGEN__)
+
+/**
+ * @brief Data of a SPI iodev
+ *
+ * Each chain of requests submitted to the iodev is a sequence of SPI
+ * transactions, with the chip select asserted during each transaction.
+ * A transaction is a single request, or requests linked with
+ * RTIO_SQE_TRANSACTION, of the RTIO_OP_TX, RTIO_OP_TINY_TX, RTIO_OP_RX and
+ * RTIO_OP_TXRX operations. Nothing is received during writes, and dummy
+ * data is sent during reads.
+ *
+ * Drivers without an iodev_submit function do the transactions with
+ * spi_transceive(), through a blocking adapter.
+ */
+struct spi_iodev_data {
+	/** SPI device and configuration */
+	struct spi_dt_spec spec;
+
+	/** Adapter for drivers without native RTIO support */
+	struct rtio_blocking blocking;
+};
+
+/** @cond INTERNAL_HIDDEN */
+extern const struct rtio_iodev_api spi_iodev_api;
+
+int z_spi_iodev_transceive(const struct rtio_sqe *sqe, struct rtio *r);
+/** @endcond */
+
+/**
+ * @brief Define an iodev for a SPI device from devicetree
+ *
+ * @param name Name of the iodev
+ * @param node_id Devicetree node identifier of the SPI device
+ * @param operation_ SPI operation, as in SPI_DT_SPEC_GET()
+ * @param delay_ Chip select delay, as in SPI_DT_SPEC_GET()
+ */
+#define SPI_DT_IODEV_DEFINE(name, node_id, operation_, delay_)                                     \
+	static struct spi_iodev_data _spi_iodev_data_##name = {                                    \
+		.spec = SPI_DT_SPEC_GET(node_id, operation_, delay_),                              \
+		.blocking = RTIO_BLOCKING_INITIALIZER(z_spi_iodev_transceive),                     \
+	};                                                                                         \
+	RTIO_IODEV_DEFINE(name, &spi_iodev_api, CONFIG_SPI_RTIO_SQ_SIZE,                           \
+			  &_spi_iodev_data_##name)
+
+/**
+ * @brief Get the buffers of a SPI transaction
+ *
+ * For drivers implementing iodev_submit.
+ *
+ * @param r RTIO context
+ * @param sqe First request of the transaction
+ * @param tx_bufs Filled with the buffers to write, one per request
+ * @param rx_bufs Filled with the buffers to read, one per request
+ * @param max Number of entries in @p tx_bufs and @p rx_bufs
+ *
+ * @return Number of buffers, 0 if the transaction has nothing to transfer
+ * @retval -ENOMEM if the transaction has more than @p max requests
+ * @retval -ENOTSUP if a request is not a transfer
+ */
+int spi_iodev_txn_bufs(struct rtio *r, const struct rtio_sqe *sqe,
+		       struct spi_buf *tx_bufs, struct spi_buf *rx_bufs, size_t max);
+
+#endif /* CONFIG_SPI_RTIO */
+
 #ifdef __cplusplus
 }
 #endif
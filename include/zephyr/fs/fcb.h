@@ -76,6 +76,44 @@ struct fcb_entry_ctx {
 	/**< Flash area where the entry is placed */
 };
 
+/**
+ * @brief Summary of the records of a FCB sector.
+ *
+ * Kept in RAM when the caller of @ref fcb_init gives an array of them, so that
+ * records can be found by sequence number or timestamp without reading all
+ * the sectors. Sequence numbers count the records appended since the oldest
+ * one present at @ref fcb_init and are not stored in flash.
+ */
+struct fcb_sector_summary {
+	uint32_t fs_first_seq;
+	/**< Sequence number of the first record of the sector */
+
+	uint32_t fs_count; /**< Number of records in the sector */
+
+	uint32_t fs_first_ts;
+	/**< Smallest timestamp of the records, UINT32_MAX if there is none */
+
+	uint32_t fs_last_ts;
+	/**< Largest timestamp of the records, 0 if there is none */
+};
+
+/** Number of bytes at the start of a record given to @ref fcb_timestamp_cb */
+#define FCB_TIMESTAMP_DATA_LEN 16
+
+/**
+ * FCB timestamp callback function type.
+ *
+ * Extracts the timestamp of a record from its first bytes. Timestamps are
+ * expected to grow with the records appended.
+ *
+ * @param[in] data first bytes of the record data
+ * @param[in] len  number of bytes in data, the smallest of the record length
+ *                 and FCB_TIMESTAMP_DATA_LEN
+ *
+ * @return timestamp of the record
+ */
+typedef uint32_t (*fcb_timestamp_cb)(const uint8_t *data, size_t len);
+
 /**
  * @brief FCB instance structure
  *
@@ -104,6 +142,12 @@ struct fcb {
 	struct flash_sector *f_sectors;
 	/**< Array of sectors, must be contiguous */
 
+	struct fcb_sector_summary *f_summary;
+	/**< Array of f_sector_cnt sector summaries, NULL if not kept */
+
+	fcb_timestamp_cb f_timestamp;
+	/**< Timestamp of the records kept in the summaries, NULL if none */
+
 	/* Flash circular buffer internal state */
 	struct k_mutex f_mtx;
 	/**< Locking for accessing the FCB data, internal state */
@@ -131,6 +175,18 @@ struct fcb {
 	 */
 };
 
+/**
+ * @brief FCB batch structure
+ *
+ * Records added to a batch are encoded in its buffer and written to flash
+ * together, with a flash write per sector they go to.
+ */
+struct fcb_batch {
+	uint8_t *fb_buf; /**< Buffer holding the encoded records */
+	size_t fb_size; /**< Size of the buffer */
+	size_t fb_len; /**< Number of bytes used in the buffer */
+};
+
 /**
  * @}
  */
@@ -179,6 +235,48 @@ int fcb_append(struct fcb *fcb, uint16_t len, struct fcb_entry *loc);
  */
 int fcb_append_finish(struct fcb *fcb, struct fcb_entry *append_loc);
 
+/**
+ * Initialize a batch of records.
+ *
+ * @param[out] batch FCB batch structure.
+ * @param[in] buf    Buffer for the records, each record taking its length,
+ *                   data and CRC, each aligned to the flash write size.
+ * @param[in] size   Size of the buffer.
+ */
+void fcb_batch_init(struct fcb_batch *batch, uint8_t *buf, size_t size);
+
+/**
+ * Add a record to a batch.
+ *
+ * The batch is flushed first when the record does not fit in its buffer.
+ *
+ * @param[in] fcb       FCB instance structure.
+ * @param[in,out] batch FCB batch structure.
+ * @param[in] data      Record data.
+ * @param[in] len       Length of the record data.
+ *
+ * @return 0 on success, -EINVAL if the record does not fit in an empty
+ *         batch, or the error of @ref fcb_batch_flush.
+ */
+int fcb_batch_add(struct fcb *fcb, struct fcb_batch *batch, const void *data,
+		  uint16_t len);
+
+/**
+ * Write the records of a batch to flash.
+ *
+ * Records are appended as with @ref fcb_append and @ref fcb_append_finish,
+ * with a single flash write for all the records going to the same sector.
+ * On failure, the records which could not be written are kept in the batch,
+ * e.g. to flush it again after @ref fcb_rotate.
+ *
+ * @param[in] fcb       FCB instance structure.
+ * @param[in,out] batch FCB batch structure.
+ *
+ * @return 0 on success, -ENOSPC if there is no room left, other negative
+ *         errno code on failure.
+ */
+int fcb_batch_flush(struct fcb *fcb, struct fcb_batch *batch);
+
 /**
  * FCB Walk callback function type.
  *
@@ -232,6 +330,39 @@ int fcb_walk(struct fcb *fcb, struct flash_sector *sector, fcb_walk_cb cb,
  */
 int fcb_getnext(struct fcb *fcb, struct fcb_entry *loc);
 
+/**
+ * Get the location of a record from its sequence number.
+ *
+ * Uses the sector summaries to read only the sector of the record.
+ *
+ * @param[in] fcb  FCB instance structure.
+ * @param[in] seq  Sequence number of the record.
+ * @param[out] loc entry location information, to continue with
+ *                 @ref fcb_getnext.
+ *
+ * @return 0 on success, -ENOENT if the record is not in the FCB, -ENOTSUP if
+ *         no summaries are kept, other negative errno code on failure.
+ */
+int fcb_seek_seq(struct fcb *fcb, uint32_t seq, struct fcb_entry *loc);
+
+/**
+ * Get the location of the first record with a timestamp not less than a
+ * given time.
+ *
+ * Uses the sector summaries to skip the sectors holding older records.
+ * Together with @ref fcb_getnext, it gives the records of a time range.
+ *
+ * @param[in] fcb  FCB instance structure.
+ * @param[in] ts   Timestamp to look for.
+ * @param[out] loc entry location information, to continue with
+ *                 @ref fcb_getnext.
+ *
+ * @return 0 on success, -ENOENT if there is no such record, -ENOTSUP if no
+ *         summaries or timestamps are kept, other negative errno code on
+ *         failure.
+ */
+int fcb_seek_time(struct fcb *fcb, uint32_t ts, struct fcb_entry *loc);
+
 /**
  * Rotate fcb sectors
  *
@@ -52,6 +52,9 @@ enum {
 	/** Identifier for in-tree LittleFS file system. */
 	FS_LITTLEFS,
 
+	/** Identifier for in-tree read-only packed image file system. */
+	FS_PACKFS,
+
 	/** Base identifier for external file systems. */
 	FS_TYPE_EXTERNAL_BASE,
 };
@@ -136,6 +139,17 @@ struct fs_statvfs {
 	unsigned long f_bfree;
 };
 
+/**
+ * @brief Element of an I/O vector, for fs_readv() and fs_writev()
+ *
+ * @param data Data of the element
+ * @param len Length of the data
+ */
+struct fs_iovec {
+	void *data;
+	size_t len;
+};
+
 
 /**
  * @name fs_open open and creation mode flags
@@ -329,6 +343,25 @@ int fs_unlink(const char *path);
  */
 int fs_rename(const char *from, const char *to);
 
+/**
+ * @brief Copy a file
+ *
+ * Copies the content of the file at @p from to a new file at @p to, which may
+ * be on another mount point. Data is transferred in pieces of
+ * CONFIG_FILE_SYSTEM_COPY_BUFFER_SIZE bytes, so that file systems can access
+ * several sectors at once. On error, the partially written destination file
+ * is deleted.
+ *
+ * @param from The source path
+ * @param to The destination path
+ *
+ * @retval 0 on success;
+ * @retval -EEXIST when the destination already exists;
+ * @retval -ENOTSUP when not implemented by underlying file system driver;
+ * @retval <0 an other negative errno code on error.
+ */
+int fs_copy(const char *from, const char *to);
+
 /**
  * @brief Read file
  *
@@ -368,6 +401,122 @@ ssize_t fs_read(struct fs_file_t *zfp, void *ptr, size_t size);
  */
 ssize_t fs_write(struct fs_file_t *zfp, const void *ptr, size_t size);
 
+/**
+ * @brief Read file into several buffers
+ *
+ * Fills the @p iovcnt buffers of @p iov in order, as fs_read() called on each
+ * of them would, stopping at the end of the file. File systems which support
+ * it read the whole vector in one operation.
+ *
+ * @param zfp Pointer to the file object
+ * @param iov Buffers to fill
+ * @param iovcnt Number of buffers
+ *
+ * @retval >=0 a number of bytes read, on success;
+ * @retval -EBADF when invoked on zfp that represents unopened/closed file;
+ * @retval -ENOTSUP when not implemented by underlying file system driver;
+ * @retval <0 a negative errno code on error before any data was read.
+ */
+ssize_t fs_readv(struct fs_file_t *zfp, const struct fs_iovec *iov,
+		 int iovcnt);
+
+/**
+ * @brief Write file from several buffers
+ *
+ * Writes the @p iovcnt buffers of @p iov in order, as fs_write() called on
+ * each of them would. File systems which support it write the whole vector
+ * in one operation.
+ *
+ * @param zfp Pointer to the file object
+ * @param iov Buffers to write
+ * @param iovcnt Number of buffers
+ *
+ * @retval >=0 a number of bytes written, on success;
+ * @retval -EBADF when invoked on zfp that represents unopened/closed file;
+ * @retval -ENOTSUP when not implemented by underlying file system driver;
+ * @retval <0 a negative errno code on error before any data was written.
+ */
+ssize_t fs_writev(struct fs_file_t *zfp, const struct fs_iovec *iov,
+		  int iovcnt);
+
+/**
+ * @brief Read file at a given position
+ *
+ * Reads up to @p size bytes at @p offset of the file, without changing the
+ * file position.
+ *
+ * @note File systems without a positional read are served by seeking to
+ * @p offset, reading and seeking back, which is not atomic with regard to
+ * other operations on the same file object.
+ *
+ * @param zfp Pointer to the file object
+ * @param ptr Pointer to the data buffer
+ * @param size Number of bytes to be read
+ * @param offset Position in the file to read from
+ *
+ * @retval >=0 a number of bytes read, on success;
+ * @retval -EBADF when invoked on zfp that represents unopened/closed file;
+ * @retval -ENOTSUP when not implemented by underlying file system driver;
+ * @retval <0 a negative errno code on error.
+ */
+ssize_t fs_pread(struct fs_file_t *zfp, void *ptr, size_t size, off_t offset);
+
+/**
+ * @brief Write file at a given position
+ *
+ * Writes @p size bytes at @p offset of the file, without changing the file
+ * position. The file must not have been opened with FS_O_APPEND.
+ *
+ * @note The emulation note of fs_pread() applies as well.
+ *
+ * @param zfp Pointer to the file object
+ * @param ptr Pointer to the data buffer
+ * @param size Number of bytes to be written
+ * @param offset Position in the file to write at
+ *
+ * @retval >=0 a number of bytes written, on success;
+ * @retval -EBADF when invoked on zfp that represents unopened/closed file;
+ * @retval -EINVAL when the file was opened with FS_O_APPEND;
+ * @retval -ENOTSUP when not implemented by underlying file system driver;
+ * @retval <0 an other negative errno code on error.
+ */
+ssize_t fs_pwrite(struct fs_file_t *zfp, const void *ptr, size_t size,
+		  off_t offset);
+
+/**
+ * @brief Map a file in memory for reading
+ *
+ * Gives direct access to the whole content of a file, without copying it,
+ * when the file system stores it contiguously in memory mapped storage. For
+ * other files, a copy is read into a heap of
+ * CONFIG_FILE_SYSTEM_MMAP_CACHE_SIZE bytes, if not 0.
+ *
+ * The content must not be modified, and must not be used after
+ * fs_munmap(). Writing to a mapped file is not supported.
+ *
+ * @param zfp Pointer to the file object
+ * @param addr Set to the address of the content
+ * @param size Set to the size of the file
+ *
+ * @retval 0 on success;
+ * @retval -EBADF when invoked on zfp that represents unopened/closed file;
+ * @retval -ENOMEM when a copy does not fit in the heap;
+ * @retval -ENOTSUP when the file cannot be mapped nor copied;
+ * @retval <0 an other negative errno code on error.
+ */
+int fs_mmap(struct fs_file_t *zfp, const void **addr, size_t *size);
+
+/**
+ * @brief Release a mapping of fs_mmap()
+ *
+ * @param zfp Pointer to the file object the mapping was done with
+ * @param addr Address fs_mmap() returned
+ *
+ * @retval 0 on success;
+ * @retval -EBADF when invoked on zfp that represents unopened/closed file.
+ */
+int fs_munmap(struct fs_file_t *zfp, const void *addr);
+
 /**
  * @brief Seek file
  *
@@ -27,6 +27,14 @@ extern "C" {
  * @param truncate Truncates/expands the file to the new length
  * @param sync Flushes the cache of an open file
  * @param close Flushes the associated stream and closes the file
+ * @param readv Reads into several buffers, optional
+ * @param writev Writes from several buffers, optional
+ * @param pread Reads at a given position, without moving the file
+ *        position, optional
+ * @param pwrite Writes at a given position, without moving the file
+ *        position, optional
+ * @param mmap Gives the address of the file content if it is stored
+ *        contiguously in memory mapped storage, -ENOTSUP otherwise, optional
  * @param opendir Opens an existing directory specified by the path
  * @param readdir Reads directory entries of an open directory
  * @param closedir Closes an open directory
@@ -51,6 +59,15 @@ struct fs_file_system_t {
 	int (*truncate)(struct fs_file_t *filp, off_t length);
 	int (*sync)(struct fs_file_t *filp);
 	int (*close)(struct fs_file_t *filp);
+	ssize_t (*readv)(struct fs_file_t *filp, const struct fs_iovec *iov,
+			 int iovcnt);
+	ssize_t (*writev)(struct fs_file_t *filp, const struct fs_iovec *iov,
+			  int iovcnt);
+	ssize_t (*pread)(struct fs_file_t *filp, void *dest, size_t nbytes,
+			 off_t offset);
+	ssize_t (*pwrite)(struct fs_file_t *filp, const void *src,
+			  size_t nbytes, off_t offset);
+	int (*mmap)(struct fs_file_t *filp, const void **addr, size_t *size);
 	/* Directory operations */
 	int (*opendir)(struct fs_dir_t *dirp, const char *fs_path);
 	int (*readdir)(struct fs_dir_t *dirp, struct fs_dirent *entry);
@@ -33,6 +33,11 @@ struct fs_littlefs {
 	 */
 	uint32_t *lookahead_buffer[CONFIG_FS_LITTLEFS_LOOKAHEAD_SIZE / sizeof(uint32_t)];
 
+	/* Address the partition is mapped at, NULL if it is not memory
+	 * mapped. Set before mount to let fs_mmap() map contiguous files.
+	 */
+	const uint8_t *mmap_base;
+
 	/* These structures are filled automatically at mount. */
 	struct lfs lfs;
 	void *backend;
@@ -31,6 +31,26 @@ extern "C" {
  * @{
  */
 
+/**
+ * @brief Non-volatile Storage statistics
+ *
+ * @param gc_count Number of sectors garbage collected
+ * @param gc_background Number of them garbage collected in the background
+ * @param gc_bytes_moved Bytes of data copied by garbage collection
+ * @param gc_max_us Longest garbage collection of a sector, in microseconds
+ * @param write_count Number of entries written to flash
+ * @param write_max_us Longest nvs_write() writing to flash, in microseconds,
+ * including garbage collection and waits for another writer
+ */
+struct nvs_stats {
+	uint32_t gc_count;
+	uint32_t gc_background;
+	uint64_t gc_bytes_moved;
+	uint32_t gc_max_us;
+	uint32_t write_count;
+	uint32_t write_max_us;
+};
+
 /**
  * @brief Non-volatile Storage File system structure
  *
@@ -44,6 +64,14 @@ extern "C" {
  * @param nvs_lock Mutex
  * @param flash_device Flash Device runtime structure
  * @param flash_parameters Flash memory parameters structure
+ * @param gc_work Background garbage collection, with CONFIG_NVS_BACKGROUND_GC
+ * @param gc_work_init Flag indicating if gc_work is initialized, with
+ * CONFIG_NVS_BACKGROUND_GC
+ * @param gc_ahead Whether garbage collecting ahead of the writes frees enough
+ * space to be worth it, with CONFIG_NVS_BACKGROUND_GC
+ * @param stats Statistics, with CONFIG_NVS_STATS
+ * @param large_wr Large entry being written, its chunks are kept by the
+ * garbage collection
  */
 struct nvs_fs {
 	off_t offset;
@@ -58,6 +86,29 @@ struct nvs_fs {
 #if CONFIG_NVS_LOOKUP_CACHE
 	uint32_t lookup_cache[CONFIG_NVS_LOOKUP_CACHE_SIZE];
 #endif
+#if CONFIG_NVS_BACKGROUND_GC
+	struct k_work gc_work;
+	bool gc_work_init;
+	bool gc_ahead;
+#endif
+#if CONFIG_NVS_STATS
+	struct nvs_stats stats;
+#endif
+	struct {
+		uint16_t id;
+		uint8_t gen;
+		bool active;
+	} large_wr;
+};
+
+/**
+ * @brief Element of an I/O vector, for nvs_writev() and nvs_readv()
+ */
+struct nvs_iovec {
+	/** Data of the element */
+	void *data;
+	/** Length of the data */
+	size_t len;
 };
 
 /**
@@ -97,6 +148,10 @@ int nvs_clear(struct nvs_fs *fs);
  *
  * Write an entry to the file system.
  *
+ * An entry too large for a sector, up to UINT16_MAX bytes, is split in
+ * chunks spread over several sectors. It replaces the previous entry
+ * atomically, so the file system needs room for both while it is written.
+ *
  * @param fs Pointer to file system
  * @param id Id of the entry to be written
  * @param data Pointer to the data to be written
@@ -108,6 +163,23 @@ int nvs_clear(struct nvs_fs *fs);
  */
 ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len);
 
+/**
+ * @brief nvs_writev
+ *
+ * Write an entry gathered from an I/O vector to the file system, as
+ * nvs_write() would write the concatenation of the elements.
+ *
+ * @param fs Pointer to file system
+ * @param id Id of the entry to be written
+ * @param iov I/O vector holding the data, it is not modified
+ * @param iovcnt Number of elements of the I/O vector
+ *
+ * @return Number of bytes written, as nvs_write(). On error, returns
+ * negative value of errno.h defined error codes.
+ */
+ssize_t nvs_writev(struct nvs_fs *fs, uint16_t id, const struct nvs_iovec *iov,
+		   size_t iovcnt);
+
 /**
  * @brief nvs_delete
  *
@@ -155,6 +227,23 @@ ssize_t nvs_read(struct nvs_fs *fs, uint16_t id, void *data, size_t len);
  */
 ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len, uint16_t cnt);
 
+/**
+ * @brief nvs_readv
+ *
+ * Read the latest entry from the file system, scattering it to an I/O
+ * vector.
+ *
+ * @param fs Pointer to file system
+ * @param id Id of the entry to be read
+ * @param iov I/O vector filled with the data, in order
+ * @param iovcnt Number of elements of the I/O vector
+ *
+ * @return Number of bytes of the entry, as nvs_read(). On error, returns
+ * negative value of errno.h defined error codes.
+ */
+ssize_t nvs_readv(struct nvs_fs *fs, uint16_t id, const struct nvs_iovec *iov,
+		  size_t iovcnt);
+
 /**
  * @brief nvs_calc_free_space
  *
@@ -168,6 +257,111 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len, ui
  */
 ssize_t nvs_calc_free_space(struct nvs_fs *fs);
 
+/**
+ * @brief nvs_stats_get
+ *
+ * Get the statistics of the file system. Requires CONFIG_NVS_STATS.
+ *
+ * @param fs Pointer to file system
+ * @param stats Filled with the statistics
+ */
+void nvs_stats_get(struct nvs_fs *fs, struct nvs_stats *stats);
+
+/**
+ * @brief nvs_stats_reset
+ *
+ * Clear the statistics of the file system. Requires CONFIG_NVS_STATS.
+ *
+ * @param fs Pointer to file system
+ */
+void nvs_stats_reset(struct nvs_fs *fs);
+
+/**
+ * @brief Entry found by nvs_foreach()
+ */
+struct nvs_entry {
+	/** Id of the entry */
+	uint16_t id;
+	/** Length of the data of the entry */
+	uint16_t len;
+	/** @cond INTERNAL_HIDDEN */
+	uint32_t data_addr;
+	uint32_t ate_wra;
+	bool large;
+	/** @endcond */
+};
+
+/**
+ * @brief Range of ids walked by nvs_foreach()
+ *
+ * @param first First id of the range
+ * @param count Number of ids in the range
+ * @param seen Bitmap of @p count bits, NVS_ID_RANGE_SEEN_WORDS(count) words
+ */
+struct nvs_id_range {
+	uint16_t first;
+	uint16_t count;
+	uint32_t *seen;
+};
+
+/** Number of words of the bitmap of a range of @p count ids */
+#define NVS_ID_RANGE_SEEN_WORDS(count) ceiling_fraction(count, 32)
+
+/**
+ * @brief nvs_foreach callback
+ *
+ * @param fs Pointer to file system
+ * @param entry Entry found, valid until the next write to the file system
+ * @param user_data User data passed to nvs_foreach()
+ *
+ * @return 0 to continue the walk, any other value to stop it
+ */
+typedef int (*nvs_foreach_cb_t)(struct nvs_fs *fs, const struct nvs_entry *entry,
+				void *user_data);
+
+/**
+ * @brief nvs_foreach
+ *
+ * Walk the latest entry of every id in the given ranges, in a single pass over
+ * the allocation table, from the most recently to the least recently written
+ * entry. Deleted entries are not reported. This is much faster than reading
+ * many ids one by one, as every nvs_read() searches the allocation table.
+ *
+ * The callback must not write to the file system.
+ *
+ * @param fs Pointer to file system
+ * @param ranges Ranges of ids to report, their bitmaps are cleared first
+ * @param num_ranges Number of ranges
+ * @param cb Callback called for every entry found
+ * @param user_data User data passed to the callback
+ *
+ * @return 0 when all entries were walked, the non-zero value returned by the
+ * callback if it stopped the walk. On error, returns negative value of errno.h
+ * defined error codes.
+ */
+int nvs_foreach(struct nvs_fs *fs, const struct nvs_id_range *ranges,
+		size_t num_ranges, nvs_foreach_cb_t cb, void *user_data);
+
+/**
+ * @brief nvs_entry_read
+ *
+ * Read the data of an entry found by nvs_foreach(), without searching it.
+ *
+ * @param fs Pointer to file system
+ * @param entry Entry found by nvs_foreach()
+ * @param data Pointer to data buffer
+ * @param len Number of bytes to be read
+ *
+ * If the file system was written since the entry was found, including by
+ * a background garbage collection, the data may have moved: it is then
+ * searched again by id, as nvs_read() does.
+ *
+ * @return Number of bytes of the entry, as nvs_read(). On error, returns
+ * negative value of errno.h defined error codes.
+ */
+ssize_t nvs_entry_read(struct nvs_fs *fs, const struct nvs_entry *entry,
+		       void *data, size_t len);
+
 /**
  * @}
  */
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_FS_PACKFS_H_
+#define ZEPHYR_INCLUDE_FS_PACKFS_H_
+
+#include <zephyr/types.h>
+#include <zephyr/devicetree.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Packed read-only image file system
+ * @defgroup packfs Packed image file system
+ * @ingroup file_system_api
+ *
+ * The image is generated at build time from a directory by
+ * scripts/build/gen_packfs_image.py and accessed in place, from memory
+ * mapped flash or from a constant array linked in the application. Files
+ * are stored contiguously, so fs_mmap() gives direct access to them.
+ *
+ * The image starts with a header, followed by the entries of the files
+ * sorted by path, the paths and the file data. Numbers are little endian
+ * and offsets are relative to the start of the image. Directories are
+ * implied by the paths of the files they contain.
+ * @{
+ */
+
+/** Magic number of an image, "PKFS" */
+#define PACKFS_MAGIC 0x53464b50
+
+/** Version of the image format */
+#define PACKFS_VERSION 1
+
+/** @brief Image header */
+struct packfs_header {
+	/** PACKFS_MAGIC */
+	uint32_t magic;
+	/** PACKFS_VERSION */
+	uint16_t version;
+	/** Number of files */
+	uint16_t entry_count;
+	/** Size of the whole image */
+	uint32_t image_size;
+} __packed;
+
+/** @brief Entry of a file */
+struct packfs_entry {
+	/** Offset of the path, relative to the root, without leading '/' */
+	uint32_t name_off;
+	/** Offset of the data */
+	uint32_t data_off;
+	/** Size of the data */
+	uint32_t size;
+	/** Length of the path, without terminating '\0' */
+	uint16_t name_len;
+	/** Reserved, 0 */
+	uint16_t reserved;
+} __packed;
+
+/**
+ * @brief Mount data of an image
+ *
+ * A pointer to it must be stored in the fs_data field of a struct
+ * fs_mount_t of type FS_PACKFS.
+ */
+struct fs_packfs {
+	/** Address of the image */
+	const void *image;
+};
+
+/**
+ * @brief Address of an image stored in a partition of memory mapped flash
+ *
+ * @param node_id Node identifier of a fixed partition of a "soc-nv-flash"
+ *        node.
+ */
+#define FS_PACKFS_PARTITION_IMAGE(node_id)				\
+	((const void *)(DT_REG_ADDR(DT_GPARENT(node_id)) + DT_REG_ADDR(node_id)))
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_FS_PACKFS_H_ */
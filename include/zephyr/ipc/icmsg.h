@@ -39,6 +39,21 @@ struct icmsg_data_t {
 	/* General */
 	struct k_work mbox_work;
 	atomic_t state;
+
+	/* Set while a message is written to the TX buffer. */
+	atomic_t tx_busy;
+	/* Space allocated by icmsg_get_tx_buffer(). */
+	void *tx_buffer;
+	size_t tx_len;
+	/* Given on notifications of the remote instance, which frees TX
+	 * space as it processes messages.
+	 */
+	struct k_sem tx_space;
+
+	/* Message passed to the received callback, and held by the user. */
+	const void *rx_buffer;
+	uint16_t rx_len;
+	atomic_t rx_held;
 };
 
 /** @brief Initialize an icmsg instance
@@ -123,7 +138,7 @@ int icmsg_close(const struct icmsg_config_t *conf,
  *
  *  @retval 0 on success.
  *  @retval -EBUSY when the instance has not finished handshake with the remote
- *                 instance.
+ *                 instance, or when another message is being sent.
  *  @retval -ENODATA when the requested data to send is empty.
  *  @retval -EBADMSG when the requested data to send is too big.
  *  @retval other errno codes from dependent modules.
@@ -132,6 +147,115 @@ int icmsg_send(const struct icmsg_config_t *conf,
 	       struct icmsg_data_t *dev_data,
 	       const void *msg, size_t len);
 
+/** @brief Get an empty TX buffer in the shared memory.
+ *
+ *  The buffer is filled by the caller and sent with @ref icmsg_send_nocopy,
+ *  or released with @ref icmsg_drop_tx_buffer. No other message can be sent
+ *  until then: @ref icmsg_send fails with -EBUSY and this function with
+ *  -EALREADY, without waiting. With the multi endpoint backends, this
+ *  applies to all the endpoints sharing the instance.
+ *
+ *  @param[in] conf Structure containing configuration parameters for the icmsg
+ *                  instance.
+ *  @param[inout] dev_data Structure containing run-time data used by the icmsg
+ *                         instance.
+ *  @param[out] data Pointer to the TX buffer, 32 bit word aligned.
+ *  @param[inout] size Requested size, or 0 for the largest buffer available.
+ *                     Set to the size of the buffer, or to the largest size
+ *                     that can be requested when -ENOMEM is returned.
+ *  @param[in] wait Timeout waiting for the remote instance to free enough
+ *                  space. The remote instance does not signal freed space:
+ *                  the TX buffer is checked again on each of its
+ *                  notifications, and at least every millisecond.
+ *
+ *  @retval 0 on success.
+ *  @retval -EBUSY when the instance has not finished handshake with the remote
+ *                 instance.
+ *  @retval -EALREADY when a TX buffer is already in use.
+ *  @retval -ENOMEM when the requested size can never be allocated.
+ *  @retval -ENOBUFS when there is not enough free space.
+ */
+int icmsg_get_tx_buffer(const struct icmsg_config_t *conf,
+			struct icmsg_data_t *dev_data,
+			void **data, size_t *size, k_timeout_t wait);
+
+/** @brief Release a TX buffer without sending it.
+ *
+ *  @param[in] conf Structure containing configuration parameters for the icmsg
+ *                  instance.
+ *  @param[inout] dev_data Structure containing run-time data used by the icmsg
+ *                         instance.
+ *  @param[in] data Pointer to the buffer obtained with
+ *                  @ref icmsg_get_tx_buffer.
+ *
+ *  @retval 0 on success.
+ *  @retval -EALREADY when no TX buffer is in use.
+ *  @retval -ENXIO when @p data is not the TX buffer in use.
+ */
+int icmsg_drop_tx_buffer(const struct icmsg_config_t *conf,
+			 struct icmsg_data_t *dev_data,
+			 const void *data);
+
+/** @brief Send a message written in a TX buffer.
+ *
+ *  @param[in] conf Structure containing configuration parameters for the icmsg
+ *                  instance.
+ *  @param[inout] dev_data Structure containing run-time data used by the icmsg
+ *                         instance.
+ *  @param[in] msg Pointer to the buffer obtained with
+ *                 @ref icmsg_get_tx_buffer.
+ *  @param[in] len Size of the message, up to the size of the buffer.
+ *
+ *  @retval Number of bytes sent on success.
+ *  @retval -EBUSY when the instance has not finished handshake with the remote
+ *                 instance.
+ *  @retval -ENXIO when @p msg is not the TX buffer in use.
+ *  @retval -ENODATA when the message is empty.
+ *  @retval -EBADMSG when the message is bigger than the buffer.
+ *  @retval other errno codes from dependent modules.
+ */
+int icmsg_send_nocopy(const struct icmsg_config_t *conf,
+		      struct icmsg_data_t *dev_data,
+		      const void *msg, size_t len);
+
+/** @brief Keep a received message in the shared memory after the callback.
+ *
+ *  Must be called from the received callback, with
+ *  @kconfig{CONFIG_IPC_SERVICE_ICMSG_NOCOPY_RX} enabled. No other message is
+ *  received until the message is released with
+ *  @ref icmsg_release_rx_buffer.
+ *
+ *  @param[in] conf Structure containing configuration parameters for the icmsg
+ *                  instance.
+ *  @param[inout] dev_data Structure containing run-time data used by the icmsg
+ *                         instance.
+ *  @param[in] data Pointer to the message passed to the received callback.
+ *
+ *  @retval 0 on success.
+ *  @retval -EALREADY when the message is already held.
+ *  @retval -ENXIO when @p data is not the message being received.
+ *  @retval -ENOTSUP when messages are copied out of the shared memory.
+ */
+int icmsg_hold_rx_buffer(const struct icmsg_config_t *conf,
+			 struct icmsg_data_t *dev_data,
+			 const void *data);
+
+/** @brief Release a message held with @ref icmsg_hold_rx_buffer.
+ *
+ *  @param[in] conf Structure containing configuration parameters for the icmsg
+ *                  instance.
+ *  @param[inout] dev_data Structure containing run-time data used by the icmsg
+ *                         instance.
+ *  @param[in] data Pointer to the held message.
+ *
+ *  @retval 0 on success.
+ *  @retval -ENXIO when @p data is not held.
+ *  @retval -ENOTSUP when messages are copied out of the shared memory.
+ */
+int icmsg_release_rx_buffer(const struct icmsg_config_t *conf,
+			    struct icmsg_data_t *dev_data,
+			    const void *data);
+
 /** @brief Clear memory in TX buffer.
  *
  *  This function is intended to be called at an early stage of boot process,
@@ -2729,6 +2729,11 @@ struct k_mutex {
 	/** Original thread priority */
 	int owner_orig_prio;
 
+#ifdef CONFIG_LOCK_STATS
+	/** Contention statistics */
+	struct k_lock_stats lock_stats;
+#endif
+
 	SYS_PORT_TRACING_TRACKING_FIELD(k_mutex)
 };
 
@@ -2913,6 +2918,10 @@ struct k_sem {
 
 	_POLL_EVENT;
 
+#ifdef CONFIG_LOCK_STATS
+	struct k_lock_stats lock_stats;
+#endif
+
 	SYS_PORT_TRACING_TRACKING_FIELD(k_sem)
 
 };
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_KERNEL_LOCK_STATS_H_
+#define ZEPHYR_INCLUDE_KERNEL_LOCK_STATS_H_
+
+#include <stdint.h>
+#include <zephyr/sys/slist.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct k_mutex;
+struct k_sem;
+struct k_spinlock;
+struct k_thread;
+
+/**
+ * @brief Lock contention statistics
+ * @defgroup lock_stats_apis Lock contention statistics
+ * @ingroup kernel_apis
+ *
+ * With CONFIG_LOCK_STATS every mutex and semaphore counts acquisitions,
+ * contended acquisitions, wait times and (for mutexes) hold times, all
+ * in hardware cycles. Spinlocks only collect statistics once a
+ * statistics record has been attached with k_spin_lock_stats_attach().
+ *
+ * Objects defined with K_MUTEX_DEFINE() and K_SEM_DEFINE() are always
+ * listed by k_lock_stats_foreach(). Objects initialized at runtime are
+ * listed once registered, and must be unregistered before their memory
+ * is reused.
+ * @{
+ */
+
+/** Kind of object a lock statistics record belongs to */
+enum k_lock_stats_type {
+	K_LOCK_STATS_MUTEX,
+	K_LOCK_STATS_SEM,
+	K_LOCK_STATS_SPINLOCK,
+};
+
+/** Per-thread wait statistics of one lock */
+struct k_lock_waiter_stats {
+	/** Waiting thread, NULL for an unused entry. */
+	const struct k_thread *thread;
+	/** Number of contended acquisitions by this thread. */
+	uint32_t count;
+	/** Total cycles this thread waited for the lock. */
+	uint64_t wait_total;
+};
+
+/** Contention statistics of one lock */
+struct k_lock_stats {
+	/** Number of successful acquisitions. */
+	uint32_t acquisitions;
+	/** Acquisitions which had to wait for the lock. */
+	uint32_t contended;
+	/** Waits which ended without getting the lock. */
+	uint32_t timeouts;
+	/** Longest wait, in cycles. */
+	uint32_t wait_max;
+	/** Sum of all waits, in cycles. */
+	uint64_t wait_total;
+	/** Longest hold time, in cycles. Not tracked for semaphores. */
+	uint32_t hold_max;
+	/** Sum of all hold times, in cycles. Not tracked for semaphores. */
+	uint64_t hold_total;
+#if (CONFIG_LOCK_STATS_TOP_WAITERS > 0) || defined(__DOXYGEN__)
+	/** Threads with the longest total wait, most waiting first. */
+	struct k_lock_waiter_stats waiters[CONFIG_LOCK_STATS_TOP_WAITERS];
+#endif
+
+	/** @cond INTERNAL_HIDDEN */
+	uint32_t hold_start;
+	sys_snode_t node;
+	const char *name;
+	const void *obj;
+	uint8_t type;
+	/** @endcond */
+};
+
+/**
+ * @brief Lock statistics iteration callback
+ *
+ * @param type Kind of lock.
+ * @param obj Lock object.
+ * @param name Name given at registration, NULL for unregistered objects.
+ * @param stats Snapshot of the statistics.
+ * @param user_data User data passed to k_lock_stats_foreach().
+ */
+typedef void (*k_lock_stats_cb_t)(enum k_lock_stats_type type, const void *obj,
+				  const char *name, const struct k_lock_stats *stats,
+				  void *user_data);
+
+/**
+ * @brief Register a mutex so it is listed by k_lock_stats_foreach()
+ *
+ * @param mutex Initialized mutex.
+ * @param name Name used in reports, must stay valid while registered.
+ */
+void k_mutex_stats_register(struct k_mutex *mutex, const char *name);
+
+/**
+ * @brief Register a semaphore so it is listed by k_lock_stats_foreach()
+ *
+ * @param sem Initialized semaphore.
+ * @param name Name used in reports, must stay valid while registered.
+ */
+void k_sem_stats_register(struct k_sem *sem, const char *name);
+
+/**
+ * @brief Start collecting statistics for a spinlock
+ *
+ * Must be called while the lock is not held. Statistics are not
+ * collected for spinlocks taken by the system timer driver, as
+ * timestamps are read through k_cycle_get_32().
+ *
+ * @param l Spinlock.
+ * @param stats Statistics storage, must stay valid while attached.
+ * @param name Name used in reports, must stay valid while attached.
+ */
+void k_spin_lock_stats_attach(struct k_spinlock *l, struct k_lock_stats *stats,
+			      const char *name);
+
+/**
+ * @brief Stop listing a registered lock
+ *
+ * Spinlocks also stop collecting statistics.
+ *
+ * @param obj Mutex, semaphore or spinlock previously registered.
+ */
+void k_lock_stats_unregister(const void *obj);
+
+/**
+ * @brief Walk the statistics of all known locks
+ *
+ * @param cb Callback called for every lock.
+ * @param user_data User data passed to the callback.
+ */
+void k_lock_stats_foreach(k_lock_stats_cb_t cb, void *user_data);
+
+/**
+ * @brief Clear the statistics of all known locks
+ */
+void k_lock_stats_reset(void);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_KERNEL_LOCK_STATS_H_ */
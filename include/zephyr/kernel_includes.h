@@ -40,5 +40,6 @@
 #include <zephyr/app_memory/mem_domain.h>
 #include <zephyr/sys/kobject.h>
 #include <zephyr/kernel/thread.h>
+#include <zephyr/kernel/lock_stats.h>
 
 #endif /* ZEPHYR_INCLUDE_KERNEL_INCLUDES_H_ */
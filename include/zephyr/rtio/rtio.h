@@ -32,6 +32,7 @@
 #ifndef ZEPHYR_INCLUDE_RTIO_RTIO_H_
 #define ZEPHYR_INCLUDE_RTIO_RTIO_H_
 
+#include <string.h>
 #include <zephyr/rtio/rtio_spsc.h>
 #include <zephyr/sys/__assert.h>
 #include <zephyr/sys/atomic.h>
@@ -99,10 +100,52 @@ struct rtio_iodev;
  */
 #define RTIO_SQE_CHAINED BIT(0)
 
+/**
+ * @brief The request is resubmitted each time it completes successfully.
+ *
+ * A completion is produced for each run, until the request fails or is
+ * canceled with rtio_sqe_cancel(). The buffer is reused by each run. A
+ * multishot request may not be chained.
+ */
+#define RTIO_SQE_MULTISHOT BIT(1)
+
+/**
+ * @brief No completion is produced when the request succeeds.
+ *
+ * Useful for the first requests of a chain, whose completion is
+ * reported by the last one. Failures are still reported.
+ */
+#define RTIO_SQE_NO_RESPONSE BIT(2)
+
+/**
+ * @brief The next request is part of the same bus transaction.
+ *
+ * The iodev is given the first request of a transaction only, does all
+ * of them at once (see rtio_txn_next()), and reports the result of the
+ * transaction on the first request. The requests of a transaction are
+ * chained, as if RTIO_SQE_CHAINED was set, and use the same iodev.
+ */
+#define RTIO_SQE_TRANSACTION BIT(3)
+
 /**
  * @}
  */
 
+struct rtio;
+struct rtio_sqe;
+
+/**
+ * @brief Callback of an RTIO_OP_CALLBACK request
+ *
+ * Called by the executor, possibly from an ISR and with the executor
+ * locked, so it must not block or use the RTIO context.
+ *
+ * @param r RTIO context
+ * @param sqe Submission of the callback
+ * @param arg0 Argument given to rtio_sqe_prep_callback()
+ */
+typedef void (*rtio_callback_t)(struct rtio *r, const struct rtio_sqe *sqe, void *arg0);
+
 /**
  * @brief A submission queue event
  */
@@ -113,6 +156,8 @@ struct rtio_sqe {
 
 	uint16_t flags; /**< Op Flags */
 
+	atomic_t canceled; /**< Set by rtio_sqe_cancel() */
+
 	const struct rtio_iodev *iodev; /**< Device to operation on */
 
 	/**
@@ -125,11 +170,38 @@ struct rtio_sqe {
 	void *userdata;
 
 	union {
+		/** OP_TX, OP_RX */
 		struct {
 			uint32_t buf_len; /**< Length of buffer */
 
 			uint8_t *buf; /**< Buffer to use*/
 		};
+
+		/** OP_TINY_TX */
+		struct {
+			uint8_t tiny_buf_len; /**< Length of tiny buffer */
+
+			uint8_t tiny_buf[7]; /**< Data to write */
+		};
+
+		/** OP_TXRX */
+		struct {
+			uint32_t txrx_buf_len; /**< Length of both buffers */
+
+			uint8_t *tx_buf; /**< Buffer to write from */
+
+			uint8_t *rx_buf; /**< Buffer to read into */
+		};
+
+		/** OP_CALLBACK */
+		struct {
+			rtio_callback_t callback; /**< Function to call */
+
+			void *arg0; /**< Argument of the callback */
+		};
+
+		/** OP_DELAY */
+		k_timeout_t delay; /**< Time to wait */
 	};
 };
 
@@ -163,8 +235,6 @@ struct rtio_cq {
 	struct rtio_cqe buffer[];
 };
 
-struct rtio;
-
 struct rtio_executor_api {
 	/**
 	 * @brief Submit the request queue to executor
@@ -211,6 +281,17 @@ struct rtio_executor {
 	const struct rtio_executor_api *api;
 };
 
+#if defined(CONFIG_RTIO_OP_DELAY) || defined(__DOXYGEN__)
+/**
+ * @brief Timer of an RTIO_OP_DELAY submission, one per executor task
+ */
+struct rtio_delay {
+	struct k_timer timer;
+	struct rtio *r;
+	const struct rtio_sqe *sqe;
+};
+#endif
+
 /**
  * @brief An RTIO queue pair that both the kernel and application work with
  *
@@ -323,6 +404,22 @@ struct rtio_iodev {
 /** An operation that transmits (writes) */
 #define RTIO_OP_TX 2
 
+/** An operation that transmits a few bytes stored in the request */
+#define RTIO_OP_TINY_TX 3
+
+/** An operation that transmits and receives at the same time (full duplex) */
+#define RTIO_OP_TXRX 4
+
+/** An operation that calls a function, done by the executor */
+#define RTIO_OP_CALLBACK 5
+
+/**
+ * An operation that waits for some time, done by the executor
+ *
+ * Requires CONFIG_RTIO_OP_DELAY, fails with -ENOTSUP otherwise.
+ */
+#define RTIO_OP_DELAY 6
+
 /**
  * @brief Prepare a nop (no op) submission
  */
@@ -330,6 +427,7 @@ static inline void rtio_sqe_prep_nop(struct rtio_sqe *sqe,
 				const struct rtio_iodev *iodev,
 				void *userdata)
 {
+	memset(sqe, 0, sizeof(struct rtio_sqe));
 	sqe->op = RTIO_OP_NOP;
 	sqe->iodev = iodev;
 	sqe->userdata = userdata;
@@ -345,6 +443,7 @@ static inline void rtio_sqe_prep_read(struct rtio_sqe *sqe,
 				      uint32_t len,
 				      void *userdata)
 {
+	memset(sqe, 0, sizeof(struct rtio_sqe));
 	sqe->op = RTIO_OP_RX;
 	sqe->prio = prio;
 	sqe->iodev = iodev;
@@ -363,6 +462,7 @@ static inline void rtio_sqe_prep_write(struct rtio_sqe *sqe,
 				       uint32_t len,
 				       void *userdata)
 {
+	memset(sqe, 0, sizeof(struct rtio_sqe));
 	sqe->op = RTIO_OP_TX;
 	sqe->prio = prio;
 	sqe->iodev = iodev;
@@ -371,6 +471,128 @@ static inline void rtio_sqe_prep_write(struct rtio_sqe *sqe,
 	sqe->userdata = userdata;
 }
 
+/**
+ * @brief Prepare a multishot read op submission
+ *
+ * The read is done again in the same buffer each time it completes, until
+ * it fails or is canceled.
+ */
+static inline void rtio_sqe_prep_read_multishot(struct rtio_sqe *sqe,
+						const struct rtio_iodev *iodev,
+						int8_t prio,
+						uint8_t *buf,
+						uint32_t len,
+						void *userdata)
+{
+	rtio_sqe_prep_read(sqe, iodev, prio, buf, len, userdata);
+	sqe->flags = RTIO_SQE_MULTISHOT;
+}
+
+/**
+ * @brief Prepare a tiny write op submission
+ *
+ * The data is copied in the submission, no buffer needs to be kept.
+ */
+static inline void rtio_sqe_prep_tiny_write(struct rtio_sqe *sqe,
+					    const struct rtio_iodev *iodev,
+					    int8_t prio,
+					    const uint8_t *tiny_buf,
+					    uint8_t tiny_buf_len,
+					    void *userdata)
+{
+	memset(sqe, 0, sizeof(struct rtio_sqe));
+	__ASSERT_NO_MSG(tiny_buf_len <= sizeof(sqe->tiny_buf));
+
+	sqe->op = RTIO_OP_TINY_TX;
+	sqe->prio = prio;
+	sqe->iodev = iodev;
+	sqe->tiny_buf_len = tiny_buf_len;
+	memcpy(sqe->tiny_buf, tiny_buf, tiny_buf_len);
+	sqe->userdata = userdata;
+}
+
+/**
+ * @brief Prepare a transceive op submission
+ */
+static inline void rtio_sqe_prep_transceive(struct rtio_sqe *sqe,
+					    const struct rtio_iodev *iodev,
+					    int8_t prio,
+					    uint8_t *tx_buf,
+					    uint8_t *rx_buf,
+					    uint32_t buf_len,
+					    void *userdata)
+{
+	memset(sqe, 0, sizeof(struct rtio_sqe));
+	sqe->op = RTIO_OP_TXRX;
+	sqe->prio = prio;
+	sqe->iodev = iodev;
+	sqe->txrx_buf_len = buf_len;
+	sqe->tx_buf = tx_buf;
+	sqe->rx_buf = rx_buf;
+	sqe->userdata = userdata;
+}
+
+/**
+ * @brief Prepare a callback op submission
+ *
+ * The callback is called by the executor when the submission is reached,
+ * for instance at the end of a chain of transfers.
+ */
+static inline void rtio_sqe_prep_callback(struct rtio_sqe *sqe,
+					  rtio_callback_t callback,
+					  void *arg0,
+					  void *userdata)
+{
+	memset(sqe, 0, sizeof(struct rtio_sqe));
+	sqe->op = RTIO_OP_CALLBACK;
+	sqe->callback = callback;
+	sqe->arg0 = arg0;
+	sqe->userdata = userdata;
+}
+
+/**
+ * @brief Prepare a delay op submission
+ *
+ * Chained after a request, it delays the next one.
+ */
+static inline void rtio_sqe_prep_delay(struct rtio_sqe *sqe,
+				       k_timeout_t delay,
+				       void *userdata)
+{
+	memset(sqe, 0, sizeof(struct rtio_sqe));
+	sqe->op = RTIO_OP_DELAY;
+	sqe->delay = delay;
+	sqe->userdata = userdata;
+}
+
+/**
+ * @brief Cancel a submission
+ *
+ * A submission not started yet completes with -ECANCELED, as the rest of
+ * its chain. A started one is not interrupted, but a multishot submission
+ * is not run again.
+ *
+ * @param sqe Submission to cancel, until it completes
+ */
+static inline void rtio_sqe_cancel(struct rtio_sqe *sqe)
+{
+	/* Not a flag: the executor may be reading them concurrently */
+	(void)atomic_set(&sqe->canceled, 1);
+}
+
+/**
+ * @brief Whether a submission was canceled with rtio_sqe_cancel()
+ *
+ * @param sqe Submission
+ *
+ * @retval true The submission is canceled
+ * @retval false The submission is not canceled
+ */
+static inline bool rtio_sqe_canceled(const struct rtio_sqe *sqe)
+{
+	return atomic_get(&sqe->canceled) != 0;
+}
+
 /**
  * @brief Statically define and initialize a fixed length submission queue.
  *
@@ -459,6 +681,26 @@ static inline void rtio_iodev_submit(const struct rtio_sqe *sqe, struct rtio *r)
 	sqe->iodev->api->submit(sqe, r);
 }
 
+/**
+ * @brief Get the next request of a transaction
+ *
+ * For iodevs walking through a transaction submitted to them.
+ *
+ * @param r RTIO context
+ * @param sqe Request of the transaction
+ *
+ * @retval sqe The next request of the transaction
+ * @retval NULL @p sqe is the last request of the transaction
+ */
+static inline const struct rtio_sqe *rtio_txn_next(struct rtio *r, const struct rtio_sqe *sqe)
+{
+	if (!(sqe->flags & RTIO_SQE_TRANSACTION)) {
+		return NULL;
+	}
+
+	return rtio_spsc_next(r->sq, sqe);
+}
+
 /**
  * @brief Count of acquirable submission queue events
  *
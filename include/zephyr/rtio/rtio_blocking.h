@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2022 Intel Corporation.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef ZEPHYR_INCLUDE_RTIO_RTIO_BLOCKING_H_
+#define ZEPHYR_INCLUDE_RTIO_RTIO_BLOCKING_H_
+
+#include <zephyr/kernel.h>
+#include <zephyr/rtio/rtio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief RTIO Blocking Adapter
+ *
+ * Lets an iodev do its requests with a blocking driver API. Requests are
+ * queued in the iodev submission queue and done one after another by the
+ * system work queue, so a batch of requests costs a single wakeup and
+ * submitting never blocks, even from an ISR or with a lock held.
+ *
+ * @defgroup rtio_blocking RTIO Blocking Adapter
+ * @ingroup rtio
+ * @{
+ */
+
+/**
+ * @brief Do a request with a blocking driver API
+ *
+ * @param sqe Request, the first one of its transaction
+ * @param r RTIO context
+ *
+ * @return Result of the request, negative errno code on failure
+ */
+typedef int (*rtio_blocking_fn_t)(const struct rtio_sqe *sqe, struct rtio *r);
+
+/**
+ * @brief Blocking adapter of an iodev
+ */
+struct rtio_blocking {
+	/** Work item doing the queued requests */
+	struct k_work work;
+
+	/** Serializes the producers of the iodev submission queue */
+	struct k_spinlock lock;
+
+	/** Submission queue of the iodev */
+	struct rtio_iodev_sq *sq;
+
+	/** Function doing a request */
+	rtio_blocking_fn_t fn;
+};
+
+/** @cond INTERNAL_HIDDEN */
+void z_rtio_blocking_work_handler(struct k_work *work);
+/** @endcond */
+
+/**
+ * @brief Statically initialize a blocking adapter
+ *
+ * @param _fn Function doing a request, see rtio_blocking_fn_t
+ */
+#define RTIO_BLOCKING_INITIALIZER(_fn)                                                             \
+	{                                                                                          \
+		.work = Z_WORK_INITIALIZER(z_rtio_blocking_work_handler),                          \
+		.fn = (_fn),                                                                       \
+	}
+
+/**
+ * @brief Submit a request to a blocking adapter
+ *
+ * To be called by the submit function of the iodev. The result of the
+ * request is reported with rtio_sqe_ok() or rtio_sqe_err().
+ *
+ * @param blk Blocking adapter
+ * @param sqe Request
+ * @param r RTIO context
+ */
+void rtio_blocking_submit(struct rtio_blocking *blk, const struct rtio_sqe *sqe, struct rtio *r);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_RTIO_RTIO_BLOCKING_H_ */
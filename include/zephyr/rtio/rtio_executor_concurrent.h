@@ -78,6 +78,11 @@ struct rtio_concurrent_executor {
 
 	/* Array of struct rtio_sqe *'s one per task' */
 	struct rtio_sqe **task_cur;
+
+#ifdef CONFIG_RTIO_OP_DELAY
+	/* Array of delay timers, one per task */
+	struct rtio_delay *task_delay;
+#endif
 };
 
 /**
@@ -103,6 +108,8 @@ static const struct rtio_executor_api z_rtio_concurrent_api = {
 #define RTIO_EXECUTOR_CONCURRENT_DEFINE(name, concurrency)                                         \
 	static struct rtio_sqe *_task_cur_##name[(concurrency)];                                   \
 	uint8_t _task_status_##name[(concurrency)];                                                \
+	IF_ENABLED(CONFIG_RTIO_OP_DELAY,                                                           \
+		   (static struct rtio_delay _task_delay_##name[(concurrency)];))                  \
 	static struct rtio_concurrent_executor name = {                                            \
 		.ctx = { .api = &z_rtio_concurrent_api },                                          \
 		.task_in = 0,                                                                      \
@@ -112,6 +119,7 @@ static const struct rtio_executor_api z_rtio_concurrent_api = {
 		.last_sqe = NULL,                                                                  \
 		.task_status = _task_status_##name,                                                \
 		.task_cur = _task_cur_##name,                                                      \
+		IF_ENABLED(CONFIG_RTIO_OP_DELAY, (.task_delay = _task_delay_##name,))              \
 	};
 
 /**
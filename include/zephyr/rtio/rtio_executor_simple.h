@@ -56,6 +56,11 @@ void rtio_simple_err(struct rtio *r, const struct rtio_sqe *sqe, int result);
  */
 struct rtio_simple_executor {
 	struct rtio_executor ctx;
+
+#ifdef CONFIG_RTIO_OP_DELAY
+	/* Timer of a delay submission */
+	struct rtio_delay delay;
+#endif
 };
 
 /**
@@ -269,6 +269,13 @@ struct rtio_spsc {
 #define rtio_spsc_consumable(spsc)                                                                 \
 	({ (spsc)->_spsc.in - (spsc)->_spsc.out - (spsc)->_spsc.consume; })
 
+/**
+ * @brief Count of consumed elements not released yet
+ *
+ * @param spsc SPSC to get item count for
+ */
+#define rtio_spsc_consumed(spsc) ({ (spsc)->_spsc.consume; })
+
 /**
  * @brief Peek at the first available item in queue
  *
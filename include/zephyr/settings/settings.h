@@ -324,6 +324,53 @@ int settings_save_one(const char *name, const void *value, size_t val_len);
  */
 int settings_delete(const char *name);
 
+/**
+ * Write the items pending in the write-back cache to persisted storage.
+ *
+ * Does nothing without CONFIG_SETTINGS_WRITE_CACHE, or within a
+ * transaction of the calling thread.
+ *
+ * @return 0 on success, non-zero on failure.
+ */
+int settings_sync(void);
+
+/**
+ * Start a transaction.
+ *
+ * Items saved by the calling thread until settings_txn_commit() are
+ * written to persisted storage all together or not at all, even across a
+ * power loss. Other threads using the settings block until the transaction
+ * ends. Items saved within the transaction are not seen by loads before it
+ * is committed.
+ *
+ * Requires CONFIG_SETTINGS_WRITE_CACHE, the transaction must fit in
+ * CONFIG_SETTINGS_WRITE_CACHE_SIZE.
+ *
+ * @retval 0 on success.
+ * @retval -EALREADY if the calling thread already started a transaction.
+ * @retval -ENOENT if there is no storage back-end.
+ * @return Other negative values if writing pending items failed.
+ */
+int settings_txn_begin(void);
+
+/**
+ * Write the items saved within the transaction and end it.
+ *
+ * The transaction ends even if writing fails. Then the items are either
+ * all written the next time settings_subsys_init() is called, or not at
+ * all.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if the calling thread did not start a transaction.
+ * @return Other negative values if writing failed.
+ */
+int settings_txn_commit(void);
+
+/**
+ * Discard the items saved within the transaction and end it.
+ */
+void settings_txn_abort(void);
+
 /**
  * Call commit for all settings handler. This should apply all
  * settings which has been set, but not applied yet.
@@ -1187,6 +1187,21 @@ int shell_insert_mode_set(const struct shell *shell, bool val);
  */
 int shell_use_colors_set(const struct shell *shell, bool val);
 
+/**
+ * @brief Allow application to control whether VT100 commands are used.
+ * Disabling them is intended for non-interactive terminals, e.g. host
+ * tools: cursor movement is not sent and the command line is not redrawn
+ * around asynchronous output.
+ * Value is modified atomically and the previous value is returned.
+ *
+ * @param[in] shell	Pointer to the shell instance.
+ * @param[in] val	VT100 commands usage.
+ *
+ * @retval 0 or 1: previous value
+ * @retval -EINVAL if shell is NULL.
+ */
+int shell_use_vt100_set(const struct shell *shell, bool val);
+
 /**
  * @brief Allow application to control whether user input is echoed back.
  * Value is modified atomically and the previous value is returned.
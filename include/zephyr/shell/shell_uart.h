@@ -25,12 +25,18 @@ struct shell_uart_ctrl_blk {
 	void *context;
 	atomic_t tx_busy;
 	bool blocking_tx;
+#ifdef CONFIG_SHELL_BACKEND_SERIAL_ASYNC
+	bool rx_stopped;
+	uint8_t rx_buf_idx;
+	uint8_t rx_bufs[2][CONFIG_SHELL_BACKEND_SERIAL_ASYNC_RX_BUFFER_SIZE];
+#endif
 #ifdef CONFIG_MCUMGR_SMP_SHELL
 	struct smp_shell_data smp;
 #endif /* CONFIG_MCUMGR_SMP_SHELL */
 };
 
-#ifdef CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN
+#if defined(CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN) || \
+	defined(CONFIG_SHELL_BACKEND_SERIAL_ASYNC)
 #define Z_UART_SHELL_TX_RINGBUF_DECLARE(_name, _size) \
 	RING_BUF_DECLARE(_name##_tx_ringbuf, _size)
 
@@ -39,12 +45,12 @@ struct shell_uart_ctrl_blk {
 
 #define Z_UART_SHELL_RX_TIMER_PTR(_name) NULL
 
-#else /* CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN */
+#else
 #define Z_UART_SHELL_TX_RINGBUF_DECLARE(_name, _size) /* Empty */
 #define Z_UART_SHELL_RX_TIMER_DECLARE(_name) static struct k_timer _name##_timer
 #define Z_UART_SHELL_TX_RINGBUF_PTR(_name) NULL
 #define Z_UART_SHELL_RX_TIMER_PTR(_name) (&_name##_timer)
-#endif /* CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN */
+#endif
 
 /** @brief Shell UART transport instance structure. */
 struct shell_uart {
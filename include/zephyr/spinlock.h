@@ -57,8 +57,13 @@ struct k_spinlock {
 #endif /* CONFIG_SPIN_LOCK_TIME_LIMIT */
 #endif /* CONFIG_SPIN_VALIDATE */
 
+#ifdef CONFIG_SPIN_LOCK_STATS
+	/* Contention statistics, see k_spin_lock_stats_attach() */
+	struct k_lock_stats *stats;
+#endif
+
 #if defined(CONFIG_CPLUSPLUS) && !defined(CONFIG_SMP) && \
-	!defined(CONFIG_SPIN_VALIDATE)
+	!defined(CONFIG_SPIN_VALIDATE) && !defined(CONFIG_SPIN_LOCK_STATS)
 	/* If CONFIG_SMP and CONFIG_SPIN_VALIDATE are both not defined
 	 * the k_spinlock struct will have no members. The result
 	 * is that in C sizeof(k_spinlock) is 0 and in C++ it is 1.
@@ -92,6 +97,12 @@ bool z_spin_lock_mem_coherent(struct k_spinlock *l);
 
 #endif /* CONFIG_SPIN_VALIDATE */
 
+#ifdef CONFIG_SPIN_LOCK_STATS
+void z_spin_lock_contended(struct k_spinlock *l);
+void z_spin_lock_stats_acquired(struct k_spinlock *l);
+void z_spin_lock_stats_released(struct k_spinlock *l);
+#endif
+
 /**
  * @brief Spinlock key type
  *
@@ -152,9 +163,21 @@ static ALWAYS_INLINE k_spinlock_key_t k_spin_lock(struct k_spinlock *l)
 #endif
 
 #ifdef CONFIG_SMP
+#ifdef CONFIG_SPIN_LOCK_STATS
+	if (!atomic_cas(&l->locked, 0, 1)) {
+		z_spin_lock_contended(l);
+	}
+#else
 	while (!atomic_cas(&l->locked, 0, 1)) {
 	}
 #endif
+#endif
+
+#ifdef CONFIG_SPIN_LOCK_STATS
+	if (unlikely(l->stats != NULL)) {
+		z_spin_lock_stats_acquired(l);
+	}
+#endif
 
 #ifdef CONFIG_SPIN_VALIDATE
 	z_spin_lock_set_owner(l);
@@ -202,6 +225,12 @@ static ALWAYS_INLINE void k_spin_unlock(struct k_spinlock *l,
 #endif /* CONFIG_SPIN_LOCK_TIME_LIMIT */
 #endif /* CONFIG_SPIN_VALIDATE */
 
+#ifdef CONFIG_SPIN_LOCK_STATS
+	if (unlikely(l->stats != NULL)) {
+		z_spin_lock_stats_released(l);
+	}
+#endif
+
 #ifdef CONFIG_SMP
 	/* Strictly we don't need atomic_clear() here (which is an
 	 * exchange operation that returns the old value).  We are always
@@ -224,6 +253,11 @@ static ALWAYS_INLINE void k_spin_release(struct k_spinlock *l)
 #ifdef CONFIG_SPIN_VALIDATE
 	__ASSERT(z_spin_unlock_valid(l), "Not my spinlock %p", l);
 #endif
+#ifdef CONFIG_SPIN_LOCK_STATS
+	if (unlikely(l->stats != NULL)) {
+		z_spin_lock_stats_released(l);
+	}
+#endif
 #ifdef CONFIG_SMP
 	atomic_clear(&l->locked);
 #endif
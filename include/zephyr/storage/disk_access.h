@@ -100,6 +100,22 @@ int disk_access_write(const char *pdrv, const uint8_t *data_buf,
  */
 int disk_access_ioctl(const char *pdrv, uint8_t cmd, void *buff);
 
+#if defined(CONFIG_DISK_CACHE) || defined(__DOXYGEN__)
+/**
+ * @brief Get the block cache statistics of a disk
+ *
+ * Function to get the statistics of the block cache enabled with
+ * CONFIG_DISK_CACHE, accumulated since the disk was registered.
+ *
+ * @param[in] pdrv          Disk name
+ * @param[out] stats        Statistics of the disk
+ *
+ * @return 0 on success, negative errno code on fail
+ */
+int disk_access_cache_stats_get(const char *pdrv,
+				struct disk_cache_stats *stats);
+#endif /* CONFIG_DISK_CACHE */
+
 #ifdef __cplusplus
 }
 #endif
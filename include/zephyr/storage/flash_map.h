@@ -182,6 +182,24 @@ int flash_area_write(const struct flash_area *fa, off_t off, const void *src,
  */
 int flash_area_erase(const struct flash_area *fa, off_t off, size_t len);
 
+#if defined(CONFIG_FLASH_ASYNC) || defined(__DOXYGEN__)
+struct flash_async_req;
+
+/**
+ * @brief Submit an asynchronous request to a flash area
+ *
+ * The request offset is relative to the beginning of the flash area; it is
+ * translated to a device offset before the request is submitted to the
+ * flash device, see flash_submit().
+ *
+ * @param[in] fa  Flash area
+ * @param[in] req Request, with op, offset, data, len and cb set
+ *
+ * @return  0 if the request is queued, negative errno code on fail.
+ */
+int flash_area_submit(const struct flash_area *fa, struct flash_async_req *req);
+#endif /* CONFIG_FLASH_ASYNC */
+
 /**
  * @brief Get write block size of the flash area
  *
@@ -63,6 +63,15 @@ struct stream_flash_ctx {
 #ifdef CONFIG_STREAM_FLASH_ERASE
 	off_t last_erased_page_start_offset; /* Last erased offset */
 #endif
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	uint8_t *buf_base; /* Start of both buffer halves */
+	uint8_t *buf_alt; /* Buffer half not being filled */
+	size_t pending_bytes; /* Bytes being written from buf_alt */
+	int result; /* First error of the pending requests */
+	struct flash_async_req erase_req; /* Erase before the pending write */
+	struct flash_async_req write_req; /* Pending write */
+	struct k_sem write_done; /* Given on completion of write_req */
+#endif
 };
 
 /**
@@ -73,6 +82,8 @@ struct stream_flash_ctx {
  * @param buf Write buffer
  * @param buf_len Length of write buffer. Can not be larger than the page size.
  *                Must be multiple of the flash device write-block-size.
+ *                With CONFIG_STREAM_FLASH_ASYNC, the buffer is used as two
+ *                halves and must be a multiple of twice the write-block-size.
  * @param offset Offset within flash device to start writing to
  * @param size Number of bytes available for performing buffered write.
  *             If this is '0', the size will be set to the total size
@@ -91,7 +102,8 @@ int stream_flash_init(struct stream_flash_ctx *ctx, const struct device *fdev,
  *
  * @param ctx context
  *
- * @return Number of payload bytes written to flash.
+ * @return Number of payload bytes written to flash. With
+ * CONFIG_STREAM_FLASH_ASYNC, bytes still being written are not counted.
  */
 size_t stream_flash_bytes_written(struct stream_flash_ctx *ctx);
 
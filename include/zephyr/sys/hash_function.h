@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Hash functions for hash tables
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_HASH_FUNCTION_H_
+#define ZEPHYR_INCLUDE_SYS_HASH_FUNCTION_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup hash_functions Hash Functions
+ * @ingroup datastructure_apis
+ *
+ * Fast, non-cryptographic hash functions spreading keys over all the bits
+ * of the result, so that a table can use the lower bits as an index.
+ *
+ * @{
+ */
+
+/**
+ * @brief Hash a buffer with 32-bit FNV-1a
+ *
+ * @param data Buffer.
+ * @param len Length of @p data in bytes.
+ *
+ * @return Hash of the buffer.
+ */
+static inline uint32_t sys_hash32_fnv1a(const void *data, size_t len)
+{
+	const uint8_t *p = (const uint8_t *)data;
+	uint32_t h = 2166136261U;
+
+	for (size_t i = 0; i < len; i++) {
+		h = (h ^ p[i]) * 16777619U;
+	}
+
+	return h;
+}
+
+/**
+ * @brief Hash a 32-bit integer
+ *
+ * This is the finalizer of MurmurHash3, a bijection mixing every bit of
+ * the input in every bit of the result.
+ *
+ * @param x Integer.
+ *
+ * @return Hash of the integer.
+ */
+static inline uint32_t sys_hash32_u32(uint32_t x)
+{
+	x ^= x >> 16;
+	x *= 0x85ebca6bU;
+	x ^= x >> 13;
+	x *= 0xc2b2ae35U;
+	x ^= x >> 16;
+
+	return x;
+}
+
+/**
+ * @brief Hash a pointer sized integer
+ *
+ * @param x Integer, for instance a pointer cast to uintptr_t.
+ *
+ * @return Hash of the integer.
+ */
+static inline uint32_t sys_hash32_uptr(uintptr_t x)
+{
+#if UINTPTR_MAX > UINT32_MAX
+	return sys_hash32_u32((uint32_t)x ^ sys_hash32_u32((uint32_t)(x >> 32)));
+#else
+	return sys_hash32_u32((uint32_t)x);
+#endif
+}
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_HASH_FUNCTION_H_ */
@@ -0,0 +1,252 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Intrusive chained hash table
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_HTABLE_H_
+#define ZEPHYR_INCLUDE_SYS_HTABLE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/hash_function.h>
+#include <zephyr/sys/slist.h>
+#include <zephyr/sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup htable_apis Hash Table
+ * @ingroup datastructure_apis
+ *
+ * A hash table of nodes embedded in user structs, chained in a
+ * power-of-2 number of buckets provided by the user, so it never
+ * allocates memory. The user computes the hash of the keys, for instance
+ * with @ref hash_functions, and compares keys with a callback, so any key
+ * type can be used. Nodes with the same key can be inserted.
+ *
+ * Finding, inserting and removing a node costs a walk of its bucket, O(1)
+ * on average if there are about as many buckets as nodes.
+ *
+ * Unlike the other data structures, a table can be given one spinlock per
+ * bucket, so that contexts working on different buckets do not contend.
+ * The locks protect the links of the table, not the nodes: the user must
+ * still make sure that a node found is not removed while it is used.
+ *
+ * @{
+ */
+
+/**
+ * @brief Hash table node
+ */
+struct sys_hnode {
+	/** @cond INTERNAL_HIDDEN */
+	sys_snode_t node;
+	uint32_t hash;
+	/** @endcond */
+};
+
+/**
+ * @brief Hash table key comparison predicate
+ *
+ * @param node Node with the hash of the key looked up.
+ * @param key Key looked up, as passed to sys_htable_find().
+ *
+ * @return true if the key of @p node is @p key.
+ */
+typedef bool (*sys_htable_eq_t)(const struct sys_hnode *node, const void *key);
+
+/**
+ * @brief Hash table
+ */
+struct sys_htable {
+	/** @cond INTERNAL_HIDDEN */
+	sys_slist_t *buckets;
+	uint32_t mask;
+	atomic_t size;
+	struct k_spinlock *locks;
+	/** @endcond */
+};
+
+/**
+ * @brief Statically initialize a hash table
+ *
+ * @param _buckets Array of buckets.
+ * @param _n_buckets Number of buckets, a power of 2.
+ * @param _locks Array of @p _n_buckets spinlocks, or NULL.
+ */
+#define SYS_HTABLE_INITIALIZER(_buckets, _n_buckets, _locks)		\
+	{								\
+		.buckets = (_buckets),					\
+		.mask = (_n_buckets) - 1,				\
+		.locks = (_locks),					\
+	}
+
+/** @cond INTERNAL_HIDDEN */
+#define Z_SYS_HTABLE_BUCKETS_DEFINE(name, n_buckets)			\
+	BUILD_ASSERT(((n_buckets) & ((n_buckets) - 1)) == 0 &&		\
+		     (n_buckets) > 0,					\
+		     "Number of buckets must be a power of 2");		\
+	static sys_slist_t _htable_buckets_##name[n_buckets]
+/** @endcond */
+
+/**
+ * @brief Define a hash table
+ *
+ * @param name Name of the hash table.
+ * @param n_buckets Number of buckets, a power of 2.
+ */
+#define SYS_HTABLE_DEFINE(name, n_buckets)				\
+	Z_SYS_HTABLE_BUCKETS_DEFINE(name, n_buckets);			\
+	struct sys_htable name = SYS_HTABLE_INITIALIZER(		\
+		_htable_buckets_##name, n_buckets, NULL)
+
+/**
+ * @brief Define a hash table with one spinlock per bucket
+ *
+ * @param name Name of the hash table.
+ * @param n_buckets Number of buckets, a power of 2.
+ */
+#define SYS_HTABLE_DEFINE_LOCKED(name, n_buckets)			\
+	Z_SYS_HTABLE_BUCKETS_DEFINE(name, n_buckets);			\
+	static struct k_spinlock _htable_locks_##name[n_buckets];	\
+	struct sys_htable name = SYS_HTABLE_INITIALIZER(		\
+		_htable_buckets_##name, n_buckets, _htable_locks_##name)
+
+/**
+ * @brief Initialize a hash table
+ *
+ * @param ht Hash table.
+ * @param buckets Array of buckets.
+ * @param n_buckets Number of buckets, a power of 2.
+ * @param locks Array of @p n_buckets spinlocks, or NULL for a table
+ *		locked by the user.
+ */
+void sys_htable_init(struct sys_htable *ht, sys_slist_t *buckets,
+		     uint32_t n_buckets, struct k_spinlock *locks);
+
+/**
+ * @brief Insert a node in a hash table
+ *
+ * @param ht Hash table.
+ * @param node Node, not in a table.
+ * @param hash Hash of the key of the node.
+ */
+void sys_htable_insert(struct sys_htable *ht, struct sys_hnode *node,
+		       uint32_t hash);
+
+/**
+ * @brief Find a node in a hash table
+ *
+ * @param ht Hash table.
+ * @param hash Hash of @p key.
+ * @param eq Key comparison predicate.
+ * @param key Key, passed to @p eq.
+ *
+ * @return The most recently inserted node with the key, or NULL.
+ */
+struct sys_hnode *sys_htable_find(struct sys_htable *ht, uint32_t hash,
+				  sys_htable_eq_t eq, const void *key);
+
+/**
+ * @brief Remove a node from a hash table
+ *
+ * @param ht Hash table.
+ * @param node Node.
+ *
+ * @return true if the node was in the table.
+ */
+bool sys_htable_remove(struct sys_htable *ht, struct sys_hnode *node);
+
+/**
+ * @brief Get the next node of a hash table
+ *
+ * Nodes are visited by bucket, in no particular order. The table must
+ * not be modified while it is walked, except for removing the node
+ * visited with SYS_HTABLE_FOR_EACH_SAFE().
+ *
+ * @param ht Hash table.
+ * @param node Current node, or NULL to get the first one.
+ *
+ * @return The next node, or NULL at the end of the table.
+ */
+struct sys_hnode *sys_htable_next(const struct sys_htable *ht,
+				  const struct sys_hnode *node);
+
+/**
+ * @brief Get the number of nodes in a hash table
+ *
+ * @param ht Hash table.
+ *
+ * @return Number of nodes.
+ */
+static inline size_t sys_htable_size(struct sys_htable *ht)
+{
+	return (size_t)atomic_get(&ht->size);
+}
+
+/**
+ * @brief Get the hash of a hash table node
+ *
+ * @param hn Hash table node.
+ *
+ * @return Hash given when the node was inserted.
+ */
+static inline uint32_t sys_hnode_hash(const struct sys_hnode *hn)
+{
+	return hn->hash;
+}
+
+/**
+ * @brief Walk the nodes of a hash table
+ *
+ * @param ht Hash table.
+ * @param hn Loop variable, a struct sys_hnode pointer.
+ */
+#define SYS_HTABLE_FOR_EACH(ht, hn)					\
+	for (hn = sys_htable_next(ht, NULL); hn != NULL;		\
+	     hn = sys_htable_next(ht, hn))
+
+/**
+ * @brief Walk the nodes of a hash table, allowing to remove the node
+ *
+ * @param ht Hash table.
+ * @param hn Loop variable, a struct sys_hnode pointer.
+ * @param hns Another struct sys_hnode pointer, for internal use.
+ */
+#define SYS_HTABLE_FOR_EACH_SAFE(ht, hn, hns)				\
+	for (hn = sys_htable_next(ht, NULL),				\
+	     hns = (hn != NULL) ? sys_htable_next(ht, hn) : NULL;	\
+	     hn != NULL;						\
+	     hn = hns, hns = (hn != NULL) ? sys_htable_next(ht, hn) : NULL)
+
+/**
+ * @brief Walk the structs containing the nodes of a hash table
+ *
+ * @param ht Hash table.
+ * @param cn Loop variable, a pointer to the containing struct.
+ * @param field Name of the struct sys_hnode member in the containing struct.
+ */
+#define SYS_HTABLE_FOR_EACH_CONTAINER(ht, cn, field)			\
+	for (struct sys_hnode *_hn = sys_htable_next(ht, NULL);		\
+	     (_hn != NULL) &&						\
+	     ((cn = CONTAINER_OF(_hn, __typeof__(*cn), field)), true);	\
+	     _hn = sys_htable_next(ht, _hn))
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_HTABLE_H_ */
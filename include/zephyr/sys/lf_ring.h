@@ -0,0 +1,320 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_LF_RING_H_
+#define ZEPHYR_INCLUDE_SYS_LF_RING_H_
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Lock-free ring buffers
+ * @defgroup lf_ring_apis Lock-free Ring Buffer APIs
+ * @ingroup datastructure_apis
+ *
+ * Byte ring buffers safe to use from several contexts without a lock. Each
+ * ring is single or multi producer and single or multi consumer, see
+ * @ref LF_RING_SPSC, @ref LF_RING_MPSC and @ref LF_RING_MPMC.
+ *
+ * Unlike @ref ring_buffer_apis, the size is a power of 2, so positions wrap
+ * with a mask, and the producer and consumer positions are kept in separate
+ * cache lines (see @kconfig{CONFIG_LF_RING_CACHE_LINE_SIZE}) so the two
+ * sides do not invalidate each other's cache on SMP.
+ *
+ * Data is written and read in place with claim and finish calls, which work
+ * on as many bytes as are contiguous in the buffer, so a batch costs a
+ * single atomic update on each side.
+ *
+ * On the multi producer (consumer) side a claim reserves bytes atomically.
+ * Claims are published once every claim started before them is finished,
+ * by whichever finishes last, so a context preempted in the middle of a
+ * claim only delays the publication of later claims and never blocks the
+ * context preempting it. Producers (consumers) never wait for each other.
+ *
+ * @{
+ */
+
+/** Single producer: puts are done from one context at a time. */
+#define LF_RING_SP BIT(0)
+
+/** Single consumer: gets are done from one context at a time. */
+#define LF_RING_SC BIT(1)
+
+/** Single producer, single consumer ring. */
+#define LF_RING_SPSC (LF_RING_SP | LF_RING_SC)
+
+/** Multi producer, single consumer ring. */
+#define LF_RING_MPSC LF_RING_SC
+
+/** Multi producer, multi consumer ring. */
+#define LF_RING_MPMC 0
+
+/** @cond INTERNAL_HIDDEN */
+
+#if CONFIG_LF_RING_CACHE_LINE_SIZE > 0
+#define Z_LF_RING_ALIGN CONFIG_LF_RING_CACHE_LINE_SIZE
+#else
+#define Z_LF_RING_ALIGN sizeof(atomic_t)
+#endif
+
+/*
+ * Head and tail are each a position and, on the multi producer (consumer)
+ * side, the number of claims started (finished), packed in one atomic
+ * variable so both are updated at once.
+ */
+#define Z_LF_RING_POS_BITS (ATOMIC_BITS / 2)
+#define Z_LF_RING_POS_MASK ((1UL << Z_LF_RING_POS_BITS) - 1UL)
+
+struct z_lf_ring_headtail {
+	/* Claimed up to here */
+	atomic_t head;
+	/* Published up to here */
+	atomic_t tail;
+} __aligned(Z_LF_RING_ALIGN);
+
+/** @endcond */
+
+/** Largest ring size, positions must be able to count up to twice the size. */
+#define LF_RING_MAX_SIZE (1UL << (Z_LF_RING_POS_BITS - 1))
+
+/**
+ * @brief Lock-free ring buffer
+ */
+struct lf_ring {
+	/** @cond INTERNAL_HIDDEN */
+	struct z_lf_ring_headtail prod;
+	struct z_lf_ring_headtail cons;
+
+	/* Not modified after initialization */
+	uint8_t *buffer __aligned(Z_LF_RING_ALIGN);
+	uint32_t size;
+	uint32_t flags;
+#ifdef CONFIG_POLL
+	struct k_poll_signal *data_signal;
+	struct k_poll_signal *space_signal;
+#endif
+	/** @endcond */
+};
+
+/**
+ * @brief Statically initialize a ring buffer
+ *
+ * @param _buffer Buffer of the ring.
+ * @param _size Size of @p _buffer in bytes, a power of 2.
+ * @param _flags @ref LF_RING_SPSC, @ref LF_RING_MPSC or @ref LF_RING_MPMC.
+ */
+#define LF_RING_INITIALIZER(_buffer, _size, _flags)			\
+	{								\
+		.buffer = (_buffer),					\
+		.size = (_size),					\
+		.flags = (_flags),					\
+	}
+
+/**
+ * @brief Define a ring buffer
+ *
+ * The ring can be accessed outside the module where it is defined using:
+ *
+ * @code extern struct lf_ring <name>; @endcode
+ *
+ * @param name Name of the ring.
+ * @param size8 Size of the ring in bytes, a power of 2.
+ * @param flags @ref LF_RING_SPSC, @ref LF_RING_MPSC or @ref LF_RING_MPMC.
+ */
+#define LF_RING_DEFINE(name, size8, flags)				\
+	BUILD_ASSERT(((size8) & ((size8) - 1)) == 0 &&			\
+		     (size8) > 0 && (size8) <= LF_RING_MAX_SIZE,	\
+		     "Size must be a power of 2");			\
+	static uint8_t __noinit _lf_ring_data_##name[size8];		\
+	struct lf_ring name =						\
+		LF_RING_INITIALIZER(_lf_ring_data_##name, size8, flags)
+
+/**
+ * @brief Initialize a ring buffer
+ *
+ * @param ring Ring.
+ * @param buffer Buffer of the ring.
+ * @param size Size of @p buffer in bytes, a power of 2 up to
+ *	       @ref LF_RING_MAX_SIZE.
+ * @param flags @ref LF_RING_SPSC, @ref LF_RING_MPSC or @ref LF_RING_MPMC.
+ */
+void lf_ring_init(struct lf_ring *ring, uint8_t *buffer, uint32_t size,
+		  uint32_t flags);
+
+/**
+ * @brief Empty a ring buffer
+ *
+ * Must not be called while the ring is used by another context.
+ *
+ * @param ring Ring.
+ */
+void lf_ring_reset(struct lf_ring *ring);
+
+#if defined(CONFIG_POLL) || defined(__DOXYGEN__)
+/**
+ * @brief Set the signals raised by a ring buffer
+ *
+ * A context waiting for data (space) in the ring can k_poll() a signal,
+ * instead of polling the ring. It resets the signal before checking the
+ * ring, so that no data (space) made available in between is missed.
+ *
+ * @param ring Ring.
+ * @param data_signal Raised when data is put in an empty ring, may be NULL.
+ * @param space_signal Raised when data is got from a full ring, may be NULL.
+ */
+void lf_ring_signals_set(struct lf_ring *ring,
+			 struct k_poll_signal *data_signal,
+			 struct k_poll_signal *space_signal);
+#endif
+
+/**
+ * @brief Claim contiguous space to put data in a ring buffer
+ *
+ * On the single producer side, several claims can be made before a single
+ * lf_ring_put_finish() for all of them, which may put less than claimed.
+ * On the multi producer side, each claim of a non-zero size must be
+ * followed by one lf_ring_put_finish() of the whole claimed size.
+ *
+ * @param ring Ring.
+ * @param data Set to the claimed space.
+ * @param size Number of bytes wanted.
+ *
+ * @return Number of bytes claimed, smaller than @p size if the ring does not
+ *	   have as much contiguous free space.
+ */
+uint32_t lf_ring_put_claim(struct lf_ring *ring, uint8_t **data, uint32_t size);
+
+/**
+ * @brief Make claimed data available to the consumers
+ *
+ * @param ring Ring.
+ * @param size Number of bytes put, see lf_ring_put_claim().
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if @p size is larger than the claimed space.
+ */
+int lf_ring_put_finish(struct lf_ring *ring, uint32_t size);
+
+/**
+ * @brief Copy data to a ring buffer
+ *
+ * The data is put with a single claim, so with multiple producers it is not
+ * interleaved with the data of other producers.
+ *
+ * @param ring Ring.
+ * @param data Data.
+ * @param size Size of @p data.
+ *
+ * @return Number of bytes put, smaller than @p size if the ring is full.
+ */
+uint32_t lf_ring_put(struct lf_ring *ring, const uint8_t *data, uint32_t size);
+
+/**
+ * @brief Claim contiguous data to get from a ring buffer
+ *
+ * The claim rules of lf_ring_put_claim() apply to the consumer side.
+ *
+ * @param ring Ring.
+ * @param data Set to the claimed data.
+ * @param size Number of bytes wanted.
+ *
+ * @return Number of bytes claimed, smaller than @p size if the ring does not
+ *	   have as much contiguous data.
+ */
+uint32_t lf_ring_get_claim(struct lf_ring *ring, uint8_t **data, uint32_t size);
+
+/**
+ * @brief Free claimed data for the producers
+ *
+ * @param ring Ring.
+ * @param size Number of bytes got, see lf_ring_get_claim().
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if @p size is larger than the claimed data.
+ */
+int lf_ring_get_finish(struct lf_ring *ring, uint32_t size);
+
+/**
+ * @brief Copy data from a ring buffer
+ *
+ * @param ring Ring.
+ * @param data Buffer for the data, may be NULL to discard it.
+ * @param size Size of @p data.
+ *
+ * @return Number of bytes got, smaller than @p size if the ring has less
+ *	   data.
+ */
+uint32_t lf_ring_get(struct lf_ring *ring, uint8_t *data, uint32_t size);
+
+/** @cond INTERNAL_HIDDEN */
+static inline uint32_t z_lf_ring_pos(const atomic_t *ht)
+{
+	return (unsigned long)atomic_get(ht) & Z_LF_RING_POS_MASK;
+}
+/** @endcond */
+
+/**
+ * @brief Get the number of bytes that can be got from a ring buffer
+ *
+ * @param ring Ring.
+ *
+ * @return Number of published bytes not yet claimed by a consumer.
+ */
+static inline uint32_t lf_ring_size_get(struct lf_ring *ring)
+{
+	return (z_lf_ring_pos(&ring->prod.tail) - z_lf_ring_pos(&ring->cons.head)) &
+	       Z_LF_RING_POS_MASK;
+}
+
+/**
+ * @brief Get the number of bytes that can be put in a ring buffer
+ *
+ * @param ring Ring.
+ *
+ * @return Number of free bytes not yet claimed by a producer.
+ */
+static inline uint32_t lf_ring_space_get(struct lf_ring *ring)
+{
+	return ring->size - ((z_lf_ring_pos(&ring->prod.head) -
+			      z_lf_ring_pos(&ring->cons.tail)) & Z_LF_RING_POS_MASK);
+}
+
+/**
+ * @brief Determine if a ring buffer has no data to get
+ *
+ * @param ring Ring.
+ *
+ * @return true if lf_ring_get_claim() would claim nothing.
+ */
+static inline bool lf_ring_is_empty(struct lf_ring *ring)
+{
+	return lf_ring_size_get(ring) == 0;
+}
+
+/**
+ * @brief Get the size of a ring buffer
+ *
+ * @param ring Ring.
+ *
+ * @return Size of the ring in bytes.
+ */
+static inline uint32_t lf_ring_capacity_get(struct lf_ring *ring)
+{
+	return ring->size;
+}
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_LF_RING_H_ */
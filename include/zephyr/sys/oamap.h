@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Open addressing hash map
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_OAMAP_H_
+#define ZEPHYR_INCLUDE_SYS_OAMAP_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup oamap_apis Open Addressing Map
+ * @ingroup datastructure_apis
+ *
+ * A map of integer keys, for instance pointers or identifiers, to pointer
+ * values, stored in an array of slots provided by the user. Collisions are
+ * resolved by linear probing, so a lookup usually reads a single cache
+ * line, unlike @ref htable_apis. Removal shifts the following entries back
+ * instead of leaving tombstones, so lookups do not slow down over time.
+ *
+ * The array must keep a quarter of its slots free, see
+ * @ref SYS_OAMAP_MAX_SIZE. A map can be moved to a larger (or smaller)
+ * array with sys_oamap_resize(), which moves a few entries at each
+ * insertion or removal, so that no operation costs a full rehash.
+ *
+ * The keys 0 and UINTPTR_MAX are reserved. Like the other data structures,
+ * maps are not synchronized: a probe sequence can span many slots, so the
+ * user locks the whole map.
+ *
+ * @{
+ */
+
+/** @cond INTERNAL_HIDDEN */
+#define Z_SYS_OAMAP_KEY_EMPTY ((uintptr_t)0)
+#define Z_SYS_OAMAP_KEY_DELETED UINTPTR_MAX
+/** @endcond */
+
+/** Number of slots moved to the new array by each insertion or removal. */
+#define SYS_OAMAP_RESIZE_STEP 4
+
+/**
+ * @brief Largest number of entries of a map
+ *
+ * @param capacity Number of slots of the map.
+ */
+#define SYS_OAMAP_MAX_SIZE(capacity) ((capacity) / 4 * 3)
+
+/**
+ * @brief Open addressing map slot
+ */
+struct sys_oamap_slot {
+	/** Key, or 0 if the slot is free. */
+	uintptr_t key;
+	/** Value. */
+	void *value;
+};
+
+/**
+ * @brief Open addressing map
+ */
+struct sys_oamap {
+	/** @cond INTERNAL_HIDDEN */
+	struct sys_oamap_slot *slots;
+	uint32_t mask;
+	uint32_t size;
+
+	/* Array being moved to slots while resizing, NULL otherwise.
+	 * Moved entries are replaced with deleted keys, so the remaining
+	 * ones are still found.
+	 */
+	struct sys_oamap_slot *old_slots;
+	uint32_t old_mask;
+	uint32_t moved;
+	/** @endcond */
+};
+
+/**
+ * @brief Statically initialize a map
+ *
+ * @param _slots Array of free slots.
+ * @param _capacity Number of slots, a power of 2 of at least 4.
+ */
+#define SYS_OAMAP_INITIALIZER(_slots, _capacity)			\
+	{								\
+		.slots = (_slots),					\
+		.mask = (_capacity) - 1,				\
+	}
+
+/**
+ * @brief Define a map
+ *
+ * @param name Name of the map.
+ * @param capacity Number of slots, a power of 2 of at least 4.
+ */
+#define SYS_OAMAP_DEFINE(name, capacity)				\
+	BUILD_ASSERT(((capacity) & ((capacity) - 1)) == 0 &&		\
+		     (capacity) >= 4,					\
+		     "Capacity must be a power of 2 of at least 4");	\
+	static struct sys_oamap_slot _oamap_slots_##name[capacity];	\
+	struct sys_oamap name =						\
+		SYS_OAMAP_INITIALIZER(_oamap_slots_##name, capacity)
+
+/**
+ * @brief Initialize a map
+ *
+ * @param map Map.
+ * @param slots Array of slots.
+ * @param capacity Number of slots, a power of 2 of at least 4.
+ */
+void sys_oamap_init(struct sys_oamap *map, struct sys_oamap_slot *slots,
+		    uint32_t capacity);
+
+/**
+ * @brief Insert or replace an entry of a map
+ *
+ * @param map Map.
+ * @param key Key.
+ * @param value Value.
+ * @param old_value Set to the value replaced, may be NULL.
+ *
+ * @retval 1 if the key was inserted.
+ * @retval 0 if the value of the key was replaced.
+ * @retval -EINVAL if the key is reserved.
+ * @retval -ENOMEM if the map is full.
+ */
+int sys_oamap_insert(struct sys_oamap *map, uintptr_t key, void *value,
+		     void **old_value);
+
+/**
+ * @brief Get the value of a key of a map
+ *
+ * @param map Map.
+ * @param key Key.
+ * @param value Set to the value of the key, may be NULL.
+ *
+ * @return true if the key is in the map.
+ */
+bool sys_oamap_get(const struct sys_oamap *map, uintptr_t key, void **value);
+
+/**
+ * @brief Remove a key from a map
+ *
+ * @param map Map.
+ * @param key Key.
+ * @param value Set to the value of the key, may be NULL.
+ *
+ * @return true if the key was in the map.
+ */
+bool sys_oamap_remove(struct sys_oamap *map, uintptr_t key, void **value);
+
+/**
+ * @brief Start moving a map to another array of slots
+ *
+ * The previous array is still used until sys_oamap_is_resizing() returns
+ * false, which happens after enough insertions and removals, or after
+ * sys_oamap_resize_finish().
+ *
+ * @param map Map.
+ * @param slots Array of slots.
+ * @param capacity Number of slots, a power of 2 of at least 4.
+ *
+ * @retval 0 on success.
+ * @retval -EBUSY if the map is already being resized.
+ * @retval -ENOMEM if the array is too small for the entries of the map.
+ */
+int sys_oamap_resize(struct sys_oamap *map, struct sys_oamap_slot *slots,
+		     uint32_t capacity);
+
+/**
+ * @brief Finish moving a map to another array of slots
+ *
+ * @param map Map.
+ */
+void sys_oamap_resize_finish(struct sys_oamap *map);
+
+/**
+ * @brief Check whether a map is moving to another array of slots
+ *
+ * @param map Map.
+ *
+ * @return true if the previous array is still in use.
+ */
+static inline bool sys_oamap_is_resizing(const struct sys_oamap *map)
+{
+	return map->old_slots != NULL;
+}
+
+/**
+ * @brief Get the number of entries of a map
+ *
+ * @param map Map.
+ *
+ * @return Number of entries.
+ */
+static inline uint32_t sys_oamap_size(const struct sys_oamap *map)
+{
+	return map->size;
+}
+
+/**
+ * @brief Get the next entry of a map
+ *
+ * The map must not be modified while it is walked.
+ *
+ * @param map Map.
+ * @param slot Current entry, or NULL to get the first one.
+ *
+ * @return The next entry, or NULL at the end of the map.
+ */
+struct sys_oamap_slot *sys_oamap_next(const struct sys_oamap *map,
+				      const struct sys_oamap_slot *slot);
+
+/**
+ * @brief Walk the entries of a map
+ *
+ * @param map Map.
+ * @param slot Loop variable, a struct sys_oamap_slot pointer.
+ */
+#define SYS_OAMAP_FOR_EACH(map, slot)					\
+	for (slot = sys_oamap_next(map, NULL); slot != NULL;		\
+	     slot = sys_oamap_next(map, slot))
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_OAMAP_H_ */
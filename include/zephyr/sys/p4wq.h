@@ -11,6 +11,7 @@
 /* Zephyr Pooled Parallel Preemptible Priority-based Work Queues */
 
 struct k_p4wq_work;
+struct z_p4wq_rq;
 
 /**
  * P4 Queue handler callback
@@ -40,18 +41,43 @@ struct k_p4wq_work {
 	};
 	struct k_thread *thread;
 	struct k_p4wq *queue;
+	struct z_p4wq_rq *rq;
+
+	/* Priority the item runs at, raised by a thread waiting for it */
+	int32_t run_prio;
+
+	/* Thread woken up for the item, until it takes any item */
+	struct k_thread *woken;
 };
 
 #define K_P4WQ_QUEUE_PER_THREAD		BIT(0)
 #define K_P4WQ_DELAYED_START		BIT(1)
 #define K_P4WQ_USER_CPU_MASK		BIT(2)
 
+#ifdef CONFIG_P4WQ_PER_CPU_QUEUES
+#define Z_P4WQ_NUM_RQ CONFIG_MP_MAX_NUM_CPUS
+#else
+#define Z_P4WQ_NUM_RQ 1
+#endif
+
+/* Run queue of a P4 Queue */
+struct z_p4wq_rq {
+	struct k_spinlock lock;
+
+	/* Work items waiting for processing */
+	struct rbtree queue;
+
+	/* Work items submitted here and in progress */
+	sys_dlist_t active;
+};
+
 /**
  * @brief P4 Queue
  *
  * Kernel pooled parallel preemptible priority-based work queue
  */
 struct k_p4wq {
+	/* Protects waitq */
 	struct k_spinlock lock;
 
 	/* Pending threads waiting for work items
@@ -65,11 +91,16 @@ struct k_p4wq {
 	 */
 	_wait_q_t waitq;
 
-	/* Work items waiting for processing */
-	struct rbtree queue;
+	/* One run queue per CPU with CONFIG_P4WQ_PER_CPU_QUEUES, so
+	 * submissions from different CPUs do not contend
+	 */
+	struct z_p4wq_rq rq[Z_P4WQ_NUM_RQ];
 
-	/* Work items in progress */
-	sys_dlist_t active;
+	/* Number of work items in the run queues */
+	atomic_t pending;
+
+	/* Number of threads waiting for work items */
+	atomic_t idle;
 
 	/* K_P4WQ_* flags above */
 	uint32_t flags;
@@ -173,6 +204,11 @@ void k_p4wq_add_thread(struct k_p4wq *queue, struct k_thread *thread,
  * higher-priority work items are available.  The handler may be
  * invoked on any CPU.
  *
+ * With @kconfig{CONFIG_P4WQ_PER_CPU_QUEUES}, the item is queued on the
+ * current CPU, and the priority and deadline order is only guaranteed
+ * between the items submitted on the same CPU.  Idle threads take
+ * items queued on other CPUs.
+ *
  * The caller must not mutate the struct while it is stored in the
  * queue.  The memory should remain unchanged until k_p4wq_cancel() is
  * called or until the entry to the handler function.
@@ -201,6 +237,13 @@ bool k_p4wq_cancel(struct k_p4wq *queue, struct k_p4wq_work *item);
 
 /**
  * @brief Regain ownership of the work item, wait for completion if it's synchronous
+ *
+ * While waiting for a synchronous item, the caller lends its priority
+ * to the item if it is higher: a running item's thread is boosted until
+ * it takes its next item, and a queued item is moved ahead of lower
+ * priority ones, the thread woken up for it being boosted too.  The
+ * priority field of the item is left unchanged, the next submission
+ * runs at that priority again.
  */
 int k_p4wq_wait(struct k_p4wq_work *work, k_timeout_t timeout);
 
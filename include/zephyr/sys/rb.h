@@ -38,6 +38,11 @@
  * structure of the tree being generated dynamically via a stack as
  * the tree is recursed.  So the overall memory overhead of a node is
  * just two pointers, identical with a doubly-linked list.
+ *
+ * With CONFIG_RB_PARENT_POINTERS, nodes store a third pointer to their
+ * parent instead.  Insertion, removal and iteration then walk up the
+ * tree through it, without searching the path from the root again or
+ * building a stack, at the cost of one more pointer per node.
  */
 
 #ifndef ZEPHYR_INCLUDE_SYS_RB_H_
@@ -48,6 +53,9 @@
 
 struct rbnode {
 	struct rbnode *children[2];
+#ifdef CONFIG_RB_PARENT_POINTERS
+	struct rbnode *parent;
+#endif
 };
 
 /* Theoretical maximum depth of tree based on pointer size. If memory
@@ -80,11 +88,25 @@ struct rbnode {
  */
 typedef bool (*rb_lessthan_t)(struct rbnode *a, struct rbnode *b);
 
+/**
+ * @typedef rb_augment_t
+ * @brief Red/black tree augmentation callback
+ *
+ * Recomputes data stored alongside the node which is derived from its
+ * subtree, for instance the number of nodes or the lowest key of the
+ * subtree.  It is called each time the children of the node change,
+ * after the data of the children themselves is up to date, so it only
+ * needs to combine the node with its two children.
+ */
+typedef void (*rb_augment_t)(struct rbnode *node);
+
 struct rbtree {
 	struct rbnode *root;
 	rb_lessthan_t lessthan_fn;
+	/* Optional, may be NULL */
+	rb_augment_t augment_fn;
 	int max_depth;
-#ifdef CONFIG_MISRA_SANE
+#if defined(CONFIG_MISRA_SANE) && !defined(CONFIG_RB_PARENT_POINTERS)
 	struct rbnode *iter_stack[Z_MAX_RBTREE_DEPTH];
 	unsigned char iter_left[Z_MAX_RBTREE_DEPTH];
 #endif
@@ -106,9 +128,44 @@ void rb_insert(struct rbtree *tree, struct rbnode *node);
 
 /**
  * @brief Remove node from tree
+ *
+ * Does nothing if the node is not in the tree.  With
+ * CONFIG_RB_PARENT_POINTERS, this is only detected for nodes that were
+ * zero-initialized or removed from a tree, not for nodes in another
+ * tree.
  */
 void rb_remove(struct rbtree *tree, struct rbnode *node);
 
+/**
+ * @brief Build a tree from sorted nodes
+ *
+ * Replaces the content of the tree with the given nodes, in O(N) time
+ * instead of the O(N*log2(N)) of as many insertions.  The resulting
+ * tree is balanced, and the augmentation callback, if any, is called
+ * on every node.
+ *
+ * @param tree Tree, with its lessthan_fn (and augment_fn) set
+ * @param nodes Array of pointers to the nodes, sorted in increasing
+ *              order, without nodes comparing equal
+ * @param count Number of nodes
+ */
+void rb_build_sorted(struct rbtree *tree, struct rbnode **nodes,
+		     uint32_t count);
+
+/**
+ * @brief Returns a child of a node
+ *
+ * Meant for augmentation callbacks, which combine the data of a node
+ * with that of its children.
+ *
+ * @param node A node of a tree
+ * @param side 0 for the lower (left) child, 1 for the higher (right) one
+ */
+static inline struct rbnode *rb_child(struct rbnode *node, uint8_t side)
+{
+	return z_rb_child(node, side);
+}
+
 /**
  * @brief Returns the lowest-sorted member of the tree
  */
@@ -152,6 +209,15 @@ static inline void rb_walk(struct rbtree *tree, rb_visit_t visit_fn,
 }
 #endif
 
+#ifdef CONFIG_RB_PARENT_POINTERS
+struct _rb_foreach {
+	struct rbnode *cur;
+};
+
+#define _RB_FOREACH_INIT(tree, node) {					\
+	.cur = NULL							\
+}
+#else
 struct _rb_foreach {
 	struct rbnode **stack;
 	uint8_t *is_left;
@@ -172,6 +238,7 @@ struct _rb_foreach {
 	.top     = -1							\
 }
 #endif
+#endif /* CONFIG_RB_PARENT_POINTERS */
 
 struct rbnode *z_rb_foreach_next(struct rbtree *tree, struct _rb_foreach *f);
 
@@ -197,6 +197,22 @@ int spsc_pbuf_alloc(struct spsc_pbuf *pb, uint16_t len, char **buf);
  */
 void spsc_pbuf_commit(struct spsc_pbuf *pb, uint16_t len);
 
+/**
+ * @brief Commit packet to the buffer and check if the consumer must be notified.
+ *
+ * Same as @ref spsc_pbuf_commit. In addition, it tells if the consumer may
+ * have found the buffer empty before the packet was committed. If not, a
+ * consumer which claims packets until @ref spsc_pbuf_claim returns 0 finds
+ * the packet without being notified, so notifications can be coalesced.
+ *
+ * @param pb	A buffer to which to write.
+ * @param len	Packet length. Must be equal or less than the length used for allocation.
+ *
+ * @retval true if the consumer had claimed all the previous packets.
+ * @retval false if the consumer has not claimed all the previous packets yet.
+ */
+bool spsc_pbuf_commit_notify(struct spsc_pbuf *pb, uint16_t len);
+
 /**
  * @brief Read specified amount of data from the packet buffer.
  *
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_TRACING_ISR_STATS_H_
+#define ZEPHYR_INCLUDE_TRACING_ISR_STATS_H_
+
+#include <zephyr/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief ISR statistics
+ * @defgroup isr_stats ISR statistics
+ * @ingroup subsys_tracing
+ *
+ * Per interrupt line duration and inter-arrival time histograms collected
+ * from the sys_trace_isr_enter() / sys_trace_isr_exit() hooks. Times are
+ * measured in hardware cycles as returned by k_cycle_get_32(). The
+ * duration of an ISR includes the time spent in ISRs nested into it.
+ *
+ * Bucket 0 of a histogram counts zero-cycle values and bucket n counts
+ * values in the range [2^(n-1), 2^n). The last bucket also counts every
+ * larger value.
+ * @{
+ */
+
+/**
+ * Line used for interrupts whose number cannot be determined, e.g. on
+ * architectures without a way to query the active interrupt or for
+ * Cortex-M system exceptions such as SysTick.
+ */
+#define ISR_STATS_IRQ_OTHER (-1)
+
+/**
+ * Number of interrupt lines with their own statistics. Lines with a
+ * higher number are accounted to ISR_STATS_IRQ_OTHER.
+ */
+#if defined(CONFIG_CPU_CORTEX_M)
+#define ISR_STATS_NUM_IRQS CONFIG_NUM_IRQS
+#elif defined(CONFIG_ARCH_POSIX)
+#define ISR_STATS_NUM_IRQS 64
+#else
+#define ISR_STATS_NUM_IRQS 0
+#endif
+
+/** @brief Statistics of one interrupt line */
+struct isr_stats {
+	/** Number of times the ISR was entered. */
+	uint32_t count;
+	/** Sum of all ISR durations, in cycles. */
+	uint64_t duration_total;
+	/** Longest ISR duration, in cycles. */
+	uint32_t duration_max;
+	/** Shortest time between two consecutive entries, in cycles. */
+	uint32_t interarrival_min;
+	/** Longest time between two consecutive entries, in cycles. */
+	uint32_t interarrival_max;
+	/** Log2 histogram of ISR durations. */
+	uint32_t duration_hist[CONFIG_TRACING_ISR_STATS_BUCKETS];
+	/** Log2 histogram of inter-arrival times. */
+	uint32_t interarrival_hist[CONFIG_TRACING_ISR_STATS_BUCKETS];
+};
+
+/**
+ * @brief Get the statistics of an interrupt line
+ *
+ * @param irq Interrupt line number or ISR_STATS_IRQ_OTHER.
+ * @param stats Output statistics.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if @a irq is out of range.
+ */
+int isr_stats_get(int irq, struct isr_stats *stats);
+
+/**
+ * @brief Clear the statistics of all interrupt lines
+ */
+void isr_stats_reset(void);
+
+/**
+ * @brief Lower bound of a histogram bucket, in cycles
+ *
+ * @param bucket Bucket index.
+ *
+ * @return Smallest value counted in @a bucket.
+ */
+static inline uint32_t isr_stats_bucket_min(unsigned int bucket)
+{
+	return (bucket == 0U) ? 0U : (1U << (bucket - 1U));
+}
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_TRACING_ISR_STATS_H_ */
@@ -65,8 +65,35 @@ struct zbus_channel {
 	 * have listeners and subscribers mixed in any sequence.
 	 */
 	const struct zbus_observer *const *observers;
+#if defined(CONFIG_ZBUS_MSG_LOAN) || defined(__DOXYGEN__)
+	/** Message pool of a loan channel. The channel messages are published by reference from
+	 * buffers of this pool. NULL for channels copying their messages.
+	 */
+	struct zbus_chan_loan *loan;
+#endif /* CONFIG_ZBUS_MSG_LOAN */
+#if defined(CONFIG_ZBUS_LATEST_VALUE_CHANNELS) || defined(__DOXYGEN__)
+	/** Message buffers of a latest value channel, published and read without locking the
+	 * channel. NULL for the other channels.
+	 */
+	struct zbus_chan_latest *latest;
+#endif /* CONFIG_ZBUS_LATEST_VALUE_CHANNELS */
 };
 
+#if defined(CONFIG_ZBUS_ASYNC_DISPATCH) || defined(__DOXYGEN__)
+/**
+ * @brief Overflow policy of a subscriber.
+ *
+ * With the asynchronous dispatch, a notification for a subscriber whose queue is full is
+ * dropped instead of delaying the other notifications. The policy selects the dropped one.
+ */
+enum zbus_overflow_policy {
+	/** Drop the new notification. */
+	ZBUS_OVERFLOW_DROP_NEW,
+	/** Drop the oldest queued notification to make room for the new one. */
+	ZBUS_OVERFLOW_DROP_OLDEST,
+};
+#endif /* CONFIG_ZBUS_ASYNC_DISPATCH */
+
 /**
  * @brief Type used to represent an observer.
  *
@@ -94,8 +121,33 @@ struct zbus_observer {
 
 	/** Observer callback function. It turns the observer into a listener. */
 	void (*const callback)(const struct zbus_channel *chan);
+#if defined(CONFIG_ZBUS_MSG_LOAN) || defined(__DOXYGEN__)
+	/** Message reference flag. The subscriber's queue receives struct zbus_msg_ref items,
+	 * holding a reference to the published message of loan channels.
+	 */
+	const bool msg_ref;
+#endif /* CONFIG_ZBUS_MSG_LOAN */
+#if defined(CONFIG_ZBUS_ASYNC_DISPATCH) || defined(__DOXYGEN__)
+	/** Overflow policy of a subscriber, one of enum zbus_overflow_policy. */
+	const uint8_t overflow;
+#endif /* CONFIG_ZBUS_ASYNC_DISPATCH */
 };
 
+#if defined(CONFIG_ZBUS_MSG_LOAN) || defined(__DOXYGEN__)
+/**
+ * @brief Type used to represent a message reference.
+ *
+ * Notification received by message reference subscribers. The message must be released with
+ * zbus_chan_release() once used.
+ */
+struct zbus_msg_ref {
+	/** The notifying channel. */
+	const struct zbus_channel *chan;
+	/** The published message, NULL when the channel does not loan its messages. */
+	const void *msg;
+};
+#endif /* CONFIG_ZBUS_MSG_LOAN */
+
 /** @cond INTERNAL_HIDDEN */
 
 #if defined(CONFIG_ZBUS_ASSERT_MOCK)
@@ -114,8 +166,10 @@ struct zbus_observer {
 
 #if defined(CONFIG_ZBUS_CHANNEL_NAME)
 #define ZBUS_CHANNEL_NAME_INIT(_name) .name = #_name,
+#define _ZBUS_CHAN_NAME(_chan)	       (_chan)->name
 #else
 #define ZBUS_CHANNEL_NAME_INIT(_name)
+#define _ZBUS_CHAN_NAME(_chan) ""
 #endif
 
 #if defined(CONFIG_ZBUS_OBSERVER_NAME)
@@ -146,6 +200,57 @@ struct zbus_observer {
 
 #define ZBUS_REF(_value) &(_value)
 
+#if defined(CONFIG_ZBUS_MSG_LOAN)
+struct zbus_chan_loan {
+	/* Pool of the message buffers */
+	struct k_mem_slab *slab;
+	/* Last published message, referenced by the channel */
+	void *current;
+};
+
+/* Header of the loan buffers, followed by the message */
+struct zbus_loan_hdr {
+	atomic_t refs;
+} __aligned(8);
+
+#define ZBUS_LOAN_INIT(_loan) .loan = (_loan),
+#else
+#define ZBUS_LOAN_INIT(_loan)
+#endif /* CONFIG_ZBUS_MSG_LOAN */
+
+#if defined(CONFIG_ZBUS_LATEST_VALUE_CHANNELS)
+struct zbus_chan_latest {
+	/* Version of the last published message. It is stored in the channel's message when
+	 * seq % buf_count is 0, in bufs[seq % buf_count - 1] otherwise.
+	 */
+	atomic_t seq;
+	uint8_t buf_count;
+	uint8_t *bufs;
+};
+
+#define ZBUS_LATEST_INIT(_latest) .latest = (_latest),
+#else
+#define ZBUS_LATEST_INIT(_latest)
+#endif /* CONFIG_ZBUS_LATEST_VALUE_CHANNELS */
+
+#define _ZBUS_CHAN_DEFINE(_name, _type, _validator, _user_data, _message, _extra, ...)       \
+	static K_MUTEX_DEFINE(_CONCAT(_zbus_mutex_, _name));                                 \
+	ZBUS_RUNTIME_OBSERVERS_LIST_DECL(_CONCAT(_runtime_observers_, _name));               \
+	FOR_EACH_NONEMPTY_TERM(_ZBUS_OBS_EXTERN, (;), __VA_ARGS__)                           \
+	static const struct zbus_observer *const _CONCAT(_zbus_observers_, _name)[] = {      \
+	FOR_EACH_NONEMPTY_TERM(ZBUS_REF, (,), __VA_ARGS__) NULL};                            \
+	const _ZBUS_STRUCT_DECLARE(zbus_channel, _name) = {                                  \
+		ZBUS_CHANNEL_NAME_INIT(_name)		       /* Name */                    \
+		.message_size = sizeof(_type),	               /* Message size */            \
+		.user_data = _user_data,		       /* User data */               \
+		.message = (_message),			       /* Reference to the message */\
+		.validator = (_validator),		       /* Validator function */      \
+		.mutex = &_CONCAT(_zbus_mutex_, _name),	       /* Channel's Mutex */         \
+		ZBUS_RUNTIME_OBSERVERS_LIST_INIT(                                            \
+			_CONCAT(_runtime_observers_, _name))   /* Runtime observer list */   \
+		_extra					       /* Loan or latest value */    \
+		.observers = _CONCAT(_zbus_observers_, _name)} /* Static observer list */
+
 k_timeout_t _zbus_timeout_remainder(uint64_t end_ticks);
 /** @endcond */
 
@@ -193,21 +298,77 @@ k_timeout_t _zbus_timeout_remainder(uint64_t end_ticks);
  */
 #define ZBUS_CHAN_DEFINE(_name, _type, _validator, _user_data, _observers, _init_val)        \
 	static _type _CONCAT(_zbus_message_, _name) = _init_val;                             \
-	static K_MUTEX_DEFINE(_CONCAT(_zbus_mutex_, _name));                                 \
-	ZBUS_RUNTIME_OBSERVERS_LIST_DECL(_CONCAT(_runtime_observers_, _name));               \
-	FOR_EACH_NONEMPTY_TERM(_ZBUS_OBS_EXTERN, (;), _observers)                            \
-	static const struct zbus_observer *const _CONCAT(_zbus_observers_, _name)[] = {      \
-	FOR_EACH_NONEMPTY_TERM(ZBUS_REF, (,), _observers) NULL};                             \
-	const _ZBUS_STRUCT_DECLARE(zbus_channel, _name) = {                                  \
-		ZBUS_CHANNEL_NAME_INIT(_name)		       /* Name */                    \
-		.message_size = sizeof(_type),	               /* Message size */            \
-		.user_data = _user_data,		       /* User data */               \
-		.message = &_CONCAT(_zbus_message_, _name),    /* Reference to the message */\
-		.validator = (_validator),		       /* Validator function */      \
-		.mutex = &_CONCAT(_zbus_mutex_, _name),	       /* Channel's Mutex */         \
-		ZBUS_RUNTIME_OBSERVERS_LIST_INIT(                                            \
-			_CONCAT(_runtime_observers_, _name))   /* Runtime observer list */   \
-		.observers = _CONCAT(_zbus_observers_, _name)} /* Static observer list */
+	_ZBUS_CHAN_DEFINE(_name, _type, _validator, _user_data,                              \
+			  &_CONCAT(_zbus_message_, _name), /* No loan */, _observers)
+
+#if defined(CONFIG_ZBUS_MSG_LOAN) || defined(__DOXYGEN__)
+/**
+ * @brief Zbus loan channel definition.
+ *
+ * This macro defines a channel whose messages are published by reference. Publishers loan a
+ * message buffer from the channel's pool with zbus_chan_loan(), fill it and publish it with
+ * zbus_chan_pub_loan(). Message reference subscribers then receive a reference to the buffer
+ * instead of reading a copy. A buffer returns to the pool when its last reference is released.
+ *
+ * @param _name The channel's name.
+ * @param _type The Message type. It must be a struct or union.
+ * @param _validator The validator function.
+ * @param _user_data A pointer to the user data.
+ * @param _observers The observers list.
+ * @param _init_val The message initialization, read until a first message is published.
+ * @param _pool_size The number of message buffers. The channel keeps a reference to the last
+ * published message, each message reference subscriber to the messages it did not release yet.
+ */
+#define ZBUS_LOAN_CHAN_DEFINE(_name, _type, _validator, _user_data, _observers, _init_val,   \
+			      _pool_size)                                                    \
+	static _type _CONCAT(_zbus_message_, _name) = _init_val;                             \
+	K_MEM_SLAB_DEFINE_STATIC(_zbus_loan_slab_##_name,                                    \
+				 ROUND_UP(sizeof(struct zbus_loan_hdr) + sizeof(_type), 8),  \
+				 _pool_size, 8);                                             \
+	static struct zbus_chan_loan _CONCAT(_zbus_loan_, _name) = {                         \
+		.slab = &_zbus_loan_slab_##_name,                                            \
+	};                                                                                   \
+	_ZBUS_CHAN_DEFINE(_name, _type, _validator, _user_data,                              \
+			  &_CONCAT(_zbus_message_, _name),                                   \
+			  ZBUS_LOAN_INIT(&_CONCAT(_zbus_loan_, _name)), _observers)
+#endif /* CONFIG_ZBUS_MSG_LOAN */
+
+#if defined(CONFIG_ZBUS_LATEST_VALUE_CHANNELS) || defined(__DOXYGEN__)
+/**
+ * @brief Zbus latest value channel definition.
+ *
+ * This macro defines a channel keeping only its latest message, in two or three buffers used in
+ * turn. zbus_chan_read() does not lock the channel: publishers write the next buffer while
+ * readers copy the latest one, and readers retry when a publisher overwrote the buffer they were
+ * copying. Three buffers let a read overlap a whole publication. Publishers still take turns on
+ * the channel's mutex. Observers are notified as for the other channels, they read the message
+ * with zbus_chan_read().
+ *
+ * @warning The message of a latest value channel must not be accessed with zbus_chan_msg() or
+ * zbus_chan_const_msg().
+ *
+ * @param _name The channel's name.
+ * @param _type The Message type. It must be a struct or union.
+ * @param _validator The validator function.
+ * @param _user_data A pointer to the user data.
+ * @param _observers The observers list.
+ * @param _init_val The message initialization.
+ * @param _buf_count The number of buffers, 2 or 3.
+ */
+#define ZBUS_LATEST_CHAN_DEFINE(_name, _type, _validator, _user_data, _observers, _init_val, \
+				_buf_count)                                                  \
+	BUILD_ASSERT(((_buf_count) == 2) || ((_buf_count) == 3),                             \
+		     "latest value channels have 2 or 3 buffers");                           \
+	static _type _CONCAT(_zbus_message_, _name) = _init_val;                             \
+	static _type _CONCAT(_zbus_bufs_, _name)[(_buf_count) - 1];                          \
+	static struct zbus_chan_latest _CONCAT(_zbus_latest_, _name) = {                     \
+		.buf_count = (_buf_count),                                                   \
+		.bufs = (uint8_t *)_CONCAT(_zbus_bufs_, _name),                              \
+	};                                                                                   \
+	_ZBUS_CHAN_DEFINE(_name, _type, _validator, _user_data,                              \
+			  &_CONCAT(_zbus_message_, _name),                                   \
+			  ZBUS_LATEST_INIT(&_CONCAT(_zbus_latest_, _name)), _observers)
+#endif /* CONFIG_ZBUS_LATEST_VALUE_CHANNELS */
 
 /**
  * @brief Initialize a message.
@@ -241,6 +402,49 @@ k_timeout_t _zbus_timeout_remainder(uint64_t end_ticks);
 					       .enabled = true,                                    \
 				       .queue = &_zbus_observer_queue_##_name, .callback = NULL}
 
+#if defined(CONFIG_ZBUS_ASYNC_DISPATCH) || defined(__DOXYGEN__)
+/**
+ * @brief Define and initialize a subscriber with an overflow policy.
+ *
+ * This macro defines a subscriber like ZBUS_SUBSCRIBER_DEFINE, with the policy applied by the
+ * asynchronous dispatch when its queue is full. ZBUS_SUBSCRIBER_DEFINE subscribers drop the new
+ * notifications.
+ *
+ * @param[in] _name The subscriber's name.
+ * @param[in] _queue_size The notification queue's size.
+ * @param[in] _policy The overflow policy, one of enum zbus_overflow_policy.
+ */
+#define ZBUS_SUBSCRIBER_DEFINE_WITH_POLICY(_name, _queue_size, _policy)                            \
+	K_MSGQ_DEFINE(_zbus_observer_queue_##_name, sizeof(const struct zbus_channel *),           \
+		      _queue_size, sizeof(const struct zbus_channel *));                           \
+	_ZBUS_STRUCT_DECLARE(zbus_observer,                                                        \
+			     _name) = {ZBUS_OBSERVER_NAME_INIT(_name) /* Name field */             \
+					       .enabled = true,                                    \
+				       .queue = &_zbus_observer_queue_##_name, .callback = NULL,   \
+				       .overflow = (_policy)}
+#endif /* CONFIG_ZBUS_ASYNC_DISPATCH */
+
+#if defined(CONFIG_ZBUS_MSG_LOAN) || defined(__DOXYGEN__)
+/**
+ * @brief Define and initialize a message reference subscriber.
+ *
+ * This macro defines a subscriber receiving struct zbus_msg_ref notifications with
+ * zbus_sub_wait_msg(). For loan channels, they hold a reference to the published message, to
+ * be released with zbus_chan_release().
+ *
+ * @param[in] _name The subscriber's name.
+ * @param[in] _queue_size The notification queue's size.
+ */
+#define ZBUS_MSG_SUBSCRIBER_DEFINE(_name, _queue_size)                                             \
+	K_MSGQ_DEFINE(_zbus_observer_queue_##_name, sizeof(struct zbus_msg_ref), _queue_size,      \
+		      sizeof(void *));                                                             \
+	_ZBUS_STRUCT_DECLARE(zbus_observer,                                                        \
+			     _name) = {ZBUS_OBSERVER_NAME_INIT(_name) /* Name field */             \
+					       .enabled = true,                                    \
+				       .queue = &_zbus_observer_queue_##_name, .callback = NULL,   \
+				       .msg_ref = true}
+#endif /* CONFIG_ZBUS_MSG_LOAN */
+
 /**
  * @brief Define and initialize a listener.
  *
@@ -261,7 +465,8 @@ k_timeout_t _zbus_timeout_remainder(uint64_t end_ticks);
  *
  * @brief Publish to a channel
  *
- * This routine publishes a message to a channel.
+ * This routine publishes a message to a channel. With CONFIG_ZBUS_ASYNC_DISPATCH, it only
+ * queues the notification of the observers, done later by the dispatcher thread.
  *
  * @param chan The channel's reference.
  * @param msg Reference to the message where the publish function copies the channel's
@@ -360,6 +565,137 @@ int zbus_chan_finish(const struct zbus_channel *chan);
  */
 int zbus_chan_notify(const struct zbus_channel *chan, k_timeout_t timeout);
 
+#if defined(CONFIG_ZBUS_MSG_LOAN) || defined(__DOXYGEN__)
+
+/**
+ * @brief Loan a message buffer from a channel.
+ *
+ * This routine takes a buffer from the pool of a loan channel, to be filled and published with
+ * zbus_chan_pub_loan(), or released with zbus_chan_release().
+ *
+ * @param[in] chan The channel's reference.
+ * @param[out] msg The loaned message buffer.
+ * @param[in] timeout Waiting period for a free buffer,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Buffer loaned.
+ * @retval -ENOTSUP The channel does not loan messages.
+ * @retval -ENOMEM Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EFAULT A parameter is incorrect, or the function context is invalid (inside an ISR). The
+ * function only returns this value when the CONFIG_ZBUS_ASSERT_MOCK is enabled.
+ */
+int zbus_chan_loan(const struct zbus_channel *chan, void **msg, k_timeout_t timeout);
+
+/**
+ * @brief Publish a loaned message to a channel.
+ *
+ * This routine publishes a message buffer obtained with zbus_chan_loan() without copying it. The
+ * caller's reference is always consumed, the buffer must not be used afterwards. On failure, the
+ * buffer is released, unless it already became the channel's message because only the
+ * notification of some observers failed.
+ *
+ * @param chan The channel's reference.
+ * @param msg The loaned message.
+ * @param timeout Waiting period to publish the channel,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Channel published.
+ * @retval -ENOTSUP The channel does not loan messages.
+ * @retval -ENOMSG The message is invalid based on the validator function.
+ * @retval -EBUSY The channel is busy.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EFAULT A parameter is incorrect, the notification could not be sent to one or more
+ * observer, or the function context is invalid (inside an ISR). The function only returns this
+ * value when the CONFIG_ZBUS_ASSERT_MOCK is enabled.
+ */
+int zbus_chan_pub_loan(const struct zbus_channel *chan, void *msg, k_timeout_t timeout);
+
+/**
+ * @brief Get a reference to the message of a loan channel.
+ *
+ * This routine gives read access to the last message published to a loan channel without copying
+ * it. The reference must be released with zbus_chan_release().
+ *
+ * @param[in] chan The channel's reference.
+ * @param[out] msg The referenced message.
+ * @param[in] timeout Waiting period to access the channel,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Message referenced.
+ * @retval -ENOTSUP The channel does not loan messages.
+ * @retval -ENODATA No message was published yet.
+ * @retval -EBUSY The channel is busy.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+int zbus_chan_ref(const struct zbus_channel *chan, const void **msg, k_timeout_t timeout);
+
+/**
+ * @brief Release a message reference.
+ *
+ * This routine releases a loaned message or a message reference. The buffer returns to the
+ * channel's pool with its last reference.
+ *
+ * @param chan The channel's reference.
+ * @param msg The message, NULL is ignored.
+ */
+void zbus_chan_release(const struct zbus_channel *chan, const void *msg);
+
+/**
+ * @brief Wait for a message reference notification.
+ *
+ * This routine makes a message reference subscriber wait for a notification.
+ *
+ * @param[in] sub The subscriber's reference.
+ * @param[out] ref The notification, whose message must be released with zbus_chan_release().
+ * @param[in] timeout Waiting period for a notification arrival,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Notification received.
+ * @retval -ENOMSG Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EINVAL The observer is not a message reference subscriber.
+ */
+int zbus_sub_wait_msg(const struct zbus_observer *sub, struct zbus_msg_ref *ref,
+		      k_timeout_t timeout);
+
+#endif /* CONFIG_ZBUS_MSG_LOAN */
+
+#if defined(CONFIG_ZBUS_ASYNC_DISPATCH_STATS) || defined(__DOXYGEN__)
+/**
+ * @brief Statistics of the asynchronous dispatch.
+ *
+ * Latencies are measured in hardware cycles, from the publication to the end of the
+ * notification of the observers.
+ */
+struct zbus_dispatch_stats {
+	/** Dispatched publications. */
+	uint32_t events;
+	/** Publications not dispatched, the dispatch queue being full. */
+	uint32_t rejected;
+	/** Notifications dropped for a subscriber whose queue was full. */
+	uint32_t dropped;
+	/** Queued notifications dropped to make room for a new one. */
+	uint32_t overwritten;
+	/** Maximum delivery latency. */
+	uint32_t latency_max;
+	/** Sum of the delivery latencies. */
+	uint64_t latency_sum;
+};
+
+/**
+ * @brief Get the statistics of the asynchronous dispatch.
+ *
+ * @param[out] stats The statistics.
+ */
+void zbus_dispatch_stats_get(struct zbus_dispatch_stats *stats);
+
+/**
+ * @brief Reset the statistics of the asynchronous dispatch.
+ */
+void zbus_dispatch_stats_reset(void);
+#endif /* CONFIG_ZBUS_ASYNC_DISPATCH_STATS */
+
 #if defined(CONFIG_ZBUS_CHANNEL_NAME) || defined(__DOXYGEN__)
 
 /**
@@ -396,6 +732,12 @@ static inline void *zbus_chan_msg(const struct zbus_channel *chan)
 {
 	__ASSERT(chan != NULL, "chan is required");
 
+#if defined(CONFIG_ZBUS_MSG_LOAN)
+	if ((chan->loan != NULL) && (chan->loan->current != NULL)) {
+		return chan->loan->current;
+	}
+#endif
+
 	return chan->message;
 }
 
@@ -415,9 +757,7 @@ static inline void *zbus_chan_msg(const struct zbus_channel *chan)
  */
 static inline const void *zbus_chan_const_msg(const struct zbus_channel *chan)
 {
-	__ASSERT(chan != NULL, "chan is required");
-
-	return chan->message;
+	return zbus_chan_msg(chan);
 }
 
 /**
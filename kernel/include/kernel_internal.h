@@ -289,6 +289,37 @@ void z_paging_histogram_inc(struct k_mem_paging_histogram_t *hist,
 			    uint32_t cycles);
 #endif /* CONFIG_DEMAND_PAGING_TIMING_HISTOGRAM */
 
+#ifdef CONFIG_LOCK_STATS
+/**
+ * Clear the statistics of a lock object being initialized at runtime.
+ */
+void z_lock_stats_init(struct k_lock_stats *stats);
+
+/**
+ * Record an acquisition of a lock, starting its hold time.
+ *
+ * The statistics update functions must be called with the lock held, or
+ * under the spinlock protecting the lock object.
+ */
+void z_lock_stats_acquired(struct k_lock_stats *stats, uint32_t now);
+
+/**
+ * Record a wait which ended with the current thread getting the lock.
+ */
+void z_lock_stats_contended(struct k_lock_stats *stats, uint32_t wait_start,
+			    uint32_t now);
+
+/**
+ * Record a wait which ended without getting the lock.
+ */
+void z_lock_stats_timeout(struct k_lock_stats *stats);
+
+/**
+ * Record the release of a lock, ending its hold time.
+ */
+void z_lock_stats_released(struct k_lock_stats *stats, uint32_t now);
+#endif /* CONFIG_LOCK_STATS */
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/kernel/lock_stats.h>
+#include <kernel_internal.h>
+#include <zephyr/sys/slist.h>
+#include <string.h>
+
+/* Registered objects. Walking the registry may call back into user
+ * code, so it is protected by a mutex rather than a spinlock. The mutex
+ * is not defined with K_MUTEX_DEFINE() to keep it out of the listing.
+ */
+static struct k_mutex registry_lock = Z_MUTEX_INITIALIZER(registry_lock);
+static sys_slist_t registry = SYS_SLIST_STATIC_INIT(&registry);
+
+#if CONFIG_LOCK_STATS_TOP_WAITERS > 0
+static void waiter_update(struct k_lock_stats *stats,
+			  const struct k_thread *thread, uint32_t wait)
+{
+	struct k_lock_waiter_stats *w = stats->waiters;
+	const int n = CONFIG_LOCK_STATS_TOP_WAITERS;
+	int i;
+
+	for (i = 0; i < n; i++) {
+		if (w[i].thread == thread || w[i].thread == NULL) {
+			break;
+		}
+	}
+
+	if (i == n) {
+		/* Evict the least waiting thread, only if this single wait
+		 * already exceeds its total.
+		 */
+		i = n - 1;
+		if (wait <= w[i].wait_total) {
+			return;
+		}
+	}
+
+	if (w[i].thread != thread) {
+		w[i].thread = thread;
+		w[i].count = 0U;
+		w[i].wait_total = 0U;
+	}
+
+	w[i].count++;
+	w[i].wait_total += wait;
+
+	/* Keep the array sorted by decreasing total wait */
+	while (i > 0 && w[i].wait_total > w[i - 1].wait_total) {
+		struct k_lock_waiter_stats tmp = w[i - 1];
+
+		w[i - 1] = w[i];
+		w[i] = tmp;
+		i--;
+	}
+}
+#endif
+
+void z_lock_stats_init(struct k_lock_stats *stats)
+{
+	memset(stats, 0, sizeof(*stats));
+}
+
+void z_lock_stats_acquired(struct k_lock_stats *stats, uint32_t now)
+{
+	stats->acquisitions++;
+	stats->hold_start = now;
+}
+
+void z_lock_stats_contended(struct k_lock_stats *stats, uint32_t wait_start,
+			    uint32_t now)
+{
+	uint32_t wait = now - wait_start;
+
+	stats->contended++;
+	stats->wait_total += wait;
+	stats->wait_max = MAX(stats->wait_max, wait);
+
+#if CONFIG_LOCK_STATS_TOP_WAITERS > 0
+	waiter_update(stats, _current, wait);
+#endif
+}
+
+void z_lock_stats_timeout(struct k_lock_stats *stats)
+{
+	stats->timeouts++;
+}
+
+void z_lock_stats_released(struct k_lock_stats *stats, uint32_t now)
+{
+	uint32_t hold = now - stats->hold_start;
+
+	stats->hold_total += hold;
+	stats->hold_max = MAX(stats->hold_max, hold);
+}
+
+#ifdef CONFIG_SPIN_LOCK_STATS
+void z_spin_lock_contended(struct k_spinlock *l)
+{
+	uint32_t start = 0;
+
+	if (l->stats != NULL) {
+		start = k_cycle_get_32();
+	}
+
+#ifdef CONFIG_SMP
+	while (!atomic_cas(&l->locked, 0, 1)) {
+	}
+#endif
+
+	if (l->stats != NULL) {
+		z_lock_stats_contended(l->stats, start, k_cycle_get_32());
+	}
+}
+
+void z_spin_lock_stats_acquired(struct k_spinlock *l)
+{
+	z_lock_stats_acquired(l->stats, k_cycle_get_32());
+}
+
+void z_spin_lock_stats_released(struct k_spinlock *l)
+{
+	z_lock_stats_released(l->stats, k_cycle_get_32());
+}
+#endif /* CONFIG_SPIN_LOCK_STATS */
+
+static bool is_registered(const struct k_lock_stats *stats)
+{
+	sys_snode_t *node;
+
+	SYS_SLIST_FOR_EACH_NODE(&registry, node) {
+		if (node == &stats->node) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void registry_add(struct k_lock_stats *stats, enum k_lock_stats_type type,
+			 const void *obj, const char *name)
+{
+	stats->type = type;
+	stats->obj = obj;
+	stats->name = name;
+
+	(void)k_mutex_lock(&registry_lock, K_FOREVER);
+	if (!is_registered(stats)) {
+		sys_slist_append(&registry, &stats->node);
+	}
+	k_mutex_unlock(&registry_lock);
+}
+
+void k_mutex_stats_register(struct k_mutex *mutex, const char *name)
+{
+	registry_add(&mutex->lock_stats, K_LOCK_STATS_MUTEX, mutex, name);
+}
+
+void k_sem_stats_register(struct k_sem *sem, const char *name)
+{
+	registry_add(&sem->lock_stats, K_LOCK_STATS_SEM, sem, name);
+}
+
+void k_spin_lock_stats_attach(struct k_spinlock *l, struct k_lock_stats *stats,
+			      const char *name)
+{
+#ifdef CONFIG_SPIN_LOCK_STATS
+	z_lock_stats_init(stats);
+	registry_add(stats, K_LOCK_STATS_SPINLOCK, l, name);
+	l->stats = stats;
+#else
+	ARG_UNUSED(l);
+	ARG_UNUSED(stats);
+	ARG_UNUSED(name);
+#endif
+}
+
+void k_lock_stats_unregister(const void *obj)
+{
+	struct k_lock_stats *stats;
+	sys_snode_t *prev = NULL;
+
+	(void)k_mutex_lock(&registry_lock, K_FOREVER);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&registry, stats, node) {
+		if (stats->obj == obj) {
+			sys_slist_remove(&registry, prev, &stats->node);
+			stats->name = NULL;
+#ifdef CONFIG_SPIN_LOCK_STATS
+			if (stats->type == K_LOCK_STATS_SPINLOCK) {
+				((struct k_spinlock *)obj)->stats = NULL;
+			}
+#endif
+			break;
+		}
+		prev = &stats->node;
+	}
+
+	k_mutex_unlock(&registry_lock);
+}
+
+void k_lock_stats_foreach(k_lock_stats_cb_t cb, void *user_data)
+{
+	struct k_lock_stats *stats;
+	struct k_lock_stats snapshot;
+
+	(void)k_mutex_lock(&registry_lock, K_FOREVER);
+
+	/* Statically defined objects not registered under a name */
+	STRUCT_SECTION_FOREACH(k_mutex, mutex) {
+		if (!is_registered(&mutex->lock_stats)) {
+			snapshot = mutex->lock_stats;
+			cb(K_LOCK_STATS_MUTEX, mutex, NULL, &snapshot, user_data);
+		}
+	}
+
+	STRUCT_SECTION_FOREACH(k_sem, sem) {
+		if (!is_registered(&sem->lock_stats)) {
+			snapshot = sem->lock_stats;
+			cb(K_LOCK_STATS_SEM, sem, NULL, &snapshot, user_data);
+		}
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&registry, stats, node) {
+		snapshot = *stats;
+		cb(stats->type, stats->obj, stats->name, &snapshot, user_data);
+	}
+
+	k_mutex_unlock(&registry_lock);
+}
+
+static void stats_clear(struct k_lock_stats *stats)
+{
+	stats->acquisitions = 0U;
+	stats->contended = 0U;
+	stats->timeouts = 0U;
+	stats->wait_max = 0U;
+	stats->wait_total = 0U;
+	stats->hold_max = 0U;
+	stats->hold_total = 0U;
+#if CONFIG_LOCK_STATS_TOP_WAITERS > 0
+	memset(stats->waiters, 0, sizeof(stats->waiters));
+#endif
+}
+
+void k_lock_stats_reset(void)
+{
+	struct k_lock_stats *stats;
+
+	(void)k_mutex_lock(&registry_lock, K_FOREVER);
+
+	STRUCT_SECTION_FOREACH(k_mutex, mutex) {
+		stats_clear(&mutex->lock_stats);
+	}
+
+	STRUCT_SECTION_FOREACH(k_sem, sem) {
+		stats_clear(&sem->lock_stats);
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&registry, stats, node) {
+		stats_clear(stats);
+	}
+
+	k_mutex_unlock(&registry_lock);
+}
@@ -53,6 +53,10 @@ int z_impl_k_mutex_init(struct k_mutex *mutex)
 
 	z_waitq_init(&mutex->wait_q);
 
+#ifdef CONFIG_LOCK_STATS
+	z_lock_stats_init(&mutex->lock_stats);
+#endif
+
 	z_object_init(mutex);
 
 	SYS_PORT_TRACING_OBJ_INIT(k_mutex, mutex, 0);
@@ -97,6 +101,9 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 	int new_prio;
 	k_spinlock_key_t key;
 	bool resched = false;
+#ifdef CONFIG_LOCK_STATS
+	uint32_t wait_start;
+#endif
 
 	__ASSERT(!arch_is_in_isr(), "mutexes cannot be used inside ISRs");
 
@@ -106,6 +113,12 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 
 	if (likely((mutex->lock_count == 0U) || (mutex->owner == _current))) {
 
+#ifdef CONFIG_LOCK_STATS
+		if (mutex->lock_count == 0U) {
+			z_lock_stats_acquired(&mutex->lock_stats, k_cycle_get_32());
+		}
+#endif
+
 		mutex->owner_orig_prio = (mutex->lock_count == 0U) ?
 					_current->base.prio :
 					mutex->owner_orig_prio;
@@ -143,6 +156,10 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 		resched = adjust_owner_prio(mutex, new_prio);
 	}
 
+#ifdef CONFIG_LOCK_STATS
+	wait_start = k_cycle_get_32();
+#endif
+
 	int got_mutex = z_pend_curr(&lock, key, &mutex->wait_q, timeout);
 
 	LOG_DBG("on mutex %p got_mutex value: %d", mutex, got_mutex);
@@ -151,6 +168,14 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 		got_mutex ? 'y' : 'n');
 
 	if (got_mutex == 0) {
+#ifdef CONFIG_LOCK_STATS
+		uint32_t now = k_cycle_get_32();
+
+		key = k_spin_lock(&lock);
+		z_lock_stats_contended(&mutex->lock_stats, wait_start, now);
+		z_lock_stats_acquired(&mutex->lock_stats, now);
+		k_spin_unlock(&lock, key);
+#endif
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, 0);
 		return 0;
 	}
@@ -161,6 +186,10 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 
 	key = k_spin_lock(&lock);
 
+#ifdef CONFIG_LOCK_STATS
+	z_lock_stats_timeout(&mutex->lock_stats);
+#endif
+
 	/*
 	 * Check if mutex was unlocked after this thread was unpended.
 	 * If so, skip adjusting owner's priority down.
@@ -241,6 +270,10 @@ int z_impl_k_mutex_unlock(struct k_mutex *mutex)
 
 	k_spinlock_key_t key = k_spin_lock(&lock);
 
+#ifdef CONFIG_LOCK_STATS
+	z_lock_stats_released(&mutex->lock_stats, k_cycle_get_32());
+#endif
+
 	adjust_owner_prio(mutex, mutex->owner_orig_prio);
 
 	/* Get the new owner, if any */
@@ -58,6 +58,9 @@ int z_impl_k_sem_init(struct k_sem *sem, unsigned int initial_count,
 	z_waitq_init(&sem->wait_q);
 #if defined(CONFIG_POLL)
 	sys_dlist_init(&sem->poll_events);
+#endif
+#ifdef CONFIG_LOCK_STATS
+	z_lock_stats_init(&sem->lock_stats);
 #endif
 	z_object_init(sem);
 
@@ -127,6 +130,9 @@ int z_impl_k_sem_take(struct k_sem *sem, k_timeout_t timeout)
 
 	if (likely(sem->count > 0U)) {
 		sem->count--;
+#ifdef CONFIG_LOCK_STATS
+		z_lock_stats_acquired(&sem->lock_stats, k_cycle_get_32());
+#endif
 		k_spin_unlock(&lock, key);
 		ret = 0;
 		goto out;
@@ -140,8 +146,25 @@ int z_impl_k_sem_take(struct k_sem *sem, k_timeout_t timeout)
 
 	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_sem, take, sem, timeout);
 
+#ifdef CONFIG_LOCK_STATS
+	uint32_t wait_start = k_cycle_get_32();
+#endif
+
 	ret = z_pend_curr(&lock, key, &sem->wait_q, timeout);
 
+#ifdef CONFIG_LOCK_STATS
+	uint32_t now = k_cycle_get_32();
+
+	key = k_spin_lock(&lock);
+	if (ret == 0) {
+		z_lock_stats_contended(&sem->lock_stats, wait_start, now);
+		z_lock_stats_acquired(&sem->lock_stats, now);
+	} else {
+		z_lock_stats_timeout(&sem->lock_stats);
+	}
+	k_spin_unlock(&lock, key);
+#endif
+
 out:
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_sem, take, sem, timeout, ret);
 
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/sys/htable.h>
+#include <zephyr/sys/__assert.h>
+
+static inline k_spinlock_key_t bucket_lock(struct sys_htable *ht, uint32_t b)
+{
+	k_spinlock_key_t k = {0};
+
+	if (ht->locks != NULL) {
+		k = k_spin_lock(&ht->locks[b]);
+	}
+
+	return k;
+}
+
+static inline void bucket_unlock(struct sys_htable *ht, uint32_t b,
+				 k_spinlock_key_t k)
+{
+	if (ht->locks != NULL) {
+		k_spin_unlock(&ht->locks[b], k);
+	}
+}
+
+void sys_htable_init(struct sys_htable *ht, sys_slist_t *buckets,
+		     uint32_t n_buckets, struct k_spinlock *locks)
+{
+	__ASSERT(is_power_of_two(n_buckets), "Number of buckets must be a power of 2");
+
+	*ht = (struct sys_htable)SYS_HTABLE_INITIALIZER(buckets, n_buckets, locks);
+
+	for (uint32_t i = 0; i < n_buckets; i++) {
+		sys_slist_init(&buckets[i]);
+	}
+}
+
+void sys_htable_insert(struct sys_htable *ht, struct sys_hnode *node,
+		       uint32_t hash)
+{
+	uint32_t b = hash & ht->mask;
+	k_spinlock_key_t k;
+
+	node->hash = hash;
+
+	k = bucket_lock(ht, b);
+	sys_slist_prepend(&ht->buckets[b], &node->node);
+	bucket_unlock(ht, b, k);
+
+	(void)atomic_inc(&ht->size);
+}
+
+struct sys_hnode *sys_htable_find(struct sys_htable *ht, uint32_t hash,
+				  sys_htable_eq_t eq, const void *key)
+{
+	uint32_t b = hash & ht->mask;
+	struct sys_hnode *hn, *found = NULL;
+	k_spinlock_key_t k = bucket_lock(ht, b);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&ht->buckets[b], hn, node) {
+		/* Only call the predicate for nodes with the same hash */
+		if (hn->hash == hash && eq(hn, key)) {
+			found = hn;
+			break;
+		}
+	}
+
+	bucket_unlock(ht, b, k);
+
+	return found;
+}
+
+bool sys_htable_remove(struct sys_htable *ht, struct sys_hnode *node)
+{
+	uint32_t b = node->hash & ht->mask;
+	k_spinlock_key_t k = bucket_lock(ht, b);
+	bool removed = sys_slist_find_and_remove(&ht->buckets[b], &node->node);
+
+	bucket_unlock(ht, b, k);
+
+	if (removed) {
+		(void)atomic_dec(&ht->size);
+	}
+
+	return removed;
+}
+
+struct sys_hnode *sys_htable_next(const struct sys_htable *ht,
+				  const struct sys_hnode *node)
+{
+	sys_snode_t *sn;
+	uint32_t b = 0;
+
+	if (node != NULL) {
+		sn = sys_slist_peek_next_no_check((sys_snode_t *)&node->node);
+		if (sn != NULL) {
+			return CONTAINER_OF(sn, struct sys_hnode, node);
+		}
+
+		b = (node->hash & ht->mask) + 1;
+	}
+
+	for (; b <= ht->mask; b++) {
+		sn = sys_slist_peek_head(&ht->buckets[b]);
+		if (sn != NULL) {
+			return CONTAINER_OF(sn, struct sys_hnode, node);
+		}
+	}
+
+	return NULL;
+}
@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/sys/lf_ring.h>
+#include <zephyr/sys/__assert.h>
+#include <string.h>
+
+#define POS_BITS Z_LF_RING_POS_BITS
+#define POS_MASK Z_LF_RING_POS_MASK
+
+static inline uint32_t pos_of(atomic_val_t v)
+{
+	return (unsigned long)v & POS_MASK;
+}
+
+static inline uint32_t cnt_of(atomic_val_t v)
+{
+	return ((unsigned long)v >> POS_BITS) & POS_MASK;
+}
+
+static inline atomic_val_t pack(uint32_t pos, uint32_t cnt)
+{
+	return (atomic_val_t)((((unsigned long)cnt & POS_MASK) << POS_BITS) |
+			      ((unsigned long)pos & POS_MASK));
+}
+
+/*
+ * Claim up to size bytes on the producer (put) or consumer side. Claims on
+ * the multi producer (consumer) side race on the head with a CAS, which also
+ * counts the claims started.
+ */
+static uint32_t claim(struct lf_ring *ring, bool put, uint32_t size,
+		      bool contiguous, uint32_t *start)
+{
+	struct z_lf_ring_headtail *ht = put ? &ring->prod : &ring->cons;
+	bool single = (ring->flags & (put ? LF_RING_SP : LF_RING_SC)) != 0;
+	atomic_val_t oh, nh;
+	uint32_t head, avail, n;
+
+	do {
+		oh = atomic_get(&ht->head);
+		head = pos_of(oh);
+
+		if (put) {
+			avail = ring->size -
+				((head - z_lf_ring_pos(&ring->cons.tail)) & POS_MASK);
+		} else {
+			avail = (z_lf_ring_pos(&ring->prod.tail) - head) & POS_MASK;
+		}
+
+		n = MIN(size, avail);
+		if (contiguous) {
+			n = MIN(n, ring->size - (head & (ring->size - 1)));
+		}
+
+		if (n == 0) {
+			*start = head;
+			return 0;
+		}
+
+		nh = pack(head + n, cnt_of(oh) + 1);
+		if (single) {
+			atomic_set(&ht->head, nh);
+			break;
+		}
+	} while (!atomic_cas(&ht->head, oh, nh));
+
+	*start = head;
+
+	return n;
+}
+
+/*
+ * Publish claimed bytes. On the single side, the claims not finished are
+ * dropped. On the multi side, the claim counted by the tail is finished, and
+ * the tail catches up with the head if no other claim is pending.
+ */
+static int finish(struct lf_ring *ring, bool put, uint32_t size,
+		  uint32_t *old_pos, uint32_t *new_pos)
+{
+	struct z_lf_ring_headtail *ht = put ? &ring->prod : &ring->cons;
+	bool single = (ring->flags & (put ? LF_RING_SP : LF_RING_SC)) != 0;
+	atomic_val_t oh, ot, nt;
+
+	if (single) {
+		ot = atomic_get(&ht->tail);
+		oh = atomic_get(&ht->head);
+		if (size > ((pos_of(oh) - pos_of(ot)) & POS_MASK)) {
+			return -EINVAL;
+		}
+
+		nt = pack(pos_of(ot) + size, 0);
+		atomic_set(&ht->head, nt);
+		atomic_set(&ht->tail, nt);
+	} else {
+		do {
+			ot = atomic_get(&ht->tail);
+			oh = atomic_get(&ht->head);
+			if (cnt_of(ot) == cnt_of(oh)) {
+				/* nothing claimed */
+				return -EINVAL;
+			}
+
+			nt = pack(pos_of(ot), cnt_of(ot) + 1);
+			if (cnt_of(nt) == cnt_of(oh)) {
+				nt = pack(pos_of(oh), cnt_of(nt));
+			}
+		} while (!atomic_cas(&ht->tail, ot, nt));
+	}
+
+	*old_pos = pos_of(ot);
+	*new_pos = pos_of(nt);
+
+	return 0;
+}
+
+void lf_ring_init(struct lf_ring *ring, uint8_t *buffer, uint32_t size,
+		  uint32_t flags)
+{
+	__ASSERT(is_power_of_two(size) && size <= LF_RING_MAX_SIZE,
+		 "Size must be a power of 2");
+
+	*ring = (struct lf_ring)LF_RING_INITIALIZER(buffer, size, flags);
+}
+
+void lf_ring_reset(struct lf_ring *ring)
+{
+	atomic_set(&ring->prod.head, 0);
+	atomic_set(&ring->prod.tail, 0);
+	atomic_set(&ring->cons.head, 0);
+	atomic_set(&ring->cons.tail, 0);
+}
+
+#ifdef CONFIG_POLL
+void lf_ring_signals_set(struct lf_ring *ring,
+			 struct k_poll_signal *data_signal,
+			 struct k_poll_signal *space_signal)
+{
+	ring->data_signal = data_signal;
+	ring->space_signal = space_signal;
+}
+#endif
+
+uint32_t lf_ring_put_claim(struct lf_ring *ring, uint8_t **data, uint32_t size)
+{
+	uint32_t start, n;
+
+	n = claim(ring, true, size, true, &start);
+	*data = &ring->buffer[start & (ring->size - 1)];
+
+	return n;
+}
+
+int lf_ring_put_finish(struct lf_ring *ring, uint32_t size)
+{
+	uint32_t old_pos, new_pos;
+	int err;
+
+	err = finish(ring, true, size, &old_pos, &new_pos);
+	if (err != 0) {
+		return err;
+	}
+
+#ifdef CONFIG_POLL
+	/* wake up the consumer if it had claimed everything */
+	if (ring->data_signal != NULL && old_pos != new_pos &&
+	    old_pos == z_lf_ring_pos(&ring->cons.head)) {
+		k_poll_signal_raise(ring->data_signal, 0);
+	}
+#else
+	ARG_UNUSED(old_pos);
+	ARG_UNUSED(new_pos);
+#endif
+
+	return 0;
+}
+
+uint32_t lf_ring_put(struct lf_ring *ring, const uint8_t *data, uint32_t size)
+{
+	uint32_t start, ofs, first, n;
+
+	n = claim(ring, true, size, false, &start);
+	if (n == 0) {
+		return 0;
+	}
+
+	ofs = start & (ring->size - 1);
+	first = MIN(n, ring->size - ofs);
+	memcpy(&ring->buffer[ofs], data, first);
+	memcpy(ring->buffer, data + first, n - first);
+
+	(void)lf_ring_put_finish(ring, n);
+
+	return n;
+}
+
+uint32_t lf_ring_get_claim(struct lf_ring *ring, uint8_t **data, uint32_t size)
+{
+	uint32_t start, n;
+
+	n = claim(ring, false, size, true, &start);
+	*data = &ring->buffer[start & (ring->size - 1)];
+
+	return n;
+}
+
+int lf_ring_get_finish(struct lf_ring *ring, uint32_t size)
+{
+	uint32_t old_pos, new_pos;
+	int err;
+
+	err = finish(ring, false, size, &old_pos, &new_pos);
+	if (err != 0) {
+		return err;
+	}
+
+#ifdef CONFIG_POLL
+	/* wake up the producers if they had claimed everything */
+	if (ring->space_signal != NULL && old_pos != new_pos &&
+	    ((z_lf_ring_pos(&ring->prod.head) - old_pos) & POS_MASK) == ring->size) {
+		k_poll_signal_raise(ring->space_signal, 0);
+	}
+#else
+	ARG_UNUSED(old_pos);
+	ARG_UNUSED(new_pos);
+#endif
+
+	return 0;
+}
+
+uint32_t lf_ring_get(struct lf_ring *ring, uint8_t *data, uint32_t size)
+{
+	uint32_t start, ofs, first, n;
+
+	n = claim(ring, false, size, false, &start);
+	if (n == 0) {
+		return 0;
+	}
+
+	if (data != NULL) {
+		ofs = start & (ring->size - 1);
+		first = MIN(n, ring->size - ofs);
+		memcpy(data, &ring->buffer[ofs], first);
+		memcpy(data + first, ring->buffer, n - first);
+	}
+
+	(void)lf_ring_get_finish(ring, n);
+
+	return n;
+}
@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/sys/oamap.h>
+#include <zephyr/sys/hash_function.h>
+#include <zephyr/sys/__assert.h>
+
+/* The current array never holds deleted keys: removal shifts entries
+ * back instead. Deleted keys only appear in the previous array while
+ * resizing, where nothing is inserted, so both arrays always keep free
+ * slots and probing terminates.
+ */
+
+static inline bool key_is_live(uintptr_t key)
+{
+	return key != Z_SYS_OAMAP_KEY_EMPTY && key != Z_SYS_OAMAP_KEY_DELETED;
+}
+
+static inline uint32_t home(uintptr_t key, uint32_t mask)
+{
+	return sys_hash32_uptr(key) & mask;
+}
+
+static struct sys_oamap_slot *probe(struct sys_oamap_slot *slots,
+				    uint32_t mask, uintptr_t key)
+{
+	for (uint32_t i = home(key, mask); ; i = (i + 1) & mask) {
+		if (slots[i].key == key) {
+			return &slots[i];
+		}
+		if (slots[i].key == Z_SYS_OAMAP_KEY_EMPTY) {
+			return NULL;
+		}
+	}
+}
+
+static struct sys_oamap_slot *find(const struct sys_oamap *map, uintptr_t key)
+{
+	struct sys_oamap_slot *slot = probe(map->slots, map->mask, key);
+
+	if (slot == NULL && map->old_slots != NULL) {
+		slot = probe(map->old_slots, map->old_mask, key);
+	}
+
+	return slot;
+}
+
+/* Key must not be in the current array */
+static void place(struct sys_oamap *map, uintptr_t key, void *value)
+{
+	uint32_t i = home(key, map->mask);
+
+	while (map->slots[i].key != Z_SYS_OAMAP_KEY_EMPTY) {
+		i = (i + 1) & map->mask;
+	}
+
+	map->slots[i].key = key;
+	map->slots[i].value = value;
+}
+
+/* Removes a slot of the current array, moving back the entries after
+ * it which would no longer be found from their home slot.
+ */
+static void shift_remove(struct sys_oamap *map, uint32_t i)
+{
+	uint32_t mask = map->mask;
+	uint32_t j = i;
+
+	for (;;) {
+		uint32_t k;
+
+		j = (j + 1) & mask;
+		if (map->slots[j].key == Z_SYS_OAMAP_KEY_EMPTY) {
+			break;
+		}
+
+		/* Entry at j stays if its home slot is in (i, j] */
+		k = home(map->slots[j].key, mask);
+		if ((i <= j) ? (i < k && k <= j) : (i < k || k <= j)) {
+			continue;
+		}
+
+		map->slots[i] = map->slots[j];
+		i = j;
+	}
+
+	map->slots[i].key = Z_SYS_OAMAP_KEY_EMPTY;
+	map->slots[i].value = NULL;
+}
+
+static void move_step(struct sys_oamap *map, uint32_t n)
+{
+	struct sys_oamap_slot *old;
+
+	while (map->old_slots != NULL && n > 0) {
+		old = &map->old_slots[map->moved];
+		if (key_is_live(old->key)) {
+			place(map, old->key, old->value);
+			old->key = Z_SYS_OAMAP_KEY_DELETED;
+		}
+
+		if (map->moved++ == map->old_mask) {
+			map->old_slots = NULL;
+		}
+		n--;
+	}
+}
+
+void sys_oamap_init(struct sys_oamap *map, struct sys_oamap_slot *slots,
+		    uint32_t capacity)
+{
+	__ASSERT(is_power_of_two(capacity) && capacity >= 4,
+		 "Capacity must be a power of 2 of at least 4");
+
+	(void)memset(slots, 0, capacity * sizeof(*slots));
+	*map = (struct sys_oamap)SYS_OAMAP_INITIALIZER(slots, capacity);
+}
+
+int sys_oamap_insert(struct sys_oamap *map, uintptr_t key, void *value,
+		     void **old_value)
+{
+	struct sys_oamap_slot *slot;
+
+	if (!key_is_live(key)) {
+		return -EINVAL;
+	}
+
+	slot = find(map, key);
+	if (slot != NULL) {
+		if (old_value != NULL) {
+			*old_value = slot->value;
+		}
+		slot->value = value;
+		return 0;
+	}
+
+	if (map->size >= SYS_OAMAP_MAX_SIZE(map->mask + 1)) {
+		return -ENOMEM;
+	}
+
+	place(map, key, value);
+	map->size++;
+	move_step(map, SYS_OAMAP_RESIZE_STEP);
+
+	return 1;
+}
+
+bool sys_oamap_get(const struct sys_oamap *map, uintptr_t key, void **value)
+{
+	struct sys_oamap_slot *slot;
+
+	if (!key_is_live(key)) {
+		return false;
+	}
+
+	slot = find(map, key);
+	if (slot == NULL) {
+		return false;
+	}
+
+	if (value != NULL) {
+		*value = slot->value;
+	}
+
+	return true;
+}
+
+bool sys_oamap_remove(struct sys_oamap *map, uintptr_t key, void **value)
+{
+	struct sys_oamap_slot *slot;
+
+	if (!key_is_live(key)) {
+		return false;
+	}
+
+	slot = probe(map->slots, map->mask, key);
+	if (slot != NULL) {
+		if (value != NULL) {
+			*value = slot->value;
+		}
+		shift_remove(map, slot - map->slots);
+	} else if (map->old_slots != NULL) {
+		slot = probe(map->old_slots, map->old_mask, key);
+		if (slot == NULL) {
+			return false;
+		}
+		if (value != NULL) {
+			*value = slot->value;
+		}
+		slot->key = Z_SYS_OAMAP_KEY_DELETED;
+	} else {
+		return false;
+	}
+
+	map->size--;
+	move_step(map, SYS_OAMAP_RESIZE_STEP);
+
+	return true;
+}
+
+int sys_oamap_resize(struct sys_oamap *map, struct sys_oamap_slot *slots,
+		     uint32_t capacity)
+{
+	__ASSERT(is_power_of_two(capacity) && capacity >= 4,
+		 "Capacity must be a power of 2 of at least 4");
+
+	if (map->old_slots != NULL) {
+		return -EBUSY;
+	}
+
+	if (map->size > SYS_OAMAP_MAX_SIZE(capacity)) {
+		return -ENOMEM;
+	}
+
+	(void)memset(slots, 0, capacity * sizeof(*slots));
+
+	map->old_slots = (map->size > 0) ? map->slots : NULL;
+	map->old_mask = map->mask;
+	map->moved = 0;
+	map->slots = slots;
+	map->mask = capacity - 1;
+
+	return 0;
+}
+
+void sys_oamap_resize_finish(struct sys_oamap *map)
+{
+	move_step(map, UINT32_MAX);
+}
+
+static struct sys_oamap_slot *first_live(struct sys_oamap_slot *slots,
+					 uint32_t i, uint32_t mask)
+{
+	for (; i <= mask; i++) {
+		if (key_is_live(slots[i].key)) {
+			return &slots[i];
+		}
+	}
+
+	return NULL;
+}
+
+struct sys_oamap_slot *sys_oamap_next(const struct sys_oamap *map,
+				      const struct sys_oamap_slot *slot)
+{
+	struct sys_oamap_slot *next;
+	uint32_t i = 0;
+
+	if (slot != NULL) {
+		if (slot >= map->slots && slot <= &map->slots[map->mask]) {
+			i = slot - map->slots + 1;
+		} else {
+			/* Walking the previous array */
+			return first_live(map->old_slots,
+					  slot - map->old_slots + 1,
+					  map->old_mask);
+		}
+	}
+
+	next = first_live(map->slots, i, map->mask);
+	if (next == NULL && map->old_slots != NULL) {
+		next = first_live(map->old_slots, 0, map->old_mask);
+	}
+
+	return next;
+}
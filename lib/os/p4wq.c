@@ -14,11 +14,11 @@ LOG_MODULE_REGISTER(p4wq, CONFIG_LOG_DEFAULT_LEVEL);
 
 struct device;
 
-static void set_prio(struct k_thread *th, struct k_p4wq_work *item)
+static void set_prio(struct k_thread *th, int32_t priority, int32_t deadline)
 {
 	__ASSERT_NO_MSG(!IS_ENABLED(CONFIG_SMP) || !z_is_thread_queued(th));
-	th->base.prio = item->priority;
-	th->base.prio_deadline = item->deadline;
+	th->base.prio = priority;
+	th->base.prio_deadline = deadline;
 }
 
 static bool rb_lessthan(struct rbnode *a, struct rbnode *b)
@@ -26,8 +26,8 @@ static bool rb_lessthan(struct rbnode *a, struct rbnode *b)
 	struct k_p4wq_work *aw = CONTAINER_OF(a, struct k_p4wq_work, rbnode);
 	struct k_p4wq_work *bw = CONTAINER_OF(b, struct k_p4wq_work, rbnode);
 
-	if (aw->priority != bw->priority) {
-		return aw->priority > bw->priority;
+	if (aw->run_prio != bw->run_prio) {
+		return aw->run_prio > bw->run_prio;
 	}
 
 	if (aw->deadline != bw->deadline) {
@@ -52,69 +52,244 @@ static bool thread_was_requeued(struct k_thread *th)
 	return !!(th->base.user_options & K_CALLBACK_STATE);
 }
 
+/* Item a thread was woken up for, until it takes any item.  Only ever
+ * compared with, the item may be gone once the thread took another one.
+ */
+static void thread_set_woken_for(struct k_thread *th, struct k_p4wq_work *w)
+{
+	th->base.swap_data = w;
+}
+
+static bool thread_woken_for(struct k_thread *th, struct k_p4wq_work *w)
+{
+	return th->base.swap_data == w;
+}
+
 /* Slightly different semantics: rb_lessthan must be perfectly
  * symmetric (to produce a single tree structure) and will use the
  * pointer value to break ties where priorities are equal, here we
  * tolerate equality as meaning "not lessthan"
  */
-static inline bool item_lessthan(struct k_p4wq_work *a, struct k_p4wq_work *b)
+static inline bool item_lessthan(struct k_p4wq_work *a, int32_t priority,
+				 int32_t deadline)
 {
-	if (a->priority > b->priority) {
+	if (a->run_prio > priority) {
 		return true;
-	} else if ((a->priority == b->priority) &&
-		   (a->deadline != b->deadline)) {
-		return a->deadline - b->deadline > 0;
+	} else if ((a->run_prio == priority) &&
+		   (a->deadline != deadline)) {
+		return a->deadline - deadline > 0;
 	} else {
 		;
 	}
 	return false;
 }
 
+/* Run queue of the current CPU, where items are submitted and which
+ * threads look at first.
+ */
+static unsigned int curr_rq_id(void)
+{
+#ifdef CONFIG_P4WQ_PER_CPU_QUEUES
+	unsigned int key = arch_irq_lock();
+	unsigned int id = arch_curr_cpu()->id;
+
+	arch_irq_unlock(key);
+
+	return id;
+#else
+	return 0;
+#endif
+}
+
+/* Takes the first item of a run queue, whose lock is held */
+static struct k_p4wq_work *rq_take(struct k_p4wq *queue, struct z_p4wq_rq *rq)
+{
+	struct rbnode *r = rb_get_max(&rq->queue);
+	struct k_p4wq_work *w;
+
+	if (r == NULL) {
+		return NULL;
+	}
+
+	w = CONTAINER_OF(r, struct k_p4wq_work, rbnode);
+	rb_remove(&rq->queue, r);
+	(void)atomic_dec(&queue->pending);
+
+	w->thread = _current;
+	w->woken = NULL;
+	thread_set_woken_for(_current, NULL);
+	sys_dlist_append(&rq->active, &w->dlnode);
+	set_prio(_current, w->run_prio, w->deadline);
+	thread_clear_requeued(_current);
+
+	return w;
+}
+
+/* Takes the first item of the current CPU's run queue, or steals one
+ * from another CPU.
+ */
+static struct k_p4wq_work *take(struct k_p4wq *queue)
+{
+	unsigned int id = curr_rq_id();
+
+	for (unsigned int i = 0; i < Z_P4WQ_NUM_RQ; i++) {
+		struct z_p4wq_rq *rq = &queue->rq[(id + i) % Z_P4WQ_NUM_RQ];
+		k_spinlock_key_t k = k_spin_lock(&rq->lock);
+		struct k_p4wq_work *w = rq_take(queue, rq);
+
+		k_spin_unlock(&rq->lock, k);
+
+		if (w != NULL) {
+			return w;
+		}
+	}
+
+	return NULL;
+}
+
+/* Pends the current thread until there is an item to take */
+static struct k_p4wq_work *wait_for_work(struct k_p4wq *queue)
+{
+	struct k_p4wq_work *w;
+	k_spinlock_key_t k;
+
+	while (true) {
+		if (atomic_get(&queue->pending) > 0) {
+			w = take(queue);
+			if (w != NULL) {
+				return w;
+			}
+		}
+
+		/* Submitters count items before checking for idle
+		 * threads, which count themselves before looking for
+		 * items, so an item is either found here or the
+		 * submitter wakes the thread up.
+		 */
+		k = k_spin_lock(&queue->lock);
+		(void)atomic_inc(&queue->idle);
+
+		w = take(queue);
+		if (w != NULL) {
+			(void)atomic_dec(&queue->idle);
+			k_spin_unlock(&queue->lock, k);
+			return w;
+		}
+
+		/* The thread waking us up uncounts us */
+		z_pend_curr(&queue->lock, k, &queue->waitq, K_FOREVER);
+	}
+}
+
+/* Finishes an item and, in the same critical section, takes the next
+ * one from the same run queue.  The completion is signaled by the
+ * caller once the lock is released, so waking the owner up does not
+ * hold the run queue.
+ */
+static struct k_p4wq_work *finish_and_take(struct k_p4wq *queue,
+					   struct k_p4wq_work *w,
+					   struct k_p4wq_work **done)
+{
+	struct z_p4wq_rq *rq = w->rq;
+	struct k_p4wq_work *next = NULL;
+	k_spinlock_key_t k = k_spin_lock(&rq->lock);
+
+	*done = NULL;
+
+	/* Remove from the active list only if it
+	 * wasn't resubmitted already
+	 */
+	if (!thread_was_requeued(_current)) {
+		sys_dlist_remove(&w->dlnode);
+		w->thread = NULL;
+		*done = w;
+	}
+
+	if (atomic_get(&queue->pending) > 0) {
+		next = rq_take(queue, rq);
+	}
+
+	k_spin_unlock(&rq->lock, k);
+
+	return next;
+}
+
 static FUNC_NORETURN void p4wq_loop(void *p0, void *p1, void *p2)
 {
 	ARG_UNUSED(p1);
 	ARG_UNUSED(p2);
 	struct k_p4wq *queue = p0;
-	k_spinlock_key_t k = k_spin_lock(&queue->lock);
+	struct k_p4wq_work *w = NULL;
+	struct k_p4wq_work *done;
 
 	while (true) {
-		struct rbnode *r = rb_get_max(&queue->queue);
+		if (w == NULL) {
+			w = wait_for_work(queue);
+		}
 
-		if (r) {
-			struct k_p4wq_work *w
-				= CONTAINER_OF(r, struct k_p4wq_work, rbnode);
+		w->handler(w);
 
-			rb_remove(&queue->queue, r);
-			w->thread = _current;
-			sys_dlist_append(&queue->active, &w->dlnode);
-			set_prio(_current, w);
-			thread_clear_requeued(_current);
+		w = finish_and_take(queue, w, &done);
+		if (done != NULL) {
+			k_sem_give(&done->done_sem);
+		}
+	}
+}
 
-			k_spin_unlock(&queue->lock, k);
+/* A thread waiting for a synchronous item lends it its priority */
+static void inherit_prio(struct k_p4wq_work *work)
+{
+	struct z_p4wq_rq *rq = work->rq;
+	int prio = _current->base.prio;
+	k_spinlock_key_t k;
 
-			w->handler(w);
+	if (rq == NULL) {
+		return;
+	}
 
-			k = k_spin_lock(&queue->lock);
+	k = k_spin_lock(&rq->lock);
 
-			/* Remove from the active list only if it
-			 * wasn't resubmitted already
-			 */
-			if (!thread_was_requeued(_current)) {
-				sys_dlist_remove(&w->dlnode);
-				w->thread = NULL;
-				k_sem_give(&w->done_sem);
-			}
-		} else {
-			z_pend_curr(&queue->lock, k, &queue->waitq, K_FOREVER);
-			k = k_spin_lock(&queue->lock);
+	if (work->thread != NULL) {
+		/* Running: the thread keeps the priority until it
+		 * takes its next item
+		 */
+		if (z_is_prio_higher(prio, work->thread->base.prio)) {
+			(void)z_set_prio(work->thread, prio);
+		}
+	} else if (rb_contains(&rq->queue, &work->rbnode) &&
+		   z_is_prio_higher(prio, work->run_prio)) {
+		rb_remove(&rq->queue, &work->rbnode);
+		work->run_prio = prio;
+		rb_insert(&rq->queue, &work->rbnode);
+
+		/* The thread woken up for the item may have taken
+		 * another one meanwhile, it is then left alone
+		 */
+		if ((work->woken != NULL) &&
+		    !thread_woken_for(work->woken, work)) {
+			work->woken = NULL;
+		}
+
+		/* Otherwise it only takes the item at the raised
+		 * priority once it gets to run
+		 */
+		if ((work->woken != NULL) &&
+		    z_is_prio_higher(prio, work->woken->base.prio)) {
+			(void)z_set_prio(work->woken, prio);
 		}
 	}
+
+	k_spin_unlock(&rq->lock, k);
 }
 
 /* Must be called to regain ownership of the work item */
 int k_p4wq_wait(struct k_p4wq_work *work, k_timeout_t timeout)
 {
 	if (work->sync) {
+		if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			inherit_prio(work);
+		}
+
 		return k_sem_take(&work->done_sem, timeout);
 	}
 
@@ -125,8 +300,11 @@ void k_p4wq_init(struct k_p4wq *queue)
 {
 	memset(queue, 0, sizeof(*queue));
 	z_waitq_init(&queue->waitq);
-	queue->queue.lessthan_fn = rb_lessthan;
-	sys_dlist_init(&queue->active);
+
+	for (int i = 0; i < Z_P4WQ_NUM_RQ; i++) {
+		queue->rq[i].queue.lessthan_fn = rb_lessthan;
+		sys_dlist_init(&queue->rq[i].active);
+	}
 }
 
 void k_p4wq_add_thread(struct k_p4wq *queue, struct k_thread *thread,
@@ -216,35 +394,58 @@ SYS_INIT(static_init, APPLICATION, 99);
 
 void k_p4wq_submit(struct k_p4wq *queue, struct k_p4wq_work *item)
 {
-	k_spinlock_key_t k = k_spin_lock(&queue->lock);
+	struct z_p4wq_rq *rq;
+	int32_t priority = item->priority;
+	int32_t deadline;
+	k_spinlock_key_t k;
+	bool first;
 
 	/* Input is a delta time from now (to match
 	 * k_thread_deadline_set()), but we store and use the absolute
 	 * cycle count.
 	 */
 	item->deadline += k_cycle_get_32();
+	deadline = item->deadline;
+	item->run_prio = priority;
+	item->woken = NULL;
 
 	/* Resubmission from within handler?  Remove from active list */
 	if (item->thread == _current) {
+		k = k_spin_lock(&item->rq->lock);
 		sys_dlist_remove(&item->dlnode);
 		thread_set_requeued(_current);
 		item->thread = NULL;
+		k_spin_unlock(&item->rq->lock, k);
 	} else {
 		k_sem_init(&item->done_sem, 0, 1);
 	}
 	__ASSERT_NO_MSG(item->thread == NULL);
 
-	rb_insert(&queue->queue, &item->rbnode);
+	rq = &queue->rq[curr_rq_id()];
+	k = k_spin_lock(&rq->lock);
+
+	rb_insert(&rq->queue, &item->rbnode);
 	item->queue = queue;
+	item->rq = rq;
 
 	/* If there were other items already ahead of it in the queue,
 	 * then we don't need to revisit active thread state and can
 	 * return.
 	 */
-	if (rb_get_max(&queue->queue) != &item->rbnode) {
-		goto out;
+	first = rb_get_max(&rq->queue) == &item->rbnode;
+
+	k_spin_unlock(&rq->lock, k);
+
+	/* See wait_for_work(): count the item before checking for idle
+	 * threads.  Without any, there is no one to wake up.
+	 */
+	(void)atomic_inc(&queue->pending);
+	if (!first || atomic_get(&queue->idle) == 0) {
+		return;
 	}
 
+	k = k_spin_lock(&queue->lock);
+
 	/* Check the list of active (running or preempted) items, if
 	 * there are at least an "active target" of those that are
 	 * higher priority than the new item, then no one needs to be
@@ -253,15 +454,21 @@ void k_p4wq_submit(struct k_p4wq *queue, struct k_p4wq_work *item)
 	struct k_p4wq_work *wi;
 	uint32_t n_beaten_by = 0, active_target = arch_num_cpus();
 
-	SYS_DLIST_FOR_EACH_CONTAINER(&queue->active, wi, dlnode) {
-		/*
-		 * item_lessthan(a, b) == true means a has lower priority than b
-		 * !item_lessthan(a, b) counts all work items with higher or
-		 * equal priority
-		 */
-		if (!item_lessthan(wi, item)) {
-			n_beaten_by++;
+	for (int i = 0; i < Z_P4WQ_NUM_RQ; i++) {
+		k_spinlock_key_t rk = k_spin_lock(&queue->rq[i].lock);
+
+		SYS_DLIST_FOR_EACH_CONTAINER(&queue->rq[i].active, wi, dlnode) {
+			/*
+			 * item_lessthan(a, b) == true means a has lower priority than b
+			 * !item_lessthan(a, b) counts all work items with higher or
+			 * equal priority
+			 */
+			if (!item_lessthan(wi, priority, deadline)) {
+				n_beaten_by++;
+			}
 		}
+
+		k_spin_unlock(&queue->rq[i].lock, rk);
 	}
 
 	if (n_beaten_by >= active_target) {
@@ -281,7 +488,18 @@ void k_p4wq_submit(struct k_p4wq *queue, struct k_p4wq_work *item)
 		goto out;
 	}
 
-	set_prio(th, item);
+	(void)atomic_dec(&queue->idle);
+	set_prio(th, priority, deadline);
+
+	/* Unless already taken, for k_p4wq_wait() to boost it */
+	k_spinlock_key_t rk = k_spin_lock(&rq->lock);
+
+	if (rb_contains(&rq->queue, &item->rbnode)) {
+		item->woken = th;
+		thread_set_woken_for(th, item);
+	}
+	k_spin_unlock(&rq->lock, rk);
+
 	z_ready_thread(th);
 	z_reschedule(&queue->lock, k);
 
@@ -293,14 +511,24 @@ out:
 
 bool k_p4wq_cancel(struct k_p4wq *queue, struct k_p4wq_work *item)
 {
-	k_spinlock_key_t k = k_spin_lock(&queue->lock);
-	bool ret = rb_contains(&queue->queue, &item->rbnode);
+	bool ret = false;
+
+	for (int i = 0; i < Z_P4WQ_NUM_RQ && !ret; i++) {
+		struct z_p4wq_rq *rq = &queue->rq[i];
+		k_spinlock_key_t k = k_spin_lock(&rq->lock);
+
+		ret = rb_contains(&rq->queue, &item->rbnode);
+		if (ret) {
+			rb_remove(&rq->queue, &item->rbnode);
+			(void)atomic_dec(&queue->pending);
+		}
+
+		k_spin_unlock(&rq->lock, k);
+	}
 
 	if (ret) {
-		rb_remove(&queue->queue, &item->rbnode);
 		k_sem_give(&item->done_sem);
 	}
 
-	k_spin_unlock(&queue->lock, k);
 	return ret;
 }
@@ -69,6 +69,25 @@ static void set_color(struct rbnode *n, enum rb_color color)
 	*p = (*p & ~1UL) | (uint8_t)color;
 }
 
+static inline void set_parent(struct rbnode *n, struct rbnode *parent)
+{
+#ifdef CONFIG_RB_PARENT_POINTERS
+	n->parent = parent;
+#else
+	ARG_UNUSED(n);
+	ARG_UNUSED(parent);
+#endif
+}
+
+static inline void augment(struct rbtree *tree, struct rbnode *n)
+{
+	if (tree->augment_fn != NULL) {
+		tree->augment_fn(n);
+	}
+}
+
+#ifndef CONFIG_RB_PARENT_POINTERS
+
 /* Searches the tree down to a node that is either identical with the
  * "node" argument or has an empty/leaf child pointer where "node"
  * should be, leaving all nodes found in the resulting stack.  Note
@@ -97,6 +116,8 @@ static int find_and_stack(struct rbtree *tree, struct rbnode *node,
 	return sz;
 }
 
+#endif
+
 struct rbnode *z_rb_get_minmax(struct rbtree *tree, uint8_t side)
 {
 	struct rbnode *n;
@@ -115,6 +136,8 @@ static uint8_t get_side(struct rbnode *parent, struct rbnode *child)
 	return (get_child(parent, 1U) == child) ? 1U : 0U;
 }
 
+#ifndef CONFIG_RB_PARENT_POINTERS
+
 /* Swaps the position of the two nodes at the top of the provided
  * stack, modifying the stack accordingly. Does not change the color
  * of either node.  That is, it effects the following transition (or
@@ -125,7 +148,7 @@ static uint8_t get_side(struct rbnode *parent, struct rbnode *child)
  * a b            b c
  *
  */
-static void rotate(struct rbnode **stack, int stacksz)
+static void rotate(struct rbtree *tree, struct rbnode **stack, int stacksz)
 {
 	CHECK(stacksz >= 2);
 
@@ -146,13 +169,34 @@ static void rotate(struct rbnode **stack, int stacksz)
 	set_child(parent, side, b);
 	stack[stacksz - 2] = child;
 	stack[stacksz - 1] = parent;
+
+	/* Parent is now below child */
+	augment(tree, parent);
+	augment(tree, child);
+}
+
+/* Calls the augmentation callback on the node and all its ancestors,
+ * bottom up.  Rotations leave the stack pointing at nodes which are no
+ * longer on a single path, so search it again.
+ */
+static void augment_path(struct rbtree *tree, struct rbnode *node,
+			 struct rbnode **stack)
+{
+	if (tree->augment_fn == NULL) {
+		return;
+	}
+
+	for (int i = find_and_stack(tree, node, stack) - 1; i >= 0; i--) {
+		tree->augment_fn(stack[i]);
+	}
 }
 
 /* The node at the top of the provided stack is red, and its parent is
  * too.  Iteratively fix the tree so it becomes a valid red black tree
  * again
  */
-static void fix_extra_red(struct rbnode **stack, int stacksz)
+static void fix_extra_red(struct rbtree *tree, struct rbnode **stack,
+			  int stacksz)
 {
 	while (stacksz > 1) {
 		struct rbnode *node = stack[stacksz - 1];
@@ -198,11 +242,11 @@ static void fix_extra_red(struct rbnode **stack, int stacksz)
 		uint8_t parent_side = get_side(parent, node);
 
 		if (parent_side != side) {
-			rotate(stack, stacksz);
+			rotate(tree, stack, stacksz);
 		}
 
 		/* Rotate the grandparent with parent, swapping colors */
-		rotate(stack, stacksz - 1);
+		rotate(tree, stack, stacksz - 1);
 		set_color(stack[stacksz - 3], BLACK);
 		set_color(stack[stacksz - 2], RED);
 		return;
@@ -218,6 +262,7 @@ void rb_insert(struct rbtree *tree, struct rbnode *node)
 {
 	set_child(node, 0U, NULL);
 	set_child(node, 1U, NULL);
+	augment(tree, node);
 
 	if (tree->root == NULL) {
 		tree->root = node;
@@ -242,7 +287,7 @@ void rb_insert(struct rbtree *tree, struct rbnode *node)
 	set_color(node, RED);
 
 	stack[stacksz++] = node;
-	fix_extra_red(stack, stacksz);
+	fix_extra_red(tree, stack, stacksz);
 
 	if (stacksz > tree->max_depth) {
 		tree->max_depth = stacksz;
@@ -251,6 +296,8 @@ void rb_insert(struct rbtree *tree, struct rbnode *node)
 	/* We may have rotated up into the root! */
 	tree->root = stack[0];
 	CHECK(is_black(tree->root));
+
+	augment_path(tree, node, stack);
 }
 
 /* Called for a node N (at the top of the stack) which after a
@@ -263,8 +310,8 @@ void rb_insert(struct rbtree *tree, struct rbnode *node)
  * then clean it up (replace it with a simple NULL child in the
  * parent) when finished.
  */
-static void fix_missing_black(struct rbnode **stack, int stacksz,
-			      struct rbnode *null_node)
+static void fix_missing_black(struct rbtree *tree, struct rbnode **stack,
+			      int stacksz, struct rbnode *null_node)
 {
 	/* Loop upward until we reach the root */
 	while (stacksz > 1) {
@@ -284,7 +331,7 @@ static void fix_missing_black(struct rbnode **stack, int stacksz,
 		 */
 		if (!is_black(sib)) {
 			stack[stacksz - 1] = sib;
-			rotate(stack, stacksz);
+			rotate(tree, stack, stacksz);
 			set_color(parent, RED);
 			set_color(sib, BLACK);
 			stack[stacksz++] = n;
@@ -334,7 +381,7 @@ static void fix_missing_black(struct rbnode **stack, int stacksz,
 
 			stack[stacksz - 1] = sib;
 			stack[stacksz++] = inner;
-			rotate(stack, stacksz);
+			rotate(tree, stack, stacksz);
 			set_color(sib, RED);
 			set_color(inner, BLACK);
 
@@ -356,7 +403,7 @@ static void fix_missing_black(struct rbnode **stack, int stacksz,
 		set_color(parent, BLACK);
 		set_color(outer, BLACK);
 		stack[stacksz - 1] = sib;
-		rotate(stack, stacksz);
+		rotate(tree, stack, stacksz);
 		if (n == null_node) {
 			set_child(parent, n_side, NULL);
 		}
@@ -472,7 +519,7 @@ void rb_remove(struct rbtree *tree, struct rbnode *node)
 	 */
 	if (child == NULL) {
 		if (is_black(node)) {
-			fix_missing_black(stack, stacksz, node);
+			fix_missing_black(tree, stack, stacksz, node);
 		} else {
 			/* Red childless nodes can just be dropped */
 			set_child(parent, get_side(parent, node), NULL);
@@ -491,6 +538,402 @@ void rb_remove(struct rbtree *tree, struct rbnode *node)
 
 	/* We may have rotated up into the root! */
 	tree->root = stack[0];
+
+	/* Everything that lost the node is above its former parent */
+	augment_path(tree, parent, stack);
+}
+
+#else /* CONFIG_RB_PARENT_POINTERS */
+
+/* Moves node N above its parent P, as rotate() does:
+ *
+ *    P          N
+ *  N  c  -->  a   P
+ * a b            b c
+ *
+ */
+static void rotate_up(struct rbtree *tree, struct rbnode *node)
+{
+	struct rbnode *parent = node->parent;
+	struct rbnode *grandparent = parent->parent;
+	uint8_t side = get_side(parent, node);
+	uint8_t other = (side == 0U) ? 1U : 0U;
+	struct rbnode *b = get_child(node, other);
+
+	if (grandparent != NULL) {
+		set_child(grandparent, get_side(grandparent, parent), node);
+	} else {
+		tree->root = node;
+	}
+	node->parent = grandparent;
+
+	set_child(parent, side, b);
+	if (b != NULL) {
+		b->parent = parent;
+	}
+
+	set_child(node, other, parent);
+	parent->parent = node;
+
+	augment(tree, parent);
+	augment(tree, node);
+}
+
+/* Calls the augmentation callback on the node and all its ancestors */
+static void augment_path(struct rbtree *tree, struct rbnode *node)
+{
+	if (tree->augment_fn == NULL) {
+		return;
+	}
+
+	for (; node != NULL; node = node->parent) {
+		tree->augment_fn(node);
+	}
+}
+
+/* Same as the stack based fix_extra_red(), walking up parent pointers */
+static void fix_extra_red(struct rbtree *tree, struct rbnode *node)
+{
+	struct rbnode *parent;
+
+	while (((parent = node->parent) != NULL) && is_red(parent)) {
+		/* A red parent is never the root */
+		struct rbnode *grandparent = parent->parent;
+		uint8_t side = get_side(grandparent, parent);
+		struct rbnode *aunt = get_child(grandparent,
+						(side == 0U) ? 1U : 0U);
+
+		if ((aunt != NULL) && is_red(aunt)) {
+			set_color(grandparent, RED);
+			set_color(parent, BLACK);
+			set_color(aunt, BLACK);
+			node = grandparent;
+			continue;
+		}
+
+		if (get_side(parent, node) != side) {
+			rotate_up(tree, node);
+			parent = node;
+		}
+
+		rotate_up(tree, parent);
+		set_color(parent, BLACK);
+		set_color(grandparent, RED);
+		break;
+	}
+
+	set_color(tree->root, BLACK);
+}
+
+void rb_insert(struct rbtree *tree, struct rbnode *node)
+{
+	struct rbnode *parent = tree->root;
+	uint8_t side = 0U;
+	int depth = 2;
+
+	set_child(node, 0U, NULL);
+	set_child(node, 1U, NULL);
+	node->parent = NULL;
+	augment(tree, node);
+
+	if (parent == NULL) {
+		tree->root = node;
+		tree->max_depth = 1;
+		set_color(node, BLACK);
+		return;
+	}
+
+	for (;;) {
+		struct rbnode *ch;
+
+		side = tree->lessthan_fn(node, parent) ? 0U : 1U;
+		ch = get_child(parent, side);
+		if (ch == NULL) {
+			break;
+		}
+		parent = ch;
+		depth++;
+	}
+
+	set_child(parent, side, node);
+	node->parent = parent;
+	set_color(node, RED);
+
+	if (depth > tree->max_depth) {
+		tree->max_depth = depth;
+	}
+
+	fix_extra_red(tree, node);
+	augment_path(tree, node);
+}
+
+/* Same as the stack based fix_missing_black(), walking up parent
+ * pointers
+ */
+static void fix_missing_black(struct rbtree *tree, struct rbnode *n,
+			      struct rbnode *null_node)
+{
+	while (n->parent != NULL) {
+		struct rbnode *c0, *c1, *inner, *outer;
+		struct rbnode *parent = n->parent;
+		uint8_t n_side = get_side(parent, n);
+		uint8_t far_side = (n_side == 0U) ? 1U : 0U;
+		struct rbnode *sib = get_child(parent, far_side);
+
+		CHECK(is_black(n));
+
+		/* Guarantee the sibling is black */
+		if (!is_black(sib)) {
+			rotate_up(tree, sib);
+			set_color(parent, RED);
+			set_color(sib, BLACK);
+			sib = get_child(parent, far_side);
+		}
+
+		CHECK(sib);
+
+		c0 = get_child(sib, 0U);
+		c1 = get_child(sib, 1U);
+		if (((c0 == NULL) || is_black(c0)) && ((c1 == NULL) ||
+					is_black(c1))) {
+			if (n == null_node) {
+				set_child(parent, n_side, NULL);
+			}
+
+			set_color(sib, RED);
+			if (is_black(parent)) {
+				n = parent;
+				continue;
+			} else {
+				set_color(parent, BLACK);
+				return;
+			}
+		}
+
+		/* Make sure the outer child of the sibling is red */
+		outer = get_child(sib, far_side);
+		if (!((outer != NULL) && is_red(outer))) {
+			inner = get_child(sib, n_side);
+
+			rotate_up(tree, inner);
+			set_color(sib, RED);
+			set_color(inner, BLACK);
+			outer = sib;
+			sib = inner;
+		}
+
+		CHECK(is_red(outer));
+		set_color(sib, get_color(parent));
+		set_color(parent, BLACK);
+		set_color(outer, BLACK);
+		rotate_up(tree, sib);
+		if (n == null_node) {
+			set_child(parent, n_side, NULL);
+		}
+		return;
+	}
+}
+
+/* Swaps the position in the tree of a node with two children and its
+ * in-order predecessor, which is the rightmost node of its left
+ * subtree.  Colors are swapped too, so only the nodes move.
+ */
+static void swap_with_predecessor(struct rbtree *tree, struct rbnode *node,
+				  struct rbnode *node2)
+{
+	struct rbnode *hiparent = node->parent;
+	struct rbnode *loparent = node2->parent;
+	struct rbnode *right = get_child(node, 1U);
+	struct rbnode *lo = get_child(node2, 0U);
+
+	if (hiparent != NULL) {
+		set_child(hiparent, get_side(hiparent, node), node2);
+	} else {
+		tree->root = node2;
+	}
+	node2->parent = hiparent;
+
+	set_child(node2, 1U, right);
+	right->parent = node2;
+
+	if (loparent == node) {
+		set_child(node2, 0U, node);
+		node->parent = node2;
+	} else {
+		struct rbnode *left = get_child(node, 0U);
+
+		set_child(node2, 0U, left);
+		left->parent = node2;
+		set_child(loparent, 1U, node);
+		node->parent = loparent;
+	}
+
+	set_child(node, 0U, lo);
+	if (lo != NULL) {
+		lo->parent = node;
+	}
+	set_child(node, 1U, NULL);
+
+	enum rb_color ctmp = get_color(node);
+
+	set_color(node, get_color(node2));
+	set_color(node2, ctmp);
+}
+
+void rb_remove(struct rbtree *tree, struct rbnode *node)
+{
+	struct rbnode *parent, *child;
+
+	/* Only the root has no parent, nodes removed get none */
+	if ((node->parent == NULL) && (node != tree->root)) {
+		return;
+	}
+
+	if ((get_child(node, 0U) != NULL) && (get_child(node, 1U) != NULL)) {
+		struct rbnode *node2 = get_child(node, 0U);
+
+		while (get_child(node2, 1U) != NULL) {
+			node2 = get_child(node2, 1U);
+		}
+
+		swap_with_predecessor(tree, node, node2);
+	}
+
+	CHECK((get_child(node, 0U) == NULL) ||
+	      (get_child(node, 1U) == NULL));
+
+	child = get_child(node, 0U);
+	if (child == NULL) {
+		child = get_child(node, 1U);
+	}
+
+	parent = node->parent;
+
+	/* Removing the root */
+	if (parent == NULL) {
+		tree->root = child;
+		if (child != NULL) {
+			child->parent = NULL;
+			set_color(child, BLACK);
+		} else {
+			tree->max_depth = 0;
+		}
+		return;
+	}
+
+	if (child == NULL) {
+		if (is_black(node)) {
+			fix_missing_black(tree, node, node);
+		} else {
+			set_child(parent, get_side(parent, node), NULL);
+		}
+	} else {
+		set_child(parent, get_side(parent, node), child);
+		child->parent = parent;
+
+		__ASSERT(is_black(node) || is_black(child), "both nodes red?!");
+		if (is_red(node) || is_red(child)) {
+			set_color(child, BLACK);
+		}
+	}
+
+	node->parent = NULL;
+	augment_path(tree, parent);
+}
+
+#endif /* CONFIG_RB_PARENT_POINTERS */
+
+/* Range of the sorted array making up a subtree, see rb_build_sorted() */
+struct rb_build_range {
+	uint32_t lo;
+	uint32_t hi;
+	uint8_t visited;
+};
+
+static inline uint32_t range_mid(uint32_t lo, uint32_t hi)
+{
+	return lo + ((hi - lo) / 2U);
+}
+
+/* Each subtree is rooted at the middle node of its range, so that the
+ * sizes of sibling subtrees differ by at most one and every level but
+ * the deepest one is full.  Nodes of the deepest level are red and all
+ * others black, which keeps the black height equal everywhere.  Nodes
+ * are linked in post-order, children first, so the stack of ranges is
+ * always the path from the root and the augmentation callback sees
+ * complete subtrees.
+ */
+void rb_build_sorted(struct rbtree *tree, struct rbnode **nodes,
+		     uint32_t count)
+{
+	/* A tree of up to UINT32_MAX nodes is at most 32 levels deep */
+	struct rb_build_range stack[32];
+	int top = 0;
+	int deepest = 0;
+
+	tree->root = NULL;
+	tree->max_depth = 0;
+
+	if (count == 0U) {
+		return;
+	}
+
+	for (uint32_t c = count; c > 1U; c >>= 1) {
+		deepest++;
+	}
+
+	stack[0] = (struct rb_build_range){ .lo = 0U, .hi = count };
+
+	while (top >= 0) {
+		struct rb_build_range *r = &stack[top];
+		uint32_t mid = range_mid(r->lo, r->hi);
+		struct rbnode *node, *ch;
+
+		/* Build the left, then the right subtree first */
+		if (r->visited == 0U) {
+			r->visited = 1U;
+			if (r->lo < mid) {
+				stack[++top] = (struct rb_build_range){
+					.lo = r->lo, .hi = mid };
+			}
+			continue;
+		}
+
+		if (r->visited == 1U) {
+			r->visited = 2U;
+			if (mid + 1U < r->hi) {
+				stack[++top] = (struct rb_build_range){
+					.lo = mid + 1U, .hi = r->hi };
+			}
+			continue;
+		}
+
+		node = nodes[mid];
+		set_child(node, 0U, NULL);
+		set_child(node, 1U, NULL);
+		set_color(node, ((top == deepest) && (top > 0)) ? RED : BLACK);
+
+		if (r->lo < mid) {
+			ch = nodes[range_mid(r->lo, mid)];
+			CHECK(tree->lessthan_fn(ch, node));
+			set_child(node, 0U, ch);
+			set_parent(ch, node);
+		}
+
+		if (mid + 1U < r->hi) {
+			ch = nodes[range_mid(mid + 1U, r->hi)];
+			CHECK(tree->lessthan_fn(node, ch));
+			set_child(node, 1U, ch);
+			set_parent(ch, node);
+		}
+
+		augment(tree, node);
+		top--;
+	}
+
+	tree->root = nodes[range_mid(0U, count)];
+	set_parent(tree->root, NULL);
+	tree->max_depth = deepest + 1;
 }
 
 #ifndef CONFIG_MISRA_SANE
@@ -525,6 +968,33 @@ bool rb_contains(struct rbtree *tree, struct rbnode *node)
 	return n == node;
 }
 
+#ifdef CONFIG_RB_PARENT_POINTERS
+/* The next node is the leftmost node of the right subtree if there is
+ * one, else the first ancestor of which the node is in the left
+ * subtree.
+ */
+struct rbnode *z_rb_foreach_next(struct rbtree *tree, struct _rb_foreach *f)
+{
+	struct rbnode *n = f->cur;
+	struct rbnode *ch;
+
+	if (n == NULL) {
+		n = z_rb_get_minmax(tree, 0U);
+	} else if ((ch = get_child(n, 1U)) != NULL) {
+		for (n = ch; (ch = get_child(n, 0U)) != NULL; n = ch) {
+			;
+		}
+	} else {
+		while ((n->parent != NULL) && (get_side(n->parent, n) == 1U)) {
+			n = n->parent;
+		}
+		n = n->parent;
+	}
+
+	f->cur = n;
+	return n;
+}
+#else
 /* Pushes the node and its chain of left-side children onto the stack
  * in the foreach struct, returning the last node, which is the next
  * node to iterate.  By construction node will always be a right child
@@ -597,3 +1067,4 @@ struct rbnode *z_rb_foreach_next(struct rbtree *tree, struct _rb_foreach *f)
 	f->top--;
 	return (f->top >= 0) ? f->stack[f->top] : NULL;
 }
+#endif /* CONFIG_RB_PARENT_POINTERS */
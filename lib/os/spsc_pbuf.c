@@ -198,19 +198,17 @@ int spsc_pbuf_alloc(struct spsc_pbuf *pb, uint16_t len, char **buf)
 	return len;
 }
 
-void spsc_pbuf_commit(struct spsc_pbuf *pb, uint16_t len)
+/* Commit a packet, returns the index at which it starts. */
+static uint32_t commit(struct spsc_pbuf *pb, uint16_t len)
 {
-	if (len == 0) {
-		return;
-	}
-
 	/* Length of the buffer and flags are immutable - avoid reloading. */
 	const uint32_t pblen = pb->common.len;
 	const uint32_t flags = pb->common.flags;
 	uint32_t *wr_idx_loc = get_wr_idx_loc(pb, flags);
 	uint8_t *data_loc = get_data_loc(pb, flags);
 
-	uint32_t wr_idx = *wr_idx_loc;
+	uint32_t start = *wr_idx_loc;
+	uint32_t wr_idx = start;
 
 	sys_put_be16(len, &data_loc[wr_idx]);
 	__sync_synchronize();
@@ -223,6 +221,53 @@ void spsc_pbuf_commit(struct spsc_pbuf *pb, uint16_t len)
 	*wr_idx_loc = wr_idx;
 	__sync_synchronize();
 	cache_wb(wr_idx_loc, sizeof(*wr_idx_loc), flags);
+
+	return start;
+}
+
+void spsc_pbuf_commit(struct spsc_pbuf *pb, uint16_t len)
+{
+	if (len == 0) {
+		return;
+	}
+
+	(void)commit(pb, len);
+}
+
+bool spsc_pbuf_commit_notify(struct spsc_pbuf *pb, uint16_t len)
+{
+	if (len == 0) {
+		return false;
+	}
+
+	const uint32_t flags = pb->common.flags;
+	uint32_t *rd_idx_loc = get_rd_idx_loc(pb, flags);
+	uint8_t *data_loc = get_data_loc(pb, flags);
+	uint32_t start = commit(pb, len);
+
+	/* Write index was stored with a barrier before reading the read index,
+	 * and the consumer stores the read index with a barrier before reading
+	 * the write index, so either it sees this packet or we see that it is
+	 * done with the previous ones.
+	 */
+	cache_inv(rd_idx_loc, sizeof(*rd_idx_loc), flags);
+	__sync_synchronize();
+
+	uint32_t rd_idx = *rd_idx_loc;
+
+	if (rd_idx == start) {
+		return true;
+	}
+
+	/* The consumer stops at a padding added before the packet when it
+	 * finds the buffer empty.
+	 */
+	if (start == 0) {
+		cache_inv(&data_loc[rd_idx], sizeof(uint8_t), flags);
+		return data_loc[rd_idx] == PADDING_MARK;
+	}
+
+	return false;
 }
 
 int spsc_pbuf_write(struct spsc_pbuf *pb, const char *buf, uint16_t len)
@@ -346,7 +391,7 @@ void spsc_pbuf_free(struct spsc_pbuf *pb, uint16_t len)
 
 	*rd_idx_loc = rd_idx;
 	__sync_synchronize();
-	cache_wb(&rd_idx_loc, sizeof(*rd_idx_loc), flags);
+	cache_wb(rd_idx_loc, sizeof(*rd_idx_loc), flags);
 }
 
 int spsc_pbuf_read(struct spsc_pbuf *pb, char *buf, uint16_t len)
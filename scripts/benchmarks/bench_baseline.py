@@ -0,0 +1,143 @@
+#!/usr/bin/env python3
+# Copyright (c) 2022 Intel Corporation
+#
+# SPDX-License-Identifier: Apache-2.0
+
+# Store and compare benchmark baselines.
+#
+# Benchmarks using the helpers of zephyr/benchmark.h print lines such as:
+#
+#   BENCH name="sched tot" unit=cycles samples=1000 min=.. median=.. p99=.. max=.. mean=..
+#
+# and record them through the "record" option of their testcase.yaml, so
+# twister writes them to recording.csv in the build directory of every
+# test instance. This script collects those files from a twister output
+# directory, saves them as a baseline, or compares them with a baseline
+# and fails when a median or 99th percentile got worse than a threshold.
+#
+# Example:
+#    ./scripts/twister -p native_posix -T tests/benchmarks
+#    ./scripts/benchmarks/bench_baseline.py save twister-out baseline.json
+#    ... change the code and run twister again ...
+#    ./scripts/benchmarks/bench_baseline.py compare twister-out baseline.json
+
+import argparse
+import csv
+import json
+import os
+import sys
+
+FIELDS = ("samples", "min", "median", "p99", "max", "mean")
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+                description="Save or compare benchmark results recorded by twister.")
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    save = sub.add_parser("save", help="Save results as a new baseline")
+    save.add_argument("outdir", help="twister output directory")
+    save.add_argument("baseline", help="Baseline file to write")
+
+    cmp = sub.add_parser("compare", help="Compare results with a baseline")
+    cmp.add_argument("outdir", help="twister output directory")
+    cmp.add_argument("baseline", help="Baseline file to compare with")
+    cmp.add_argument("-t", "--threshold", type=float, default=10.0,
+                     help="Allowed median increase, in percent (default: 10)")
+    cmp.add_argument("--p99-threshold", type=float, default=None,
+                     help="Allowed p99 increase, in percent "
+                          "(default: twice the median threshold)")
+    cmp.add_argument("--min-delta", type=int, default=0,
+                     help="Ignore increases smaller than this absolute value")
+
+    return parser.parse_args()
+
+
+def collect(outdir):
+    """Return {instance: {benchmark name: record}} from recording.csv files"""
+    results = {}
+
+    for root, _, files in os.walk(outdir):
+        if "recording.csv" not in files:
+            continue
+
+        instance = os.path.relpath(root, outdir)
+        with open(os.path.join(root, "recording.csv"), newline="") as f:
+            for row in csv.DictReader(f):
+                if "name" not in row or "median" not in row:
+                    # Recorded by a test not using the benchmark helpers
+                    continue
+                record = {"unit": row.get("unit", "")}
+                for field in FIELDS:
+                    if row.get(field) is not None:
+                        record[field] = int(row[field])
+                results.setdefault(instance, {})[row["name"]] = record
+
+    return results
+
+
+def exceeds(base, new, threshold, min_delta):
+    return new - base > min_delta and new > base * (1 + threshold / 100)
+
+
+def compare(results, baseline, args):
+    p99_threshold = args.p99_threshold
+    if p99_threshold is None:
+        p99_threshold = 2 * args.threshold
+
+    regressions = 0
+    for instance, benches in sorted(results.items()):
+        for name, new in sorted(benches.items()):
+            base = baseline.get(instance, {}).get(name)
+            if base is None:
+                print(f"NEW  {instance}: {name}")
+                continue
+
+            failed = []
+            if exceeds(base["median"], new["median"], args.threshold, args.min_delta):
+                failed.append("median")
+            if "p99" in base and "p99" in new and \
+               exceeds(base["p99"], new["p99"], p99_threshold, args.min_delta):
+                failed.append("p99")
+
+            change = 0.0
+            if base["median"]:
+                change = 100.0 * (new["median"] - base["median"]) / base["median"]
+            status = "FAIL" if failed else "OK  "
+            print(f"{status} {instance}: {name}: median {base['median']} -> "
+                  f"{new['median']} {new['unit']} ({change:+.1f}%)"
+                  + (f" [{', '.join(failed)}]" if failed else ""))
+            regressions += bool(failed)
+
+    for instance, benches in sorted(baseline.items()):
+        for name in sorted(benches):
+            if name not in results.get(instance, {}):
+                print(f"GONE {instance}: {name}")
+
+    return regressions
+
+
+def main():
+    args = parse_args()
+    results = collect(args.outdir)
+
+    if not results:
+        sys.exit(f"No benchmark results found in {args.outdir}")
+
+    if args.command == "save":
+        with open(args.baseline, "w") as f:
+            json.dump(results, f, indent=4, sort_keys=True)
+        print(f"Saved {sum(len(b) for b in results.values())} results "
+              f"to {args.baseline}")
+        return
+
+    with open(args.baseline, "r") as f:
+        baseline = json.load(f)
+
+    regressions = compare(results, baseline, args)
+    if regressions:
+        sys.exit(f"{regressions} benchmark(s) regressed")
+
+
+if __name__ == "__main__":
+    main()
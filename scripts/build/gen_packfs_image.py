@@ -0,0 +1,98 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2022 Intel Corporation
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""Generate a packed read-only file system image from a directory
+
+The image is mounted by the packfs file system (include/zephyr/fs/packfs.h).
+It holds a header, the entries of the files sorted by path, the paths and
+the file data, each file being stored contiguously and aligned.
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+PACKFS_MAGIC = 0x53464b50
+PACKFS_VERSION = 1
+HEADER = struct.Struct('<IHHI')
+ENTRY = struct.Struct('<IIIHH')
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+
+    parser.add_argument("-a", "--align", type=int, default=4,
+                        help="Alignment of the file data (default: 4)")
+    parser.add_argument("-o", "--output", required=True,
+                        help="Output image file")
+    parser.add_argument("dir", help="Directory to pack")
+
+    return parser.parse_args()
+
+
+def collect(root):
+    files = []
+
+    for dirpath, _, filenames in os.walk(root):
+        for name in filenames:
+            path = os.path.join(dirpath, name)
+            rel = os.path.relpath(path, root).replace(os.sep, '/')
+            files.append((rel.encode('utf-8'), path))
+
+    # Sorted by bytes, as the file system looks them up with memcmp()
+    files.sort(key=lambda f: f[0])
+
+    return files
+
+
+def align(offset, alignment):
+    return (offset + alignment - 1) // alignment * alignment
+
+
+def main():
+    args = parse_args()
+
+    if args.align < 1 or args.align & (args.align - 1):
+        sys.exit("alignment must be a power of two")
+
+    files = collect(args.dir)
+    if len(files) > 0xffff:
+        sys.exit("too many files")
+
+    names = b''
+    name_offs = []
+    names_start = HEADER.size + ENTRY.size * len(files)
+    for name, _ in files:
+        name_offs.append(names_start + len(names))
+        names += name
+
+    entries = b''
+    data = b''
+    data_start = align(names_start + len(names), args.align)
+    for (name, path), name_off in zip(files, name_offs):
+        with open(path, 'rb') as f:
+            content = f.read()
+        data += bytes(align(len(data), args.align) - len(data))
+        entries += ENTRY.pack(name_off, data_start + len(data), len(content),
+                              len(name), 0)
+        data += content
+
+    padding = bytes(data_start - names_start - len(names))
+    size = data_start + len(data)
+
+    with open(args.output, 'wb') as f:
+        f.write(HEADER.pack(PACKFS_MAGIC, PACKFS_VERSION, len(files), size))
+        f.write(entries)
+        f.write(names)
+        f.write(padding)
+        f.write(data)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,162 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2022 Intel Corporation.
+#
+# SPDX-License-Identifier: Apache-2.0
+"""
+Convert sampling profiler output to folded stacks.
+
+The input is either the console output of the "profiler dump" shell
+command or a binary blob produced by sampling_profiler_export(). Addresses
+are symbolized using the zephyr.elf symbol table and the result is printed
+in the folded format understood by flamegraph.pl and speedscope:
+
+    ./scripts/profiling/sampling_profiler.py -e build/zephyr/zephyr.elf \\
+        -i console.log > profile.folded
+    flamegraph.pl profile.folded > profile.svg
+"""
+
+import argparse
+import bisect
+import struct
+import sys
+
+from elftools.elf.elffile import ELFFile
+
+EXPORT_MAGIC = 0x4650535a
+NAME_LEN = 16
+HDR_FMT = "IBBBBIII"
+
+
+class Symbolizer:
+    def __init__(self, elf_path):
+        self.addrs = []
+        self.syms = []
+
+        with open(elf_path, "rb") as f:
+            elf = ELFFile(f)
+            self.little_endian = elf.little_endian
+            symtab = elf.get_section_by_name(".symtab")
+            if symtab is None:
+                sys.exit(f"{elf_path}: no symbol table")
+
+            funcs = []
+            for sym in symtab.iter_symbols():
+                if sym["st_info"]["type"] != "STT_FUNC" or sym["st_size"] == 0:
+                    continue
+                # Thumb functions have the low bit set in the symbol value
+                start = sym["st_value"] & ~1
+                funcs.append((start, start + sym["st_size"], sym.name))
+
+        funcs.sort()
+        self.addrs = [f[0] for f in funcs]
+        self.syms = funcs
+
+    def lookup(self, addr):
+        idx = bisect.bisect_right(self.addrs, addr) - 1
+        if idx >= 0:
+            start, end, name = self.syms[idx]
+            if start <= addr < end:
+                return name
+        return f"0x{addr:x}"
+
+
+def parse_text(path):
+    """Yield (thread, [frames outermost first], count) from a shell dump."""
+    in_dump = False
+
+    with open(path, errors="replace") as f:
+        for line in f:
+            if "#PROF:BEGIN" in line:
+                in_dump = True
+                continue
+            if "#PROF:END" in line:
+                in_dump = False
+                continue
+            if not in_dump or "#PROF:" not in line:
+                continue
+
+            # Thread names may contain spaces: the record starts after the
+            # marker and the count is after the last space
+            record = line.split("#PROF:", 1)[1].rstrip()
+            stack, _, count = record.rpartition(" ")
+            if not stack or not count.isdigit():
+                continue
+
+            thread, *frames = stack.split(";")
+            yield thread, [int(a, 16) for a in frames], int(count)
+
+
+def parse_binary(path, little_endian):
+    """Yield (thread, [frames outermost first], count) from an export."""
+    end = "<" if little_endian else ">"
+
+    with open(path, "rb") as f:
+        data = f.read()
+
+    hdr_size = struct.calcsize(end + HDR_FMT)
+    magic, version, frame_size, max_frames, _, records, samples, dropped = \
+        struct.unpack_from(end + HDR_FMT, data)
+    if magic != EXPORT_MAGIC:
+        sys.exit(f"{path}: bad magic 0x{magic:x}")
+    if version != 1:
+        sys.exit(f"{path}: unsupported version {version}")
+
+    print(f"# samples {samples} dropped {dropped}", file=sys.stderr)
+
+    word = "I" if frame_size == 4 else "Q"
+    rec_fmt = f"{end}{word}{NAME_LEN}sII{max_frames}{word}"
+    rec_size = struct.calcsize(rec_fmt)
+
+    off = hdr_size
+    for _ in range(records):
+        fields = struct.unpack_from(rec_fmt, data, off)
+        off += rec_size
+
+        thread, name, count, depth = fields[:4]
+        frames = list(fields[4:4 + depth])
+        name = name.split(b"\0")[0].decode(errors="replace")
+        if not name:
+            name = f"0x{thread:x}"
+
+        yield name, list(reversed(frames)), count
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("-e", "--elf", required=True,
+                        help="zephyr.elf of the profiled image")
+    parser.add_argument("-i", "--input", required=True,
+                        help="console log or binary export")
+    parser.add_argument("-b", "--binary", action="store_true",
+                        help="input is a binary sampling_profiler_export() blob")
+    parser.add_argument("--no-thread", action="store_true",
+                        help="do not use the thread name as the stack root")
+    return parser.parse_args()
+
+
+def main():
+    args = parse_args()
+    sym = Symbolizer(args.elf)
+
+    if args.binary:
+        samples = parse_binary(args.input, sym.little_endian)
+    else:
+        samples = parse_text(args.input)
+
+    folded = {}
+    for thread, frames, count in samples:
+        stack = [sym.lookup(a) for a in frames] or ["[unknown]"]
+        if not args.no_thread:
+            stack.insert(0, thread)
+        key = ";".join(stack)
+        folded[key] = folded.get(key, 0) + count
+
+    for key, count in sorted(folded.items()):
+        print(f"{key} {count}")
+
+
+if __name__ == "__main__":
+    main()
@@ -69,6 +69,20 @@ class Harness:
             self.ordered = config.get('ordered', True)
             self.record = config.get('record', {})
 
+    def parse_record(self, line):
+        if self.record:
+            pattern = re.compile(self.record.get("regex", ""))
+            match = pattern.search(line)
+            if match:
+                csv = []
+                if not self.fieldnames:
+                    for k,v in match.groupdict().items():
+                        self.fieldnames.append(k)
+
+                for k,v in match.groupdict().items():
+                    csv.append(v.strip())
+                self.recording.append(csv)
+
     def process_test(self, line):
 
         runid_match = re.search(self.run_id_pattern, line)
@@ -137,18 +151,7 @@ class Console(Harness):
             self.capture_coverage = False
 
 
-        if self.record:
-            pattern = re.compile(self.record.get("regex", ""))
-            match = pattern.search(line)
-            if match:
-                csv = []
-                if not self.fieldnames:
-                    for k,v in match.groupdict().items():
-                        self.fieldnames.append(k)
-
-                for k,v in match.groupdict().items():
-                    csv.append(v.strip())
-                self.recording.append(csv)
+        self.parse_record(line)
 
         self.process_test(line)
 
@@ -285,6 +288,8 @@ class Test(Harness):
             self._match = False
             self.ztest = True
 
+        self.parse_record(line)
+
         self.process_test(line)
 
         if not self.ztest and self.state:
@@ -0,0 +1,434 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** @file
+ *  @brief Statistical sampling CPU profiler
+ *
+ * Samples are taken from a kernel timer expiry function, i.e. from the
+ * system timer interrupt, and stored in an open addressing hash table
+ * keyed by (thread, call stack). Linear probing keeps the ISR path short
+ * and allocation free; when the table is full new stacks are dropped and
+ * accounted for in the statistics.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/debug/sampling_profiler.h>
+#include <zephyr/sys/util.h>
+#include <string.h>
+#include <errno.h>
+
+#ifdef CONFIG_SAMPLING_PROFILER_SHELL
+#include <zephyr/shell/shell.h>
+#include <stdlib.h>
+#endif
+
+BUILD_ASSERT((CONFIG_SAMPLING_PROFILER_BUCKETS & (CONFIG_SAMPLING_PROFILER_BUCKETS - 1)) == 0,
+	     "CONFIG_SAMPLING_PROFILER_BUCKETS must be a power of two");
+
+#define BUCKET_MASK (CONFIG_SAMPLING_PROFILER_BUCKETS - 1)
+
+static struct sampling_profiler_record table[CONFIG_SAMPLING_PROFILER_BUCKETS];
+static struct sampling_profiler_stats stats;
+static struct k_spinlock lock;
+static struct k_timer sample_timer;
+static bool running;
+
+static uint32_t hash_mix(uint32_t h, uintptr_t v)
+{
+	/* FNV-1a over the word, good enough to spread code addresses
+	 * which mostly differ in their low bits.
+	 */
+	for (size_t i = 0; i < sizeof(v); i++) {
+		h ^= (uint8_t)(v >> (i * 8U));
+		h *= 16777619U;
+	}
+
+	return h;
+}
+
+static uint32_t record_hash(const struct k_thread *thread,
+			    const uintptr_t *frames, size_t depth)
+{
+	uint32_t h = hash_mix(2166136261U, (uintptr_t)thread);
+
+	for (size_t i = 0; i < depth; i++) {
+		h = hash_mix(h, frames[i]);
+	}
+
+	return h;
+}
+
+static bool record_match(const struct sampling_profiler_record *rec,
+			 const struct k_thread *thread,
+			 const uintptr_t *frames, size_t depth)
+{
+	return (rec->thread == thread) && (rec->depth == depth) &&
+	       (memcmp(rec->frames, frames, depth * sizeof(frames[0])) == 0);
+}
+
+static void record_init(struct sampling_profiler_record *rec,
+			const struct k_thread *thread,
+			const uintptr_t *frames, size_t depth)
+{
+	const char *name = NULL;
+
+	rec->thread = thread;
+	rec->depth = depth;
+	memcpy(rec->frames, frames, depth * sizeof(frames[0]));
+
+#ifdef CONFIG_THREAD_NAME
+	if (thread != NULL) {
+		name = thread->name;
+	}
+#endif
+	if (name != NULL && name[0] != '\0') {
+		strncpy(rec->name, name, sizeof(rec->name) - 1);
+		rec->name[sizeof(rec->name) - 1] = '\0';
+	} else {
+		rec->name[0] = '\0';
+	}
+}
+
+void sampling_profiler_record(const struct k_thread *thread,
+			      const uintptr_t *frames, size_t depth)
+{
+	k_spinlock_key_t key;
+	uint32_t idx;
+
+	depth = MIN(depth, CONFIG_SAMPLING_PROFILER_MAX_FRAMES);
+	idx = record_hash(thread, frames, depth) & BUCKET_MASK;
+
+	key = k_spin_lock(&lock);
+
+	stats.samples++;
+
+	for (size_t probe = 0; probe < CONFIG_SAMPLING_PROFILER_BUCKETS; probe++) {
+		struct sampling_profiler_record *rec = &table[idx];
+
+		if (rec->count == 0U) {
+			record_init(rec, thread, frames, depth);
+			rec->count = 1U;
+			stats.records++;
+			k_spin_unlock(&lock, key);
+			return;
+		}
+
+		if (record_match(rec, thread, frames, depth)) {
+			rec->count++;
+			k_spin_unlock(&lock, key);
+			return;
+		}
+
+		idx = (idx + 1U) & BUCKET_MASK;
+	}
+
+	stats.dropped++;
+
+	k_spin_unlock(&lock, key);
+}
+
+#if defined(CONFIG_CPU_CORTEX_M)
+/* The sampler runs from the SysTick (or other timer) handler. The
+ * interrupted thread context was stacked by hardware on the process
+ * stack: r0-r3, r12, lr, pc, xpsr. Samples taken while another ISR was
+ * running are attributed to the thread that ISR preempted.
+ */
+static size_t sample_frames(uintptr_t *frames)
+{
+	uint32_t *esf;
+	size_t depth = 0;
+
+	__asm__ volatile("mrs %0, psp" : "=r"(esf));
+
+	if (esf == NULL) {
+		return 0;
+	}
+
+	frames[depth++] = esf[6];
+#if CONFIG_SAMPLING_PROFILER_MAX_FRAMES > 1
+	/* LR of the interrupted function is usually its caller, strip the
+	 * Thumb bit so the host can symbolize it.
+	 */
+	frames[depth++] = esf[5] & ~1U;
+#endif
+
+	return depth;
+}
+#else
+/* No portable way to get at the interrupted context, samples only carry
+ * the thread; architectures with an unwinder can feed full samples
+ * through sampling_profiler_record().
+ */
+static size_t sample_frames(uintptr_t *frames)
+{
+	ARG_UNUSED(frames);
+
+	return 0;
+}
+#endif
+
+static void sample_timer_expiry(struct k_timer *timer)
+{
+	uintptr_t frames[CONFIG_SAMPLING_PROFILER_MAX_FRAMES];
+	size_t depth;
+
+	ARG_UNUSED(timer);
+
+	depth = sample_frames(frames);
+	sampling_profiler_record(k_current_get(), frames, depth);
+}
+
+int sampling_profiler_start(uint32_t frequency)
+{
+	k_spinlock_key_t key;
+	k_timeout_t period;
+
+	if (frequency == 0U) {
+		frequency = CONFIG_SAMPLING_PROFILER_FREQUENCY;
+	}
+
+	if (frequency > CONFIG_SYS_CLOCK_TICKS_PER_SEC) {
+		return -EINVAL;
+	}
+
+	period = K_TICKS(CONFIG_SYS_CLOCK_TICKS_PER_SEC / frequency);
+
+	key = k_spin_lock(&lock);
+	if (running) {
+		k_spin_unlock(&lock, key);
+		return -EALREADY;
+	}
+	k_timer_init(&sample_timer, sample_timer_expiry, NULL);
+	k_timer_start(&sample_timer, period, period);
+	running = true;
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+void sampling_profiler_stop(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	/* The timer is only initialized once started */
+	if (running) {
+		k_timer_stop(&sample_timer);
+		running = false;
+	}
+	k_spin_unlock(&lock, key);
+}
+
+bool sampling_profiler_is_running(void)
+{
+	return running;
+}
+
+void sampling_profiler_reset(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	memset(table, 0, sizeof(table));
+	memset(&stats, 0, sizeof(stats));
+
+	k_spin_unlock(&lock, key);
+}
+
+void sampling_profiler_foreach(sampling_profiler_cb_t cb, void *user_data)
+{
+	struct sampling_profiler_record rec;
+
+	for (size_t i = 0; i < ARRAY_SIZE(table); i++) {
+		k_spinlock_key_t key = k_spin_lock(&lock);
+
+		rec = table[i];
+		k_spin_unlock(&lock, key);
+
+		if (rec.count != 0U) {
+			cb(&rec, user_data);
+		}
+	}
+}
+
+void sampling_profiler_stats_get(struct sampling_profiler_stats *out)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	*out = stats;
+
+	k_spin_unlock(&lock, key);
+}
+
+#define EXPORT_RECORD_SIZE (sizeof(uintptr_t) + SAMPLING_PROFILER_NAME_LEN + \
+			    2 * sizeof(uint32_t) +				\
+			    CONFIG_SAMPLING_PROFILER_MAX_FRAMES * sizeof(uintptr_t))
+
+size_t sampling_profiler_export_size(void)
+{
+	struct sampling_profiler_stats s;
+
+	sampling_profiler_stats_get(&s);
+
+	return sizeof(struct sampling_profiler_export_hdr) +
+	       s.records * EXPORT_RECORD_SIZE;
+}
+
+struct export_ctx {
+	uint8_t *pos;
+	uint8_t *end;
+	uint32_t records;
+};
+
+static void export_cb(const struct sampling_profiler_record *rec, void *user_data)
+{
+	struct export_ctx *ctx = user_data;
+	uintptr_t thread = (uintptr_t)rec->thread;
+	uint32_t depth = rec->depth;
+
+	/* Records added while exporting are silently left out */
+	if ((size_t)(ctx->end - ctx->pos) < EXPORT_RECORD_SIZE) {
+		return;
+	}
+
+	memcpy(ctx->pos, &thread, sizeof(thread));
+	ctx->pos += sizeof(thread);
+	memcpy(ctx->pos, rec->name, SAMPLING_PROFILER_NAME_LEN);
+	ctx->pos += SAMPLING_PROFILER_NAME_LEN;
+	memcpy(ctx->pos, &rec->count, sizeof(rec->count));
+	ctx->pos += sizeof(rec->count);
+	memcpy(ctx->pos, &depth, sizeof(depth));
+	ctx->pos += sizeof(depth);
+	memset(ctx->pos, 0, CONFIG_SAMPLING_PROFILER_MAX_FRAMES * sizeof(uintptr_t));
+	memcpy(ctx->pos, rec->frames, depth * sizeof(uintptr_t));
+	ctx->pos += CONFIG_SAMPLING_PROFILER_MAX_FRAMES * sizeof(uintptr_t);
+
+	ctx->records++;
+}
+
+int sampling_profiler_export(uint8_t *buf, size_t len)
+{
+	struct sampling_profiler_export_hdr hdr = {
+		.magic = SAMPLING_PROFILER_EXPORT_MAGIC,
+		.version = SAMPLING_PROFILER_EXPORT_VERSION,
+		.frame_size = sizeof(uintptr_t),
+		.max_frames = CONFIG_SAMPLING_PROFILER_MAX_FRAMES,
+	};
+	struct sampling_profiler_stats s;
+	struct export_ctx ctx;
+
+	sampling_profiler_stats_get(&s);
+
+	if (len < sizeof(hdr) + s.records * EXPORT_RECORD_SIZE) {
+		return -ENOMEM;
+	}
+
+	ctx.pos = buf + sizeof(hdr);
+	ctx.end = buf + len;
+	ctx.records = 0;
+
+	sampling_profiler_foreach(export_cb, &ctx);
+
+	hdr.records = ctx.records;
+	hdr.samples = s.samples;
+	hdr.dropped = s.dropped;
+	memcpy(buf, &hdr, sizeof(hdr));
+
+	return ctx.pos - buf;
+}
+
+#ifdef CONFIG_SAMPLING_PROFILER_SHELL
+
+static int cmd_profiler_start(const struct shell *sh, size_t argc, char **argv)
+{
+	uint32_t frequency = 0;
+	int err;
+
+	if (argc > 1) {
+		frequency = strtoul(argv[1], NULL, 10);
+	}
+
+	err = sampling_profiler_start(frequency);
+	if (err) {
+		shell_error(sh, "Failed to start profiler (err %d)", err);
+		return err;
+	}
+
+	return 0;
+}
+
+static int cmd_profiler_stop(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	sampling_profiler_stop();
+
+	return 0;
+}
+
+static int cmd_profiler_reset(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	sampling_profiler_reset();
+
+	return 0;
+}
+
+/* Print one folded stack per line, outermost frame first, in the format
+ * expected by flamegraph.pl once addresses have been symbolized, after a
+ * marker telling records from other console output:
+ *   #PROF:<thread>;0x<frame>;...;0x<pc> <count>
+ */
+static void dump_cb(const struct sampling_profiler_record *rec, void *user_data)
+{
+	const struct shell *sh = user_data;
+	char line[SAMPLING_PROFILER_NAME_LEN +
+		  CONFIG_SAMPLING_PROFILER_MAX_FRAMES * (sizeof(uintptr_t) * 2 + 3) + 12];
+	int pos;
+
+	if (rec->name[0] != '\0') {
+		pos = snprintk(line, sizeof(line), "%s", rec->name);
+	} else {
+		pos = snprintk(line, sizeof(line), "%p", (void *)rec->thread);
+	}
+
+	for (int i = rec->depth - 1; i >= 0 && pos < sizeof(line); i--) {
+		pos += snprintk(&line[pos], sizeof(line) - pos, ";0x%lx",
+				(unsigned long)rec->frames[i]);
+	}
+
+	shell_print(sh, "#PROF:%s %u", line, rec->count);
+}
+
+static int cmd_profiler_dump(const struct shell *sh, size_t argc, char **argv)
+{
+	struct sampling_profiler_stats s;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	sampling_profiler_stats_get(&s);
+
+	shell_print(sh, "#PROF:BEGIN samples %u dropped %u records %u",
+		    s.samples, s.dropped, s.records);
+	sampling_profiler_foreach(dump_cb, (void *)sh);
+	shell_print(sh, "#PROF:END");
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_profiler,
+	SHELL_CMD_ARG(start, NULL, "[frequency in Hz]", cmd_profiler_start, 1, 1),
+	SHELL_CMD(stop, NULL, "Stop sampling.", cmd_profiler_stop),
+	SHELL_CMD(reset, NULL, "Clear collected samples.", cmd_profiler_reset),
+	SHELL_CMD(dump, NULL, "Print folded stacks.", cmd_profiler_dump),
+	SHELL_SUBCMD_SET_END /* Array terminated. */
+);
+
+SHELL_CMD_REGISTER(profiler, &sub_profiler, "Sampling profiler commands", NULL);
+
+#endif /* CONFIG_SAMPLING_PROFILER_SHELL */
@@ -12,6 +12,7 @@
 #include <zephyr/storage/disk_access.h>
 #include <errno.h>
 #include <zephyr/device.h>
+#include "disk_cache.h"
 
 #define LOG_LEVEL CONFIG_DISK_LOG_LEVEL
 #include <zephyr/logging/log.h>
@@ -87,7 +88,11 @@ int disk_access_read(const char *pdrv, uint8_t *data_buf,
 
 	if ((disk != NULL) && (disk->ops != NULL) &&
 				(disk->ops->read != NULL)) {
+#if defined(CONFIG_DISK_CACHE)
+		rc = disk_cache_read(disk, data_buf, start_sector, num_sector);
+#else
 		rc = disk->ops->read(disk, data_buf, start_sector, num_sector);
+#endif
 	}
 
 	return rc;
@@ -101,7 +106,11 @@ int disk_access_write(const char *pdrv, const uint8_t *data_buf,
 
 	if ((disk != NULL) && (disk->ops != NULL) &&
 				(disk->ops->write != NULL)) {
+#if defined(CONFIG_DISK_CACHE)
+		rc = disk_cache_write(disk, data_buf, start_sector, num_sector);
+#else
 		rc = disk->ops->write(disk, data_buf, start_sector, num_sector);
+#endif
 	}
 
 	return rc;
@@ -114,6 +123,14 @@ int disk_access_ioctl(const char *pdrv, uint8_t cmd, void *buf)
 
 	if ((disk != NULL) && (disk->ops != NULL) &&
 				(disk->ops->ioctl != NULL)) {
+#if defined(CONFIG_DISK_CACHE)
+		if (cmd == DISK_IOCTL_CTRL_SYNC) {
+			rc = disk_cache_sync(disk);
+			if (rc) {
+				return rc;
+			}
+		}
+#endif
 		rc = disk->ops->ioctl(disk, cmd, buf);
 	}
 
@@ -137,6 +154,9 @@ int disk_access_register(struct disk_info *disk)
 		goto reg_err;
 	}
 
+#if defined(CONFIG_DISK_CACHE)
+	disk_cache_attach(disk);
+#endif
 	/*  append to the disk list */
 	sys_dlist_append(&disk_access_list, &disk->node);
 	LOG_DBG("disk interface(%s) registered", disk->name);
@@ -161,6 +181,9 @@ int disk_access_unregister(struct disk_info *disk)
 		rc = -EINVAL;
 		goto unreg_err;
 	}
+#if defined(CONFIG_DISK_CACHE)
+	(void)disk_cache_detach(disk);
+#endif
 	/* remove disk node from the list */
 	sys_dlist_remove(&disk->node);
 	LOG_DBG("disk interface(%s) unregistered", disk->name);
@@ -175,6 +198,9 @@ static int disk_init(const struct device *dev)
 
 	k_mutex_init(&mutex);
 	sys_dlist_init(&disk_access_list);
+#if defined(CONFIG_DISK_CACHE)
+	disk_cache_init();
+#endif
 	return 0;
 }
 
@@ -0,0 +1,434 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <errno.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/dlist.h>
+#include <zephyr/storage/disk_access.h>
+#include "disk_cache.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(disk, CONFIG_DISK_LOG_LEVEL);
+
+/* Only the sectors of single sector requests are kept in the cache blocks:
+ * file systems access their metadata one sector at a time and file data in
+ * larger requests, which go to the disk directly.
+ */
+struct disk_cache_block {
+	/* Node in the LRU list, the least recently used block first */
+	sys_dnode_t node;
+	/* Disk of the cached sector, NULL if the block is free */
+	struct disk_info *disk;
+	uint32_t sector;
+	bool dirty;
+	uint8_t data[CONFIG_DISK_CACHE_SECTOR_SIZE] __aligned(4);
+};
+
+static struct disk_cache_block blocks[CONFIG_DISK_CACHE_BLOCKS];
+static sys_dlist_t lru;
+
+#if CONFIG_DISK_CACHE_READ_AHEAD > 0
+/* Sectors read at once on a sequential read miss */
+static struct {
+	/* Disk of the sectors, NULL if the window is empty */
+	struct disk_info *disk;
+	uint32_t start;
+	uint32_t count;
+	uint8_t data[CONFIG_DISK_CACHE_READ_AHEAD *
+		     CONFIG_DISK_CACHE_SECTOR_SIZE] __aligned(4);
+} ra;
+#endif
+
+static K_MUTEX_DEFINE(cache_lock);
+
+/* Query the geometry of the disk, which is not cached if it is unknown or if
+ * its sectors do not fit in the cache blocks.
+ */
+static bool cache_usable(struct disk_info *disk)
+{
+	uint32_t size, count;
+
+	if (disk->cache_sector_size != 0) {
+		return disk->cache_sector_size <= CONFIG_DISK_CACHE_SECTOR_SIZE;
+	}
+
+	if ((disk->ops->ioctl == NULL) ||
+	    disk->ops->ioctl(disk, DISK_IOCTL_GET_SECTOR_SIZE, &size) ||
+	    disk->ops->ioctl(disk, DISK_IOCTL_GET_SECTOR_COUNT, &count) ||
+	    (size == 0)) {
+		return false;
+	}
+
+	if (size > CONFIG_DISK_CACHE_SECTOR_SIZE) {
+		LOG_WRN("%s: %u byte sectors not cached", disk->name, size);
+	}
+
+	disk->cache_sector_count = count;
+	disk->cache_sector_size = size;
+
+	return size <= CONFIG_DISK_CACHE_SECTOR_SIZE;
+}
+
+static void block_touch(struct disk_cache_block *b)
+{
+	sys_dlist_remove(&b->node);
+	sys_dlist_append(&lru, &b->node);
+}
+
+static struct disk_cache_block *block_find(struct disk_info *disk,
+					   uint32_t sector)
+{
+	for (int i = 0; i < ARRAY_SIZE(blocks); i++) {
+		if ((blocks[i].disk == disk) && (blocks[i].sector == sector)) {
+			return &blocks[i];
+		}
+	}
+
+	return NULL;
+}
+
+static int block_write_back(struct disk_cache_block *b)
+{
+	struct disk_info *disk = b->disk;
+	int rc;
+
+	rc = disk->ops->write(disk, b->data, b->sector, 1);
+	if (rc) {
+		LOG_ERR("%s: writing back sector %u failed: %d", disk->name,
+			b->sector, rc);
+		return rc;
+	}
+
+	b->dirty = false;
+	disk->cache_stats.write_backs++;
+
+	return 0;
+}
+
+/* Take the least recently used block for a sector, writing it back first if
+ * it is dirty.
+ */
+static int block_alloc(struct disk_info *disk, uint32_t sector,
+		       struct disk_cache_block **block)
+{
+	struct disk_cache_block *b;
+	int rc;
+
+	b = SYS_DLIST_PEEK_HEAD_CONTAINER(&lru, b, node);
+
+	if (b->disk != NULL) {
+		if (b->dirty) {
+			rc = block_write_back(b);
+			if (rc) {
+				return rc;
+			}
+		}
+		b->disk->cache_stats.evictions++;
+	}
+
+	b->disk = disk;
+	b->sector = sector;
+	b->dirty = false;
+	block_touch(b);
+	*block = b;
+
+	return 0;
+}
+
+static uint8_t *ra_find(struct disk_info *disk, uint32_t sector)
+{
+#if CONFIG_DISK_CACHE_READ_AHEAD > 0
+	if ((ra.disk == disk) && (sector - ra.start < ra.count)) {
+		return &ra.data[(sector - ra.start) * disk->cache_sector_size];
+	}
+#endif
+
+	return NULL;
+}
+
+#if CONFIG_DISK_CACHE_READ_AHEAD > 0
+static int ra_fill(struct disk_info *disk, uint32_t sector)
+{
+	uint32_t count = 1;
+	int rc;
+
+	if (sector < disk->cache_sector_count) {
+		count = MIN(CONFIG_DISK_CACHE_READ_AHEAD,
+			    disk->cache_sector_count - sector);
+	}
+
+	ra.disk = NULL;
+
+	rc = disk->ops->read(disk, ra.data, sector, count);
+	if (rc) {
+		return rc;
+	}
+
+	/* Dirty blocks are newer than the disk, and may be evicted while
+	 * the window is still in use.
+	 */
+	for (int i = 0; i < ARRAY_SIZE(blocks); i++) {
+		if ((blocks[i].disk == disk) && blocks[i].dirty &&
+		    (blocks[i].sector - sector < count)) {
+			memcpy(&ra.data[(blocks[i].sector - sector) *
+					disk->cache_sector_size],
+			       blocks[i].data, disk->cache_sector_size);
+		}
+	}
+
+	ra.disk = disk;
+	ra.start = sector;
+	ra.count = count;
+	disk->cache_stats.read_ahead++;
+
+	return 0;
+}
+#endif
+
+static void ra_update(struct disk_info *disk, const uint8_t *data_buf,
+		      uint32_t start_sector, uint32_t num_sector)
+{
+	uint8_t *dst;
+
+	for (uint32_t i = 0; i < num_sector; i++) {
+		dst = ra_find(disk, start_sector + i);
+		if (dst != NULL) {
+			memcpy(dst, &data_buf[i * disk->cache_sector_size],
+			       disk->cache_sector_size);
+		}
+	}
+}
+
+static const uint8_t *cached_data(struct disk_info *disk, uint32_t sector)
+{
+	struct disk_cache_block *b = block_find(disk, sector);
+
+	if (b != NULL) {
+		block_touch(b);
+		return b->data;
+	}
+
+	return ra_find(disk, sector);
+}
+
+void disk_cache_init(void)
+{
+	sys_dlist_init(&lru);
+
+	for (int i = 0; i < ARRAY_SIZE(blocks); i++) {
+		sys_dlist_append(&lru, &blocks[i].node);
+	}
+}
+
+void disk_cache_attach(struct disk_info *disk)
+{
+	disk->cache_sector_size = 0;
+	disk->cache_sector_count = 0;
+	disk->cache_next_sector = 0;
+	memset(&disk->cache_stats, 0, sizeof(disk->cache_stats));
+}
+
+int disk_cache_read(struct disk_info *disk, uint8_t *data_buf,
+		    uint32_t start_sector, uint32_t num_sector)
+{
+	struct disk_cache_block *b;
+	uint32_t sector = start_sector;
+	uint32_t left = num_sector;
+	const uint8_t *src;
+	bool sequential;
+	uint32_t size;
+	uint32_t run;
+	int rc = 0;
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	if (!cache_usable(disk)) {
+		rc = disk->ops->read(disk, data_buf, start_sector, num_sector);
+		goto end;
+	}
+
+	size = disk->cache_sector_size;
+	sequential = (start_sector == disk->cache_next_sector);
+
+	while (left > 0) {
+		src = cached_data(disk, sector);
+		if (src != NULL) {
+			memcpy(data_buf, src, size);
+			disk->cache_stats.hits++;
+			run = 1;
+			goto next;
+		}
+
+		/* Consecutive sectors missing from the cache */
+		for (run = 1; run < left; run++) {
+			if (cached_data(disk, sector + run) != NULL) {
+				break;
+			}
+		}
+
+#if CONFIG_DISK_CACHE_READ_AHEAD > 0
+		if (sequential && (run < CONFIG_DISK_CACHE_READ_AHEAD)) {
+			rc = ra_fill(disk, sector);
+			if (rc) {
+				break;
+			}
+			run = MIN(run, ra.count);
+			memcpy(data_buf, ra.data, run * size);
+			disk->cache_stats.misses += run;
+			goto next;
+		}
+#endif
+
+		rc = disk->ops->read(disk, data_buf, sector, run);
+		if (rc) {
+			break;
+		}
+		disk->cache_stats.misses += run;
+
+		if (num_sector == 1) {
+			rc = block_alloc(disk, sector, &b);
+			if (rc) {
+				break;
+			}
+			memcpy(b->data, data_buf, size);
+		}
+next:
+		sector += run;
+		data_buf += run * size;
+		left -= run;
+	}
+
+	disk->cache_next_sector = start_sector + num_sector;
+
+end:
+	k_mutex_unlock(&cache_lock);
+
+	return rc;
+}
+
+int disk_cache_write(struct disk_info *disk, const uint8_t *data_buf,
+		     uint32_t start_sector, uint32_t num_sector)
+{
+	struct disk_cache_block *b;
+	uint32_t size;
+	int rc;
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	if (!cache_usable(disk)) {
+		rc = disk->ops->write(disk, data_buf, start_sector, num_sector);
+		goto end;
+	}
+
+	size = disk->cache_sector_size;
+
+	/* Out of range sectors go to the disk to report the error */
+	if (IS_ENABLED(CONFIG_DISK_CACHE_WRITE_BACK) && (num_sector == 1) &&
+	    (start_sector < disk->cache_sector_count)) {
+		b = block_find(disk, start_sector);
+		if (b != NULL) {
+			block_touch(b);
+		} else {
+			rc = block_alloc(disk, start_sector, &b);
+			if (rc) {
+				goto end;
+			}
+		}
+
+		memcpy(b->data, data_buf, size);
+		b->dirty = true;
+		disk->cache_stats.writes_deferred++;
+	} else {
+		rc = disk->ops->write(disk, data_buf, start_sector, num_sector);
+		if (rc) {
+			goto end;
+		}
+
+		/* The written sectors are now clean */
+		for (uint32_t i = 0; i < num_sector; i++) {
+			b = block_find(disk, start_sector + i);
+			if (b != NULL) {
+				memcpy(b->data, &data_buf[i * size], size);
+				b->dirty = false;
+			}
+		}
+	}
+
+	ra_update(disk, data_buf, start_sector, num_sector);
+	rc = 0;
+
+end:
+	k_mutex_unlock(&cache_lock);
+
+	return rc;
+}
+
+int disk_cache_sync(struct disk_info *disk)
+{
+	int rc = 0;
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	for (int i = 0; i < ARRAY_SIZE(blocks); i++) {
+		if ((blocks[i].disk == disk) && blocks[i].dirty) {
+			rc = block_write_back(&blocks[i]);
+			if (rc) {
+				break;
+			}
+		}
+	}
+
+	k_mutex_unlock(&cache_lock);
+
+	return rc;
+}
+
+int disk_cache_detach(struct disk_info *disk)
+{
+	int rc;
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	rc = disk_cache_sync(disk);
+
+	/* Dirty sectors which could not be written back are lost */
+	for (int i = 0; i < ARRAY_SIZE(blocks); i++) {
+		if (blocks[i].disk == disk) {
+			blocks[i].disk = NULL;
+			blocks[i].dirty = false;
+			sys_dlist_remove(&blocks[i].node);
+			sys_dlist_prepend(&lru, &blocks[i].node);
+		}
+	}
+
+#if CONFIG_DISK_CACHE_READ_AHEAD > 0
+	if (ra.disk == disk) {
+		ra.disk = NULL;
+	}
+#endif
+
+	k_mutex_unlock(&cache_lock);
+
+	return rc;
+}
+
+int disk_access_cache_stats_get(const char *pdrv,
+				struct disk_cache_stats *stats)
+{
+	struct disk_info *disk = disk_access_get_di(pdrv);
+
+	if (disk == NULL) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+	*stats = disk->cache_stats;
+	k_mutex_unlock(&cache_lock);
+
+	return 0;
+}
@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_SUBSYS_DISK_DISK_CACHE_H_
+#define ZEPHYR_SUBSYS_DISK_DISK_CACHE_H_
+
+#include <zephyr/drivers/disk.h>
+
+struct disk_info *disk_access_get_di(const char *name);
+
+void disk_cache_init(void);
+
+/* Reset the cache state of a disk being registered */
+void disk_cache_attach(struct disk_info *disk);
+
+int disk_cache_read(struct disk_info *disk, uint8_t *data_buf,
+		    uint32_t start_sector, uint32_t num_sector);
+
+int disk_cache_write(struct disk_info *disk, const uint8_t *data_buf,
+		     uint32_t start_sector, uint32_t num_sector);
+
+/* Write back the dirty sectors of a disk */
+int disk_cache_sync(struct disk_info *disk);
+
+/* Drop the sectors of a disk being unregistered, after writing back the
+ * dirty ones
+ */
+int disk_cache_detach(struct disk_info *disk);
+
+#endif /* ZEPHYR_SUBSYS_DISK_DISK_CACHE_H_ */
@@ -5,6 +5,9 @@
  *
  * Emulator for the Bosch BMI160 accelerometer / gyro. This supports basic
  * init and reading of canned samples. It supports both I2C and SPI buses.
+ *
+ * The headerless FIFO is emulated as always full of canned samples, so that
+ * streaming reads can be exercised at the maximum rate the bus allows.
  */
 
 #define DT_DRV_COMPAT bosch_bmi160
@@ -44,25 +47,83 @@ struct bmi160_emul_cfg {
 /* Names for the PMU components */
 static const char *const pmu_name[] = { "acc", "gyr", "mag", "INV" };
 
+/*
+ * Use hard-coded scales to get values just above 0, 1, 2 and
+ * 3, 4, 5. Values are stored in little endianness.
+ * gyr[x] = 0x0b01  // 3 * 1000000 / BMI160_GYR_SCALE(2000) + 1
+ * gyr[y] = 0x0eac  // 4 * 1000000 / BMI160_GYR_SCALE(2000) + 1
+ * gyr[z] = 0x1257  // 5 * 1000000 / BMI160_GYR_SCALE(2000) + 1
+ * acc[x] = 0x0001  // 0 * 1000000 / BMI160_ACC_SCALE(2) + 1
+ * acc[y] = 0x0689  // 1 * 1000000 / BMI160_ACC_SCALE(2) + 1
+ * acc[z] = 0x0d11  // 2 * 1000000 / BMI160_ACC_SCALE(2) + 1
+ */
+static const uint8_t raw_data[] = { 0x01, 0x0b, 0xac, 0x0e, 0x57, 0x12,
+				    0x01, 0x00, 0x89, 0x06, 0x11, 0x0d };
+
+#define RAW_DATA_GYR_OFS	0
+#define RAW_DATA_ACC_OFS	(BMI160_AXES * sizeof(uint16_t))
+
 static void sample_read(union bmi160_sample *buf)
 {
-	/*
-	 * Use hard-coded scales to get values just above 0, 1, 2 and
-	 * 3, 4, 5. Values are stored in little endianness.
-	 * gyr[x] = 0x0b01  // 3 * 1000000 / BMI160_GYR_SCALE(2000) + 1
-	 * gyr[y] = 0x0eac  // 4 * 1000000 / BMI160_GYR_SCALE(2000) + 1
-	 * gyr[z] = 0x1257  // 5 * 1000000 / BMI160_GYR_SCALE(2000) + 1
-	 * acc[x] = 0x0001  // 0 * 1000000 / BMI160_ACC_SCALE(2) + 1
-	 * acc[y] = 0x0689  // 1 * 1000000 / BMI160_ACC_SCALE(2) + 1
-	 * acc[z] = 0x0d11  // 2 * 1000000 / BMI160_ACC_SCALE(2) + 1
-	 */
-	static uint8_t raw_data[] = { 0x01, 0x0b, 0xac, 0x0e, 0x57, 0x12,
-				      0x01, 0x00, 0x89, 0x06, 0x11, 0x0d };
-
 	LOG_INF("Sample read");
 	memcpy(buf->raw, raw_data, ARRAY_SIZE(raw_data));
 }
 
+/* Get the size of a FIFO frame, 0 if the FIFO is disabled */
+static int fifo_frame_size(const struct emul *target)
+{
+	const struct bmi160_emul_cfg *cfg = target->cfg;
+	uint8_t fifo_cfg = cfg->reg[BMI160_REG_FIFO_CONFIG1];
+	int size = 0;
+
+	if (fifo_cfg & BMI160_FIFO_GYR_EN) {
+		size += BMI160_AXES * sizeof(uint16_t);
+	}
+	if (fifo_cfg & BMI160_FIFO_ACC_EN) {
+		size += BMI160_AXES * sizeof(uint16_t);
+	}
+
+	return size;
+}
+
+static int fifo_length(const struct emul *target)
+{
+	int size = fifo_frame_size(target);
+
+	return size ? ROUND_DOWN(BMI160_FIFO_SIZE, size) : 0;
+}
+
+/* The FIFO is refilled as fast as it is read, so any length can be read */
+static void fifo_read(const struct emul *target, uint8_t *buf, size_t len)
+{
+	const struct bmi160_emul_cfg *cfg = target->cfg;
+	uint8_t fifo_cfg = cfg->reg[BMI160_REG_FIFO_CONFIG1];
+	uint8_t frame[BMI160_AXES * sizeof(uint16_t) * 2];
+	int size = 0;
+	size_t i;
+
+	if (fifo_cfg & BMI160_FIFO_GYR_EN) {
+		memcpy(&frame[size], &raw_data[RAW_DATA_GYR_OFS],
+		       BMI160_AXES * sizeof(uint16_t));
+		size += BMI160_AXES * sizeof(uint16_t);
+	}
+	if (fifo_cfg & BMI160_FIFO_ACC_EN) {
+		memcpy(&frame[size], &raw_data[RAW_DATA_ACC_OFS],
+		       BMI160_AXES * sizeof(uint16_t));
+		size += BMI160_AXES * sizeof(uint16_t);
+	}
+
+	if (size == 0) {
+		/* an empty FIFO reads as 0x80 */
+		memset(buf, 0x80, len);
+		return;
+	}
+
+	for (i = 0; i < len; i++) {
+		buf[i] = frame[i % size];
+	}
+}
+
 static void reg_write(const struct emul *target, int regn, int val)
 {
 	struct bmi160_emul_data *data = target->data;
@@ -83,11 +144,17 @@ static void reg_write(const struct emul *target, int regn, int val)
 	case BMI160_REG_GYR_RANGE:
 		LOG_INF("   * gyr range");
 		break;
+	case BMI160_REG_FIFO_CONFIG1:
+		LOG_INF("   * fifo config");
+		break;
 	case BMI160_REG_CMD:
 		switch (val) {
 		case BMI160_CMD_SOFT_RESET:
 			LOG_INF("   * soft reset");
 			break;
+		case BMI160_CMD_FIFO_FLUSH:
+			LOG_INF("   * fifo flush");
+			break;
 		default:
 			if ((val & BMI160_CMD_PMU_BIT) == BMI160_CMD_PMU_BIT) {
 				int which = (val & BMI160_CMD_PMU_MASK) >> BMI160_CMD_PMU_SHIFT;
@@ -156,6 +223,14 @@ static int reg_read(const struct emul *target, int regn)
 	case BMI160_REG_GYR_RANGE:
 		LOG_INF("   * gyr range");
 		break;
+	case BMI160_REG_FIFO_LENGTH0:
+		LOG_INF("   * fifo length");
+		val = fifo_length(target) & 0xff;
+		break;
+	case BMI160_REG_FIFO_LENGTH1:
+		LOG_INF("   * fifo length");
+		val = fifo_length(target) >> 8;
+		break;
 	default:
 		LOG_INF("Unknown read %x", regn);
 	}
@@ -164,6 +239,26 @@ static int reg_read(const struct emul *target, int regn)
 	return val;
 }
 
+/* Read @a len bytes starting at register @a regn, as a bus burst read does */
+static void burst_read(const struct emul *target, int regn, uint8_t *buf, size_t len)
+{
+	size_t i;
+
+	if (regn == BMI160_REG_FIFO_DATA) {
+		fifo_read(target, buf, len);
+		return;
+	}
+
+	if (regn == BMI160_SAMPLE_BURST_READ_ADDR && len == BMI160_SAMPLE_SIZE) {
+		sample_read((union bmi160_sample *)buf);
+		return;
+	}
+
+	for (i = 0; i < len; i++) {
+		buf[i] = reg_read(target, regn + i);
+	}
+}
+
 #if BMI160_BUS_SPI
 static int bmi160_emul_io_spi(const struct emul *target, const struct spi_config *config,
 			      const struct spi_buf_set *tx_bufs, const struct spi_buf_set *rx_bufs)
@@ -193,27 +288,13 @@ static int bmi160_emul_io_spi(const struct emul *target, const struct spi_config
 				LOG_ERR("Cannot read without rxd");
 				return -EPERM;
 			}
-			switch (txd->len) {
-			case 1:
-				if (regn & BMI160_REG_READ) {
-					regn &= BMI160_REG_MASK;
-					val = reg_read(target, regn);
-					*(uint8_t *)rxd->buf = val;
-				} else {
-					val = *(uint8_t *)txd->buf;
-					reg_write(target, regn, val);
-				}
-				break;
-			case BMI160_SAMPLE_SIZE:
-				if (regn & BMI160_REG_READ) {
-					sample_read(rxd->buf);
-				} else {
-					LOG_INF("Unknown sample write");
-				}
-				break;
-			default:
+			if (regn & BMI160_REG_READ) {
+				burst_read(target, regn & BMI160_REG_MASK, rxd->buf, rxd->len);
+			} else if (txd->len == 1) {
+				val = *(uint8_t *)txd->buf;
+				reg_write(target, regn, val);
+			} else {
 				LOG_INF("Unknown A txd->len %d", txd->len);
-				break;
 			}
 			break;
 		default:
@@ -235,7 +316,6 @@ static int bmi160_emul_transfer_i2c(const struct emul *target, struct i2c_msg *m
 				    int addr)
 {
 	struct bmi160_emul_data *data;
-	unsigned int val;
 
 	data = target->data;
 
@@ -257,18 +337,7 @@ static int bmi160_emul_transfer_i2c(const struct emul *target, struct i2c_msg *m
 		/* Now process the 'read' part of the message */
 		msgs++;
 		if (msgs->flags & I2C_MSG_READ) {
-			switch (msgs->len) {
-			case 1:
-				val = reg_read(target, data->cur_reg);
-				msgs->buf[0] = val;
-				break;
-			case BMI160_SAMPLE_SIZE:
-				sample_read((void *)msgs->buf);
-				break;
-			default:
-				LOG_ERR("Unexpected msg1 length %d", msgs->len);
-				return -EIO;
-			}
+			burst_read(target, data->cur_reg, msgs->buf, msgs->len);
 		} else {
 			if (msgs->len != 1) {
 				LOG_ERR("Unexpected msg1 length %d", msgs->len);
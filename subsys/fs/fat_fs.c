@@ -13,9 +13,11 @@
 #include <zephyr/fs/fs.h>
 #include <zephyr/fs/fs_sys.h>
 #include <zephyr/sys/__assert.h>
+#include <zephyr/storage/disk_access.h>
 #include <ff.h>
 
 #define FATFS_MAX_FILE_NAME 12 /* Uses 8.3 SFN */
+#define FATFS_MAX_VOLUME_NAME 16
 
 /* Memory pool for FatFs directory objects */
 K_MEM_SLAB_DEFINE(fatfs_dirp_pool, sizeof(DIR),
@@ -201,6 +203,120 @@ static ssize_t fatfs_write(struct fs_file_t *zfp, const void *ptr, size_t size)
 	return res;
 }
 
+static ssize_t fatfs_readv(struct fs_file_t *zfp, const struct fs_iovec *iov,
+			   int iovcnt)
+{
+	ssize_t total = 0;
+	unsigned int br;
+	FRESULT res;
+
+	/* FatFs transfers the whole sectors of each buffer directly between
+	 * the buffer and the disk, in one disk access per cluster.
+	 */
+	for (int i = 0; i < iovcnt; i++) {
+		res = f_read(zfp->filep, iov[i].data, iov[i].len, &br);
+		if (res != FR_OK) {
+			return (total > 0) ? total : translate_error(res);
+		}
+
+		total += br;
+		if (br < iov[i].len) {
+			break;
+		}
+	}
+
+	return total;
+}
+
+static ssize_t fatfs_writev(struct fs_file_t *zfp, const struct fs_iovec *iov,
+			    int iovcnt)
+{
+	ssize_t total = -ENOTSUP;
+
+#if !defined(CONFIG_FS_FATFS_READ_ONLY)
+	unsigned int bw;
+	FRESULT res = FR_OK;
+
+	/* Append once for the whole vector */
+	if (zfp->flags & FS_O_APPEND) {
+		res = f_lseek(zfp->filep, f_size((FIL *)zfp->filep));
+		if (res != FR_OK) {
+			return translate_error(res);
+		}
+	}
+
+	total = 0;
+	for (int i = 0; i < iovcnt; i++) {
+		res = f_write(zfp->filep, iov[i].data, iov[i].len, &bw);
+		if (res != FR_OK) {
+			return (total > 0) ? total : translate_error(res);
+		}
+
+		total += bw;
+		if (bw < iov[i].len) {
+			break;
+		}
+	}
+#endif
+
+	return total;
+}
+
+static ssize_t fatfs_pread(struct fs_file_t *zfp, void *ptr, size_t size,
+			   off_t offset)
+{
+	FIL *fp = zfp->filep;
+	FSIZE_t pos = f_tell(fp);
+	unsigned int br = 0;
+	FRESULT res;
+
+	if (offset >= f_size(fp)) {
+		return 0;
+	}
+
+	res = f_lseek(fp, offset);
+	if (res == FR_OK) {
+		res = f_read(fp, ptr, size, &br);
+	}
+
+	if (f_lseek(fp, pos) != FR_OK) {
+		res = FR_DISK_ERR;
+	}
+
+	return (res == FR_OK) ? br : translate_error(res);
+}
+
+static ssize_t fatfs_pwrite(struct fs_file_t *zfp, const void *ptr,
+			    size_t size, off_t offset)
+{
+	int ret = -ENOTSUP;
+
+#if !defined(CONFIG_FS_FATFS_READ_ONLY)
+	FIL *fp = zfp->filep;
+	FSIZE_t pos = f_tell(fp);
+	unsigned int bw = 0;
+	FRESULT res;
+
+	/* Seeking past the end would expand the file with undefined data */
+	if (offset > f_size(fp)) {
+		return -EINVAL;
+	}
+
+	res = f_lseek(fp, offset);
+	if (res == FR_OK) {
+		res = f_write(fp, ptr, size, &bw);
+	}
+
+	if (f_lseek(fp, pos) != FR_OK) {
+		res = FR_DISK_ERR;
+	}
+
+	ret = (res == FR_OK) ? bw : translate_error(res);
+#endif
+
+	return ret;
+}
+
 static int fatfs_seek(struct fs_file_t *zfp, off_t offset, int whence)
 {
 	FRESULT res = FR_OK;
@@ -455,6 +571,25 @@ static int fatfs_unmount(struct fs_mount_t *mountp)
 
 	res = f_mount(NULL, &mountp->mnt_point[1], 0);
 
+#if defined(CONFIG_DISK_CACHE)
+	/* Write back the sectors the disk access cache holds for the volume,
+	 * named as the mount point without its leading '/' and trailing ':'.
+	 */
+	if (res == FR_OK) {
+		char pdrv[FATFS_MAX_VOLUME_NAME + 1];
+		const char *name = &mountp->mnt_point[1];
+		size_t len = strcspn(name, ":");
+
+		if (len < sizeof(pdrv)) {
+			memcpy(pdrv, name, len);
+			pdrv[len] = '\0';
+			if (disk_access_ioctl(pdrv, DISK_IOCTL_CTRL_SYNC, NULL)) {
+				return -EIO;
+			}
+		}
+	}
+#endif
+
 	return translate_error(res);
 }
 
@@ -468,6 +603,10 @@ static const struct fs_file_system_t fatfs_fs = {
 	.tell = fatfs_tell,
 	.truncate = fatfs_truncate,
 	.sync = fatfs_sync,
+	.readv = fatfs_readv,
+	.writev = fatfs_writev,
+	.pread = fatfs_pread,
+	.pwrite = fatfs_pwrite,
 	.opendir = fatfs_opendir,
 	.readdir = fatfs_readdir,
 	.closedir = fatfs_closedir,
@@ -170,6 +170,9 @@ fcb_init(int f_area_id, struct fcb *fcb)
 			break;
 		}
 	}
+	if (rc == 0) {
+		rc = fcb_summary_init(fcb);
+	}
 	k_mutex_init(&fcb->f_mtx);
 	return rc;
 }
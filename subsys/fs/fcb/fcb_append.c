@@ -50,16 +50,42 @@ fcb_append_to_scratch(struct fcb *fcb)
 	if (rc) {
 		return rc;
 	}
+	fcb_summary_sector_new(fcb, sector);
 	fcb->f_active.fe_sector = sector;
 	fcb->f_active.fe_elem_off = fcb_len_in_flash(fcb, sizeof(struct fcb_disk_area));
 	fcb->f_active_id++;
 	return 0;
 }
 
+/*
+ * Make a new sector active for an element taking len bytes in flash, keeping
+ * the scratch sectors free. Called with the mutex held.
+ */
 int
-fcb_append(struct fcb *fcb, uint16_t len, struct fcb_entry *append_loc)
+fcb_append_new_sector(struct fcb *fcb, uint32_t len)
 {
 	struct flash_sector *sector;
+	int rc;
+
+	sector = fcb_new_sector(fcb, fcb->f_scratch_cnt);
+	if (!sector || (sector->fs_size <
+		fcb_len_in_flash(fcb, sizeof(struct fcb_disk_area)) + len)) {
+		return -ENOSPC;
+	}
+	rc = fcb_sector_hdr_init(fcb, sector, fcb->f_active_id + 1);
+	if (rc) {
+		return rc;
+	}
+	fcb_summary_sector_new(fcb, sector);
+	fcb->f_active.fe_sector = sector;
+	fcb->f_active.fe_elem_off = fcb_len_in_flash(fcb, sizeof(struct fcb_disk_area));
+	fcb->f_active_id++;
+	return 0;
+}
+
+int
+fcb_append(struct fcb *fcb, uint16_t len, struct fcb_entry *append_loc)
+{
 	struct fcb_entry *active;
 	int cnt;
 	int rc;
@@ -83,19 +109,10 @@ fcb_append(struct fcb *fcb, uint16_t len, struct fcb_entry *append_loc)
 	}
 	active = &fcb->f_active;
 	if (active->fe_elem_off + len + cnt > active->fe_sector->fs_size) {
-		sector = fcb_new_sector(fcb, fcb->f_scratch_cnt);
-		if (!sector || (sector->fs_size <
-			fcb_len_in_flash(fcb, sizeof(struct fcb_disk_area)) + len + cnt)) {
-			rc = -ENOSPC;
-			goto err;
-		}
-		rc = fcb_sector_hdr_init(fcb, sector, fcb->f_active_id + 1);
+		rc = fcb_append_new_sector(fcb, len + cnt);
 		if (rc) {
 			goto err;
 		}
-		fcb->f_active.fe_sector = sector;
-		fcb->f_active.fe_elem_off = fcb_len_in_flash(fcb, sizeof(struct fcb_disk_area));
-		fcb->f_active_id++;
 	}
 
 	rc = fcb_flash_write(fcb, active->fe_sector, active->fe_elem_off, tmp_str, cnt);
@@ -120,6 +137,7 @@ err:
 int
 fcb_append_finish(struct fcb *fcb, struct fcb_entry *loc)
 {
+	uint32_t ts = 0U;
 	int rc;
 	uint8_t crc8[fcb->f_align];
 	off_t off;
@@ -136,5 +154,20 @@ fcb_append_finish(struct fcb *fcb, struct fcb_entry *loc)
 	if (rc) {
 		return -EIO;
 	}
-	return 0;
+
+	if (!fcb->f_summary) {
+		return 0;
+	}
+
+	/* The entry is only counted once its CRC makes it valid */
+	if (fcb->f_timestamp) {
+		rc = fcb_elem_timestamp(fcb, loc, &ts);
+	}
+	k_mutex_lock(&fcb->f_mtx, K_FOREVER);
+	fcb_summary_add(fcb, loc->fe_sector, 1);
+	if (fcb->f_timestamp && rc == 0) {
+		fcb_summary_ts(fcb, loc->fe_sector, ts);
+	}
+	k_mutex_unlock(&fcb->f_mtx);
+	return rc;
 }
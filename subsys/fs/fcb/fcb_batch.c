@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/sys/crc.h>
+#include <zephyr/fs/fcb.h>
+#include "fcb_priv.h"
+
+/*
+ * Records are encoded in the batch buffer as they are laid out in flash: the
+ * length, the data and the CRC, each padded to the flash alignment with the
+ * erase value. Flushing then takes a single flash write per sector.
+ */
+
+void
+fcb_batch_init(struct fcb_batch *batch, uint8_t *buf, size_t size)
+{
+	batch->fb_buf = buf;
+	batch->fb_size = size;
+	batch->fb_len = 0;
+}
+
+/*
+ * Size in flash of the record starting at rec, and its data offset.
+ */
+static size_t
+fcb_batch_elem_size(struct fcb *fcb, uint8_t *rec, size_t *data_off,
+		    uint16_t *len)
+{
+	int cnt;
+
+	cnt = fcb_get_len(fcb, rec, len);
+	*data_off = fcb_len_in_flash(fcb, cnt);
+	return *data_off + fcb_len_in_flash(fcb, *len) +
+	       fcb_len_in_flash(fcb, FCB_CRC_SZ);
+}
+
+int
+fcb_batch_add(struct fcb *fcb, struct fcb_batch *batch, const void *data,
+	      uint16_t len)
+{
+	uint8_t *rec;
+	size_t size;
+	uint8_t crc8;
+	int cnt;
+	int rc;
+	uint8_t tmp_str[2];
+
+	cnt = fcb_put_len(fcb, tmp_str, len);
+	if (cnt < 0) {
+		return cnt;
+	}
+	size = fcb_len_in_flash(fcb, cnt) + fcb_len_in_flash(fcb, len) +
+	       fcb_len_in_flash(fcb, FCB_CRC_SZ);
+	if (size > batch->fb_size) {
+		return -EINVAL;
+	}
+
+	if (batch->fb_len + size > batch->fb_size) {
+		rc = fcb_batch_flush(fcb, batch);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	rec = &batch->fb_buf[batch->fb_len];
+	memset(rec, fcb->f_erase_value, size);
+	memcpy(rec, tmp_str, cnt);
+	memcpy(rec + fcb_len_in_flash(fcb, cnt), data, len);
+
+	crc8 = crc8_ccitt(CRC8_CCITT_INITIAL_VALUE, tmp_str, cnt);
+	crc8 = crc8_ccitt(crc8, data, len);
+	rec[fcb_len_in_flash(fcb, cnt) + fcb_len_in_flash(fcb, len)] = crc8;
+
+	batch->fb_len += size;
+	return 0;
+}
+
+/*
+ * Write the records from off which fit in the active sector, returns the
+ * number of bytes written.
+ */
+static int
+fcb_batch_write(struct fcb *fcb, struct fcb_batch *batch, size_t off)
+{
+	struct fcb_entry *active = &fcb->f_active;
+	size_t room = active->fe_sector->fs_size - active->fe_elem_off;
+	size_t end, size, data_off;
+	uint32_t first_ts = UINT32_MAX;
+	uint32_t last_ts = 0U;
+	uint32_t count = 0U;
+	uint32_t ts;
+	uint16_t len;
+	int rc;
+
+	for (end = off; end < batch->fb_len; end += size) {
+		size = fcb_batch_elem_size(fcb, &batch->fb_buf[end], &data_off,
+					   &len);
+		if (end + size - off > room) {
+			break;
+		}
+		if (fcb->f_summary && fcb->f_timestamp) {
+			ts = fcb->f_timestamp(&batch->fb_buf[end + data_off],
+					      MIN(len, FCB_TIMESTAMP_DATA_LEN));
+			first_ts = MIN(first_ts, ts);
+			last_ts = MAX(last_ts, ts);
+		}
+		count++;
+	}
+
+	if (end == off) {
+		return 0;
+	}
+
+	rc = fcb_flash_write(fcb, active->fe_sector, active->fe_elem_off,
+			     &batch->fb_buf[off], end - off);
+	if (rc) {
+		return -EIO;
+	}
+	active->fe_elem_off += end - off;
+	fcb_summary_add(fcb, active->fe_sector, count);
+	if (fcb->f_summary && fcb->f_timestamp) {
+		fcb_summary_ts(fcb, active->fe_sector, first_ts);
+		fcb_summary_ts(fcb, active->fe_sector, last_ts);
+	}
+	return end - off;
+}
+
+int
+fcb_batch_flush(struct fcb *fcb, struct fcb_batch *batch)
+{
+	size_t off = 0;
+	size_t data_off;
+	uint16_t len;
+	int rc;
+
+	rc = k_mutex_lock(&fcb->f_mtx, K_FOREVER);
+	if (rc) {
+		return -EINVAL;
+	}
+
+	while (off < batch->fb_len) {
+		rc = fcb_batch_write(fcb, batch, off);
+		if (rc < 0) {
+			break;
+		}
+		if (rc == 0) {
+			/* The next record goes to a new sector */
+			rc = fcb_append_new_sector(fcb,
+				fcb_batch_elem_size(fcb, &batch->fb_buf[off],
+						    &data_off, &len));
+			if (rc) {
+				break;
+			}
+			continue;
+		}
+		off += rc;
+		rc = 0;
+	}
+
+	k_mutex_unlock(&fcb->f_mtx);
+
+	/* Keep the records not written */
+	memmove(batch->fb_buf, &batch->fb_buf[off], batch->fb_len - off);
+	batch->fb_len -= off;
+	return rc;
+}
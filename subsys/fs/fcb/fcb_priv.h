@@ -73,6 +73,15 @@ int fcb_elem_info(struct fcb *fcb, struct fcb_entry *loc);
 int fcb_elem_crc8(struct fcb *fcb, struct fcb_entry *loc, uint8_t *crc8p);
 
 int fcb_sector_hdr_init(struct fcb *fcb, struct flash_sector *sector, uint16_t id);
+int fcb_append_new_sector(struct fcb *fcb, uint32_t len);
+
+int fcb_summary_init(struct fcb *fcb);
+void fcb_summary_sector_new(struct fcb *fcb, struct flash_sector *sector);
+void fcb_summary_sector_erase(struct fcb *fcb, struct flash_sector *sector);
+void fcb_summary_add(struct fcb *fcb, struct flash_sector *sector,
+		     uint32_t count);
+void fcb_summary_ts(struct fcb *fcb, struct flash_sector *sector, uint32_t ts);
+int fcb_elem_timestamp(struct fcb *fcb, struct fcb_entry *loc, uint32_t *ts);
 int fcb_sector_hdr_read(struct fcb *fcb, struct flash_sector *sector,
 			struct fcb_disk_area *fdap);
 
@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/fs/fcb.h>
+#include "fcb_priv.h"
+
+/*
+ * Sector summaries, kept in RAM: the sequence number of the first record, the
+ * number of records and the range of their timestamps, for each sector.
+ */
+
+static struct fcb_sector_summary *
+fcb_summary_get(struct fcb *fcb, struct flash_sector *sector)
+{
+	return &fcb->f_summary[sector - fcb->f_sectors];
+}
+
+static void
+fcb_summary_reset(struct fcb_sector_summary *sum, uint32_t first_seq)
+{
+	sum->fs_first_seq = first_seq;
+	sum->fs_count = 0U;
+	sum->fs_first_ts = UINT32_MAX;
+	sum->fs_last_ts = 0U;
+}
+
+int
+fcb_elem_timestamp(struct fcb *fcb, struct fcb_entry *loc, uint32_t *ts)
+{
+	uint8_t data[FCB_TIMESTAMP_DATA_LEN];
+	size_t len = MIN(loc->fe_data_len, sizeof(data));
+	int rc;
+
+	rc = fcb_flash_read(fcb, loc->fe_sector, loc->fe_data_off, data, len);
+	if (rc) {
+		return -EIO;
+	}
+	*ts = fcb->f_timestamp(data, len);
+	return 0;
+}
+
+/*
+ * Count the records of all the sectors, from the oldest one.
+ */
+int
+fcb_summary_init(struct fcb *fcb)
+{
+	struct fcb_sector_summary *sum;
+	struct flash_sector *sector;
+	struct fcb_entry loc;
+	uint32_t seq = 0U;
+	uint32_t ts;
+	int rc;
+
+	if (!fcb->f_summary) {
+		return 0;
+	}
+
+	for (int i = 0; i < fcb->f_sector_cnt; i++) {
+		fcb_summary_reset(&fcb->f_summary[i], 0U);
+	}
+
+	sector = fcb->f_oldest;
+	while (1) {
+		sum = fcb_summary_get(fcb, sector);
+		sum->fs_first_seq = seq;
+
+		loc.fe_sector = sector;
+		loc.fe_elem_off = 0U;
+		while ((rc = fcb_getnext_nolock(fcb, &loc)) == 0 &&
+		       loc.fe_sector == sector) {
+			if (fcb->f_timestamp) {
+				rc = fcb_elem_timestamp(fcb, &loc, &ts);
+				if (rc) {
+					return rc;
+				}
+				sum->fs_first_ts = MIN(sum->fs_first_ts, ts);
+				sum->fs_last_ts = MAX(sum->fs_last_ts, ts);
+			}
+			sum->fs_count++;
+			seq++;
+		}
+		if (rc != 0 && rc != -ENOTSUP) {
+			return rc;
+		}
+
+		if (sector == fcb->f_active.fe_sector) {
+			break;
+		}
+		sector = fcb_getnext_sector(fcb, sector);
+	}
+	return 0;
+}
+
+/*
+ * The new active sector follows the current one. Called before the switch.
+ */
+void
+fcb_summary_sector_new(struct fcb *fcb, struct flash_sector *sector)
+{
+	struct fcb_sector_summary *active;
+
+	if (!fcb->f_summary) {
+		return;
+	}
+	active = fcb_summary_get(fcb, fcb->f_active.fe_sector);
+	fcb_summary_reset(fcb_summary_get(fcb, sector),
+			  active->fs_first_seq + active->fs_count);
+}
+
+/*
+ * Erased sector, still giving the sequence number of the next record if it
+ * was the active one.
+ */
+void
+fcb_summary_sector_erase(struct fcb *fcb, struct flash_sector *sector)
+{
+	struct fcb_sector_summary *sum;
+
+	if (!fcb->f_summary) {
+		return;
+	}
+	sum = fcb_summary_get(fcb, sector);
+	fcb_summary_reset(sum, sum->fs_first_seq + sum->fs_count);
+}
+
+/*
+ * Records made valid in a sector, which may be older than the active one when
+ * an append was finished after the next sectors were started.
+ */
+void
+fcb_summary_add(struct fcb *fcb, struct flash_sector *sector, uint32_t count)
+{
+	if (!fcb->f_summary) {
+		return;
+	}
+	fcb_summary_get(fcb, sector)->fs_count += count;
+	while (sector != fcb->f_active.fe_sector) {
+		sector = fcb_getnext_sector(fcb, sector);
+		fcb_summary_get(fcb, sector)->fs_first_seq += count;
+	}
+}
+
+void
+fcb_summary_ts(struct fcb *fcb, struct flash_sector *sector, uint32_t ts)
+{
+	struct fcb_sector_summary *sum;
+
+	if (!fcb->f_summary) {
+		return;
+	}
+	sum = fcb_summary_get(fcb, sector);
+	sum->fs_first_ts = MIN(sum->fs_first_ts, ts);
+	sum->fs_last_ts = MAX(sum->fs_last_ts, ts);
+}
+
+int
+fcb_seek_seq(struct fcb *fcb, uint32_t seq, struct fcb_entry *loc)
+{
+	struct fcb_sector_summary *sum;
+	struct flash_sector *sector;
+	uint32_t skip;
+	int rc;
+
+	if (!fcb->f_summary) {
+		return -ENOTSUP;
+	}
+
+	rc = k_mutex_lock(&fcb->f_mtx, K_FOREVER);
+	if (rc) {
+		return -EINVAL;
+	}
+
+	rc = -ENOENT;
+	sector = fcb->f_oldest;
+	while (1) {
+		sum = fcb_summary_get(fcb, sector);
+		if (seq - sum->fs_first_seq < sum->fs_count) {
+			skip = seq - sum->fs_first_seq;
+			loc->fe_sector = sector;
+			loc->fe_elem_off = 0U;
+			do {
+				rc = fcb_getnext_nolock(fcb, loc);
+			} while (rc == 0 && skip-- > 0);
+			if (rc == -ENOTSUP) {
+				rc = -ENOENT;
+			}
+			break;
+		}
+		if (sector == fcb->f_active.fe_sector) {
+			break;
+		}
+		sector = fcb_getnext_sector(fcb, sector);
+	}
+
+	k_mutex_unlock(&fcb->f_mtx);
+	return rc;
+}
+
+int
+fcb_seek_time(struct fcb *fcb, uint32_t ts, struct fcb_entry *loc)
+{
+	struct fcb_sector_summary *sum;
+	struct flash_sector *sector;
+	uint32_t elem_ts;
+	int rc;
+
+	if (!fcb->f_summary || !fcb->f_timestamp) {
+		return -ENOTSUP;
+	}
+
+	rc = k_mutex_lock(&fcb->f_mtx, K_FOREVER);
+	if (rc) {
+		return -EINVAL;
+	}
+
+	rc = -ENOENT;
+	sector = fcb->f_oldest;
+	while (1) {
+		sum = fcb_summary_get(fcb, sector);
+		/* Sectors holding only older records are skipped */
+		if (sum->fs_count > 0U && sum->fs_last_ts >= ts) {
+			loc->fe_sector = sector;
+			loc->fe_elem_off = 0U;
+			while ((rc = fcb_getnext_nolock(fcb, loc)) == 0) {
+				rc = fcb_elem_timestamp(fcb, loc, &elem_ts);
+				if (rc || elem_ts >= ts) {
+					break;
+				}
+			}
+			if (rc == -ENOTSUP) {
+				rc = -ENOENT;
+			}
+			break;
+		}
+		if (sector == fcb->f_active.fe_sector) {
+			break;
+		}
+		sector = fcb_getnext_sector(fcb, sector);
+	}
+
+	k_mutex_unlock(&fcb->f_mtx);
+	return rc;
+}
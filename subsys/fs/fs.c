@@ -237,6 +237,278 @@ ssize_t fs_write(struct fs_file_t *zfp, const void *ptr, size_t size)
 	return rc;
 }
 
+ssize_t fs_readv(struct fs_file_t *zfp, const struct fs_iovec *iov,
+		 int iovcnt)
+{
+	ssize_t total = 0;
+	ssize_t rc;
+
+	if (zfp->mp == NULL) {
+		return -EBADF;
+	}
+
+	if (zfp->mp->fs->readv != NULL) {
+		rc = zfp->mp->fs->readv(zfp, iov, iovcnt);
+		if (rc < 0) {
+			LOG_ERR("file read error (%d)", rc);
+		}
+		return rc;
+	}
+
+	CHECKIF(zfp->mp->fs->read == NULL) {
+		return -ENOTSUP;
+	}
+
+	for (int i = 0; i < iovcnt; i++) {
+		rc = zfp->mp->fs->read(zfp, iov[i].data, iov[i].len);
+		if (rc < 0) {
+			LOG_ERR("file read error (%d)", rc);
+			return (total > 0) ? total : rc;
+		}
+
+		total += rc;
+		if (rc < iov[i].len) {
+			break;
+		}
+	}
+
+	return total;
+}
+
+ssize_t fs_writev(struct fs_file_t *zfp, const struct fs_iovec *iov,
+		  int iovcnt)
+{
+	ssize_t total = 0;
+	ssize_t rc;
+
+	if (zfp->mp == NULL) {
+		return -EBADF;
+	}
+
+	if (zfp->mp->fs->writev != NULL) {
+		rc = zfp->mp->fs->writev(zfp, iov, iovcnt);
+		if (rc < 0) {
+			LOG_ERR("file write error (%d)", rc);
+		}
+		return rc;
+	}
+
+	CHECKIF(zfp->mp->fs->write == NULL) {
+		return -ENOTSUP;
+	}
+
+	for (int i = 0; i < iovcnt; i++) {
+		rc = zfp->mp->fs->write(zfp, iov[i].data, iov[i].len);
+		if (rc < 0) {
+			LOG_ERR("file write error (%d)", rc);
+			return (total > 0) ? total : rc;
+		}
+
+		total += rc;
+		if (rc < iov[i].len) {
+			break;
+		}
+	}
+
+	return total;
+}
+
+/* Positional access emulated by moving the file position around a regular
+ * read or write.
+ */
+static ssize_t fs_rw_at(struct fs_file_t *zfp, void *ptr, size_t size,
+			off_t offset, bool write)
+{
+	const struct fs_file_system_t *fs = zfp->mp->fs;
+	ssize_t rc;
+	off_t pos;
+	int ret;
+
+	CHECKIF((fs->lseek == NULL) || (fs->tell == NULL)) {
+		return -ENOTSUP;
+	}
+
+	pos = fs->tell(zfp);
+	if (pos < 0) {
+		return pos;
+	}
+
+	rc = fs->lseek(zfp, offset, FS_SEEK_SET);
+	if (rc < 0) {
+		return rc;
+	}
+
+	rc = write ? fs->write(zfp, ptr, size) : fs->read(zfp, ptr, size);
+
+	ret = fs->lseek(zfp, pos, FS_SEEK_SET);
+	if ((rc >= 0) && (ret < 0)) {
+		rc = ret;
+	}
+
+	return rc;
+}
+
+ssize_t fs_pread(struct fs_file_t *zfp, void *ptr, size_t size, off_t offset)
+{
+	ssize_t rc;
+
+	if (zfp->mp == NULL) {
+		return -EBADF;
+	}
+
+	if (offset < 0) {
+		return -EINVAL;
+	}
+
+	if (zfp->mp->fs->pread != NULL) {
+		rc = zfp->mp->fs->pread(zfp, ptr, size, offset);
+	} else {
+		CHECKIF(zfp->mp->fs->read == NULL) {
+			return -ENOTSUP;
+		}
+		rc = fs_rw_at(zfp, ptr, size, offset, false);
+	}
+
+	if (rc < 0) {
+		LOG_ERR("file read error (%d)", rc);
+	}
+
+	return rc;
+}
+
+ssize_t fs_pwrite(struct fs_file_t *zfp, const void *ptr, size_t size,
+		  off_t offset)
+{
+	ssize_t rc;
+
+	if (zfp->mp == NULL) {
+		return -EBADF;
+	}
+
+	if ((offset < 0) || (zfp->flags & FS_O_APPEND)) {
+		return -EINVAL;
+	}
+
+	if (zfp->mp->fs->pwrite != NULL) {
+		rc = zfp->mp->fs->pwrite(zfp, ptr, size, offset);
+	} else {
+		CHECKIF(zfp->mp->fs->write == NULL) {
+			return -ENOTSUP;
+		}
+		rc = fs_rw_at(zfp, (void *)ptr, size, offset, true);
+	}
+
+	if (rc < 0) {
+		LOG_ERR("file write error (%d)", rc);
+	}
+
+	return rc;
+}
+
+#if CONFIG_FILE_SYSTEM_MMAP_CACHE_SIZE > 0
+/* Copies of the files which cannot be mapped */
+K_HEAP_DEFINE(mmap_cache, CONFIG_FILE_SYSTEM_MMAP_CACHE_SIZE);
+
+static bool mmap_is_copy(const void *addr)
+{
+	const uint8_t *start = mmap_cache.heap.init_mem;
+
+	return ((const uint8_t *)addr >= start) &&
+	       ((const uint8_t *)addr < start + mmap_cache.heap.init_bytes);
+}
+
+static int mmap_copy(struct fs_file_t *zfp, const void **addr, size_t *size)
+{
+	off_t pos, end;
+	ssize_t len;
+	size_t done;
+	uint8_t *buf;
+	int rc;
+
+	pos = fs_tell(zfp);
+	if (pos < 0) {
+		return pos;
+	}
+
+	rc = fs_seek(zfp, 0, FS_SEEK_END);
+	if (rc < 0) {
+		return rc;
+	}
+
+	end = fs_tell(zfp);
+
+	rc = fs_seek(zfp, pos, FS_SEEK_SET);
+	if (rc < 0) {
+		return rc;
+	}
+
+	if (end < 0) {
+		return end;
+	}
+
+	/* Empty files get a valid address as well */
+	buf = k_heap_alloc(&mmap_cache, MAX(end, 1), K_NO_WAIT);
+	if (buf == NULL) {
+		return -ENOMEM;
+	}
+
+	for (done = 0; done < end; done += len) {
+		len = fs_pread(zfp, &buf[done], end - done, done);
+		if (len <= 0) {
+			k_heap_free(&mmap_cache, buf);
+			return (len < 0) ? len : -EIO;
+		}
+	}
+
+	*addr = buf;
+	*size = end;
+
+	return 0;
+}
+#endif /* CONFIG_FILE_SYSTEM_MMAP_CACHE_SIZE > 0 */
+
+int fs_mmap(struct fs_file_t *zfp, const void **addr, size_t *size)
+{
+	int rc = -ENOTSUP;
+
+	if (zfp->mp == NULL) {
+		return -EBADF;
+	}
+
+	if (zfp->mp->fs->mmap != NULL) {
+		rc = zfp->mp->fs->mmap(zfp, addr, size);
+	}
+
+#if CONFIG_FILE_SYSTEM_MMAP_CACHE_SIZE > 0
+	if (rc == -ENOTSUP) {
+		rc = mmap_copy(zfp, addr, size);
+	}
+#endif
+
+	if ((rc < 0) && (rc != -ENOTSUP)) {
+		LOG_ERR("file map error (%d)", rc);
+	}
+
+	return rc;
+}
+
+int fs_munmap(struct fs_file_t *zfp, const void *addr)
+{
+	if (zfp->mp == NULL) {
+		return -EBADF;
+	}
+
+#if CONFIG_FILE_SYSTEM_MMAP_CACHE_SIZE > 0
+	if (mmap_is_copy(addr)) {
+		k_heap_free(&mmap_cache, (void *)addr);
+	}
+#else
+	ARG_UNUSED(addr);
+#endif
+
+	return 0;
+}
+
 int fs_seek(struct fs_file_t *zfp, off_t offset, int whence)
 {
 	int rc = -ENOTSUP;
@@ -580,6 +852,68 @@ int fs_rename(const char *from, const char *to)
 	return rc;
 }
 
+/* Buffer of fs_copy(), shared by all copies */
+static K_MUTEX_DEFINE(copy_lock);
+static uint8_t copy_buf[CONFIG_FILE_SYSTEM_COPY_BUFFER_SIZE] __aligned(4);
+
+int fs_copy(const char *from, const char *to)
+{
+	struct fs_file_t src, dst;
+	struct fs_dirent entry;
+	ssize_t len;
+	ssize_t rc;
+
+	rc = fs_stat(to, &entry);
+	if (rc == 0) {
+		return -EEXIST;
+	}
+
+	fs_file_t_init(&src);
+	fs_file_t_init(&dst);
+
+	rc = fs_open(&src, from, FS_O_READ);
+	if (rc < 0) {
+		return rc;
+	}
+
+	rc = fs_open(&dst, to, FS_O_CREATE | FS_O_WRITE);
+	if (rc < 0) {
+		(void)fs_close(&src);
+		return rc;
+	}
+
+	k_mutex_lock(&copy_lock, K_FOREVER);
+
+	do {
+		len = fs_read(&src, copy_buf, sizeof(copy_buf));
+		if (len <= 0) {
+			rc = len;
+			break;
+		}
+
+		rc = fs_write(&dst, copy_buf, len);
+		if ((rc >= 0) && (rc < len)) {
+			rc = -ENOSPC;
+		}
+	} while (rc >= 0);
+
+	k_mutex_unlock(&copy_lock);
+
+	(void)fs_close(&src);
+	if (rc == 0) {
+		rc = fs_close(&dst);
+	} else {
+		(void)fs_close(&dst);
+	}
+
+	if (rc < 0) {
+		LOG_ERR("failed to copy %s to %s (%d)", from, to, (int)rc);
+		(void)fs_unlink(to);
+	}
+
+	return rc;
+}
+
 int fs_stat(const char *abs_path, struct fs_dirent *entry)
 {
 	struct fs_mount_t *mp;
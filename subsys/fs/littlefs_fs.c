@@ -381,6 +381,136 @@ static ssize_t littlefs_write(struct fs_file_t *fp, const void *ptr, size_t len)
 	return lfs_to_errno(ret);
 }
 
+static ssize_t littlefs_readv(struct fs_file_t *fp, const struct fs_iovec *iov,
+			      int iovcnt)
+{
+	struct fs_littlefs *fs = fp->mp->fs_data;
+	ssize_t total = 0;
+	lfs_ssize_t ret = 0;
+
+	/* The whole vector is read under the lock, so that it is not
+	 * interleaved with other accesses to the file system.
+	 */
+	fs_lock(fs);
+
+	for (int i = 0; i < iovcnt; i++) {
+		ret = lfs_file_read(&fs->lfs, LFS_FILEP(fp), iov[i].data,
+				    iov[i].len);
+		if (ret < 0) {
+			break;
+		}
+
+		total += ret;
+		if (ret < iov[i].len) {
+			break;
+		}
+	}
+
+	fs_unlock(fs);
+
+	return ((ret < 0) && (total == 0)) ? lfs_to_errno(ret) : total;
+}
+
+static ssize_t littlefs_writev(struct fs_file_t *fp,
+			       const struct fs_iovec *iov, int iovcnt)
+{
+	struct fs_littlefs *fs = fp->mp->fs_data;
+	ssize_t total = 0;
+	lfs_ssize_t ret = 0;
+
+	fs_lock(fs);
+
+	for (int i = 0; i < iovcnt; i++) {
+		ret = lfs_file_write(&fs->lfs, LFS_FILEP(fp), iov[i].data,
+				     iov[i].len);
+		if (ret < 0) {
+			break;
+		}
+
+		total += ret;
+		if (ret < iov[i].len) {
+			break;
+		}
+	}
+
+	fs_unlock(fs);
+
+	return ((ret < 0) && (total == 0)) ? lfs_to_errno(ret) : total;
+}
+
+/* Read or write at a position, restoring the file position under the lock */
+static ssize_t littlefs_rw_at(struct fs_file_t *fp, void *ptr, size_t len,
+			      off_t off, bool write)
+{
+	struct fs_littlefs *fs = fp->mp->fs_data;
+	lfs_file_t *file = LFS_FILEP(fp);
+	lfs_soff_t pos;
+	lfs_ssize_t ret;
+
+	fs_lock(fs);
+
+	pos = lfs_file_tell(&fs->lfs, file);
+	if (pos < 0) {
+		fs_unlock(fs);
+		return lfs_to_errno(pos);
+	}
+
+	ret = lfs_file_seek(&fs->lfs, file, off, LFS_SEEK_SET);
+	if (ret >= 0) {
+		ret = write ? lfs_file_write(&fs->lfs, file, ptr, len) :
+			      lfs_file_read(&fs->lfs, file, ptr, len);
+	}
+
+	pos = lfs_file_seek(&fs->lfs, file, pos, LFS_SEEK_SET);
+	if ((ret >= 0) && (pos < 0)) {
+		ret = pos;
+	}
+
+	fs_unlock(fs);
+
+	return lfs_to_errno(ret);
+}
+
+static ssize_t littlefs_pread(struct fs_file_t *fp, void *ptr, size_t len,
+			      off_t off)
+{
+	return littlefs_rw_at(fp, ptr, len, off, false);
+}
+
+static ssize_t littlefs_pwrite(struct fs_file_t *fp, const void *ptr,
+			       size_t len, off_t off)
+{
+	return littlefs_rw_at(fp, (void *)ptr, len, off, true);
+}
+
+/* Files are CTZ skip-lists whose blocks after the first one start with
+ * pointers, so only a committed file held in a single block is contiguous
+ * in the partition.
+ */
+static int littlefs_mmap(struct fs_file_t *fp, const void **addr, size_t *size)
+{
+	struct fs_littlefs *fs = fp->mp->fs_data;
+	lfs_file_t *file = LFS_FILEP(fp);
+	int rc = -ENOTSUP;
+
+	if (fs->mmap_base == NULL) {
+		return -ENOTSUP;
+	}
+
+	fs_lock(fs);
+
+	if (!(file->flags & (LFS_F_INLINE | LFS_F_DIRTY | LFS_F_WRITING)) &&
+	    (file->ctz.size <= fs->cfg.block_size)) {
+		*addr = fs->mmap_base + (size_t)file->ctz.head * fs->cfg.block_size;
+		*size = file->ctz.size;
+		rc = 0;
+	}
+
+	fs_unlock(fs);
+
+	return rc;
+}
+
 BUILD_ASSERT((FS_SEEK_SET == LFS_SEEK_SET)
 	     && (FS_SEEK_CUR == LFS_SEEK_CUR)
 	     && (FS_SEEK_END == LFS_SEEK_END));
@@ -890,6 +1020,11 @@ static const struct fs_file_system_t littlefs_fs = {
 	.tell = littlefs_tell,
 	.truncate = littlefs_truncate,
 	.sync = littlefs_sync,
+	.readv = littlefs_readv,
+	.writev = littlefs_writev,
+	.pread = littlefs_pread,
+	.pwrite = littlefs_pwrite,
+	.mmap = littlefs_mmap,
 	.opendir = littlefs_opendir,
 	.readdir = littlefs_readdir,
 	.closedir = littlefs_closedir,
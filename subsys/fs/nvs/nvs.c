@@ -6,6 +6,7 @@
  */
 
 #include <zephyr/drivers/flash.h>
+#include <zephyr/init.h>
 #include <string.h>
 #include <errno.h>
 #include <inttypes.h>
@@ -19,6 +20,18 @@ LOG_MODULE_REGISTER(fs_nvs, CONFIG_NVS_LOG_LEVEL);
 static int nvs_prev_ate(struct nvs_fs *fs, uint32_t *addr, struct nvs_ate *ate);
 static int nvs_ate_valid(struct nvs_fs *fs, const struct nvs_ate *entry);
 
+static inline bool nvs_ate_is_chunk(const struct nvs_ate *ate)
+{
+	return ate->part < NVS_PART_LARGE;
+}
+
+#if CONFIG_NVS_STATS
+static uint32_t nvs_us_since(uint32_t start)
+{
+	return k_cyc_to_us_ceil32(k_cycle_get_32() - start);
+}
+#endif
+
 #ifdef CONFIG_NVS_LOOKUP_CACHE
 
 static inline size_t nvs_lookup_cache_pos(uint16_t id)
@@ -61,7 +74,8 @@ static int nvs_lookup_cache_rebuild(struct nvs_fs *fs)
 
 		cache_entry = &fs->lookup_cache[nvs_lookup_cache_pos(ate.id)];
 
-		if (ate.id != 0xFFFF && *cache_entry == NVS_LOOKUP_CACHE_NO_ADDR &&
+		if (ate.id != 0xFFFF && !nvs_ate_is_chunk(&ate) &&
+		    *cache_entry == NVS_LOOKUP_CACHE_NO_ADDR &&
 		    nvs_ate_valid(fs, &ate)) {
 			*cache_entry = ate_addr;
 		}
@@ -168,8 +182,10 @@ static int nvs_flash_ate_wrt(struct nvs_fs *fs, const struct nvs_ate *entry)
 	rc = nvs_flash_al_wrt(fs, fs->ate_wra, entry,
 			       sizeof(struct nvs_ate));
 #ifdef CONFIG_NVS_LOOKUP_CACHE
-	/* 0xFFFF is a special-purpose identifier. Exclude it from the cache */
-	if (entry->id != 0xFFFF) {
+	/* 0xFFFF is a special-purpose identifier. Exclude it from the cache,
+	 * as well as the chunks of large entries which are not looked up.
+	 */
+	if ((entry->id != 0xFFFF) && !nvs_ate_is_chunk(entry)) {
 		fs->lookup_cache[nvs_lookup_cache_pos(entry->id)] = fs->ate_wra;
 	}
 #endif
@@ -189,6 +205,129 @@ static int nvs_flash_data_wrt(struct nvs_fs *fs, const void *data, size_t len)
 	return rc;
 }
 
+/* span of the bytes [skip, skip + len) of an I/O vector */
+struct nvs_span {
+	const struct nvs_iovec *iov;
+	size_t iovcnt;
+	size_t skip;
+	size_t len;
+};
+
+/* consume the next contiguous piece of a span, returns its length */
+static size_t nvs_span_next(struct nvs_span *span, uint8_t **data)
+{
+	size_t n;
+
+	while ((span->len > 0U) && (span->iovcnt > 0U)) {
+		if (span->skip >= span->iov->len) {
+			span->skip -= span->iov->len;
+			span->iov++;
+			span->iovcnt--;
+			continue;
+		}
+
+		n = MIN(span->len, span->iov->len - span->skip);
+		*data = (uint8_t *)span->iov->data + span->skip;
+		span->skip += n;
+		span->len -= n;
+
+		return n;
+	}
+
+	return 0;
+}
+
+/* span of at most len bytes at offset in a span */
+static struct nvs_span nvs_span_sub(const struct nvs_span *span, size_t offset,
+				    size_t len)
+{
+	struct nvs_span sub = *span;
+
+	sub.skip += offset;
+	sub.len = MIN(len, span->len - offset);
+
+	return sub;
+}
+
+/* data written through a buffer, to write small pieces at once */
+struct nvs_wbuf {
+	uint8_t buf[NVS_BLOCK_SIZE];
+	size_t fill;
+	uint32_t addr;
+};
+
+static int nvs_wbuf_flush(struct nvs_fs *fs, struct nvs_wbuf *wb)
+{
+	int rc;
+
+	/* the last write block is padded by nvs_flash_al_wrt */
+	rc = nvs_flash_al_wrt(fs, wb->addr, wb->buf, wb->fill);
+	wb->addr += nvs_al_size(fs, wb->fill);
+	wb->fill = 0U;
+
+	return rc;
+}
+
+static int nvs_wbuf_put(struct nvs_fs *fs, struct nvs_wbuf *wb,
+			const uint8_t *data, size_t len)
+{
+	int rc;
+	size_t n;
+
+	while (len > 0U) {
+		if ((wb->fill == 0U) && (len >= sizeof(wb->buf))) {
+			/* write the aligned part in place */
+			n = len & ~(fs->flash_parameters->write_block_size - 1U);
+			rc = nvs_flash_al_wrt(fs, wb->addr, data, n);
+			wb->addr += n;
+		} else {
+			n = MIN(len, sizeof(wb->buf) - wb->fill);
+			memcpy(&wb->buf[wb->fill], data, n);
+			wb->fill += n;
+			rc = 0;
+			if (wb->fill == sizeof(wb->buf)) {
+				rc = nvs_wbuf_flush(fs, wb);
+			}
+		}
+
+		if (rc) {
+			return rc;
+		}
+
+		data += n;
+		len -= n;
+	}
+
+	return 0;
+}
+
+/* data write of a header followed by the data of a span */
+static int nvs_flash_data_wrtv(struct nvs_fs *fs, const void *hdr,
+			       size_t hdr_len, struct nvs_span span)
+{
+	struct nvs_wbuf wb = { .addr = fs->data_wra };
+	size_t len = hdr_len + span.len;
+	uint8_t *data;
+	size_t n;
+	int rc;
+
+	rc = nvs_wbuf_put(fs, &wb, hdr, hdr_len);
+
+	n = nvs_span_next(&span, &data);
+	while ((rc == 0) && (n > 0U)) {
+		rc = nvs_wbuf_put(fs, &wb, data, n);
+		n = nvs_span_next(&span, &data);
+	}
+
+	if (rc == 0) {
+		rc = nvs_wbuf_flush(fs, &wb);
+	}
+
+	fs->data_wra += nvs_al_size(fs, len);
+
+	return rc;
+}
+
 /* flash ate read */
 static int nvs_flash_ate_rd(struct nvs_fs *fs, uint32_t addr,
 			     struct nvs_ate *entry)
@@ -232,6 +371,48 @@ static int nvs_flash_block_cmp(struct nvs_fs *fs, uint32_t addr, const void *dat
 	return 0;
 }
 
+/* nvs_flash_span_cmp compares the data in flash at addr to the data of a
+ * span, returns 0 if equal, 1 if not equal, errcode if error
+ */
+static int nvs_flash_span_cmp(struct nvs_fs *fs, uint32_t addr,
+			      struct nvs_span span)
+{
+	uint8_t *data;
+	size_t n;
+	int rc;
+
+	for (n = nvs_span_next(&span, &data); n > 0U;
+	     n = nvs_span_next(&span, &data)) {
+		rc = nvs_flash_block_cmp(fs, addr, data, n);
+		if (rc) {
+			return rc;
+		}
+		addr += n;
+	}
+
+	return 0;
+}
+
+/* flash read from nvs address to the data of a span */
+static int nvs_flash_span_rd(struct nvs_fs *fs, uint32_t addr,
+			     struct nvs_span span)
+{
+	uint8_t *data;
+	size_t n;
+	int rc;
+
+	for (n = nvs_span_next(&span, &data); n > 0U;
+	     n = nvs_span_next(&span, &data)) {
+		rc = nvs_flash_rd(fs, addr, data, n);
+		if (rc) {
+			return rc;
+		}
+		addr += n;
+	}
+
+	return 0;
+}
+
 /* nvs_flash_cmp_const compares the data in flash at addr to a constant
  * value. returns 0 if all data in flash is equal to value, 1 if not equal,
  * errcode if error
@@ -402,21 +583,22 @@ static int nvs_close_ate_valid(struct nvs_fs *fs, const struct nvs_ate *entry)
 	return 1;
 }
 
-/* store an entry in flash */
-static int nvs_flash_wrt_entry(struct nvs_fs *fs, uint16_t id, const void *data,
-				size_t len)
+/* store an entry in flash, its data is a header followed by a span */
+static int nvs_flash_wrt_entry(struct nvs_fs *fs, uint16_t id, uint8_t part,
+				const void *hdr, size_t hdr_len,
+				const struct nvs_span *span)
 {
 	int rc;
 	struct nvs_ate entry;
 
 	entry.id = id;
 	entry.offset = (uint16_t)(fs->data_wra & ADDR_OFFS_MASK);
-	entry.len = (uint16_t)len;
-	entry.part = 0xff;
+	entry.len = (uint16_t)(hdr_len + span->len);
+	entry.part = part;
 
 	nvs_ate_crc8_update(&entry);
 
-	rc = nvs_flash_data_wrt(fs, data, len);
+	rc = nvs_flash_data_wrtv(fs, hdr, hdr_len, *span);
 	if (rc) {
 		return rc;
 	}
@@ -534,6 +716,183 @@ static void nvs_sector_advance(struct nvs_fs *fs, uint32_t *addr)
 	}
 }
 
+/* find the latest valid ate of an entry, skipping the chunks of large
+ * entries. addr is set to the address of the ate.
+ * returns 0 if found, -ENOENT if not found, errcode on error
+ */
+static int nvs_latest_ate(struct nvs_fs *fs, uint16_t id, uint32_t *addr,
+			  struct nvs_ate *ate)
+{
+	int rc;
+	uint32_t wlk_addr;
+
+	wlk_addr = fs->ate_wra;
+	do {
+		*addr = wlk_addr;
+		rc = nvs_prev_ate(fs, &wlk_addr, ate);
+		if (rc) {
+			return rc;
+		}
+		if ((ate->id == id) && !nvs_ate_is_chunk(ate) &&
+		    nvs_ate_valid(fs, ate)) {
+			return 0;
+		}
+	} while (wlk_addr != fs->ate_wra);
+
+	return -ENOENT;
+}
+
+/* read the manifest of a large entry, from its ate at addr */
+static int nvs_large_rd(struct nvs_fs *fs, uint32_t addr,
+			const struct nvs_ate *ate, struct nvs_large *large)
+{
+	if (ate->len != sizeof(*large)) {
+		return -EIO;
+	}
+
+	addr &= ADDR_SECT_MASK;
+	addr += ate->offset;
+
+	return nvs_flash_rd(fs, addr, large, sizeof(*large));
+}
+
+/* read the chunk header of a chunk, from its ate at addr */
+static int nvs_chunk_hdr_rd(struct nvs_fs *fs, uint32_t addr,
+			    const struct nvs_ate *ate, struct nvs_chunk_hdr *hdr)
+{
+	if (ate->len < sizeof(*hdr)) {
+		return -EIO;
+	}
+
+	addr &= ADDR_SECT_MASK;
+	addr += ate->offset;
+
+	return nvs_flash_rd(fs, addr, hdr, sizeof(*hdr));
+}
+
+/* a chunk at addr is live if it is the latest copy of a chunk of the latest
+ * manifest of its entry, or of the large entry being written.
+ * returns 1 if live, 0 if not, errcode on error
+ */
+static int nvs_chunk_live(struct nvs_fs *fs, uint32_t addr,
+			  const struct nvs_ate *chunk)
+{
+	int rc;
+	uint32_t wlk_addr, ate_addr;
+	struct nvs_ate ate;
+	struct nvs_large large;
+	struct nvs_chunk_hdr hdr, wlk_hdr;
+
+	rc = nvs_chunk_hdr_rd(fs, addr, chunk, &hdr);
+	if (rc) {
+		return (rc == -EIO) ? 0 : rc;
+	}
+
+	if (!fs->large_wr.active || (fs->large_wr.id != chunk->id) ||
+	    (fs->large_wr.gen != hdr.gen)) {
+		rc = nvs_latest_ate(fs, chunk->id, &ate_addr, &ate);
+		if (rc) {
+			return (rc == -ENOENT) ? 0 : rc;
+		}
+
+		if (ate.part != NVS_PART_LARGE) {
+			return 0;
+		}
+
+		rc = nvs_large_rd(fs, ate_addr, &ate, &large);
+		if (rc) {
+			return (rc == -EIO) ? 0 : rc;
+		}
+
+		if ((large.gen != hdr.gen) || (chunk->part >= large.count)) {
+			return 0;
+		}
+	}
+
+	wlk_addr = fs->ate_wra;
+	do {
+		ate_addr = wlk_addr;
+		rc = nvs_prev_ate(fs, &wlk_addr, &ate);
+		if (rc) {
+			return rc;
+		}
+
+		if ((ate.id != chunk->id) || (ate.part != chunk->part) ||
+		    !nvs_ate_valid(fs, &ate) ||
+		    nvs_chunk_hdr_rd(fs, ate_addr, &ate, &wlk_hdr)) {
+			continue;
+		}
+
+		if (wlk_hdr.gen == hdr.gen) {
+			return (ate_addr == addr) ? 1 : 0;
+		}
+	} while (wlk_addr != fs->ate_wra);
+
+	return 0;
+}
+
+/* read the chunks of a large entry to a span of its data, or compare them
+ * to it. returns 0 if read or equal, 1 if not equal, errcode on error
+ */
+static int nvs_large_walk(struct nvs_fs *fs, uint16_t id,
+			  const struct nvs_large *large,
+			  const struct nvs_span *span, bool cmp)
+{
+	int rc;
+	uint32_t found[ceiling_fraction(NVS_LARGE_MAX_CHUNKS, 32)] = { 0 };
+	uint32_t wlk_addr, rd_addr;
+	struct nvs_ate wlk_ate;
+	struct nvs_chunk_hdr hdr;
+	struct nvs_span chunk;
+	size_t total = 0U, chunk_len;
+
+	wlk_addr = fs->ate_wra;
+	do {
+		rd_addr = wlk_addr;
+		rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
+		if (rc) {
+			return rc;
+		}
+
+		/* only the latest copy of each chunk counts */
+		if ((wlk_ate.id != id) || (wlk_ate.part >= large->count) ||
+		    (found[wlk_ate.part / 32U] & BIT(wlk_ate.part % 32U)) ||
+		    !nvs_ate_valid(fs, &wlk_ate) ||
+		    nvs_chunk_hdr_rd(fs, rd_addr, &wlk_ate, &hdr) ||
+		    (hdr.gen != large->gen)) {
+			continue;
+		}
+
+		found[wlk_ate.part / 32U] |= BIT(wlk_ate.part % 32U);
+		chunk_len = wlk_ate.len - sizeof(hdr);
+		total += chunk_len;
+
+		if (hdr.offset >= span->len) {
+			continue;
+		}
+
+		rd_addr &= ADDR_SECT_MASK;
+		rd_addr += wlk_ate.offset + sizeof(hdr);
+		chunk = nvs_span_sub(span, hdr.offset, chunk_len);
+
+		if (cmp) {
+			rc = nvs_flash_span_cmp(fs, rd_addr, chunk);
+		} else {
+			rc = nvs_flash_span_rd(fs, rd_addr, chunk);
+		}
+		if (rc) {
+			return rc;
+		}
+	} while (wlk_addr != fs->ate_wra);
+
+	if (total != large->len) {
+		LOG_ERR("Missing chunks of large entry %d", id);
+		return -ENOENT;
+	}
+
+	return 0;
+}
+
 /* allocation entry close (this closes the current sector) by writing offset
  * of last ate to the sector end.
  */
@@ -548,6 +907,7 @@ static int nvs_sector_close(struct nvs_fs *fs)
 	close_ate.id = 0xFFFF;
 	close_ate.len = 0U;
 	close_ate.offset = (uint16_t)((fs->ate_wra + ate_size) & ADDR_OFFS_MASK);
+	close_ate.part = NVS_PART_NONE;
 
 	fs->ate_wra &= ADDR_SECT_MASK;
 	fs->ate_wra += (fs->sector_size - ate_size);
@@ -571,11 +931,31 @@ static int nvs_add_gc_done_ate(struct nvs_fs *fs)
 	gc_done_ate.id = 0xffff;
 	gc_done_ate.len = 0U;
 	gc_done_ate.offset = (uint16_t)(fs->data_wra & ADDR_OFFS_MASK);
+	gc_done_ate.part = NVS_PART_NONE;
 	nvs_ate_crc8_update(&gc_done_ate);
 
 	return nvs_flash_ate_wrt(fs, &gc_done_ate);
 }
 
+#if CONFIG_NVS_BACKGROUND_GC
+/* Writes are serialized with the background gc by nvs_lock, a priority
+ * inversion is bounded by the mutex priority inheritance.
+ */
+static K_THREAD_STACK_DEFINE(nvs_gc_stack, CONFIG_NVS_BACKGROUND_GC_STACK_SIZE);
+static struct k_work_q nvs_gc_work_q;
+
+static size_t nvs_gc_threshold(struct nvs_fs *fs)
+{
+	return (size_t)fs->sector_size * CONFIG_NVS_BACKGROUND_GC_THRESHOLD / 100;
+}
+
+static bool nvs_gc_needed(struct nvs_fs *fs)
+{
+	return fs->gc_ahead &&
+	       ((fs->ate_wra - fs->data_wra) < nvs_gc_threshold(fs));
+}
+#endif
+
 /* garbage collection: the address ate_wra has been updated to the new sector
  * that has just been started. The data to gc is in the sector after this new
  * sector.
@@ -584,9 +964,12 @@ static int nvs_gc(struct nvs_fs *fs)
 {
 	int rc;
 	struct nvs_ate close_ate, gc_ate, wlk_ate;
-	uint32_t sec_addr, gc_addr, gc_prev_addr, wlk_addr, wlk_prev_addr,
-	      data_addr, stop_addr;
+	uint32_t sec_addr, gc_addr, gc_prev_addr, wlk_addr, data_addr, stop_addr;
 	size_t ate_size;
+	bool copy;
+#if CONFIG_NVS_STATS
+	uint32_t start = k_cycle_get_32();
+#endif
 
 	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
 
@@ -629,28 +1012,27 @@ static int nvs_gc(struct nvs_fs *fs)
 			continue;
 		}
 
-		wlk_addr = fs->ate_wra;
-		do {
-			wlk_prev_addr = wlk_addr;
-			rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
-			if (rc) {
+		if (nvs_ate_is_chunk(&gc_ate)) {
+			rc = nvs_chunk_live(fs, gc_prev_addr, &gc_ate);
+			if (rc < 0) {
 				return rc;
 			}
-			/* if ate with same id is reached we might need to copy.
-			 * only consider valid wlk_ate's. Something wrong might
-			 * have been written that has the same ate but is
-			 * invalid, don't consider these as a match.
+			copy = (rc == 1);
+		} else {
+			/* if the latest valid ate with same id is reached copy
+			 * is needed unless it is a deleted item. Something
+			 * wrong might have been written that has the same ate
+			 * but is invalid, don't consider these as a match.
 			 */
-			if ((wlk_ate.id == gc_ate.id) &&
-			    (nvs_ate_valid(fs, &wlk_ate))) {
-				break;
+			rc = nvs_latest_ate(fs, gc_ate.id, &wlk_addr, &wlk_ate);
+			if ((rc < 0) && (rc != -ENOENT)) {
+				return rc;
 			}
-		} while (wlk_addr != fs->ate_wra);
+			copy = (rc == 0) && (wlk_addr == gc_prev_addr) &&
+			       gc_ate.len;
+		}
 
-		/* if walk has reached the same address as gc_addr copy is
-		 * needed unless it is a deleted item.
-		 */
-		if ((wlk_prev_addr == gc_prev_addr) && gc_ate.len) {
+		if (copy) {
 			/* copy needed */
 			LOG_DBG("Moving %d, len %d", gc_ate.id, gc_ate.len);
 
@@ -669,6 +1051,10 @@ static int nvs_gc(struct nvs_fs *fs)
 			if (rc) {
 				return rc;
 			}
+
+#if CONFIG_NVS_STATS
+			fs->stats.gc_bytes_moved += gc_ate.len;
+#endif
 		}
 	} while (gc_prev_addr != stop_addr);
 
@@ -692,63 +1078,258 @@ gc_done:
 	if (rc) {
 		return rc;
 	}
+
+#if CONFIG_NVS_BACKGROUND_GC
+	/* Collecting ahead is pointless when the collected sectors hold
+	 * so much data that little space is left for writes: it would only
+	 * close sectors early, the writes then wait for a collection.
+	 */
+	fs->gc_ahead = (fs->ate_wra - fs->data_wra) >= nvs_gc_threshold(fs);
+#endif
+
+#if CONFIG_NVS_STATS
+	fs->stats.gc_count++;
+	fs->stats.gc_max_us = MAX(fs->stats.gc_max_us, nvs_us_since(start));
+#endif
+
 	return 0;
 }
 
-static int nvs_startup(struct nvs_fs *fs)
+#if CONFIG_NVS_BACKGROUND_GC
+static void nvs_gc_work_handler(struct k_work *work)
 {
+	struct nvs_fs *fs = CONTAINER_OF(work, struct nvs_fs, gc_work);
 	int rc;
-	struct nvs_ate last_ate;
-	size_t ate_size, empty_len;
-	/* Initialize addr to 0 for the case fs->sector_count == 0. This
-	 * should never happen as this is verified in nvs_mount() but both
-	 * Coverity and GCC believe the contrary.
-	 */
-	uint32_t addr = 0U;
-	uint16_t i, closed_sectors = 0;
-	uint8_t erase_value = fs->flash_parameters->erase_value;
 
 	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
 
-	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
-	/* step through the sectors to find a open sector following
-	 * a closed sector, this is where NVS can write.
-	 */
-	for (i = 0; i < fs->sector_count; i++) {
-		addr = (i << ADDR_SECT_SHIFT) +
-		       (uint16_t)(fs->sector_size - ate_size);
-		rc = nvs_flash_cmp_const(fs, addr, erase_value,
-					 sizeof(struct nvs_ate));
-		if (rc) {
-			/* closed sector */
-			closed_sectors++;
-			nvs_sector_advance(fs, &addr);
-			rc = nvs_flash_cmp_const(fs, addr, erase_value,
-						 sizeof(struct nvs_ate));
-			if (!rc) {
-				/* open sector */
-				break;
-			}
-		}
-	}
-	/* all sectors are closed, this is not a nvs fs */
-	if (closed_sectors == fs->sector_count) {
-		rc = -EDEADLK;
+	/* Writes may have been garbage collecting since the submission */
+	if (!fs->ready || !nvs_gc_needed(fs)) {
 		goto end;
 	}
 
-	if (i == fs->sector_count) {
-		/* none of the sectors where closed, in most cases we can set
-		 * the address to the first sector, except when there are only
-		 * two sectors. Then we can only set it to the first sector if
-		 * the last sector contains no ate's. So we check this first
-		 */
-		rc = nvs_flash_cmp_const(fs, addr - ate_size, erase_value,
-				sizeof(struct nvs_ate));
-		if (!rc) {
-			/* empty ate */
-			nvs_sector_advance(fs, &addr);
-		}
+	LOG_DBG("Background gc of sector %d", (fs->ate_wra >> ADDR_SECT_SHIFT));
+
+	rc = nvs_sector_close(fs);
+	if (rc == 0) {
+		rc = nvs_gc(fs);
+	}
+
+	if (rc) {
+		LOG_ERR("Background gc failed: %d", rc);
+		goto end;
+	}
+
+#if CONFIG_NVS_STATS
+	fs->stats.gc_background++;
+#endif
+
+end:
+	k_mutex_unlock(&fs->nvs_lock);
+}
+
+static void nvs_gc_work_cancel(struct nvs_fs *fs)
+{
+	struct k_work_sync sync;
+
+	/* The work is only initialized once the file system was mounted */
+	if (fs->gc_work_init) {
+		(void)k_work_cancel_sync(&fs->gc_work, &sync);
+	}
+}
+
+static int nvs_gc_work_q_init(const struct device *dev)
+{
+	const struct k_work_queue_config cfg = {
+		.name = "nvs_gc",
+	};
+
+	ARG_UNUSED(dev);
+
+	k_work_queue_start(&nvs_gc_work_q, nvs_gc_stack,
+			   K_THREAD_STACK_SIZEOF(nvs_gc_stack),
+			   K_LOWEST_APPLICATION_THREAD_PRIO, &cfg);
+
+	return 0;
+}
+
+SYS_INIT(nvs_gc_work_q_init, POST_KERNEL, CONFIG_APPLICATION_INIT_PRIORITY);
+#endif /* CONFIG_NVS_BACKGROUND_GC */
+
+/* garbage collect until the current sector has room for an entry of len
+ * bytes, 0 for a delete entry.
+ */
+static int nvs_room_make(struct nvs_fs *fs, size_t len)
+{
+	int rc, gc_count;
+	size_t ate_size, required_space = 0U;
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+
+	/* calculate required space if the entry contains data */
+	if (len) {
+		/* Leave space for delete ate */
+		required_space = nvs_al_size(fs, len) + ate_size;
+	}
+
+	gc_count = 0;
+	while (1) {
+		if (gc_count == fs->sector_count) {
+			/* gc'ed all sectors, no extra space will be created
+			 * by extra gc.
+			 */
+			return -ENOSPC;
+		}
+
+		if (fs->ate_wra >= (fs->data_wra + required_space)) {
+			return 0;
+		}
+
+		rc = nvs_sector_close(fs);
+		if (rc) {
+			return rc;
+		}
+
+		rc = nvs_gc(fs);
+		if (rc) {
+			return rc;
+		}
+		gc_count++;
+	}
+}
+
+/* write a large entry as chunks filling the sectors, followed by its
+ * manifest. The chunks are kept by the garbage collection while written.
+ */
+static int nvs_large_wrt(struct nvs_fs *fs, uint16_t id,
+			 const struct nvs_span *span)
+{
+	int rc;
+	uint32_t addr;
+	struct nvs_ate ate;
+	struct nvs_large large = { 0 };
+	struct nvs_chunk_hdr hdr = { .reserved = 0xff };
+	struct nvs_iovec large_iov = { .data = &large, .len = sizeof(large) };
+	struct nvs_span chunk, manifest = {
+		.iov = &large_iov, .iovcnt = 1, .len = sizeof(large)
+	};
+	size_t ate_size, room, min_len, offset = 0U;
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+
+	/* A generation other than the one of the latest manifest, so that
+	 * the chunks of an interrupted write are not taken for its own.
+	 */
+	rc = nvs_latest_ate(fs, id, &addr, &ate);
+	if ((rc == 0) && (ate.part == NVS_PART_LARGE) &&
+	    (nvs_large_rd(fs, addr, &ate, &large) == 0)) {
+		large.gen++;
+	} else if ((rc < 0) && (rc != -ENOENT)) {
+		return rc;
+	}
+	large.len = span->len;
+	large.count = 0U;
+	hdr.gen = large.gen;
+
+	fs->large_wr.id = id;
+	fs->large_wr.gen = large.gen;
+	fs->large_wr.active = true;
+
+	while (offset < span->len) {
+		if (large.count == NVS_LARGE_MAX_CHUNKS) {
+			rc = -ENOSPC;
+			goto end;
+		}
+
+		/* fill the current sector, unless only a small chunk fits */
+		min_len = MIN(span->len - offset, fs->sector_size / 4U);
+		rc = nvs_room_make(fs, sizeof(hdr) + min_len);
+		if (rc) {
+			goto end;
+		}
+
+		room = fs->ate_wra - fs->data_wra - ate_size;
+		room &= ~(fs->flash_parameters->write_block_size - 1U);
+
+		hdr.offset = (uint16_t)offset;
+		chunk = nvs_span_sub(span, offset, room - sizeof(hdr));
+
+		rc = nvs_flash_wrt_entry(fs, id, large.count, &hdr, sizeof(hdr),
+					 &chunk);
+		if (rc) {
+			goto end;
+		}
+
+		offset += chunk.len;
+		large.count++;
+	}
+
+	rc = nvs_room_make(fs, sizeof(large));
+	if (rc) {
+		goto end;
+	}
+
+	rc = nvs_flash_wrt_entry(fs, id, NVS_PART_LARGE, NULL, 0, &manifest);
+
+end:
+	fs->large_wr.active = false;
+	return rc;
+}
+
+static int nvs_startup(struct nvs_fs *fs)
+{
+	int rc;
+	struct nvs_ate last_ate;
+	size_t ate_size, empty_len;
+	/* Initialize addr to 0 for the case fs->sector_count == 0. This
+	 * should never happen as this is verified in nvs_mount() but both
+	 * Coverity and GCC believe the contrary.
+	 */
+	uint32_t addr = 0U;
+	uint16_t i, closed_sectors = 0;
+	uint8_t erase_value = fs->flash_parameters->erase_value;
+
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+	/* step through the sectors to find a open sector following
+	 * a closed sector, this is where NVS can write.
+	 */
+	for (i = 0; i < fs->sector_count; i++) {
+		addr = (i << ADDR_SECT_SHIFT) +
+		       (uint16_t)(fs->sector_size - ate_size);
+		rc = nvs_flash_cmp_const(fs, addr, erase_value,
+					 sizeof(struct nvs_ate));
+		if (rc) {
+			/* closed sector */
+			closed_sectors++;
+			nvs_sector_advance(fs, &addr);
+			rc = nvs_flash_cmp_const(fs, addr, erase_value,
+						 sizeof(struct nvs_ate));
+			if (!rc) {
+				/* open sector */
+				break;
+			}
+		}
+	}
+	/* all sectors are closed, this is not a nvs fs */
+	if (closed_sectors == fs->sector_count) {
+		rc = -EDEADLK;
+		goto end;
+	}
+
+	if (i == fs->sector_count) {
+		/* none of the sectors where closed, in most cases we can set
+		 * the address to the first sector, except when there are only
+		 * two sectors. Then we can only set it to the first sector if
+		 * the last sector contains no ate's. So we check this first
+		 */
+		rc = nvs_flash_cmp_const(fs, addr - ate_size, erase_value,
+				sizeof(struct nvs_ate));
+		if (!rc) {
+			/* empty ate */
+			nvs_sector_advance(fs, &addr);
+		}
 	}
 
 	/* addr contains address of closing ate in the most recent sector,
@@ -914,6 +1495,10 @@ int nvs_clear(struct nvs_fs *fs)
 		return -EACCES;
 	}
 
+#if CONFIG_NVS_BACKGROUND_GC
+	nvs_gc_work_cancel(fs);
+#endif
+
 	for (uint16_t i = 0; i < fs->sector_count; i++) {
 		addr = i << ADDR_SECT_SHIFT;
 		rc = nvs_flash_erase_sector(fs, addr);
@@ -935,6 +1520,17 @@ int nvs_mount(struct nvs_fs *fs)
 	struct flash_pages_info info;
 	size_t write_block_size;
 
+#if CONFIG_NVS_BACKGROUND_GC
+	nvs_gc_work_cancel(fs);
+	k_work_init(&fs->gc_work, nvs_gc_work_handler);
+	fs->gc_work_init = true;
+	fs->gc_ahead = true;
+#endif
+
+#if CONFIG_NVS_STATS
+	(void)memset(&fs->stats, 0, sizeof(fs->stats));
+#endif
+
 	k_mutex_init(&fs->nvs_lock);
 
 	fs->flash_parameters = flash_get_parameters(fs->flash_device);
@@ -987,14 +1583,19 @@ int nvs_mount(struct nvs_fs *fs)
 	return 0;
 }
 
-ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
+ssize_t nvs_writev(struct nvs_fs *fs, uint16_t id, const struct nvs_iovec *iov,
+		   size_t iovcnt)
 {
-	int rc, gc_count;
-	size_t ate_size, data_size;
+	int rc;
+	size_t ate_size, len = 0U;
 	struct nvs_ate wlk_ate;
-	uint32_t wlk_addr, rd_addr;
-	uint16_t required_space = 0U; /* no space, appropriate for delete ate */
-	bool prev_found = false;
+	struct nvs_large large;
+	struct nvs_span span;
+	uint32_t rd_addr;
+	bool prev_found;
+#if CONFIG_NVS_STATS
+	uint32_t start = k_cycle_get_32();
+#endif
 
 	if (!fs->ready) {
 		LOG_ERR("NVS not initialized");
@@ -1002,37 +1603,47 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 	}
 
 	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
-	data_size = nvs_al_size(fs, len);
 
-	/* The maximum data size is sector size - 4 ate
-	 * where: 1 ate for data, 1 ate for sector close, 1 ate for gc done,
-	 * and 1 ate to always allow a delete.
+	for (size_t i = 0; i < iovcnt; i++) {
+		if ((iov[i].len > 0) && (iov[i].data == NULL)) {
+			return -EINVAL;
+		}
+		len += iov[i].len;
+	}
+
+	/* Entries larger than sector size - 4 ate, where: 1 ate for data,
+	 * 1 ate for sector close, 1 ate for gc done, and 1 ate to always
+	 * allow a delete, are written as a large entry.
 	 */
-	if ((len > (fs->sector_size - 4 * ate_size)) ||
-	    ((len > 0) && (data == NULL))) {
+	if (len > UINT16_MAX) {
 		return -EINVAL;
 	}
 
+	span.iov = iov;
+	span.iovcnt = iovcnt;
+	span.skip = 0U;
+	span.len = len;
+
 	/* find latest entry with same id */
-	wlk_addr = fs->ate_wra;
-	rd_addr = wlk_addr;
+	rc = nvs_latest_ate(fs, id, &rd_addr, &wlk_ate);
+	if ((rc < 0) && (rc != -ENOENT)) {
+		return rc;
+	}
+	prev_found = (rc == 0);
 
-	while (1) {
-		rd_addr = wlk_addr;
-		rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
-		if (rc) {
-			return rc;
-		}
-		if ((wlk_ate.id == id) && (nvs_ate_valid(fs, &wlk_ate))) {
-			prev_found = true;
-			break;
+	if (prev_found && (wlk_ate.part == NVS_PART_LARGE)) {
+		/* compare with the chunks of the previous large entry */
+		rc = nvs_large_rd(fs, rd_addr, &wlk_ate, &large);
+		if ((rc == 0) && (len == large.len)) {
+			rc = nvs_large_walk(fs, id, &large, &span, true);
+			if (rc == 0) {
+				return 0;
+			}
 		}
-		if (wlk_addr == fs->ate_wra) {
-			break;
+		if ((rc < 0) && (rc != -EIO) && (rc != -ENOENT)) {
+			return rc;
 		}
-	}
-
-	if (prev_found) {
+	} else if (prev_found) {
 		/* previous entry found */
 		rd_addr &= ADDR_SECT_MASK;
 		rd_addr += wlk_ate.offset;
@@ -1048,7 +1659,7 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 		} else if (len == wlk_ate.len) {
 			/* do not try to compare if lengths are not equal */
 			/* compare the data and if equal return 0 */
-			rc = nvs_flash_block_cmp(fs, rd_addr, data, len);
+			rc = nvs_flash_span_cmp(fs, rd_addr, span);
 			if (rc <= 0) {
 				return rc;
 			}
@@ -1060,76 +1671,63 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 		}
 	}
 
-	/* calculate required space if the entry contains data */
-	if (data_size) {
-		/* Leave space for delete ate */
-		required_space = data_size + ate_size;
-	}
-
 	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
 
-	gc_count = 0;
-	while (1) {
-		if (gc_count == fs->sector_count) {
-			/* gc'ed all sectors, no extra space will be created
-			 * by extra gc.
-			 */
-			rc = -ENOSPC;
-			goto end;
-		}
-
-		if (fs->ate_wra >= (fs->data_wra + required_space)) {
-
-			rc = nvs_flash_wrt_entry(fs, id, data, len);
-			if (rc) {
-				goto end;
-			}
-			break;
-		}
-
-
-		rc = nvs_sector_close(fs);
-		if (rc) {
-			goto end;
-		}
-
-		rc = nvs_gc(fs);
-		if (rc) {
-			goto end;
+	if (len > (fs->sector_size - 4 * ate_size)) {
+		rc = nvs_large_wrt(fs, id, &span);
+	} else {
+		rc = nvs_room_make(fs, len);
+		if (rc == 0) {
+			rc = nvs_flash_wrt_entry(fs, id, NVS_PART_NONE, NULL, 0,
+						 &span);
 		}
-		gc_count++;
+	}
+	if (rc) {
+		goto end;
 	}
 	rc = len;
+
+#if CONFIG_NVS_BACKGROUND_GC
+	if (nvs_gc_needed(fs)) {
+		(void)k_work_submit_to_queue(&nvs_gc_work_q, &fs->gc_work);
+	}
+#endif
+
+#if CONFIG_NVS_STATS
+	fs->stats.write_count++;
+	fs->stats.write_max_us = MAX(fs->stats.write_max_us, nvs_us_since(start));
+#endif
 end:
 	k_mutex_unlock(&fs->nvs_lock);
 	return rc;
 }
 
+ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
+{
+	const struct nvs_iovec iov = { .data = (void *)data, .len = len };
+
+	return nvs_writev(fs, id, &iov, 1);
+}
+
 int nvs_delete(struct nvs_fs *fs, uint16_t id)
 {
 	return nvs_write(fs, id, NULL, 0);
 }
 
-ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len,
-		      uint16_t cnt)
+static ssize_t nvs_read_span(struct nvs_fs *fs, uint16_t id,
+			     const struct nvs_span *span, uint16_t cnt)
 {
 	int rc;
 	uint32_t wlk_addr, rd_addr;
 	uint16_t cnt_his;
 	struct nvs_ate wlk_ate;
-	size_t ate_size;
+	struct nvs_large large;
 
 	if (!fs->ready) {
 		LOG_ERR("NVS not initialized");
 		return -EACCES;
 	}
 
-	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
-
-	if (len > (fs->sector_size - 2 * ate_size)) {
-		return -EINVAL;
-	}
-
 	cnt_his = 0U;
 
 #ifdef CONFIG_NVS_LOOKUP_CACHE
@@ -1150,7 +1748,8 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len,
 		if (rc) {
 			goto err;
 		}
-		if ((wlk_ate.id == id) &&  (nvs_ate_valid(fs, &wlk_ate))) {
+		if ((wlk_ate.id == id) && !nvs_ate_is_chunk(&wlk_ate) &&
+		    (nvs_ate_valid(fs, &wlk_ate))) {
 			cnt_his++;
 		}
 		if (wlk_addr == fs->ate_wra) {
@@ -1159,13 +1758,27 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len,
 	}
 
 	if (((wlk_addr == fs->ate_wra) && (wlk_ate.id != id)) ||
-	    (wlk_ate.len == 0U) || (cnt_his < cnt)) {
+	    nvs_ate_is_chunk(&wlk_ate) || (wlk_ate.len == 0U) ||
+	    (cnt_his < cnt)) {
 		return -ENOENT;
 	}
 
+	if (wlk_ate.part == NVS_PART_LARGE) {
+		/* the chunks of older entries may have been gc'ed */
+		rc = nvs_large_rd(fs, rd_addr, &wlk_ate, &large);
+		if (rc == 0) {
+			rc = nvs_large_walk(fs, id, &large, span, false);
+		}
+		if (rc) {
+			goto err;
+		}
+
+		return large.len;
+	}
+
 	rd_addr &= ADDR_SECT_MASK;
 	rd_addr += wlk_ate.offset;
-	rc = nvs_flash_rd(fs, rd_addr, data, MIN(len, wlk_ate.len));
+	rc = nvs_flash_span_rd(fs, rd_addr, nvs_span_sub(span, 0, wlk_ate.len));
 	if (rc) {
 		goto err;
 	}
@@ -1176,6 +1789,15 @@ err:
 	return rc;
 }
 
+ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len,
+		      uint16_t cnt)
+{
+	const struct nvs_iovec iov = { .data = data, .len = len };
+	const struct nvs_span span = { .iov = &iov, .iovcnt = 1, .len = len };
+
+	return nvs_read_span(fs, id, &span, cnt);
+}
+
 ssize_t nvs_read(struct nvs_fs *fs, uint16_t id, void *data, size_t len)
 {
 	int rc;
@@ -1184,12 +1806,159 @@ ssize_t nvs_read(struct nvs_fs *fs, uint16_t id, void *data, size_t len)
 	return rc;
 }
 
+ssize_t nvs_readv(struct nvs_fs *fs, uint16_t id, const struct nvs_iovec *iov,
+		  size_t iovcnt)
+{
+	struct nvs_span span = { .iov = iov, .iovcnt = iovcnt };
+
+	for (size_t i = 0; i < iovcnt; i++) {
+		span.len += iov[i].len;
+	}
+
+	return nvs_read_span(fs, id, &span, 0);
+}
+
+/* Return the range containing id, if its latest entry was not seen yet */
+static const struct nvs_id_range *nvs_range_unseen(const struct nvs_id_range *ranges,
+						   size_t num_ranges, uint16_t id)
+{
+	for (size_t i = 0; i < num_ranges; i++) {
+		uint16_t bit = id - ranges[i].first;
+
+		if ((id < ranges[i].first) || (bit >= ranges[i].count)) {
+			continue;
+		}
+
+		if (ranges[i].seen[bit / 32U] & BIT(bit % 32U)) {
+			return NULL;
+		}
+
+		ranges[i].seen[bit / 32U] |= BIT(bit % 32U);
+		return &ranges[i];
+	}
+
+	return NULL;
+}
+
+int nvs_foreach(struct nvs_fs *fs, const struct nvs_id_range *ranges,
+		size_t num_ranges, nvs_foreach_cb_t cb, void *user_data)
+{
+	int rc;
+	uint32_t wlk_addr, rd_addr;
+	struct nvs_ate wlk_ate;
+	struct nvs_entry entry;
+	struct nvs_large large;
+
+	if (!fs->ready) {
+		LOG_ERR("NVS not initialized");
+		return -EACCES;
+	}
+
+	for (size_t i = 0; i < num_ranges; i++) {
+		(void)memset(ranges[i].seen, 0,
+			     NVS_ID_RANGE_SEEN_WORDS(ranges[i].count) * sizeof(uint32_t));
+	}
+
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+
+	wlk_addr = fs->ate_wra;
+
+	while (1) {
+		rd_addr = wlk_addr;
+		rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
+		if (rc) {
+			break;
+		}
+
+		/* Only the first (latest) valid ate of an id counts, a
+		 * delete ate hides the older ones.
+		 */
+		if ((wlk_ate.id != 0xFFFF) && !nvs_ate_is_chunk(&wlk_ate) &&
+		    nvs_ate_valid(fs, &wlk_ate) &&
+		    nvs_range_unseen(ranges, num_ranges, wlk_ate.id) &&
+		    wlk_ate.len) {
+			entry.id = wlk_ate.id;
+			entry.len = wlk_ate.len;
+			entry.data_addr = (rd_addr & ADDR_SECT_MASK) + wlk_ate.offset;
+			entry.ate_wra = fs->ate_wra;
+			entry.large = (wlk_ate.part == NVS_PART_LARGE);
+
+			if (entry.large) {
+				rc = nvs_large_rd(fs, rd_addr, &wlk_ate, &large);
+				if (rc) {
+					break;
+				}
+				entry.len = large.len;
+			}
+
+			rc = cb(fs, &entry, user_data);
+			if (rc) {
+				break;
+			}
+		}
+
+		if (wlk_addr == fs->ate_wra) {
+			break;
+		}
+	}
+
+	k_mutex_unlock(&fs->nvs_lock);
+	return rc;
+}
+
+ssize_t nvs_entry_read(struct nvs_fs *fs, const struct nvs_entry *entry,
+		       void *data, size_t len)
+{
+	int rc;
+
+	if (!fs->ready) {
+		LOG_ERR("NVS not initialized");
+		return -EACCES;
+	}
+
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+
+	/* A garbage collection may have moved the data, the chunks of a
+	 * large entry are searched anyway.
+	 */
+	if (entry->large || (entry->ate_wra != fs->ate_wra)) {
+		k_mutex_unlock(&fs->nvs_lock);
+		return nvs_read(fs, entry->id, data, len);
+	}
+
+	rc = nvs_flash_rd(fs, entry->data_addr, data, MIN(len, entry->len));
+
+	k_mutex_unlock(&fs->nvs_lock);
+
+	if (rc) {
+		return rc;
+	}
+
+	return entry->len;
+}
+
+#if CONFIG_NVS_STATS
+void nvs_stats_get(struct nvs_fs *fs, struct nvs_stats *stats)
+{
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+	*stats = fs->stats;
+	k_mutex_unlock(&fs->nvs_lock);
+}
+
+void nvs_stats_reset(struct nvs_fs *fs)
+{
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+	(void)memset(&fs->stats, 0, sizeof(fs->stats));
+	k_mutex_unlock(&fs->nvs_lock);
+}
+#endif
+
 ssize_t nvs_calc_free_space(struct nvs_fs *fs)
 {
 
 	int rc;
 	struct nvs_ate step_ate, wlk_ate;
-	uint32_t step_addr, wlk_addr;
+	uint32_t step_addr, step_prev_addr, wlk_addr;
 	size_t ate_size, free_space;
 
 	if (!fs->ready) {
@@ -1207,11 +1976,28 @@ ssize_t nvs_calc_free_space(struct nvs_fs *fs)
 	step_addr = fs->ate_wra;
 
 	while (1) {
+		step_prev_addr = step_addr;
 		rc = nvs_prev_ate(fs, &step_addr, &step_ate);
 		if (rc) {
 			return rc;
 		}
 
+		if (nvs_ate_is_chunk(&step_ate)) {
+			rc = nvs_ate_valid(fs, &step_ate) ?
+			     nvs_chunk_live(fs, step_prev_addr, &step_ate) : 0;
+			if (rc < 0) {
+				return rc;
+			}
+			if (rc) {
+				free_space -= nvs_al_size(fs, step_ate.len);
+				free_space -= ate_size;
+			}
+			if (step_addr == fs->ate_wra) {
+				break;
+			}
+			continue;
+		}
+
 		wlk_addr = fs->ate_wra;
 
 		while (1) {
@@ -1219,7 +2005,8 @@ ssize_t nvs_calc_free_space(struct nvs_fs *fs)
 			if (rc) {
 				return rc;
 			}
-			if ((wlk_ate.id == step_ate.id) ||
+			if (((wlk_ate.id == step_ate.id) &&
+			     !nvs_ate_is_chunk(&wlk_ate)) ||
 			    (wlk_addr == fs->ate_wra)) {
 				break;
 			}
@@ -26,7 +26,10 @@ extern "C" {
  */
 #define NVS_STATUS_NOSPACE 1
 
-#define NVS_BLOCK_SIZE 32
+#define NVS_BLOCK_SIZE CONFIG_NVS_WRITE_BUFFER_SIZE
+
+BUILD_ASSERT((NVS_BLOCK_SIZE & (NVS_BLOCK_SIZE - 1)) == 0,
+	     "NVS write buffer size must be a power of 2");
 
 #define NVS_LOOKUP_CACHE_NO_ADDR 0xFFFFFFFF
 
@@ -43,6 +46,33 @@ BUILD_ASSERT(offsetof(struct nvs_ate, crc8) ==
 		 sizeof(struct nvs_ate) - sizeof(uint8_t),
 		 "crc8 must be the last member");
 
+/*
+ * LARGE ENTRIES
+ * An entry too large for a sector is stored as chunks followed by a
+ * manifest. The ate of the manifest has the id of the entry and the part
+ * NVS_PART_LARGE. The ates of the chunks have the id of the entry and the
+ * index of the chunk as part, their data starts with a chunk header. Only
+ * the latest copy of the chunks with the generation of the latest manifest
+ * belong to the entry, older chunks are left to the garbage collection.
+ */
+#define NVS_PART_NONE 0xFF
+#define NVS_PART_LARGE 0xFE
+#define NVS_LARGE_MAX_CHUNKS NVS_PART_LARGE
+
+/* Data of the manifest */
+struct nvs_large {
+	uint8_t gen;	/* generation of the chunks */
+	uint8_t count;	/* number of chunks */
+	uint16_t len;	/* length of the entry */
+} __packed;
+
+/* Header of the data of a chunk */
+struct nvs_chunk_hdr {
+	uint8_t gen;	/* generation, as the manifest */
+	uint8_t reserved;
+	uint16_t offset;	/* offset of the chunk in the entry */
+} __packed;
+
 #ifdef __cplusplus
 }
 #endif
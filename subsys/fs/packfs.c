@@ -0,0 +1,506 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <errno.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/fs/fs.h>
+#include <zephyr/fs/fs_sys.h>
+#include <zephyr/fs/packfs.h>
+#include <zephyr/sys/byteorder.h>
+#include "fs_impl.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(packfs, CONFIG_FS_LOG_LEVEL);
+
+struct packfs_file {
+	const uint8_t *data;
+	size_t size;
+	size_t pos;
+};
+
+struct packfs_dir {
+	const uint8_t *image;
+	/* Next entry to look at */
+	uint16_t index;
+	/* Length of the directory path followed by '/', 0 for the root */
+	uint16_t prefix_len;
+	/* Path of an entry of the directory, holding the prefix */
+	const char *prefix;
+	/* Last subdirectory listed, to list it once */
+	const char *last;
+	size_t last_len;
+};
+
+K_MEM_SLAB_DEFINE_STATIC(packfs_file_pool, sizeof(struct packfs_file),
+			 CONFIG_FS_PACKFS_NUM_FILES, 4);
+K_MEM_SLAB_DEFINE_STATIC(packfs_dir_pool, sizeof(struct packfs_dir),
+			 CONFIG_FS_PACKFS_NUM_DIRS, 4);
+
+static const uint8_t *image_get(const struct fs_mount_t *mp)
+{
+	return ((const struct fs_packfs *)mp->fs_data)->image;
+}
+
+static uint16_t entry_count(const uint8_t *image)
+{
+	return sys_le16_to_cpu(((const struct packfs_header *)image)->entry_count);
+}
+
+static const struct packfs_entry *entry_get(const uint8_t *image, int i)
+{
+	return (const struct packfs_entry *)(image +
+		sizeof(struct packfs_header)) + i;
+}
+
+static const char *entry_name(const uint8_t *image,
+			      const struct packfs_entry *e, size_t *len)
+{
+	*len = sys_le16_to_cpu(e->name_len);
+
+	return (const char *)image + sys_le32_to_cpu(e->name_off);
+}
+
+/* Compare the path of an entry with a path, followed by '/' for a
+ * directory.
+ */
+static int name_cmp(const char *name, size_t name_len, const char *path,
+		    size_t len, bool dir)
+{
+	int rc = memcmp(name, path, MIN(name_len, len));
+
+	if (rc != 0) {
+		return rc;
+	}
+
+	if (name_len < len) {
+		return -1;
+	}
+
+	if (!dir) {
+		return (name_len > len) ? 1 : 0;
+	}
+
+	if (name_len == len) {
+		return -1;
+	}
+
+	if (name[len] != '/') {
+		return (uint8_t)name[len] - '/';
+	}
+
+	return (name_len > len + 1) ? 1 : 0;
+}
+
+/* First entry not sorted before the path */
+static int lower_bound(const uint8_t *image, const char *path, size_t len,
+		       bool dir)
+{
+	int lo = 0;
+	int hi = entry_count(image);
+	const char *name;
+	size_t name_len;
+	int mid;
+
+	while (lo < hi) {
+		mid = (lo + hi) / 2;
+		name = entry_name(image, entry_get(image, mid), &name_len);
+		if (name_cmp(name, name_len, path, len, dir) < 0) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	return lo;
+}
+
+/* Path relative to the root, without leading and trailing '/' */
+static const char *path_get(const char *path, const struct fs_mount_t *mp,
+			    size_t *len)
+{
+	path = fs_impl_strip_prefix(path, mp);
+	while (*path == '/') {
+		path++;
+	}
+
+	*len = strlen(path);
+	while ((*len > 0) && (path[*len - 1] == '/')) {
+		(*len)--;
+	}
+
+	return path;
+}
+
+static const struct packfs_entry *file_find(const uint8_t *image,
+					    const char *path, size_t len)
+{
+	int i = lower_bound(image, path, len, false);
+	const char *name;
+	size_t name_len;
+
+	if (i < entry_count(image)) {
+		name = entry_name(image, entry_get(image, i), &name_len);
+		if (name_cmp(name, name_len, path, len, false) == 0) {
+			return entry_get(image, i);
+		}
+	}
+
+	return NULL;
+}
+
+/* Index of the first entry in a directory, -ENOENT if there is none */
+static int dir_find(const uint8_t *image, const char *path, size_t len)
+{
+	int i;
+	const char *name;
+	size_t name_len;
+
+	if (len == 0) {
+		return 0;
+	}
+
+	i = lower_bound(image, path, len, true);
+	if (i < entry_count(image)) {
+		name = entry_name(image, entry_get(image, i), &name_len);
+		if ((name_len > len + 1) && (name[len] == '/') &&
+		    (memcmp(name, path, len) == 0)) {
+			return i;
+		}
+	}
+
+	return -ENOENT;
+}
+
+static void dirent_name_set(struct fs_dirent *entry, const char *name,
+			    size_t len)
+{
+	len = MIN(len, MAX_FILE_NAME);
+	memcpy(entry->name, name, len);
+	entry->name[len] = '\0';
+}
+
+static int packfs_open(struct fs_file_t *zfp, const char *path,
+		       fs_mode_t flags)
+{
+	const uint8_t *image = image_get(zfp->mp);
+	const struct packfs_entry *e;
+	struct packfs_file *file;
+	size_t len;
+
+	if (flags & (FS_O_WRITE | FS_O_CREATE | FS_O_APPEND)) {
+		return -EROFS;
+	}
+
+	path = path_get(path, zfp->mp, &len);
+	e = file_find(image, path, len);
+	if (e == NULL) {
+		return (dir_find(image, path, len) >= 0) ? -EISDIR : -ENOENT;
+	}
+
+	if (k_mem_slab_alloc(&packfs_file_pool, (void **)&file, K_NO_WAIT)) {
+		return -ENOMEM;
+	}
+
+	file->data = image + sys_le32_to_cpu(e->data_off);
+	file->size = sys_le32_to_cpu(e->size);
+	file->pos = 0;
+	zfp->filep = file;
+
+	return 0;
+}
+
+static int packfs_close(struct fs_file_t *zfp)
+{
+	k_mem_slab_free(&packfs_file_pool, &zfp->filep);
+	zfp->filep = NULL;
+
+	return 0;
+}
+
+static ssize_t packfs_pread(struct fs_file_t *zfp, void *ptr, size_t size,
+			    off_t offset)
+{
+	struct packfs_file *file = zfp->filep;
+
+	if (offset >= file->size) {
+		return 0;
+	}
+
+	size = MIN(size, file->size - offset);
+	memcpy(ptr, &file->data[offset], size);
+
+	return size;
+}
+
+static ssize_t packfs_read(struct fs_file_t *zfp, void *ptr, size_t size)
+{
+	struct packfs_file *file = zfp->filep;
+	ssize_t len = packfs_pread(zfp, ptr, size, file->pos);
+
+	file->pos += len;
+
+	return len;
+}
+
+static int packfs_seek(struct fs_file_t *zfp, off_t offset, int whence)
+{
+	struct packfs_file *file = zfp->filep;
+	off_t pos;
+
+	switch (whence) {
+	case FS_SEEK_SET:
+		pos = offset;
+		break;
+	case FS_SEEK_CUR:
+		pos = file->pos + offset;
+		break;
+	case FS_SEEK_END:
+		pos = file->size + offset;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	if ((pos < 0) || (pos > file->size)) {
+		return -EINVAL;
+	}
+
+	file->pos = pos;
+
+	return 0;
+}
+
+static off_t packfs_tell(struct fs_file_t *zfp)
+{
+	struct packfs_file *file = zfp->filep;
+
+	return file->pos;
+}
+
+static int packfs_mmap(struct fs_file_t *zfp, const void **addr, size_t *size)
+{
+	struct packfs_file *file = zfp->filep;
+
+	*addr = file->data;
+	*size = file->size;
+
+	return 0;
+}
+
+static int packfs_opendir(struct fs_dir_t *zdp, const char *path)
+{
+	const uint8_t *image = image_get(zdp->mp);
+	struct packfs_dir *dir;
+	size_t len;
+	int i;
+
+	path = path_get(path, zdp->mp, &len);
+	i = dir_find(image, path, len);
+	if (i < 0) {
+		return i;
+	}
+
+	if (k_mem_slab_alloc(&packfs_dir_pool, (void **)&dir, K_NO_WAIT)) {
+		return -ENOMEM;
+	}
+
+	dir->image = image;
+	dir->index = i;
+	dir->prefix_len = (len > 0) ? len + 1 : 0;
+	dir->prefix = (i < entry_count(image)) ?
+		      entry_name(image, entry_get(image, i), &len) : NULL;
+	dir->last = NULL;
+	dir->last_len = 0;
+	zdp->dirp = dir;
+
+	return 0;
+}
+
+static int packfs_readdir(struct fs_dir_t *zdp, struct fs_dirent *entry)
+{
+	struct packfs_dir *dir = zdp->dirp;
+	const struct packfs_entry *e;
+	const char *name, *child, *slash;
+	size_t name_len, len;
+
+	for (; dir->index < entry_count(dir->image); dir->index++) {
+		e = entry_get(dir->image, dir->index);
+		name = entry_name(dir->image, e, &name_len);
+
+		if ((name_len <= dir->prefix_len) ||
+		    ((dir->prefix_len > 0) &&
+		     memcmp(name, dir->prefix, dir->prefix_len))) {
+			break;
+		}
+
+		child = name + dir->prefix_len;
+		len = name_len - dir->prefix_len;
+		slash = memchr(child, '/', len);
+
+		if (slash == NULL) {
+			dirent_name_set(entry, child, len);
+			entry->type = FS_DIR_ENTRY_FILE;
+			entry->size = sys_le32_to_cpu(e->size);
+			dir->index++;
+			return 0;
+		}
+
+		/* Files of a subdirectory follow each other */
+		len = slash - child;
+		if ((len != dir->last_len) || memcmp(child, dir->last, len)) {
+			dir->last = child;
+			dir->last_len = len;
+			dirent_name_set(entry, child, len);
+			entry->type = FS_DIR_ENTRY_DIR;
+			entry->size = 0;
+			dir->index++;
+			return 0;
+		}
+	}
+
+	entry->name[0] = '\0';
+
+	return 0;
+}
+
+static int packfs_closedir(struct fs_dir_t *zdp)
+{
+	k_mem_slab_free(&packfs_dir_pool, &zdp->dirp);
+	zdp->dirp = NULL;
+
+	return 0;
+}
+
+static int packfs_stat(struct fs_mount_t *mountp, const char *path,
+		       struct fs_dirent *entry)
+{
+	const uint8_t *image = image_get(mountp);
+	const struct packfs_entry *e;
+	const char *base;
+	size_t len;
+
+	path = path_get(path, mountp, &len);
+
+	/* Name of the last component */
+	for (base = path + len; (base > path) && (base[-1] != '/'); base--) {
+	}
+	dirent_name_set(entry, base, path + len - base);
+
+	e = file_find(image, path, len);
+	if (e != NULL) {
+		entry->type = FS_DIR_ENTRY_FILE;
+		entry->size = sys_le32_to_cpu(e->size);
+		return 0;
+	}
+
+	if (dir_find(image, path, len) >= 0) {
+		entry->type = FS_DIR_ENTRY_DIR;
+		entry->size = 0;
+		return 0;
+	}
+
+	return -ENOENT;
+}
+
+static int packfs_statvfs(struct fs_mount_t *mountp, const char *path,
+			  struct fs_statvfs *stat)
+{
+	const struct packfs_header *hdr =
+		(const struct packfs_header *)image_get(mountp);
+
+	ARG_UNUSED(path);
+
+	stat->f_bsize = 1;
+	stat->f_frsize = 1;
+	stat->f_blocks = sys_le32_to_cpu(hdr->image_size);
+	stat->f_bfree = 0;
+
+	return 0;
+}
+
+static bool image_valid(const uint8_t *image)
+{
+	const struct packfs_header *hdr = (const struct packfs_header *)image;
+	uint32_t size = sys_le32_to_cpu(hdr->image_size);
+	const struct packfs_entry *e;
+	uint64_t name_end, data_end;
+
+	if ((sys_le32_to_cpu(hdr->magic) != PACKFS_MAGIC) ||
+	    (sys_le16_to_cpu(hdr->version) != PACKFS_VERSION)) {
+		return false;
+	}
+
+	if (sizeof(*hdr) + (uint64_t)entry_count(image) * sizeof(*e) > size) {
+		return false;
+	}
+
+	for (int i = 0; i < entry_count(image); i++) {
+		e = entry_get(image, i);
+		name_end = (uint64_t)sys_le32_to_cpu(e->name_off) +
+			   sys_le16_to_cpu(e->name_len);
+		data_end = (uint64_t)sys_le32_to_cpu(e->data_off) +
+			   sys_le32_to_cpu(e->size);
+		if ((name_end > size) || (data_end > size)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static int packfs_mount(struct fs_mount_t *mountp)
+{
+	const struct fs_packfs *fs = mountp->fs_data;
+
+	if ((fs == NULL) || (fs->image == NULL)) {
+		return -EINVAL;
+	}
+
+	if (!image_valid(fs->image)) {
+		LOG_ERR("%s: invalid image", mountp->mnt_point);
+		return -EINVAL;
+	}
+
+	mountp->flags |= FS_MOUNT_FLAG_READ_ONLY;
+
+	return 0;
+}
+
+static int packfs_unmount(struct fs_mount_t *mountp)
+{
+	ARG_UNUSED(mountp);
+
+	return 0;
+}
+
+static const struct fs_file_system_t packfs_fs = {
+	.open = packfs_open,
+	.close = packfs_close,
+	.read = packfs_read,
+	.lseek = packfs_seek,
+	.tell = packfs_tell,
+	.pread = packfs_pread,
+	.mmap = packfs_mmap,
+	.opendir = packfs_opendir,
+	.readdir = packfs_readdir,
+	.closedir = packfs_closedir,
+	.mount = packfs_mount,
+	.unmount = packfs_unmount,
+	.stat = packfs_stat,
+	.statvfs = packfs_statvfs,
+};
+
+static int packfs_init(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	return fs_register(FS_PACKFS, &packfs_fs);
+}
+
+SYS_INIT(packfs_init, POST_KERNEL, 99);
@@ -43,10 +43,84 @@ static int send(const struct device *instance, void *token,
 	return icmsg_send(conf, dev_data, msg, len);
 }
 
+static int get_tx_buffer_size(const struct device *instance, void *token)
+{
+	const struct icmsg_config_t *conf = instance->config;
+	struct icmsg_data_t *dev_data = instance->data;
+	size_t len = SIZE_MAX;
+	void *data;
+	int r;
+
+	/* Requesting too much reports the largest size without allocating */
+	r = icmsg_get_tx_buffer(conf, dev_data, &data, &len, K_NO_WAIT);
+
+	return (r == -ENOMEM) ? (int)len : r;
+}
+
+static int get_tx_buffer(const struct device *instance, void *token,
+			 void **data, uint32_t *user_len, k_timeout_t wait)
+{
+	const struct icmsg_config_t *conf = instance->config;
+	struct icmsg_data_t *dev_data = instance->data;
+	size_t len = *user_len;
+	int r;
+
+	r = icmsg_get_tx_buffer(conf, dev_data, data, &len, wait);
+	*user_len = len;
+
+	return r;
+}
+
+static int drop_tx_buffer(const struct device *instance, void *token,
+			  const void *data)
+{
+	const struct icmsg_config_t *conf = instance->config;
+	struct icmsg_data_t *dev_data = instance->data;
+
+	return icmsg_drop_tx_buffer(conf, dev_data, data);
+}
+
+static int send_nocopy(const struct device *instance, void *token,
+		       const void *msg, size_t len)
+{
+	const struct icmsg_config_t *conf = instance->config;
+	struct icmsg_data_t *dev_data = instance->data;
+
+	return icmsg_send_nocopy(conf, dev_data, msg, len);
+}
+
+#ifdef CONFIG_IPC_SERVICE_ICMSG_NOCOPY_RX
+static int hold_rx_buffer(const struct device *instance, void *token,
+			  void *data)
+{
+	const struct icmsg_config_t *conf = instance->config;
+	struct icmsg_data_t *dev_data = instance->data;
+
+	return icmsg_hold_rx_buffer(conf, dev_data, data);
+}
+
+static int release_rx_buffer(const struct device *instance, void *token,
+			     void *data)
+{
+	const struct icmsg_config_t *conf = instance->config;
+	struct icmsg_data_t *dev_data = instance->data;
+
+	return icmsg_release_rx_buffer(conf, dev_data, data);
+}
+#endif
+
 const static struct ipc_service_backend backend_ops = {
 	.register_endpoint = register_ept,
 	.deregister_endpoint = deregister_ept,
 	.send = send,
+	.get_tx_buffer_size = get_tx_buffer_size,
+	.get_tx_buffer = get_tx_buffer,
+	.drop_tx_buffer = drop_tx_buffer,
+	.send_nocopy = send_nocopy,
+#ifdef CONFIG_IPC_SERVICE_ICMSG_NOCOPY_RX
+	.hold_rx_buffer = hold_rx_buffer,
+	.release_rx_buffer = release_rx_buffer,
+#endif
 };
 
 static int backend_init(const struct device *instance)
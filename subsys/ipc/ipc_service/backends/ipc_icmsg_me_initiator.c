@@ -12,7 +12,6 @@
 
 #define DT_DRV_COMPAT	zephyr_ipc_icmsg_me_initiator
 
-#define SEND_BUF_SIZE CONFIG_IPC_SERVICE_BACKEND_ICMSG_ME_SEND_BUF_SIZE
 #define NUM_EP        CONFIG_IPC_SERVICE_BACKEND_ICMSG_ME_NUM_EP
 #define EP_NAME_LEN   CONFIG_IPC_SERVICE_BACKEND_ICMSG_ME_EP_NAME_LEN
 
@@ -33,8 +32,6 @@ struct backend_data_t {
 	struct k_mutex send_mutex;
 	const struct ipc_ept_cfg *epts[NUM_EP];
 	ept_id_t ids[NUM_EP];
-
-	uint8_t send_buffer[SEND_BUF_SIZE] __aligned(4);
 };
 
 static void bound(void *priv)
@@ -147,8 +144,10 @@ static int register_ept(const struct device *instance, void **token,
 
 	k_event_wait(&data->event, EVENT_BOUND, false, K_FOREVER);
 
+	k_mutex_lock(&data->send_mutex, K_FOREVER);
 	r = icmsg_send(conf, &data->icmsg_data, ep_disc_req,
 		       2 * sizeof(ept_id_t) + name_len);
+	k_mutex_unlock(&data->send_mutex);
 	if (r < 0) {
 		data->epts[i] = NULL;
 		goto exit;
@@ -167,41 +166,142 @@ static int send(const struct device *instance, void *token,
 	const struct icmsg_config_t *conf = instance->config;
 	struct backend_data_t *dev_data = instance->data;
 	ept_id_t *id = token;
+	size_t size = len + sizeof(ept_id_t);
+	uint8_t *buf;
 	int r;
-	int sent_bytes;
-
-	if (len >= SEND_BUF_SIZE - sizeof(ept_id_t)) {
-		return -EBADMSG;
-	}
 
 	k_mutex_lock(&dev_data->send_mutex, K_FOREVER);
 
-	/* TODO: Optimization: How to avoid this copying? */
-	/* We could implement scatter list for icmsg_send, but it would require
-	 * scatter list also for SPSC buffer implementation.
+	/* The message is copied once, after the endpoint id, in the TX
+	 * buffer.
 	 */
-	dev_data->send_buffer[0] = *id;
-	memcpy(dev_data->send_buffer + sizeof(ept_id_t), msg, len);
-
-	r = icmsg_send(conf, &dev_data->icmsg_data, dev_data->send_buffer,
-			len + sizeof(ept_id_t));
-	if (r > 0) {
-		sent_bytes = r - 1;
+	r = icmsg_get_tx_buffer(conf, &dev_data->icmsg_data, (void **)&buf,
+				&size, K_NO_WAIT);
+	if (r == 0) {
+		buf[0] = *id;
+		memcpy(buf + sizeof(ept_id_t), msg, len);
+		r = icmsg_send_nocopy(conf, &dev_data->icmsg_data, buf,
+				      len + sizeof(ept_id_t));
 	}
 
 	k_mutex_unlock(&dev_data->send_mutex);
 
 	if (r > 0) {
-		return sent_bytes;
-	} else {
+		return r - sizeof(ept_id_t);
+	}
+
+	/* Report the same errors as icmsg_send() */
+	if (r == -ENOMEM) {
+		return -EBADMSG;
+	} else if (r == -ENOBUFS) {
+		return -ENOMEM;
+	} else if (r == -EALREADY) {
+		return -EBUSY;
+	}
+
+	return r;
+}
+
+static int get_tx_buffer_size(const struct device *instance, void *token)
+{
+	const struct icmsg_config_t *conf = instance->config;
+	struct backend_data_t *dev_data = instance->data;
+	size_t len = SIZE_MAX;
+	void *data;
+	int r;
+
+	/* Requesting too much reports the largest size without allocating */
+	r = icmsg_get_tx_buffer(conf, &dev_data->icmsg_data, &data, &len,
+				K_NO_WAIT);
+
+	return (r == -ENOMEM) ? (int)(len - sizeof(ept_id_t)) : r;
+}
+
+static int get_tx_buffer(const struct device *instance, void *token,
+			 void **data, uint32_t *user_len, k_timeout_t wait)
+{
+	const struct icmsg_config_t *conf = instance->config;
+	struct backend_data_t *dev_data = instance->data;
+	ept_id_t *id = token;
+	size_t len = (*user_len == 0) ? 0 : *user_len + sizeof(ept_id_t);
+	uint8_t *buf;
+	int r;
+
+	r = icmsg_get_tx_buffer(conf, &dev_data->icmsg_data, (void **)&buf,
+				&len, wait);
+	if (len >= sizeof(ept_id_t)) {
+		*user_len = len - sizeof(ept_id_t);
+	}
+
+	if (r) {
 		return r;
 	}
+
+	/* The endpoint id precedes the user data, which is not word aligned */
+	buf[0] = *id;
+	*data = buf + sizeof(ept_id_t);
+
+	return 0;
+}
+
+static int drop_tx_buffer(const struct device *instance, void *token,
+			  const void *data)
+{
+	const struct icmsg_config_t *conf = instance->config;
+	struct backend_data_t *dev_data = instance->data;
+
+	return icmsg_drop_tx_buffer(conf, &dev_data->icmsg_data,
+				    (const uint8_t *)data - sizeof(ept_id_t));
+}
+
+static int send_nocopy(const struct device *instance, void *token,
+		       const void *msg, size_t len)
+{
+	const struct icmsg_config_t *conf = instance->config;
+	struct backend_data_t *dev_data = instance->data;
+	int r;
+
+	r = icmsg_send_nocopy(conf, &dev_data->icmsg_data,
+			      (const uint8_t *)msg - sizeof(ept_id_t),
+			      len + sizeof(ept_id_t));
+
+	return (r > 0) ? (int)(r - sizeof(ept_id_t)) : r;
+}
+
+#ifdef CONFIG_IPC_SERVICE_ICMSG_NOCOPY_RX
+static int hold_rx_buffer(const struct device *instance, void *token,
+			  void *data)
+{
+	const struct icmsg_config_t *conf = instance->config;
+	struct backend_data_t *dev_data = instance->data;
+
+	return icmsg_hold_rx_buffer(conf, &dev_data->icmsg_data,
+				    (uint8_t *)data - sizeof(ept_id_t));
+}
+
+static int release_rx_buffer(const struct device *instance, void *token,
+			     void *data)
+{
+	const struct icmsg_config_t *conf = instance->config;
+	struct backend_data_t *dev_data = instance->data;
+
+	return icmsg_release_rx_buffer(conf, &dev_data->icmsg_data,
+				       (uint8_t *)data - sizeof(ept_id_t));
 }
+#endif
 
 const static struct ipc_service_backend backend_ops = {
 	.open_instance = open,
 	.register_endpoint = register_ept,
 	.send = send,
+	.get_tx_buffer_size = get_tx_buffer_size,
+	.get_tx_buffer = get_tx_buffer,
+	.drop_tx_buffer = drop_tx_buffer,
+	.send_nocopy = send_nocopy,
+#ifdef CONFIG_IPC_SERVICE_ICMSG_NOCOPY_RX
+	.hold_rx_buffer = hold_rx_buffer,
+	.release_rx_buffer = release_rx_buffer,
+#endif
 };
 
 static int backend_init(const struct device *instance)
@@ -276,12 +276,21 @@ static void virtio_notify_cb(struct virtqueue *vq, void *priv)
 static void mbox_callback_process(struct k_work *item)
 {
 	struct backend_data_t *data;
+	struct virtqueue *vq;
 	unsigned int vq_id;
 
 	data = CONTAINER_OF(item, struct backend_data_t, mbox_work);
 	vq_id = (data->role == ROLE_HOST) ? VIRTQUEUE_ID_HOST : VIRTQUEUE_ID_REMOTE;
+	vq = data->vr.vq[vq_id];
 
-	virtqueue_notification(data->vr.vq[vq_id]);
+	/* The remote does not kick while notifications are disabled, so
+	 * buffers queued in the meantime are processed here, until the queue
+	 * is found empty after enabling notifications again.
+	 */
+	virtqueue_disable_cb(vq);
+	do {
+		virtqueue_notification(vq);
+	} while (virtqueue_enable_cb(vq));
 }
 
 static void mbox_callback(const struct device *instance, uint32_t channel,
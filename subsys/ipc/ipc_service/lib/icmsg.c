@@ -11,12 +11,18 @@
 #include <zephyr/sys/atomic.h>
 #include <zephyr/sys/spsc_pbuf.h>
 
-#define CB_BUF_SIZE	CONFIG_IPC_SERVICE_ICMSG_CB_BUF_SIZE
-
 static const uint8_t magic[] = {0x45, 0x6d, 0x31, 0x6c, 0x31, 0x4b,
 				0x30, 0x72, 0x6e, 0x33, 0x6c, 0x69, 0x34};
+
+#ifndef CONFIG_IPC_SERVICE_ICMSG_NOCOPY_RX
+#define CB_BUF_SIZE	CONFIG_IPC_SERVICE_ICMSG_CB_BUF_SIZE
+
 BUILD_ASSERT(sizeof(magic) <= CB_BUF_SIZE);
 BUILD_ASSERT(CB_BUF_SIZE <= UINT16_MAX);
+#endif
+
+/* Longest wait for a notification before checking the TX buffer again */
+#define TX_WAIT_POLL K_MSEC(1)
 
 static int mbox_deinit(const struct icmsg_config_t *conf,
 		       struct icmsg_data_t *dev_data)
@@ -41,10 +47,31 @@ static int mbox_deinit(const struct icmsg_config_t *conf,
 static void mbox_callback_process(struct k_work *item)
 {
 	struct icmsg_data_t *dev_data = CONTAINER_OF(item, struct icmsg_data_t, mbox_work);
+	atomic_t state = atomic_get(&dev_data->state);
+	const uint8_t *rx_buffer;
+	int len;
+
+#ifdef CONFIG_IPC_SERVICE_ICMSG_NOCOPY_RX
+	char *pkt;
+
+	if (atomic_get(&dev_data->rx_held)) {
+		/* Processing resumes when the held message is released. */
+		return;
+	}
+
+	len = spsc_pbuf_claim(dev_data->rx_ib, &pkt);
+	if (len == 0) {
+		return;
+	}
+
+	rx_buffer = (const uint8_t *)pkt;
+	dev_data->rx_buffer = rx_buffer;
+	dev_data->rx_len = len;
+#else
 	uint8_t cb_buffer[CB_BUF_SIZE] __aligned(4);
 
-	atomic_t state = atomic_get(&dev_data->state);
-	int len = spsc_pbuf_read(dev_data->rx_ib, cb_buffer, CB_BUF_SIZE);
+	rx_buffer = cb_buffer;
+	len = spsc_pbuf_read(dev_data->rx_ib, cb_buffer, CB_BUF_SIZE);
 
 	__ASSERT_NO_MSG(len <= CB_BUF_SIZE);
 
@@ -55,27 +82,37 @@ static void mbox_callback_process(struct k_work *item)
 	} else if (len <= 0) {
 		return;
 	}
+#endif
 
 	if (state == ICMSG_STATE_READY) {
 		if (dev_data->cb->received) {
-			dev_data->cb->received(cb_buffer, len, dev_data->ctx);
+			dev_data->cb->received(rx_buffer, len, dev_data->ctx);
 		}
 	} else {
 		__ASSERT_NO_MSG(state == ICMSG_STATE_BUSY);
-		if (len != sizeof(magic) || memcmp(magic, cb_buffer, len)) {
+		if (len != sizeof(magic) || memcmp(magic, rx_buffer, len)) {
 			__ASSERT_NO_MSG(false);
-			return;
-		}
+		} else {
+			if (dev_data->cb->bound) {
+				dev_data->cb->bound(dev_data->ctx);
+			}
 
-		if (dev_data->cb->bound) {
-			dev_data->cb->bound(dev_data->ctx);
+			atomic_set(&dev_data->state, ICMSG_STATE_READY);
 		}
+	}
 
-		atomic_set(&dev_data->state, ICMSG_STATE_READY);
+#ifdef CONFIG_IPC_SERVICE_ICMSG_NOCOPY_RX
+	if (atomic_get(&dev_data->rx_held)) {
+		return;
 	}
 
+	dev_data->rx_buffer = NULL;
+	spsc_pbuf_free(dev_data->rx_ib, len);
+#endif
+
 	/* Reading with NULL buffer to know if there are data in the
-	 * buffer to be read.
+	 * buffer to be read. The remote instance does not notify messages
+	 * sent before this one was processed.
 	 */
 	len = spsc_pbuf_read(dev_data->rx_ib, NULL, 0);
 	if (len > 0) {
@@ -93,6 +130,8 @@ static void mbox_callback(const struct device *instance, uint32_t channel,
 {
 	struct icmsg_data_t *dev_data = user_data;
 
+	/* The remote instance may have made room for a waiting sender */
+	k_sem_give(&dev_data->tx_space);
 	(void)k_work_submit(&dev_data->mbox_work);
 }
 
@@ -111,6 +150,39 @@ static int mbox_init(const struct icmsg_config_t *conf,
 	return mbox_set_enabled(&conf->mbox_rx, 1);
 }
 
+/* Largest message the TX buffer can hold when it is empty. */
+static size_t tx_max_len(struct icmsg_data_t *dev_data)
+{
+	return MIN(spsc_pbuf_capacity(dev_data->tx_ib) - sizeof(uint32_t),
+		   SPSC_PBUF_MAX_LEN - 1);
+}
+
+/* Publish an allocated message, and notify the remote instance unless it
+ * is still processing the previous ones.
+ */
+static int tx_commit(const struct icmsg_config_t *conf,
+		     struct icmsg_data_t *dev_data, size_t len)
+{
+	bool notify = true;
+
+	if (IS_ENABLED(CONFIG_IPC_SERVICE_ICMSG_COALESCE_NOTIFY)) {
+		notify = spsc_pbuf_commit_notify(dev_data->tx_ib, len);
+	} else {
+		spsc_pbuf_commit(dev_data->tx_ib, len);
+	}
+
+	dev_data->tx_buffer = NULL;
+	atomic_clear(&dev_data->tx_busy);
+
+	if (!notify) {
+		return 0;
+	}
+
+	__ASSERT_NO_MSG(conf->mbox_tx.dev != NULL);
+
+	return mbox_send(&conf->mbox_tx, NULL);
+}
+
 int icmsg_init(const struct icmsg_config_t *conf,
 	       struct icmsg_data_t *dev_data)
 {
@@ -120,6 +192,7 @@ int icmsg_init(const struct icmsg_config_t *conf,
 					 conf->tx_shm_size,
 					 SPSC_PBUF_CACHE);
 	dev_data->rx_ib = (void *)conf->rx_shm_addr;
+	k_sem_init(&dev_data->tx_space, 0, 1);
 
 	return 0;
 }
@@ -177,6 +250,11 @@ int icmsg_close(const struct icmsg_config_t *conf,
 		return ret;
 	}
 
+	dev_data->tx_buffer = NULL;
+	atomic_clear(&dev_data->tx_busy);
+	dev_data->rx_buffer = NULL;
+	atomic_clear(&dev_data->rx_held);
+
 	atomic_set(&dev_data->state, ICMSG_STATE_OFF);
 
 	return 0;
@@ -186,8 +264,8 @@ int icmsg_send(const struct icmsg_config_t *conf,
 	       struct icmsg_data_t *dev_data,
 	       const void *msg, size_t len)
 {
+	char *buf;
 	int ret;
-	int sent_bytes;
 
 	if (atomic_get(&dev_data->state) != ICMSG_STATE_READY) {
 		return -EBUSY;
@@ -198,22 +276,174 @@ int icmsg_send(const struct icmsg_config_t *conf,
 		return -ENODATA;
 	}
 
-	ret = spsc_pbuf_write(dev_data->tx_ib, msg, len);
-	if (ret < 0) {
-		return ret;
-	} else if (ret < len) {
+	if (len >= SPSC_PBUF_MAX_LEN) {
 		return -EBADMSG;
 	}
-	sent_bytes = ret;
 
-	__ASSERT_NO_MSG(conf->mbox_tx.dev != NULL);
+	if (!atomic_cas(&dev_data->tx_busy, false, true)) {
+		return -EBUSY;
+	}
 
-	ret = mbox_send(&conf->mbox_tx, NULL);
+	/* Message is copied in place, as with icmsg_get_tx_buffer(). */
+	ret = spsc_pbuf_alloc(dev_data->tx_ib, len, &buf);
+	if (ret < (int)len) {
+		atomic_clear(&dev_data->tx_busy);
+		return ret < 0 ? ret : -ENOMEM;
+	}
+
+	memcpy(buf, msg, len);
+
+	ret = tx_commit(conf, dev_data, len);
 	if (ret) {
 		return ret;
 	}
 
-	return sent_bytes;
+	return len;
+}
+
+int icmsg_get_tx_buffer(const struct icmsg_config_t *conf,
+			struct icmsg_data_t *dev_data,
+			void **data, size_t *size, k_timeout_t wait)
+{
+	uint64_t end = sys_clock_timeout_end_calc(wait);
+	size_t max_len;
+	char *buf;
+	int ret;
+
+	if (atomic_get(&dev_data->state) != ICMSG_STATE_READY) {
+		return -EBUSY;
+	}
+
+	max_len = tx_max_len(dev_data);
+	if (*size > max_len) {
+		*size = max_len;
+		return -ENOMEM;
+	}
+
+	if (!atomic_cas(&dev_data->tx_busy, false, true)) {
+		return -EALREADY;
+	}
+
+	while (true) {
+		ret = spsc_pbuf_alloc(dev_data->tx_ib,
+				      *size == 0 ? SPSC_PBUF_MAX_LEN : *size, &buf);
+		if (ret > 0 && (size_t)ret >= *size) {
+			break;
+		}
+
+		if (ret < 0 || K_TIMEOUT_EQ(wait, K_NO_WAIT) ||
+		    (!K_TIMEOUT_EQ(wait, K_FOREVER) &&
+		     (uint64_t)sys_clock_tick_get() >= end)) {
+			atomic_clear(&dev_data->tx_busy);
+			return ret < 0 ? ret : -ENOBUFS;
+		}
+
+		/* Space is freed when the remote instance processes messages,
+		 * which it does not signal by itself: the buffer is checked
+		 * again when it sends something, or after TX_WAIT_POLL.
+		 */
+		(void)k_sem_take(&dev_data->tx_space, TX_WAIT_POLL);
+	}
+
+	dev_data->tx_buffer = buf;
+	dev_data->tx_len = ret;
+
+	*data = buf;
+	*size = ret;
+
+	return 0;
+}
+
+int icmsg_drop_tx_buffer(const struct icmsg_config_t *conf,
+			 struct icmsg_data_t *dev_data,
+			 const void *data)
+{
+	if (dev_data->tx_buffer == NULL) {
+		return -EALREADY;
+	}
+
+	if (data != dev_data->tx_buffer) {
+		return -ENXIO;
+	}
+
+	/* Allocation does not change the buffer state except for padding,
+	 * which the remote instance skips.
+	 */
+	dev_data->tx_buffer = NULL;
+	atomic_clear(&dev_data->tx_busy);
+
+	return 0;
+}
+
+int icmsg_send_nocopy(const struct icmsg_config_t *conf,
+		      struct icmsg_data_t *dev_data,
+		      const void *msg, size_t len)
+{
+	int ret;
+
+	if (atomic_get(&dev_data->state) != ICMSG_STATE_READY) {
+		return -EBUSY;
+	}
+
+	if (dev_data->tx_buffer == NULL || msg != dev_data->tx_buffer) {
+		return -ENXIO;
+	}
+
+	if (len == 0) {
+		return -ENODATA;
+	}
+
+	if (len > dev_data->tx_len) {
+		return -EBADMSG;
+	}
+
+	ret = tx_commit(conf, dev_data, len);
+	if (ret) {
+		return ret;
+	}
+
+	return len;
+}
+
+int icmsg_hold_rx_buffer(const struct icmsg_config_t *conf,
+			 struct icmsg_data_t *dev_data,
+			 const void *data)
+{
+	if (!IS_ENABLED(CONFIG_IPC_SERVICE_ICMSG_NOCOPY_RX)) {
+		return -ENOTSUP;
+	}
+
+	if (data == NULL || data != dev_data->rx_buffer) {
+		return -ENXIO;
+	}
+
+	if (!atomic_cas(&dev_data->rx_held, false, true)) {
+		return -EALREADY;
+	}
+
+	return 0;
+}
+
+int icmsg_release_rx_buffer(const struct icmsg_config_t *conf,
+			    struct icmsg_data_t *dev_data,
+			    const void *data)
+{
+	if (!IS_ENABLED(CONFIG_IPC_SERVICE_ICMSG_NOCOPY_RX)) {
+		return -ENOTSUP;
+	}
+
+	if (!atomic_get(&dev_data->rx_held) || data != dev_data->rx_buffer) {
+		return -ENXIO;
+	}
+
+	dev_data->rx_buffer = NULL;
+	spsc_pbuf_free(dev_data->rx_ib, dev_data->rx_len);
+	atomic_clear(&dev_data->rx_held);
+
+	/* Process the messages received meanwhile. */
+	(void)k_work_submit(&dev_data->mbox_work);
+
+	return 0;
 }
 
 int icmsg_clear_tx_memory(const struct icmsg_config_t *conf)
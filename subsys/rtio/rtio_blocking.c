@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2022 Intel Corporation.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/rtio/rtio_blocking.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/kernel.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(rtio_blocking, CONFIG_RTIO_LOG_LEVEL);
+
+void z_rtio_blocking_work_handler(struct k_work *work)
+{
+	struct rtio_blocking *blk = CONTAINER_OF(work, struct rtio_blocking, work);
+	struct rtio_iodev_sqe *iodev_sqe;
+	const struct rtio_sqe *sqe;
+	struct rtio *r;
+	int result;
+
+	/* Completing a request may queue the next one of its chain */
+	while ((iodev_sqe = rtio_spsc_consume(blk->sq)) != NULL) {
+		sqe = iodev_sqe->sqe;
+		r = iodev_sqe->r;
+		rtio_spsc_release(blk->sq);
+
+		result = blk->fn(sqe, r);
+		if (result < 0) {
+			rtio_sqe_err(r, sqe, result);
+		} else {
+			rtio_sqe_ok(r, sqe, result);
+		}
+	}
+}
+
+void rtio_blocking_submit(struct rtio_blocking *blk, const struct rtio_sqe *sqe, struct rtio *r)
+{
+	struct rtio_iodev_sqe *iodev_sqe;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&blk->lock);
+
+	blk->sq = sqe->iodev->iodev_sq;
+	iodev_sqe = rtio_spsc_acquire(blk->sq);
+	if (iodev_sqe != NULL) {
+		iodev_sqe->sqe = sqe;
+		iodev_sqe->r = r;
+		rtio_spsc_produce(blk->sq);
+	}
+
+	k_spin_unlock(&blk->lock, key);
+
+	if (iodev_sqe == NULL) {
+		LOG_WRN("iodev queue full");
+		rtio_sqe_err(r, sqe, -ENOMEM);
+		return;
+	}
+
+	k_work_submit(&blk->work);
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2022 Intel Corporation.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_SUBSYS_RTIO_RTIO_EXECUTOR_COMMON_H_
+#define ZEPHYR_SUBSYS_RTIO_RTIO_EXECUTOR_COMMON_H_
+
+#include <zephyr/rtio/rtio.h>
+
+/**
+ * @brief Produce the completion of a submission, unless not wanted
+ */
+static inline void rtio_executor_complete(struct rtio *r, const struct rtio_sqe *sqe, int result)
+{
+	if (result < 0 || !(sqe->flags & RTIO_SQE_NO_RESPONSE)) {
+		rtio_cqe_submit(r, result, sqe->userdata);
+	}
+}
+
+/**
+ * @brief Whether the next submission belongs to the same chain
+ */
+static inline bool rtio_executor_linked(const struct rtio_sqe *sqe)
+{
+	return (sqe->flags & (RTIO_SQE_CHAINED | RTIO_SQE_TRANSACTION)) != 0;
+}
+
+/**
+ * @brief Whether a successful submission runs again
+ */
+static inline bool rtio_executor_rearm(const struct rtio_sqe *sqe)
+{
+	return (sqe->flags & RTIO_SQE_MULTISHOT) && !rtio_sqe_canceled(sqe);
+}
+
+#ifdef CONFIG_RTIO_OP_DELAY
+static void rtio_executor_delay_expired(struct k_timer *timer)
+{
+	struct rtio_delay *delay = CONTAINER_OF(timer, struct rtio_delay, timer);
+
+	rtio_sqe_ok(delay->r, delay->sqe, 0);
+}
+
+/**
+ * @brief Start the timer of a delay submission, which completes it
+ */
+static inline void rtio_executor_delay_start(struct rtio_delay *delay, struct rtio *r,
+					     const struct rtio_sqe *sqe)
+{
+	delay->r = r;
+	delay->sqe = sqe;
+	k_timer_init(&delay->timer, rtio_executor_delay_expired, NULL);
+	k_timer_start(&delay->timer, sqe->delay, K_NO_WAIT);
+}
+#endif
+
+#endif /* ZEPHYR_SUBSYS_RTIO_RTIO_EXECUTOR_COMMON_H_ */
@@ -9,6 +9,8 @@
 #include <zephyr/rtio/rtio.h>
 #include <zephyr/kernel.h>
 
+#include "rtio_executor_common.h"
+
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(rtio_executor_concurrent, CONFIG_RTIO_LOG_LEVEL);
 
@@ -69,7 +71,7 @@ static void conex_sweep_task(struct rtio *r, struct rtio_concurrent_executor *ex
 {
 	struct rtio_sqe *sqe = rtio_spsc_consume(r->sq);
 
-	while (sqe != NULL && sqe->flags & RTIO_SQE_CHAINED) {
+	while (sqe != NULL && rtio_executor_linked(sqe)) {
 		rtio_spsc_release(r->sq);
 		sqe = rtio_spsc_consume(r->sq);
 	}
@@ -91,14 +93,80 @@ static void conex_sweep(struct rtio *r, struct rtio_concurrent_executor *exc)
 	}
 }
 
+/**
+ * @brief Complete a task with an error, failing the rest of its chain
+ */
+static void conex_task_fail(struct rtio *r, struct rtio_concurrent_executor *exc,
+			    uint16_t task_idx, const struct rtio_sqe *sqe, int result)
+{
+	rtio_executor_complete(r, sqe, result);
+
+	while (rtio_executor_linked(sqe)) {
+		sqe = rtio_spsc_next(r->sq, sqe);
+		if (sqe == NULL) {
+			break;
+		}
+		rtio_cqe_submit(r, -ECANCELED, sqe->userdata);
+	}
+
+	exc->task_status[task_idx] |= CONEX_TASK_COMPLETE;
+}
+
+/**
+ * @brief Start the current submission of a task
+ *
+ * Operations done by the executor itself complete in place, going on with
+ * the rest of the chain until a submission is left in progress.
+ */
+static void conex_task_start(struct rtio *r, struct rtio_concurrent_executor *exc,
+			     uint16_t task_idx)
+{
+	struct rtio_sqe *sqe = exc->task_cur[task_idx];
+
+	while (true) {
+		if (rtio_sqe_canceled(sqe)) {
+			conex_task_fail(r, exc, task_idx, sqe, -ECANCELED);
+			return;
+		}
+
+		switch (sqe->op) {
+		case RTIO_OP_CALLBACK:
+			sqe->callback(r, sqe, sqe->arg0);
+			rtio_executor_complete(r, sqe, 0);
+			break;
+		case RTIO_OP_DELAY:
+#ifdef CONFIG_RTIO_OP_DELAY
+			rtio_executor_delay_start(&exc->task_delay[task_idx], r, sqe);
+#else
+			conex_task_fail(r, exc, task_idx, sqe, -ENOTSUP);
+#endif
+			return;
+		default:
+			rtio_iodev_submit(sqe, r);
+			return;
+		}
+
+		if (!(sqe->flags & RTIO_SQE_CHAINED) ||
+		    (rtio_spsc_next(r->sq, sqe) == NULL)) {
+			exc->task_status[task_idx] |= CONEX_TASK_COMPLETE;
+			return;
+		}
+
+		sqe = rtio_spsc_next(r->sq, sqe);
+		exc->task_cur[task_idx] = sqe;
+	}
+}
+
 static void conex_resume(struct rtio *r, struct rtio_concurrent_executor *exc)
 {
 	/* In order resume tasks */
 	for (uint16_t task_id = exc->task_out; task_id < exc->task_in; task_id++) {
-		if (exc->task_status[task_id & exc->task_mask] & CONEX_TASK_SUSPENDED) {
+		uint16_t task_idx = task_id & exc->task_mask;
+
+		if (exc->task_status[task_idx] & CONEX_TASK_SUSPENDED) {
 			LOG_INF("resuming suspended task %d", task_id);
-			exc->task_status[task_id] &= ~CONEX_TASK_SUSPENDED;
-			rtio_iodev_submit(exc->task_cur[task_id], r);
+			exc->task_status[task_idx] &= ~CONEX_TASK_SUSPENDED;
+			conex_task_start(r, exc, task_idx);
 		}
 	}
 }
@@ -107,6 +175,9 @@ static void conex_sweep_resume(struct rtio *r, struct rtio_concurrent_executor *
 {
 	conex_sweep(r, exc);
 	conex_resume(r, exc);
+
+	/* Tasks done entirely by the executor complete when resumed */
+	conex_sweep(r, exc);
 }
 
 /**
@@ -145,7 +216,7 @@ int rtio_concurrent_submit(struct rtio *r)
 		LOG_INF("head SQE in chain %p", sqe);
 
 		/* Get the next task id if one exists */
-		uint16_t task_idx = conex_task_next(exc);
+		uint16_t task_idx = conex_task_next(exc) & exc->task_mask;
 
 		LOG_INF("setting up task %d", task_idx);
 
@@ -155,7 +226,7 @@ int rtio_concurrent_submit(struct rtio *r)
 
 		LOG_INF("submitted sqe %p", sqe);
 		/* Go to the next sqe not in the current chain */
-		while (sqe != NULL && (sqe->flags & RTIO_SQE_CHAINED)) {
+		while (sqe != NULL && rtio_executor_linked(sqe)) {
 			sqe = rtio_spsc_next(r->sq, sqe);
 		}
 
@@ -186,6 +257,7 @@ int rtio_concurrent_submit(struct rtio *r)
 
 	/* Resume all suspended tasks */
 	conex_resume(r, exc);
+	conex_sweep(r, exc);
 
 	k_spin_unlock(&exc->lock, key);
 
@@ -197,7 +269,6 @@ int rtio_concurrent_submit(struct rtio *r)
  */
 void rtio_concurrent_ok(struct rtio *r, const struct rtio_sqe *sqe, int result)
 {
-	struct rtio_sqe *next_sqe;
 	k_spinlock_key_t key;
 	struct rtio_concurrent_executor *exc = (struct rtio_concurrent_executor *)r->executor;
 
@@ -210,21 +281,36 @@ void rtio_concurrent_ok(struct rtio *r, const struct rtio_sqe *sqe, int result)
 	 */
 	key = k_spin_lock(&exc->lock);
 
-	rtio_cqe_submit(r, result, sqe->userdata);
-
 	/* Determine the task id : O(n) */
-	uint16_t task_id = conex_task_id(exc, sqe);
+	uint16_t task_idx = conex_task_id(exc, sqe) & exc->task_mask;
 
-	if (sqe->flags & RTIO_SQE_CHAINED) {
-		next_sqe = rtio_spsc_next(r->sq, sqe);
+	if (rtio_executor_rearm(sqe)) {
+		rtio_cqe_submit(r, result, sqe->userdata);
+		rtio_iodev_submit(sqe, r);
+		k_spin_unlock(&exc->lock, key);
+		return;
+	}
 
-		rtio_iodev_submit(next_sqe, r);
+	rtio_executor_complete(r, sqe, result);
 
-		exc->task_cur[task_id] = next_sqe;
-	} else {
-		exc->task_status[task_id]  |= CONEX_TASK_COMPLETE;
+	/* The iodev did the rest of the transaction as well */
+	while (sqe->flags & RTIO_SQE_TRANSACTION) {
+		const struct rtio_sqe *next = rtio_spsc_next(r->sq, sqe);
+
+		if (next == NULL) {
+			break;
+		}
+		sqe = next;
+		rtio_executor_complete(r, sqe, result);
 	}
 
+	if ((sqe->flags & RTIO_SQE_CHAINED) &&
+	    (rtio_spsc_next(r->sq, sqe) != NULL)) {
+		exc->task_cur[task_idx] = rtio_spsc_next(r->sq, sqe);
+		conex_task_start(r, exc, task_idx);
+	} else {
+		exc->task_status[task_idx] |= CONEX_TASK_COMPLETE;
+	}
 
 	/* Sweep up unused SQEs and tasks, retry suspended tasks */
 	/* TODO Use a try lock here and don't bother doing it if we are already
@@ -240,7 +326,6 @@ void rtio_concurrent_ok(struct rtio *r, const struct rtio_sqe *sqe, int result)
  */
 void rtio_concurrent_err(struct rtio *r, const struct rtio_sqe *sqe, int result)
 {
-	struct rtio_sqe *nsqe;
 	k_spinlock_key_t key;
 	struct rtio_concurrent_executor *exc = (struct rtio_concurrent_executor *)r->executor;
 
@@ -254,23 +339,11 @@ void rtio_concurrent_err(struct rtio *r, const struct rtio_sqe *sqe, int result)
 	 */
 	key = k_spin_lock(&exc->lock);
 
-	rtio_cqe_submit(r, result, sqe->userdata);
-
 	/* Determine the task id : O(n) */
-	uint16_t task_id = conex_task_id(exc, sqe);
-
-
-	/* Fail the remaining sqe's in the chain */
-	if (sqe->flags & RTIO_SQE_CHAINED) {
-		nsqe = rtio_spsc_next(r->sq, sqe);
-		while (nsqe != NULL && nsqe->flags & RTIO_SQE_CHAINED) {
-			rtio_cqe_submit(r, -ECANCELED, nsqe->userdata);
-			nsqe = rtio_spsc_next(r->sq, nsqe);
-		}
-	}
+	uint16_t task_idx = conex_task_id(exc, sqe) & exc->task_mask;
 
-	/* Task is complete (failed) */
-	exc->task_status[task_id] |= CONEX_TASK_COMPLETE;
+	/* Task is complete (failed), as the remaining sqe's in the chain */
+	conex_task_fail(r, exc, task_idx, sqe, result);
 
 	conex_sweep_resume(r, exc);
 
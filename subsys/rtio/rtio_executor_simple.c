@@ -8,9 +8,79 @@
 #include <zephyr/rtio/rtio.h>
 #include <zephyr/kernel.h>
 
+#include "rtio_executor_common.h"
+
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(rtio_executor_simple, CONFIG_RTIO_LOG_LEVEL);
 
+/**
+ * @brief Release the submission in progress and produce its completion
+ */
+static void rtio_simple_complete(struct rtio *r, const struct rtio_sqe *sqe, int result)
+{
+	struct rtio_sqe done = *sqe;
+
+	/* The entry may be reused as soon as it is released */
+	rtio_spsc_release(r->sq);
+	rtio_executor_complete(r, &done, result);
+}
+
+/**
+ * @brief Fail the submission in progress and the rest of its chain
+ */
+static void rtio_simple_fail(struct rtio *r, const struct rtio_sqe *sqe, int result)
+{
+	bool chained = rtio_executor_linked(sqe);
+
+	rtio_simple_complete(r, sqe, result);
+
+	while (chained) {
+		sqe = rtio_spsc_consume(r->sq);
+		if (sqe == NULL) {
+			break;
+		}
+		chained = rtio_executor_linked(sqe);
+		rtio_simple_complete(r, sqe, -ECANCELED);
+	}
+}
+
+/**
+ * @brief Start a consumed submission
+ *
+ * Operations done by the executor itself complete in place, going on with
+ * the next submissions until one is left in progress.
+ */
+static void rtio_simple_start(struct rtio *r, struct rtio_sqe *sqe)
+{
+	while (sqe != NULL) {
+		if (rtio_sqe_canceled(sqe)) {
+			rtio_simple_fail(r, sqe, -ECANCELED);
+			sqe = rtio_spsc_consume(r->sq);
+			continue;
+		}
+
+		switch (sqe->op) {
+		case RTIO_OP_CALLBACK:
+			sqe->callback(r, sqe, sqe->arg0);
+			rtio_simple_complete(r, sqe, 0);
+			break;
+		case RTIO_OP_DELAY:
+#ifdef CONFIG_RTIO_OP_DELAY
+			rtio_executor_delay_start(
+				&((struct rtio_simple_executor *)r->executor)->delay, r, sqe);
+			return;
+#else
+			rtio_simple_fail(r, sqe, -ENOTSUP);
+			break;
+#endif
+		default:
+			rtio_iodev_submit(sqe, r);
+			return;
+		}
+
+		sqe = rtio_spsc_consume(r->sq);
+	}
+}
 
 /**
  * @brief Submit submissions to simple executor
@@ -24,15 +94,13 @@ LOG_MODULE_REGISTER(rtio_executor_simple, CONFIG_RTIO_LOG_LEVEL);
  */
 int rtio_simple_submit(struct rtio *r)
 {
-	/* TODO For each submission queue entry chain,
-	 * submit the chain to the first iodev
-	 */
-	struct rtio_sqe *sqe = rtio_spsc_consume(r->sq);
-
-	if (sqe != NULL) {
-		rtio_iodev_submit(sqe, r);
+	/* The completion of the submission in progress starts the next one */
+	if (rtio_spsc_consumed(r->sq) > 0) {
+		return 0;
 	}
 
+	rtio_simple_start(r, rtio_spsc_consume(r->sq));
+
 	return 0;
 }
 
@@ -41,11 +109,27 @@ int rtio_simple_submit(struct rtio *r)
  */
 void rtio_simple_ok(struct rtio *r, const struct rtio_sqe *sqe, int result)
 {
-	void *userdata = sqe->userdata;
+	if (rtio_executor_rearm(sqe)) {
+		rtio_cqe_submit(r, result, sqe->userdata);
+		rtio_iodev_submit(sqe, r);
+		return;
+	}
 
-	rtio_spsc_release(r->sq);
-	rtio_cqe_submit(r, result, userdata);
-	rtio_simple_submit(r);
+	bool txn = sqe->flags & RTIO_SQE_TRANSACTION;
+
+	rtio_simple_complete(r, sqe, result);
+
+	/* The iodev did the rest of the transaction as well */
+	while (txn) {
+		sqe = rtio_spsc_consume(r->sq);
+		if (sqe == NULL) {
+			break;
+		}
+		txn = sqe->flags & RTIO_SQE_TRANSACTION;
+		rtio_simple_complete(r, sqe, result);
+	}
+
+	rtio_simple_start(r, rtio_spsc_consume(r->sq));
 }
 
 /**
@@ -53,29 +137,6 @@ void rtio_simple_ok(struct rtio *r, const struct rtio_sqe *sqe, int result)
  */
 void rtio_simple_err(struct rtio *r, const struct rtio_sqe *sqe, int result)
 {
-	struct rtio_sqe *nsqe;
-	void *userdata = sqe->userdata;
-	bool chained = sqe->flags & RTIO_SQE_CHAINED;
-
-	rtio_spsc_release(r->sq);
-	rtio_cqe_submit(r, result, sqe->userdata);
-
-	if (chained) {
-
-		nsqe = rtio_spsc_consume(r->sq);
-		while (nsqe != NULL && nsqe->flags & RTIO_SQE_CHAINED) {
-			userdata = nsqe->userdata;
-			rtio_spsc_release(r->sq);
-			rtio_cqe_submit(r, -ECANCELED, userdata);
-			nsqe = rtio_spsc_consume(r->sq);
-		}
-
-		if (nsqe != NULL) {
-			rtio_iodev_submit(nsqe, r);
-		}
-
-	} else {
-		/* Now we can submit the next in the queue if we aren't done */
-		rtio_simple_submit(r);
-	}
+	rtio_simple_fail(r, sqe, result);
+	rtio_simple_start(r, rtio_spsc_consume(r->sq));
 }
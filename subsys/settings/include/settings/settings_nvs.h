@@ -45,6 +45,10 @@ struct settings_nvs {
 	} cache[CONFIG_SETTINGS_NVS_NAME_CACHE_SIZE];
 
 	uint16_t cache_next;
+	/* Every stored name is in the cache */
+	bool cache_complete;
+	/* A name was dropped from the cache */
+	bool cache_evicted;
 #endif
 };
 
@@ -24,6 +24,105 @@ sys_slist_t settings_handlers;
 
 K_MUTEX_DEFINE(settings_lock);
 
+#if defined(CONFIG_SETTINGS_HANDLER_LOOKUP)
+/* Handlers hashed by name with linear probing. Names are hashed with
+ * FNV-1a, so the hashes of all the prefixes of a key are found in a
+ * single pass over it.
+ */
+#define HANDLER_HASH_INIT 2166136261U
+
+static struct settings_handler_static
+	*handler_index[CONFIG_SETTINGS_HANDLER_LOOKUP_SIZE];
+/* Set when the index holds all the handlers */
+static bool handler_index_valid;
+
+static inline uint32_t handler_hash_step(uint32_t hash, char c)
+{
+	return (hash ^ (uint8_t)c) * 16777619U;
+}
+
+static void handler_index_add(struct settings_handler_static *ch)
+{
+	uint32_t hash = HANDLER_HASH_INIT;
+	size_t slot;
+
+	for (const char *c = ch->name; *c != '\0'; c++) {
+		hash = handler_hash_step(hash, *c);
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(handler_index); i++) {
+		slot = (hash + i) % ARRAY_SIZE(handler_index);
+		if ((handler_index[slot] == NULL) ||
+		    !strcmp(handler_index[slot]->name, ch->name)) {
+			handler_index[slot] = ch;
+			return;
+		}
+	}
+
+	/* Full, fall back to walking all the handlers */
+	LOG_WRN("CONFIG_SETTINGS_HANDLER_LOOKUP_SIZE too small");
+	handler_index_valid = false;
+}
+
+static struct settings_handler_static *handler_index_find(const char *name,
+							  size_t len,
+							  uint32_t hash)
+{
+	struct settings_handler_static *ch;
+
+	for (size_t i = 0; i < ARRAY_SIZE(handler_index); i++) {
+		ch = handler_index[(hash + i) % ARRAY_SIZE(handler_index)];
+		if (ch == NULL) {
+			break;
+		}
+		if (!strncmp(ch->name, name, len) && (ch->name[len] == '\0')) {
+			return ch;
+		}
+	}
+
+	return NULL;
+}
+
+/* Find the handler of the longest prefix of name, ending at a separator */
+static bool handler_index_lookup(const char *name, const char **next,
+				 struct settings_handler_static **match)
+{
+	const char *end[SETTINGS_MAX_DIR_DEPTH];
+	uint32_t hash[SETTINGS_MAX_DIR_DEPTH];
+	uint32_t h = HANDLER_HASH_INIT;
+	int n = 0;
+
+	for (const char *c = name; ; c++) {
+		if ((*c == SETTINGS_NAME_SEPARATOR) || (*c == SETTINGS_NAME_END) ||
+		    (*c == '\0')) {
+			if (n == ARRAY_SIZE(end)) {
+				/* Too deep, let the caller walk the handlers */
+				return false;
+			}
+			end[n] = c;
+			hash[n++] = h;
+			if (*c != SETTINGS_NAME_SEPARATOR) {
+				break;
+			}
+		}
+		h = handler_hash_step(h, *c);
+	}
+
+	*match = NULL;
+
+	while (n-- > 0) {
+		*match = handler_index_find(name, end[n] - name, hash[n]);
+		if (*match != NULL) {
+			if (next && (*end[n] == SETTINGS_NAME_SEPARATOR)) {
+				*next = end[n] + 1;
+			}
+			break;
+		}
+	}
+
+	return true;
+}
+#endif /* CONFIG_SETTINGS_HANDLER_LOOKUP */
 
 void settings_store_init(void);
 
@@ -32,6 +131,13 @@ void settings_init(void)
 #if defined(CONFIG_SETTINGS_DYNAMIC_HANDLERS)
 	sys_slist_init(&settings_handlers);
 #endif /* CONFIG_SETTINGS_DYNAMIC_HANDLERS */
+#if defined(CONFIG_SETTINGS_HANDLER_LOOKUP)
+	(void)memset(handler_index, 0, sizeof(handler_index));
+	handler_index_valid = true;
+	STRUCT_SECTION_FOREACH(settings_handler_static, ch) {
+		handler_index_add(ch);
+	}
+#endif /* CONFIG_SETTINGS_HANDLER_LOOKUP */
 	settings_store_init();
 }
 
@@ -56,6 +162,11 @@ int settings_register(struct settings_handler *handler)
 		}
 	}
 	sys_slist_append(&settings_handlers, &handler->node);
+#if defined(CONFIG_SETTINGS_HANDLER_LOOKUP)
+	if (handler_index_valid) {
+		handler_index_add((struct settings_handler_static *)handler);
+	}
+#endif /* CONFIG_SETTINGS_HANDLER_LOOKUP */
 
 end:
 	k_mutex_unlock(&settings_lock);
@@ -145,6 +256,13 @@ struct settings_handler_static *settings_parse_and_lookup(const char *name,
 		*next = NULL;
 	}
 
+#if defined(CONFIG_SETTINGS_HANDLER_LOOKUP)
+	if (handler_index_valid &&
+	    handler_index_lookup(name, next, &bestmatch)) {
+		return bestmatch;
+	}
+#endif /* CONFIG_SETTINGS_HANDLER_LOOKUP */
+
 	STRUCT_SECTION_FOREACH(settings_handler_static, ch) {
 		if (!settings_name_steq(name, ch->name, &tmpnext)) {
 			continue;
@@ -0,0 +1,400 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <errno.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/sys/byteorder.h>
+#include "settings_priv.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(settings, CONFIG_SETTINGS_LOG_LEVEL);
+
+/* Pending items are kept as records of the name length (1 byte), the value
+ * length (2 bytes, little endian, 0 for a delete), the name without its
+ * terminating '\0' and the value. A transaction is first saved as a single
+ * item holding all the records, named SETTINGS_TXN_JOURNAL, which is
+ * replayed at init if the records were not all written.
+ */
+#define SETTINGS_CACHE_HDR_LEN 3
+
+extern struct k_mutex settings_lock;
+
+static struct settings_cache {
+	uint8_t buf[CONFIG_SETTINGS_WRITE_CACHE_SIZE];
+	size_t used;
+	uint16_t count;
+	/* Thread which started a transaction, if any */
+	k_tid_t txn;
+} cache;
+
+static void settings_cache_flush_work(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(flush_work, settings_cache_flush_work);
+
+static size_t record_len(const uint8_t *rec)
+{
+	return SETTINGS_CACHE_HDR_LEN + rec[0] + sys_get_le16(&rec[1]);
+}
+
+static uint8_t *record_find(const char *name, size_t name_len)
+{
+	uint8_t *rec = cache.buf;
+
+	while (rec < &cache.buf[cache.used]) {
+		if ((rec[0] == name_len) &&
+		    !memcmp(&rec[SETTINGS_CACHE_HDR_LEN], name, name_len)) {
+			return rec;
+		}
+		rec += record_len(rec);
+	}
+
+	return NULL;
+}
+
+static void record_remove(uint8_t *rec)
+{
+	size_t len = record_len(rec);
+	uint8_t *end = &cache.buf[cache.used];
+
+	memmove(rec, rec + len, end - (rec + len));
+	cache.used -= len;
+	cache.count--;
+}
+
+static bool records_valid(const uint8_t *buf, size_t len)
+{
+	const uint8_t *rec = buf;
+
+	while (rec < &buf[len]) {
+		if ((&buf[len] - rec < SETTINGS_CACHE_HDR_LEN) ||
+		    (rec[0] > SETTINGS_MAX_NAME_LEN) ||
+		    (&buf[len] - rec < record_len(rec))) {
+			return false;
+		}
+		rec += record_len(rec);
+	}
+
+	return true;
+}
+
+static int records_write(struct settings_store *cs, const uint8_t *buf,
+			 size_t len)
+{
+	char name[SETTINGS_MAX_NAME_LEN + 1];
+	const uint8_t *rec = buf;
+	const char *value;
+	size_t val_len;
+	int rc, ret = 0;
+
+	/* An item failing does not prevent the following ones from being
+	 * written, the first error is returned.
+	 */
+	while (rec < &buf[len]) {
+		memcpy(name, &rec[SETTINGS_CACHE_HDR_LEN], rec[0]);
+		name[rec[0]] = '\0';
+		val_len = sys_get_le16(&rec[1]);
+		value = (const char *)&rec[SETTINGS_CACHE_HDR_LEN + rec[0]];
+
+		rc = cs->cs_itf->csi_save(cs, name, val_len ? value : NULL,
+					  val_len);
+		if (rc) {
+			LOG_ERR("writing %s failed: %d", name, rc);
+			if (ret == 0) {
+				ret = rc;
+			}
+		}
+
+		rec += record_len(rec);
+	}
+
+	return ret;
+}
+
+/* Write the pending items, through the journal if they must be atomic */
+static int settings_cache_flush(bool atomic)
+{
+	struct settings_store *cs = settings_save_dst;
+	int rc;
+
+	if (cache.used == 0) {
+		return 0;
+	}
+
+	/* A single item is written atomically by every back-end */
+	atomic = atomic && (cache.count > 1);
+
+	if (atomic) {
+		rc = cs->cs_itf->csi_save(cs, SETTINGS_TXN_JOURNAL,
+					  (const char *)cache.buf, cache.used);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	rc = records_write(cs, cache.buf, cache.used);
+	if (atomic && (rc == 0)) {
+		rc = cs->cs_itf->csi_save(cs, SETTINGS_TXN_JOURNAL, NULL, 0);
+	}
+
+	/* Items which could not be written are dropped, keeping them would
+	 * fail every later flush. After an atomic write the journal is left
+	 * for settings_cache_recover() to complete.
+	 */
+	cache.used = 0;
+	cache.count = 0;
+
+	return rc;
+}
+
+static void settings_cache_flush_work(struct k_work *work)
+{
+	/* Do not block the system work queue during a transaction */
+	if (k_mutex_lock(&settings_lock, K_NO_WAIT)) {
+		k_work_schedule(k_work_delayable_from_work(work),
+				K_MSEC(CONFIG_SETTINGS_WRITE_CACHE_FLUSH_DELAY_MS));
+		return;
+	}
+
+	(void)settings_cache_sync();
+
+	k_mutex_unlock(&settings_lock);
+}
+
+int settings_cache_save(struct settings_store *cs, const char *name,
+			const void *value, size_t val_len)
+{
+	size_t name_len = strlen(name);
+	size_t len = SETTINGS_CACHE_HDR_LEN + name_len + val_len;
+	size_t old_len = 0;
+	uint8_t *rec;
+	int rc;
+
+	ARG_UNUSED(cs);
+
+	if ((name_len > SETTINGS_MAX_NAME_LEN) || (val_len > UINT16_MAX)) {
+		return -EINVAL;
+	}
+
+	if (value == NULL) {
+		val_len = 0;
+		len = SETTINGS_CACHE_HDR_LEN + name_len;
+	}
+
+	if (len > sizeof(cache.buf)) {
+		return -ENOMEM;
+	}
+
+	/* The previous value stays pending until the new one is stored */
+	rec = record_find(name, name_len);
+	if (rec != NULL) {
+		old_len = record_len(rec);
+	}
+
+	if (cache.used - old_len + len > sizeof(cache.buf)) {
+		if (cache.txn != NULL) {
+			return -ENOMEM;
+		}
+
+		rc = settings_cache_flush(false);
+		if (rc) {
+			return rc;
+		}
+
+		/* Written along with the other items */
+		rec = NULL;
+	}
+
+	if (rec != NULL) {
+		record_remove(rec);
+	}
+
+	rec = &cache.buf[cache.used];
+	rec[0] = name_len;
+	sys_put_le16(val_len, &rec[1]);
+	memcpy(&rec[SETTINGS_CACHE_HDR_LEN], name, name_len);
+	if (val_len) {
+		memcpy(&rec[SETTINGS_CACHE_HDR_LEN + name_len], value, val_len);
+	}
+	cache.used += len;
+	cache.count++;
+
+	if (cache.txn != NULL) {
+		return 0;
+	}
+
+	if ((CONFIG_SETTINGS_WRITE_CACHE_FLUSH_COUNT > 0) &&
+	    (cache.count >= CONFIG_SETTINGS_WRITE_CACHE_FLUSH_COUNT)) {
+		return settings_cache_flush(false);
+	}
+
+	if (CONFIG_SETTINGS_WRITE_CACHE_FLUSH_DELAY_MS > 0) {
+		/* Does not postpone an already scheduled write */
+		k_work_schedule(&flush_work,
+				K_MSEC(CONFIG_SETTINGS_WRITE_CACHE_FLUSH_DELAY_MS));
+	}
+
+	return 0;
+}
+
+int settings_cache_sync(void)
+{
+	if (cache.txn != NULL) {
+		return 0;
+	}
+
+	return settings_cache_flush(false);
+}
+
+int settings_sync(void)
+{
+	int rc;
+
+	if (settings_save_dst == NULL) {
+		return -ENOENT;
+	}
+
+	k_mutex_lock(&settings_lock, K_FOREVER);
+	rc = settings_cache_sync();
+	k_mutex_unlock(&settings_lock);
+
+	return rc;
+}
+
+int settings_txn_begin(void)
+{
+	int rc;
+
+	if (settings_save_dst == NULL) {
+		return -ENOENT;
+	}
+
+	/* The lock is held until the transaction ends */
+	k_mutex_lock(&settings_lock, K_FOREVER);
+
+	if (cache.txn == k_current_get()) {
+		k_mutex_unlock(&settings_lock);
+		return -EALREADY;
+	}
+
+	rc = settings_cache_flush(false);
+	if (rc) {
+		k_mutex_unlock(&settings_lock);
+		return rc;
+	}
+
+	cache.txn = k_current_get();
+
+	return 0;
+}
+
+int settings_txn_commit(void)
+{
+	int rc;
+
+	k_mutex_lock(&settings_lock, K_FOREVER);
+
+	if (cache.txn != k_current_get()) {
+		k_mutex_unlock(&settings_lock);
+		return -EINVAL;
+	}
+
+	rc = settings_cache_flush(true);
+
+	/* The items are either in the journal or not written at all */
+	cache.used = 0;
+	cache.count = 0;
+	cache.txn = NULL;
+
+	/* Once for this call and once for settings_txn_begin() */
+	k_mutex_unlock(&settings_lock);
+	k_mutex_unlock(&settings_lock);
+
+	return rc;
+}
+
+void settings_txn_abort(void)
+{
+	k_mutex_lock(&settings_lock, K_FOREVER);
+
+	if (cache.txn != k_current_get()) {
+		k_mutex_unlock(&settings_lock);
+		return;
+	}
+
+	cache.used = 0;
+	cache.count = 0;
+	cache.txn = NULL;
+
+	k_mutex_unlock(&settings_lock);
+	k_mutex_unlock(&settings_lock);
+}
+
+static int journal_read(const char *key, size_t len, settings_read_cb read_cb,
+			void *cb_arg, void *param)
+{
+	ssize_t rc;
+
+	ARG_UNUSED(param);
+
+	/* Only the journal itself, not items below it */
+	if (key != NULL) {
+		return 0;
+	}
+
+	if (len > sizeof(cache.buf)) {
+		LOG_ERR("transaction journal too large: %zu", len);
+		return -ENOMEM;
+	}
+
+	rc = read_cb(cb_arg, cache.buf, len);
+	if (rc == len) {
+		cache.used = len;
+	}
+
+	return 0;
+}
+
+int settings_cache_recover(void)
+{
+	struct settings_store *cs = settings_save_dst;
+	int rc;
+
+	if (cs == NULL) {
+		return 0;
+	}
+
+	k_mutex_lock(&settings_lock, K_FOREVER);
+
+	cache.used = 0;
+	cache.count = 0;
+
+	(void)settings_load_subtree_direct(SETTINGS_TXN_JOURNAL, journal_read,
+					   NULL);
+	if (cache.used == 0) {
+		k_mutex_unlock(&settings_lock);
+		return 0;
+	}
+
+	if (records_valid(cache.buf, cache.used)) {
+		LOG_WRN("completing an interrupted transaction");
+		rc = records_write(cs, cache.buf, cache.used);
+	} else {
+		LOG_ERR("discarding a corrupted transaction journal");
+		rc = 0;
+	}
+
+	if (rc == 0) {
+		rc = cs->cs_itf->csi_save(cs, SETTINGS_TXN_JOURNAL, NULL, 0);
+	}
+
+	cache.used = 0;
+
+	k_mutex_unlock(&settings_lock);
+
+	return rc;
+}
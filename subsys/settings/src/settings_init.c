@@ -14,6 +14,7 @@
 #include <zephyr/settings/settings.h>
 #include "settings/settings_file.h"
 #include <zephyr/kernel.h>
+#include "settings_priv.h"
 
 
 bool settings_subsys_initialized;
@@ -35,6 +36,12 @@ int settings_subsys_init(void)
 
 	err = settings_backend_init(); /* func rises kernel panic once error */
 
+#ifdef CONFIG_SETTINGS_WRITE_CACHE
+	if (!err) {
+		err = settings_cache_recover();
+	}
+#endif
+
 	if (!err) {
 		settings_subsys_initialized = true;
 	}
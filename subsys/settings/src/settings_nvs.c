@@ -25,9 +25,20 @@ LOG_MODULE_DECLARE(settings, CONFIG_SETTINGS_LOG_LEVEL);
 
 struct settings_nvs_read_fn_arg {
 	struct nvs_fs *fs;
-	uint16_t id;
+	const struct nvs_entry *entry;
 };
 
+/* Entries found by one scan of the NVS allocation table when loading, the
+ * table is only used with the settings lock held.
+ */
+struct settings_nvs_load_batch {
+	uint16_t first;
+	struct nvs_entry name[CONFIG_SETTINGS_NVS_LOAD_BATCH];
+	struct nvs_entry value[CONFIG_SETTINGS_NVS_LOAD_BATCH];
+};
+
+static struct settings_nvs_load_batch load_batch;
+
 static int settings_nvs_load(struct settings_store *cs,
 			     const struct settings_load_arg *arg);
 static int settings_nvs_save(struct settings_store *cs, const char *name,
@@ -47,9 +58,9 @@ static ssize_t settings_nvs_read_fn(void *back_end, void *data, size_t len)
 
 	rd_fn_arg = (struct settings_nvs_read_fn_arg *)back_end;
 
-	rc = nvs_read(rd_fn_arg->fs, rd_fn_arg->id, data, len);
+	rc = nvs_entry_read(rd_fn_arg->fs, rd_fn_arg->entry, data, len);
 	if (rc > (ssize_t)len) {
-		/* nvs_read signals that not all bytes were read
+		/* nvs_entry_read signals that not all bytes were read
 		 * align read len to what was requested
 		 */
 		rc = len;
@@ -74,15 +85,41 @@ int settings_nvs_dst(struct settings_nvs *cf)
 }
 
 #if CONFIG_SETTINGS_NVS_NAME_CACHE
+/* Names are cached by hash, in a window of slots following the slot of
+ * their hash, so looking up a name reads a bounded number of slots.
+ */
+#define SETTINGS_NVS_CACHE_WINDOW MIN(8, CONFIG_SETTINGS_NVS_NAME_CACHE_SIZE)
+
 static void settings_nvs_cache_add(struct settings_nvs *cf, const char *name,
 				   uint16_t name_id)
 {
 	uint16_t name_hash = crc16_ccitt(0xffff, name, strlen(name));
+	int free = -1;
+	int slot;
 
-	cf->cache[cf->cache_next].name_hash = name_hash;
-	cf->cache[cf->cache_next++].name_id = name_id;
+	for (int i = 0; i < SETTINGS_NVS_CACHE_WINDOW; i++) {
+		slot = (name_hash + i) % CONFIG_SETTINGS_NVS_NAME_CACHE_SIZE;
+
+		if (cf->cache[slot].name_id == name_id) {
+			cf->cache[slot].name_hash = name_hash;
+			return;
+		}
 
-	cf->cache_next %= CONFIG_SETTINGS_NVS_NAME_CACHE_SIZE;
+		if ((free < 0) && (cf->cache[slot].name_id <= NVS_NAMECNT_ID)) {
+			free = slot;
+		}
+	}
+
+	if (free < 0) {
+		/* Replace the entries of the window in turn */
+		free = (name_hash + cf->cache_next++ % SETTINGS_NVS_CACHE_WINDOW) %
+		       CONFIG_SETTINGS_NVS_NAME_CACHE_SIZE;
+		cf->cache_complete = false;
+		cf->cache_evicted = true;
+	}
+
+	cf->cache[free].name_hash = name_hash;
+	cf->cache[free].name_id = name_id;
 }
 
 static uint16_t settings_nvs_cache_match(struct settings_nvs *cf, const char *name,
@@ -90,17 +127,20 @@ static uint16_t settings_nvs_cache_match(struct settings_nvs *cf, const char *na
 {
 	uint16_t name_hash = crc16_ccitt(0xffff, name, strlen(name));
 	int rc;
+	int slot;
+
+	for (int i = 0; i < SETTINGS_NVS_CACHE_WINDOW; i++) {
+		slot = (name_hash + i) % CONFIG_SETTINGS_NVS_NAME_CACHE_SIZE;
 
-	for (int i = 0; i < CONFIG_SETTINGS_NVS_NAME_CACHE_SIZE; i++) {
-		if (cf->cache[i].name_hash != name_hash) {
+		if (cf->cache[slot].name_hash != name_hash) {
 			continue;
 		}
 
-		if (cf->cache[i].name_id <= NVS_NAMECNT_ID) {
+		if (cf->cache[slot].name_id <= NVS_NAMECNT_ID) {
 			continue;
 		}
 
-		rc = nvs_read(&cf->cf_nvs, cf->cache[i].name_id, rdname, len);
+		rc = nvs_read(&cf->cf_nvs, cf->cache[slot].name_id, rdname, len);
 		if (rc < 0) {
 			continue;
 		}
@@ -111,13 +151,48 @@ static uint16_t settings_nvs_cache_match(struct settings_nvs *cf, const char *na
 			continue;
 		}
 
-		return cf->cache[i].name_id;
+		return cf->cache[slot].name_id;
 	}
 
 	return NVS_NAMECNT_ID;
 }
 #endif /* CONFIG_SETTINGS_NVS_NAME_CACHE */
 
+static int settings_nvs_load_found(struct nvs_fs *fs,
+				   const struct nvs_entry *entry,
+				   void *user_data)
+{
+	struct settings_nvs_load_batch *batch = user_data;
+
+	ARG_UNUSED(fs);
+
+	if (entry->id >= batch->first + NVS_NAME_ID_OFFSET) {
+		batch->value[entry->id - batch->first - NVS_NAME_ID_OFFSET] = *entry;
+	} else {
+		batch->name[entry->id - batch->first] = *entry;
+	}
+
+	return 0;
+}
+
+/* Find the names and values of count settings from first, in one scan */
+static int settings_nvs_load_scan(struct settings_nvs *cf, uint16_t first,
+				  uint16_t count)
+{
+	uint32_t seen[2][NVS_ID_RANGE_SEEN_WORDS(CONFIG_SETTINGS_NVS_LOAD_BATCH)];
+	const struct nvs_id_range ranges[] = {
+		{ .first = first, .count = count, .seen = seen[0] },
+		{ .first = first + NVS_NAME_ID_OFFSET, .count = count,
+		  .seen = seen[1] },
+	};
+
+	(void)memset(&load_batch, 0, sizeof(load_batch));
+	load_batch.first = first;
+
+	return nvs_foreach(&cf->cf_nvs, ranges, ARRAY_SIZE(ranges),
+			   settings_nvs_load_found, &load_batch);
+}
+
 static int settings_nvs_load(struct settings_store *cs,
 			     const struct settings_load_arg *arg)
 {
@@ -125,64 +200,95 @@ static int settings_nvs_load(struct settings_store *cs,
 	struct settings_nvs *cf = (struct settings_nvs *)cs;
 	struct settings_nvs_read_fn_arg read_fn_arg;
 	char name[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
-	char buf;
-	ssize_t rc1, rc2;
-	uint16_t name_id = NVS_NAMECNT_ID;
+	const struct nvs_entry *name_entry, *value_entry;
+	ssize_t rc1;
+	uint32_t ate_wra;
+	uint16_t name_id, first, end;
 
-	name_id = cf->last_name_id + 1;
+	/* Settings are loaded from the highest name id down, in batches of
+	 * ids looked up in a single scan. Writing to NVS, from a handler or
+	 * to clean up, invalidates the batch which is then scanned again.
+	 */
+	end = cf->last_name_id + 1;
 
-	while (1) {
+#if CONFIG_SETTINGS_NVS_NAME_CACHE
+	cf->cache_evicted = false;
+#endif
 
-		name_id--;
-		if (name_id == NVS_NAMECNT_ID) {
-			break;
+	while (end > NVS_NAMECNT_ID + 1) {
+		first = MAX(end - CONFIG_SETTINGS_NVS_LOAD_BATCH,
+			    NVS_NAMECNT_ID + 1);
+
+		ret = settings_nvs_load_scan(cf, first, end - first);
+		if (ret) {
+			return ret;
 		}
 
-		/* In the NVS backend, each setting item is stored in two NVS
-		 * entries one for the setting's name and one with the
-		 * setting's value.
-		 */
-		rc1 = nvs_read(&cf->cf_nvs, name_id, &name, sizeof(name));
-		rc2 = nvs_read(&cf->cf_nvs, name_id + NVS_NAME_ID_OFFSET,
-			       &buf, sizeof(buf));
+		ate_wra = cf->cf_nvs.ate_wra;
 
-		if ((rc1 <= 0) && (rc2 <= 0)) {
-			continue;
-		}
+		while ((end > first) && (ate_wra == cf->cf_nvs.ate_wra)) {
+			name_id = --end;
 
-		if ((rc1 <= 0) || (rc2 <= 0)) {
-			/* Settings item is not stored correctly in the NVS.
-			 * NVS entry for its name or value is either missing
-			 * or deleted. Clean dirty entries to make space for
-			 * future settings item.
+			/* In the NVS backend, each setting item is stored in
+			 * two NVS entries one for the setting's name and one
+			 * with the setting's value.
 			 */
-			if (name_id == cf->last_name_id) {
-				cf->last_name_id--;
-				nvs_write(&cf->cf_nvs, NVS_NAMECNT_ID,
-					  &cf->last_name_id, sizeof(uint16_t));
+			name_entry = &load_batch.name[name_id - first];
+			value_entry = &load_batch.value[name_id - first];
+
+			if ((name_entry->len == 0) && (value_entry->len == 0)) {
+				continue;
 			}
-			nvs_delete(&cf->cf_nvs, name_id);
-			nvs_delete(&cf->cf_nvs, name_id + NVS_NAME_ID_OFFSET);
-			continue;
-		}
 
-		/* Found a name, this might not include a trailing \0 */
-		name[rc1] = '\0';
-		read_fn_arg.fs = &cf->cf_nvs;
-		read_fn_arg.id = name_id + NVS_NAME_ID_OFFSET;
+			rc1 = 0;
+			if (name_entry->len) {
+				rc1 = nvs_entry_read(&cf->cf_nvs, name_entry,
+						     &name, sizeof(name) - 1);
+			}
+
+			if ((rc1 <= 0) || (value_entry->len == 0)) {
+				/* Settings item is not stored correctly in the
+				 * NVS. NVS entry for its name or value is
+				 * either missing or deleted. Clean dirty
+				 * entries to make space for future settings
+				 * item.
+				 */
+				if (name_id == cf->last_name_id) {
+					cf->last_name_id--;
+					nvs_write(&cf->cf_nvs, NVS_NAMECNT_ID,
+						  &cf->last_name_id,
+						  sizeof(uint16_t));
+				}
+				nvs_delete(&cf->cf_nvs, name_id);
+				nvs_delete(&cf->cf_nvs,
+					   name_id + NVS_NAME_ID_OFFSET);
+				continue;
+			}
+
+			/* Found a name, this might not include a trailing \0 */
+			name[MIN(rc1, sizeof(name) - 1)] = '\0';
+			read_fn_arg.fs = &cf->cf_nvs;
+			read_fn_arg.entry = value_entry;
 
 #if CONFIG_SETTINGS_NVS_NAME_CACHE
-		settings_nvs_cache_add(cf, name, name_id);
+			settings_nvs_cache_add(cf, name, name_id);
 #endif
 
-		ret = settings_call_set_handler(
-			name, rc2,
-			settings_nvs_read_fn, &read_fn_arg,
-			(void *)arg);
-		if (ret) {
-			break;
+			ret = settings_call_set_handler(
+				name, value_entry->len,
+				settings_nvs_read_fn, &read_fn_arg,
+				(void *)arg);
+			if (ret) {
+				return ret;
+			}
 		}
 	}
+
+#if CONFIG_SETTINGS_NVS_NAME_CACHE
+	/* All names were seen, a name not in the cache is not stored */
+	cf->cache_complete = !cf->cache_evicted;
+#endif
+
 	return ret;
 }
 
@@ -209,6 +315,16 @@ static int settings_nvs_save(struct settings_store *cs, const char *name,
 		write_name = false;
 		goto found;
 	}
+
+	/* Not stored, take a new name id without searching the stored names.
+	 * Once all ids were used, search for one freed by a delete.
+	 */
+	if (cf->cache_complete &&
+	    (cf->last_name_id + 1 < NVS_NAMECNT_ID + NVS_NAME_ID_OFFSET)) {
+		write_name_id = cf->last_name_id + 1;
+		write_name = true;
+		goto found;
+	}
 #endif
 
 	name_id = cf->last_name_id + 1;
@@ -298,6 +414,9 @@ found:
 		if (rc < 0) {
 			return rc;
 		}
+#if CONFIG_SETTINGS_NVS_NAME_CACHE
+		settings_nvs_cache_add(cf, name, write_name_id);
+#endif
 	}
 
 	/* update the last_name_id and write to flash if required*/
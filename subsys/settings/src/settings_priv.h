@@ -121,6 +121,23 @@ void settings_line_io_init(int (*read_cb)(void *ctx, off_t off, char *buf,
 			  uint8_t io_rwbs);
 
 
+#ifdef CONFIG_SETTINGS_WRITE_CACHE
+/* Name of the item holding a transaction being written */
+#define SETTINGS_TXN_JOURNAL "settings_txn"
+
+/* Cache an item to write, called with the settings lock held */
+int settings_cache_save(struct settings_store *cs, const char *name,
+			const void *value, size_t val_len);
+
+/* Write the pending items, unless within a transaction. Called with the
+ * settings lock held.
+ */
+int settings_cache_sync(void);
+
+/* Complete a transaction interrupted while it was written */
+int settings_cache_recover(void);
+#endif
+
 extern sys_slist_t settings_load_srcs;
 extern sys_slist_t settings_handlers;
 extern struct settings_store *settings_save_dst;
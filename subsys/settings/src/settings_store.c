@@ -54,6 +54,10 @@ int settings_load_subtree(const char *subtree)
 	 *    commit all
 	 */
 	k_mutex_lock(&settings_lock, K_FOREVER);
+#ifdef CONFIG_SETTINGS_WRITE_CACHE
+	/* Load the values of pending writes */
+	(void)settings_cache_sync();
+#endif
 	SYS_SLIST_FOR_EACH_CONTAINER(&settings_load_srcs, cs, cs_next) {
 		cs->cs_itf->csi_load(cs, &arg);
 	}
@@ -81,6 +85,10 @@ int settings_load_subtree_direct(
 	 *    commit all
 	 */
 	k_mutex_lock(&settings_lock, K_FOREVER);
+#ifdef CONFIG_SETTINGS_WRITE_CACHE
+	/* Load the values of pending writes */
+	(void)settings_cache_sync();
+#endif
 	SYS_SLIST_FOR_EACH_CONTAINER(&settings_load_srcs, cs, cs_next) {
 		cs->cs_itf->csi_load(cs, &arg);
 	}
@@ -103,7 +111,11 @@ int settings_save_one(const char *name, const void *value, size_t val_len)
 
 	k_mutex_lock(&settings_lock, K_FOREVER);
 
+#ifdef CONFIG_SETTINGS_WRITE_CACHE
+	rc = settings_cache_save(cs, name, value, val_len);
+#else
 	rc = cs->cs_itf->csi_save(cs, name, (char *)value, val_len);
+#endif
 
 	k_mutex_unlock(&settings_lock);
 
@@ -152,12 +164,26 @@ int settings_save(void)
 	}
 #endif /* CONFIG_SETTINGS_DYNAMIC_HANDLERS */
 
+#ifdef CONFIG_SETTINGS_WRITE_CACHE
+	rc2 = settings_sync();
+	if (!rc) {
+		rc = rc2;
+	}
+#endif
+
 	if (cs->cs_itf->csi_save_end) {
 		cs->cs_itf->csi_save_end(cs);
 	}
 	return rc;
 }
 
+#ifndef CONFIG_SETTINGS_WRITE_CACHE
+int settings_sync(void)
+{
+	return 0;
+}
+#endif
+
 int settings_storage_get(void **storage)
 {
 	struct settings_store *cs = settings_save_dst;
@@ -162,6 +162,131 @@ static void uart_callback(const struct device *dev, void *user_data)
 }
 #endif /* CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN */
 
+#ifdef CONFIG_SHELL_BACKEND_SERIAL_ASYNC
+static void async_tx_start(const struct shell_uart *sh_uart)
+{
+	struct shell_uart_ctrl_blk *ctrl_blk = sh_uart->ctrl_blk;
+	uint8_t *data;
+	uint32_t len;
+	int err;
+
+	do {
+		len = ring_buf_get_claim(sh_uart->tx_ringbuf, &data,
+					 sh_uart->tx_ringbuf->size);
+		if (len > 0) {
+			err = uart_tx(ctrl_blk->dev, data, len, SYS_FOREVER_US);
+			if (err == 0) {
+				return;
+			}
+
+			/* Drop the data rather than stalling the shell. */
+			LOG_ERR("TX failed (%d)", err);
+			(void)ring_buf_get_finish(sh_uart->tx_ringbuf, len);
+		}
+
+		atomic_clear(&ctrl_blk->tx_busy);
+
+		/* Data may have been added after the claim above, in which
+		 * case the writer saw the transmitter busy.
+		 */
+	} while (!ring_buf_is_empty(sh_uart->tx_ringbuf) &&
+		 atomic_cas(&ctrl_blk->tx_busy, 0, 1));
+}
+
+static void async_rx_put(const struct shell_uart *sh_uart, uint8_t *data,
+			 size_t len)
+{
+#ifdef CONFIG_MCUMGR_SMP_SHELL
+	size_t smp_len = smp_shell_rx_bytes(&sh_uart->ctrl_blk->smp, data, len);
+
+	data += smp_len;
+	len -= smp_len;
+#endif /* CONFIG_MCUMGR_SMP_SHELL */
+
+	if (ring_buf_put(sh_uart->rx_ringbuf, data, len) < len) {
+		LOG_WRN("RX ring buffer full.");
+	}
+}
+
+static void async_rx_enable(const struct shell_uart *sh_uart)
+{
+	struct shell_uart_ctrl_blk *ctrl_blk = sh_uart->ctrl_blk;
+	int err;
+
+	ctrl_blk->rx_buf_idx = 0;
+	err = uart_rx_enable(ctrl_blk->dev, ctrl_blk->rx_bufs[0],
+			     sizeof(ctrl_blk->rx_bufs[0]),
+			     CONFIG_SHELL_BACKEND_SERIAL_ASYNC_RX_TIMEOUT);
+	if (err != 0) {
+		LOG_ERR("RX enable failed (%d)", err);
+	}
+}
+
+static void async_callback(const struct device *dev, struct uart_event *evt,
+			   void *user_data)
+{
+	const struct shell_uart *sh_uart = (struct shell_uart *)user_data;
+	struct shell_uart_ctrl_blk *ctrl_blk = sh_uart->ctrl_blk;
+
+	switch (evt->type) {
+	case UART_TX_DONE:
+	case UART_TX_ABORTED:
+		(void)ring_buf_get_finish(sh_uart->tx_ringbuf, evt->data.tx.len);
+		if (ctrl_blk->blocking_tx) {
+			/* Transfer aborted when switching to blocking mode. */
+			atomic_clear(&ctrl_blk->tx_busy);
+		} else {
+			async_tx_start(sh_uart);
+		}
+		ctrl_blk->handler(SHELL_TRANSPORT_EVT_TX_RDY, ctrl_blk->context);
+		break;
+
+	case UART_RX_RDY:
+		async_rx_put(sh_uart, evt->data.rx.buf + evt->data.rx.offset,
+			     evt->data.rx.len);
+		ctrl_blk->handler(SHELL_TRANSPORT_EVT_RX_RDY, ctrl_blk->context);
+		break;
+
+	case UART_RX_BUF_REQUEST:
+		ctrl_blk->rx_buf_idx ^= 1;
+		(void)uart_rx_buf_rsp(dev, ctrl_blk->rx_bufs[ctrl_blk->rx_buf_idx],
+				      sizeof(ctrl_blk->rx_bufs[0]));
+		break;
+
+	case UART_RX_DISABLED:
+		/* Reception stops on line errors, restart it. */
+		if (!ctrl_blk->rx_stopped) {
+			async_rx_enable(sh_uart);
+		}
+		break;
+
+	default:
+		break;
+	}
+}
+#endif /* CONFIG_SHELL_BACKEND_SERIAL_ASYNC */
+
+static void uart_async_init(const struct shell_uart *sh_uart)
+{
+#ifdef CONFIG_SHELL_BACKEND_SERIAL_ASYNC
+	const struct device *dev = sh_uart->ctrl_blk->dev;
+	int err;
+
+	ring_buf_reset(sh_uart->tx_ringbuf);
+	ring_buf_reset(sh_uart->rx_ringbuf);
+	sh_uart->ctrl_blk->tx_busy = 0;
+	sh_uart->ctrl_blk->rx_stopped = false;
+
+	err = uart_callback_set(dev, async_callback, (void *)sh_uart);
+	if (err != 0) {
+		LOG_ERR("Async API not supported (%d)", err);
+		return;
+	}
+
+	async_rx_enable(sh_uart);
+#endif
+}
+
 static void uart_irq_init(const struct shell_uart *sh_uart)
 {
 #ifdef CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN
@@ -206,7 +331,9 @@ static int init(const struct shell_transport *transport,
 	k_fifo_init(&sh_uart->ctrl_blk->smp.buf_ready);
 #endif
 
-	if (IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN)) {
+	if (IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_ASYNC)) {
+		uart_async_init(sh_uart);
+	} else if (IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN)) {
 		uart_irq_init(sh_uart);
 	} else {
 		k_timer_init(sh_uart->timer, timer_handler, NULL);
@@ -221,7 +348,15 @@ static int uninit(const struct shell_transport *transport)
 {
 	const struct shell_uart *sh_uart = (struct shell_uart *)transport->ctx;
 
-	if (IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN)) {
+	if (IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_ASYNC)) {
+#ifdef CONFIG_SHELL_BACKEND_SERIAL_ASYNC
+		const struct device *dev = sh_uart->ctrl_blk->dev;
+
+		sh_uart->ctrl_blk->rx_stopped = true;
+		(void)uart_rx_disable(dev);
+		(void)uart_tx_abort(dev);
+#endif
+	} else if (IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN)) {
 		const struct device *dev = sh_uart->ctrl_blk->dev;
 
 		uart_irq_tx_disable(dev);
@@ -242,6 +377,9 @@ static int enable(const struct shell_transport *transport, bool blocking_tx)
 	if (blocking_tx) {
 #ifdef CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN
 		uart_irq_tx_disable(sh_uart->ctrl_blk->dev);
+#endif
+#ifdef CONFIG_SHELL_BACKEND_SERIAL_ASYNC
+		(void)uart_tx_abort(sh_uart->ctrl_blk->dev);
 #endif
 	}
 
@@ -260,6 +398,18 @@ static void irq_write(const struct shell_uart *sh_uart, const void *data,
 	}
 }
 
+#ifdef CONFIG_SHELL_BACKEND_SERIAL_ASYNC
+static void async_write(const struct shell_uart *sh_uart, const void *data,
+			size_t length, size_t *cnt)
+{
+	*cnt = ring_buf_put(sh_uart->tx_ringbuf, data, length);
+
+	if (atomic_cas(&sh_uart->ctrl_blk->tx_busy, 0, 1)) {
+		async_tx_start(sh_uart);
+	}
+}
+#endif /* CONFIG_SHELL_BACKEND_SERIAL_ASYNC */
+
 static int write(const struct shell_transport *transport,
 		 const void *data, size_t length, size_t *cnt)
 {
@@ -269,6 +419,10 @@ static int write(const struct shell_transport *transport,
 	if (IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN) &&
 		!sh_uart->ctrl_blk->blocking_tx) {
 		irq_write(sh_uart, data, length, cnt);
+#ifdef CONFIG_SHELL_BACKEND_SERIAL_ASYNC
+	} else if (!sh_uart->ctrl_blk->blocking_tx) {
+		async_write(sh_uart, data, length, cnt);
+#endif
 	} else {
 		for (size_t i = 0; i < length; i++) {
 			uart_poll_out(sh_uart->ctrl_blk->dev, data8[i]);
@@ -288,6 +288,74 @@ static int cmd_kernel_log_level_set(const struct shell *sh,
 }
 #endif
 
+#if defined(CONFIG_LOCK_STATS)
+static void shell_lock_stats(enum k_lock_stats_type type, const void *obj,
+			     const char *name, const struct k_lock_stats *stats,
+			     void *user_data)
+{
+	static const char * const type_str[] = { "mutex", "sem", "spin" };
+	const struct shell *shell = (const struct shell *)user_data;
+
+	if (stats->acquisitions == 0U && stats->timeouts == 0U) {
+		return;
+	}
+
+	shell_print(shell, "%-5s %-16s %p %10u %10u %8u %10u %10u %10u",
+		    type_str[type], name ? name : "", obj,
+		    stats->acquisitions, stats->contended, stats->timeouts,
+		    stats->contended ?
+			(uint32_t)(stats->wait_total / stats->contended) : 0U,
+		    stats->wait_max, stats->hold_max);
+
+#if CONFIG_LOCK_STATS_TOP_WAITERS > 0
+	for (int i = 0; i < CONFIG_LOCK_STATS_TOP_WAITERS; i++) {
+		const struct k_lock_waiter_stats *w = &stats->waiters[i];
+		const char *tname;
+
+		if (w->thread == NULL) {
+			break;
+		}
+
+		tname = k_thread_name_get((k_tid_t)w->thread);
+		shell_print(shell, "      waiter %p %-16s %10u %10llu", w->thread,
+			    tname ? tname : "", w->count,
+			    (unsigned long long)w->wait_total);
+	}
+#endif
+}
+
+static int cmd_kernel_locks(const struct shell *shell,
+			    size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	shell_print(shell, "Cycles @ %u Hz", sys_clock_hw_cycles_per_sec());
+	shell_print(shell, "%-5s %-16s %-10s %10s %10s %8s %10s %10s %10s",
+		    "type", "name", "object", "acquired", "contended",
+		    "timeouts", "avg wait", "max wait", "max hold");
+	k_lock_stats_foreach(shell_lock_stats, (void *)shell);
+
+	return 0;
+}
+
+static int cmd_kernel_locks_reset(const struct shell *shell,
+				  size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	k_lock_stats_reset();
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel_locks,
+	SHELL_CMD(reset, NULL, "Clear lock statistics.", cmd_kernel_locks_reset),
+	SHELL_SUBCMD_SET_END /* Array terminated. */
+);
+#endif
+
 #if defined(CONFIG_REBOOT)
 static int cmd_kernel_reboot_warm(const struct shell *shell,
 				  size_t argc, char **argv)
@@ -322,6 +390,10 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel_reboot,
 
 SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel,
 	SHELL_CMD(cycles, NULL, "Kernel cycles.", cmd_kernel_cycles),
+#if defined(CONFIG_LOCK_STATS)
+	SHELL_CMD(locks, &sub_kernel_locks, "Lock contention statistics.",
+		  cmd_kernel_locks),
+#endif
 #if defined(CONFIG_REBOOT)
 	SHELL_CMD(reboot, &sub_kernel_reboot, "Reboot.", NULL),
 #endif
@@ -551,6 +551,7 @@ static int exec_cmd(const struct shell *shell, size_t argc, const char **argv,
 #endif
 
 		z_flag_cmd_ctx_set(shell, true);
+		z_shell_output_batch_set(shell, true);
 		/* Unlock thread mutex in case command would like to borrow
 		 * shell context to other thread to avoid mutex deadlock.
 		 */
@@ -559,6 +560,7 @@ static int exec_cmd(const struct shell *shell, size_t argc, const char **argv,
 							 (char **)argv);
 		/* Bring back mutex to shell thread. */
 		k_mutex_lock(&shell->ctx->wr_mtx, K_FOREVER);
+		z_shell_output_batch_set(shell, false);
 		z_flag_cmd_ctx_set(shell, false);
 	}
 
@@ -1498,14 +1500,18 @@ void shell_vfprintf(const struct shell *sh, enum shell_vt100_color color,
 	}
 
 	k_mutex_lock(&sh->ctx->wr_mtx, K_FOREVER);
-	if (!z_flag_cmd_ctx_get(sh) && !sh->ctx->bypass) {
+	if (!z_flag_cmd_ctx_get(sh) && !sh->ctx->bypass &&
+	    z_shell_vt100_active(sh)) {
 		z_shell_cmd_line_erase(sh);
 	}
 	z_shell_vfprintf(sh, color, fmt, args);
-	if (!z_flag_cmd_ctx_get(sh) && !sh->ctx->bypass) {
+	if (!z_flag_cmd_ctx_get(sh) && !sh->ctx->bypass &&
+	    z_shell_vt100_active(sh)) {
 		z_shell_print_prompt_and_cmd(sh);
 	}
-	z_transport_buffer_flush(sh);
+	if (!z_shell_output_batch_get(sh)) {
+		z_transport_buffer_flush(sh);
+	}
 	k_mutex_unlock(&sh->ctx->wr_mtx);
 }
 
@@ -1656,6 +1662,15 @@ int shell_use_colors_set(const struct shell *shell, bool val)
 	return (int)z_flag_use_colors_set(shell, val);
 }
 
+int shell_use_vt100_set(const struct shell *shell, bool val)
+{
+	if (shell == NULL) {
+		return -EINVAL;
+	}
+
+	return (int)z_flag_use_vt100_set(shell, val);
+}
+
 int shell_echo_set(const struct shell *shell, bool val)
 {
 	if (shell == NULL) {
@@ -24,6 +24,11 @@
 #define SHELL_HELP_COLORS		"Toggle colored syntax."
 #define SHELL_HELP_COLORS_OFF		"Disable colored syntax."
 #define SHELL_HELP_COLORS_ON		"Enable colored syntax."
+#define SHELL_HELP_VT100		"Toggle VT100 commands."
+#define SHELL_HELP_VT100_OFF		\
+	"Disable VT100 commands for a non-interactive terminal. The command " \
+	"line is not redrawn around asynchronous output."
+#define SHELL_HELP_VT100_ON		"Enable VT100 commands."
 #define SHELL_HELP_STATISTICS		"Shell statistics."
 #define SHELL_HELP_STATISTICS_SHOW	\
 	"Get shell statistics for the Logger module."
@@ -260,6 +265,26 @@ static int cmd_colors_on(const struct shell *shell, size_t argc, char **argv)
 	return 0;
 }
 
+static int cmd_vt100_off(const struct shell *shell, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	z_flag_use_vt100_set(shell, false);
+
+	return 0;
+}
+
+static int cmd_vt100_on(const struct shell *shell, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	z_flag_use_vt100_set(shell, true);
+
+	return 0;
+}
+
 static int cmd_echo_off(const struct shell *shell, size_t argc, char **argv)
 {
 	ARG_UNUSED(argc);
@@ -415,6 +440,14 @@ SHELL_STATIC_SUBCMD_SET_CREATE(m_sub_colors,
 	SHELL_SUBCMD_SET_END
 );
 
+SHELL_STATIC_SUBCMD_SET_CREATE(m_sub_vt100,
+	SHELL_COND_CMD_ARG(CONFIG_SHELL_VT100_COMMANDS, off, NULL,
+			   SHELL_HELP_VT100_OFF, cmd_vt100_off, 1, 0),
+	SHELL_COND_CMD_ARG(CONFIG_SHELL_VT100_COMMANDS, on, NULL,
+			   SHELL_HELP_VT100_ON, cmd_vt100_on, 1, 0),
+	SHELL_SUBCMD_SET_END
+);
+
 SHELL_STATIC_SUBCMD_SET_CREATE(m_sub_echo,
 	SHELL_CMD_ARG(off, NULL, SHELL_HELP_ECHO_OFF, cmd_echo_off, 1, 0),
 	SHELL_CMD_ARG(on, NULL, SHELL_HELP_ECHO_ON, cmd_echo_on, 1, 0),
@@ -446,6 +479,8 @@ SHELL_STATIC_SUBCMD_SET_CREATE(m_sub_shell,
 	SHELL_CMD_ARG(echo, &m_sub_echo, SHELL_HELP_ECHO, cmd_echo, 1, 1),
 	SHELL_COND_CMD(CONFIG_SHELL_STATS, stats, &m_sub_shell_stats,
 			SHELL_HELP_STATISTICS, NULL),
+	SHELL_COND_CMD(CONFIG_SHELL_VT100_COMMANDS, vt100, &m_sub_vt100,
+		       SHELL_HELP_VT100, NULL),
 	SHELL_SUBCMD_SET_END
 );
 
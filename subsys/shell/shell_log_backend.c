@@ -176,6 +176,10 @@ static void process_log_msg(const struct shell *sh,
 			key = irq_lock();
 		} else {
 			k_mutex_lock(&sh->ctx->wr_mtx, K_FOREVER);
+			/* Keep the order with batched command output. */
+			if (z_shell_output_batch_get(sh)) {
+				z_shell_fprintf_buffer_flush(sh->fprintf_ctx);
+			}
 		}
 		if (!z_flag_cmd_ctx_get(sh)) {
 			z_shell_cmd_line_erase(sh);
@@ -185,7 +189,7 @@ static void process_log_msg(const struct shell *sh,
 	log_output_msg_process(log_output, &msg->log, flags);
 
 	if (locked) {
-		if (!z_flag_cmd_ctx_get(sh)) {
+		if (!z_flag_cmd_ctx_get(sh) && z_shell_vt100_active(sh)) {
 			z_shell_print_prompt_and_cmd(sh);
 		}
 		if (k_is_in_isr()) {
@@ -68,6 +68,10 @@ void z_shell_op_cursor_position_synchronize(const struct shell *shell)
 	struct shell_multiline_cons *cons = &shell->ctx->vt100_ctx.cons;
 	bool last_line;
 
+	if (!z_shell_vt100_active(shell)) {
+		return;
+	}
+
 	z_shell_multiline_data_calc(cons, shell->ctx->cmd_buff_pos,
 				    shell->ctx->cmd_buff_len);
 	last_line = (cons->cur_y == cons->cur_y_end);
@@ -96,6 +100,11 @@ void z_shell_op_cursor_move(const struct shell *shell, int16_t val)
 	int32_t row_span;
 	int32_t col_span;
 
+	if (!z_shell_vt100_active(shell)) {
+		shell->ctx->cmd_buff_pos = new_pos;
+		return;
+	}
+
 	z_shell_multiline_data_calc(cons, shell->ctx->cmd_buff_pos,
 				    shell->ctx->cmd_buff_len);
 
@@ -350,6 +359,10 @@ void z_shell_op_completion_insert(const struct shell *shell,
 
 void z_shell_cmd_line_erase(const struct shell *shell)
 {
+	if (!z_shell_vt100_active(shell)) {
+		return;
+	}
+
 	z_shell_multiline_data_calc(&shell->ctx->vt100_ctx.cons,
 				    shell->ctx->cmd_buff_pos,
 				    shell->ctx->cmd_buff_len);
@@ -89,6 +89,36 @@ static inline bool z_flag_use_vt100_set(const struct shell *sh, bool val)
 	return ret;
 }
 
+/* Returns true if cursor movement and line redraw commands are sent, that is
+ * when the terminal on the other side is interactive.
+ */
+static inline bool z_shell_vt100_active(const struct shell *sh)
+{
+	return IS_ENABLED(CONFIG_SHELL_VT100_COMMANDS) &&
+	       z_flag_use_vt100_get(sh);
+}
+
+/* While batching, output is passed to the transport only when the print
+ * buffer is full or batching ends.
+ */
+static inline void z_shell_output_batch_set(const struct shell *sh, bool val)
+{
+	if (!IS_ENABLED(CONFIG_SHELL_PRINTF_BATCH)) {
+		return;
+	}
+
+	sh->fprintf_ctx->ctrl_blk->autoflush = !val;
+	if (!val) {
+		z_shell_fprintf_buffer_flush(sh->fprintf_ctx);
+	}
+}
+
+static inline bool z_shell_output_batch_get(const struct shell *sh)
+{
+	return IS_ENABLED(CONFIG_SHELL_PRINTF_BATCH) &&
+	       !sh->fprintf_ctx->ctrl_blk->autoflush;
+}
+
 static inline bool z_flag_echo_get(const struct shell *sh)
 {
 	return sh->ctx->cfg.flags.echo == 1;
@@ -82,6 +82,19 @@ int flash_area_erase(const struct flash_area *fa, off_t off, size_t len)
 	return flash_erase(fa->fa_dev, fa->fa_off + off, len);
 }
 
+#ifdef CONFIG_FLASH_ASYNC
+int flash_area_submit(const struct flash_area *fa, struct flash_async_req *req)
+{
+	if (!is_in_flash_area_bounds(fa, req->offset, req->len)) {
+		return -EINVAL;
+	}
+
+	req->offset += fa->fa_off;
+
+	return flash_submit(fa->fa_dev, req);
+}
+#endif /* CONFIG_FLASH_ASYNC */
+
 uint32_t flash_area_align(const struct flash_area *fa)
 {
 	return flash_get_write_block_size(fa->fa_dev);
@@ -104,10 +104,135 @@ int stream_flash_erase_page(struct stream_flash_ctx *ctx, off_t off)
 
 #endif /* CONFIG_STREAM_FLASH_ERASE */
 
+/* Read back the data written from buf and pass it to the callback */
+static int flash_verify(struct stream_flash_ctx *ctx, uint8_t *buf, size_t len,
+			size_t write_addr)
+{
+	int rc;
+
+	/* Invert to ensure that caller is able to discover a faulty
+	 * flash_read() even if no error code is returned.
+	 */
+	for (int i = 0; i < len; i++) {
+		buf[i] = ~buf[i];
+	}
+
+	rc = flash_read(ctx->fdev, write_addr, buf, len);
+	if (rc != 0) {
+		LOG_ERR("flash read failed: %d", rc);
+		return rc;
+	}
+
+	rc = ctx->callback(buf, len, write_addr);
+	if (rc != 0) {
+		LOG_ERR("callback failed: %d", rc);
+	}
+
+	return rc;
+}
+
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+
+static void flash_write_done(const struct device *dev,
+			     struct flash_async_req *req, int result)
+{
+	struct stream_flash_ctx *ctx =
+		CONTAINER_OF(req, struct stream_flash_ctx, write_req);
+
+	ARG_UNUSED(dev);
+
+	if ((result != 0) && (ctx->result == 0)) {
+		ctx->result = result;
+	}
+
+	k_sem_give(&ctx->write_done);
+}
+
+#ifdef CONFIG_STREAM_FLASH_ERASE
+static void flash_erase_done(const struct device *dev,
+			     struct flash_async_req *req, int result)
+{
+	struct stream_flash_ctx *ctx =
+		CONTAINER_OF(req, struct stream_flash_ctx, erase_req);
+
+	ARG_UNUSED(dev);
+
+	if ((result != 0) && (ctx->result == 0)) {
+		ctx->result = result;
+	}
+}
+
+/* Queue the erase of the page to which off belongs, if not already done.
+ * The write queued next is executed once the erase completed.
+ */
+static int flash_erase_page_async(struct stream_flash_ctx *ctx, off_t off)
+{
+	int rc;
+	struct flash_pages_info page;
+
+	rc = flash_get_page_info_by_offs(ctx->fdev, off, &page);
+	if (rc != 0) {
+		LOG_ERR("Error %d while getting page info", rc);
+		return rc;
+	}
+
+	if (ctx->last_erased_page_start_offset == page.start_offset) {
+		return 0;
+	}
+
+	LOG_DBG("Erasing page at offset 0x%08lx", (long)page.start_offset);
+
+	rc = flash_erase_async(ctx->fdev, &ctx->erase_req, page.start_offset,
+			       page.size, flash_erase_done);
+	if (rc != 0) {
+		LOG_ERR("Error %d while erasing page", rc);
+	} else {
+		ctx->last_erased_page_start_offset = page.start_offset;
+	}
+
+	return rc;
+}
+#endif /* CONFIG_STREAM_FLASH_ERASE */
+
+/* Wait for the pending write, if any, and account for its data */
+static int flash_wait(struct stream_flash_ctx *ctx)
+{
+	size_t write_addr = ctx->offset + ctx->bytes_written;
+	int rc;
+
+	if (ctx->pending_bytes == 0) {
+		return 0;
+	}
+
+	(void)k_sem_take(&ctx->write_done, K_FOREVER);
+
+	rc = ctx->result;
+	ctx->result = 0;
+
+	if (rc != 0) {
+		LOG_ERR("flash write error %d offset=0x%08zx", rc, write_addr);
+#ifdef CONFIG_STREAM_FLASH_ERASE
+		ctx->last_erased_page_start_offset = -1;
+#endif
+	} else if (ctx->callback) {
+		rc = flash_verify(ctx, ctx->buf_alt, ctx->pending_bytes,
+				  write_addr);
+	}
+
+	if (rc == 0) {
+		ctx->bytes_written += ctx->pending_bytes;
+	}
+	ctx->pending_bytes = 0U;
+
+	return rc;
+}
+
+#endif /* CONFIG_STREAM_FLASH_ASYNC */
+
 static int flash_sync(struct stream_flash_ctx *ctx)
 {
 	int rc = 0;
-	size_t write_addr = ctx->offset + ctx->bytes_written;
+	size_t write_addr;
 	size_t buf_bytes_aligned;
 	size_t fill_length;
 	uint8_t filler;
@@ -117,16 +242,28 @@ static int flash_sync(struct stream_flash_ctx *ctx)
 		return 0;
 	}
 
-	if (IS_ENABLED(CONFIG_STREAM_FLASH_ERASE)) {
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	/* The other half of the buffer is about to be filled */
+	rc = flash_wait(ctx);
+	if (rc != 0) {
+		return rc;
+	}
+#endif
+
+	write_addr = ctx->offset + ctx->bytes_written;
 
-		rc = stream_flash_erase_page(ctx,
-					     write_addr + ctx->buf_bytes - 1);
-		if (rc < 0) {
-			LOG_ERR("stream_flash_erase_page err %d offset=0x%08zx",
-				rc, write_addr);
-			return rc;
-		}
+#ifdef CONFIG_STREAM_FLASH_ERASE
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	rc = flash_erase_page_async(ctx, write_addr + ctx->buf_bytes - 1);
+#else
+	rc = stream_flash_erase_page(ctx, write_addr + ctx->buf_bytes - 1);
+#endif
+	if (rc < 0) {
+		LOG_ERR("stream_flash_erase_page err %d offset=0x%08zx",
+			rc, write_addr);
+		return rc;
 	}
+#endif /* CONFIG_STREAM_FLASH_ERASE */
 
 	fill_length = flash_get_write_block_size(ctx->fdev);
 	if (ctx->buf_bytes % fill_length) {
@@ -139,32 +276,36 @@ static int flash_sync(struct stream_flash_ctx *ctx)
 	}
 
 	buf_bytes_aligned = ctx->buf_bytes + fill_length;
-	rc = flash_write(ctx->fdev, write_addr, ctx->buf, buf_bytes_aligned);
 
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	rc = flash_write_async(ctx->fdev, &ctx->write_req, write_addr, ctx->buf,
+			       buf_bytes_aligned, flash_write_done);
 	if (rc != 0) {
 		LOG_ERR("flash_write error %d offset=0x%08zx", rc,
 			write_addr);
 		return rc;
 	}
 
-	if (ctx->callback) {
-		/* Invert to ensure that caller is able to discover a faulty
-		 * flash_read() even if no error code is returned.
-		 */
-		for (int i = 0; i < ctx->buf_bytes; i++) {
-			ctx->buf[i] = ~ctx->buf[i];
-		}
+	/* Fill the other half while this one is written */
+	ctx->pending_bytes = ctx->buf_bytes;
+	ctx->buf_alt = ctx->buf;
+	ctx->buf = (ctx->buf == ctx->buf_base) ? ctx->buf_base + ctx->buf_len :
+						 ctx->buf_base;
+	ctx->buf_bytes = 0U;
 
-		rc = flash_read(ctx->fdev, write_addr, ctx->buf,
-				ctx->buf_bytes);
-		if (rc != 0) {
-			LOG_ERR("flash read failed: %d", rc);
-			return rc;
-		}
+	return 0;
+#else
+	rc = flash_write(ctx->fdev, write_addr, ctx->buf, buf_bytes_aligned);
 
-		rc = ctx->callback(ctx->buf, ctx->buf_bytes, write_addr);
+	if (rc != 0) {
+		LOG_ERR("flash_write error %d offset=0x%08zx", rc,
+			write_addr);
+		return rc;
+	}
+
+	if (ctx->callback) {
+		rc = flash_verify(ctx, ctx->buf, ctx->buf_bytes, write_addr);
 		if (rc != 0) {
-			LOG_ERR("callback failed: %d", rc);
 			return rc;
 		}
 	}
@@ -173,6 +314,7 @@ static int flash_sync(struct stream_flash_ctx *ctx)
 	ctx->buf_bytes = 0U;
 
 	return rc;
+#endif /* CONFIG_STREAM_FLASH_ASYNC */
 }
 
 int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *data,
@@ -181,12 +323,18 @@ int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *dat
 	int processed = 0;
 	int rc = 0;
 	int buf_empty_bytes;
+	size_t queued;
 
 	if (!ctx) {
 		return -EFAULT;
 	}
 
-	if (ctx->bytes_written + ctx->buf_bytes + len > ctx->available) {
+	queued = ctx->bytes_written + ctx->buf_bytes;
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	queued += ctx->pending_bytes;
+#endif
+
+	if (queued + len > ctx->available) {
 		return -ENOMEM;
 	}
 
@@ -216,6 +364,12 @@ int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *dat
 		rc = flash_sync(ctx);
 	}
 
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	if (flush && rc == 0) {
+		rc = flash_wait(ctx);
+	}
+#endif
+
 	return rc;
 }
 
@@ -272,6 +426,12 @@ int stream_flash_init(struct stream_flash_ctx *ctx, const struct device *fdev,
 		return -EFAULT;
 	}
 
+	if (IS_ENABLED(CONFIG_STREAM_FLASH_ASYNC) &&
+	    ((buf_len / 2) % flash_get_write_block_size(fdev))) {
+		LOG_ERR("Buffer halves are not aligned to minimal write-block-size");
+		return -EFAULT;
+	}
+
 	/* Calculate the total size of the flash device */
 	flash_page_foreach(fdev, find_flash_total_size, &inspect_flash_ctx);
 
@@ -300,6 +460,15 @@ int stream_flash_init(struct stream_flash_ctx *ctx, const struct device *fdev,
 	ctx->last_erased_page_start_offset = -1;
 #endif
 
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	ctx->buf_len = buf_len / 2;
+	ctx->buf_base = buf;
+	ctx->buf_alt = buf + ctx->buf_len;
+	ctx->pending_bytes = 0U;
+	ctx->result = 0;
+	k_sem_init(&ctx->write_done, 0, 1);
+#endif
+
 	return 0;
 }
 
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/benchmark.h>
+#include <stdlib.h>
+
+void benchmark_init(struct benchmark *bench, const char *name,
+		    uint64_t *samples, uint32_t capacity)
+{
+	bench->name = name;
+	bench->samples = samples;
+	bench->capacity = capacity;
+	benchmark_reset(bench);
+}
+
+void benchmark_reset(struct benchmark *bench)
+{
+	bench->count = 0U;
+	bench->dropped = 0U;
+}
+
+void benchmark_sample_add(struct benchmark *bench, uint64_t cycles)
+{
+	if (bench->count < bench->capacity) {
+		bench->samples[bench->count++] = cycles;
+	} else {
+		bench->dropped++;
+	}
+}
+
+void benchmark_run(struct benchmark *bench, benchmark_fn_t fn, void *arg,
+		   uint32_t warmup, uint32_t reps)
+{
+	timing_t start, end;
+
+	timing_init();
+	timing_start();
+
+	for (uint32_t i = 0; i < warmup; i++) {
+		fn(arg);
+	}
+
+	for (uint32_t i = 0; i < reps; i++) {
+		start = timing_counter_get();
+		fn(arg);
+		end = timing_counter_get();
+		benchmark_sample_add(bench, timing_cycles_get(&start, &end));
+	}
+
+	timing_stop();
+}
+
+static int sample_cmp(const void *a, const void *b)
+{
+	uint64_t x = *(const uint64_t *)a;
+	uint64_t y = *(const uint64_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+/* Nearest-rank percentile of sorted samples */
+static uint64_t percentile(const struct benchmark *bench, uint32_t pct)
+{
+	uint32_t rank = ceiling_fraction(bench->count * pct, 100U);
+
+	return bench->samples[MAX(rank, 1U) - 1U];
+}
+
+int benchmark_stats_get(struct benchmark *bench, struct benchmark_stats *stats)
+{
+	uint64_t sum = 0U;
+
+	if (bench->count == 0U) {
+		return -ENODATA;
+	}
+
+	qsort(bench->samples, bench->count, sizeof(bench->samples[0]), sample_cmp);
+
+	for (uint32_t i = 0; i < bench->count; i++) {
+		sum += bench->samples[i];
+	}
+
+	stats->samples = bench->count;
+	stats->min = bench->samples[0];
+	stats->max = bench->samples[bench->count - 1U];
+	stats->median = percentile(bench, 50U);
+	stats->p99 = percentile(bench, 99U);
+	stats->mean = sum / bench->count;
+
+	return 0;
+}
+
+static void report(const char *name, const char *unit,
+		   const struct benchmark_stats *stats)
+{
+	printk("BENCH name=\"%s\" unit=%s samples=%u min=%llu median=%llu "
+	       "p99=%llu max=%llu mean=%llu\n", name, unit, stats->samples,
+	       (unsigned long long)stats->min, (unsigned long long)stats->median,
+	       (unsigned long long)stats->p99, (unsigned long long)stats->max,
+	       (unsigned long long)stats->mean);
+}
+
+void benchmark_report(struct benchmark *bench)
+{
+	struct benchmark_stats stats;
+
+	if (benchmark_stats_get(bench, &stats) != 0) {
+		printk("BENCH name=\"%s\" no samples\n", bench->name);
+		return;
+	}
+
+	if (bench->dropped != 0U) {
+		printk("%s: %u samples dropped\n", bench->name, bench->dropped);
+	}
+
+	report(bench->name, "cycles", &stats);
+}
+
+void benchmark_report_value(const char *name, const char *unit, uint64_t value)
+{
+	struct benchmark_stats stats = {
+		.samples = 1U,
+		.min = value,
+		.median = value,
+		.p99 = value,
+		.max = value,
+		.mean = value,
+	};
+
+	report(name, unit, &stats);
+}
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_TESTSUITE_INCLUDE_BENCHMARK_H_
+#define ZEPHYR_TESTSUITE_INCLUDE_BENCHMARK_H_
+
+#include <stdint.h>
+#include <zephyr/timing/timing.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Benchmark helpers
+ * @defgroup benchmark_apis Benchmark helpers
+ * @ingroup all_tests
+ *
+ * Collect per-repetition timings of an operation, measured with the
+ * timing functions, and report their distribution as a single line:
+ *
+ * @code
+ * BENCH name="<name>" unit=<unit> samples=<n> min=<v> median=<v> p99=<v> max=<v> mean=<v>
+ * @endcode
+ *
+ * These lines are parsed by twister (see the "record" harness option)
+ * and compared against a stored baseline by
+ * scripts/benchmarks/bench_baseline.py.
+ * @{
+ */
+
+/** Distribution of the samples of a benchmark */
+struct benchmark_stats {
+	/** Number of samples. */
+	uint32_t samples;
+	/** Fastest sample. */
+	uint64_t min;
+	/** Median sample. */
+	uint64_t median;
+	/** 99th percentile. */
+	uint64_t p99;
+	/** Slowest sample. */
+	uint64_t max;
+	/** Arithmetic mean. */
+	uint64_t mean;
+};
+
+/** Benchmark sample collector */
+struct benchmark {
+	/** Name used in reports. */
+	const char *name;
+	/** Sample storage. */
+	uint64_t *samples;
+	/** Number of entries in @a samples. */
+	uint32_t capacity;
+	/** Number of samples collected. */
+	uint32_t count;
+	/** Samples not stored because the buffer was full. */
+	uint32_t dropped;
+};
+
+/**
+ * @brief Statically define a benchmark with its sample storage
+ *
+ * @param _var Name of the benchmark variable.
+ * @param _name Name used in reports.
+ * @param _capacity Maximum number of samples kept.
+ */
+#define BENCHMARK_DEFINE(_var, _name, _capacity)			\
+	static uint64_t _var##_samples[_capacity];			\
+	static struct benchmark _var = {				\
+		.name = _name,						\
+		.samples = _var##_samples,				\
+		.capacity = _capacity,					\
+	}
+
+/** Operation measured by benchmark_run() */
+typedef void (*benchmark_fn_t)(void *arg);
+
+/**
+ * @brief Initialize a benchmark at runtime
+ *
+ * @param bench Benchmark.
+ * @param name Name used in reports.
+ * @param samples Sample storage.
+ * @param capacity Number of entries in @p samples.
+ */
+void benchmark_init(struct benchmark *bench, const char *name,
+		    uint64_t *samples, uint32_t capacity);
+
+/**
+ * @brief Discard all samples of a benchmark
+ *
+ * @param bench Benchmark.
+ */
+void benchmark_reset(struct benchmark *bench);
+
+/**
+ * @brief Add one sample, in timing cycles
+ *
+ * Samples beyond the capacity are counted as dropped.
+ *
+ * @param bench Benchmark.
+ * @param cycles Measured duration.
+ */
+void benchmark_sample_add(struct benchmark *bench, uint64_t cycles);
+
+/**
+ * @brief Time repetitions of an operation
+ *
+ * Calls @p fn @p warmup times without measuring it, to settle caches
+ * and lazy initialization, then @p reps times recording the duration
+ * of each call.
+ *
+ * @param bench Benchmark.
+ * @param fn Operation to measure.
+ * @param arg Argument passed to @p fn.
+ * @param warmup Number of unmeasured calls.
+ * @param reps Number of measured calls.
+ */
+void benchmark_run(struct benchmark *bench, benchmark_fn_t fn, void *arg,
+		   uint32_t warmup, uint32_t reps);
+
+/**
+ * @brief Compute the distribution of the samples
+ *
+ * Sorts the samples in place.
+ *
+ * @param bench Benchmark.
+ * @param stats Filled with the distribution.
+ *
+ * @retval 0 on success.
+ * @retval -ENODATA if no sample was collected.
+ */
+int benchmark_stats_get(struct benchmark *bench, struct benchmark_stats *stats);
+
+/**
+ * @brief Print the distribution of the samples, in timing cycles
+ *
+ * @param bench Benchmark.
+ */
+void benchmark_report(struct benchmark *bench);
+
+/**
+ * @brief Print a single measurement computed by the caller
+ *
+ * For suites averaging their own loops: the value is reported as a
+ * distribution of one sample.
+ *
+ * @param name Name used in reports.
+ * @param unit Unit of @p value, for instance "cycles" or "ns".
+ * @param value Measurement.
+ */
+void benchmark_report_value(const char *name, const char *unit, uint64_t value);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_TESTSUITE_INCLUDE_BENCHMARK_H_ */
@@ -25,8 +25,20 @@
 
 #define TICK_SYNCH()  k_sleep(K_TICKS(1))
 
+#ifdef CONFIG_TEST_BENCHMARK
+#include <zephyr/timing/timing.h>
+
+/* Measure with the timing functions, as all benchmark helpers do */
+#define OS_GET_TIME() ((uint32_t)timing_counter_get())
+
+#define TIME_STAMP_TO_NS_AVG(t, count) \
+	((uint32_t)timing_cycles_to_ns_avg(t, count))
+#else
 #define OS_GET_TIME() k_cycle_get_32()
 
+#define TIME_STAMP_TO_NS_AVG(t, count) SYS_CLOCK_HW_CYCLES_TO_NS_AVG(t, count)
+#endif
+
 /* time necessary to read the time */
 extern uint32_t tm_off;
 
@@ -52,6 +64,11 @@ static inline uint32_t TIME_STAMP_DELTA_GET(uint32_t ts)
  */
 static inline void bench_test_init(void)
 {
+#ifdef CONFIG_TEST_BENCHMARK
+	timing_init();
+	timing_start();
+#endif
+
 	uint32_t t = OS_GET_TIME();
 
 	tm_off = OS_GET_TIME() - t;
@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _TRACE_ISR_STATS_H
+#define _TRACE_ISR_STATS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Record ISR entry, called from sys_trace_isr_enter().
+ */
+void isr_stats_enter(void);
+
+/**
+ * @brief Record ISR exit, called from sys_trace_isr_exit().
+ */
+void isr_stats_exit(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,263 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/tracing/isr_stats.h>
+#include <tracing_isr_stats.h>
+#include <string.h>
+#include <errno.h>
+
+#if defined(CONFIG_ARCH_POSIX)
+#include <zephyr/arch/posix/posix_soc_if.h>
+#endif
+
+#ifdef CONFIG_TRACING_ISR_STATS_SHELL
+#include <zephyr/shell/shell.h>
+#include <stdlib.h>
+#endif
+
+/* Line 0 collects ISR_STATS_IRQ_OTHER, line n + 1 is IRQ n */
+#define NUM_LINES (ISR_STATS_NUM_IRQS + 1)
+
+struct isr_frame {
+	uint16_t line;
+	uint32_t start;
+};
+
+struct isr_cpu {
+	uint32_t depth;
+	struct isr_frame frames[CONFIG_TRACING_ISR_STATS_MAX_NESTING];
+};
+
+static struct isr_stats lines[NUM_LINES];
+static uint32_t last_enter[NUM_LINES];
+static struct isr_cpu cpus[CONFIG_MP_MAX_NUM_CPUS];
+static struct k_spinlock lock;
+
+static inline int current_irq(void)
+{
+#if defined(CONFIG_CPU_CORTEX_M)
+	uint32_t ipsr;
+
+	/* External interrupts start at exception number 16 */
+	__asm__ volatile("mrs %0, ipsr" : "=r"(ipsr));
+	return (int)(ipsr & 0x1ffU) - 16;
+#elif defined(CONFIG_ARCH_POSIX)
+	return posix_get_current_irq();
+#else
+	return ISR_STATS_IRQ_OTHER;
+#endif
+}
+
+static inline uint16_t irq_to_line(int irq)
+{
+	if (irq < 0 || irq >= ISR_STATS_NUM_IRQS) {
+		return 0;
+	}
+
+	return irq + 1;
+}
+
+static inline unsigned int bucket_of(uint32_t cycles)
+{
+	unsigned int bucket;
+
+	bucket = (cycles == 0U) ? 0U : (32U - __builtin_clz(cycles));
+
+	return MIN(bucket, CONFIG_TRACING_ISR_STATS_BUCKETS - 1);
+}
+
+void isr_stats_enter(void)
+{
+	uint32_t now = k_cycle_get_32();
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	struct isr_cpu *cpu = &cpus[_current_cpu->id];
+	uint16_t line = irq_to_line(current_irq());
+	struct isr_stats *st = &lines[line];
+
+	if (st->count != 0U) {
+		uint32_t delta = now - last_enter[line];
+
+		st->interarrival_hist[bucket_of(delta)]++;
+		st->interarrival_max = MAX(st->interarrival_max, delta);
+		st->interarrival_min = MIN(st->interarrival_min, delta);
+	}
+	last_enter[line] = now;
+	st->count++;
+
+	/* Too deep nesting only loses the duration of the innermost ISRs */
+	if (cpu->depth < CONFIG_TRACING_ISR_STATS_MAX_NESTING) {
+		cpu->frames[cpu->depth].line = line;
+		cpu->frames[cpu->depth].start = now;
+	}
+	cpu->depth++;
+
+	k_spin_unlock(&lock, key);
+}
+
+void isr_stats_exit(void)
+{
+	uint32_t now = k_cycle_get_32();
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	struct isr_cpu *cpu = &cpus[_current_cpu->id];
+
+	if (cpu->depth == 0U) {
+		/* Exit without entry, statistics were enabled mid-ISR */
+		k_spin_unlock(&lock, key);
+		return;
+	}
+
+	cpu->depth--;
+
+	if (cpu->depth < CONFIG_TRACING_ISR_STATS_MAX_NESTING) {
+		struct isr_frame *frame = &cpu->frames[cpu->depth];
+		struct isr_stats *st = &lines[frame->line];
+		uint32_t duration = now - frame->start;
+
+		st->duration_hist[bucket_of(duration)]++;
+		st->duration_total += duration;
+		st->duration_max = MAX(st->duration_max, duration);
+	}
+
+	k_spin_unlock(&lock, key);
+}
+
+int isr_stats_get(int irq, struct isr_stats *stats)
+{
+	k_spinlock_key_t key;
+
+	if (irq < ISR_STATS_IRQ_OTHER || irq >= ISR_STATS_NUM_IRQS) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&lock);
+	*stats = lines[irq_to_line(irq)];
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+static void lines_reset(void)
+{
+	memset(lines, 0, sizeof(lines));
+
+	for (size_t i = 0; i < ARRAY_SIZE(lines); i++) {
+		lines[i].interarrival_min = UINT32_MAX;
+	}
+}
+
+void isr_stats_reset(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	/* In-flight ISRs keep their nesting frames so their exit still
+	 * balances, only the accumulated values are cleared.
+	 */
+	lines_reset();
+
+	k_spin_unlock(&lock, key);
+}
+
+static int isr_stats_init(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	isr_stats_reset();
+
+	return 0;
+}
+
+SYS_INIT(isr_stats_init, PRE_KERNEL_1, 0);
+
+#ifdef CONFIG_TRACING_ISR_STATS_SHELL
+
+static void print_hist(const struct shell *sh, const char *title,
+		       const uint32_t *hist)
+{
+	shell_print(sh, "  %s:", title);
+
+	for (unsigned int i = 0; i < CONFIG_TRACING_ISR_STATS_BUCKETS; i++) {
+		if (hist[i] == 0U) {
+			continue;
+		}
+
+		shell_print(sh, "    >= %10u: %u", isr_stats_bucket_min(i), hist[i]);
+	}
+}
+
+static void print_line(const struct shell *sh, int irq, bool verbose)
+{
+	struct isr_stats st;
+
+	if (isr_stats_get(irq, &st) != 0 || st.count == 0U) {
+		return;
+	}
+
+	if (irq == ISR_STATS_IRQ_OTHER) {
+		shell_fprintf(sh, SHELL_NORMAL, "%8s", "other");
+	} else {
+		shell_fprintf(sh, SHELL_NORMAL, "%8d", irq);
+	}
+
+	shell_print(sh, " %10u %10u %10u %10u %10u", st.count,
+		    (uint32_t)(st.duration_total / st.count), st.duration_max,
+		    (st.count > 1U) ? st.interarrival_min : 0U,
+		    st.interarrival_max);
+
+	if (verbose) {
+		print_hist(sh, "duration", st.duration_hist);
+		print_hist(sh, "inter-arrival", st.interarrival_hist);
+	}
+}
+
+static int cmd_isr_stats_show(const struct shell *sh, size_t argc, char **argv)
+{
+	int irq = ISR_STATS_IRQ_OTHER - 1;
+
+	if (argc > 1) {
+		irq = strtol(argv[1], NULL, 10);
+		if (irq < ISR_STATS_IRQ_OTHER || irq >= ISR_STATS_NUM_IRQS) {
+			shell_error(sh, "Invalid IRQ %d", irq);
+			return -EINVAL;
+		}
+	}
+
+	shell_print(sh, "Cycles @ %u Hz", sys_clock_hw_cycles_per_sec());
+	shell_print(sh, "%8s %10s %10s %10s %10s %10s", "IRQ", "count",
+		    "avg dur", "max dur", "min gap", "max gap");
+
+	if (irq >= ISR_STATS_IRQ_OTHER) {
+		print_line(sh, irq, true);
+		return 0;
+	}
+
+	for (irq = ISR_STATS_IRQ_OTHER; irq < ISR_STATS_NUM_IRQS; irq++) {
+		print_line(sh, irq, false);
+	}
+
+	return 0;
+}
+
+static int cmd_isr_stats_reset(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	isr_stats_reset();
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_isr_stats,
+	SHELL_CMD_ARG(show, NULL, "[irq] Print ISR statistics.", cmd_isr_stats_show, 1, 1),
+	SHELL_CMD(reset, NULL, "Clear ISR statistics.", cmd_isr_stats_reset),
+	SHELL_SUBCMD_SET_END /* Array terminated. */
+);
+
+SHELL_CMD_REGISTER(isr_stats, &sub_isr_stats, "ISR latency statistics", NULL);
+
+#endif /* CONFIG_TRACING_ISR_STATS_SHELL */
@@ -4,10 +4,16 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
-#include <zephyr/sys/ring_buffer.h>
+#include <zephyr/sys/lf_ring.h>
 
-static struct ring_buf tracing_ring_buf;
-static uint8_t tracing_buffer[CONFIG_TRACING_BUFFER_SIZE + 1];
+/*
+ * Producers are serialized by TRACING_LOCK(), and a single thread consumes,
+ * so the consumer never takes the lock.
+ */
+#define TRACING_RING_SIZE (1U << LOG2CEIL(CONFIG_TRACING_BUFFER_SIZE))
+
+static struct lf_ring tracing_ring;
+static uint8_t tracing_buffer[TRACING_RING_SIZE];
 static uint8_t tracing_cmd_buffer[CONFIG_TRACING_CMD_BUFFER_SIZE];
 
 uint32_t tracing_cmd_buffer_alloc(uint8_t **data)
@@ -19,51 +25,51 @@ uint32_t tracing_cmd_buffer_alloc(uint8_t **data)
 
 uint32_t tracing_buffer_put_claim(uint8_t **data, uint32_t size)
 {
-	return ring_buf_put_claim(&tracing_ring_buf, data, size);
+	return lf_ring_put_claim(&tracing_ring, data, size);
 }
 
 int tracing_buffer_put_finish(uint32_t size)
 {
-	return ring_buf_put_finish(&tracing_ring_buf, size);
+	return lf_ring_put_finish(&tracing_ring, size);
 }
 
 uint32_t tracing_buffer_put(uint8_t *data, uint32_t size)
 {
-	return ring_buf_put(&tracing_ring_buf, data, size);
+	return lf_ring_put(&tracing_ring, data, size);
 }
 
 uint32_t tracing_buffer_get_claim(uint8_t **data, uint32_t size)
 {
-	return ring_buf_get_claim(&tracing_ring_buf, data, size);
+	return lf_ring_get_claim(&tracing_ring, data, size);
 }
 
 int tracing_buffer_get_finish(uint32_t size)
 {
-	return ring_buf_get_finish(&tracing_ring_buf, size);
+	return lf_ring_get_finish(&tracing_ring, size);
 }
 
 uint32_t tracing_buffer_get(uint8_t *data, uint32_t size)
 {
-	return ring_buf_get(&tracing_ring_buf, data, size);
+	return lf_ring_get(&tracing_ring, data, size);
 }
 
 void tracing_buffer_init(void)
 {
-	ring_buf_init(&tracing_ring_buf,
-		      sizeof(tracing_buffer), tracing_buffer);
+	lf_ring_init(&tracing_ring, tracing_buffer, sizeof(tracing_buffer),
+		     LF_RING_SPSC);
 }
 
 bool tracing_buffer_is_empty(void)
 {
-	return ring_buf_is_empty(&tracing_ring_buf);
+	return lf_ring_is_empty(&tracing_ring);
 }
 
 uint32_t tracing_buffer_capacity_get(void)
 {
-	return ring_buf_capacity_get(&tracing_ring_buf);
+	return lf_ring_capacity_get(&tracing_ring);
 }
 
 uint32_t tracing_buffer_space_get(void)
 {
-	return ring_buf_space_get(&tracing_ring_buf);
+	return lf_ring_space_get(&tracing_ring);
 }
@@ -8,9 +8,23 @@
 #include <string.h>
 #include <zephyr/kernel.h>
 
+#ifdef CONFIG_TRACING_ISR_STATS
+#include <tracing_isr_stats.h>
+
+void sys_trace_isr_enter(void)
+{
+	isr_stats_enter();
+}
+
+void sys_trace_isr_exit(void)
+{
+	isr_stats_exit();
+}
+#else
 void sys_trace_isr_enter(void) {}
 
 void sys_trace_isr_exit(void) {}
+#endif
 
 void sys_trace_isr_exit_to_scheduler(void) {}
 
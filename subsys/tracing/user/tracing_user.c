@@ -9,6 +9,9 @@
 #include <kernel_internal.h>
 #include <zephyr/kernel_structs.h>
 #include <ksched.h>
+#ifdef CONFIG_TRACING_ISR_STATS
+#include <tracing_isr_stats.h>
+#endif
 
 static int nested_interrupts[CONFIG_MP_MAX_NUM_CPUS];
 
@@ -108,6 +111,10 @@ void sys_trace_isr_enter(void)
 	sys_trace_isr_enter_user(nested_interrupts[curr_cpu->id]);
 	nested_interrupts[curr_cpu->id]++;
 
+#ifdef CONFIG_TRACING_ISR_STATS
+	isr_stats_enter();
+#endif
+
 	irq_unlock(key);
 }
 
@@ -116,6 +123,10 @@ void sys_trace_isr_exit(void)
 	unsigned int key = irq_lock();
 	_cpu_t *curr_cpu = _current_cpu;
 
+#ifdef CONFIG_TRACING_ISR_STATS
+	isr_stats_exit();
+#endif
+
 	nested_interrupts[curr_cpu->id]--;
 	sys_trace_isr_exit_user(nested_interrupts[curr_cpu->id]);
 
@@ -16,6 +16,103 @@ k_timeout_t _zbus_timeout_remainder(uint64_t end_ticks)
 	return K_TICKS((k_ticks_t)MAX(end_ticks - now_ticks, 0));
 }
 
+#if defined(CONFIG_ZBUS_MSG_LOAN)
+static inline struct zbus_loan_hdr *_zbus_loan_hdr(const void *msg)
+{
+	return (struct zbus_loan_hdr *)msg - 1;
+}
+#endif /* CONFIG_ZBUS_MSG_LOAN */
+
+#if defined(CONFIG_ZBUS_ASYNC_DISPATCH_STATS)
+static struct zbus_dispatch_stats _zbus_dispatch_stats;
+static struct k_spinlock _zbus_dispatch_stats_lock;
+
+static void _zbus_dispatch_stat_inc(uint32_t *counter)
+{
+	k_spinlock_key_t key = k_spin_lock(&_zbus_dispatch_stats_lock);
+
+	(*counter)++;
+
+	k_spin_unlock(&_zbus_dispatch_stats_lock, key);
+}
+
+#define _ZBUS_DISPATCH_STAT_INC(_field) _zbus_dispatch_stat_inc(&_zbus_dispatch_stats._field)
+#else
+#define _ZBUS_DISPATCH_STAT_INC(_field)
+#endif /* CONFIG_ZBUS_ASYNC_DISPATCH_STATS */
+
+static int _zbus_queue_put(const struct zbus_observer *obs, const void *item, uint64_t end_ticks)
+{
+#if defined(CONFIG_ZBUS_ASYNC_DISPATCH)
+	union {
+		const struct zbus_channel *chan;
+#if defined(CONFIG_ZBUS_MSG_LOAN)
+		struct zbus_msg_ref ref;
+#endif /* CONFIG_ZBUS_MSG_LOAN */
+	} oldest;
+	int err;
+
+	/* The dispatcher never waits for a subscriber */
+	err = k_msgq_put(obs->queue, item, K_NO_WAIT);
+	if ((err != -ENOMSG) || (obs->overflow != ZBUS_OVERFLOW_DROP_OLDEST)) {
+		return err;
+	}
+
+	if (k_msgq_get(obs->queue, &oldest, K_NO_WAIT) == 0) {
+#if defined(CONFIG_ZBUS_MSG_LOAN)
+		if (obs->msg_ref) {
+			zbus_chan_release(oldest.ref.chan, oldest.ref.msg);
+		}
+#endif /* CONFIG_ZBUS_MSG_LOAN */
+		_ZBUS_DISPATCH_STAT_INC(overwritten);
+	}
+
+	return k_msgq_put(obs->queue, item, K_NO_WAIT);
+#else
+	return k_msgq_put(obs->queue, item, _zbus_timeout_remainder(end_ticks));
+#endif /* CONFIG_ZBUS_ASYNC_DISPATCH */
+}
+
+static int _zbus_notify_subscriber(const struct zbus_channel *chan,
+				   const struct zbus_observer *obs, uint64_t end_ticks)
+{
+	const void *item = &chan;
+	int err;
+
+#if defined(CONFIG_ZBUS_MSG_LOAN)
+	struct zbus_msg_ref ref = {.chan = chan, .msg = NULL};
+
+	if (obs->msg_ref) {
+		/* The subscriber gets its own reference to the message */
+		if ((chan->loan != NULL) && (chan->loan->current != NULL)) {
+			ref.msg = chan->loan->current;
+			atomic_inc(&_zbus_loan_hdr(ref.msg)->refs);
+		}
+		item = &ref;
+	}
+#endif /* CONFIG_ZBUS_MSG_LOAN */
+
+	err = _zbus_queue_put(obs, item, end_ticks);
+
+#if defined(CONFIG_ZBUS_MSG_LOAN)
+	if (err) {
+		zbus_chan_release(chan, ref.msg);
+	}
+#endif /* CONFIG_ZBUS_MSG_LOAN */
+
+#if defined(CONFIG_ZBUS_ASYNC_DISPATCH)
+	/* Dropping is the subscriber's policy, not a failure of the publication */
+	if (err == -ENOMSG) {
+		LOG_DBG("Notification of %s to observer %s dropped", _ZBUS_CHAN_NAME(chan),
+			_ZBUS_OBS_NAME(obs));
+		_ZBUS_DISPATCH_STAT_INC(dropped);
+		err = 0;
+	}
+#endif /* CONFIG_ZBUS_ASYNC_DISPATCH */
+
+	return err;
+}
+
 #if (CONFIG_ZBUS_RUNTIME_OBSERVERS_POOL_SIZE > 0)
 static inline void _zbus_notify_runtime_listeners(const struct zbus_channel *chan)
 {
@@ -46,8 +143,7 @@ static inline int _zbus_notify_runtime_subscribers(const struct zbus_channel *ch
 		__ASSERT(obs_nd != NULL, "observer node is NULL");
 
 		if (obs_nd->obs->enabled && (obs_nd->obs->queue != NULL)) {
-			err = k_msgq_put(obs_nd->obs->queue, &chan,
-					 _zbus_timeout_remainder(end_ticks));
+			err = _zbus_notify_subscriber(chan, obs_nd->obs, end_ticks);
 
 			_ZBUS_ASSERT(err == 0,
 				     "could not deliver notification to observer %s. Error code %d",
@@ -80,7 +176,7 @@ static int _zbus_notify_observers(const struct zbus_channel *chan, uint64_t end_
 	/* Notify static subscribers */
 	for (const struct zbus_observer *const *obs = chan->observers; *obs != NULL; ++obs) {
 		if ((*obs)->enabled && ((*obs)->queue != NULL)) {
-			err = k_msgq_put((*obs)->queue, &chan, _zbus_timeout_remainder(end_ticks));
+			err = _zbus_notify_subscriber(chan, *obs, end_ticks);
 			_ZBUS_ASSERT(err == 0, "could not deliver notification to observer %s.",
 				     _ZBUS_OBS_NAME(*obs));
 			if (err) {
@@ -100,6 +196,163 @@ static int _zbus_notify_observers(const struct zbus_channel *chan, uint64_t end_
 	return last_error;
 }
 
+#if defined(CONFIG_ZBUS_ASYNC_DISPATCH)
+struct zbus_dispatch_event {
+	const struct zbus_channel *chan;
+	/* Cycle count at the publication */
+	uint32_t timestamp;
+};
+
+K_MSGQ_DEFINE(_zbus_dispatch_queue, sizeof(struct zbus_dispatch_event),
+	      CONFIG_ZBUS_ASYNC_DISPATCH_QUEUE_SIZE, sizeof(void *));
+
+static void _zbus_dispatcher(void *p1, void *p2, void *p3)
+{
+	struct zbus_dispatch_event evt;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		k_msgq_get(&_zbus_dispatch_queue, &evt, K_FOREVER);
+
+		/* Listeners access the message under the channel's mutex, as when notified
+		 * by the publisher.
+		 */
+		k_mutex_lock(evt.chan->mutex, K_FOREVER);
+		(void)_zbus_notify_observers(evt.chan, 0);
+		k_mutex_unlock(evt.chan->mutex);
+
+#if defined(CONFIG_ZBUS_ASYNC_DISPATCH_STATS)
+		uint32_t latency = k_cycle_get_32() - evt.timestamp;
+		k_spinlock_key_t key = k_spin_lock(&_zbus_dispatch_stats_lock);
+
+		_zbus_dispatch_stats.events++;
+		_zbus_dispatch_stats.latency_sum += latency;
+		_zbus_dispatch_stats.latency_max = MAX(_zbus_dispatch_stats.latency_max, latency);
+
+		k_spin_unlock(&_zbus_dispatch_stats_lock, key);
+#endif /* CONFIG_ZBUS_ASYNC_DISPATCH_STATS */
+	}
+}
+
+K_THREAD_DEFINE(zbus_dispatcher, CONFIG_ZBUS_ASYNC_DISPATCH_STACK_SIZE, _zbus_dispatcher, NULL,
+		NULL, NULL, CONFIG_ZBUS_ASYNC_DISPATCH_THREAD_PRIORITY, 0, 0);
+
+#if defined(CONFIG_ZBUS_ASYNC_DISPATCH_STATS)
+void zbus_dispatch_stats_get(struct zbus_dispatch_stats *stats)
+{
+	k_spinlock_key_t key = k_spin_lock(&_zbus_dispatch_stats_lock);
+
+	*stats = _zbus_dispatch_stats;
+
+	k_spin_unlock(&_zbus_dispatch_stats_lock, key);
+}
+
+void zbus_dispatch_stats_reset(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&_zbus_dispatch_stats_lock);
+
+	memset(&_zbus_dispatch_stats, 0, sizeof(_zbus_dispatch_stats));
+
+	k_spin_unlock(&_zbus_dispatch_stats_lock, key);
+}
+#endif /* CONFIG_ZBUS_ASYNC_DISPATCH_STATS */
+#endif /* CONFIG_ZBUS_ASYNC_DISPATCH */
+
+/* Notifies the observers of a channel locked by the caller, or queues their notification for
+ * the dispatcher, and unlocks the channel.
+ */
+static int _zbus_notify_and_unlock(const struct zbus_channel *chan, uint64_t end_ticks)
+{
+	int err;
+
+#if defined(CONFIG_ZBUS_ASYNC_DISPATCH)
+	struct zbus_dispatch_event evt = {.chan = chan, .timestamp = k_cycle_get_32()};
+
+	k_mutex_unlock(chan->mutex);
+
+	/* Queued once the channel is unlocked, the dispatcher may be waiting for it. Listeners
+	 * publishing from the dispatcher never wait for room, only the dispatcher makes some.
+	 */
+	err = k_msgq_put(&_zbus_dispatch_queue, &evt,
+			 (k_current_get() == zbus_dispatcher) ? K_NO_WAIT
+							      : _zbus_timeout_remainder(end_ticks));
+	if (err) {
+		LOG_ERR("Channel %s at %p could not be dispatched. Error code %d",
+			_ZBUS_CHAN_NAME(chan), chan, err);
+		_ZBUS_DISPATCH_STAT_INC(rejected);
+	}
+#else
+	err = _zbus_notify_observers(chan, end_ticks);
+
+	k_mutex_unlock(chan->mutex);
+#endif /* CONFIG_ZBUS_ASYNC_DISPATCH */
+
+	return err;
+}
+
+#if defined(CONFIG_ZBUS_LATEST_VALUE_CHANNELS)
+/* Sequence numbers wrap at a multiple of the buffer count, so that consecutive messages always
+ * go to different buffers.
+ */
+#define _ZBUS_LATEST_SEQ_WRAP 0x60000000U
+
+static inline uint8_t *_zbus_latest_buf(const struct zbus_channel *chan, uint32_t seq)
+{
+	struct zbus_chan_latest *latest = chan->latest;
+	uint32_t idx = seq % latest->buf_count;
+
+	if (idx == 0U) {
+		return chan->message;
+	}
+
+	return &latest->bufs[(idx - 1U) * chan->message_size];
+}
+
+static int _zbus_latest_pub(const struct zbus_channel *chan, const void *msg,
+			    k_timeout_t timeout, uint64_t end_ticks)
+{
+	struct zbus_chan_latest *latest = chan->latest;
+	uint32_t seq;
+	int err;
+
+	/* Publishers take turns on the mutex, readers never wait */
+	err = k_mutex_lock(chan->mutex, timeout);
+	if (err) {
+		return err;
+	}
+
+	/* A reader still copying the buffer detects it was overwritten */
+	seq = ((uint32_t)atomic_get(&latest->seq) + 1U) % _ZBUS_LATEST_SEQ_WRAP;
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	memcpy(_zbus_latest_buf(chan, seq), msg, chan->message_size);
+	atomic_set(&latest->seq, seq);
+
+	err = _zbus_notify_and_unlock(chan, end_ticks);
+
+	return err;
+}
+
+static void _zbus_latest_read(const struct zbus_channel *chan, void *msg)
+{
+	struct zbus_chan_latest *latest = chan->latest;
+	uint32_t seq, overwritten;
+
+	/* The buffer of message seq is overwritten by message seq + buf_count, which is only
+	 * written once message seq + buf_count - 1 is published.
+	 */
+	do {
+		seq = (uint32_t)atomic_get(&latest->seq);
+		memcpy(msg, _zbus_latest_buf(chan, seq), chan->message_size);
+		__atomic_thread_fence(__ATOMIC_SEQ_CST);
+		overwritten = ((uint32_t)atomic_get(&latest->seq) + _ZBUS_LATEST_SEQ_WRAP - seq) %
+			      _ZBUS_LATEST_SEQ_WRAP;
+	} while (overwritten > latest->buf_count - 2U);
+}
+#endif /* CONFIG_ZBUS_LATEST_VALUE_CHANNELS */
+
 int zbus_chan_pub(const struct zbus_channel *chan, const void *msg, k_timeout_t timeout)
 {
 	int err;
@@ -113,6 +366,27 @@ int zbus_chan_pub(const struct zbus_channel *chan, const void *msg, k_timeout_t
 		return -ENOMSG;
 	}
 
+#if defined(CONFIG_ZBUS_LATEST_VALUE_CHANNELS)
+	if (chan->latest != NULL) {
+		return _zbus_latest_pub(chan, msg, timeout, end_ticks);
+	}
+#endif /* CONFIG_ZBUS_LATEST_VALUE_CHANNELS */
+
+#if defined(CONFIG_ZBUS_MSG_LOAN)
+	if (chan->loan != NULL) {
+		void *buf;
+
+		err = zbus_chan_loan(chan, &buf, timeout);
+		if (err) {
+			return err;
+		}
+
+		memcpy(buf, msg, chan->message_size);
+
+		return zbus_chan_pub_loan(chan, buf, _zbus_timeout_remainder(end_ticks));
+	}
+#endif /* CONFIG_ZBUS_MSG_LOAN */
+
 	err = k_mutex_lock(chan->mutex, timeout);
 	if (err) {
 		return err;
@@ -120,9 +394,7 @@ int zbus_chan_pub(const struct zbus_channel *chan, const void *msg, k_timeout_t
 
 	memcpy(chan->message, msg, chan->message_size);
 
-	err = _zbus_notify_observers(chan, end_ticks);
-
-	k_mutex_unlock(chan->mutex);
+	err = _zbus_notify_and_unlock(chan, end_ticks);
 
 	return err;
 }
@@ -135,36 +407,164 @@ int zbus_chan_read(const struct zbus_channel *chan, void *msg, k_timeout_t timeo
 	_ZBUS_ASSERT(chan != NULL, "chan is required");
 	_ZBUS_ASSERT(msg != NULL, "msg is required");
 
+#if defined(CONFIG_ZBUS_LATEST_VALUE_CHANNELS)
+	if (chan->latest != NULL) {
+		_zbus_latest_read(chan, msg);
+		return 0;
+	}
+#endif /* CONFIG_ZBUS_LATEST_VALUE_CHANNELS */
+
 	err = k_mutex_lock(chan->mutex, timeout);
 	if (err) {
 		return err;
 	}
 
-	memcpy(msg, chan->message, chan->message_size);
+	memcpy(msg, zbus_chan_const_msg(chan), chan->message_size);
 
 	return k_mutex_unlock(chan->mutex);
 }
 
-int zbus_chan_notify(const struct zbus_channel *chan, k_timeout_t timeout)
+#if defined(CONFIG_ZBUS_MSG_LOAN)
+int zbus_chan_loan(const struct zbus_channel *chan, void **msg, k_timeout_t timeout)
 {
+	struct zbus_loan_hdr *hdr;
 	int err;
+
+	_ZBUS_ASSERT(!k_is_in_isr(), "zbus cannot be used inside ISRs");
+	_ZBUS_ASSERT(chan != NULL, "chan is required");
+	_ZBUS_ASSERT(msg != NULL, "msg is required");
+
+	if (chan->loan == NULL) {
+		return -ENOTSUP;
+	}
+
+	err = k_mem_slab_alloc(chan->loan->slab, (void **)&hdr, timeout);
+	if (err) {
+		return err;
+	}
+
+	atomic_set(&hdr->refs, 1);
+	*msg = hdr + 1;
+
+	return 0;
+}
+
+int zbus_chan_pub_loan(const struct zbus_channel *chan, void *msg, k_timeout_t timeout)
+{
+	int err;
+	void *prev;
 	uint64_t end_ticks = sys_clock_timeout_end_calc(timeout);
 
 	_ZBUS_ASSERT(!k_is_in_isr(), "zbus cannot be used inside ISRs");
 	_ZBUS_ASSERT(chan != NULL, "chan is required");
+	_ZBUS_ASSERT(msg != NULL, "msg is required");
+
+	if (chan->loan == NULL) {
+		return -ENOTSUP;
+	}
+
+	if (chan->validator != NULL && !chan->validator(msg, chan->message_size)) {
+		zbus_chan_release(chan, msg);
+		return -ENOMSG;
+	}
 
 	err = k_mutex_lock(chan->mutex, timeout);
 	if (err) {
+		zbus_chan_release(chan, msg);
 		return err;
 	}
 
-	err = _zbus_notify_observers(chan, end_ticks);
+	/* Only a reference changes hands under the mutex. From here on the message is published,
+	 * even if some observers cannot be notified.
+	 */
+	prev = chan->loan->current;
+	chan->loan->current = msg;
+
+	err = _zbus_notify_and_unlock(chan, end_ticks);
+
+	zbus_chan_release(chan, prev);
+
+	return err;
+}
+
+int zbus_chan_ref(const struct zbus_channel *chan, const void **msg, k_timeout_t timeout)
+{
+	int err;
+
+	_ZBUS_ASSERT(!k_is_in_isr(), "zbus cannot be used inside ISRs");
+	_ZBUS_ASSERT(chan != NULL, "chan is required");
+	_ZBUS_ASSERT(msg != NULL, "msg is required");
+
+	if (chan->loan == NULL) {
+		return -ENOTSUP;
+	}
+
+	err = k_mutex_lock(chan->mutex, timeout);
+	if (err) {
+		return err;
+	}
+
+	if (chan->loan->current == NULL) {
+		err = -ENODATA;
+	} else {
+		atomic_inc(&_zbus_loan_hdr(chan->loan->current)->refs);
+		*msg = chan->loan->current;
+	}
 
 	k_mutex_unlock(chan->mutex);
 
 	return err;
 }
 
+void zbus_chan_release(const struct zbus_channel *chan, const void *msg)
+{
+	struct zbus_loan_hdr *hdr;
+
+	__ASSERT(chan != NULL, "chan is required");
+
+	if ((msg == NULL) || (chan->loan == NULL)) {
+		return;
+	}
+
+	hdr = _zbus_loan_hdr(msg);
+	if (atomic_dec(&hdr->refs) == 1) {
+		k_mem_slab_free(chan->loan->slab, (void **)&hdr);
+	}
+}
+
+int zbus_sub_wait_msg(const struct zbus_observer *sub, struct zbus_msg_ref *ref,
+		      k_timeout_t timeout)
+{
+	_ZBUS_ASSERT(!k_is_in_isr(), "zbus cannot be used inside ISRs");
+	_ZBUS_ASSERT(sub != NULL, "sub is required");
+	_ZBUS_ASSERT(ref != NULL, "ref is required");
+
+	if ((sub->queue == NULL) || !sub->msg_ref) {
+		return -EINVAL;
+	}
+
+	return k_msgq_get(sub->queue, ref, timeout);
+}
+#endif /* CONFIG_ZBUS_MSG_LOAN */
+
+int zbus_chan_notify(const struct zbus_channel *chan, k_timeout_t timeout)
+{
+	int err;
+	uint64_t end_ticks = sys_clock_timeout_end_calc(timeout);
+
+	_ZBUS_ASSERT(!k_is_in_isr(), "zbus cannot be used inside ISRs");
+	_ZBUS_ASSERT(chan != NULL, "chan is required");
+
+	err = k_mutex_lock(chan->mutex, timeout);
+	if (err) {
+		return err;
+	}
+
+	err = _zbus_notify_and_unlock(chan, end_ticks);
+
+	return err;
+}
+
 int zbus_chan_claim(const struct zbus_channel *chan, k_timeout_t timeout)
 {
 	_ZBUS_ASSERT(!k_is_in_isr(), "zbus cannot be used inside ISRs");
@@ -200,5 +600,11 @@ int zbus_sub_wait(const struct zbus_observer *sub, const struct zbus_channel **c
 		return -EINVAL;
 	}
 
+#if defined(CONFIG_ZBUS_MSG_LOAN)
+	if (sub->msg_ref) {
+		return -EINVAL;
+	}
+#endif /* CONFIG_ZBUS_MSG_LOAN */
+
 	return k_msgq_get(sub->queue, chan, timeout);
 }
@@ -27,8 +27,8 @@ void queue_test(void)
 	}
 	et = TIME_STAMP_DELTA_GET(et);
 
-	PRINT_F(output_file, FORMAT, "enqueue 1 byte msg in FIFO",
-			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
+	PRINT_RESULT("enqueue 1 byte msg in FIFO",
+			TIME_STAMP_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
 
 	et = BENCH_START();
 	for (i = 0; i < NR_OF_FIFO_RUNS; i++) {
@@ -37,8 +37,8 @@ void queue_test(void)
 	et = TIME_STAMP_DELTA_GET(et);
 	check_result();
 
-	PRINT_F(output_file, FORMAT, "dequeue 1 byte msg in FIFO",
-			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
+	PRINT_RESULT("dequeue 1 byte msg in FIFO",
+			TIME_STAMP_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
 
 	et = BENCH_START();
 	for (i = 0; i < NR_OF_FIFO_RUNS; i++) {
@@ -47,8 +47,8 @@ void queue_test(void)
 	et = TIME_STAMP_DELTA_GET(et);
 	check_result();
 
-	PRINT_F(output_file, FORMAT, "enqueue 4 bytes msg in FIFO",
-			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
+	PRINT_RESULT("enqueue 4 bytes msg in FIFO",
+			TIME_STAMP_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
 
 	et = BENCH_START();
 	for (i = 0; i < NR_OF_FIFO_RUNS; i++) {
@@ -57,8 +57,8 @@ void queue_test(void)
 	et = TIME_STAMP_DELTA_GET(et);
 	check_result();
 
-	PRINT_F(output_file, FORMAT, "dequeue 4 bytes msg in FIFO",
-			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
+	PRINT_RESULT("dequeue 4 bytes msg in FIFO",
+			TIME_STAMP_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
 
 	k_sem_give(&STARTRCV);
 
@@ -69,9 +69,8 @@ void queue_test(void)
 	et = TIME_STAMP_DELTA_GET(et);
 	check_result();
 
-	PRINT_F(output_file, FORMAT,
-			"enqueue 1 byte msg in FIFO to a waiting higher priority task",
-			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
+	PRINT_RESULT("enqueue 1 byte msg in FIFO to a waiting higher priority task",
+		TIME_STAMP_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
 
 	et = BENCH_START();
 	for (i = 0; i < NR_OF_FIFO_RUNS; i++) {
@@ -80,9 +79,8 @@ void queue_test(void)
 	et = TIME_STAMP_DELTA_GET(et);
 	check_result();
 
-	PRINT_F(output_file, FORMAT,
-			"enqueue 4 bytes in FIFO to a waiting higher priority task",
-			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
+	PRINT_RESULT("enqueue 4 bytes in FIFO to a waiting higher priority task",
+		TIME_STAMP_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
 }
 
 #endif /* FIFO_BENCH */
@@ -140,7 +140,7 @@ void mailbox_put(uint32_t size, int count, uint32_t *time)
 		k_mbox_put(&MAILB1, &message, K_FOREVER);
 	}
 	t = TIME_STAMP_DELTA_GET(t);
-	*time = SYS_CLOCK_HW_CYCLES_TO_NS_AVG(t, count);
+	*time = TIME_STAMP_TO_NS_AVG(t, count);
 	check_result();
 }
 
@@ -93,7 +93,7 @@ void mailbox_get(struct k_mbox *mailbox,
 	}
 
 	t = TIME_STAMP_DELTA_GET(t);
-	*time = SYS_CLOCK_HW_CYCLES_TO_NS_AVG(t, count);
+	*time = TIME_STAMP_TO_NS_AVG(t, count);
 	if (bench_test_end() < 0) {
 		PRINT_OVERFLOW_ERROR();
 	}
@@ -21,6 +21,8 @@
 
 #include <zephyr/sys/util.h>
 
+#include <zephyr/benchmark.h>
+
 
 /* uncomment the define below to use floating point arithmetic */
 /* #define FLOAT */
@@ -167,6 +169,18 @@ extern struct k_mem_slab MAP1;
 	PRINT_STRING(sline, stream);					\
 }
 
+/* PRINT_RESULT
+ * Macro to print a result line of the table, in nanoseconds, and report
+ * it to the benchmark harness.
+ */
+#define PRINT_RESULT(name, ns)						\
+{									\
+	uint32_t _ns = (ns);						\
+									\
+	PRINT_F(output_file, FORMAT, name, _ns);			\
+	benchmark_report_value(name, "ns", _ns);			\
+}
+
 #define PRINT_OVERFLOW_ERROR()						\
 	PRINT_F(output_file, __FILE__":%d Error: tick occurred\n", __LINE__)
 
@@ -29,8 +29,8 @@ void mutex_test(void)
 	et = TIME_STAMP_DELTA_GET(et);
 	check_result();
 
-	PRINT_F(output_file, FORMAT, "average lock and unlock mutex",
-		SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, (2 * NR_OF_MUTEX_RUNS)));
+	PRINT_RESULT("average lock and unlock mutex",
+		TIME_STAMP_TO_NS_AVG(et, (2 * NR_OF_MUTEX_RUNS)));
 }
 
 #endif /* MUTEX_BENCH */
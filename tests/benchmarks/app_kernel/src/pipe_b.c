@@ -236,7 +236,7 @@ int pipeput(struct k_pipe *pipe,
 	}
 
 	t = TIME_STAMP_DELTA_GET(t);
-	*time = SYS_CLOCK_HW_CYCLES_TO_NS_AVG(t, count);
+	*time = TIME_STAMP_TO_NS_AVG(t, count);
 	if (bench_test_end() < 0) {
 		if (high_timer_overflow()) {
 			PRINT_STRING("| Timer overflow."
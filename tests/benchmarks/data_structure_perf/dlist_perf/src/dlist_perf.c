@@ -12,8 +12,12 @@
 
 #include <zephyr/ztest.h>
 #include <zephyr/sys/dlist.h>
+#include <zephyr/benchmark.h>
 
 #define NODE_SIZE 5
+#define BENCH_NODES 512
+#define BENCH_WARMUP 16
+#define BENCH_REPS 256
 
 static sys_dlist_t test_list;
 
@@ -254,4 +258,53 @@ ZTEST(dlist_perf, test_dlist_insert_and_remove)
 		&node[ARRAY_SIZE(node)/2 - 1]), "dlist can't remove a node in constant time");
 }
 
+static sys_dlist_t bench_list;
+static sys_dnode_t bench_nodes[BENCH_NODES];
+
+static void dlist_remove_append(void *arg)
+{
+	sys_dnode_t *node = arg;
+
+	sys_dlist_remove(node);
+	sys_dlist_append(&bench_list, node);
+}
+
+static void dlist_get_append(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	sys_dlist_append(&bench_list, sys_dlist_get(&bench_list));
+}
+
+/**
+ * @brief Measure the duration of dlist operations
+ *
+ * @details Remove a node from the middle of a long list and append
+ * it again, then take the head of the list and append it, reporting
+ * the distribution of the durations.
+ *
+ * @ingroup lib_dlist_tests
+ */
+ZTEST(dlist_perf, test_dlist_timing)
+{
+	BENCHMARK_DEFINE(bench_remove, "dlist remove+append", BENCH_REPS);
+	BENCHMARK_DEFINE(bench_get, "dlist get+append", BENCH_REPS);
+
+	sys_dlist_init(&bench_list);
+	for (int i = 0; i < ARRAY_SIZE(bench_nodes); i++) {
+		sys_dlist_append(&bench_list, &bench_nodes[i]);
+	}
+
+	benchmark_run(&bench_remove, dlist_remove_append,
+		      &bench_nodes[BENCH_NODES / 2], BENCH_WARMUP, BENCH_REPS);
+	benchmark_run(&bench_get, dlist_get_append, NULL, BENCH_WARMUP,
+		      BENCH_REPS);
+
+	zassert_equal(bench_remove.count, BENCH_REPS);
+	zassert_equal(bench_get.count, BENCH_REPS);
+
+	benchmark_report(&bench_remove);
+	benchmark_report(&bench_get);
+}
+
 ZTEST_SUITE(dlist_perf, NULL, NULL, NULL, NULL, NULL);
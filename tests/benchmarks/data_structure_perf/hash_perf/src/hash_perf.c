@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Lookup and update durations of the hash tables against a red-black tree
+ * and a linear scan of a doubly linked list, all holding the same items.
+ * Each repetition looks up the next item, so that a single hot item does
+ * not stay in cache.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/benchmark.h>
+#include <zephyr/sys/dlist.h>
+#include <zephyr/sys/htable.h>
+#include <zephyr/sys/oamap.h>
+#include <zephyr/sys/rb.h>
+
+#define N_ITEMS 512
+#define BENCH_WARMUP 16
+#define BENCH_REPS 256
+
+struct item {
+	struct sys_hnode hn;
+	struct rbnode rb;
+	sys_dnode_t dn;
+	uintptr_t key;
+};
+
+static struct item items[N_ITEMS];
+static uint32_t next_idx;
+
+SYS_HTABLE_DEFINE(htable, N_ITEMS);
+SYS_OAMAP_DEFINE(oamap, 2 * N_ITEMS);
+static struct rbtree tree;
+static sys_dlist_t list;
+
+static bool item_lessthan(struct rbnode *a, struct rbnode *b)
+{
+	return CONTAINER_OF(a, struct item, rb)->key <
+	       CONTAINER_OF(b, struct item, rb)->key;
+}
+
+static bool item_eq(const struct sys_hnode *hn, const void *key)
+{
+	return CONTAINER_OF(hn, struct item, hn)->key == *(const uintptr_t *)key;
+}
+
+static inline struct item *next_item(void)
+{
+	next_idx = (next_idx + 1) % N_ITEMS;
+
+	return &items[next_idx];
+}
+
+static void htable_find(void *arg)
+{
+	uintptr_t key = next_item()->key;
+
+	(void)sys_htable_find(&htable, sys_hash32_uptr(key), item_eq, &key);
+}
+
+static void oamap_get(void *arg)
+{
+	(void)sys_oamap_get(&oamap, next_item()->key, NULL);
+}
+
+static void rbtree_contains(void *arg)
+{
+	(void)rb_contains(&tree, &next_item()->rb);
+}
+
+static void dlist_scan(void *arg)
+{
+	uintptr_t key = next_item()->key;
+	struct item *it;
+
+	SYS_DLIST_FOR_EACH_CONTAINER(&list, it, dn) {
+		if (it->key == key) {
+			break;
+		}
+	}
+}
+
+static void htable_remove_insert(void *arg)
+{
+	struct item *it = next_item();
+
+	(void)sys_htable_remove(&htable, &it->hn);
+	sys_htable_insert(&htable, &it->hn, sys_hash32_uptr(it->key));
+}
+
+static void oamap_remove_insert(void *arg)
+{
+	struct item *it = next_item();
+
+	(void)sys_oamap_remove(&oamap, it->key, NULL);
+	(void)sys_oamap_insert(&oamap, it->key, it, NULL);
+}
+
+static void rbtree_remove_insert(void *arg)
+{
+	struct item *it = next_item();
+
+	rb_remove(&tree, &it->rb);
+	rb_insert(&tree, &it->rb);
+}
+
+static void *hash_perf_setup(void)
+{
+	tree.lessthan_fn = item_lessthan;
+	sys_dlist_init(&list);
+
+	for (uint32_t i = 0; i < N_ITEMS; i++) {
+		/* Spread keys, an odd multiplier never gives 0 */
+		items[i].key = (i + 1) * 2654435761U;
+
+		sys_htable_insert(&htable, &items[i].hn,
+				  sys_hash32_uptr(items[i].key));
+		(void)sys_oamap_insert(&oamap, items[i].key, &items[i], NULL);
+		rb_insert(&tree, &items[i].rb);
+		sys_dlist_append(&list, &items[i].dn);
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Measure the duration of lookups
+ *
+ * @ingroup lib_hash_table_tests
+ *
+ * @see sys_htable_find(), sys_oamap_get()
+ */
+ZTEST(hash_perf, test_lookup)
+{
+	BENCHMARK_DEFINE(bench_htable, "htable find", BENCH_REPS);
+	BENCHMARK_DEFINE(bench_oamap, "oamap get", BENCH_REPS);
+	BENCHMARK_DEFINE(bench_rbtree, "rbtree contains", BENCH_REPS);
+	BENCHMARK_DEFINE(bench_dlist, "dlist scan", BENCH_REPS);
+
+	zassert_equal(sys_oamap_size(&oamap), N_ITEMS);
+
+	benchmark_run(&bench_htable, htable_find, NULL, BENCH_WARMUP,
+		      BENCH_REPS);
+	benchmark_run(&bench_oamap, oamap_get, NULL, BENCH_WARMUP, BENCH_REPS);
+	benchmark_run(&bench_rbtree, rbtree_contains, NULL, BENCH_WARMUP,
+		      BENCH_REPS);
+	benchmark_run(&bench_dlist, dlist_scan, NULL, BENCH_WARMUP,
+		      BENCH_REPS);
+
+	benchmark_report(&bench_htable);
+	benchmark_report(&bench_oamap);
+	benchmark_report(&bench_rbtree);
+	benchmark_report(&bench_dlist);
+}
+
+/**
+ * @brief Measure the duration of removing and inserting again an item
+ *
+ * @ingroup lib_hash_table_tests
+ *
+ * @see sys_htable_insert(), sys_oamap_insert()
+ */
+ZTEST(hash_perf, test_update)
+{
+	BENCHMARK_DEFINE(bench_htable, "htable remove+insert", BENCH_REPS);
+	BENCHMARK_DEFINE(bench_oamap, "oamap remove+insert", BENCH_REPS);
+	BENCHMARK_DEFINE(bench_rbtree, "rbtree remove+insert", BENCH_REPS);
+
+	benchmark_run(&bench_htable, htable_remove_insert, NULL, BENCH_WARMUP,
+		      BENCH_REPS);
+	benchmark_run(&bench_oamap, oamap_remove_insert, NULL, BENCH_WARMUP,
+		      BENCH_REPS);
+	benchmark_run(&bench_rbtree, rbtree_remove_insert, NULL, BENCH_WARMUP,
+		      BENCH_REPS);
+
+	zassert_equal(sys_htable_size(&htable), N_ITEMS);
+	zassert_equal(sys_oamap_size(&oamap), N_ITEMS);
+
+	benchmark_report(&bench_htable);
+	benchmark_report(&bench_oamap);
+	benchmark_report(&bench_rbtree);
+}
+
+ZTEST_SUITE(hash_perf, NULL, hash_perf_setup, NULL, NULL, NULL);
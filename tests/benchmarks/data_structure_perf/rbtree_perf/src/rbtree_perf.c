@@ -6,8 +6,11 @@
 
 #include <zephyr/ztest.h>
 #include <zephyr/sys/rb.h>
+#include <zephyr/benchmark.h>
 
 #define TREE_SIZE 512
+#define BENCH_WARMUP 16
+#define BENCH_REPS 256
 /* zephyr can't do floating-point arithmetic,
  * so manual: dlog_N = 2log(TREE_SIZE) = 18
  */
@@ -207,4 +210,184 @@ ZTEST(rbtree_perf, test_rbtree_perf)
 	verify_rbtree_perf(root, test);
 }
 
+static struct rbnode bench_nodes[TREE_SIZE];
+static struct rbtree bench_tree;
+
+static void rbtree_remove_insert(void *arg)
+{
+	rb_remove(&bench_tree, arg);
+	rb_insert(&bench_tree, arg);
+}
+
+static void rbtree_contains(void *arg)
+{
+	(void)rb_contains(&bench_tree, arg);
+}
+
+static void rbtree_get_min(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	(void)rb_get_min(&bench_tree);
+}
+
+/**
+ * @brief Measure the duration of rbtree operations
+ *
+ * @details Remove and insert again a node of a full tree, look it up
+ * and get the minimum node, reporting the distribution of the
+ * durations.
+ *
+ * @ingroup lib_rbtree_tests
+ *
+ * @see rb_insert(), rb_remove(), rb_contains(), rb_get_min()
+ */
+ZTEST(rbtree_perf, test_rbtree_timing)
+{
+	BENCHMARK_DEFINE(bench_update, "rbtree remove+insert", BENCH_REPS);
+	BENCHMARK_DEFINE(bench_contains, "rbtree contains", BENCH_REPS);
+	BENCHMARK_DEFINE(bench_min, "rbtree get_min", BENCH_REPS);
+	struct rbnode *node = &bench_nodes[TREE_SIZE / 2];
+
+	bench_tree.lessthan_fn = node_lessthan;
+	for (uint32_t i = 0; i < TREE_SIZE; i++) {
+		rb_insert(&bench_tree, &bench_nodes[i]);
+	}
+
+	benchmark_run(&bench_update, rbtree_remove_insert, node, BENCH_WARMUP,
+		      BENCH_REPS);
+	benchmark_run(&bench_contains, rbtree_contains, node, BENCH_WARMUP,
+		      BENCH_REPS);
+	benchmark_run(&bench_min, rbtree_get_min, NULL, BENCH_WARMUP,
+		      BENCH_REPS);
+
+	zassert_true(rb_contains(&bench_tree, node));
+	zassert_equal(bench_update.count, BENCH_REPS);
+
+	benchmark_report(&bench_update);
+	benchmark_report(&bench_contains);
+	benchmark_report(&bench_min);
+}
+
+#define SCALE_BUILD_REPS 8
+/* Prime, so that stepping through nodes visits all of them */
+#define SCALE_STRIDE 7919
+
+#define SCALE(_n)							\
+	{								\
+		.n = _n,						\
+		.build = "rbtree build_sorted " #_n,			\
+		.insert = "rbtree insert " #_n,				\
+		.remove = "rbtree remove " #_n,				\
+		.search = "rbtree search " #_n,				\
+	}
+
+static const struct {
+	uint32_t n;
+	const char *build;
+	const char *insert;
+	const char *remove;
+	const char *search;
+} scales[] = {
+	SCALE(100),
+	SCALE(1000),
+	SCALE(10000),
+	SCALE(100000),
+};
+
+static struct rbnode scale_nodes[CONFIG_RBTREE_PERF_MAX_NODES];
+static struct rbnode *scale_sorted[CONFIG_RBTREE_PERF_MAX_NODES];
+static struct rbtree scale_tree;
+static uint32_t scale_n;
+static uint32_t scale_idx;
+static uint64_t scale_samples[BENCH_REPS];
+static struct benchmark scale_bench;
+
+static struct rbnode *scale_next(void)
+{
+	scale_idx = (scale_idx + SCALE_STRIDE) % scale_n;
+
+	return &scale_nodes[scale_idx];
+}
+
+static void scale_build(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	rb_build_sorted(&scale_tree, scale_sorted, scale_n);
+}
+
+static void scale_insert(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	rb_insert(&scale_tree, scale_next());
+}
+
+static void scale_remove(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	rb_remove(&scale_tree, scale_next());
+}
+
+static void scale_search(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	(void)rb_contains(&scale_tree, scale_next());
+}
+
+static void scale_measure(const char *name, benchmark_fn_t fn, uint32_t warmup,
+			  uint32_t reps)
+{
+	benchmark_init(&scale_bench, name, scale_samples,
+		       ARRAY_SIZE(scale_samples));
+	benchmark_run(&scale_bench, fn, NULL, warmup, reps);
+	zassert_equal(scale_bench.count, reps);
+	benchmark_report(&scale_bench);
+}
+
+/**
+ * @brief Measure the duration of rbtree operations against the tree size
+ *
+ * @details For trees of 10^2 nodes and up to
+ * CONFIG_RBTREE_PERF_MAX_NODES, build the tree from sorted nodes, then
+ * remove nodes spread over the tree, insert them again and look nodes
+ * up, reporting the distribution of the durations of each operation.
+ *
+ * @ingroup lib_rbtree_tests
+ *
+ * @see rb_build_sorted(), rb_insert(), rb_remove(), rb_contains()
+ */
+ZTEST(rbtree_perf, test_rbtree_scaling)
+{
+	uint32_t reps;
+
+	scale_tree.lessthan_fn = node_lessthan;
+	for (uint32_t i = 0; i < ARRAY_SIZE(scale_nodes); i++) {
+		scale_sorted[i] = &scale_nodes[i];
+	}
+
+	for (uint32_t i = 0; i < ARRAY_SIZE(scales); i++) {
+		if (scales[i].n > ARRAY_SIZE(scale_nodes)) {
+			break;
+		}
+
+		scale_n = scales[i].n;
+		scale_measure(scales[i].build, scale_build, 1, SCALE_BUILD_REPS);
+
+		/* Remove distinct nodes, then insert the same ones back */
+		reps = MIN(BENCH_REPS, scale_n - BENCH_WARMUP);
+		scale_idx = 0;
+		scale_measure(scales[i].remove, scale_remove, BENCH_WARMUP, reps);
+		scale_idx = 0;
+		scale_measure(scales[i].insert, scale_insert, BENCH_WARMUP, reps);
+		scale_measure(scales[i].search, scale_search, BENCH_WARMUP,
+			      BENCH_REPS);
+
+		zassert_true(rb_contains(&scale_tree, &scale_nodes[0]));
+	}
+}
+
 ZTEST_SUITE(rbtree_perf, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * File system throughput on the RAM disk, so that the time measured is
+ * spent in the file system and the disk access layer. A file is written
+ * and read sequentially in pieces of several sizes, with fs_read() and
+ * fs_readv(), then accessed at random sector aligned positions with
+ * fs_pread() and fs_pwrite(), and finally copied with fs_copy().
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/benchmark.h>
+#include <zephyr/fs/fs.h>
+#include <zephyr/timing/timing.h>
+#include <ff.h>
+#include <stdio.h>
+
+#define N_REPS 5
+#define FILE_SIZE (128 * 1024)
+#define SECTOR_SIZE 512
+#define N_RANDOM 64
+#define N_IOV 4
+
+#define MNT_POINT "/RAM:"
+#define FILE_NAME MNT_POINT "/bench.bin"
+#define COPY_NAME MNT_POINT "/copy.bin"
+
+static FATFS fat_fs;
+static struct fs_mount_t mnt = {
+	.type = FS_FATFS,
+	.fs_data = &fat_fs,
+	.mnt_point = MNT_POINT,
+};
+
+static struct fs_file_t file;
+static uint8_t buf[4096] __aligned(4);
+static uint64_t samples[N_REPS];
+static struct benchmark bench;
+static size_t chunk;
+static uint32_t seed;
+
+static uint32_t next_random(void)
+{
+	seed = seed * 1103515245U + 12345U;
+
+	return seed >> 8;
+}
+
+static void seq_write(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	(void)fs_seek(&file, 0, FS_SEEK_SET);
+	for (size_t off = 0; off < FILE_SIZE; off += chunk) {
+		(void)fs_write(&file, buf, chunk);
+	}
+	(void)fs_sync(&file);
+}
+
+static void seq_read(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	(void)fs_seek(&file, 0, FS_SEEK_SET);
+	for (size_t off = 0; off < FILE_SIZE; off += chunk) {
+		(void)fs_read(&file, buf, chunk);
+	}
+}
+
+static void seq_readv(void *arg)
+{
+	struct fs_iovec iov[N_IOV];
+
+	ARG_UNUSED(arg);
+
+	for (int i = 0; i < N_IOV; i++) {
+		iov[i].data = &buf[i * sizeof(buf) / N_IOV];
+		iov[i].len = sizeof(buf) / N_IOV;
+	}
+
+	(void)fs_seek(&file, 0, FS_SEEK_SET);
+	for (size_t off = 0; off < FILE_SIZE; off += sizeof(buf)) {
+		(void)fs_readv(&file, iov, N_IOV);
+	}
+}
+
+static off_t random_offset(void)
+{
+	return (next_random() % (FILE_SIZE / chunk)) * chunk;
+}
+
+static void random_read(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	for (int i = 0; i < N_RANDOM; i++) {
+		(void)fs_pread(&file, buf, chunk, random_offset());
+	}
+}
+
+static void random_write(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	for (int i = 0; i < N_RANDOM; i++) {
+		(void)fs_pwrite(&file, buf, chunk, random_offset());
+	}
+	(void)fs_sync(&file);
+}
+
+/* Runs a benchmark and reports its median throughput as well */
+static void measure(const char *what, benchmark_fn_t fn, size_t bytes)
+{
+	static char names[16][40];
+	static int n;
+	struct benchmark_stats stats;
+	uint64_t ns;
+
+	snprintf(names[n], sizeof(names[n]), "%s %zu", what, chunk);
+	benchmark_init(&bench, names[n], samples, ARRAY_SIZE(samples));
+	benchmark_run(&bench, fn, NULL, 1, N_REPS);
+	benchmark_report(&bench);
+
+	if (benchmark_stats_get(&bench, &stats) == 0) {
+		ns = timing_cycles_to_ns(stats.median);
+		if (ns > 0) {
+			benchmark_report_value(names[n], "KiB/s",
+					       bytes * 1000000000ULL / 1024U / ns);
+		}
+	}
+
+	n = (n + 1) % ARRAY_SIZE(names);
+}
+
+static int bench_copy(void)
+{
+	struct benchmark_stats stats;
+	timing_t start, end;
+	uint64_t ns;
+	int rc = 0;
+
+	benchmark_init(&bench, "fs_copy", samples, ARRAY_SIZE(samples));
+
+	timing_init();
+	timing_start();
+
+	for (int i = 0; i < N_REPS; i++) {
+		(void)fs_unlink(COPY_NAME);
+		start = timing_counter_get();
+		rc = fs_copy(FILE_NAME, COPY_NAME);
+		end = timing_counter_get();
+		if (rc) {
+			printk("fs_copy failed: %d\n", rc);
+			break;
+		}
+		benchmark_sample_add(&bench, timing_cycles_get(&start, &end));
+	}
+
+	timing_stop();
+
+	if (rc == 0) {
+		benchmark_report(&bench);
+		if (benchmark_stats_get(&bench, &stats) == 0) {
+			ns = timing_cycles_to_ns(stats.median);
+			if (ns > 0) {
+				benchmark_report_value("fs_copy", "KiB/s",
+					FILE_SIZE * 1000000000ULL / 1024U / ns);
+			}
+		}
+	}
+
+	return rc;
+}
+
+void main(void)
+{
+	static const size_t chunks[] = { SECTOR_SIZE, sizeof(buf) };
+	int rc;
+
+	rc = fs_mount(&mnt);
+	if (rc == 0) {
+		(void)fs_unlink(FILE_NAME);
+		(void)fs_unlink(COPY_NAME);
+		fs_file_t_init(&file);
+		rc = fs_open(&file, FILE_NAME, FS_O_CREATE | FS_O_RDWR);
+	}
+	if (rc) {
+		printk("file system setup failed: %d\n", rc);
+		return;
+	}
+
+	printk("FAT throughput on the RAM disk, %u byte file, disk cache %s\n",
+	       FILE_SIZE, IS_ENABLED(CONFIG_DISK_CACHE) ? "on" : "off");
+
+	for (int i = 0; i < sizeof(buf); i++) {
+		buf[i] = i;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(chunks); i++) {
+		chunk = chunks[i];
+		seed = 1U;
+
+		measure("seq write", seq_write, FILE_SIZE);
+		measure("seq read", seq_read, FILE_SIZE);
+		measure("random pread", random_read, N_RANDOM * chunk);
+		measure("random pwrite", random_write, N_RANDOM * chunk);
+	}
+
+	chunk = sizeof(buf) / N_IOV;
+	measure("seq readv x4", seq_readv, FILE_SIZE);
+
+	(void)fs_close(&file);
+
+	if (bench_copy() == 0) {
+		printk("fin\n");
+	}
+}
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Message rate between two ICMSG instances wired through an emulated MBOX,
+ * sending with a copy (ipc_service_send()) against writing in place in the
+ * TX buffer (ipc_service_get_tx_buffer() and ipc_service_send_nocopy()).
+ * The sender yields to the receiver when the TX buffer is full, and the
+ * number of MBOX signals per 100 messages shows how many notifications are
+ * coalesced.
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/benchmark.h>
+#include <zephyr/drivers/mbox/mbox_emul.h>
+#include <zephyr/ipc/ipc_service.h>
+#include <zephyr/timing/timing.h>
+
+#define N_REPS 10
+#define N_MSGS 1000
+#define MSG_SIZE 32
+
+/* ipc0 signals ipc1 on this channel of the emulated MBOX */
+#define IPC0_TX_CHANNEL 0
+
+static const struct device *mbox = DEVICE_DT_GET(DT_NODELABEL(mbox_emul));
+
+static struct ipc_ept ept0;
+static struct ipc_ept ept1;
+static K_SEM_DEFINE(bound_sem, 0, 2);
+static atomic_t received;
+
+static uint64_t samples[N_REPS];
+static struct benchmark bench;
+
+static void bound_cb(void *priv)
+{
+	k_sem_give(&bound_sem);
+}
+
+static void received_cb(const void *data, size_t len, void *priv)
+{
+	(void)atomic_inc(&received);
+}
+
+static struct ipc_ept_cfg ept0_cfg = {
+	.name = "ept0",
+	.cb = {
+		.bound = bound_cb,
+	},
+};
+
+static struct ipc_ept_cfg ept1_cfg = {
+	.name = "ept1",
+	.cb = {
+		.bound = bound_cb,
+		.received = received_cb,
+	},
+};
+
+static bool send_copy(void)
+{
+	uint8_t msg[MSG_SIZE] = {0};
+
+	return ipc_service_send(&ept0, msg, sizeof(msg)) == sizeof(msg);
+}
+
+static bool send_nocopy(void)
+{
+	uint32_t size = MSG_SIZE;
+	void *data;
+
+	if (ipc_service_get_tx_buffer(&ept0, &data, &size, K_NO_WAIT) != 0) {
+		return false;
+	}
+
+	memset(data, 0, MSG_SIZE);
+
+	return ipc_service_send_nocopy(&ept0, data, MSG_SIZE) == MSG_SIZE;
+}
+
+static void transfer(void *arg)
+{
+	bool (*send)(void) = arg;
+
+	atomic_set(&received, 0);
+
+	for (int i = 0; i < N_MSGS; i++) {
+		while (!send()) {
+			k_yield();
+		}
+	}
+
+	while (atomic_get(&received) < N_MSGS) {
+		k_yield();
+	}
+}
+
+/* Runs a benchmark and reports its median message rate as well */
+static void measure(const char *name, bool (*send)(void))
+{
+	struct benchmark_stats stats;
+	uint32_t signals;
+	uint64_t ns;
+
+	signals = mbox_emul_signals_get(mbox, IPC0_TX_CHANNEL);
+
+	benchmark_init(&bench, name, samples, ARRAY_SIZE(samples));
+	benchmark_run(&bench, transfer, send, 1, N_REPS);
+	benchmark_report(&bench);
+
+	if (benchmark_stats_get(&bench, &stats) == 0) {
+		ns = timing_cycles_to_ns(stats.median);
+		if (ns > 0) {
+			benchmark_report_value(name, "msg/s",
+					       N_MSGS * 1000000000ULL / ns);
+		}
+	}
+
+	signals = mbox_emul_signals_get(mbox, IPC0_TX_CHANNEL) - signals;
+	benchmark_report_value(name, "signals/100msg",
+			       (uint64_t)signals * 100 / (N_MSGS * (N_REPS + 1)));
+}
+
+void main(void)
+{
+	int ret;
+
+	ret = ipc_service_register_endpoint(DEVICE_DT_GET(DT_NODELABEL(ipc0)),
+					    &ept0, &ept0_cfg);
+	if (ret == 0) {
+		ret = ipc_service_register_endpoint(DEVICE_DT_GET(DT_NODELABEL(ipc1)),
+						    &ept1, &ept1_cfg);
+	}
+
+	if (ret != 0) {
+		printk("ipc_service_register_endpoint() failed: %d\n", ret);
+		return;
+	}
+
+	for (int i = 0; i < 2; i++) {
+		(void)k_sem_take(&bound_sem, K_FOREVER);
+	}
+
+	printk("icmsg message rate, %u byte messages, %u messages per run\n",
+	       MSG_SIZE, N_MSGS);
+
+	measure("icmsg send", send_copy);
+	measure("icmsg send_nocopy", send_nocopy);
+
+	printk("fin\n");
+}
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief Measure the cost of the ISR statistics instrumentation
+ *
+ * This file contains a test that measures the time added to every
+ * interrupt by the sys_trace_isr_enter() / sys_trace_isr_exit() hooks
+ * when CONFIG_TRACING_ISR_STATS is enabled.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/tracing/tracing.h>
+#include <zephyr/tracing/isr_stats.h>
+#include "utils.h"
+
+#define NUM_ITERATIONS 1000
+
+void isr_stats_overhead(void)
+{
+	timing_t timestamp_start;
+	timing_t timestamp_end;
+	unsigned int key;
+	uint32_t diff;
+
+	timing_start();
+	TICK_SYNCH();
+
+	key = irq_lock();
+
+	timestamp_start = timing_counter_get();
+	for (int i = 0; i < NUM_ITERATIONS; i++) {
+		sys_trace_isr_enter();
+		sys_trace_isr_exit();
+	}
+	timestamp_end = timing_counter_get();
+
+	irq_unlock(key);
+
+	diff = timing_cycles_get(&timestamp_start, &timestamp_end);
+	PRINT_STATS_AVG("ISR statistics instrumentation overhead per interrupt",
+			diff, NUM_ITERATIONS);
+
+	/* Do not leave the synthetic entries in the statistics */
+	isr_stats_reset();
+
+	timing_stop();
+}
@@ -15,6 +15,7 @@
 #include <zephyr/sys/printk.h>
 #include <stdio.h>
 #include <zephyr/timestamp.h>
+#include <zephyr/benchmark.h>
 
 #define INT_IMM8_OFFSET   1
 #define IRQ_PRIORITY      3
@@ -37,11 +38,18 @@ extern int error_count;
 		printk("%s", sline);			     	\
 	}
 
-#define PRINT_STATS(x, y) \
-	PRINT_F(x, y, (uint32_t)timing_cycles_to_ns(y))
+#define PRINT_STATS(x, y)						\
+	{								\
+		PRINT_F(x, y, (uint32_t)timing_cycles_to_ns(y));	\
+		benchmark_report_value(x, "cycles", y);			\
+	}
 
-#define PRINT_STATS_AVG(x, y, counter)	\
-	PRINT_F(x, y / counter, (uint32_t)timing_cycles_to_ns_avg(y, counter));
+#define PRINT_STATS_AVG(x, y, counter)					\
+	{								\
+		PRINT_F(x, y / counter,					\
+			(uint32_t)timing_cycles_to_ns_avg(y, counter));	\
+		benchmark_report_value(x, "cycles", y / counter);	\
+	}
 
 
 #endif
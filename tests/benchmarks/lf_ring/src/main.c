@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Throughput of byte rings shared by producer and consumer threads: a
+ * ring_buf guarded by a spinlock, against lock-free SPSC, MPSC and MPMC
+ * lf_rings. Each producer puts N_BYTES in RECORD_SIZE records and each
+ * consumer gets them until all are consumed, yielding while the ring is
+ * full (empty). With SMP, the threads run on several CPUs at once.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/benchmark.h>
+#include <zephyr/sys/ring_buffer.h>
+#include <zephyr/sys/lf_ring.h>
+#include <zephyr/timing/timing.h>
+
+#define N_REPS 10
+#define N_BYTES 16384
+#define RING_SIZE 256
+#define RECORD_SIZE 16
+#define MAX_THREADS 4
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define PRIO K_PRIO_PREEMPT(1)
+
+struct ring_ops {
+	uint32_t (*put)(const uint8_t *data, uint32_t size);
+	uint32_t (*get)(uint8_t *data, uint32_t size);
+};
+
+struct config {
+	const char *name;
+	const struct ring_ops *ops;
+	uint32_t flags;
+	int producers;
+	int consumers;
+};
+
+RING_BUF_DECLARE(locked_ring, RING_SIZE);
+static struct k_spinlock locked_lock;
+LF_RING_DEFINE(lf_ring, RING_SIZE, LF_RING_MPMC);
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, MAX_THREADS, STACK_SIZE);
+static struct k_thread threads[MAX_THREADS];
+static const struct config *current;
+static atomic_t consumed;
+
+static uint64_t samples[N_REPS];
+static struct benchmark bench;
+
+static uint32_t locked_put(const uint8_t *data, uint32_t size)
+{
+	k_spinlock_key_t key = k_spin_lock(&locked_lock);
+	uint32_t n = 0;
+
+	/* A record is put whole or not at all, as with lf_ring_put() */
+	if (ring_buf_space_get(&locked_ring) >= size) {
+		n = ring_buf_put(&locked_ring, data, size);
+	}
+
+	k_spin_unlock(&locked_lock, key);
+
+	return n;
+}
+
+static uint32_t locked_get(uint8_t *data, uint32_t size)
+{
+	k_spinlock_key_t key = k_spin_lock(&locked_lock);
+	uint32_t n = ring_buf_get(&locked_ring, data, size);
+
+	k_spin_unlock(&locked_lock, key);
+
+	return n;
+}
+
+static uint32_t lf_put(const uint8_t *data, uint32_t size)
+{
+	return lf_ring_put(&lf_ring, data, size);
+}
+
+static uint32_t lf_get(uint8_t *data, uint32_t size)
+{
+	return lf_ring_get(&lf_ring, data, size);
+}
+
+static const struct ring_ops locked_ops = {locked_put, locked_get};
+static const struct ring_ops lf_ops = {lf_put, lf_get};
+
+static const struct config configs[] = {
+	{"ring_buf spinlock 1:1", &locked_ops, 0, 1, 1},
+	{"ring_buf spinlock 2:2", &locked_ops, 0, 2, 2},
+	{"lf_ring spsc 1:1", &lf_ops, LF_RING_SPSC, 1, 1},
+	{"lf_ring mpsc 3:1", &lf_ops, LF_RING_MPSC, 3, 1},
+	{"lf_ring mpmc 1:1", &lf_ops, LF_RING_MPMC, 1, 1},
+	{"lf_ring mpmc 2:2", &lf_ops, LF_RING_MPMC, 2, 2},
+};
+
+static void producer(void *p1, void *p2, void *p3)
+{
+	uint8_t record[RECORD_SIZE] = {0};
+	uint32_t sent = 0;
+
+	while (sent < N_BYTES) {
+		if (current->ops->put(record, sizeof(record)) == sizeof(record)) {
+			sent += sizeof(record);
+		} else {
+			k_yield();
+		}
+	}
+}
+
+static void consumer(void *p1, void *p2, void *p3)
+{
+	uint32_t total = N_BYTES * current->producers;
+	uint8_t record[RECORD_SIZE];
+	uint32_t n;
+
+	while ((uint32_t)atomic_get(&consumed) < total) {
+		n = current->ops->get(record, sizeof(record));
+		if (n > 0) {
+			(void)atomic_add(&consumed, n);
+		} else {
+			k_yield();
+		}
+	}
+}
+
+static void transfer(void *arg)
+{
+	const struct config *cfg = arg;
+	int n = 0;
+
+	current = cfg;
+	atomic_set(&consumed, 0);
+	ring_buf_reset(&locked_ring);
+	lf_ring_init(&lf_ring, lf_ring.buffer, RING_SIZE, cfg->flags);
+
+	for (int i = 0; i < cfg->consumers; i++, n++) {
+		k_thread_create(&threads[n], stacks[n], STACK_SIZE, consumer,
+				NULL, NULL, NULL, PRIO, 0, K_NO_WAIT);
+	}
+	for (int i = 0; i < cfg->producers; i++, n++) {
+		k_thread_create(&threads[n], stacks[n], STACK_SIZE, producer,
+				NULL, NULL, NULL, PRIO, 0, K_NO_WAIT);
+	}
+
+	for (int i = 0; i < n; i++) {
+		(void)k_thread_join(&threads[i], K_FOREVER);
+	}
+}
+
+/* Runs a benchmark and reports its median throughput as well */
+static void measure(const struct config *cfg)
+{
+	struct benchmark_stats stats;
+	uint64_t ns;
+
+	__ASSERT_NO_MSG(cfg->producers + cfg->consumers <= MAX_THREADS);
+
+	benchmark_init(&bench, cfg->name, samples, ARRAY_SIZE(samples));
+	benchmark_run(&bench, transfer, (void *)cfg, 1, N_REPS);
+	benchmark_report(&bench);
+
+	if (benchmark_stats_get(&bench, &stats) == 0) {
+		ns = timing_cycles_to_ns(stats.median);
+		if (ns > 0) {
+			benchmark_report_value(cfg->name, "KiB/s",
+					       (uint64_t)N_BYTES * cfg->producers *
+					       1000000000ULL / 1024 / ns);
+		}
+	}
+}
+
+void main(void)
+{
+	printk("ring throughput, %u byte ring, %u byte records, %u bytes per producer\n",
+	       RING_SIZE, RECORD_SIZE, N_BYTES);
+
+	for (int i = 0; i < ARRAY_SIZE(configs); i++) {
+		measure(&configs[i]);
+	}
+
+	printk("fin\n");
+}
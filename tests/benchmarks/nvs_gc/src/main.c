@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Latency of NVS writes going through garbage collections, on the flash
+ * simulator with its hardware timing. The application idles between the
+ * writes, which leaves time for the background garbage collection.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/benchmark.h>
+#include <zephyr/drivers/flash.h>
+#include <zephyr/fs/nvs.h>
+#include <zephyr/storage/flash_map.h>
+#include <string.h>
+
+#define N_IDS 32
+#define N_WRITES 640
+#define VALUE_LEN 64
+#define IDLE_MS 20
+
+static uint64_t write_samples[N_WRITES];
+static struct benchmark write_bench;
+
+static struct nvs_fs fs;
+
+void main(void)
+{
+	const struct flash_area *fa;
+	struct flash_pages_info info;
+	struct nvs_stats stats;
+	uint8_t value[VALUE_LEN];
+	timing_t start, end;
+	ssize_t len;
+	int rc;
+
+	/* Start from empty storage, the simulated flash may be kept in a file */
+	rc = flash_area_open(FIXED_PARTITION_ID(storage_partition), &fa);
+	if (rc == 0) {
+		rc = flash_area_erase(fa, 0, fa->fa_size);
+	}
+	if (rc == 0) {
+		fs.flash_device = flash_area_get_device(fa);
+		fs.offset = fa->fa_off;
+		rc = flash_get_page_info_by_offs(fs.flash_device, fs.offset,
+						 &info);
+	}
+	if (rc == 0) {
+		fs.sector_size = info.size;
+		fs.sector_count = MIN(fa->fa_size / info.size, 4U);
+		rc = nvs_mount(&fs);
+	}
+	if (rc) {
+		printk("nvs init failed: %d\n", rc);
+		return;
+	}
+
+	printk("NVS write latency, %u sectors of %u bytes, background gc %s\n",
+	       fs.sector_count, fs.sector_size,
+	       IS_ENABLED(CONFIG_NVS_BACKGROUND_GC) ? "on" : "off");
+
+	benchmark_init(&write_bench, "nvs_write", write_samples,
+		       ARRAY_SIZE(write_samples));
+	nvs_stats_reset(&fs);
+
+	timing_init();
+	timing_start();
+
+	for (uint32_t i = 0; i < N_WRITES; i++) {
+		memset(value, i, sizeof(value));
+
+		start = timing_counter_get();
+		len = nvs_write(&fs, i % N_IDS, value, sizeof(value));
+		end = timing_counter_get();
+		if (len != sizeof(value)) {
+			printk("nvs_write failed: %d\n", (int)len);
+			return;
+		}
+		benchmark_sample_add(&write_bench, timing_cycles_get(&start, &end));
+
+		k_msleep(IDLE_MS);
+	}
+
+	timing_stop();
+
+	/* The data survived the garbage collections */
+	for (uint32_t id = 0; id < N_IDS; id++) {
+		len = nvs_read(&fs, id, value, sizeof(value));
+		if ((len != sizeof(value)) ||
+		    (value[0] != (uint8_t)(N_WRITES - N_IDS + id))) {
+			printk("id %u read back wrong: %d\n", id, (int)len);
+			return;
+		}
+	}
+
+	benchmark_report(&write_bench);
+
+	nvs_stats_get(&fs, &stats);
+	printk("%u writes, %u gc, %u in the background, %llu bytes moved\n",
+	       stats.write_count, stats.gc_count, stats.gc_background,
+	       stats.gc_bytes_moved);
+	benchmark_report_value("nvs_write max", "us", stats.write_max_us);
+	benchmark_report_value("nvs gc max", "us", stats.gc_max_us);
+
+	printk("fin\n");
+}
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Throughput of short work items submitted by one thread per CPU to a
+ * P4 work queue with one worker thread per CPU, against a k_work queue,
+ * which has a single thread. Each submitter submits N_ITEMS items, and a
+ * run ends when all items have been handled. The P4 queue uses per-CPU
+ * run queues with CONFIG_P4WQ_PER_CPU_QUEUES.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/benchmark.h>
+#include <zephyr/sys/p4wq.h>
+#include <zephyr/timing/timing.h>
+
+#define N_REPS 10
+#define N_ITEMS 256
+#define MAX_SUBMITTERS CONFIG_MP_MAX_NUM_CPUS
+#define STACK_SIZE (2048 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define SUBMIT_PRIO K_PRIO_PREEMPT(1)
+#define ITEM_PRIO K_PRIO_PREEMPT(2)
+
+#ifdef CONFIG_P4WQ_PER_CPU_QUEUES
+#define P4WQ_NAME "p4wq per-cpu"
+#else
+#define P4WQ_NAME "p4wq"
+#endif
+
+K_P4WQ_DEFINE(p4wq, MAX_SUBMITTERS, STACK_SIZE);
+
+static K_THREAD_STACK_DEFINE(work_q_stack, STACK_SIZE);
+static struct k_work_q work_q;
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, MAX_SUBMITTERS, STACK_SIZE);
+static struct k_thread threads[MAX_SUBMITTERS];
+
+static struct k_p4wq_work p4wq_items[MAX_SUBMITTERS][N_ITEMS];
+static struct k_work work_items[MAX_SUBMITTERS][N_ITEMS];
+
+static atomic_t handled;
+static uint32_t total;
+static K_SEM_DEFINE(done_sem, 0, 1);
+
+static uint64_t samples[N_REPS];
+static struct benchmark bench;
+
+static void item_done(void)
+{
+	if ((uint32_t)atomic_inc(&handled) + 1 == total) {
+		k_sem_give(&done_sem);
+	}
+}
+
+static void p4wq_handler(struct k_p4wq_work *item)
+{
+	item_done();
+}
+
+static void work_handler(struct k_work *work)
+{
+	item_done();
+}
+
+static void p4wq_submitter(void *p1, void *p2, void *p3)
+{
+	struct k_p4wq_work *items = p4wq_items[(uintptr_t)p1];
+
+	for (int i = 0; i < N_ITEMS; i++) {
+		items[i].priority = ITEM_PRIO;
+		items[i].deadline = 0;
+		items[i].handler = p4wq_handler;
+		k_p4wq_submit(&p4wq, &items[i]);
+	}
+}
+
+static void work_submitter(void *p1, void *p2, void *p3)
+{
+	struct k_work *items = work_items[(uintptr_t)p1];
+
+	for (int i = 0; i < N_ITEMS; i++) {
+		(void)k_work_submit_to_queue(&work_q, &items[i]);
+	}
+}
+
+static void transfer(void *arg)
+{
+	k_thread_entry_t submitter = arg;
+	unsigned int num_cpus = arch_num_cpus();
+
+	atomic_set(&handled, 0);
+	total = N_ITEMS * num_cpus;
+
+	for (uintptr_t i = 0; i < num_cpus; i++) {
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, submitter,
+				(void *)i, NULL, NULL, SUBMIT_PRIO, 0, K_NO_WAIT);
+	}
+
+	for (int i = 0; i < num_cpus; i++) {
+		(void)k_thread_join(&threads[i], K_FOREVER);
+	}
+
+	(void)k_sem_take(&done_sem, K_FOREVER);
+
+	if (submitter == p4wq_submitter) {
+		/* Regain ownership of the items before the next run */
+		for (int i = 0; i < num_cpus; i++) {
+			for (int j = 0; j < N_ITEMS; j++) {
+				while (k_p4wq_wait(&p4wq_items[i][j], K_NO_WAIT) != 0) {
+					k_yield();
+				}
+			}
+		}
+	}
+}
+
+/* Runs a benchmark and reports its median throughput as well */
+static void measure(const char *name, k_thread_entry_t submitter)
+{
+	struct benchmark_stats stats;
+	uint64_t ns;
+
+	benchmark_init(&bench, name, samples, ARRAY_SIZE(samples));
+	benchmark_run(&bench, transfer, submitter, 1, N_REPS);
+	benchmark_report(&bench);
+
+	if (benchmark_stats_get(&bench, &stats) == 0) {
+		ns = timing_cycles_to_ns(stats.median);
+		if (ns > 0) {
+			benchmark_report_value(name, "items/s",
+					       (uint64_t)N_ITEMS * arch_num_cpus() *
+					       1000000000ULL / ns);
+		}
+	}
+}
+
+void main(void)
+{
+	k_work_queue_start(&work_q, work_q_stack, STACK_SIZE, ITEM_PRIO, NULL);
+
+	for (int i = 0; i < MAX_SUBMITTERS; i++) {
+		for (int j = 0; j < N_ITEMS; j++) {
+			k_work_init(&work_items[i][j], work_handler);
+		}
+	}
+
+	printk("work item throughput, %u CPUs, %u items per submitter\n",
+	       arch_num_cpus(), N_ITEMS);
+
+	measure("k_work", work_submitter);
+	measure(P4WQ_NAME, p4wq_submitter);
+
+	printk("fin\n");
+}
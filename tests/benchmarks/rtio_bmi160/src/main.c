@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Reads of a batch of samples from an emulated BMI160, over SPI and I2C:
+ * one blocking bus call per sample, one RTIO submission with a transaction
+ * per sample done by the emulated bus, and the same submission done through
+ * the blocking adapter, from the system work queue.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/benchmark.h>
+#include <zephyr/drivers/i2c.h>
+#include <zephyr/drivers/spi.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/rtio/rtio_blocking.h>
+#include <zephyr/rtio/rtio_executor_simple.h>
+
+#define N_REPS 20
+#define N_SAMPLES 8
+
+#define BMI160_REG_DATA_GYR_X 0x0C
+#define BMI160_REG_READ BIT(7)
+#define BMI160_SAMPLE_SIZE 12
+
+#define SPI_OPERATION (SPI_WORD_SET(8) | SPI_TRANSFER_MSB)
+
+static const struct spi_dt_spec spi_bmi_spec =
+	SPI_DT_SPEC_GET(DT_NODELABEL(bmi_spi), SPI_OPERATION, 0);
+static const struct i2c_dt_spec i2c_bmi_spec = I2C_DT_SPEC_GET(DT_NODELABEL(bmi_i2c));
+
+SPI_DT_IODEV_DEFINE(spi_bmi, DT_NODELABEL(bmi_spi), SPI_OPERATION, 0);
+I2C_DT_IODEV_DEFINE(i2c_bmi, DT_NODELABEL(bmi_i2c));
+
+/* I2C iodev doing its transactions through the blocking adapter */
+static int i2c_blocking_transfer(const struct rtio_sqe *sqe, struct rtio *r)
+{
+	struct i2c_msg msgs[2];
+	int count = i2c_iodev_txn_msgs(r, sqe, msgs, ARRAY_SIZE(msgs));
+
+	return count <= 0 ? count : i2c_transfer_dt(&i2c_bmi_spec, msgs, count);
+}
+
+static struct rtio_blocking i2c_blocking = RTIO_BLOCKING_INITIALIZER(i2c_blocking_transfer);
+
+static void i2c_blocking_submit(const struct rtio_sqe *sqe, struct rtio *r)
+{
+	rtio_blocking_submit(&i2c_blocking, sqe, r);
+}
+
+static const struct rtio_iodev_api i2c_blocking_api = {
+	.submit = i2c_blocking_submit,
+};
+
+RTIO_IODEV_DEFINE(i2c_bmi_blocking, &i2c_blocking_api, 4, NULL);
+
+RTIO_EXECUTOR_SIMPLE_DEFINE(bench_exec);
+RTIO_DEFINE(r_bench, (struct rtio_executor *)&bench_exec, 2 * N_SAMPLES, 4);
+
+static uint8_t samples[N_SAMPLES][BMI160_SAMPLE_SIZE];
+static uint64_t bench_samples[N_REPS];
+static struct benchmark bench;
+
+static void spi_read_blocking(void *arg)
+{
+	uint8_t reg = BMI160_REG_DATA_GYR_X | BMI160_REG_READ;
+
+	for (int i = 0; i < N_SAMPLES; i++) {
+		const struct spi_buf tx[] = {{.buf = &reg, .len = 1},
+					     {.buf = NULL, .len = BMI160_SAMPLE_SIZE}};
+		const struct spi_buf rx[] = {{.buf = NULL, .len = 1},
+					     {.buf = samples[i], .len = BMI160_SAMPLE_SIZE}};
+		const struct spi_buf_set tx_set = {.buffers = tx, .count = ARRAY_SIZE(tx)};
+		const struct spi_buf_set rx_set = {.buffers = rx, .count = ARRAY_SIZE(rx)};
+
+		(void)spi_transceive_dt(&spi_bmi_spec, &tx_set, &rx_set);
+	}
+}
+
+static void i2c_read_blocking(void *arg)
+{
+	for (int i = 0; i < N_SAMPLES; i++) {
+		(void)i2c_burst_read_dt(&i2c_bmi_spec, BMI160_REG_DATA_GYR_X, samples[i],
+					BMI160_SAMPLE_SIZE);
+	}
+}
+
+/* One transaction per sample, only the last one completes */
+static void read_rtio(void *arg)
+{
+	const struct rtio_iodev *iodev = arg;
+	uint8_t reg = BMI160_REG_DATA_GYR_X;
+	struct rtio *r = &r_bench;
+	struct rtio_sqe *sqe;
+	uint16_t flags;
+
+	if (iodev == &spi_bmi) {
+		reg |= BMI160_REG_READ;
+	}
+
+	for (int i = 0; i < N_SAMPLES; i++) {
+		flags = i < N_SAMPLES - 1 ? RTIO_SQE_NO_RESPONSE : 0;
+
+		sqe = rtio_sqe_acquire(r);
+		rtio_sqe_prep_tiny_write(sqe, iodev, 0, &reg, 1, NULL);
+		sqe->flags = RTIO_SQE_TRANSACTION | flags;
+
+		sqe = rtio_sqe_acquire(r);
+		rtio_sqe_prep_read(sqe, iodev, 0, samples[i], BMI160_SAMPLE_SIZE, NULL);
+		sqe->flags = flags;
+	}
+
+	(void)rtio_submit(r, 2);
+	rtio_cqe_release_all(r);
+	while (rtio_cqe_consume(r) != NULL) {
+		rtio_cqe_release_all(r);
+	}
+}
+
+static void measure(const char *name, benchmark_fn_t fn, void *arg)
+{
+	benchmark_init(&bench, name, bench_samples, ARRAY_SIZE(bench_samples));
+	benchmark_run(&bench, fn, arg, 2, N_REPS);
+	benchmark_report(&bench);
+}
+
+void main(void)
+{
+	printk("bmi160 emulator, %u samples per run\n", N_SAMPLES);
+
+	measure("spi blocking", spi_read_blocking, NULL);
+	measure("spi rtio", read_rtio, (void *)&spi_bmi);
+	measure("i2c blocking", i2c_read_blocking, NULL);
+	measure("i2c rtio", read_rtio, (void *)&i2c_bmi);
+	measure("i2c rtio blocking adapter", read_rtio, (void *)&i2c_bmi_blocking);
+
+	printk("fin\n");
+}
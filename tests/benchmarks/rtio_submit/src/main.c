@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Submit to complete latency of RTIO requests with the simple executor, on
+ * an iodev completing requests as soon as they are submitted. A register
+ * read is done as one chain (tiny write, read and callback, producing a
+ * single completion) and as separate submissions, each waited for, as a
+ * driver would without chains.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/benchmark.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/rtio/rtio_executor_simple.h>
+
+#define N_REPS 100
+
+static void iodev_sync_submit(const struct rtio_sqe *sqe, struct rtio *r)
+{
+	if (sqe->op == RTIO_OP_RX) {
+		memset(sqe->buf, 0x5a, sqe->buf_len);
+	}
+
+	rtio_sqe_ok(r, sqe, 0);
+}
+
+static const struct rtio_iodev_api iodev_sync_api = {
+	.submit = iodev_sync_submit,
+};
+
+RTIO_IODEV_DEFINE(iodev_sync, &iodev_sync_api, 1, NULL);
+
+RTIO_EXECUTOR_SIMPLE_DEFINE(bench_exec);
+RTIO_DEFINE(r_bench, (struct rtio_executor *)&bench_exec, 4, 4);
+
+static const uint8_t reg = 0x28;
+static uint8_t rx_buf[6];
+static volatile uint32_t sink;
+static uint64_t samples[N_REPS];
+static struct benchmark bench;
+
+static void consume_sample(struct rtio *r, const struct rtio_sqe *sqe, void *arg0)
+{
+	sink += rx_buf[0] + rx_buf[5];
+}
+
+static void wait_complete(struct rtio *r)
+{
+	struct rtio_cqe *cqe = rtio_cqe_consume_block(r);
+
+	sink += cqe->result;
+	rtio_cqe_release_all(r);
+}
+
+static void submit_nop(void *arg)
+{
+	struct rtio *r = arg;
+
+	rtio_sqe_prep_nop(rtio_sqe_acquire(r), &iodev_sync, NULL);
+	(void)rtio_submit(r, 1);
+	wait_complete(r);
+}
+
+static void submit_chain(void *arg)
+{
+	struct rtio *r = arg;
+	struct rtio_sqe *sqe;
+
+	sqe = rtio_sqe_acquire(r);
+	rtio_sqe_prep_tiny_write(sqe, &iodev_sync, 0, &reg, 1, NULL);
+	sqe->flags = RTIO_SQE_CHAINED | RTIO_SQE_NO_RESPONSE;
+
+	sqe = rtio_sqe_acquire(r);
+	rtio_sqe_prep_read(sqe, &iodev_sync, 0, rx_buf, sizeof(rx_buf), NULL);
+	sqe->flags = RTIO_SQE_CHAINED | RTIO_SQE_NO_RESPONSE;
+
+	rtio_sqe_prep_callback(rtio_sqe_acquire(r), consume_sample, NULL, NULL);
+
+	(void)rtio_submit(r, 1);
+	wait_complete(r);
+}
+
+static void submit_separate(void *arg)
+{
+	struct rtio *r = arg;
+
+	rtio_sqe_prep_write(rtio_sqe_acquire(r), &iodev_sync, 0, (uint8_t *)&reg, 1, NULL);
+	(void)rtio_submit(r, 1);
+	wait_complete(r);
+
+	rtio_sqe_prep_read(rtio_sqe_acquire(r), &iodev_sync, 0, rx_buf, sizeof(rx_buf), NULL);
+	(void)rtio_submit(r, 1);
+	wait_complete(r);
+
+	consume_sample(r, NULL, NULL);
+}
+
+static void measure(const char *name, benchmark_fn_t fn)
+{
+	benchmark_init(&bench, name, samples, ARRAY_SIZE(samples));
+	benchmark_run(&bench, fn, &r_bench, 10, N_REPS);
+	benchmark_report(&bench);
+}
+
+void main(void)
+{
+	printk("rtio submit to complete latency\n");
+
+	measure("rtio nop", submit_nop);
+	measure("rtio register read chain", submit_chain);
+	measure("rtio register read separate", submit_separate);
+
+	printk("fin\n");
+}
@@ -7,6 +7,7 @@
 #include <zephyr/kernel.h>
 #include <zephyr/sys/printk.h>
 #include <zephyr/wait_q.h>
+#include <zephyr/benchmark.h>
 #include <ksched.h>
 
 /* This is a scheduler microbenchmark, designed to measure latencies
@@ -26,7 +27,8 @@
  *
  * It then iterates this many times, reporting timestamp latencies
  * between each numbered step and for the whole cycle, and a running
- * average for all cycles run.
+ * average for all cycles run. The distribution of each step is
+ * reported at the end.
  */
 
 #define N_RUNS 1000
@@ -47,27 +49,31 @@ enum {
 	NUM_STAMP_STATES
 };
 
-uint32_t stamps[NUM_STAMP_STATES];
+timing_t stamps[NUM_STAMP_STATES];
 
-static inline int _stamp(int state)
-{
-	uint32_t t;
+BENCHMARK_DEFINE(bench_unpend, "sched unpend", N_RUNS);
+BENCHMARK_DEFINE(bench_ready, "sched ready", N_RUNS);
+BENCHMARK_DEFINE(bench_switch, "sched switch", N_RUNS);
+BENCHMARK_DEFINE(bench_pend, "sched pend", N_RUNS);
+BENCHMARK_DEFINE(bench_tot, "sched tot", N_RUNS);
 
-	/* In theory the TSC has much lower overhead and higher
-	 * precision.  In practice it's VERY jittery in recent qemu
-	 * versions and frankly too noisy to trust.
+static inline uint32_t _stamp(int state)
+{
+	/* On x86 the timing functions read the TSC. In theory it has
+	 * much lower overhead and higher precision. In practice it's
+	 * VERY jittery in recent qemu versions and frankly too noisy
+	 * to trust.
 	 */
-#ifdef CONFIG_X86
-	__asm__ volatile("rdtsc" : "=a"(t) : : "edx");
-#else
-	t = k_cycle_get_32();
-#endif
-
-	stamps[state] = t;
-	return t;
+	stamps[state] = timing_counter_get();
+	return (uint32_t)stamps[state];
+}
+
+static inline uint32_t delta(int from, int to)
+{
+	return (uint32_t)timing_cycles_get(&stamps[from], &stamps[to]);
 }
 
-/* #define stamp(s) printk("%s @ %d\n", #s, _stamp(s)) */
+/* #define stamp(s) printk("%s @ %u\n", #s, _stamp(s)) */
 #define stamp(s) _stamp(s)
 
 static void partner_fn(void *arg1, void *arg2, void *arg3)
@@ -98,6 +104,9 @@ void main(void)
 				     partner_fn, NULL, NULL, NULL,
 				     partner_prio, 0, K_NO_WAIT);
 
+	timing_init();
+	timing_start();
+
 	/* Let it start running and pend */
 	k_sleep(K_MSEC(100));
 
@@ -120,7 +129,11 @@ void main(void)
 		k_yield();
 		stamp(YIELDED);
 
-		uint32_t avg, whole = stamps[4] - stamps[0];
+		uint32_t unpend = delta(UNPENDING, UNPENDED_READYING);
+		uint32_t ready = delta(UNPENDED_READYING, READIED_YIELDING);
+		uint32_t swtch = delta(READIED_YIELDING, PARTNER_AWAKE_PENDING);
+		uint32_t pend = delta(PARTNER_AWAKE_PENDING, YIELDED);
+		uint32_t avg, whole = delta(UNPENDING, YIELDED);
 
 		if (++runs > N_SETTLE) {
 			/* Only compute averages after the first ~10
@@ -130,6 +143,12 @@ void main(void)
 			 */
 			tot += whole;
 			avg = tot / (runs - 10);
+
+			benchmark_sample_add(&bench_unpend, unpend);
+			benchmark_sample_add(&bench_ready, ready);
+			benchmark_sample_add(&bench_switch, swtch);
+			benchmark_sample_add(&bench_pend, pend);
+			benchmark_sample_add(&bench_tot, whole);
 		} else {
 			tot = 0U;
 			avg = 0U;
@@ -142,11 +161,16 @@ void main(void)
 		 * unpend 132 ready 257 switch 278 pend 321 tot 988 (avg 900)
 		 */
 		printk("unpend %4d ready %4d switch %4d pend %4d tot %4d (avg %4d)\n",
-		       stamps[1] - stamps[0],
-		       stamps[2] - stamps[1],
-		       stamps[3] - stamps[2],
-		       stamps[4] - stamps[3],
-		       whole, avg);
+		       unpend, ready, swtch, pend, whole, avg);
 	}
+
+	timing_stop();
+
+	benchmark_report(&bench_unpend);
+	benchmark_report(&bench_ready);
+	benchmark_report(&bench_switch);
+	benchmark_report(&bench_pend);
+	benchmark_report(&bench_tot);
+
 	printk("fin\n");
 }
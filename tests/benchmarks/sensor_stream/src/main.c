@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Accelerometer and gyroscope samples read from an emulated BMI160, over SPI
+ * and I2C: one sensor_sample_fetch() and sensor_channel_get() per sample,
+ * against draining its FIFO with sensor_read_frames() and decoding the batch,
+ * directly and through a stream iodev. The emulated FIFO is always full, so
+ * the throughput is bounded by the bus and the driver only.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/benchmark.h>
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/rtio/rtio_executor_simple.h>
+#include <zephyr/timing/timing.h>
+
+#define N_REPS 20
+#define N_FRAMES 64
+
+/* Room for the header, driver data and N_FRAMES frames of up to 12 bytes */
+#define FRAME_BUF_SIZE (64 + N_FRAMES * 12)
+
+static const struct device *const spi_bmi = DEVICE_DT_GET(DT_NODELABEL(bmi_spi));
+static const struct device *const i2c_bmi = DEVICE_DT_GET(DT_NODELABEL(bmi_i2c));
+
+SENSOR_DT_STREAM_IODEV_DEFINE(spi_bmi_stream, DT_NODELABEL(bmi_spi));
+SENSOR_DT_STREAM_IODEV_DEFINE(i2c_bmi_stream, DT_NODELABEL(bmi_i2c));
+
+RTIO_EXECUTOR_SIMPLE_DEFINE(bench_exec);
+RTIO_DEFINE(r_bench, (struct rtio_executor *)&bench_exec, 2, 2);
+
+static uint8_t frame_buf[FRAME_BUF_SIZE] __aligned(8);
+static uint32_t frame_buf_len;
+static int32_t accel[N_FRAMES * 3];
+static int32_t gyro[N_FRAMES * 3];
+static struct sensor_value values[N_FRAMES][6];
+
+static uint64_t bench_samples[N_REPS];
+static struct benchmark bench;
+
+static void read_fetch(void *arg)
+{
+	const struct device *dev = arg;
+
+	for (int i = 0; i < N_FRAMES; i++) {
+		(void)sensor_sample_fetch(dev);
+		(void)sensor_channel_get(dev, SENSOR_CHAN_ACCEL_XYZ, &values[i][0]);
+		(void)sensor_channel_get(dev, SENSOR_CHAN_GYRO_XYZ, &values[i][3]);
+	}
+}
+
+static void decode(const struct device *dev)
+{
+	const struct sensor_decoder_api *decoder;
+	int8_t shift;
+
+	(void)sensor_get_decoder(dev, &decoder);
+	(void)decoder->decode(frame_buf, SENSOR_CHAN_ACCEL_XYZ, 0, N_FRAMES, accel, &shift);
+	(void)decoder->decode(frame_buf, SENSOR_CHAN_GYRO_XYZ, 0, N_FRAMES, gyro, &shift);
+}
+
+static void read_stream(void *arg)
+{
+	const struct device *dev = arg;
+
+	(void)sensor_read_frames(dev, frame_buf, frame_buf_len);
+	decode(dev);
+}
+
+static void read_stream_rtio(void *arg)
+{
+	const struct rtio_iodev *iodev = arg;
+	const struct sensor_stream_iodev_data *data = iodev->data;
+	struct rtio *r = &r_bench;
+	struct rtio_sqe *sqe;
+
+	sqe = rtio_sqe_acquire(r);
+	rtio_sqe_prep_read(sqe, iodev, 0, frame_buf, frame_buf_len, NULL);
+	(void)rtio_submit(r, 1);
+	rtio_cqe_release_all(r);
+
+	decode(data->dev);
+}
+
+/* Runs a benchmark and reports its median throughput as well */
+static void measure(const char *name, benchmark_fn_t fn, void *arg)
+{
+	struct benchmark_stats stats;
+	uint64_t ns;
+
+	benchmark_init(&bench, name, bench_samples, ARRAY_SIZE(bench_samples));
+	benchmark_run(&bench, fn, arg, 2, N_REPS);
+	benchmark_report(&bench);
+
+	if (benchmark_stats_get(&bench, &stats) == 0) {
+		ns = timing_cycles_to_ns(stats.median);
+		if (ns > 0) {
+			benchmark_report_value(name, "frames/s",
+					       N_FRAMES * 1000000000ULL / ns);
+		}
+	}
+}
+
+void main(void)
+{
+	const struct sensor_frame_header *hdr = (const struct sensor_frame_header *)frame_buf;
+
+	/* Size reads to exactly N_FRAMES frames */
+	if (sensor_read_frames(spi_bmi, frame_buf, sizeof(frame_buf)) < 0) {
+		printk("cannot read frames\n");
+		return;
+	}
+	frame_buf_len = hdr->offset + N_FRAMES * hdr->frame_size;
+
+	printk("bmi160 emulator, %u frames of %u bytes per run\n", N_FRAMES, hdr->frame_size);
+
+	measure("spi fetch", read_fetch, (void *)spi_bmi);
+	measure("spi stream", read_stream, (void *)spi_bmi);
+	measure("spi stream rtio", read_stream_rtio, (void *)&spi_bmi_stream);
+	measure("i2c fetch", read_fetch, (void *)i2c_bmi);
+	measure("i2c stream", read_stream, (void *)i2c_bmi);
+	measure("i2c stream rtio", read_stream_rtio, (void *)&i2c_bmi_stream);
+
+	printk("fin\n");
+}
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Boot time load of the settings stored in NVS, on the flash simulator.
+ * settings_load() is compared with the former loader, which searched the
+ * NVS allocation table for the name and the value of every setting. The
+ * update of a stored setting is timed as well.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/benchmark.h>
+#include <zephyr/fs/nvs.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/storage/flash_map.h>
+#include <settings/settings_nvs.h>
+#include <stdio.h>
+
+#define N_REPS 5
+
+static const uint16_t n_settings[] = { 32, 64, 128, 192 };
+
+static uint64_t load_samples[N_REPS];
+static uint64_t lookup_samples[N_REPS];
+static uint64_t save_samples[N_REPS];
+static struct benchmark load_bench;
+static struct benchmark lookup_bench;
+static struct benchmark save_bench;
+static char load_name[ARRAY_SIZE(n_settings)][32];
+static char lookup_name[ARRAY_SIZE(n_settings)][32];
+static char save_name[ARRAY_SIZE(n_settings)][32];
+
+static struct nvs_fs *fs;
+static uint32_t loaded;
+
+static int bench_set(const char *key, size_t len, settings_read_cb read_cb,
+		     void *cb_arg)
+{
+	uint32_t val;
+
+	ARG_UNUSED(key);
+
+	if (len == sizeof(val) && read_cb(cb_arg, &val, sizeof(val)) == len) {
+		loaded++;
+	}
+
+	return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(bench, "bench", NULL, bench_set, NULL, NULL);
+
+static void load(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	(void)settings_load();
+}
+
+/* Loader before the single scan of the allocation table */
+static void lookup(void *arg)
+{
+	char name[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
+	uint16_t last_name_id;
+	uint32_t val;
+	ssize_t rc1, rc2;
+
+	ARG_UNUSED(arg);
+
+	if (nvs_read(fs, NVS_NAMECNT_ID, &last_name_id,
+		     sizeof(last_name_id)) < 0) {
+		return;
+	}
+
+	for (uint16_t id = last_name_id; id > NVS_NAMECNT_ID; id--) {
+		rc1 = nvs_read(fs, id, &name, sizeof(name));
+		rc2 = nvs_read(fs, id + NVS_NAME_ID_OFFSET, &val, sizeof(val));
+		if (rc1 > 0 && rc2 == sizeof(val)) {
+			loaded++;
+		}
+	}
+}
+
+static void save(void *arg)
+{
+	static uint32_t val;
+
+	ARG_UNUSED(arg);
+
+	val++;
+	(void)settings_save_one("bench/s0", &val, sizeof(val));
+}
+
+void main(void)
+{
+	const struct flash_area *fa;
+	char key[SETTINGS_MAX_NAME_LEN];
+	uint32_t saved = 0U;
+	int rc;
+
+	/* Start from empty storage, the simulated flash may be kept in a file */
+	rc = flash_area_open(FIXED_PARTITION_ID(storage_partition), &fa);
+	if (rc == 0) {
+		rc = flash_area_erase(fa, 0, fa->fa_size);
+		flash_area_close(fa);
+	}
+	if (rc == 0) {
+		rc = settings_subsys_init();
+	}
+	if (rc == 0) {
+		rc = settings_storage_get((void **)&fs);
+	}
+	if (rc) {
+		printk("settings init failed: %d\n", rc);
+		return;
+	}
+
+	printk("Settings NVS load, batches of %d settings\n",
+	       CONFIG_SETTINGS_NVS_LOAD_BATCH);
+
+	for (int i = 0; i < ARRAY_SIZE(n_settings); i++) {
+		for (; saved < n_settings[i]; saved++) {
+			snprintf(key, sizeof(key), "bench/s%u", saved);
+			rc = settings_save_one(key, &saved, sizeof(saved));
+			if (rc) {
+				printk("settings_save_one failed: %d\n", rc);
+				return;
+			}
+		}
+
+		snprintf(load_name[i], sizeof(load_name[i]),
+			 "settings_load n=%u", saved);
+		benchmark_init(&load_bench, load_name[i], load_samples,
+			       ARRAY_SIZE(load_samples));
+		loaded = 0U;
+		benchmark_run(&load_bench, load, NULL, 1, N_REPS);
+		if (loaded != saved * (N_REPS + 1)) {
+			printk("settings_load found %u settings\n", loaded);
+			return;
+		}
+		benchmark_report(&load_bench);
+
+		snprintf(lookup_name[i], sizeof(lookup_name[i]),
+			 "nvs_read per id n=%u", saved);
+		benchmark_init(&lookup_bench, lookup_name[i], lookup_samples,
+			       ARRAY_SIZE(lookup_samples));
+		benchmark_run(&lookup_bench, lookup, NULL, 1, N_REPS);
+		benchmark_report(&lookup_bench);
+
+		snprintf(save_name[i], sizeof(save_name[i]),
+			 "settings_save_one n=%u", saved);
+		benchmark_init(&save_bench, save_name[i], save_samples,
+			       ARRAY_SIZE(save_samples));
+		benchmark_run(&save_bench, save, NULL, 1, N_REPS);
+		benchmark_report(&save_bench);
+	}
+
+	printk("fin\n");
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/shell/shell_dummy.h>
+#include <zephyr/sys/util.h>
+#include <string.h>
+
+#define N_LINES 200
+#define N_RUNS 5
+
+/* Typical width of a listing such as "kernel threads" */
+static const char line[] =
+	"0x20001234 thread_name          prio 7  state pending   0x0040";
+
+static const struct shell *sh;
+
+static int cmd_bench_lines(const struct shell *shell, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	for (int i = 0; i < N_LINES; i++) {
+		shell_print(shell, "%3d %s", i % 1000, line);
+	}
+
+	return 0;
+}
+
+SHELL_CMD_REGISTER(bench_lines, NULL, "Print benchmark lines", cmd_bench_lines);
+
+static void report(const char *name, uint32_t cycles)
+{
+	uint32_t lines = N_LINES * N_RUNS;
+	/* "%3d " prefix, the line and the line ending */
+	uint32_t bytes = lines * (4 + strlen(line) + 2);
+
+	printk("%-10s lines %6u bytes %8u cycles %10u cycles/line %6u\n",
+	       name, lines, bytes, cycles, cycles / lines);
+}
+
+/* Output of a command handler, batched with CONFIG_SHELL_PRINTF_BATCH */
+static void bench_command(void)
+{
+	uint32_t start, cycles = 0;
+
+	for (int run = 0; run < N_RUNS; run++) {
+		shell_backend_dummy_clear_output(sh);
+		start = k_cycle_get_32();
+		(void)shell_execute_cmd(sh, "bench_lines");
+		cycles += k_cycle_get_32() - start;
+	}
+
+	report("command", cycles);
+}
+
+/* Output from another thread, interleaved with the command line */
+static void bench_async(const char *name, bool vt100)
+{
+	uint32_t start, cycles = 0;
+
+	(void)shell_use_vt100_set(sh, vt100);
+
+	for (int run = 0; run < N_RUNS; run++) {
+		shell_backend_dummy_clear_output(sh);
+		start = k_cycle_get_32();
+		for (int i = 0; i < N_LINES; i++) {
+			shell_print(sh, "%3d %s", i % 1000, line);
+		}
+		cycles += k_cycle_get_32() - start;
+	}
+
+	(void)shell_use_vt100_set(sh, true);
+
+	report(name, cycles);
+}
+
+void main(void)
+{
+	sh = shell_backend_dummy_get_ptr();
+
+	while (!shell_ready(sh)) {
+		k_msleep(1);
+	}
+
+	printk("Shell output throughput, batching %s, %u cycles/s\n",
+	       IS_ENABLED(CONFIG_SHELL_PRINTF_BATCH) ? "on" : "off",
+	       sys_clock_hw_cycles_per_sec());
+
+	bench_command();
+	bench_async("async", true);
+	bench_async("async-raw", false);
+
+	printk("fin\n");
+}
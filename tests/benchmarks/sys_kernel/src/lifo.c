@@ -142,8 +142,7 @@ int lifo_test(void)
 	k_fifo_init(&sync_fifo);
 
 	/* test get/wait & put thread functions between co-op threads */
-	fprintf(output_file, sz_test_case_fmt,
-			"LIFO #1");
+	test_case_begin("LIFO #1");
 	fprintf(output_file, sz_description,
 			"\n\tk_lifo_init"
 			"\n\tk_lifo_get(K_FOREVER)"
@@ -172,8 +171,7 @@ int lifo_test(void)
 	}
 
 	/* test get/yield & put thread functions between co-op threads */
-	fprintf(output_file, sz_test_case_fmt,
-			"LIFO #2");
+	test_case_begin("LIFO #2");
 	fprintf(output_file, sz_description,
 			"\n\tk_lifo_init"
 			"\n\tk_lifo_get(K_FOREVER)"
@@ -206,8 +204,7 @@ int lifo_test(void)
 	}
 
 	/* test get wait & put functions between co-op and preemptive threads */
-	fprintf(output_file, sz_test_case_fmt,
-			"LIFO #3");
+	test_case_begin("LIFO #3");
 	fprintf(output_file, sz_description,
 			"\n\tk_lifo_init"
 			"\n\tk_lifo_get(K_FOREVER)"
@@ -73,8 +73,7 @@ int mem_slab_test(void)
 	int return_value = 0;
 
 	/* Test k_mem_slab_alloc. */
-	fprintf(output_file, sz_test_case_fmt,
-		"Memslab #1");
+	test_case_begin("Memslab #1");
 	fprintf(output_file, sz_description,
 		"\n\tk_mem_slab_alloc");
 	printf(sz_test_start_fmt);
@@ -86,8 +85,7 @@ int mem_slab_test(void)
 	return_value += check_result(i, t);
 
 	/* Test k_mem_slab_free. */
-	fprintf(output_file, sz_test_case_fmt,
-		"Memslab #2");
+	test_case_begin("Memslab #2");
 	fprintf(output_file, sz_description,
 		"\n\tk_mem_slab_free");
 	printf(sz_test_start_fmt);
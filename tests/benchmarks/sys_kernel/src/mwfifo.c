@@ -143,8 +143,7 @@ int fifo_test(void)
 	k_fifo_init(&sync_fifo);
 
 	/* test get wait & put thread functions between co-op threads */
-	fprintf(output_file, sz_test_case_fmt,
-			"FIFO #1");
+	test_case_begin("FIFO #1");
 	fprintf(output_file, sz_description,
 			"\n\tk_fifo_init"
 			"\n\tk_fifo_get(K_FOREVER)"
@@ -172,8 +171,7 @@ int fifo_test(void)
 	}
 
 	/* test get/yield & put thread functions between co-op threads */
-	fprintf(output_file, sz_test_case_fmt,
-			"FIFO #2");
+	test_case_begin("FIFO #2");
 	fprintf(output_file, sz_description,
 			"\n\tk_fifo_init"
 			"\n\tk_fifo_get(K_FOREVER)"
@@ -204,8 +202,7 @@ int fifo_test(void)
 	}
 
 	/* test get wait & put functions between co-op and preemptive threads */
-	fprintf(output_file, sz_test_case_fmt,
-			"FIFO #3");
+	test_case_begin("FIFO #3");
 	fprintf(output_file, sz_description,
 			"\n\tk_fifo_init"
 			"\n\tk_fifo_get(K_FOREVER)"
@@ -110,8 +110,7 @@ int sema_test(void)
 	int i = 0;
 	int return_value = 0;
 
-	fprintf(output_file, sz_test_case_fmt,
-			"Semaphore #1");
+	test_case_begin("Semaphore #1");
 	fprintf(output_file, sz_description,
 			"\n\tk_sem_init"
 			"\n\tk_sem_take(K_FOREVER)"
@@ -133,8 +132,7 @@ int sema_test(void)
 
 	return_value += check_result(i, t);
 
-	fprintf(output_file, sz_test_case_fmt,
-			"Semaphore #2");
+	test_case_begin("Semaphore #2");
 	fprintf(output_file, sz_description,
 			"\n\tk_sem_init"
 			"\n\tk_sem_take(TICKS_NONE)"
@@ -158,8 +156,7 @@ int sema_test(void)
 
 	return_value += check_result(i, t);
 
-	fprintf(output_file, sz_test_case_fmt,
-			"Semaphore #3");
+	test_case_begin("Semaphore #3");
 	fprintf(output_file, sz_description,
 			"\n\tk_sem_init"
 			"\n\tk_sem_take(K_FOREVER)"
@@ -140,8 +140,7 @@ int stack_test(void)
 	int return_value = 0;
 
 	/* test get wait & put stack functions between co-op threads */
-	fprintf(output_file, sz_test_case_fmt,
-			"Stack #1");
+	test_case_begin("Stack #1");
 	fprintf(output_file, sz_description,
 			"\n\tk_stack_init"
 			"\n\tk_stack_pop(K_FOREVER)"
@@ -164,8 +163,7 @@ int stack_test(void)
 	return_value += check_result(i, t);
 
 	/* test get/yield & put stack functions between co-op threads */
-	fprintf(output_file, sz_test_case_fmt,
-			"Stack #2");
+	test_case_begin("Stack #2");
 	fprintf(output_file, sz_description,
 			"\n\tk_stack_init"
 			"\n\tk_stack_pop(K_FOREVER)"
@@ -193,8 +191,7 @@ int stack_test(void)
 	/* test get wait & put stack functions across co-op and preemptive
 	 * threads
 	 */
-	fprintf(output_file, sz_test_case_fmt,
-			"Stack #3");
+	test_case_begin("Stack #3");
 	fprintf(output_file, sz_description,
 			"\n\tk_stack_init"
 			"\n\tk_stack_pop(K_FOREVER)"
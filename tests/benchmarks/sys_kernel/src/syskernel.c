@@ -8,6 +8,7 @@
 
 #include <zephyr/kernel.h>
 #include <zephyr/tc_util.h>
+#include <zephyr/benchmark.h>
 
 #include "syskernel.h"
 
@@ -32,6 +33,21 @@ uint32_t tm_off;
 /* Holds the loop count that need to be carried out. */
 uint32_t number_of_loops;
 
+/* Name of the running test case, used in the benchmark report */
+static const char *test_case_name;
+
+/**
+ *
+ * @brief Announce a test case
+ *
+ * @param name   Name of the test case.
+ */
+void test_case_begin(const char *name)
+{
+	test_case_name = name;
+	fprintf(output_file, sz_test_case_fmt, name);
+}
+
 /**
  *
  * @brief Get the time ticks before test starts
@@ -59,6 +75,8 @@ void begin_test(void)
  */
 int check_result(int i, uint32_t t)
 {
+	uint32_t ns;
+
 	/*
 	 * bench_test_end checks timestamp_check static variable.
 	 * bench_test_start modifies it
@@ -77,13 +95,15 @@ int check_result(int i, uint32_t t)
 		fprintf(output_file, sz_case_end_fmt);
 		return 0;
 	}
+	ns = TIME_STAMP_TO_NS_AVG(t, number_of_loops);
 	fprintf(output_file, sz_case_result_fmt, sz_success);
 	fprintf(output_file, sz_case_details_fmt,
 			"Average time for 1 iteration: ");
-	fprintf(output_file, sz_case_timing_fmt,
-			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(t, number_of_loops));
+	fprintf(output_file, sz_case_timing_fmt, ns);
 
 	fprintf(output_file, sz_case_end_fmt);
+	fprintf(output_file, "\n");
+	benchmark_report_value(test_case_name, "ns", ns);
 	return 1;
 }
 
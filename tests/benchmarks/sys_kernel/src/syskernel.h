@@ -50,6 +50,7 @@ extern uint32_t number_of_loops;
 #define sz_case_end_fmt		"\nEND TEST CASE"
 #define sz_case_timing_fmt	"%u nSec"
 
+void test_case_begin(const char *name);
 int check_result(int i, uint32_t ticks);
 
 int sema_test(void);
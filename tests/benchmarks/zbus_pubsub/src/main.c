@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Publish/subscribe throughput of zbus channels for large messages. The
+ * publisher fills each message and a subscriber consumes it, touching its
+ * first and last bytes, through a copying channel (zbus_chan_pub() and
+ * zbus_chan_read()), a loan channel (zbus_chan_loan(), zbus_chan_pub_loan()
+ * and a message reference subscriber) and a latest value channel, which is
+ * read without waiting for notifications.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/benchmark.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/zbus/zbus.h>
+#include <stdio.h>
+
+#define N_REPS 10
+#define N_MSGS 64
+
+struct msg_1k {
+	uint8_t data[1024];
+};
+
+struct msg_4k {
+	uint8_t data[4096];
+};
+
+#define BENCH_CHANNELS(_type)                                                                      \
+	ZBUS_CHAN_DEFINE(copy_chan_##_type, struct _type, NULL, NULL,                              \
+			 ZBUS_OBSERVERS(copy_sub_##_type), ZBUS_MSG_INIT(0));                      \
+	ZBUS_LOAN_CHAN_DEFINE(loan_chan_##_type, struct _type, NULL, NULL,                         \
+			      ZBUS_OBSERVERS(ref_sub_##_type), ZBUS_MSG_INIT(0), 4);               \
+	ZBUS_LATEST_CHAN_DEFINE(latest_chan_##_type, struct _type, NULL, NULL,                     \
+				ZBUS_OBSERVERS_EMPTY, ZBUS_MSG_INIT(0), 3);                        \
+	ZBUS_SUBSCRIBER_DEFINE(copy_sub_##_type, 1);                                               \
+	ZBUS_MSG_SUBSCRIBER_DEFINE(ref_sub_##_type, 1)
+
+BENCH_CHANNELS(msg_1k);
+BENCH_CHANNELS(msg_4k);
+
+struct pubsub {
+	const struct zbus_channel *copy_chan;
+	const struct zbus_channel *loan_chan;
+	const struct zbus_channel *latest_chan;
+	const struct zbus_observer *copy_sub;
+	const struct zbus_observer *ref_sub;
+	size_t size;
+};
+
+static struct pubsub pubsubs[] = {
+	{&copy_chan_msg_1k, &loan_chan_msg_1k, &latest_chan_msg_1k, &copy_sub_msg_1k,
+	 &ref_sub_msg_1k, sizeof(struct msg_1k)},
+	{&copy_chan_msg_4k, &loan_chan_msg_4k, &latest_chan_msg_4k, &copy_sub_msg_4k,
+	 &ref_sub_msg_4k, sizeof(struct msg_4k)},
+};
+
+static uint8_t pub_buf[4096];
+static uint8_t sub_buf[4096];
+static uint64_t samples[N_REPS];
+static struct benchmark bench;
+static volatile uint32_t sink;
+
+static void consume(const uint8_t *msg, size_t size)
+{
+	sink += msg[0] + msg[size - 1];
+}
+
+static void pubsub_copy(void *arg)
+{
+	struct pubsub *ps = arg;
+	const struct zbus_channel *chan;
+
+	for (int i = 0; i < N_MSGS; i++) {
+		memset(pub_buf, i, ps->size);
+		(void)zbus_chan_pub(ps->copy_chan, pub_buf, K_FOREVER);
+		(void)zbus_sub_wait(ps->copy_sub, &chan, K_FOREVER);
+		(void)zbus_chan_read(chan, sub_buf, K_FOREVER);
+		consume(sub_buf, ps->size);
+	}
+}
+
+static void pubsub_loan(void *arg)
+{
+	struct pubsub *ps = arg;
+	struct zbus_msg_ref ref;
+	void *msg;
+
+	for (int i = 0; i < N_MSGS; i++) {
+		if (zbus_chan_loan(ps->loan_chan, &msg, K_FOREVER)) {
+			return;
+		}
+		memset(msg, i, ps->size);
+		(void)zbus_chan_pub_loan(ps->loan_chan, msg, K_FOREVER);
+		(void)zbus_sub_wait_msg(ps->ref_sub, &ref, K_FOREVER);
+		consume(ref.msg, ps->size);
+		zbus_chan_release(ref.chan, ref.msg);
+	}
+}
+
+static void pubsub_latest(void *arg)
+{
+	struct pubsub *ps = arg;
+
+	for (int i = 0; i < N_MSGS; i++) {
+		memset(pub_buf, i, ps->size);
+		(void)zbus_chan_pub(ps->latest_chan, pub_buf, K_FOREVER);
+		(void)zbus_chan_read(ps->latest_chan, sub_buf, K_NO_WAIT);
+		consume(sub_buf, ps->size);
+	}
+}
+
+/* Runs a benchmark and reports its median message rate as well */
+static void measure(const char *what, benchmark_fn_t fn, struct pubsub *ps)
+{
+	static char names[8][40];
+	static int n;
+	struct benchmark_stats stats;
+	uint64_t ns;
+
+	snprintf(names[n], sizeof(names[n]), "%s %zu", what, ps->size);
+	benchmark_init(&bench, names[n], samples, ARRAY_SIZE(samples));
+	benchmark_run(&bench, fn, ps, 1, N_REPS);
+	benchmark_report(&bench);
+
+	if (benchmark_stats_get(&bench, &stats) == 0) {
+		ns = timing_cycles_to_ns(stats.median);
+		if (ns > 0) {
+			benchmark_report_value(names[n], "msg/s", N_MSGS * 1000000000ULL / ns);
+		}
+	}
+
+	n = (n + 1) % ARRAY_SIZE(names);
+}
+
+void main(void)
+{
+	printk("zbus publish/subscribe, %u messages per sample\n", N_MSGS);
+
+	for (int i = 0; i < ARRAY_SIZE(pubsubs); i++) {
+		measure("copy", pubsub_copy, &pubsubs[i]);
+		measure("loan", pubsub_loan, &pubsubs[i]);
+		measure("latest", pubsub_latest, &pubsubs[i]);
+	}
+
+	printk("fin\n");
+}
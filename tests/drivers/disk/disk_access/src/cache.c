@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/storage/disk_access.h>
+#include <string.h>
+
+#if IS_ENABLED(CONFIG_DISK_CACHE)
+
+#if IS_ENABLED(CONFIG_DISK_DRIVER_SDMMC)
+#define DISK_NAME CONFIG_SDMMC_VOLUME_NAME
+#elif IS_ENABLED(CONFIG_DISK_DRIVER_RAM)
+#define DISK_NAME CONFIG_DISK_RAM_VOLUME_NAME
+#endif
+
+#define SECTOR_SIZE CONFIG_DISK_CACHE_SECTOR_SIZE
+#define BLOCKS CONFIG_DISK_CACHE_BLOCKS
+#define READ_AHEAD CONFIG_DISK_CACHE_READ_AHEAD
+
+/* Sectors read to evict the ones of a previous test, following the sectors
+ * the disk_driver tests use at the middle of the disk.
+ */
+#define SCRUB_SECTOR 128
+/* Sectors the tests use */
+#define TEST_SECTOR (SCRUB_SECTOR + 2 * BLOCKS + READ_AHEAD + 2)
+
+static const char *disk_pdrv = DISK_NAME;
+
+static uint8_t wbuf[(READ_AHEAD + 2) * SECTOR_SIZE];
+static uint8_t rbuf[(READ_AHEAD + 2) * SECTOR_SIZE];
+
+static void stats_get(struct disk_cache_stats *stats)
+{
+	zassert_ok(disk_access_cache_stats_get(disk_pdrv, stats));
+}
+
+static void read_one(uint32_t sector)
+{
+	zassert_ok(disk_access_read(disk_pdrv, rbuf, sector, 1));
+}
+
+static void fill(uint8_t *buf, uint32_t num_sectors, uint8_t seed)
+{
+	for (int i = 0; i < num_sectors * SECTOR_SIZE; i++) {
+		buf[i] = seed + i;
+	}
+}
+
+/* Fill the cache blocks with sectors the tests do not use, then the
+ * read-ahead window by a sequential read.
+ */
+static void cache_scrub(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	read_one(0);
+	for (int i = 0; i < BLOCKS; i++) {
+		read_one(SCRUB_SECTOR + 2 * i);
+	}
+	read_one(SCRUB_SECTOR + 2 * BLOCKS - 1);
+}
+
+ZTEST(disk_cache, test_hit)
+{
+	struct disk_cache_stats before, after;
+
+	fill(wbuf, 2, 0x10);
+	zassert_ok(disk_access_write(disk_pdrv, wbuf, TEST_SECTOR, 2));
+
+	stats_get(&before);
+	read_one(TEST_SECTOR);
+	zassert_mem_equal(rbuf, wbuf, SECTOR_SIZE);
+	memset(rbuf, 0, sizeof(rbuf));
+	read_one(TEST_SECTOR);
+	zassert_mem_equal(rbuf, wbuf, SECTOR_SIZE);
+	stats_get(&after);
+
+	zassert_equal(after.misses - before.misses, 1);
+	zassert_equal(after.hits - before.hits, 1);
+}
+
+ZTEST(disk_cache, test_read_ahead)
+{
+	struct disk_cache_stats before, after;
+
+	if (READ_AHEAD < 2) {
+		ztest_test_skip();
+	}
+
+	fill(wbuf, READ_AHEAD + 1, 0x20);
+	zassert_ok(disk_access_write(disk_pdrv, wbuf, TEST_SECTOR,
+				     READ_AHEAD + 1));
+
+	stats_get(&before);
+	for (int i = 0; i <= READ_AHEAD; i++) {
+		read_one(TEST_SECTOR + i);
+		zassert_mem_equal(rbuf, &wbuf[i * SECTOR_SIZE], SECTOR_SIZE,
+				  "sector %d", i);
+	}
+	stats_get(&after);
+
+	/* The first sector is cached alone, the second one is the first
+	 * sequential read and fills the read-ahead window.
+	 */
+	zassert_equal(after.read_ahead - before.read_ahead, 1);
+	zassert_equal(after.misses - before.misses, 2);
+	zassert_equal(after.hits - before.hits, READ_AHEAD - 1);
+
+	/* Writes update the window */
+	fill(wbuf, 1, 0x30);
+	zassert_ok(disk_access_write(disk_pdrv, wbuf, TEST_SECTOR + 2, 1));
+	read_one(TEST_SECTOR + 2);
+	zassert_mem_equal(rbuf, wbuf, SECTOR_SIZE);
+}
+
+ZTEST(disk_cache, test_write_back)
+{
+	struct disk_cache_stats before, after;
+
+	if (!IS_ENABLED(CONFIG_DISK_CACHE_WRITE_BACK)) {
+		ztest_test_skip();
+	}
+
+	fill(wbuf, 1, 0x40);
+
+	stats_get(&before);
+	zassert_ok(disk_access_write(disk_pdrv, wbuf, TEST_SECTOR, 1));
+	zassert_ok(disk_access_write(disk_pdrv, wbuf, TEST_SECTOR, 1));
+	read_one(TEST_SECTOR);
+	zassert_mem_equal(rbuf, wbuf, SECTOR_SIZE);
+	stats_get(&after);
+
+	zassert_equal(after.writes_deferred - before.writes_deferred, 2);
+	zassert_equal(after.write_backs - before.write_backs, 0);
+	zassert_equal(after.hits - before.hits, 1);
+
+	zassert_ok(disk_access_ioctl(disk_pdrv, DISK_IOCTL_CTRL_SYNC, NULL));
+	stats_get(&after);
+	zassert_equal(after.write_backs - before.write_backs, 1);
+
+	/* Nothing left to write back */
+	zassert_ok(disk_access_ioctl(disk_pdrv, DISK_IOCTL_CTRL_SYNC, NULL));
+	stats_get(&before);
+	zassert_equal(after.write_backs, before.write_backs);
+}
+
+ZTEST(disk_cache, test_eviction)
+{
+	struct disk_cache_stats before, after;
+
+	if (!IS_ENABLED(CONFIG_DISK_CACHE_WRITE_BACK)) {
+		ztest_test_skip();
+	}
+
+	fill(wbuf, 1, 0x50);
+
+	stats_get(&before);
+	zassert_ok(disk_access_write(disk_pdrv, wbuf, TEST_SECTOR, 1));
+
+	/* Push the written sector out of the cache */
+	for (int i = 0; i < BLOCKS; i++) {
+		read_one(SCRUB_SECTOR + 2 * i);
+	}
+	stats_get(&after);
+	zassert_equal(after.write_backs - before.write_backs, 1);
+	zassert_true(after.evictions - before.evictions >= 1);
+
+	/* Read back from the disk */
+	memset(rbuf, 0, sizeof(rbuf));
+	read_one(TEST_SECTOR);
+	zassert_mem_equal(rbuf, wbuf, SECTOR_SIZE);
+	stats_get(&before);
+	zassert_equal(before.misses - after.misses, 1);
+}
+
+/* A sector written back after a read-ahead covering it is not read from
+ * the stale window.
+ */
+ZTEST(disk_cache, test_read_ahead_dirty)
+{
+	struct disk_cache_stats before, after;
+
+	if (!IS_ENABLED(CONFIG_DISK_CACHE_WRITE_BACK) || (READ_AHEAD < 2)) {
+		ztest_test_skip();
+	}
+
+	fill(wbuf, READ_AHEAD + 1, 0x80);
+	zassert_ok(disk_access_write(disk_pdrv, wbuf, TEST_SECTOR,
+				     READ_AHEAD + 1));
+
+	/* Only in the cache */
+	fill(wbuf, 1, 0x90);
+	zassert_ok(disk_access_write(disk_pdrv, wbuf, TEST_SECTOR + 2, 1));
+
+	/* Fill the window from the sector before */
+	read_one(TEST_SECTOR);
+	read_one(TEST_SECTOR + 1);
+
+	/* Evict all the blocks with sectors no test caches */
+	stats_get(&before);
+	for (int i = 0; i < BLOCKS; i++) {
+		read_one(SCRUB_SECTOR + 2 * i + 1);
+	}
+	stats_get(&after);
+	zassert_equal(after.write_backs - before.write_backs, 1);
+
+	memset(rbuf, 0, sizeof(rbuf));
+	read_one(TEST_SECTOR + 2);
+	zassert_mem_equal(rbuf, wbuf, SECTOR_SIZE);
+}
+
+ZTEST(disk_cache, test_write_through_update)
+{
+	fill(wbuf, 1, 0x60);
+	zassert_ok(disk_access_write(disk_pdrv, wbuf, TEST_SECTOR, 1));
+	read_one(TEST_SECTOR);
+
+	/* Multi sector writes go to the disk and refresh cached sectors */
+	fill(wbuf, 4, 0x70);
+	zassert_ok(disk_access_write(disk_pdrv, wbuf, TEST_SECTOR, 4));
+	zassert_ok(disk_access_read(disk_pdrv, rbuf, TEST_SECTOR, 4));
+	zassert_mem_equal(rbuf, wbuf, 4 * SECTOR_SIZE);
+
+	zassert_ok(disk_access_ioctl(disk_pdrv, DISK_IOCTL_CTRL_SYNC, NULL));
+	zassert_ok(disk_access_read(disk_pdrv, rbuf, TEST_SECTOR, 1));
+	zassert_mem_equal(rbuf, wbuf, SECTOR_SIZE);
+}
+
+static void *disk_cache_setup(void)
+{
+	zassert_ok(disk_access_init(disk_pdrv));
+	zassert_equal(disk_access_cache_stats_get("nonexistent", NULL),
+		      -EINVAL);
+
+	return NULL;
+}
+
+ZTEST_SUITE(disk_cache, NULL, disk_cache_setup, cache_scrub, NULL, NULL);
+
+#endif /* CONFIG_DISK_CACHE */
@@ -308,6 +308,80 @@ ZTEST(flash_sim_api, test_get_mock)
 #endif
 }
 
+#ifdef CONFIG_FLASH_ASYNC
+struct async_ctx {
+	struct flash_async_req req[3];
+	struct k_sem done;
+	int order[3];
+	int result[3];
+	int count;
+};
+
+static void async_cb(const struct device *dev, struct flash_async_req *req,
+		     int result)
+{
+	struct async_ctx *ctx = req->user_data;
+	int idx = req - ctx->req;
+
+	zassert_equal_ptr(dev, flash_dev, "unexpected device");
+
+	ctx->order[ctx->count++] = idx;
+	ctx->result[idx] = result;
+	k_sem_give(&ctx->done);
+}
+
+ZTEST(flash_sim_api, test_async)
+{
+	static struct async_ctx ctx;
+	const off_t off = FLASH_SIMULATOR_BASE_OFFSET + FLASH_SIMULATOR_ERASE_UNIT;
+	uint32_t data[4] = { 0x01020304, 0x05060708, 0x090a0b0c, 0x0d0e0f10 };
+	uint32_t rd[ARRAY_SIZE(data)];
+	int rc;
+
+	k_sem_init(&ctx.done, 0, ARRAY_SIZE(ctx.req));
+	for (int i = 0; i < ARRAY_SIZE(ctx.req); i++) {
+		ctx.req[i].user_data = &ctx;
+	}
+
+	/* Queued requests are executed in order: the write sees the erased
+	 * unit and the read the written data.
+	 */
+	memset(rd, 0, sizeof(rd));
+	rc = flash_erase_async(flash_dev, &ctx.req[0], off,
+			       FLASH_SIMULATOR_ERASE_UNIT, async_cb);
+	zassert_equal(0, rc, "flash_erase_async failed: %d", rc);
+	rc = flash_write_async(flash_dev, &ctx.req[1], off, data, sizeof(data),
+			       async_cb);
+	zassert_equal(0, rc, "flash_write_async failed: %d", rc);
+	rc = flash_read_async(flash_dev, &ctx.req[2], off, rd, sizeof(rd),
+			      async_cb);
+	zassert_equal(0, rc, "flash_read_async failed: %d", rc);
+
+	for (int i = 0; i < ARRAY_SIZE(ctx.req); i++) {
+		zassert_equal(0, k_sem_take(&ctx.done, K_SECONDS(1)),
+			      "request not completed");
+		zassert_equal(i, ctx.order[i], "completed out of order");
+		zassert_equal(0, ctx.result[i], "request %d failed: %d", i,
+			      ctx.result[i]);
+	}
+	zassert_mem_equal(data, rd, sizeof(data), "read data differs");
+
+	/* Errors are reported through the callback */
+	ctx.count = 0;
+	rc = flash_write_async(flash_dev, &ctx.req[0], off, data, sizeof(data),
+			       async_cb);
+	zassert_equal(0, rc, "flash_write_async failed: %d", rc);
+	zassert_equal(0, k_sem_take(&ctx.done, K_SECONDS(1)),
+		      "request not completed");
+	zassert_equal(-EIO, ctx.result[0], "double write not reported: %d",
+		      ctx.result[0]);
+
+	ctx.req[0].op = FLASH_ASYNC_ERASE + 1;
+	rc = flash_submit(flash_dev, &ctx.req[0]);
+	zassert_equal(-EINVAL, rc, "invalid request accepted: %d", rc);
+}
+#endif /* CONFIG_FLASH_ASYNC */
+
 void *flash_sim_setup(void)
 {
 	test_init();
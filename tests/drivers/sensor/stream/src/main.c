@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/rtio/rtio_executor_simple.h>
+
+#define N_FRAMES 32
+
+/* Room for the header, driver data and N_FRAMES frames of up to 12 bytes */
+#define FRAME_BUF_SIZE (64 + N_FRAMES * 12)
+
+struct sensor_stream_fixture {
+	const struct device *accel_spi;
+	const struct device *accel_i2c;
+};
+
+static enum sensor_channel channel[] = {
+	SENSOR_CHAN_ACCEL_X,
+	SENSOR_CHAN_ACCEL_Y,
+	SENSOR_CHAN_ACCEL_Z,
+	SENSOR_CHAN_GYRO_X,
+	SENSOR_CHAN_GYRO_Y,
+	SENSOR_CHAN_GYRO_Z,
+};
+
+static uint8_t frame_buf[FRAME_BUF_SIZE] __aligned(8);
+static int32_t values[FRAME_BUF_SIZE / 2];
+
+SENSOR_DT_STREAM_IODEV_DEFINE(stream_spi, DT_ALIAS(accel_0));
+
+RTIO_EXECUTOR_SIMPLE_DEFINE(stream_exec);
+RTIO_DEFINE(r_stream, (struct rtio_executor *)&stream_exec, 4, 4);
+
+/* Check every frame in frame_buf decodes to the value of sensor_channel_get() */
+static void check_frames(const struct device *dev, uint16_t count)
+{
+	const struct sensor_frame_header *hdr = (const struct sensor_frame_header *)frame_buf;
+	const struct sensor_decoder_api *decoder;
+	struct sensor_value val;
+	int8_t shift;
+	int64_t expected, micro;
+
+	zassert_equal(hdr->frame_count, count, "expected %u frames, got %u", count,
+		      hdr->frame_count);
+	zassert_ok(sensor_get_decoder(dev, &decoder));
+	zassert_ok(sensor_sample_fetch(dev));
+
+	for (int i = 0; i < ARRAY_SIZE(channel); i++) {
+		zassert_ok(sensor_channel_get(dev, channel[i], &val));
+		expected = (int64_t)val.val1 * 1000000 + val.val2;
+
+		zassert_equal(decoder->decode(frame_buf, channel[i], 0, count, values, &shift),
+			      count);
+		for (int j = 0; j < count; j++) {
+			micro = sensor_q31_to_micro(values[j], shift);
+			zassert_within(micro, expected, 1, "frame %d: expected %lld, got %lld",
+				       j, expected, micro);
+		}
+	}
+}
+
+static void test_read_frames(const struct device *dev)
+{
+	const struct sensor_frame_header *hdr = (const struct sensor_frame_header *)frame_buf;
+	int rc;
+
+	zassert_true(device_is_ready(dev), "sensor not ready");
+
+	rc = sensor_read_frames(dev, frame_buf, sizeof(frame_buf));
+	zassert_true(rc > 0, "read failed %d", rc);
+	zassert_equal(rc, hdr->offset + hdr->frame_count * hdr->frame_size);
+	zassert_true(hdr->frame_count >= N_FRAMES, "only %u frames", hdr->frame_count);
+	zassert_true(hdr->period_ns > 0);
+	zassert_true(sensor_frame_timestamp(frame_buf, hdr->frame_count - 1) >=
+		     sensor_frame_timestamp(frame_buf, 0));
+
+	check_frames(dev, hdr->frame_count);
+}
+
+ZTEST_F(sensor_stream, test_read_frames_spi)
+{
+	test_read_frames(fixture->accel_spi);
+}
+
+ZTEST_F(sensor_stream, test_read_frames_i2c)
+{
+	test_read_frames(fixture->accel_i2c);
+}
+
+ZTEST_F(sensor_stream, test_decode_xyz)
+{
+	const struct sensor_frame_header *hdr = (const struct sensor_frame_header *)frame_buf;
+	const struct sensor_decoder_api *decoder;
+	int32_t xyz[3 * 4];
+	int32_t x;
+	int8_t shift;
+
+	zassert_true(sensor_read_frames(fixture->accel_spi, frame_buf, sizeof(frame_buf)) > 0);
+	zassert_ok(sensor_get_decoder(fixture->accel_spi, &decoder));
+
+	zassert_equal(decoder->decode(frame_buf, SENSOR_CHAN_ACCEL_XYZ, 2, 4, xyz, &shift), 4);
+	for (int i = 0; i < 4; i++) {
+		zassert_equal(decoder->decode(frame_buf, SENSOR_CHAN_ACCEL_Y, 2 + i, 1, &x,
+					      &shift), 1);
+		zassert_equal(xyz[3 * i + 1], x);
+	}
+
+	/* Decoding stops at the last frame */
+	zassert_equal(decoder->decode(frame_buf, SENSOR_CHAN_GYRO_X, hdr->frame_count - 1, 4,
+				      values, &shift), 1);
+	zassert_equal(decoder->decode(frame_buf, SENSOR_CHAN_DIE_TEMP, 0, 1, values, &shift),
+		      -ENOTSUP);
+}
+
+ZTEST_F(sensor_stream, test_buffer_too_small)
+{
+	zassert_equal(sensor_read_frames(fixture->accel_spi, frame_buf,
+					 sizeof(struct sensor_frame_header)),
+		      -ENOMEM);
+}
+
+ZTEST_F(sensor_stream, test_rtio)
+{
+	struct rtio *r = &r_stream;
+	struct rtio_sqe *sqe;
+	struct rtio_cqe *cqe;
+	const struct sensor_frame_header *hdr = (const struct sensor_frame_header *)frame_buf;
+	int result;
+
+	sqe = rtio_sqe_acquire(r);
+	zassert_not_null(sqe);
+	rtio_sqe_prep_read(sqe, &stream_spi, 0, frame_buf, sizeof(frame_buf), frame_buf);
+
+	zassert_ok(rtio_submit(r, 1));
+
+	cqe = rtio_cqe_consume(r);
+	zassert_not_null(cqe);
+	zassert_equal(cqe->userdata, frame_buf);
+	result = cqe->result;
+	rtio_cqe_release_all(r);
+
+	zassert_equal(result, hdr->offset + hdr->frame_count * hdr->frame_size);
+	check_frames(fixture->accel_spi, hdr->frame_count);
+}
+
+static void *sensor_stream_setup(void)
+{
+	static struct sensor_stream_fixture fixture = {
+		.accel_spi = DEVICE_DT_GET(DT_ALIAS(accel_0)),
+		.accel_i2c = DEVICE_DT_GET(DT_ALIAS(accel_1)),
+	};
+
+	return &fixture;
+}
+
+ZTEST_SUITE(sensor_stream, NULL, sensor_stream_setup, NULL, NULL, NULL);
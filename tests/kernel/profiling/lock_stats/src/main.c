@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <string.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define HOLD_US 1000
+
+K_MUTEX_DEFINE(static_mutex);
+K_SEM_DEFINE(static_sem, 0, 1);
+
+static K_THREAD_STACK_DEFINE(helper_stack, STACK_SIZE);
+static struct k_thread helper_thread;
+
+static struct k_mutex runtime_mutex;
+static struct k_sem runtime_sem;
+static struct k_spinlock spin;
+static struct k_lock_stats spin_stats;
+
+static void mutex_waiter(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	zassert_ok(k_mutex_lock(p1, K_FOREVER));
+	k_mutex_unlock(p1);
+}
+
+static void mutex_holder(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	zassert_ok(k_mutex_lock(p1, K_FOREVER));
+	k_sleep(K_MSEC(50));
+	k_mutex_unlock(p1);
+}
+
+static void sem_waiter(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	zassert_ok(k_sem_take(p1, K_FOREVER));
+}
+
+static k_tid_t helper_start(k_thread_entry_t entry, void *arg)
+{
+	k_tid_t tid;
+
+	tid = k_thread_create(&helper_thread, helper_stack, STACK_SIZE, entry,
+			      arg, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	/* Let the helper run until it blocks */
+	k_msleep(1);
+
+	return tid;
+}
+
+ZTEST(lock_stats, test_mutex_contention)
+{
+	const struct k_lock_stats *st = &static_mutex.lock_stats;
+	k_tid_t tid;
+
+	zassert_ok(k_mutex_lock(&static_mutex, K_FOREVER));
+	tid = helper_start(mutex_waiter, &static_mutex);
+	k_busy_wait(HOLD_US);
+	k_mutex_unlock(&static_mutex);
+	k_thread_join(tid, K_FOREVER);
+
+	zassert_equal(st->acquisitions, 2);
+	zassert_equal(st->contended, 1);
+	zassert_equal(st->timeouts, 0);
+	zassert_true(st->hold_max > 0);
+	zassert_true(st->hold_total >= st->hold_max);
+	zassert_true(st->wait_total >= st->wait_max);
+#if CONFIG_LOCK_STATS_TOP_WAITERS > 0
+	zassert_equal_ptr(st->waiters[0].thread, tid);
+	zassert_equal(st->waiters[0].count, 1);
+	zassert_equal(st->waiters[0].wait_total, st->wait_total);
+#endif
+
+	/* Recursive locking counts a single acquisition */
+	zassert_ok(k_mutex_lock(&static_mutex, K_FOREVER));
+	zassert_ok(k_mutex_lock(&static_mutex, K_FOREVER));
+	k_mutex_unlock(&static_mutex);
+	k_mutex_unlock(&static_mutex);
+	zassert_equal(st->acquisitions, 3);
+}
+
+ZTEST(lock_stats, test_mutex_timeout)
+{
+	const struct k_lock_stats *st = &runtime_mutex.lock_stats;
+	k_tid_t tid;
+
+	tid = helper_start(mutex_holder, &runtime_mutex);
+	zassert_equal(k_mutex_lock(&runtime_mutex, K_MSEC(10)), -EAGAIN);
+	k_thread_join(tid, K_FOREVER);
+
+	zassert_equal(st->acquisitions, 1);
+	zassert_equal(st->contended, 0);
+	zassert_equal(st->timeouts, 1);
+	zassert_true(st->hold_max > 0);
+}
+
+ZTEST(lock_stats, test_sem)
+{
+	const struct k_lock_stats *st = &runtime_sem.lock_stats;
+	k_tid_t tid;
+
+	zassert_equal(k_sem_take(&runtime_sem, K_MSEC(10)), -EAGAIN);
+	zassert_equal(st->timeouts, 1);
+	zassert_equal(st->acquisitions, 0);
+
+	tid = helper_start(sem_waiter, &runtime_sem);
+	k_busy_wait(HOLD_US);
+	k_sem_give(&runtime_sem);
+	k_thread_join(tid, K_FOREVER);
+
+	zassert_equal(st->acquisitions, 1);
+	zassert_equal(st->contended, 1);
+	zassert_true(st->wait_max > 0);
+	zassert_equal(st->hold_max, 0);
+
+	k_sem_give(&runtime_sem);
+	zassert_ok(k_sem_take(&runtime_sem, K_NO_WAIT));
+	zassert_equal(st->acquisitions, 2);
+	zassert_equal(st->contended, 1);
+}
+
+ZTEST(lock_stats, test_spinlock)
+{
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&spin);
+	k_spin_unlock(&spin, key);
+	zassert_equal(spin_stats.acquisitions, 0, "counted before attach");
+
+	k_spin_lock_stats_attach(&spin, &spin_stats, "test_spin");
+
+	for (int i = 0; i < 3; i++) {
+		key = k_spin_lock(&spin);
+		k_busy_wait(10);
+		k_spin_unlock(&spin, key);
+	}
+
+	zassert_equal(spin_stats.acquisitions, 3);
+	zassert_true(spin_stats.hold_max > 0);
+
+	k_lock_stats_unregister(&spin);
+
+	key = k_spin_lock(&spin);
+	k_spin_unlock(&spin, key);
+	zassert_equal(spin_stats.acquisitions, 3, "counted after detach");
+}
+
+struct find_ctx {
+	const void *obj;
+	const char *name;
+	bool found;
+};
+
+static void find_cb(enum k_lock_stats_type type, const void *obj,
+		    const char *name, const struct k_lock_stats *stats,
+		    void *user_data)
+{
+	struct find_ctx *ctx = user_data;
+
+	ARG_UNUSED(type);
+	ARG_UNUSED(stats);
+
+	if (obj == ctx->obj) {
+		zassert_false(ctx->found, "object listed twice");
+		ctx->found = true;
+		ctx->name = name;
+	}
+}
+
+static bool find(const void *obj, const char **name)
+{
+	struct find_ctx ctx = { .obj = obj };
+
+	k_lock_stats_foreach(find_cb, &ctx);
+	*name = ctx.name;
+
+	return ctx.found;
+}
+
+ZTEST(lock_stats, test_foreach)
+{
+	const char *name;
+
+	zassert_true(find(&static_mutex, &name));
+	zassert_is_null(name);
+	zassert_true(find(&static_sem, &name));
+	zassert_is_null(name);
+
+	zassert_false(find(&runtime_mutex, &name));
+	k_mutex_stats_register(&runtime_mutex, "runtime_mutex");
+	k_sem_stats_register(&runtime_sem, "runtime_sem");
+	k_mutex_stats_register(&static_mutex, "static_mutex");
+
+	zassert_true(find(&runtime_mutex, &name));
+	zassert_equal(strcmp(name, "runtime_mutex"), 0);
+	zassert_true(find(&runtime_sem, &name));
+	zassert_equal(strcmp(name, "runtime_sem"), 0);
+	zassert_true(find(&static_mutex, &name));
+	zassert_equal(strcmp(name, "static_mutex"), 0);
+
+	k_lock_stats_unregister(&runtime_mutex);
+	k_lock_stats_unregister(&runtime_sem);
+	k_lock_stats_unregister(&static_mutex);
+
+	zassert_false(find(&runtime_mutex, &name));
+	zassert_false(find(&runtime_sem, &name));
+	zassert_true(find(&static_mutex, &name));
+	zassert_is_null(name);
+}
+
+ZTEST(lock_stats, test_reset)
+{
+	zassert_ok(k_mutex_lock(&static_mutex, K_FOREVER));
+	k_mutex_unlock(&static_mutex);
+	zassert_true(static_mutex.lock_stats.acquisitions > 0);
+
+	k_lock_stats_reset();
+
+	zassert_equal(static_mutex.lock_stats.acquisitions, 0);
+	zassert_equal(static_mutex.lock_stats.hold_total, 0);
+}
+
+static void lock_stats_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	k_mutex_init(&runtime_mutex);
+	k_sem_init(&runtime_sem, 0, 1);
+	k_lock_stats_reset();
+}
+
+ZTEST_SUITE(lock_stats, NULL, NULL, lock_stats_before, NULL, NULL);
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/sys/htable.h>
+
+/**
+ * @defgroup lib_hash_table_tests Hash tables
+ * @ingroup all_tests
+ * @{
+ * @}
+ */
+
+#define N_NODES 48
+
+struct entry {
+	struct sys_hnode hn;
+	uint32_t key;
+};
+
+SYS_HTABLE_DEFINE(ht_defined, 8);
+SYS_HTABLE_DEFINE_LOCKED(ht_locked, 8);
+
+static sys_slist_t buckets[16];
+static struct sys_htable ht;
+static struct entry entries[N_NODES];
+
+static bool entry_eq(const struct sys_hnode *hn, const void *key)
+{
+	return CONTAINER_OF(hn, struct entry, hn)->key == *(const uint32_t *)key;
+}
+
+static struct entry *lookup(struct sys_htable *table, uint32_t key)
+{
+	struct sys_hnode *hn = sys_htable_find(table, sys_hash32_u32(key),
+					       entry_eq, &key);
+
+	return (hn != NULL) ? CONTAINER_OF(hn, struct entry, hn) : NULL;
+}
+
+static void insert_all(struct sys_htable *table)
+{
+	for (uint32_t i = 0; i < N_NODES; i++) {
+		entries[i].key = i * 7;
+		sys_htable_insert(table, &entries[i].hn,
+				  sys_hash32_u32(entries[i].key));
+	}
+}
+
+static void htable_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	sys_htable_init(&ht, buckets, ARRAY_SIZE(buckets), NULL);
+}
+
+ZTEST(htable_api, test_define)
+{
+	uint32_t key = 3;
+	struct entry e = { .key = key };
+
+	zassert_equal(sys_htable_size(&ht_defined), 0);
+	zassert_is_null(sys_htable_next(&ht_defined, NULL));
+
+	sys_htable_insert(&ht_defined, &e.hn, sys_hash32_u32(key));
+	zassert_equal(lookup(&ht_defined, key), &e);
+	zassert_true(sys_htable_remove(&ht_defined, &e.hn));
+	zassert_equal(sys_htable_size(&ht_defined), 0);
+}
+
+ZTEST(htable_api, test_insert_find_remove)
+{
+	uint32_t key;
+
+	insert_all(&ht);
+	zassert_equal(sys_htable_size(&ht), N_NODES);
+
+	for (uint32_t i = 0; i < N_NODES; i++) {
+		zassert_equal(lookup(&ht, i * 7), &entries[i]);
+		zassert_equal(sys_hnode_hash(&entries[i].hn),
+			      sys_hash32_u32(i * 7));
+	}
+
+	/* Keys that were not inserted */
+	key = 1;
+	zassert_is_null(lookup(&ht, key));
+	key = N_NODES * 7;
+	zassert_is_null(lookup(&ht, key));
+
+	for (uint32_t i = 0; i < N_NODES; i += 2) {
+		zassert_true(sys_htable_remove(&ht, &entries[i].hn));
+	}
+	zassert_equal(sys_htable_size(&ht), N_NODES / 2);
+
+	/* Removing twice is detected */
+	zassert_false(sys_htable_remove(&ht, &entries[0].hn));
+	zassert_equal(sys_htable_size(&ht), N_NODES / 2);
+
+	for (uint32_t i = 0; i < N_NODES; i++) {
+		zassert_equal(lookup(&ht, i * 7),
+			      (i % 2) ? &entries[i] : NULL);
+	}
+}
+
+/* Nodes with the same key are all kept, the last one is found first */
+ZTEST(htable_api, test_duplicates)
+{
+	struct entry a = { .key = 5 };
+	struct entry b = { .key = 5 };
+
+	sys_htable_insert(&ht, &a.hn, sys_hash32_u32(a.key));
+	sys_htable_insert(&ht, &b.hn, sys_hash32_u32(b.key));
+	zassert_equal(sys_htable_size(&ht), 2);
+
+	zassert_equal(lookup(&ht, 5), &b);
+	zassert_true(sys_htable_remove(&ht, &b.hn));
+	zassert_equal(lookup(&ht, 5), &a);
+	zassert_true(sys_htable_remove(&ht, &a.hn));
+	zassert_is_null(lookup(&ht, 5));
+}
+
+/* Keys colliding in a bucket are told apart by the predicate */
+ZTEST(htable_api, test_collisions)
+{
+	struct entry a = { .key = 1 };
+	struct entry b = { .key = 2 };
+
+	sys_htable_insert(&ht, &a.hn, 0);
+	sys_htable_insert(&ht, &b.hn, ARRAY_SIZE(buckets));
+
+	zassert_equal(sys_htable_find(&ht, 0, entry_eq, &a.key), &a.hn);
+	zassert_equal(sys_htable_find(&ht, ARRAY_SIZE(buckets), entry_eq,
+				      &b.key), &b.hn);
+	zassert_is_null(sys_htable_find(&ht, 0, entry_eq, &b.key));
+}
+
+ZTEST(htable_api, test_for_each)
+{
+	struct sys_hnode *hn, *hns;
+	struct entry *e;
+	uint64_t seen = 0;
+	int count = 0;
+
+	insert_all(&ht);
+
+	SYS_HTABLE_FOR_EACH(&ht, hn) {
+		e = CONTAINER_OF(hn, struct entry, hn);
+		zassert_false(seen & BIT64(e - entries), "node visited twice");
+		seen |= BIT64(e - entries);
+	}
+	zassert_equal(seen, BIT64_MASK(N_NODES));
+
+	SYS_HTABLE_FOR_EACH_CONTAINER(&ht, e, hn) {
+		count++;
+	}
+	zassert_equal(count, N_NODES);
+
+	SYS_HTABLE_FOR_EACH_SAFE(&ht, hn, hns) {
+		zassert_true(sys_htable_remove(&ht, hn));
+	}
+	zassert_equal(sys_htable_size(&ht), 0);
+	zassert_is_null(sys_htable_next(&ht, NULL));
+}
+
+ZTEST(htable_api, test_locked)
+{
+	insert_all(&ht_locked);
+	zassert_equal(sys_htable_size(&ht_locked), N_NODES);
+
+	for (uint32_t i = 0; i < N_NODES; i++) {
+		zassert_equal(lookup(&ht_locked, i * 7), &entries[i]);
+		zassert_true(sys_htable_remove(&ht_locked, &entries[i].hn));
+	}
+	zassert_equal(sys_htable_size(&ht_locked), 0);
+}
+
+ZTEST_SUITE(htable_api, NULL, NULL, htable_before, NULL, NULL);
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/sys/oamap.h>
+
+#define CAPACITY 64
+#define MAX_SIZE SYS_OAMAP_MAX_SIZE(CAPACITY)
+
+SYS_OAMAP_DEFINE(map_defined, 8);
+
+static struct sys_oamap_slot slots[CAPACITY];
+static struct sys_oamap_slot big_slots[4 * CAPACITY];
+static struct sys_oamap map;
+
+static inline void *value_of(uintptr_t key)
+{
+	return (void *)(key * 3);
+}
+
+static void fill(uintptr_t first, uint32_t n)
+{
+	for (uintptr_t k = first; k < first + n; k++) {
+		zassert_equal(sys_oamap_insert(&map, k, value_of(k), NULL), 1);
+	}
+}
+
+static void check(uintptr_t first, uint32_t n)
+{
+	void *value;
+
+	for (uintptr_t k = first; k < first + n; k++) {
+		zassert_true(sys_oamap_get(&map, k, &value), "key %lu lost",
+			     (unsigned long)k);
+		zassert_equal(value, value_of(k));
+	}
+}
+
+static void oamap_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	sys_oamap_init(&map, slots, CAPACITY);
+}
+
+ZTEST(oamap_api, test_define)
+{
+	void *value;
+
+	zassert_equal(sys_oamap_size(&map_defined), 0);
+	zassert_equal(sys_oamap_insert(&map_defined, 1, &value, NULL), 1);
+	zassert_true(sys_oamap_get(&map_defined, 1, &value));
+	zassert_equal(value, &value);
+	zassert_true(sys_oamap_remove(&map_defined, 1, NULL));
+	zassert_equal(sys_oamap_size(&map_defined), 0);
+}
+
+ZTEST(oamap_api, test_insert_get_remove)
+{
+	void *value;
+
+	fill(1, MAX_SIZE);
+	zassert_equal(sys_oamap_size(&map), MAX_SIZE);
+	check(1, MAX_SIZE);
+
+	zassert_false(sys_oamap_get(&map, MAX_SIZE + 1, &value));
+
+	/* Removing shifts entries back, the others must still be found */
+	for (uintptr_t k = 1; k <= MAX_SIZE; k += 2) {
+		zassert_true(sys_oamap_remove(&map, k, &value));
+		zassert_equal(value, value_of(k));
+	}
+	zassert_false(sys_oamap_remove(&map, 1, NULL));
+	zassert_equal(sys_oamap_size(&map), MAX_SIZE / 2);
+
+	for (uintptr_t k = 1; k <= MAX_SIZE; k++) {
+		zassert_equal(sys_oamap_get(&map, k, NULL), (k % 2) == 0);
+	}
+}
+
+ZTEST(oamap_api, test_replace)
+{
+	void *value, *old;
+
+	zassert_equal(sys_oamap_insert(&map, 42, &value, NULL), 1);
+	zassert_equal(sys_oamap_insert(&map, 42, &old, &value), 0);
+	zassert_equal(value, &value);
+	zassert_equal(sys_oamap_size(&map), 1);
+
+	zassert_true(sys_oamap_get(&map, 42, &value));
+	zassert_equal(value, &old);
+}
+
+ZTEST(oamap_api, test_invalid_and_full)
+{
+	zassert_equal(sys_oamap_insert(&map, 0, NULL, NULL), -EINVAL);
+	zassert_equal(sys_oamap_insert(&map, UINTPTR_MAX, NULL, NULL), -EINVAL);
+	zassert_false(sys_oamap_get(&map, 0, NULL));
+
+	fill(1, MAX_SIZE);
+	zassert_equal(sys_oamap_insert(&map, MAX_SIZE + 1, NULL, NULL), -ENOMEM);
+
+	/* Replacing is still possible */
+	zassert_equal(sys_oamap_insert(&map, 1, value_of(1), NULL), 0);
+}
+
+/* Entries keep being found while they are moved to a larger array */
+ZTEST(oamap_api, test_resize)
+{
+	fill(1, MAX_SIZE);
+
+	zassert_equal(sys_oamap_resize(&map, big_slots, ARRAY_SIZE(big_slots)), 0);
+	zassert_true(sys_oamap_is_resizing(&map));
+	zassert_equal(sys_oamap_resize(&map, slots, CAPACITY), -EBUSY);
+	check(1, MAX_SIZE);
+
+	/* Insertions move entries until the previous array is unused */
+	for (uintptr_t k = MAX_SIZE + 1; sys_oamap_is_resizing(&map); k++) {
+		zassert_equal(sys_oamap_insert(&map, k, value_of(k), NULL), 1);
+		check(1, k);
+	}
+	zassert_true(sys_oamap_size(&map) <= CAPACITY / SYS_OAMAP_RESIZE_STEP + MAX_SIZE);
+	check(1, sys_oamap_size(&map));
+
+	/* Too many entries to move back */
+	fill(sys_oamap_size(&map) + 1, MAX_SIZE);
+	zassert_equal(sys_oamap_resize(&map, slots, CAPACITY), -ENOMEM);
+}
+
+ZTEST(oamap_api, test_resize_remove_finish)
+{
+	fill(1, MAX_SIZE);
+	zassert_equal(sys_oamap_resize(&map, big_slots, ARRAY_SIZE(big_slots)), 0);
+
+	/* Remove keys from both arrays */
+	for (uintptr_t k = 1; k <= MAX_SIZE / 2; k++) {
+		zassert_true(sys_oamap_remove(&map, k, NULL));
+	}
+	zassert_false(sys_oamap_remove(&map, 1, NULL));
+
+	sys_oamap_resize_finish(&map);
+	zassert_false(sys_oamap_is_resizing(&map));
+	zassert_equal(sys_oamap_size(&map), MAX_SIZE - MAX_SIZE / 2);
+	check(MAX_SIZE / 2 + 1, MAX_SIZE - MAX_SIZE / 2);
+
+	/* Shrinking back */
+	zassert_equal(sys_oamap_resize(&map, slots, CAPACITY), 0);
+	sys_oamap_resize_finish(&map);
+	check(MAX_SIZE / 2 + 1, MAX_SIZE - MAX_SIZE / 2);
+}
+
+ZTEST(oamap_api, test_for_each)
+{
+	struct sys_oamap_slot *slot;
+	uint64_t seen = 0;
+
+	BUILD_ASSERT(MAX_SIZE + 4 < 64);
+
+	fill(1, MAX_SIZE);
+	zassert_equal(sys_oamap_resize(&map, big_slots, ARRAY_SIZE(big_slots)), 0);
+	fill(MAX_SIZE + 1, 4);
+
+	/* Walks both arrays while resizing */
+	zassert_true(sys_oamap_is_resizing(&map));
+	SYS_OAMAP_FOR_EACH(&map, slot) {
+		zassert_false(seen & BIT64(slot->key), "key visited twice");
+		zassert_equal(slot->value, value_of(slot->key));
+		seen |= BIT64(slot->key);
+	}
+	zassert_equal(seen, BIT64_MASK(MAX_SIZE + 5) & ~BIT64(0));
+}
+
+ZTEST_SUITE(oamap_api, NULL, NULL, oamap_before, NULL, NULL);
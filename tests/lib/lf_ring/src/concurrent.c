@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/ztress.h>
+#include <zephyr/sys/lf_ring.h>
+
+#define RING_SIZE 64
+#define N_PRODUCERS 3
+#define N_CONSUMERS 2
+
+/* Records are put with a single claim, the ring size is a multiple of it */
+struct record {
+	uint16_t seq;
+	uint8_t producer;
+	uint8_t check;
+};
+
+static uint8_t buffer[RING_SIZE];
+static struct lf_ring ring;
+
+static uint16_t produced[N_PRODUCERS];
+static uint16_t consumed[N_PRODUCERS];
+static uint32_t produced_sum[N_PRODUCERS];
+static uint32_t consumed_sum[N_CONSUMERS];
+
+static bool produce_bytes(void *user_data, uint32_t iter_cnt, bool last, int prio)
+{
+	static uint8_t cnt;
+	static uint32_t wr = 8;
+	uint8_t *data;
+	uint32_t len;
+
+	len = lf_ring_put_claim(&ring, &data, wr);
+	for (uint32_t i = 0; i < len; i++) {
+		data[i] = cnt++;
+	}
+
+	wr = wr == 14 ? 8 : wr + 1;
+
+	zassert_ok(lf_ring_put_finish(&ring, len));
+
+	return true;
+}
+
+static bool consume_bytes(void *user_data, uint32_t iter_cnt, bool last, int prio)
+{
+	static uint8_t cnt;
+	static uint32_t rd = 8;
+	uint8_t *data;
+	uint32_t len;
+
+	len = lf_ring_get_claim(&ring, &data, rd);
+	for (uint32_t i = 0; i < len; i++) {
+		zassert_equal(data[i], cnt, "Got %02x, exp: %02x", data[i], cnt);
+		cnt++;
+	}
+
+	rd = rd == 14 ? 8 : rd + 1;
+
+	zassert_ok(lf_ring_get_finish(&ring, len));
+
+	return true;
+}
+
+static bool produce_record(void *user_data, uint32_t iter_cnt, bool last, int prio)
+{
+	uintptr_t id = (uintptr_t)user_data;
+	struct record rec = {
+		.seq = produced[id],
+		.producer = id,
+		.check = ~id,
+	};
+
+	if (lf_ring_put(&ring, (uint8_t *)&rec, sizeof(rec)) == sizeof(rec)) {
+		produced[id]++;
+		produced_sum[id] += rec.seq;
+	}
+
+	return true;
+}
+
+/* Records of each producer must come in order to a single consumer */
+static bool consume_record_ordered(void *user_data, uint32_t iter_cnt, bool last, int prio)
+{
+	struct record rec;
+
+	while (lf_ring_get(&ring, (uint8_t *)&rec, sizeof(rec)) == sizeof(rec)) {
+		zassert_equal(rec.check, (uint8_t)~rec.producer, "corrupted record");
+		zassert_true(rec.producer < N_PRODUCERS);
+		zassert_equal(rec.seq, consumed[rec.producer], "producer %u: got %u, exp %u",
+			      rec.producer, rec.seq, consumed[rec.producer]);
+		consumed[rec.producer]++;
+	}
+
+	return true;
+}
+
+static bool consume_record(void *user_data, uint32_t iter_cnt, bool last, int prio)
+{
+	uintptr_t id = (uintptr_t)user_data;
+	struct record rec;
+
+	if (lf_ring_get(&ring, (uint8_t *)&rec, sizeof(rec)) == sizeof(rec)) {
+		zassert_equal(rec.check, (uint8_t)~rec.producer, "corrupted record");
+		consumed_sum[id] += rec.seq;
+	}
+
+	return true;
+}
+
+static void stress_init(uint32_t flags)
+{
+	lf_ring_init(&ring, buffer, sizeof(buffer), flags);
+	memset(produced, 0, sizeof(produced));
+	memset(consumed, 0, sizeof(consumed));
+	memset(produced_sum, 0, sizeof(produced_sum));
+	memset(consumed_sum, 0, sizeof(consumed_sum));
+
+	ztress_set_timeout((CONFIG_SYS_CLOCK_TICKS_PER_SEC < 10000) ? K_MSEC(1000) :
+								      K_MSEC(10000));
+}
+
+ZTEST(lf_ring_api, test_spsc_stress)
+{
+	PRINT("Producing interrupts consuming\n");
+	stress_init(LF_RING_SPSC);
+	ZTRESS_EXECUTE(ZTRESS_TIMER(produce_bytes, NULL, 0, Z_TIMEOUT_TICKS(20)),
+		       ZTRESS_THREAD(consume_bytes, NULL, 0, 2000, Z_TIMEOUT_TICKS(20)));
+
+	PRINT("Consuming interrupts producing\n");
+	stress_init(LF_RING_SPSC);
+	ZTRESS_EXECUTE(ZTRESS_TIMER(consume_bytes, NULL, 0, Z_TIMEOUT_TICKS(20)),
+		       ZTRESS_THREAD(produce_bytes, NULL, 0, 2000, Z_TIMEOUT_TICKS(20)));
+}
+
+ZTEST(lf_ring_api, test_mpsc_stress)
+{
+	stress_init(LF_RING_MPSC);
+	ZTRESS_EXECUTE(ZTRESS_TIMER(produce_record, (void *)0, 0, Z_TIMEOUT_TICKS(20)),
+		       ZTRESS_THREAD(produce_record, (void *)1, 0, 0, Z_TIMEOUT_TICKS(20)),
+		       ZTRESS_THREAD(produce_record, (void *)2, 0, 1000, Z_TIMEOUT_TICKS(20)),
+		       ZTRESS_THREAD(consume_record_ordered, NULL, 0, 1000, Z_TIMEOUT_TICKS(20)));
+
+	consume_record_ordered(NULL, 0, true, 0);
+	for (int i = 0; i < N_PRODUCERS; i++) {
+		zassert_equal(consumed[i], produced[i], "producer %d: lost records", i);
+	}
+}
+
+ZTEST(lf_ring_api, test_mpmc_stress)
+{
+	uint32_t produced_total = 0, consumed_total = 0;
+
+	stress_init(LF_RING_MPMC);
+	ZTRESS_EXECUTE(ZTRESS_TIMER(produce_record, (void *)0, 0, Z_TIMEOUT_TICKS(20)),
+		       ZTRESS_THREAD(consume_record, (void *)0, 0, 0, Z_TIMEOUT_TICKS(20)),
+		       ZTRESS_THREAD(produce_record, (void *)1, 0, 1000, Z_TIMEOUT_TICKS(20)),
+		       ZTRESS_THREAD(produce_record, (void *)2, 0, 1000, Z_TIMEOUT_TICKS(20)),
+		       ZTRESS_THREAD(consume_record, (void *)1, 0, 1000, Z_TIMEOUT_TICKS(20)));
+
+	while (!lf_ring_is_empty(&ring)) {
+		consume_record((void *)0, 0, true, 0);
+	}
+
+	for (int i = 0; i < N_PRODUCERS; i++) {
+		produced_total += produced_sum[i];
+	}
+	for (int i = 0; i < N_CONSUMERS; i++) {
+		consumed_total += consumed_sum[i];
+	}
+
+	zassert_equal(produced_total, consumed_total, "lost or duplicated records");
+}
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/sys/lf_ring.h>
+
+/**
+ * @defgroup lib_lf_ring_tests Lock-free ring buffer
+ * @ingroup all_tests
+ * @{
+ * @}
+ */
+
+#define SIZE 16
+
+LF_RING_DEFINE(ring_defined, 32, LF_RING_MPSC);
+
+static uint8_t buffer[SIZE];
+static struct lf_ring ring;
+
+static void fill(uint8_t *data, uint32_t len, uint8_t first)
+{
+	for (uint32_t i = 0; i < len; i++) {
+		data[i] = first + i;
+	}
+}
+
+ZTEST(lf_ring_api, test_define)
+{
+	zassert_equal(lf_ring_capacity_get(&ring_defined), 32);
+	zassert_equal(lf_ring_space_get(&ring_defined), 32);
+	zassert_true(lf_ring_is_empty(&ring_defined));
+}
+
+/* Single producer claims accumulate until a finish, which may put less */
+ZTEST(lf_ring_api, test_spsc_claim_finish)
+{
+	uint8_t *data;
+
+	lf_ring_init(&ring, buffer, SIZE, LF_RING_SPSC);
+
+	zassert_equal(lf_ring_put_claim(&ring, &data, 10), 10);
+	zassert_equal_ptr(data, buffer);
+	zassert_equal(lf_ring_put_claim(&ring, &data, 10), 6, "claim not contiguous");
+	zassert_equal_ptr(data, &buffer[10]);
+	zassert_equal(lf_ring_put_finish(&ring, SIZE + 1), -EINVAL);
+	zassert_true(lf_ring_is_empty(&ring), "claimed data is visible");
+
+	zassert_ok(lf_ring_put_finish(&ring, 12));
+	zassert_equal(lf_ring_size_get(&ring), 12);
+	zassert_equal(lf_ring_space_get(&ring), 4);
+
+	zassert_equal(lf_ring_get_claim(&ring, &data, SIZE), 12);
+	zassert_ok(lf_ring_get_finish(&ring, 8));
+	zassert_equal(lf_ring_size_get(&ring), 4);
+	zassert_equal(lf_ring_space_get(&ring), 12);
+
+	/* the free space wraps, claims stop at the end of the buffer */
+	zassert_equal(lf_ring_put_claim(&ring, &data, SIZE), 4);
+	zassert_equal_ptr(data, &buffer[12]);
+	zassert_equal(lf_ring_put_claim(&ring, &data, SIZE), 8);
+	zassert_equal_ptr(data, buffer);
+	zassert_ok(lf_ring_put_finish(&ring, 12));
+	zassert_equal(lf_ring_space_get(&ring), 0);
+	zassert_equal(lf_ring_put_claim(&ring, &data, 1), 0);
+
+	lf_ring_reset(&ring);
+	zassert_true(lf_ring_is_empty(&ring));
+	zassert_equal(lf_ring_space_get(&ring), SIZE);
+}
+
+ZTEST(lf_ring_api, test_put_get_wrap)
+{
+	uint8_t in[SIZE], out[SIZE];
+
+	fill(in, sizeof(in), 0);
+
+	for (int flags = 0; flags <= LF_RING_SPSC; flags++) {
+		lf_ring_init(&ring, buffer, SIZE, flags);
+
+		for (int i = 0; i < 2 * SIZE; i++) {
+			zassert_equal(lf_ring_put(&ring, in, 5), 5);
+			memset(out, 0, sizeof(out));
+			zassert_equal(lf_ring_get(&ring, out, sizeof(out)), 5);
+			zassert_mem_equal(in, out, 5);
+		}
+
+		zassert_equal(lf_ring_put(&ring, in, sizeof(in)), SIZE);
+		zassert_equal(lf_ring_put(&ring, in, 1), 0);
+		zassert_equal(lf_ring_get(&ring, NULL, 3), 3);
+		zassert_equal(lf_ring_get(&ring, out, sizeof(out)), SIZE - 3);
+		zassert_mem_equal(&in[3], out, SIZE - 3);
+	}
+}
+
+/* Claims are published once all earlier claims are finished */
+ZTEST(lf_ring_api, test_mp_publication)
+{
+	uint8_t *first, *second, *data;
+
+	lf_ring_init(&ring, buffer, SIZE, LF_RING_MPMC);
+
+	zassert_equal(lf_ring_put_claim(&ring, &first, 4), 4);
+	zassert_equal(lf_ring_put_claim(&ring, &second, 4), 4);
+	zassert_equal_ptr(second, first + 4);
+	zassert_equal(lf_ring_space_get(&ring), SIZE - 8);
+
+	fill(second, 4, 4);
+	zassert_ok(lf_ring_put_finish(&ring, 4));
+	zassert_true(lf_ring_is_empty(&ring), "published before the first claim");
+
+	fill(first, 4, 0);
+	zassert_ok(lf_ring_put_finish(&ring, 4));
+	zassert_equal(lf_ring_size_get(&ring), 8);
+	zassert_equal(lf_ring_put_finish(&ring, 4), -EINVAL);
+
+	zassert_equal(lf_ring_get_claim(&ring, &first, 2), 2);
+	zassert_equal(lf_ring_get_claim(&ring, &second, 6), 6);
+	zassert_equal(first[0], 0);
+	zassert_equal(second[0], 2);
+	zassert_equal(lf_ring_size_get(&ring), 0);
+
+	zassert_ok(lf_ring_get_finish(&ring, 6));
+	zassert_equal(lf_ring_space_get(&ring), SIZE - 8, "freed before the first claim");
+	zassert_ok(lf_ring_get_finish(&ring, 2));
+	zassert_equal(lf_ring_space_get(&ring), SIZE);
+	zassert_equal(lf_ring_get_claim(&ring, &data, 1), 0);
+}
+
+ZTEST(lf_ring_api, test_signals)
+{
+	struct k_poll_signal data_signal, space_signal;
+	uint8_t in[SIZE] = { 0 };
+	unsigned int signaled;
+	int result;
+
+	k_poll_signal_init(&data_signal);
+	k_poll_signal_init(&space_signal);
+	lf_ring_init(&ring, buffer, SIZE, LF_RING_MPSC);
+	lf_ring_signals_set(&ring, &data_signal, &space_signal);
+
+	zassert_equal(lf_ring_put(&ring, in, 4), 4);
+	k_poll_signal_check(&data_signal, &signaled, &result);
+	zassert_true(signaled, "no signal when putting in an empty ring");
+
+	k_poll_signal_reset(&data_signal);
+	zassert_equal(lf_ring_put(&ring, in, 4), 4);
+	k_poll_signal_check(&data_signal, &signaled, &result);
+	zassert_false(signaled, "signal when putting in a non empty ring");
+
+	zassert_equal(lf_ring_put(&ring, in, SIZE), SIZE - 8);
+	zassert_equal(lf_ring_get(&ring, NULL, 2), 2);
+	k_poll_signal_check(&space_signal, &signaled, &result);
+	zassert_true(signaled, "no signal when getting from a full ring");
+
+	k_poll_signal_reset(&space_signal);
+	zassert_equal(lf_ring_get(&ring, NULL, 2), 2);
+	k_poll_signal_check(&space_signal, &signaled, &result);
+	zassert_false(signaled, "signal when getting from a non full ring");
+}
+
+ZTEST_SUITE(lf_ring_api, NULL, NULL, NULL, NULL, NULL);
@@ -274,5 +274,40 @@ ZTEST(lib_p4wq_1cpu, test_p4wq_simple)
 	zassert_true(has_run, "high-priority item didn't run");
 }
 
+static void inherit_handler(struct k_p4wq_work *work)
+{
+	run_count = k_thread_priority_get(k_current_get());
+}
+
+/* Validate a thread waiting for a synchronous item lends it its priority */
+ZTEST(lib_p4wq_1cpu, test_p4wq_wait_inherit)
+{
+	int prio = 2;
+
+	k_thread_priority_set(k_current_get(), prio);
+
+	/* Lower priority item, which does not run until we wait */
+	simple_item = (struct k_p4wq_work){};
+	simple_item.priority = prio + 3;
+	simple_item.handler = inherit_handler;
+	simple_item.sync = true;
+
+	run_count = -1;
+	k_p4wq_submit(&wq, &simple_item);
+	zassert_equal(run_count, -1, "ran too early");
+
+	zassert_ok(k_p4wq_wait(&simple_item, K_FOREVER), "wait failed");
+	zassert_equal(run_count, prio, "item ran at priority %d", run_count);
+	zassert_equal(simple_item.priority, prio + 3, "item priority changed");
+
+	/* Submitted again without waiting, it runs at its own priority */
+	run_count = -1;
+	simple_item.deadline = 0;
+	k_p4wq_submit(&wq, &simple_item);
+	k_msleep(1);
+	zassert_ok(k_p4wq_wait(&simple_item, K_NO_WAIT), "item did not run");
+	zassert_equal(run_count, prio + 3, "item ran at priority %d", run_count);
+}
+
 ZTEST_SUITE(lib_p4wq, NULL, NULL, NULL, NULL, NULL);
 ZTEST_SUITE(lib_p4wq_1cpu, NULL, NULL, ztest_simple_1cpu_before, ztest_simple_1cpu_after, NULL);
@@ -335,6 +335,57 @@ ZTEST(test_spsc_pbuf, test_0cpy_corner2)
 	PACKET_WRITE(pb, capacity, 0, 2, exp_len);
 }
 
+static bool packet_write_notify(struct spsc_pbuf *pb, uint16_t len, char **buf)
+{
+	zassert_equal(spsc_pbuf_alloc(pb, len, buf), len);
+
+	return spsc_pbuf_commit_notify(pb, len);
+}
+
+static void packet_free(struct spsc_pbuf *pb)
+{
+	char *buf;
+	uint16_t len = spsc_pbuf_claim(pb, &buf);
+
+	zassert_true(len > 0);
+	spsc_pbuf_free(pb, len);
+}
+
+ZTEST(test_spsc_pbuf, test_commit_notify)
+{
+	static uint8_t buffer[128] __aligned(MAX(Z_SPSC_PBUF_DCACHE_LINE, 4));
+	struct spsc_pbuf *pb = spsc_pbuf_init(buffer, sizeof(buffer), 0);
+	uint16_t len = 20;
+	char *prev = NULL;
+	char *buf;
+
+	zassert_false(spsc_pbuf_commit_notify(pb, 0));
+
+	/* Consumer is notified of the first packet only. */
+	zassert_true(packet_write_notify(pb, len, &buf));
+	zassert_false(packet_write_notify(pb, len, &buf));
+
+	/* Consumer has not claimed the second packet yet. */
+	packet_free(pb);
+	zassert_false(packet_write_notify(pb, len, &buf));
+
+	packet_free(pb);
+	packet_free(pb);
+
+	/* Consumer caught up each time, until the packet wraps around with a
+	 * padding at which the consumer stopped.
+	 */
+	do {
+		prev = buf;
+		zassert_true(packet_write_notify(pb, len, &buf));
+		packet_free(pb);
+	} while (buf > prev);
+
+	/* Consumer caught up with the packet after the padding too. */
+	zassert_true(packet_write_notify(pb, len, &buf));
+	zassert_false(packet_write_notify(pb, len, &buf));
+}
+
 ZTEST(test_spsc_pbuf, test_largest_alloc)
 {
 	static uint8_t buffer[128] __aligned(MAX(Z_SPSC_PBUF_DCACHE_LINE, 4));
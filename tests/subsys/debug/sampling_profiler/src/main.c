@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/debug/sampling_profiler.h>
+
+struct count_ctx {
+	uint32_t records;
+	uint32_t samples;
+	/* Records of thread with the frames, and their total samples */
+	uint32_t match_records;
+	uint32_t match;
+	const struct k_thread *thread;
+	const uintptr_t *frames;
+	size_t depth;
+};
+
+static void count_cb(const struct sampling_profiler_record *rec, void *user_data)
+{
+	struct count_ctx *ctx = user_data;
+
+	ctx->records++;
+	ctx->samples += rec->count;
+
+	if (ctx->frames != NULL && rec->thread == ctx->thread && rec->depth == ctx->depth &&
+	    memcmp(rec->frames, ctx->frames, ctx->depth * sizeof(uintptr_t)) == 0) {
+		ctx->match_records++;
+		ctx->match += rec->count;
+	}
+}
+
+static void profiler_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	sampling_profiler_stop();
+	sampling_profiler_reset();
+}
+
+ZTEST(sampling_profiler, test_aggregation)
+{
+	const uintptr_t stack_a[] = { 0x1000, 0x2000, 0x3000 };
+	const uintptr_t stack_b[] = { 0x1004, 0x2000, 0x3000 };
+	struct sampling_profiler_stats stats;
+	struct count_ctx ctx = {
+		.thread = k_current_get(),
+		.frames = stack_a,
+		.depth = ARRAY_SIZE(stack_a),
+	};
+
+	for (int i = 0; i < 10; i++) {
+		sampling_profiler_record(k_current_get(), stack_a, ARRAY_SIZE(stack_a));
+	}
+	sampling_profiler_record(k_current_get(), stack_b, ARRAY_SIZE(stack_b));
+	/* Same stack in another thread is a separate record */
+	sampling_profiler_record(NULL, stack_a, ARRAY_SIZE(stack_a));
+
+	sampling_profiler_foreach(count_cb, &ctx);
+	sampling_profiler_stats_get(&stats);
+
+	zassert_equal(ctx.records, 3, "unexpected record count %u", ctx.records);
+	zassert_equal(ctx.samples, 12, "unexpected sample count %u", ctx.samples);
+	zassert_equal(stats.samples, 12, "unexpected stats samples");
+	zassert_equal(stats.dropped, 0, "unexpected drops");
+	zassert_equal(stats.records, 3, "unexpected stats records");
+	zassert_equal(ctx.match_records, 1, "stack split in %u records", ctx.match_records);
+	zassert_equal(ctx.match, 10, "stack not aggregated (%u)", ctx.match);
+
+	ctx = (struct count_ctx){
+		.thread = NULL,
+		.frames = stack_a,
+		.depth = ARRAY_SIZE(stack_a),
+	};
+	sampling_profiler_foreach(count_cb, &ctx);
+	zassert_equal(ctx.match_records, 1, "other thread record count %u", ctx.match_records);
+	zassert_equal(ctx.match, 1, "other thread sample count %u", ctx.match);
+}
+
+ZTEST(sampling_profiler, test_truncation)
+{
+	uintptr_t deep[CONFIG_SAMPLING_PROFILER_MAX_FRAMES + 2];
+	struct count_ctx ctx = {
+		.frames = deep,
+		.depth = CONFIG_SAMPLING_PROFILER_MAX_FRAMES,
+	};
+
+	for (int i = 0; i < ARRAY_SIZE(deep); i++) {
+		deep[i] = 0x100 * (i + 1);
+	}
+
+	sampling_profiler_record(NULL, deep, ARRAY_SIZE(deep));
+	sampling_profiler_foreach(count_cb, &ctx);
+
+	zassert_equal(ctx.records, 1, "unexpected record count");
+	zassert_equal(ctx.match_records, 1, "stack not truncated to max frames");
+	zassert_equal(ctx.match, 1, "unexpected sample count %u", ctx.match);
+}
+
+ZTEST(sampling_profiler, test_table_full)
+{
+	struct sampling_profiler_stats stats;
+	uintptr_t pc;
+
+	for (pc = 0; pc < CONFIG_SAMPLING_PROFILER_BUCKETS + 5; pc++) {
+		sampling_profiler_record(NULL, &pc, 1);
+	}
+
+	sampling_profiler_stats_get(&stats);
+
+	zassert_equal(stats.records, CONFIG_SAMPLING_PROFILER_BUCKETS,
+		      "table not filled");
+	zassert_equal(stats.dropped, 5, "unexpected drops %u", stats.dropped);
+	zassert_equal(stats.samples, CONFIG_SAMPLING_PROFILER_BUCKETS + 5,
+		      "unexpected samples");
+}
+
+ZTEST(sampling_profiler, test_export)
+{
+	static uint8_t buf[1024];
+	const uintptr_t stack[] = { 0x1234, 0x5678 };
+	struct sampling_profiler_export_hdr hdr;
+	int len;
+
+	sampling_profiler_record(k_current_get(), stack, ARRAY_SIZE(stack));
+	sampling_profiler_record(k_current_get(), stack, ARRAY_SIZE(stack));
+
+	zassert_equal(sampling_profiler_export(buf, sizeof(hdr)), -ENOMEM,
+		      "export should not fit");
+
+	len = sampling_profiler_export(buf, sizeof(buf));
+	zassert_equal(len, sampling_profiler_export_size(), "unexpected size %d", len);
+
+	memcpy(&hdr, buf, sizeof(hdr));
+	zassert_equal(hdr.magic, SAMPLING_PROFILER_EXPORT_MAGIC, "bad magic");
+	zassert_equal(hdr.version, SAMPLING_PROFILER_EXPORT_VERSION, "bad version");
+	zassert_equal(hdr.frame_size, sizeof(uintptr_t), "bad frame size");
+	zassert_equal(hdr.max_frames, CONFIG_SAMPLING_PROFILER_MAX_FRAMES, "bad depth");
+	zassert_equal(hdr.records, 1, "bad record count");
+	zassert_equal(hdr.samples, 2, "bad sample count");
+}
+
+ZTEST(sampling_profiler, test_timer_sampling)
+{
+	struct sampling_profiler_stats stats;
+
+	zassert_equal(sampling_profiler_start(CONFIG_SYS_CLOCK_TICKS_PER_SEC + 1),
+		      -EINVAL, "frequency above tick rate accepted");
+
+	zassert_ok(sampling_profiler_start(0), "start failed");
+	zassert_true(sampling_profiler_is_running(), "not running");
+	zassert_equal(sampling_profiler_start(0), -EALREADY, "double start");
+
+	k_busy_wait(USEC_PER_MSEC * 100);
+	k_msleep(100);
+
+	sampling_profiler_stop();
+	zassert_false(sampling_profiler_is_running(), "still running");
+
+	sampling_profiler_stats_get(&stats);
+	zassert_true(stats.samples > 0, "no samples taken");
+	zassert_true(stats.records > 0, "no records");
+}
+
+ZTEST_SUITE(sampling_profiler, NULL, NULL, profiler_before, NULL, NULL);
@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "fcb_test.h"
+#include <zephyr/sys/byteorder.h>
+
+#define TS_ELEM_LEN 100
+#define TS_ELEM_CNT 400
+
+static uint8_t batch_buf[512];
+
+static uint32_t fcb_test_timestamp(const uint8_t *data, size_t len)
+{
+	zassert_true(len >= sizeof(uint32_t), "timestamp missing");
+	return sys_get_le32(data);
+}
+
+ZTEST(fcb_test_with_4sectors_set, test_fcb_batch)
+{
+	struct fcb_batch batch;
+	struct fcb *fcb;
+	uint8_t test_data[128];
+	int var_cnt;
+	int rc;
+	int i;
+	int j;
+
+	fcb = &test_fcb;
+	fcb_batch_init(&batch, batch_buf, sizeof(batch_buf));
+
+	for (i = 0; i < sizeof(test_data); i++) {
+		for (j = 0; j < i; j++) {
+			test_data[j] = fcb_test_append_data(i, j);
+		}
+		rc = fcb_batch_add(fcb, &batch, test_data, i);
+		zassert_true(rc == 0, "fcb_batch_add call failure");
+	}
+
+	/* Only the records flushed so far are in flash */
+	var_cnt = 0;
+	rc = fcb_walk(fcb, 0, fcb_test_data_walk_cb, &var_cnt);
+	zassert_true(rc == 0, "fcb_walk call failure");
+	zassert_true(var_cnt > 0 && var_cnt < sizeof(test_data),
+		     "unexpected number of flushed records");
+
+	rc = fcb_batch_flush(fcb, &batch);
+	zassert_true(rc == 0, "fcb_batch_flush call failure");
+	zassert_equal(batch.fb_len, 0, "batch not empty");
+
+	var_cnt = 0;
+	rc = fcb_walk(fcb, 0, fcb_test_data_walk_cb, &var_cnt);
+	zassert_true(rc == 0, "fcb_walk call failure");
+	zassert_equal(var_cnt, sizeof(test_data),
+		      "fetched data size not match to wrote data size");
+
+	/* Does not fit in an empty batch */
+	rc = fcb_batch_add(fcb, &batch, test_data, sizeof(batch_buf));
+	zassert_equal(rc, -EINVAL, "too large record accepted");
+}
+
+ZTEST(fcb_test_with_4sectors_set, test_fcb_batch_fill)
+{
+	struct fcb_batch batch;
+	struct fcb *fcb;
+	uint8_t test_data[TS_ELEM_LEN];
+	int elem_cnts[4] = {0};
+	struct append_arg aa = { .elem_cnts = elem_cnts };
+	int added = 0;
+	int rc;
+
+	fcb = &test_fcb;
+	fcb_batch_init(&batch, batch_buf, sizeof(batch_buf));
+	memset(test_data, 0xa5, sizeof(test_data));
+
+	while (1) {
+		rc = fcb_batch_add(fcb, &batch, test_data, sizeof(test_data));
+		if (rc == -ENOSPC) {
+			break;
+		}
+		zassert_true(rc == 0, "fcb_batch_add call failure");
+		added++;
+	}
+
+	/* The records not written stay in the batch */
+	zassert_true(batch.fb_len > 0, "batch emptied on failure");
+
+	rc = fcb_walk(fcb, 0, fcb_test_cnt_elems_cb, &aa);
+	zassert_true(rc == 0, "fcb_walk call failure");
+	for (int i = 0; i < ARRAY_SIZE(elem_cnts); i++) {
+		zassert_true(elem_cnts[i] > 0, "sector %d not used", i);
+		zassert_equal(elem_cnts[i], elem_cnts[0], "uneven sectors");
+	}
+
+	/* Room is made for the rest of the batch */
+	rc = fcb_rotate(fcb);
+	zassert_true(rc == 0, "fcb_rotate call failure");
+	rc = fcb_batch_flush(fcb, &batch);
+	zassert_true(rc == 0, "fcb_batch_flush call failure");
+}
+
+static void fcb_test_ts_append(struct fcb *fcb, struct fcb_batch *batch,
+			       uint32_t ts)
+{
+	uint8_t test_data[TS_ELEM_LEN];
+	struct fcb_entry loc;
+	int rc;
+
+	memset(test_data, ts, sizeof(test_data));
+	sys_put_le32(ts, test_data);
+
+	/* Every third record is appended without the batch */
+	if (ts % 3 == 0) {
+		rc = fcb_batch_flush(fcb, batch);
+		zassert_true(rc == 0, "fcb_batch_flush call failure");
+		rc = fcb_append(fcb, sizeof(test_data), &loc);
+		zassert_true(rc == 0, "fcb_append call failure");
+		rc = flash_area_write(fcb->fap, FCB_ENTRY_FA_DATA_OFF(loc),
+				      test_data, sizeof(test_data));
+		zassert_true(rc == 0, "flash_area_write call failure");
+		rc = fcb_append_finish(fcb, &loc);
+		zassert_true(rc == 0, "fcb_append_finish call failure");
+	} else {
+		rc = fcb_batch_add(fcb, batch, test_data, sizeof(test_data));
+		zassert_true(rc == 0, "fcb_batch_add call failure");
+	}
+}
+
+static uint32_t fcb_test_loc_ts(struct fcb *fcb, struct fcb_entry *loc)
+{
+	uint8_t data[sizeof(uint32_t)];
+	int rc;
+
+	rc = flash_area_read(fcb->fap, FCB_ENTRY_FA_DATA_OFF((*loc)), data,
+			     sizeof(data));
+	zassert_true(rc == 0, "read call failure");
+	return sys_get_le32(data);
+}
+
+ZTEST(fcb_test_with_4sectors_set, test_fcb_summary)
+{
+	struct fcb_sector_summary summary[4];
+	struct fcb_sector_summary summary2[4];
+	struct fcb_sector_summary *active;
+	uint8_t test_data[TS_ELEM_LEN];
+	struct fcb_batch batch;
+	struct fcb_entry loc, next;
+	struct fcb *fcb;
+	uint32_t seq;
+	int rc;
+
+	fcb = &test_fcb;
+	zassert_equal(fcb_seek_seq(fcb, 0, &loc), -ENOTSUP,
+		      "seek without summaries");
+
+	fcb->f_summary = summary;
+	fcb->f_timestamp = fcb_test_timestamp;
+	rc = fcb_init(TEST_FCB_FLASH_AREA_ID, fcb);
+	zassert_true(rc == 0, "fcb_init call failure");
+	zassert_equal(fcb_seek_time(fcb, 0, &loc), -ENOENT, "empty fcb");
+
+	fcb_batch_init(&batch, batch_buf, sizeof(batch_buf));
+	for (uint32_t ts = 0; ts < TS_ELEM_CNT; ts++) {
+		fcb_test_ts_append(fcb, &batch, ts * 10);
+	}
+	rc = fcb_batch_flush(fcb, &batch);
+	zassert_true(rc == 0, "fcb_batch_flush call failure");
+
+	zassert_equal(summary[0].fs_first_seq, 0, "first sequence");
+	zassert_true(summary[1].fs_count > 0 && summary[2].fs_count > 0,
+		     "records not spread over sectors");
+	zassert_equal(summary[2].fs_first_seq + summary[2].fs_count +
+		      summary[3].fs_count, TS_ELEM_CNT, "records not counted");
+	zassert_equal(summary[1].fs_first_ts, summary[1].fs_first_seq * 10,
+		      "first timestamp");
+	zassert_equal(summary[1].fs_last_ts,
+		      (summary[2].fs_first_seq - 1) * 10, "last timestamp");
+
+	for (seq = 0; seq < TS_ELEM_CNT; seq += 37) {
+		rc = fcb_seek_seq(fcb, seq, &loc);
+		zassert_true(rc == 0, "fcb_seek_seq call failure");
+		zassert_equal(fcb_test_loc_ts(fcb, &loc), seq * 10,
+			      "wrong record for %u", seq);
+	}
+	zassert_equal(fcb_seek_seq(fcb, TS_ELEM_CNT, &loc), -ENOENT,
+		      "seek past the last record");
+
+	rc = fcb_seek_time(fcb, 1234, &loc);
+	zassert_true(rc == 0, "fcb_seek_time call failure");
+	zassert_equal(fcb_test_loc_ts(fcb, &loc), 1240, "wrong record");
+	rc = fcb_getnext(fcb, &loc);
+	zassert_true(rc == 0, "fcb_getnext call failure");
+	zassert_equal(fcb_test_loc_ts(fcb, &loc), 1250, "wrong next record");
+	zassert_equal(fcb_seek_time(fcb, TS_ELEM_CNT * 10, &loc), -ENOENT,
+		      "seek past the last timestamp");
+
+	/* Summaries are rebuilt from flash */
+	fcb->f_summary = summary2;
+	rc = fcb_init(TEST_FCB_FLASH_AREA_ID, fcb);
+	zassert_true(rc == 0, "fcb_init call failure");
+	zassert_mem_equal(summary, summary2, sizeof(summary), "summary rebuilt");
+
+	/* Sequence numbers go on after a rotation */
+	rc = fcb_rotate(fcb);
+	zassert_true(rc == 0, "fcb_rotate call failure");
+	zassert_equal(fcb_seek_seq(fcb, 0, &loc), -ENOENT,
+		      "seek to an erased record");
+	seq = summary2[1].fs_first_seq;
+	rc = fcb_seek_seq(fcb, seq, &loc);
+	zassert_true(rc == 0, "fcb_seek_seq call failure");
+	zassert_equal(fcb_test_loc_ts(fcb, &loc), seq * 10, "wrong record");
+	rc = fcb_seek_time(fcb, 0, &loc);
+	zassert_true(rc == 0, "fcb_seek_time call failure");
+	zassert_equal(fcb_test_loc_ts(fcb, &loc), seq * 10, "wrong record");
+
+	/* A record is only counted once finished */
+	active = &summary2[fcb->f_active.fe_sector - fcb->f_sectors];
+	seq = active->fs_first_seq + active->fs_count;
+	memset(test_data, 0, sizeof(test_data));
+	sys_put_le32(seq * 10, test_data);
+	rc = fcb_append(fcb, sizeof(test_data), &loc);
+	zassert_true(rc == 0, "fcb_append call failure");
+	rc = flash_area_write(fcb->fap, FCB_ENTRY_FA_DATA_OFF(loc),
+			      test_data, sizeof(test_data));
+	zassert_true(rc == 0, "flash_area_write call failure");
+	zassert_equal(fcb_seek_seq(fcb, seq, &next), -ENOENT,
+		      "unfinished record counted");
+	rc = fcb_append_finish(fcb, &loc);
+	zassert_true(rc == 0, "fcb_append_finish call failure");
+	rc = fcb_seek_seq(fcb, seq, &next);
+	zassert_true(rc == 0, "fcb_seek_seq call failure");
+	zassert_equal(fcb_test_loc_ts(fcb, &next), seq * 10, "wrong record");
+}
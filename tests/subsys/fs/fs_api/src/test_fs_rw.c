@@ -0,0 +1,391 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Vectored and positional access, mappings and copies, on a file system
+ * keeping a few files in RAM. It implements pread itself, the other
+ * operations are emulated by the file system API.
+ */
+
+#include "test_fs.h"
+#include <string.h>
+
+#define MEM_FS_MNTP "/MEM:"
+#define MEM_FILE MEM_FS_MNTP"/a"
+#define MEM_FILE_COPY MEM_FS_MNTP"/b"
+#define MEM_FILE_MAX 2
+#define MEM_FILE_SIZE 4000
+
+struct mem_file {
+	char name[MAX_FILE_NAME + 1];
+	uint8_t data[MEM_FILE_SIZE];
+	size_t size;
+	bool used;
+};
+
+struct mem_handle {
+	struct mem_file *file;
+	off_t pos;
+	bool used;
+};
+
+static struct mem_file files[MEM_FILE_MAX];
+static struct mem_handle handles[MEM_FILE_MAX];
+static int pread_calls;
+
+static struct mem_file *mem_find(const char *path)
+{
+	for (int i = 0; i < MEM_FILE_MAX; i++) {
+		if (files[i].used && !strcmp(files[i].name, path)) {
+			return &files[i];
+		}
+	}
+
+	return NULL;
+}
+
+static int mem_open(struct fs_file_t *zfp, const char *path, fs_mode_t flags)
+{
+	struct mem_file *file = mem_find(path);
+	int i;
+
+	if (file == NULL) {
+		if (!(flags & FS_O_CREATE)) {
+			return -ENOENT;
+		}
+		for (i = 0; (i < MEM_FILE_MAX) && files[i].used; i++) {
+		}
+		if (i == MEM_FILE_MAX) {
+			return -ENOSPC;
+		}
+		file = &files[i];
+		strcpy(file->name, path);
+		file->size = 0;
+		file->used = true;
+	}
+
+	for (i = 0; (i < MEM_FILE_MAX) && handles[i].used; i++) {
+	}
+	if (i == MEM_FILE_MAX) {
+		return -ENFILE;
+	}
+
+	handles[i].file = file;
+	handles[i].pos = 0;
+	handles[i].used = true;
+	zfp->filep = &handles[i];
+
+	return 0;
+}
+
+static int mem_close(struct fs_file_t *zfp)
+{
+	struct mem_handle *h = zfp->filep;
+
+	h->used = false;
+
+	return 0;
+}
+
+static ssize_t mem_read(struct fs_file_t *zfp, void *ptr, size_t size)
+{
+	struct mem_handle *h = zfp->filep;
+	size_t len = MIN(size, h->file->size - h->pos);
+
+	memcpy(ptr, &h->file->data[h->pos], len);
+	h->pos += len;
+
+	return len;
+}
+
+static ssize_t mem_write(struct fs_file_t *zfp, const void *ptr, size_t size)
+{
+	struct mem_handle *h = zfp->filep;
+	size_t len;
+
+	if (zfp->flags & FS_O_APPEND) {
+		h->pos = h->file->size;
+	}
+
+	len = MIN(size, MEM_FILE_SIZE - h->pos);
+	if ((len == 0) && (size > 0)) {
+		return -ENOSPC;
+	}
+
+	memcpy(&h->file->data[h->pos], ptr, len);
+	h->pos += len;
+	h->file->size = MAX(h->file->size, h->pos);
+
+	return len;
+}
+
+static ssize_t mem_pread(struct fs_file_t *zfp, void *ptr, size_t size,
+			 off_t offset)
+{
+	struct mem_handle *h = zfp->filep;
+	size_t len;
+
+	pread_calls++;
+
+	if (offset >= h->file->size) {
+		return 0;
+	}
+
+	len = MIN(size, h->file->size - offset);
+	memcpy(ptr, &h->file->data[offset], len);
+
+	return len;
+}
+
+static int mem_lseek(struct fs_file_t *zfp, off_t off, int whence)
+{
+	struct mem_handle *h = zfp->filep;
+	off_t pos;
+
+	switch (whence) {
+	case FS_SEEK_SET:
+		pos = off;
+		break;
+	case FS_SEEK_CUR:
+		pos = h->pos + off;
+		break;
+	case FS_SEEK_END:
+		pos = h->file->size + off;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	if ((pos < 0) || (pos > h->file->size)) {
+		return -EINVAL;
+	}
+
+	h->pos = pos;
+
+	return 0;
+}
+
+static off_t mem_tell(struct fs_file_t *zfp)
+{
+	struct mem_handle *h = zfp->filep;
+
+	return h->pos;
+}
+
+static int mem_stat(struct fs_mount_t *mountp, const char *path,
+		    struct fs_dirent *entry)
+{
+	struct mem_file *file = mem_find(path);
+
+	if (file == NULL) {
+		return -ENOENT;
+	}
+
+	entry->type = FS_DIR_ENTRY_FILE;
+	entry->size = file->size;
+
+	return 0;
+}
+
+static int mem_unlink(struct fs_mount_t *mountp, const char *path)
+{
+	struct mem_file *file = mem_find(path);
+
+	if (file == NULL) {
+		return -ENOENT;
+	}
+
+	file->used = false;
+
+	return 0;
+}
+
+static int mem_mount(struct fs_mount_t *mountp)
+{
+	return 0;
+}
+
+static int mem_unmount(struct fs_mount_t *mountp)
+{
+	return 0;
+}
+
+static const struct fs_file_system_t mem_fs = {
+	.open = mem_open,
+	.close = mem_close,
+	.read = mem_read,
+	.write = mem_write,
+	.pread = mem_pread,
+	.lseek = mem_lseek,
+	.tell = mem_tell,
+	.stat = mem_stat,
+	.unlink = mem_unlink,
+	.mount = mem_mount,
+	.unmount = mem_unmount,
+};
+
+static struct fs_mount_t mem_mnt = {
+	.type = TEST_FS_2,
+	.mnt_point = MEM_FS_MNTP,
+};
+
+static struct fs_file_t file;
+static uint8_t pattern[MEM_FILE_SIZE];
+static uint8_t buf[MEM_FILE_SIZE];
+
+static void open_pattern(size_t len)
+{
+	zassert_ok(fs_open(&file, MEM_FILE, FS_O_CREATE | FS_O_RDWR));
+	zassert_equal(fs_write(&file, pattern, len), len);
+	zassert_ok(fs_seek(&file, 0, FS_SEEK_SET));
+}
+
+ZTEST(fs_api_rw, test_readv)
+{
+	uint8_t a[3], b[10], c[20];
+	struct fs_iovec iov[] = {
+		{ .data = a, .len = sizeof(a) },
+		{ .data = b, .len = sizeof(b) },
+		{ .data = c, .len = sizeof(c) },
+	};
+
+	open_pattern(20);
+
+	/* Stops at the end of the file */
+	zassert_equal(fs_readv(&file, iov, ARRAY_SIZE(iov)), 20);
+	zassert_mem_equal(a, pattern, sizeof(a));
+	zassert_mem_equal(b, &pattern[3], sizeof(b));
+	zassert_mem_equal(c, &pattern[13], 7);
+	zassert_equal(fs_readv(&file, iov, ARRAY_SIZE(iov)), 0);
+}
+
+ZTEST(fs_api_rw, test_writev)
+{
+	struct fs_iovec iov[] = {
+		{ .data = &pattern[0], .len = 5 },
+		{ .data = &pattern[5], .len = 0 },
+		{ .data = &pattern[5], .len = 100 },
+	};
+
+	zassert_ok(fs_open(&file, MEM_FILE, FS_O_CREATE | FS_O_RDWR));
+	zassert_equal(fs_writev(&file, iov, ARRAY_SIZE(iov)), 105);
+	zassert_equal(fs_tell(&file), 105);
+
+	zassert_ok(fs_seek(&file, 0, FS_SEEK_SET));
+	zassert_equal(fs_read(&file, buf, sizeof(buf)), 105);
+	zassert_mem_equal(buf, pattern, 105);
+}
+
+ZTEST(fs_api_rw, test_pread_pwrite)
+{
+	open_pattern(100);
+	zassert_ok(fs_seek(&file, 10, FS_SEEK_SET));
+
+	/* Served by the file system */
+	zassert_equal(fs_pread(&file, buf, 50, 40), 50);
+	zassert_equal(pread_calls, 1);
+	zassert_mem_equal(buf, &pattern[40], 50);
+	zassert_equal(fs_pread(&file, buf, 50, 80), 20);
+	zassert_equal(fs_pread(&file, buf, 50, 200), 0);
+	zassert_equal(fs_pread(&file, buf, 50, -1), -EINVAL);
+	zassert_equal(fs_tell(&file), 10);
+
+	/* Emulated */
+	zassert_equal(fs_pwrite(&file, "xyz", 3, 98), 3);
+	zassert_equal(fs_tell(&file), 10);
+	zassert_equal(fs_pread(&file, buf, 10, 95), 6);
+	zassert_mem_equal(buf, &pattern[95], 3);
+	zassert_mem_equal(&buf[3], "xyz", 3);
+
+	zassert_ok(fs_close(&file));
+
+	zassert_ok(fs_open(&file, MEM_FILE, FS_O_WRITE | FS_O_APPEND));
+	zassert_equal(fs_pwrite(&file, "xyz", 3, 0), -EINVAL);
+}
+
+ZTEST(fs_api_rw, test_copy)
+{
+	struct fs_dirent entry;
+	size_t len = sizeof(pattern);
+
+	open_pattern(len);
+	zassert_ok(fs_close(&file));
+
+	zassert_ok(fs_copy(MEM_FILE, MEM_FILE_COPY));
+	zassert_ok(fs_stat(MEM_FILE_COPY, &entry));
+	zassert_equal(entry.size, len);
+
+	zassert_ok(fs_open(&file, MEM_FILE_COPY, FS_O_READ));
+	zassert_equal(fs_read(&file, buf, sizeof(buf)), len);
+	zassert_mem_equal(buf, pattern, len);
+	zassert_ok(fs_close(&file));
+
+	zassert_equal(fs_copy(MEM_FILE, MEM_FILE_COPY), -EEXIST);
+	zassert_equal(fs_copy(MEM_FS_MNTP"/none", MEM_FS_MNTP"/c"), -ENOENT);
+	zassert_equal(fs_stat(MEM_FS_MNTP"/c", &entry), -ENOENT);
+}
+
+ZTEST(fs_api_rw, test_mmap_copy)
+{
+	const void *addr, *addr2;
+	size_t size;
+
+	open_pattern(1000);
+	zassert_ok(fs_seek(&file, 10, FS_SEEK_SET));
+
+	/* Not mapped by the file system, copied */
+	zassert_ok(fs_mmap(&file, &addr, &size));
+	zassert_equal(size, 1000);
+	zassert_mem_equal(addr, pattern, size);
+	zassert_equal(fs_tell(&file), 10);
+
+	zassert_ok(fs_mmap(&file, &addr2, &size));
+	zassert_not_equal(addr, addr2);
+	zassert_ok(fs_munmap(&file, addr2));
+
+	/* No room for a second copy of a large file */
+	zassert_ok(fs_close(&file));
+	open_pattern(MEM_FILE_SIZE);
+	zassert_ok(fs_mmap(&file, &addr2, &size));
+	zassert_equal(size, MEM_FILE_SIZE);
+	zassert_mem_equal(addr2, pattern, size);
+	zassert_equal(fs_mmap(&file, &addr2, &size), -ENOMEM);
+
+	zassert_ok(fs_munmap(&file, addr));
+	zassert_ok(fs_munmap(&file, addr2));
+}
+
+static void *fs_api_rw_setup(void)
+{
+	for (int i = 0; i < sizeof(pattern); i++) {
+		pattern[i] = i * 7;
+	}
+
+	zassert_ok(fs_register(TEST_FS_2, &mem_fs));
+	zassert_ok(fs_mount(&mem_mnt));
+
+	return NULL;
+}
+
+static void fs_api_rw_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	memset(files, 0, sizeof(files));
+	memset(handles, 0, sizeof(handles));
+	fs_file_t_init(&file);
+	pread_calls = 0;
+}
+
+static void fs_api_rw_teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	fs_unmount(&mem_mnt);
+	fs_unregister(TEST_FS_2, &mem_fs);
+}
+
+ZTEST_SUITE(fs_api_rw, NULL, fs_api_rw_setup, fs_api_rw_before, NULL,
+	    fs_api_rw_teardown);
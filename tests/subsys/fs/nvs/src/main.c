@@ -648,6 +648,7 @@ ZTEST_F(nvs, test_nvs_gc_corrupt_close_ate)
 	ate.id = 0x1;
 	ate.offset = 0;
 	ate.len = sizeof(data);
+	ate.part = 0xff;
 	ate.crc8 = crc8_ccitt(0xff, &ate,
 			      offsetof(struct nvs_ate, crc8));
 
@@ -869,3 +870,417 @@ ZTEST_F(nvs, test_nvs_cache_gc)
 	zassert_equal(num, 2, "invalid cache content after gc");
 #endif
 }
+
+struct foreach_ctx {
+	uint32_t found;
+	int count;
+	int stop_after;
+};
+
+static int foreach_cb(struct nvs_fs *fs, const struct nvs_entry *entry,
+		      void *user_data)
+{
+	struct foreach_ctx *ctx = user_data;
+	uint8_t rd_buf[32];
+	uint8_t buf[32];
+	ssize_t len;
+
+	zassert_true(entry->id < 32, "entry out of the ranges: %d", entry->id);
+	zassert_false(ctx->found & BIT(entry->id), "entry reported twice");
+	ctx->found |= BIT(entry->id);
+	ctx->count++;
+
+	/* The entry is the latest one, as found by nvs_read() */
+	len = nvs_entry_read(fs, entry, rd_buf, sizeof(rd_buf));
+	zassert_equal(len, entry->len, "nvs_entry_read failed: %d", len);
+	len = nvs_read(fs, entry->id, buf, sizeof(buf));
+	zassert_equal(len, entry->len, "nvs_read failed: %d", len);
+	zassert_mem_equal(buf, rd_buf, len, "entry data differs");
+
+	return (ctx->count == ctx->stop_after) ? 1 : 0;
+}
+
+/*
+ * Test the single pass walk of the latest entries.
+ */
+ZTEST_F(nvs, test_nvs_foreach)
+{
+	int err;
+	uint16_t max_id = 10;
+	uint32_t seen[2][NVS_ID_RANGE_SEEN_WORDS(10)];
+	const struct nvs_id_range ranges[] = {
+		{ .first = 0, .count = 4, .seen = seen[0] },
+		{ .first = 6, .count = 10, .seen = seen[1] },
+	};
+	struct foreach_ctx ctx = { 0 };
+
+	fixture->fs.sector_count = 3;
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0,  "nvs_mount call failure: %d", err);
+
+	/* Several rounds of writes, going through garbage collection */
+	write_content(max_id, 0, 200, &fixture->fs);
+
+	err = nvs_delete(&fixture->fs, 2);
+	zassert_true(err == 0,  "nvs_delete call failure: %d", err);
+	write_content(max_id, 200, 202, &fixture->fs);
+
+	/* Ids 0, 1, 3 and 6 to 9, id 2 is deleted and 4, 5 out of ranges */
+	err = nvs_foreach(&fixture->fs, ranges, ARRAY_SIZE(ranges), foreach_cb,
+			  &ctx);
+	zassert_true(err == 0,  "nvs_foreach call failure: %d", err);
+	zassert_equal(ctx.found, BIT_MASK(10) & ~(BIT(2) | BIT(4) | BIT(5)),
+		      "unexpected entries found: 0x%x", ctx.found);
+
+	/* The callback stops the walk, from the most recent entry */
+	memset(&ctx, 0, sizeof(ctx));
+	ctx.stop_after = 1;
+	err = nvs_foreach(&fixture->fs, ranges, ARRAY_SIZE(ranges), foreach_cb,
+			  &ctx);
+	zassert_equal(err, 1, "nvs_foreach not stopped: %d", err);
+	zassert_equal(ctx.found, BIT(1), "unexpected entries found: 0x%x",
+		      ctx.found);
+}
+
+static int entry_get_cb(struct nvs_fs *fs, const struct nvs_entry *entry,
+			void *user_data)
+{
+	ARG_UNUSED(fs);
+
+	*(struct nvs_entry *)user_data = *entry;
+
+	return 0;
+}
+
+/*
+ * Test reading an entry after a garbage collection moved its data.
+ */
+ZTEST_F(nvs, test_nvs_entry_read_moved)
+{
+	int err;
+	ssize_t len;
+	uint32_t seen[NVS_ID_RANGE_SEEN_WORDS(1)];
+	const struct nvs_id_range range = { .first = 1, .count = 1, .seen = seen };
+	struct nvs_entry entry;
+	uint8_t buf[32];
+	uint8_t rd_buf[32];
+	/* One more than fit in a sector */
+	const uint16_t max_writes =
+		fixture->fs.sector_size / (sizeof(buf) + sizeof(struct nvs_ate)) + 1;
+
+	fixture->fs.sector_count = 2;
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0,  "nvs_mount call failure: %d", err);
+
+	memset(buf, 0xa5, sizeof(buf));
+	len = nvs_write(&fixture->fs, 1, buf, sizeof(buf));
+	zassert_true(len == sizeof(buf), "nvs_write failed: %d", len);
+
+	err = nvs_foreach(&fixture->fs, &range, 1, entry_get_cb, &entry);
+	zassert_true(err == 0,  "nvs_foreach call failure: %d", err);
+
+	/* Fill the sector with other ids, the garbage collection copies id 1 */
+	for (uint16_t i = 0; i < max_writes; i++) {
+		memset(rd_buf, i, sizeof(rd_buf));
+		len = nvs_write(&fixture->fs, 2 + (i % 8), rd_buf, sizeof(rd_buf));
+		zassert_true(len == sizeof(rd_buf), "nvs_write failed: %d", len);
+	}
+	zassert_not_equal(entry.ate_wra >> ADDR_SECT_SHIFT,
+			  fixture->fs.ate_wra >> ADDR_SECT_SHIFT,
+			  "no garbage collection");
+
+	len = nvs_entry_read(&fixture->fs, &entry, rd_buf, sizeof(rd_buf));
+	zassert_equal(len, sizeof(rd_buf), "nvs_entry_read failed: %d", len);
+	zassert_mem_equal(buf, rd_buf, sizeof(rd_buf), "entry data differs");
+}
+
+#if CONFIG_NVS_STATS
+ZTEST_F(nvs, test_nvs_stats)
+{
+	int err;
+	ssize_t len;
+	uint8_t buf[32];
+	struct nvs_stats stats;
+	/* One more than fit in a sector */
+	const uint16_t max_writes =
+		fixture->fs.sector_size / (sizeof(buf) + sizeof(struct nvs_ate)) + 1;
+
+	fixture->fs.sector_count = 2;
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0,  "nvs_mount call failure: %d", err);
+
+	write_content(10, 0, max_writes, &fixture->fs);
+
+	nvs_stats_get(&fixture->fs, &stats);
+	zassert_equal(stats.write_count, max_writes, "writes: %u",
+		      stats.write_count);
+	zassert_equal(stats.gc_count, 1, "gc: %u", stats.gc_count);
+	zassert_equal(stats.gc_background, 0, "background gc: %u",
+		      stats.gc_background);
+	zassert_true(stats.gc_bytes_moved > 0, "no data moved");
+	zassert_true(stats.gc_bytes_moved <= 10 * sizeof(buf),
+		     "unexpected data moved: %llu", stats.gc_bytes_moved);
+
+	/* Unchanged data is not written */
+	len = nvs_read(&fixture->fs, 0, buf, sizeof(buf));
+	zassert_true(len == sizeof(buf), "nvs_read failed: %d", len);
+	len = nvs_write(&fixture->fs, 0, buf, sizeof(buf));
+	zassert_true(len == 0, "nvs_write failed: %d", len);
+
+	nvs_stats_get(&fixture->fs, &stats);
+	zassert_equal(stats.write_count, max_writes, "writes: %u",
+		      stats.write_count);
+
+	nvs_stats_reset(&fixture->fs);
+	nvs_stats_get(&fixture->fs, &stats);
+	zassert_equal(stats.write_count, 0, "writes: %u", stats.write_count);
+	zassert_equal(stats.gc_count, 0, "gc: %u", stats.gc_count);
+	zassert_equal(stats.gc_bytes_moved, 0, "data moved");
+}
+
+#if CONFIG_NVS_BACKGROUND_GC
+/*
+ * Test the garbage collection running ahead of the writes once the current
+ * sector falls below the threshold.
+ */
+ZTEST_F(nvs, test_nvs_background_gc)
+{
+	int err;
+	uint32_t sector;
+	struct nvs_stats stats;
+	const uint16_t max_id = 10;
+	/* Just enough to go below the threshold */
+	const uint16_t writes =
+		fixture->fs.sector_size * (100 - CONFIG_NVS_BACKGROUND_GC_THRESHOLD) /
+		100 / (32 + sizeof(struct nvs_ate)) + 1;
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0,  "nvs_mount call failure: %d", err);
+
+	sector = fixture->fs.ate_wra >> ADDR_SECT_SHIFT;
+	write_content(max_id, 0, writes, &fixture->fs);
+	zassert_equal(fixture->fs.ate_wra >> ADDR_SECT_SHIFT, sector,
+		      "sector closed by a write");
+
+	/* The test thread is cooperative, the collection runs once it sleeps */
+	k_msleep(10);
+
+	nvs_stats_get(&fixture->fs, &stats);
+	zassert_equal(stats.gc_background, 1, "background gc: %u",
+		      stats.gc_background);
+	zassert_not_equal(fixture->fs.ate_wra >> ADDR_SECT_SHIFT, sector,
+			  "sector not closed");
+	check_content(max_id, &fixture->fs);
+
+	/* The next writes find room */
+	write_content(max_id, writes, writes + max_id, &fixture->fs);
+	nvs_stats_get(&fixture->fs, &stats);
+	zassert_equal(stats.gc_background, 1, "background gc: %u",
+		      stats.gc_background);
+	zassert_equal(stats.gc_count, 1, "gc: %u", stats.gc_count);
+	check_content(max_id, &fixture->fs);
+}
+#endif
+#endif
+
+#define TEST_LARGE_LEN 6000
+
+static uint8_t large_wr_buf[TEST_LARGE_LEN];
+static uint8_t large_rd_buf[TEST_LARGE_LEN];
+
+static void large_pattern(uint8_t seed)
+{
+	for (size_t i = 0; i < sizeof(large_wr_buf); i++) {
+		large_wr_buf[i] = (uint8_t)(i * 7 + seed);
+	}
+}
+
+static void large_check(struct nvs_fs *fs, uint16_t id)
+{
+	ssize_t len;
+
+	memset(large_rd_buf, 0, sizeof(large_rd_buf));
+	len = nvs_read(fs, id, large_rd_buf, sizeof(large_rd_buf));
+	zassert_equal(len, sizeof(large_rd_buf), "nvs_read failed: %d", len);
+	zassert_mem_equal(large_wr_buf, large_rd_buf, sizeof(large_rd_buf),
+			  "large entry differs");
+}
+
+/*
+ * Test entries spanning several sectors.
+ */
+ZTEST_F(nvs, test_nvs_large)
+{
+	int err;
+	ssize_t len;
+	uint8_t buf[16];
+	uint32_t seen[NVS_ID_RANGE_SEEN_WORDS(1)];
+	const struct nvs_id_range range = { .first = 1, .count = 1, .seen = seen };
+	struct nvs_entry entry;
+
+	BUILD_ASSERT(TEST_LARGE_LEN > 4096, "not larger than a sector");
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0,  "nvs_mount call failure: %d", err);
+
+	large_pattern(0);
+	len = nvs_write(&fixture->fs, 1, large_wr_buf, sizeof(large_wr_buf));
+	zassert_equal(len, sizeof(large_wr_buf), "nvs_write failed: %d", len);
+	large_check(&fixture->fs, 1);
+
+	/* A partial read returns the length of the entry */
+	len = nvs_read(&fixture->fs, 1, buf, sizeof(buf));
+	zassert_equal(len, sizeof(large_wr_buf), "nvs_read failed: %d", len);
+	zassert_mem_equal(large_wr_buf, buf, sizeof(buf), "large entry differs");
+
+	/* Unchanged data is not written */
+	len = nvs_write(&fixture->fs, 1, large_wr_buf, sizeof(large_wr_buf));
+	zassert_equal(len, 0, "nvs_write failed: %d", len);
+
+	/* Rewrites, interleaved with other entries, go through the garbage
+	 * collection of the chunks.
+	 */
+	for (uint8_t seed = 1; seed < 6; seed++) {
+		write_content(10, 0, 40, &fixture->fs);
+		large_pattern(seed);
+		len = nvs_write(&fixture->fs, 1, large_wr_buf,
+				sizeof(large_wr_buf));
+		zassert_equal(len, sizeof(large_wr_buf), "nvs_write failed: %d",
+			      len);
+		large_check(&fixture->fs, 1);
+	}
+
+	len = nvs_calc_free_space(&fixture->fs);
+	zassert_true(len > 0, "nvs_calc_free_space failed: %d", len);
+	zassert_true(len < (fixture->fs.sector_count - 1) * fixture->fs.sector_size -
+			   sizeof(large_wr_buf), "free space too large: %d", len);
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0,  "nvs_mount call failure: %d", err);
+	large_check(&fixture->fs, 1);
+
+	err = nvs_foreach(&fixture->fs, &range, 1, entry_get_cb, &entry);
+	zassert_true(err == 0,  "nvs_foreach call failure: %d", err);
+	zassert_equal(entry.len, sizeof(large_wr_buf), "entry length: %d",
+		      entry.len);
+	len = nvs_entry_read(&fixture->fs, &entry, large_rd_buf,
+			     sizeof(large_rd_buf));
+	zassert_equal(len, sizeof(large_rd_buf), "nvs_entry_read failed: %d", len);
+	zassert_mem_equal(large_wr_buf, large_rd_buf, sizeof(large_rd_buf),
+			  "large entry differs");
+
+	/* A small entry replaces the large one */
+	len = nvs_write(&fixture->fs, 1, buf, sizeof(buf));
+	zassert_equal(len, sizeof(buf), "nvs_write failed: %d", len);
+	len = nvs_read(&fixture->fs, 1, large_rd_buf, sizeof(large_rd_buf));
+	zassert_equal(len, sizeof(buf), "nvs_read failed: %d", len);
+
+	err = nvs_delete(&fixture->fs, 1);
+	zassert_true(err == 0,  "nvs_delete call failure: %d", err);
+	len = nvs_read(&fixture->fs, 1, large_rd_buf, sizeof(large_rd_buf));
+	zassert_equal(len, -ENOENT, "nvs_read unexpected result: %d", len);
+}
+
+/*
+ * Test that an interrupted write of a large entry keeps the previous one.
+ */
+ZTEST_F(nvs, test_nvs_large_interrupted)
+{
+	int err;
+	ssize_t len;
+	uint32_t *flash_write_stat;
+	uint32_t *flash_max_write_calls;
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0,  "nvs_mount call failure: %d", err);
+
+	large_pattern(0);
+	len = nvs_write(&fixture->fs, 1, large_wr_buf, sizeof(large_wr_buf));
+	zassert_equal(len, sizeof(large_wr_buf), "nvs_write failed: %d", len);
+
+	/* Lose the writes after the first chunk, as a power down would */
+	stats_walk(fixture->sim_thresholds, flash_sim_max_write_calls_find,
+		   &flash_max_write_calls);
+	stats_walk(fixture->sim_stats, flash_sim_write_calls_find, &flash_write_stat);
+	*flash_max_write_calls = 2;
+	*flash_write_stat = 0;
+
+	large_pattern(1);
+	len = nvs_write(&fixture->fs, 1, large_wr_buf, sizeof(large_wr_buf));
+	zassert_equal(len, sizeof(large_wr_buf), "nvs_write failed: %d", len);
+
+	*flash_max_write_calls = 0;
+
+	memset(&fixture->fs, 0, sizeof(fixture->fs));
+	(void)setup();
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0,  "nvs_mount call failure: %d", err);
+
+	large_pattern(0);
+	large_check(&fixture->fs, 1);
+
+	/* The orphan chunk is not taken for a chunk of the next write */
+	large_pattern(2);
+	len = nvs_write(&fixture->fs, 1, large_wr_buf, sizeof(large_wr_buf));
+	zassert_equal(len, sizeof(large_wr_buf), "nvs_write failed: %d", len);
+	large_check(&fixture->fs, 1);
+}
+
+/*
+ * Test the scatter-gather write and read.
+ */
+ZTEST_F(nvs, test_nvs_iovec)
+{
+	int err;
+	ssize_t len;
+	uint8_t a[3] = { 1, 2, 3 };
+	uint8_t b[40];
+	uint8_t c[5] = { 4, 5, 6, 7, 8 };
+	uint8_t all[sizeof(a) + sizeof(b) + sizeof(c)];
+	uint8_t rd_buf[sizeof(all)];
+	uint8_t rd_a[10], rd_b[sizeof(all) - sizeof(rd_a)];
+	struct nvs_iovec iov[] = {
+		{ .data = a, .len = sizeof(a) },
+		{ .data = NULL, .len = 0 },
+		{ .data = b, .len = sizeof(b) },
+		{ .data = c, .len = sizeof(c) },
+	};
+	struct nvs_iovec rd_iov[] = {
+		{ .data = rd_a, .len = sizeof(rd_a) },
+		{ .data = rd_b, .len = sizeof(rd_b) },
+	};
+
+	for (size_t i = 0; i < sizeof(b); i++) {
+		b[i] = 0x80 + i;
+	}
+	memcpy(all, a, sizeof(a));
+	memcpy(&all[sizeof(a)], b, sizeof(b));
+	memcpy(&all[sizeof(a) + sizeof(b)], c, sizeof(c));
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0,  "nvs_mount call failure: %d", err);
+
+	len = nvs_writev(&fixture->fs, 1, iov, ARRAY_SIZE(iov));
+	zassert_equal(len, sizeof(all), "nvs_writev failed: %d", len);
+
+	len = nvs_read(&fixture->fs, 1, rd_buf, sizeof(rd_buf));
+	zassert_equal(len, sizeof(all), "nvs_read failed: %d", len);
+	zassert_mem_equal(all, rd_buf, sizeof(all), "gathered data differs");
+
+	/* Unchanged data is not written */
+	len = nvs_write(&fixture->fs, 1, all, sizeof(all));
+	zassert_equal(len, 0, "nvs_write failed: %d", len);
+
+	len = nvs_readv(&fixture->fs, 1, rd_iov, ARRAY_SIZE(rd_iov));
+	zassert_equal(len, sizeof(all), "nvs_readv failed: %d", len);
+	zassert_mem_equal(all, rd_a, sizeof(rd_a), "scattered data differs");
+	zassert_mem_equal(&all[sizeof(rd_a)], rd_b, sizeof(rd_b),
+			  "scattered data differs");
+
+	iov[1].len = 1;
+	len = nvs_writev(&fixture->fs, 1, iov, ARRAY_SIZE(iov));
+	zassert_equal(len, -EINVAL, "nvs_writev unexpected result: %d", len);
+}
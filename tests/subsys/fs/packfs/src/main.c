@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zephyr/fs/fs.h>
+#include <zephyr/fs/packfs.h>
+#include <zephyr/sys/byteorder.h>
+
+#define MNT_POINT "/pack"
+
+static const uint8_t image[] __aligned(4) = {
+#include "packfs_image.inc"
+};
+
+static struct fs_packfs packfs = {
+	.image = image,
+};
+
+static struct fs_mount_t mnt = {
+	.type = FS_PACKFS,
+	.fs_data = &packfs,
+	.mnt_point = MNT_POINT,
+};
+
+static struct fs_file_t file;
+
+static void check_file(const char *path, const char *content, size_t size)
+{
+	struct fs_dirent entry;
+	char buf[64];
+
+	zassert_ok(fs_stat(path, &entry));
+	zassert_equal(entry.type, FS_DIR_ENTRY_FILE);
+	zassert_equal(entry.size, size);
+
+	zassert_ok(fs_open(&file, path, FS_O_READ));
+	zassert_equal(fs_read(&file, buf, sizeof(buf)), size);
+	zassert_mem_equal(buf, content, size);
+	zassert_equal(fs_read(&file, buf, sizeof(buf)), 0);
+	zassert_ok(fs_close(&file));
+}
+
+ZTEST(fs_packfs, test_read)
+{
+	check_file(MNT_POINT "/hello.txt", "Hello, packfs!\n", 15);
+	check_file(MNT_POINT "/sub.txt", "next to the directory\n", 22);
+	check_file(MNT_POINT "/sub/deep/x.txt", "deep\n", 5);
+	check_file(MNT_POINT "/subdir/y.txt", "other\n", 6);
+	check_file(MNT_POINT "/sub/empty", "", 0);
+
+	zassert_equal(fs_open(&file, MNT_POINT "/none", FS_O_READ), -ENOENT);
+	zassert_equal(fs_open(&file, MNT_POINT "/sub/deep/x", FS_O_READ),
+		      -ENOENT);
+	zassert_equal(fs_open(&file, MNT_POINT "/sub", FS_O_READ), -EISDIR);
+}
+
+ZTEST(fs_packfs, test_seek)
+{
+	char buf[4];
+
+	zassert_ok(fs_open(&file, MNT_POINT "/sub/data.bin", FS_O_READ));
+
+	zassert_ok(fs_seek(&file, 10, FS_SEEK_SET));
+	zassert_equal(fs_read(&file, buf, sizeof(buf)), sizeof(buf));
+	zassert_mem_equal(buf, "abcd", sizeof(buf));
+	zassert_equal(fs_tell(&file), 14);
+
+	zassert_ok(fs_seek(&file, -2, FS_SEEK_END));
+	zassert_equal(fs_read(&file, buf, sizeof(buf)), 2);
+	zassert_mem_equal(buf, "yz", 2);
+
+	zassert_equal(fs_seek(&file, 1, FS_SEEK_END), -EINVAL);
+	zassert_equal(fs_pread(&file, buf, sizeof(buf), 3), sizeof(buf));
+	zassert_mem_equal(buf, "3456", sizeof(buf));
+	zassert_equal(fs_tell(&file), 36);
+
+	zassert_ok(fs_close(&file));
+}
+
+ZTEST(fs_packfs, test_read_only)
+{
+	zassert_equal(fs_open(&file, MNT_POINT "/hello.txt", FS_O_RDWR),
+		      -EROFS);
+	zassert_equal(fs_open(&file, MNT_POINT "/new", FS_O_CREATE | FS_O_WRITE),
+		      -EROFS);
+	zassert_equal(fs_unlink(MNT_POINT "/hello.txt"), -EROFS);
+	zassert_equal(fs_mkdir(MNT_POINT "/dir"), -EROFS);
+}
+
+static void check_dir(const char *path, const char *const *names,
+		      const enum fs_dir_entry_type *types, int count)
+{
+	struct fs_dirent entry;
+	struct fs_dir_t dir;
+
+	fs_dir_t_init(&dir);
+	zassert_ok(fs_opendir(&dir, path));
+
+	for (int i = 0; i < count; i++) {
+		zassert_ok(fs_readdir(&dir, &entry));
+		zassert_true(strcmp(entry.name, names[i]) == 0,
+			     "%s: %s instead of %s", path, entry.name, names[i]);
+		zassert_equal(entry.type, types[i]);
+	}
+
+	zassert_ok(fs_readdir(&dir, &entry));
+	zassert_equal(entry.name[0], '\0', "%s: extra %s", path, entry.name);
+	zassert_ok(fs_closedir(&dir));
+}
+
+ZTEST(fs_packfs, test_readdir)
+{
+	static const char *const root[] = {
+		"hello.txt", "sub.txt", "sub", "subdir",
+	};
+	static const enum fs_dir_entry_type root_types[] = {
+		FS_DIR_ENTRY_FILE, FS_DIR_ENTRY_FILE, FS_DIR_ENTRY_DIR,
+		FS_DIR_ENTRY_DIR,
+	};
+	static const char *const sub[] = { "data.bin", "deep", "empty" };
+	static const enum fs_dir_entry_type sub_types[] = {
+		FS_DIR_ENTRY_FILE, FS_DIR_ENTRY_DIR, FS_DIR_ENTRY_FILE,
+	};
+	struct fs_dirent entry;
+	struct fs_dir_t dir;
+
+	check_dir(MNT_POINT, root, root_types, ARRAY_SIZE(root));
+	check_dir(MNT_POINT "/sub", sub, sub_types, ARRAY_SIZE(sub));
+	check_dir(MNT_POINT "/sub/", sub, sub_types, ARRAY_SIZE(sub));
+
+	zassert_ok(fs_stat(MNT_POINT "/sub/deep", &entry));
+	zassert_equal(entry.type, FS_DIR_ENTRY_DIR);
+	zassert_equal(strcmp(entry.name, "deep"), 0);
+
+	fs_dir_t_init(&dir);
+	zassert_equal(fs_opendir(&dir, MNT_POINT "/su"), -ENOENT);
+	zassert_equal(fs_opendir(&dir, MNT_POINT "/hello.txt"), -ENOENT);
+}
+
+ZTEST(fs_packfs, test_mmap)
+{
+	const void *addr;
+	size_t size;
+
+	zassert_ok(fs_open(&file, MNT_POINT "/sub/data.bin", FS_O_READ));
+	zassert_ok(fs_mmap(&file, &addr, &size));
+	zassert_equal(size, 36);
+	zassert_mem_equal(addr, "0123456789", 10);
+
+	/* In place in the image, aligned */
+	zassert_true(((const uint8_t *)addr >= image) &&
+		     ((const uint8_t *)addr + size <= image + sizeof(image)));
+	zassert_equal((uintptr_t)addr % 4, 0);
+
+	zassert_ok(fs_munmap(&file, addr));
+	zassert_ok(fs_close(&file));
+}
+
+ZTEST(fs_packfs, test_invalid_image)
+{
+	static uint8_t bad[sizeof(image)] __aligned(4);
+	struct fs_packfs bad_fs = { .image = bad };
+	struct fs_mount_t bad_mnt = {
+		.type = FS_PACKFS,
+		.fs_data = &bad_fs,
+		.mnt_point = "/bad",
+	};
+	struct packfs_header *hdr = (struct packfs_header *)bad;
+
+	memcpy(bad, image, sizeof(image));
+	hdr->magic ^= 1;
+	zassert_equal(fs_mount(&bad_mnt), -EINVAL);
+
+	memcpy(bad, image, sizeof(image));
+	hdr->image_size = sys_cpu_to_le32(sizeof(struct packfs_header));
+	zassert_equal(fs_mount(&bad_mnt), -EINVAL);
+}
+
+static void *fs_packfs_setup(void)
+{
+	zassert_ok(fs_mount(&mnt));
+
+	return NULL;
+}
+
+static void fs_packfs_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	fs_file_t_init(&file);
+}
+
+ZTEST_SUITE(fs_packfs, NULL, fs_packfs_setup, fs_packfs_before, NULL, NULL);
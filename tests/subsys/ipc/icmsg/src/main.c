@@ -0,0 +1,250 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/mbox/mbox_emul.h>
+#include <zephyr/ipc/ipc_service.h>
+#include <zephyr/ztest.h>
+
+/* ipc0 signals ipc1 on this channel of the emulated MBOX */
+#define IPC0_TX_CHANNEL 0
+
+#define BURST_LEN 8
+#define MSG_LEN 16
+
+static const struct device *mbox = DEVICE_DT_GET(DT_NODELABEL(mbox_emul));
+
+static struct ipc_ept ept0;
+static struct ipc_ept ept1;
+
+static K_SEM_DEFINE(bound_sem, 0, 2);
+static K_SEM_DEFINE(rx_sem, 0, BURST_LEN);
+
+static uint8_t rx_data[BURST_LEN][MSG_LEN];
+static size_t rx_len[BURST_LEN];
+static int rx_cnt;
+
+/* Message held by the receiver, NULL if received messages are not held */
+static void *held;
+static bool hold_next;
+
+static void bound_cb(void *priv)
+{
+	k_sem_give(&bound_sem);
+}
+
+static void received_cb(const void *data, size_t len, void *priv)
+{
+	zassert_true(rx_cnt < BURST_LEN, "Too many messages");
+	zassert_true(len <= MSG_LEN, "Unexpected message length %zu", len);
+
+	memcpy(rx_data[rx_cnt], data, len);
+	rx_len[rx_cnt] = len;
+	rx_cnt++;
+
+	if (hold_next) {
+		hold_next = false;
+		held = (void *)data;
+		zassert_ok(ipc_service_hold_rx_buffer(&ept1, held));
+	}
+
+	k_sem_give(&rx_sem);
+}
+
+static struct ipc_ept_cfg ept0_cfg = {
+	.name = "ept0",
+	.cb = {
+		.bound = bound_cb,
+	},
+};
+
+static struct ipc_ept_cfg ept1_cfg = {
+	.name = "ept1",
+	.cb = {
+		.bound = bound_cb,
+		.received = received_cb,
+	},
+};
+
+static void fill(uint8_t *buf, size_t len, uint8_t seed)
+{
+	for (size_t i = 0; i < len; i++) {
+		buf[i] = seed + i;
+	}
+}
+
+static void check_rx(int idx, size_t len, uint8_t seed)
+{
+	uint8_t exp[MSG_LEN];
+
+	fill(exp, len, seed);
+	zassert_equal(rx_len[idx], len, "Unexpected length %zu", rx_len[idx]);
+	zassert_mem_equal(rx_data[idx], exp, len);
+}
+
+static void wait_rx(int cnt)
+{
+	for (int i = 0; i < cnt; i++) {
+		zassert_ok(k_sem_take(&rx_sem, K_MSEC(100)), "Message %d not received", i);
+	}
+}
+
+ZTEST(icmsg, test_send)
+{
+	uint8_t msg[MSG_LEN];
+	int ret;
+
+	fill(msg, sizeof(msg), 1);
+
+	ret = ipc_service_send(&ept0, msg, sizeof(msg));
+	zassert_equal(ret, sizeof(msg), "Unexpected ret %d", ret);
+
+	wait_rx(1);
+	check_rx(0, sizeof(msg), 1);
+
+	ret = ipc_service_send(&ept0, msg, 0);
+	zassert_equal(ret, -ENODATA, "Unexpected ret %d", ret);
+}
+
+ZTEST(icmsg, test_send_nocopy)
+{
+	uint32_t size = MSG_LEN;
+	void *data;
+	int ret;
+
+	ret = ipc_service_get_tx_buffer_size(&ept0);
+	zassert_true(ret > MSG_LEN, "Unexpected size %d", ret);
+
+	ret = ipc_service_get_tx_buffer(&ept0, &data, &size, K_NO_WAIT);
+	zassert_ok(ret);
+	zassert_true(size >= MSG_LEN);
+
+	/* Only one message is prepared at a time */
+	ret = ipc_service_send(&ept0, data, MSG_LEN);
+	zassert_equal(ret, -EBUSY, "Unexpected ret %d", ret);
+
+	fill(data, MSG_LEN, 2);
+	ret = ipc_service_send_nocopy(&ept0, data, MSG_LEN);
+	zassert_equal(ret, MSG_LEN, "Unexpected ret %d", ret);
+
+	wait_rx(1);
+	check_rx(0, MSG_LEN, 2);
+
+	/* A dropped buffer is not sent */
+	size = MSG_LEN;
+	zassert_ok(ipc_service_get_tx_buffer(&ept0, &data, &size, K_NO_WAIT));
+	zassert_ok(ipc_service_drop_tx_buffer(&ept0, data));
+	zassert_equal(ipc_service_drop_tx_buffer(&ept0, data), -EALREADY);
+
+	zassert_equal(k_sem_take(&rx_sem, K_MSEC(10)), -EAGAIN);
+	zassert_equal(rx_cnt, 1);
+}
+
+ZTEST(icmsg, test_tx_buffer_too_big)
+{
+	uint32_t size = UINT32_MAX;
+	void *data;
+	int max;
+	int ret;
+
+	max = ipc_service_get_tx_buffer_size(&ept0);
+
+	ret = ipc_service_get_tx_buffer(&ept0, &data, &size, K_NO_WAIT);
+	zassert_equal(ret, -ENOMEM, "Unexpected ret %d", ret);
+	zassert_equal(size, max, "Unexpected size %u", size);
+}
+
+ZTEST(icmsg, test_hold_rx)
+{
+	uint8_t msg[MSG_LEN];
+	int ret;
+
+	if (!IS_ENABLED(CONFIG_IPC_SERVICE_ICMSG_NOCOPY_RX)) {
+		ret = ipc_service_hold_rx_buffer(&ept1, msg);
+		zassert_equal(ret, -EIO, "Unexpected ret %d", ret);
+		ztest_test_skip();
+	}
+
+	hold_next = true;
+
+	for (int i = 0; i < 2; i++) {
+		fill(msg, sizeof(msg), 3 + i);
+		ret = ipc_service_send(&ept0, msg, sizeof(msg));
+		zassert_equal(ret, sizeof(msg), "Unexpected ret %d", ret);
+	}
+
+	/* The second message is not processed while the first is held */
+	wait_rx(1);
+	zassert_equal(k_sem_take(&rx_sem, K_MSEC(10)), -EAGAIN);
+	check_rx(0, sizeof(msg), 3);
+
+	zassert_ok(ipc_service_release_rx_buffer(&ept1, held));
+
+	wait_rx(1);
+	check_rx(1, sizeof(msg), 4);
+}
+
+ZTEST(icmsg, test_coalesced_notify)
+{
+	uint8_t msg[MSG_LEN];
+	uint32_t signals;
+	int ret;
+
+	signals = mbox_emul_signals_get(mbox, IPC0_TX_CHANNEL);
+
+	/* The receiver does not run before the whole burst is sent */
+	k_sched_lock();
+	for (int i = 0; i < BURST_LEN; i++) {
+		fill(msg, sizeof(msg), i);
+		ret = ipc_service_send(&ept0, msg, sizeof(msg));
+		zassert_equal(ret, sizeof(msg), "Unexpected ret %d", ret);
+	}
+	k_sched_unlock();
+
+	wait_rx(BURST_LEN);
+	for (int i = 0; i < BURST_LEN; i++) {
+		check_rx(i, sizeof(msg), i);
+	}
+
+	signals = mbox_emul_signals_get(mbox, IPC0_TX_CHANNEL) - signals;
+	if (IS_ENABLED(CONFIG_IPC_SERVICE_ICMSG_COALESCE_NOTIFY)) {
+		zassert_equal(signals, 1, "Unexpected signals %u", signals);
+	} else {
+		zassert_equal(signals, BURST_LEN, "Unexpected signals %u", signals);
+	}
+}
+
+static void *icmsg_setup(void)
+{
+	int ret;
+
+	ret = ipc_service_register_endpoint(DEVICE_DT_GET(DT_NODELABEL(ipc0)),
+					    &ept0, &ept0_cfg);
+	zassert_ok(ret, "ipc_service_register_endpoint() failed");
+
+	ret = ipc_service_register_endpoint(DEVICE_DT_GET(DT_NODELABEL(ipc1)),
+					    &ept1, &ept1_cfg);
+	zassert_ok(ret, "ipc_service_register_endpoint() failed");
+
+	for (int i = 0; i < 2; i++) {
+		zassert_ok(k_sem_take(&bound_sem, K_MSEC(100)), "Not bound");
+	}
+
+	return NULL;
+}
+
+static void icmsg_before(void *fixture)
+{
+	rx_cnt = 0;
+	held = NULL;
+	hold_next = false;
+	k_sem_reset(&rx_sem);
+}
+
+ZTEST_SUITE(icmsg, NULL, icmsg_setup, icmsg_before, NULL, NULL);
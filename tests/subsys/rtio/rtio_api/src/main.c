@@ -53,6 +53,7 @@ ZTEST(rtio_spsc, test_produce_consume_size1)
 	uint32_t *cons2 = rtio_spsc_consume(&ezspsc);
 
 	zassert_equal(rtio_spsc_consumable(&ezspsc), 0, "Consumables should be 0");
+	zassert_equal(rtio_spsc_consumed(&ezspsc), 1, "Consumed should be 1");
 
 	zassert_not_null(cons2, "Consume should not fail");
 	zassert_equal(*cons2, magic, "Consume value should equal magic");
@@ -68,6 +69,8 @@ ZTEST(rtio_spsc, test_produce_consume_size1)
 
 	rtio_spsc_release(&ezspsc);
 
+	zassert_equal(rtio_spsc_consumed(&ezspsc), 0, "Consumed should be 0");
+
 	uint32_t *acq4 = rtio_spsc_acquire(&ezspsc);
 
 	zassert_not_null(acq4, "Acquire should succeed");
@@ -422,6 +425,228 @@ ZTEST(rtio_api, test_rtio_multiple_chains)
 
 
 
+RTIO_EXECUTOR_SIMPLE_DEFINE(ops_exec_simp);
+RTIO_DEFINE(r_ops_simp, (struct rtio_executor *)&ops_exec_simp, 4, 4);
+
+RTIO_EXECUTOR_CONCURRENT_DEFINE(ops_exec_con, 2);
+RTIO_DEFINE(r_ops_con, (struct rtio_executor *)&ops_exec_con, 4, 4);
+
+RTIO_IODEV_TEST_DEFINE(iodev_test_ops, 1);
+
+static atomic_t ops_callbacks;
+
+static void rtio_ops_callback(struct rtio *r, const struct rtio_sqe *sqe, void *arg0)
+{
+	zassert_equal_ptr(arg0, &ops_callbacks, "Expected the callback argument");
+	atomic_inc(&ops_callbacks);
+}
+
+/**
+ * @brief Test a write, read and callback chain completing once
+ *
+ * Ensures the executor runs callback submissions in order with the chain
+ * and that submissions flagged RTIO_SQE_NO_RESPONSE produce no completion.
+ */
+void test_rtio_callback_chain_(struct rtio *r)
+{
+	int res;
+	const uint8_t reg = 0x28;
+	uint8_t tx_buf[2] = {0x20, 0x57};
+	uint8_t rx_buf[6];
+	uintptr_t userdata[4] = {0, 1, 2, 3};
+	struct rtio_sqe *sqe;
+	struct rtio_cqe *cqe;
+
+	atomic_set(&ops_callbacks, 0);
+
+	sqe = rtio_spsc_acquire(r->sq);
+	zassert_not_null(sqe, "Expected a valid sqe");
+	rtio_sqe_prep_tiny_write(sqe, &iodev_test_ops, 0, &reg, 1, &userdata[0]);
+	sqe->flags = RTIO_SQE_CHAINED | RTIO_SQE_NO_RESPONSE;
+	zassert_equal(sqe->tiny_buf[0], reg, "Expected the data in the submission");
+
+	sqe = rtio_spsc_acquire(r->sq);
+	zassert_not_null(sqe, "Expected a valid sqe");
+	rtio_sqe_prep_transceive(sqe, &iodev_test_ops, 0, tx_buf, rx_buf, sizeof(tx_buf),
+				 &userdata[1]);
+	sqe->flags = RTIO_SQE_CHAINED | RTIO_SQE_NO_RESPONSE;
+
+	sqe = rtio_spsc_acquire(r->sq);
+	zassert_not_null(sqe, "Expected a valid sqe");
+	rtio_sqe_prep_read(sqe, &iodev_test_ops, 0, rx_buf, sizeof(rx_buf), &userdata[2]);
+	sqe->flags = RTIO_SQE_CHAINED | RTIO_SQE_NO_RESPONSE;
+
+	sqe = rtio_spsc_acquire(r->sq);
+	zassert_not_null(sqe, "Expected a valid sqe");
+	rtio_sqe_prep_callback(sqe, rtio_ops_callback, &ops_callbacks, &userdata[3]);
+
+	res = rtio_submit(r, 1);
+	zassert_ok(res, "Should return ok from rtio_execute");
+	zassert_equal(atomic_get(&ops_callbacks), 1, "Expected one callback");
+
+	cqe = rtio_spsc_consume(r->cq);
+	zassert_not_null(cqe, "Expected a valid cqe");
+	zassert_ok(cqe->result, "Result should be ok");
+	zassert_equal_ptr(cqe->userdata, &userdata[3], "Expected the callback completion");
+	rtio_spsc_release(r->cq);
+
+	zassert_is_null(rtio_spsc_consume(r->cq), "Expected a single completion");
+}
+
+ZTEST(rtio_api, test_rtio_callback_chain)
+{
+	rtio_iodev_test_init(&iodev_test_ops);
+
+	TC_PRINT("rtio callback chain simple\n");
+	test_rtio_callback_chain_(&r_ops_simp);
+	TC_PRINT("rtio callback chain concurrent\n");
+	test_rtio_callback_chain_(&r_ops_con);
+}
+
+/**
+ * @brief Test canceling a chain before it is submitted
+ */
+void test_rtio_cancel_(struct rtio *r)
+{
+	int res;
+	uintptr_t userdata[2] = {0, 1};
+	struct rtio_sqe *sqe;
+	struct rtio_cqe *cqe;
+
+	for (int i = 0; i < 2; i++) {
+		sqe = rtio_spsc_acquire(r->sq);
+		zassert_not_null(sqe, "Expected a valid sqe");
+		rtio_sqe_prep_nop(sqe, &iodev_test_ops, &userdata[i]);
+		if (i == 0) {
+			sqe->flags |= RTIO_SQE_CHAINED;
+			rtio_sqe_cancel(sqe);
+		}
+	}
+
+	res = rtio_submit(r, 2);
+	zassert_ok(res, "Should return ok from rtio_execute");
+
+	for (int i = 0; i < 2; i++) {
+		cqe = rtio_spsc_consume(r->cq);
+		zassert_not_null(cqe, "Expected a valid cqe");
+		zassert_equal(cqe->result, -ECANCELED, "Result should be canceled");
+		zassert_equal_ptr(cqe->userdata, &userdata[i], "Expected in order completions");
+		rtio_spsc_release(r->cq);
+	}
+}
+
+ZTEST(rtio_api, test_rtio_cancel)
+{
+	rtio_iodev_test_init(&iodev_test_ops);
+
+	TC_PRINT("rtio cancel simple\n");
+	test_rtio_cancel_(&r_ops_simp);
+	TC_PRINT("rtio cancel concurrent\n");
+	test_rtio_cancel_(&r_ops_con);
+}
+
+/**
+ * @brief Test a multishot read until it is canceled
+ */
+void test_rtio_multishot_(struct rtio *r)
+{
+	int res;
+	uint8_t buf[4];
+	uintptr_t userdata = 7;
+	struct rtio_sqe *sqe;
+	struct rtio_cqe *cqe;
+
+	sqe = rtio_spsc_acquire(r->sq);
+	zassert_not_null(sqe, "Expected a valid sqe");
+	rtio_sqe_prep_read_multishot(sqe, &iodev_test_ops, 0, buf, sizeof(buf), &userdata);
+
+	res = rtio_submit(r, 3);
+	zassert_ok(res, "Should return ok from rtio_execute");
+
+	for (int i = 0; i < 3; i++) {
+		cqe = rtio_cqe_consume_block(r);
+		zassert_ok(cqe->result, "Result should be ok");
+		zassert_equal_ptr(cqe->userdata, &userdata, "Expected userdata back");
+		rtio_spsc_release(r->cq);
+	}
+
+	/* The read in progress completes, and is not run again */
+	rtio_sqe_cancel(sqe);
+	cqe = rtio_cqe_consume_block(r);
+	zassert_ok(cqe->result, "Result should be ok");
+	rtio_spsc_release(r->cq);
+
+	k_sleep(K_MSEC(50));
+	while ((cqe = rtio_spsc_consume(r->cq)) != NULL) {
+		rtio_spsc_release(r->cq);
+	}
+	k_sleep(K_MSEC(50));
+	zassert_is_null(rtio_spsc_consume(r->cq), "Expected no more completions");
+	zassert_equal(rtio_spsc_consumable(r->sq), 0, "Expected the submission to be done");
+}
+
+ZTEST(rtio_api, test_rtio_multishot)
+{
+	rtio_iodev_test_init(&iodev_test_ops);
+
+	TC_PRINT("rtio multishot simple\n");
+	test_rtio_multishot_(&r_ops_simp);
+	TC_PRINT("rtio multishot concurrent\n");
+	test_rtio_multishot_(&r_ops_con);
+}
+
+#ifdef CONFIG_RTIO_OP_DELAY
+/**
+ * @brief Test a delay between two chained submissions
+ */
+void test_rtio_delay_(struct rtio *r)
+{
+	int res;
+	int64_t start;
+	uintptr_t userdata[3] = {0, 1, 2};
+	struct rtio_sqe *sqe;
+
+	sqe = rtio_spsc_acquire(r->sq);
+	zassert_not_null(sqe, "Expected a valid sqe");
+	rtio_sqe_prep_nop(sqe, &iodev_test_ops, &userdata[0]);
+	sqe->flags = RTIO_SQE_CHAINED;
+
+	sqe = rtio_spsc_acquire(r->sq);
+	zassert_not_null(sqe, "Expected a valid sqe");
+	rtio_sqe_prep_delay(sqe, K_MSEC(30), &userdata[1]);
+	sqe->flags = RTIO_SQE_CHAINED;
+
+	sqe = rtio_spsc_acquire(r->sq);
+	zassert_not_null(sqe, "Expected a valid sqe");
+	rtio_sqe_prep_nop(sqe, &iodev_test_ops, &userdata[2]);
+
+	start = k_uptime_get();
+	res = rtio_submit(r, 3);
+	zassert_ok(res, "Should return ok from rtio_execute");
+	zassert_true(k_uptime_get() - start >= 30, "Expected the chain to be delayed");
+
+	for (int i = 0; i < 3; i++) {
+		struct rtio_cqe *cqe = rtio_spsc_consume(r->cq);
+
+		zassert_not_null(cqe, "Expected a valid cqe");
+		zassert_ok(cqe->result, "Result should be ok");
+		zassert_equal_ptr(cqe->userdata, &userdata[i], "Expected in order completions");
+		rtio_spsc_release(r->cq);
+	}
+}
+
+ZTEST(rtio_api, test_rtio_delay)
+{
+	rtio_iodev_test_init(&iodev_test_ops);
+
+	TC_PRINT("rtio delay simple\n");
+	test_rtio_delay_(&r_ops_simp);
+	TC_PRINT("rtio delay concurrent\n");
+	test_rtio_delay_(&r_ops_con);
+}
+#endif /* CONFIG_RTIO_OP_DELAY */
+
+
 #ifdef CONFIG_USERSPACE
 K_APPMEM_PARTITION_DEFINE(rtio_partition);
 K_APP_BMEM(rtio_partition) uint8_t syscall_bufs[4];
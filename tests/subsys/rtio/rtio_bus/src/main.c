@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2022 Intel Corporation.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/i2c.h>
+#include <zephyr/drivers/spi.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/rtio/rtio_executor_simple.h>
+
+#define BMI160_REG_CHIPID 0x00
+#define BMI160_REG_DATA_GYR_X 0x0C
+#define BMI160_REG_READ BIT(7)
+#define BMI160_CHIP_ID 0xD1
+#define BMI160_SAMPLE_SIZE 12
+
+SPI_DT_IODEV_DEFINE(spi_bmi, DT_NODELABEL(bmi_spi), SPI_WORD_SET(8) | SPI_TRANSFER_MSB, 0);
+I2C_DT_IODEV_DEFINE(i2c_bmi, DT_NODELABEL(bmi_i2c));
+
+RTIO_EXECUTOR_SIMPLE_DEFINE(bus_exec);
+RTIO_DEFINE(r_bus, (struct rtio_executor *)&bus_exec, 16, 16);
+
+/* Registers are read with their address or'ed with BMI160_REG_READ over SPI */
+static uint8_t reg_addr(const struct rtio_iodev *iodev, uint8_t reg)
+{
+	return iodev == &spi_bmi ? (reg | BMI160_REG_READ) : reg;
+}
+
+static void prep_reg_read(struct rtio *r, const struct rtio_iodev *iodev, uint8_t reg,
+			  uint8_t *buf, uint32_t len, uint16_t flags, void *userdata)
+{
+	uint8_t addr = reg_addr(iodev, reg);
+	struct rtio_sqe *sqe;
+
+	sqe = rtio_sqe_acquire(r);
+	zassert_not_null(sqe, "Expected a valid sqe");
+	rtio_sqe_prep_tiny_write(sqe, iodev, 0, &addr, 1, userdata);
+	sqe->flags = RTIO_SQE_TRANSACTION | flags;
+
+	sqe = rtio_sqe_acquire(r);
+	zassert_not_null(sqe, "Expected a valid sqe");
+	rtio_sqe_prep_read(sqe, iodev, 0, buf, len, userdata);
+	sqe->flags = flags;
+}
+
+static void test_chip_id(const struct rtio_iodev *iodev)
+{
+	struct rtio *r = &r_bus;
+	struct rtio_cqe *cqe;
+	uint8_t chip_id = 0;
+
+	prep_reg_read(r, iodev, BMI160_REG_CHIPID, &chip_id, 1, 0, &chip_id);
+	zassert_ok(rtio_submit(r, 2), "Should return ok from rtio_submit");
+
+	for (int i = 0; i < 2; i++) {
+		cqe = rtio_cqe_consume(r);
+		zassert_not_null(cqe, "Expected a valid cqe");
+		zassert_ok(cqe->result, "Result should be ok");
+		zassert_equal_ptr(cqe->userdata, &chip_id, "Expected userdata back");
+		rtio_cqe_release_all(r);
+	}
+
+	zassert_equal(chip_id, BMI160_CHIP_ID, "Unexpected chip id %x", chip_id);
+}
+
+ZTEST(rtio_bus, test_spi_chip_id)
+{
+	test_chip_id(&spi_bmi);
+}
+
+ZTEST(rtio_bus, test_i2c_chip_id)
+{
+	test_chip_id(&i2c_bmi);
+}
+
+/**
+ * @brief Test a batch of sample reads on both buses completing once
+ */
+ZTEST(rtio_bus, test_batch)
+{
+	static uint8_t samples[4][BMI160_SAMPLE_SIZE];
+	const struct rtio_iodev *iodevs[] = {&spi_bmi, &i2c_bmi};
+	struct rtio *r = &r_bus;
+	struct rtio_cqe *cqe;
+	int last = ARRAY_SIZE(samples) - 1;
+
+	memset(samples, 0, sizeof(samples));
+
+	/* Only the last transaction reports its completion */
+	for (int i = 0; i < ARRAY_SIZE(samples); i++) {
+		prep_reg_read(r, iodevs[i % 2], BMI160_REG_DATA_GYR_X, samples[i],
+			      BMI160_SAMPLE_SIZE, i == last ? 0 : RTIO_SQE_NO_RESPONSE,
+			      &samples[i]);
+	}
+
+	zassert_ok(rtio_submit(r, 2), "Should return ok from rtio_submit");
+
+	for (int i = 0; i < 2; i++) {
+		cqe = rtio_cqe_consume(r);
+		zassert_not_null(cqe, "Expected a valid cqe");
+		zassert_ok(cqe->result, "Result should be ok");
+		zassert_equal_ptr(cqe->userdata, &samples[last], "Expected the last read");
+		rtio_cqe_release_all(r);
+	}
+	zassert_is_null(rtio_cqe_consume(r), "Expected no other completion");
+
+	for (int i = 0; i < ARRAY_SIZE(samples); i++) {
+		/* gyr[x] of the emulated samples */
+		zassert_equal(samples[i][0], 0x01, "Unexpected sample %d", i);
+		zassert_equal(samples[i][1], 0x0b, "Unexpected sample %d", i);
+	}
+}
+
+/**
+ * @brief Test a transaction too long for the bus fails as a whole
+ */
+ZTEST(rtio_bus, test_txn_too_long)
+{
+	static uint8_t buf[CONFIG_I2C_RTIO_TXN_MAX + 1];
+	struct rtio *r = &r_bus;
+	struct rtio_sqe *sqe;
+	struct rtio_cqe *cqe;
+
+	for (int i = 0; i < ARRAY_SIZE(buf); i++) {
+		sqe = rtio_sqe_acquire(r);
+		zassert_not_null(sqe, "Expected a valid sqe");
+		rtio_sqe_prep_read(sqe, &i2c_bmi, 0, &buf[i], 1, &buf[i]);
+		if (i < ARRAY_SIZE(buf) - 1) {
+			sqe->flags = RTIO_SQE_TRANSACTION;
+		}
+	}
+
+	zassert_ok(rtio_submit(r, ARRAY_SIZE(buf)), "Should return ok from rtio_submit");
+
+	for (int i = 0; i < ARRAY_SIZE(buf); i++) {
+		cqe = rtio_cqe_consume(r);
+		zassert_not_null(cqe, "Expected a valid cqe");
+		zassert_equal(cqe->result, i == 0 ? -ENOMEM : -ECANCELED,
+			      "Unexpected result %d", cqe->result);
+		zassert_equal_ptr(cqe->userdata, &buf[i], "Expected in order completions");
+		rtio_cqe_release_all(r);
+	}
+}
+
+ZTEST_SUITE(rtio_bus, NULL, NULL, NULL, NULL, NULL);
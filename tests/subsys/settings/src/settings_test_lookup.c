@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "settings_test.h"
+
+static int lookup_set(const char *name, size_t len, settings_read_cb read_cb,
+		      void *cb_arg)
+{
+	return 0;
+}
+
+static struct settings_handler lookup_handlers[] = {
+	{ .name = "lookup", .h_set = lookup_set },
+	{ .name = "lookup/nested", .h_set = lookup_set },
+	{ .name = "lookup/nested/deep", .h_set = lookup_set },
+};
+
+/* The handler registered for the longest prefix of the name is found */
+ZTEST(settings_config, test_config_lookup)
+{
+	const struct {
+		const char *name;
+		int handler;
+		const char *next;
+	} cases[] = {
+		{ "lookup", 0, NULL },
+		{ "lookup/a", 0, "a" },
+		{ "lookup/nest", 0, "nest" },
+		{ "lookup/nested", 1, NULL },
+		{ "lookup/nested=1", 1, NULL },
+		{ "lookup/nested/a/b", 1, "a/b" },
+		{ "lookup/nested/deep/a", 2, "a" },
+		{ "lookups/a", -1, NULL },
+		{ "look", -1, NULL },
+		{ "1/2/3/4/5/6/7/8/9/10", -1, NULL },
+	};
+	struct settings_handler_static *ch;
+	const char *next;
+
+	for (int i = 0; i < ARRAY_SIZE(lookup_handlers); i++) {
+		zassert_ok(settings_register(&lookup_handlers[i]));
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(cases); i++) {
+		ch = settings_parse_and_lookup(cases[i].name, &next);
+		if (cases[i].handler < 0) {
+			zassert_is_null(ch, "%s: unexpected handler",
+					cases[i].name);
+			continue;
+		}
+
+		zassert_equal_ptr(ch, &lookup_handlers[cases[i].handler],
+				  "%s: wrong handler", cases[i].name);
+		if (cases[i].next == NULL) {
+			zassert_is_null(next, "%s: unexpected next",
+					cases[i].name);
+		} else {
+			zassert_not_null(next, "%s: no next", cases[i].name);
+			zassert_equal(strcmp(next, cases[i].next), 0,
+				      "%s: wrong next %s", cases[i].name, next);
+		}
+	}
+
+	zassert_equal(settings_register(&lookup_handlers[1]), -EEXIST);
+}
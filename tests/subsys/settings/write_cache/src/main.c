@@ -0,0 +1,302 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/fs/nvs.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/sys/byteorder.h>
+#include <string.h>
+
+#include "settings_priv.h"
+
+static struct nvs_fs *fs;
+
+struct read_ctx {
+	uint32_t val;
+	bool found;
+};
+
+static int read_one(const char *key, size_t len, settings_read_cb read_cb,
+		    void *cb_arg, void *param)
+{
+	struct read_ctx *ctx = param;
+
+	if (key == NULL && len == sizeof(ctx->val)) {
+		ctx->found = (read_cb(cb_arg, &ctx->val, len) == len);
+	}
+
+	return 0;
+}
+
+/* Value persisted in the back-end, pending writes are written first */
+static bool stored(const char *name, uint32_t *val)
+{
+	struct read_ctx ctx = { 0 };
+
+	zassert_ok(settings_load_subtree_direct(name, read_one, &ctx));
+	*val = ctx.val;
+
+	return ctx.found;
+}
+
+static void save(const char *name, uint32_t val)
+{
+	zassert_ok(settings_save_one(name, &val, sizeof(val)));
+}
+
+ZTEST(settings_write_cache, test_coalesce)
+{
+	uint32_t wra, val;
+
+	if (CONFIG_SETTINGS_WRITE_CACHE_FLUSH_COUNT > 0) {
+		ztest_test_skip();
+	}
+
+	wra = fs->ate_wra;
+	for (int i = 0; i < 10; i++) {
+		save("wc/a", i);
+		save("wc/b", 100 + i);
+	}
+	zassert_equal(fs->ate_wra, wra, "written before sync");
+
+	zassert_ok(settings_sync());
+	zassert_not_equal(fs->ate_wra, wra, "not written by sync");
+	wra = fs->ate_wra;
+
+	zassert_true(stored("wc/a", &val));
+	zassert_equal(val, 9);
+	zassert_true(stored("wc/b", &val));
+	zassert_equal(val, 109);
+	zassert_equal(fs->ate_wra, wra, "written again");
+
+	zassert_ok(settings_delete("wc/b"));
+	zassert_true(stored("wc/a", &val));
+	zassert_false(stored("wc/b", &val));
+}
+
+ZTEST(settings_write_cache, test_full)
+{
+	char name[16];
+	uint32_t val;
+
+	if (CONFIG_SETTINGS_WRITE_CACHE_FLUSH_COUNT > 0) {
+		ztest_test_skip();
+	}
+
+	/* Filling the cache writes the pending items */
+	for (int i = 0; i < 20; i++) {
+		snprintf(name, sizeof(name), "wc/f%d", i);
+		save(name, i);
+	}
+
+	for (int i = 0; i < 20; i++) {
+		snprintf(name, sizeof(name), "wc/f%d", i);
+		zassert_true(stored(name, &val));
+		zassert_equal(val, i);
+	}
+}
+
+ZTEST(settings_write_cache, test_policy)
+{
+	uint32_t wra, val;
+
+	if (CONFIG_SETTINGS_WRITE_CACHE_FLUSH_COUNT == 0) {
+		ztest_test_skip();
+	}
+
+	wra = fs->ate_wra;
+	save("wc/p", 1);
+	zassert_equal(fs->ate_wra, wra, "written before the delay");
+	k_msleep(CONFIG_SETTINGS_WRITE_CACHE_FLUSH_DELAY_MS * 2);
+	zassert_not_equal(fs->ate_wra, wra, "not written after the delay");
+
+	wra = fs->ate_wra;
+	for (int i = 0; i < CONFIG_SETTINGS_WRITE_CACHE_FLUSH_COUNT - 1; i++) {
+		save(i % 2 ? "wc/odd" : "wc/even", i);
+		save(i % 2 ? "wc/odd" : "wc/even", i);
+	}
+	save("wc/p", 2);
+	save("wc/q", 3);
+	zassert_not_equal(fs->ate_wra, wra, "not written after the count");
+	zassert_true(stored("wc/q", &val));
+	zassert_equal(val, 3);
+}
+
+ZTEST(settings_write_cache, test_txn)
+{
+	uint32_t val;
+
+	save("wc/t1", 1);
+	save("wc/t2", 2);
+
+	zassert_ok(settings_txn_begin());
+	zassert_equal(settings_txn_begin(), -EALREADY);
+	save("wc/t1", 10);
+	save("wc/t2", 20);
+	zassert_ok(settings_delete("wc/t1"));
+	save("wc/t1", 11);
+	settings_txn_abort();
+
+	zassert_true(stored("wc/t1", &val));
+	zassert_equal(val, 1);
+	zassert_true(stored("wc/t2", &val));
+	zassert_equal(val, 2);
+
+	zassert_ok(settings_txn_begin());
+	save("wc/t1", 10);
+	save("wc/t2", 20);
+	zassert_ok(settings_txn_commit());
+	zassert_equal(settings_txn_commit(), -EINVAL);
+
+	zassert_true(stored("wc/t1", &val));
+	zassert_equal(val, 10);
+	zassert_true(stored("wc/t2", &val));
+	zassert_equal(val, 20);
+	zassert_false(stored(SETTINGS_TXN_JOURNAL, &val), "journal left");
+}
+
+ZTEST(settings_write_cache, test_txn_too_large)
+{
+	char name[16];
+	int rc = 0;
+
+	zassert_ok(settings_txn_begin());
+	for (int i = 0; i < 20 && rc == 0; i++) {
+		snprintf(name, sizeof(name), "wc/l%d", i);
+		rc = settings_save_one(name, &i, sizeof(i));
+	}
+	zassert_equal(rc, -ENOMEM, "transaction larger than the cache");
+	settings_txn_abort();
+}
+
+/* A value which does not fit does not drop the pending one */
+ZTEST(settings_write_cache, test_txn_replace_too_large)
+{
+	uint8_t large[64] = { 0 };
+	char name[16];
+	uint32_t val;
+	int rc = 0;
+
+	save("wc/m", 1);
+	zassert_ok(settings_sync());
+
+	zassert_ok(settings_txn_begin());
+	save("wc/m", 5);
+	for (int i = 0; i < 20 && rc == 0; i++) {
+		snprintf(name, sizeof(name), "wc/n%d", i);
+		rc = settings_save_one(name, &i, sizeof(i));
+	}
+	zassert_equal(rc, -ENOMEM, "transaction larger than the cache");
+	zassert_equal(settings_save_one("wc/m", large, sizeof(large)), -ENOMEM);
+	zassert_ok(settings_txn_commit());
+
+	zassert_true(stored("wc/m", &val));
+	zassert_equal(val, 5);
+}
+
+static const struct settings_store_itf *store_itf;
+
+static int failing_save(struct settings_store *cs, const char *name,
+			const char *value, size_t val_len)
+{
+	if (strcmp(name, "wc/bad") == 0) {
+		return -EIO;
+	}
+
+	return store_itf->csi_save(cs, name, value, val_len);
+}
+
+/* An item the back-end keeps rejecting does not block the cache */
+ZTEST(settings_write_cache, test_flush_error)
+{
+	struct settings_store *cs = settings_save_dst;
+	struct settings_store_itf itf;
+	uint32_t val;
+
+	if (CONFIG_SETTINGS_WRITE_CACHE_FLUSH_COUNT > 0) {
+		ztest_test_skip();
+	}
+
+	store_itf = cs->cs_itf;
+	itf = *store_itf;
+	itf.csi_save = failing_save;
+	cs->cs_itf = &itf;
+
+	save("wc/bad", 1);
+	save("wc/good", 2);
+	zassert_equal(settings_sync(), -EIO);
+	zassert_ok(settings_sync(), "failed item still pending");
+
+	save("wc/good", 3);
+	zassert_ok(settings_sync());
+
+	cs->cs_itf = store_itf;
+
+	zassert_false(stored("wc/bad", &val));
+	zassert_true(stored("wc/good", &val));
+	zassert_equal(val, 3);
+}
+
+static size_t record_add(uint8_t *buf, const char *name, uint32_t val)
+{
+	size_t name_len = strlen(name);
+
+	buf[0] = name_len;
+	sys_put_le16(sizeof(val), &buf[1]);
+	memcpy(&buf[3], name, name_len);
+	memcpy(&buf[3 + name_len], &val, sizeof(val));
+
+	return 3 + name_len + sizeof(val);
+}
+
+/* A journal left by a power loss during a commit is replayed at init */
+ZTEST(settings_write_cache, test_txn_recover)
+{
+	struct settings_store *cs = settings_save_dst;
+	uint8_t journal[64];
+	size_t len = 0;
+	uint32_t val;
+
+	save("wc/r1", 1);
+	zassert_ok(settings_sync());
+
+	len += record_add(&journal[len], "wc/r1", 10);
+	len += record_add(&journal[len], "wc/r2", 20);
+	zassert_ok(cs->cs_itf->csi_save(cs, SETTINGS_TXN_JOURNAL, journal, len));
+	zassert_ok(cs->cs_itf->csi_save(cs, "wc/r1", (const char *)&val, 0));
+
+	zassert_ok(settings_cache_recover());
+
+	zassert_true(stored("wc/r1", &val));
+	zassert_equal(val, 10);
+	zassert_true(stored("wc/r2", &val));
+	zassert_equal(val, 20);
+	zassert_false(stored(SETTINGS_TXN_JOURNAL, &val), "journal left");
+
+	/* A corrupted journal is discarded */
+	journal[0] = 0xff;
+	zassert_ok(cs->cs_itf->csi_save(cs, SETTINGS_TXN_JOURNAL, journal, len));
+	zassert_ok(settings_cache_recover());
+	zassert_false(stored(SETTINGS_TXN_JOURNAL, &val), "journal left");
+}
+
+static void *setup(void)
+{
+	const struct flash_area *fa;
+
+	zassert_ok(flash_area_open(FIXED_PARTITION_ID(storage_partition), &fa));
+	zassert_ok(flash_area_erase(fa, 0, fa->fa_size));
+	flash_area_close(fa);
+
+	zassert_ok(settings_subsys_init());
+	zassert_ok(settings_storage_get((void **)&fs));
+
+	return NULL;
+}
+
+ZTEST_SUITE(settings_write_cache, NULL, setup, NULL, NULL, NULL);
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zephyr/drivers/flash.h>
+#include <zephyr/storage/stream_flash.h>
+
+#define BUF_LEN 1024
+#define HALF_LEN (BUF_LEN / 2)
+#define TEST_LEN 0x3000
+#define SOC_NV_FLASH_NODE DT_INST(0, soc_nv_flash)
+#define FLASH_SIZE DT_REG_SIZE(SOC_NV_FLASH_NODE)
+
+/* Area written by the tests */
+#define FLASH_BASE (128 * 1024)
+
+static const struct device *const fdev = DEVICE_DT_GET(DT_CHOSEN(zephyr_flash_controller));
+static struct stream_flash_ctx ctx;
+static uint8_t buf[BUF_LEN];
+static uint8_t write_buf[TEST_LEN];
+static uint8_t read_buf[TEST_LEN];
+
+static size_t cb_count;
+static size_t cb_next;
+static int cb_ret;
+
+static int stream_flash_callback(uint8_t *data, size_t len, size_t offset)
+{
+	zassert_true((data == buf) || (data == &buf[HALF_LEN]), "incorrect buf");
+	zassert_equal(offset, FLASH_BASE + cb_next, "incorrect offset");
+	zassert_mem_equal(data, &write_buf[cb_next], len, "incorrect data");
+
+	cb_count++;
+	cb_next += len;
+
+	return cb_ret;
+}
+
+static void verify(size_t len)
+{
+	int rc;
+
+	rc = flash_read(fdev, FLASH_BASE, read_buf, len);
+	zassert_equal(rc, 0, "flash_read failed: %d", rc);
+	zassert_mem_equal(read_buf, write_buf, len, "flash content differs");
+}
+
+ZTEST(stream_flash_async, test_init)
+{
+	int rc;
+
+	/* Each half must be aligned to the write block size */
+	rc = stream_flash_init(&ctx, fdev, buf,
+			       flash_get_write_block_size(fdev), FLASH_BASE, 0,
+			       NULL);
+	if (flash_get_write_block_size(fdev) > 1) {
+		zassert_true(rc < 0, "should fail as halves are unaligned");
+	}
+
+	rc = stream_flash_init(&ctx, fdev, buf, BUF_LEN, FLASH_BASE, 0, NULL);
+	zassert_equal(rc, 0, "stream_flash_init failed: %d", rc);
+	zassert_equal(ctx.buf_len, HALF_LEN, "buffer not split");
+}
+
+ZTEST(stream_flash_async, test_overlap)
+{
+	int rc;
+
+	/* Filling a half queues its write and returns */
+	rc = stream_flash_buffered_write(&ctx, write_buf, HALF_LEN, false);
+	zassert_equal(rc, 0, "stream_flash_buffered_write failed: %d", rc);
+	zassert_equal(stream_flash_bytes_written(&ctx), 0,
+		      "waited for the write");
+	zassert_equal(ctx.pending_bytes, HALF_LEN, "write not pending");
+
+	/* The other half is filled meanwhile */
+	rc = stream_flash_buffered_write(&ctx, &write_buf[HALF_LEN], 100, false);
+	zassert_equal(rc, 0, "stream_flash_buffered_write failed: %d", rc);
+	zassert_equal(ctx.buf_bytes, 100, "data not buffered");
+
+	/* A flush waits for all the data to be written */
+	rc = stream_flash_buffered_write(&ctx, NULL, 0, true);
+	zassert_equal(rc, 0, "flush failed: %d", rc);
+	zassert_equal(stream_flash_bytes_written(&ctx), HALF_LEN + 100,
+		      "data not written");
+	zassert_equal(cb_count, 2, "callback not called for each half");
+	verify(HALF_LEN + 100);
+}
+
+ZTEST(stream_flash_async, test_multi_page)
+{
+	int rc;
+	size_t chunk = 300;
+
+	/* Data spanning several pages, written in unaligned pieces */
+	for (size_t off = 0; off < TEST_LEN; off += chunk) {
+		rc = stream_flash_buffered_write(&ctx, &write_buf[off],
+						 MIN(chunk, TEST_LEN - off),
+						 false);
+		zassert_equal(rc, 0, "stream_flash_buffered_write failed: %d",
+			      rc);
+	}
+
+	rc = stream_flash_buffered_write(&ctx, NULL, 0, true);
+	zassert_equal(rc, 0, "flush failed: %d", rc);
+	zassert_equal(stream_flash_bytes_written(&ctx), TEST_LEN,
+		      "data not written");
+	zassert_equal(cb_next, TEST_LEN, "callback not called for all data");
+	verify(TEST_LEN);
+}
+
+ZTEST(stream_flash_async, test_callback_error)
+{
+	int rc;
+
+	rc = stream_flash_buffered_write(&ctx, write_buf, HALF_LEN, false);
+	zassert_equal(rc, 0, "stream_flash_buffered_write failed: %d", rc);
+
+	/* The error of the verification is returned by the flush */
+	cb_ret = -EIO;
+	rc = stream_flash_buffered_write(&ctx, NULL, 0, true);
+	zassert_equal(rc, -EIO, "error not reported: %d", rc);
+	zassert_equal(stream_flash_bytes_written(&ctx), 0,
+		      "failed data counted as written");
+}
+
+static void *stream_flash_async_setup(void)
+{
+	for (size_t i = 0; i < sizeof(write_buf); i++) {
+		write_buf[i] = (uint8_t)(i * 13 + 7);
+	}
+
+	zassert_true(device_is_ready(fdev), "flash device not ready");
+	zassert_true(FLASH_BASE + TEST_LEN <= FLASH_SIZE, "flash too small");
+
+	return NULL;
+}
+
+static void stream_flash_async_before(void *fixture)
+{
+	int rc;
+
+	ARG_UNUSED(fixture);
+
+	cb_count = 0;
+	cb_next = 0;
+	cb_ret = 0;
+
+	/* Leave programmed data in the area, the pages must be erased */
+	memset(read_buf, 0, sizeof(read_buf));
+	(void)flash_write(fdev, FLASH_BASE + TEST_LEN - HALF_LEN, read_buf,
+			  HALF_LEN);
+
+	rc = stream_flash_init(&ctx, fdev, buf, BUF_LEN, FLASH_BASE, 0,
+			       stream_flash_callback);
+	zassert_equal(rc, 0, "stream_flash_init failed: %d", rc);
+}
+
+ZTEST_SUITE(stream_flash_async, NULL, stream_flash_async_setup,
+	    stream_flash_async_before, NULL, NULL);
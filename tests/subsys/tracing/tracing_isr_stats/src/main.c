@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/irq_offload.h>
+#include <zephyr/tracing/isr_stats.h>
+#if defined(CONFIG_CPU_CORTEX_M)
+#include <zephyr/interrupt_util.h>
+#endif
+
+#define OFFLOAD_COUNT 10
+#define ISR_BUSY_US 100
+
+/* On Cortex-M, irq_offload() runs the routine from the SVC handler, which
+ * is not traced: a spare NVIC line is raised instead.
+ */
+#if defined(CONFIG_CPU_CORTEX_M)
+#define TEST_IRQ_PRIO 1
+
+static uint32_t test_irq;
+#endif
+
+static void offload_isr(const void *param)
+{
+	ARG_UNUSED(param);
+
+	k_busy_wait(ISR_BUSY_US);
+}
+
+static void raise_isr(void)
+{
+#if defined(CONFIG_CPU_CORTEX_M)
+	trigger_irq(test_irq);
+#else
+	irq_offload(offload_isr, NULL);
+#endif
+}
+
+/* Find the line which counted exactly the offloaded interrupts */
+static int find_offload_line(struct isr_stats *out)
+{
+	struct isr_stats st;
+
+	for (int irq = ISR_STATS_IRQ_OTHER; irq < ISR_STATS_NUM_IRQS; irq++) {
+		zassert_ok(isr_stats_get(irq, &st), "get failed for %d", irq);
+		if (st.count == OFFLOAD_COUNT && st.duration_max > 0) {
+			*out = st;
+			return irq;
+		}
+	}
+
+	return ISR_STATS_IRQ_OTHER - 1;
+}
+
+ZTEST(isr_stats, test_invalid_line)
+{
+	struct isr_stats st;
+
+	zassert_equal(isr_stats_get(ISR_STATS_IRQ_OTHER - 1, &st), -EINVAL,
+		      "negative line accepted");
+	zassert_equal(isr_stats_get(ISR_STATS_NUM_IRQS, &st), -EINVAL,
+		      "line past NUM_IRQS accepted");
+}
+
+ZTEST(isr_stats, test_offload_histograms)
+{
+	uint32_t busy_cycles = k_us_to_cyc_floor32(ISR_BUSY_US);
+	uint32_t hist_total = 0;
+	uint32_t gap_total = 0;
+	struct isr_stats st = { 0 };
+	int irq;
+
+	/* Keep the tick out of the way, it would hide the offload line */
+	k_sleep(K_TICKS(1));
+	isr_stats_reset();
+
+	for (int i = 0; i < OFFLOAD_COUNT; i++) {
+		raise_isr();
+		k_busy_wait(ISR_BUSY_US);
+	}
+
+	irq = find_offload_line(&st);
+	zassert_true(irq >= ISR_STATS_IRQ_OTHER, "offloaded ISRs not found");
+
+	for (int i = 0; i < CONFIG_TRACING_ISR_STATS_BUCKETS; i++) {
+		hist_total += st.duration_hist[i];
+		gap_total += st.interarrival_hist[i];
+	}
+
+	zassert_equal(hist_total, OFFLOAD_COUNT, "duration histogram %u", hist_total);
+	zassert_equal(gap_total, OFFLOAD_COUNT - 1, "gap histogram %u", gap_total);
+	zassert_true(st.duration_max >= busy_cycles, "duration %u < %u",
+		     st.duration_max, busy_cycles);
+	zassert_true(st.duration_total >= (uint64_t)busy_cycles * OFFLOAD_COUNT,
+		     "total duration too short");
+	zassert_true(st.interarrival_min >= busy_cycles, "gap %u < %u",
+		     st.interarrival_min, busy_cycles);
+	zassert_true(st.interarrival_max >= st.interarrival_min, "bad gap range");
+}
+
+ZTEST(isr_stats, test_reset)
+{
+	struct isr_stats st;
+
+	raise_isr();
+	isr_stats_reset();
+
+	for (int irq = ISR_STATS_IRQ_OTHER; irq < ISR_STATS_NUM_IRQS; irq++) {
+		zassert_ok(isr_stats_get(irq, &st), "get failed");
+		zassert_equal(st.count, 0, "line %d not cleared", irq);
+		zassert_equal(st.duration_max, 0, "line %d not cleared", irq);
+	}
+}
+
+ZTEST(isr_stats, test_bucket_bounds)
+{
+	zassert_equal(isr_stats_bucket_min(0), 0, "bucket 0");
+	zassert_equal(isr_stats_bucket_min(1), 1, "bucket 1");
+	zassert_equal(isr_stats_bucket_min(5), 16, "bucket 5");
+}
+
+static void *isr_stats_setup(void)
+{
+#if defined(CONFIG_CPU_CORTEX_M)
+	test_irq = get_available_nvic_line(CONFIG_NUM_IRQS);
+	arch_irq_connect_dynamic(test_irq, TEST_IRQ_PRIO, offload_isr, NULL, 0);
+	irq_enable(test_irq);
+#endif
+
+	return NULL;
+}
+
+ZTEST_SUITE(isr_stats, NULL, isr_stats_setup, NULL, NULL, NULL);
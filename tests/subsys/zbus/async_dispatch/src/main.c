@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/ztest.h>
+
+struct value_msg {
+	int value;
+};
+
+ZBUS_CHAN_DEFINE(chan_a,	   /* Name */
+		 struct value_msg, /* Message type */
+
+		 NULL,							 /* Validator */
+		 NULL,							 /* User data */
+		 ZBUS_OBSERVERS(lis, drop_new_sub, drop_oldest_sub), /* observers */
+		 ZBUS_MSG_INIT(0)					 /* Initial value */
+);
+
+ZBUS_CHAN_DEFINE(chan_b,	   /* Name */
+		 struct value_msg, /* Message type */
+
+		 NULL,					     /* Validator */
+		 NULL,					     /* User data */
+		 ZBUS_OBSERVERS(drop_new_sub, drop_oldest_sub), /* observers */
+		 ZBUS_MSG_INIT(0)			     /* Initial value */
+);
+
+ZBUS_CHAN_DEFINE(chan_c,	   /* Name */
+		 struct value_msg, /* Message type */
+
+		 NULL,			 /* Validator */
+		 NULL,			 /* User data */
+		 ZBUS_OBSERVERS(fwd_lis), /* observers */
+		 ZBUS_MSG_INIT(0)	 /* Initial value */
+);
+
+static int lis_count;
+static int lis_value;
+static k_tid_t lis_thread;
+
+static void lis_cb(const struct zbus_channel *chan)
+{
+	const struct value_msg *msg = zbus_chan_const_msg(chan);
+
+	lis_count++;
+	lis_value = msg->value;
+	lis_thread = k_current_get();
+
+	/* Delivery takes some time */
+	k_busy_wait(100);
+}
+
+ZBUS_LISTENER_DEFINE(lis, lis_cb);
+
+static int fwd_err[2];
+
+/* Publishes twice from the dispatcher, without a timeout */
+static void fwd_cb(const struct zbus_channel *chan)
+{
+	for (int i = 0; i < ARRAY_SIZE(fwd_err); i++) {
+		fwd_err[i] = zbus_chan_pub(&chan_b, zbus_chan_const_msg(chan), K_FOREVER);
+	}
+}
+
+ZBUS_LISTENER_DEFINE(fwd_lis, fwd_cb);
+ZBUS_SUBSCRIBER_DEFINE(drop_new_sub, 2);
+ZBUS_SUBSCRIBER_DEFINE_WITH_POLICY(drop_oldest_sub, 2, ZBUS_OVERFLOW_DROP_OLDEST);
+
+static void publish(const struct zbus_channel *chan, int value)
+{
+	struct value_msg msg = {.value = value};
+
+	zassert_ok(zbus_chan_pub(chan, &msg, K_NO_WAIT));
+}
+
+ZTEST(async_dispatch, test_publisher_context)
+{
+	struct zbus_dispatch_stats stats;
+
+	publish(&chan_a, 1);
+	publish(&chan_a, 2);
+
+	/* The test thread is cooperative, nothing is delivered before it sleeps */
+	zassert_equal(lis_count, 0);
+
+	k_msleep(10);
+
+	zassert_equal(lis_count, 2);
+	zassert_equal(lis_value, 2);
+	zassert_not_equal(lis_thread, k_current_get());
+
+	zbus_dispatch_stats_get(&stats);
+	zassert_equal(stats.events, 2);
+	zassert_true(k_cyc_to_us_floor32(stats.latency_max) >= 100);
+	zassert_true(stats.latency_sum >= stats.latency_max);
+}
+
+ZTEST(async_dispatch, test_overflow_policies)
+{
+	const struct zbus_channel *chan;
+	struct zbus_dispatch_stats stats;
+
+	publish(&chan_a, 1);
+	publish(&chan_a, 2);
+	publish(&chan_b, 3);
+	k_msleep(10);
+
+	/* The last notification did not fit */
+	zassert_ok(zbus_sub_wait(&drop_new_sub, &chan, K_NO_WAIT));
+	zassert_equal_ptr(chan, &chan_a);
+	zassert_ok(zbus_sub_wait(&drop_new_sub, &chan, K_NO_WAIT));
+	zassert_equal_ptr(chan, &chan_a);
+	zassert_equal(zbus_sub_wait(&drop_new_sub, &chan, K_NO_WAIT), -ENOMSG);
+
+	/* The first notification made room for it */
+	zassert_ok(zbus_sub_wait(&drop_oldest_sub, &chan, K_NO_WAIT));
+	zassert_equal_ptr(chan, &chan_a);
+	zassert_ok(zbus_sub_wait(&drop_oldest_sub, &chan, K_NO_WAIT));
+	zassert_equal_ptr(chan, &chan_b);
+	zassert_equal(zbus_sub_wait(&drop_oldest_sub, &chan, K_NO_WAIT), -ENOMSG);
+
+	zbus_dispatch_stats_get(&stats);
+	zassert_equal(stats.events, 3);
+	zassert_equal(stats.dropped, 1);
+	zassert_equal(stats.overwritten, 1);
+}
+
+ZTEST(async_dispatch, test_dispatch_queue_full)
+{
+	struct value_msg msg = {.value = 5};
+	struct zbus_dispatch_stats stats;
+
+	for (int i = 0; i < CONFIG_ZBUS_ASYNC_DISPATCH_QUEUE_SIZE; i++) {
+		publish(&chan_b, i);
+	}
+
+	zassert_equal(zbus_chan_pub(&chan_b, &msg, K_NO_WAIT), -ENOMSG);
+	zassert_equal(zbus_chan_pub(&chan_b, &msg, K_MSEC(10)), 0);
+	k_msleep(10);
+
+	zbus_dispatch_stats_get(&stats);
+	zassert_equal(stats.events, CONFIG_ZBUS_ASYNC_DISPATCH_QUEUE_SIZE + 1);
+	zassert_equal(stats.rejected, 1);
+
+	zbus_dispatch_stats_reset();
+	zbus_dispatch_stats_get(&stats);
+	zassert_equal(stats.events, 0);
+	zassert_equal(stats.latency_max, 0);
+}
+
+ZTEST(async_dispatch, test_dispatcher_publish)
+{
+	struct zbus_dispatch_stats stats;
+
+	/* Once the dispatcher took this one, its listener fills the queue */
+	publish(&chan_c, 7);
+	for (int i = 0; i < CONFIG_ZBUS_ASYNC_DISPATCH_QUEUE_SIZE - 1; i++) {
+		publish(&chan_b, i);
+	}
+	k_msleep(10);
+
+	/* The dispatcher did not wait for itself */
+	zassert_equal(fwd_err[0], 0);
+	zassert_equal(fwd_err[1], -ENOMSG);
+
+	zbus_dispatch_stats_get(&stats);
+	zassert_equal(stats.events, CONFIG_ZBUS_ASYNC_DISPATCH_QUEUE_SIZE + 1);
+	zassert_equal(stats.rejected, 1);
+}
+
+static void async_dispatch_before(void *fixture)
+{
+	const struct zbus_channel *chan;
+
+	ARG_UNUSED(fixture);
+
+	while (zbus_sub_wait(&drop_new_sub, &chan, K_NO_WAIT) == 0) {
+	}
+	while (zbus_sub_wait(&drop_oldest_sub, &chan, K_NO_WAIT) == 0) {
+	}
+
+	lis_count = 0;
+	zbus_dispatch_stats_reset();
+}
+
+ZTEST_SUITE(async_dispatch, NULL, NULL, async_dispatch_before, NULL, NULL);
@@ -0,0 +1,324 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/ztest.h>
+
+#define FRAME_SIZE 1024
+#define POOL_SIZE  3
+
+struct frame_msg {
+	uint32_t seq;
+	uint8_t data[FRAME_SIZE];
+};
+
+struct state_msg {
+	uint32_t a;
+	uint32_t b;
+	uint32_t c;
+};
+
+static bool frame_validator(const void *msg, size_t msg_size)
+{
+	return ((const struct frame_msg *)msg)->seq != UINT32_MAX;
+}
+
+ZBUS_LOAN_CHAN_DEFINE(frame_chan,	/* Name */
+		      struct frame_msg, /* Message type */
+
+		      frame_validator,				   /* Validator */
+		      NULL,					   /* User data */
+		      ZBUS_OBSERVERS(frame_lis, frame_sub, copy_sub), /* observers */
+		      ZBUS_MSG_INIT(.seq = 7),			   /* Initial value */
+		      POOL_SIZE					   /* Pool size */
+);
+
+ZBUS_LATEST_CHAN_DEFINE(state_chan,	  /* Name */
+			struct state_msg, /* Message type */
+
+			NULL,				  /* Validator */
+			NULL,				  /* User data */
+			ZBUS_OBSERVERS(state_lis),	  /* observers */
+			ZBUS_MSG_INIT(.a = 1, .b = 1, .c = 1), /* Initial value */
+			3				  /* Buffers */
+);
+
+ZBUS_LOAN_CHAN_DEFINE(slow_chan,	    /* Name */
+		      struct state_msg, /* Message type */
+
+		      NULL,		       /* Validator */
+		      NULL,		       /* User data */
+		      ZBUS_OBSERVERS(slow_sub), /* observers */
+		      ZBUS_MSG_INIT(0),	       /* Initial value */
+		      POOL_SIZE		       /* Pool size */
+);
+
+ZBUS_CHAN_DEFINE(plain_chan,	    /* Name */
+		 struct state_msg, /* Message type */
+
+		 NULL,			   /* Validator */
+		 NULL,			   /* User data */
+		 ZBUS_OBSERVERS(frame_sub), /* observers */
+		 ZBUS_MSG_INIT(0)	   /* Initial value */
+);
+
+static uint32_t listener_seq;
+
+static void frame_cb(const struct zbus_channel *chan)
+{
+	const struct frame_msg *msg = zbus_chan_const_msg(chan);
+
+	listener_seq = msg->seq;
+}
+
+ZBUS_LISTENER_DEFINE(frame_lis, frame_cb);
+ZBUS_MSG_SUBSCRIBER_DEFINE(frame_sub, 4);
+ZBUS_SUBSCRIBER_DEFINE(copy_sub, 4);
+ZBUS_MSG_SUBSCRIBER_DEFINE(slow_sub, 1);
+
+static struct state_msg state_seen;
+
+static void state_cb(const struct zbus_channel *chan)
+{
+	zassert_ok(zbus_chan_read(chan, &state_seen, K_NO_WAIT));
+}
+
+ZBUS_LISTENER_DEFINE(state_lis, state_cb);
+
+static void drain(void)
+{
+	struct zbus_msg_ref ref;
+	const struct zbus_channel *chan;
+
+	while (zbus_sub_wait_msg(&frame_sub, &ref, K_NO_WAIT) == 0) {
+		zbus_chan_release(ref.chan, ref.msg);
+	}
+	while (zbus_sub_wait(&copy_sub, &chan, K_NO_WAIT) == 0) {
+	}
+	while (zbus_sub_wait_msg(&slow_sub, &ref, K_NO_WAIT) == 0) {
+		zbus_chan_release(ref.chan, ref.msg);
+	}
+}
+
+static int publish_frame(uint32_t seq)
+{
+	struct frame_msg *msg;
+	int err;
+
+	err = zbus_chan_loan(&frame_chan, (void **)&msg, K_NO_WAIT);
+	if (err) {
+		return err;
+	}
+
+	msg->seq = seq;
+	memset(msg->data, seq, sizeof(msg->data));
+
+	return zbus_chan_pub_loan(&frame_chan, msg, K_NO_WAIT);
+}
+
+ZTEST(msg_loan, test_initial_message)
+{
+	struct frame_msg copy;
+	const void *msg;
+
+	/* The initial message is read until a loan is published */
+	zassert_equal(zbus_chan_ref(&frame_chan, &msg, K_NO_WAIT), -ENODATA);
+	zassert_ok(zbus_chan_read(&frame_chan, &copy, K_NO_WAIT));
+	zassert_equal(copy.seq, 7);
+}
+
+ZTEST(msg_loan, test_loan_publish)
+{
+	const struct zbus_channel *chan;
+	struct zbus_msg_ref ref;
+	struct frame_msg copy;
+
+	zassert_ok(publish_frame(1));
+	zassert_equal(listener_seq, 1);
+
+	/* Message reference subscribers get the published buffer itself */
+	zassert_ok(zbus_sub_wait_msg(&frame_sub, &ref, K_NO_WAIT));
+	zassert_equal_ptr(ref.chan, &frame_chan);
+	zassert_equal(((const struct frame_msg *)ref.msg)->seq, 1);
+	zassert_equal_ptr(ref.msg, zbus_chan_const_msg(&frame_chan));
+
+	/* Other subscribers read a copy */
+	zassert_ok(zbus_sub_wait(&copy_sub, &chan, K_NO_WAIT));
+	zassert_ok(zbus_chan_read(chan, &copy, K_NO_WAIT));
+	zassert_equal(copy.seq, 1);
+	zassert_equal(copy.data[FRAME_SIZE - 1], 1);
+
+	/* The referenced message outlives the next publication */
+	zassert_ok(publish_frame(2));
+	zassert_equal(((const struct frame_msg *)ref.msg)->seq, 1);
+	zbus_chan_release(ref.chan, ref.msg);
+
+	zassert_equal(zbus_sub_wait(&frame_sub, &chan, K_NO_WAIT), -EINVAL);
+	zassert_equal(zbus_sub_wait_msg(&copy_sub, &ref, K_NO_WAIT), -EINVAL);
+}
+
+ZTEST(msg_loan, test_loan_pool)
+{
+	struct zbus_msg_ref ref;
+	struct frame_msg frame = {.seq = 10};
+	const void *msg;
+	void *bufs[POOL_SIZE];
+	int i;
+
+	zassert_ok(publish_frame(3));
+	drain();
+
+	/* The channel keeps the last message */
+	for (i = 0; i < POOL_SIZE - 1; i++) {
+		zassert_ok(zbus_chan_loan(&frame_chan, &bufs[i], K_NO_WAIT));
+	}
+	zassert_equal(zbus_chan_loan(&frame_chan, &bufs[i], K_NO_WAIT), -ENOMEM);
+	for (i = 0; i < POOL_SIZE - 1; i++) {
+		zbus_chan_release(&frame_chan, bufs[i]);
+	}
+
+	/* References held by readers keep buffers from the pool */
+	zassert_ok(zbus_chan_ref(&frame_chan, &msg, K_NO_WAIT));
+	zassert_ok(zbus_chan_pub(&frame_chan, &frame, K_NO_WAIT));
+	zassert_ok(zbus_chan_loan(&frame_chan, &bufs[0], K_NO_WAIT));
+	zassert_equal(zbus_chan_pub(&frame_chan, &frame, K_NO_WAIT), -ENOMEM);
+
+	zbus_chan_release(&frame_chan, bufs[0]);
+	zbus_chan_release(&frame_chan, msg);
+	drain();
+
+	/* So do the references queued to subscribers */
+	zassert_ok(publish_frame(5));
+	zassert_ok(publish_frame(6));
+	zassert_ok(publish_frame(7));
+	zassert_equal(publish_frame(8), -ENOMEM);
+	drain();
+	zassert_ok(publish_frame(4));
+	zassert_ok(zbus_sub_wait_msg(&frame_sub, &ref, K_NO_WAIT));
+	zassert_equal(((const struct frame_msg *)ref.msg)->seq, 4);
+	zbus_chan_release(ref.chan, ref.msg);
+
+	/* Invalid messages are not published */
+	frame.seq = UINT32_MAX;
+	zassert_equal(zbus_chan_pub(&frame_chan, &frame, K_NO_WAIT), -ENOMSG);
+	zassert_equal(listener_seq, 4);
+}
+
+ZTEST(msg_loan, test_loan_notify_error)
+{
+	struct state_msg *msg;
+	struct zbus_msg_ref ref;
+	const void *current;
+	void *bufs[POOL_SIZE];
+	int i;
+
+	/* The first message fills the subscriber queue, the second one is not queued */
+	zassert_ok(zbus_chan_loan(&slow_chan, (void **)&msg, K_NO_WAIT));
+	msg->a = 1;
+	zassert_ok(zbus_chan_pub_loan(&slow_chan, msg, K_NO_WAIT));
+	zassert_ok(zbus_chan_loan(&slow_chan, (void **)&msg, K_NO_WAIT));
+	msg->a = 2;
+	zassert_not_equal(zbus_chan_pub_loan(&slow_chan, msg, K_NO_WAIT), 0);
+
+	/* The message was published all the same, and the reference consumed */
+	zassert_ok(zbus_chan_ref(&slow_chan, &current, K_NO_WAIT));
+	zassert_equal(((const struct state_msg *)current)->a, 2);
+	zbus_chan_release(&slow_chan, current);
+
+	zassert_ok(zbus_sub_wait_msg(&slow_sub, &ref, K_NO_WAIT));
+	zassert_equal(((const struct state_msg *)ref.msg)->a, 1);
+	zbus_chan_release(ref.chan, ref.msg);
+
+	/* Only the channel's message is still taken from the pool */
+	for (i = 0; i < POOL_SIZE - 1; i++) {
+		zassert_ok(zbus_chan_loan(&slow_chan, &bufs[i], K_NO_WAIT));
+	}
+	zassert_equal(zbus_chan_loan(&slow_chan, &bufs[i], K_NO_WAIT), -ENOMEM);
+	for (i = 0; i < POOL_SIZE - 1; i++) {
+		zbus_chan_release(&slow_chan, bufs[i]);
+	}
+
+	zassert_ok(zbus_chan_ref(&slow_chan, &current, K_NO_WAIT));
+	zassert_equal(((const struct state_msg *)current)->a, 2);
+	zbus_chan_release(&slow_chan, current);
+}
+
+ZTEST(msg_loan, test_plain_channel)
+{
+	struct state_msg state = {.a = 5};
+	struct zbus_msg_ref ref;
+	void *buf;
+
+	zassert_equal(zbus_chan_loan(&plain_chan, &buf, K_NO_WAIT), -ENOTSUP);
+	zassert_equal(zbus_chan_pub_loan(&plain_chan, &state, K_NO_WAIT), -ENOTSUP);
+
+	/* Message reference subscribers observe copying channels too */
+	zassert_ok(zbus_chan_pub(&plain_chan, &state, K_NO_WAIT));
+	zassert_ok(zbus_sub_wait_msg(&frame_sub, &ref, K_NO_WAIT));
+	zassert_equal_ptr(ref.chan, &plain_chan);
+	zassert_is_null(ref.msg);
+	zbus_chan_release(ref.chan, ref.msg);
+}
+
+#define WRITER_STACK_SIZE 1024
+
+static K_THREAD_STACK_DEFINE(writer_stack, WRITER_STACK_SIZE);
+static struct k_thread writer_thread;
+static volatile bool writer_done;
+
+static void writer(void *p1, void *p2, void *p3)
+{
+	struct state_msg state;
+
+	for (uint32_t i = 2; i < 2000; i++) {
+		state.a = i;
+		state.b = i;
+		state.c = i;
+		zassert_ok(zbus_chan_pub(&state_chan, &state, K_FOREVER));
+		if ((i % 16) == 0) {
+			k_yield();
+		}
+	}
+
+	writer_done = true;
+}
+
+ZTEST(msg_loan, test_latest_value)
+{
+	struct state_msg state;
+	uint32_t last = 0;
+
+	zassert_ok(zbus_chan_read(&state_chan, &state, K_NO_WAIT));
+	zassert_equal(state.a, 1);
+	zassert_equal(state.c, 1);
+
+	k_thread_create(&writer_thread, writer_stack, WRITER_STACK_SIZE, writer, NULL, NULL, NULL,
+			k_thread_priority_get(k_current_get()), 0, K_NO_WAIT);
+
+	/* Reads are never torn and never go back in time */
+	while (!writer_done) {
+		zassert_ok(zbus_chan_read(&state_chan, &state, K_NO_WAIT));
+		zassert_true((state.a == state.b) && (state.b == state.c), "torn read");
+		zassert_true(state.a >= last, "older message read");
+		last = state.a;
+		k_yield();
+	}
+
+	k_thread_join(&writer_thread, K_FOREVER);
+
+	zassert_ok(zbus_chan_read(&state_chan, &state, K_NO_WAIT));
+	zassert_equal(state.a, 1999);
+	zassert_equal(state_seen.a, 1999);
+}
+
+static void msg_loan_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	drain();
+}
+
+ZTEST_SUITE(msg_loan, NULL, NULL, NULL, msg_loan_after, NULL);
@@ -97,6 +97,10 @@ void check_rbnode(struct rbnode *node, int blacks_above)
 		struct rbnode *ch = z_rb_child(node, side);
 
 		if (ch) {
+#ifdef CONFIG_RB_PARENT_POINTERS
+			_CHECK(ch->parent == node);
+#endif
+
 			/* Basic tree requirement */
 			if (side == 0) {
 				_CHECK(node_lessthan(ch, node));
@@ -125,6 +129,9 @@ void check_rb(void)
 
 	_CHECK(tree.root);
 	_CHECK(z_rb_is_black(tree.root));
+#ifdef CONFIG_RB_PARENT_POINTERS
+	_CHECK(tree.root->parent == NULL);
+#endif
 
 	check_rbnode(tree.root, 0);
 }
@@ -277,4 +284,172 @@ ZTEST(rbtree_api, test_rb_get_minmax)
 	zassert_true(rb_get_max(&tree) == &nodes[7], "the tree is invalid");
 }
 
+/**
+ * @brief Test building trees from sorted nodes
+ *
+ * @details Build trees of all sizes up to MAX_NODES from the sorted
+ * array of nodes, check them, then remove and insert nodes again.
+ *
+ * @ingroup lib_rbtree_tests
+ *
+ * @see rb_build_sorted()
+ */
+ZTEST(rbtree_api, test_rb_build_sorted)
+{
+	static struct rbnode *sorted[MAX_NODES];
+	int size, i;
+
+	for (i = 0; i < MAX_NODES; i++) {
+		sorted[i] = &nodes[i];
+	}
+
+	for (size = 0; size <= MAX_NODES; size++) {
+		(void)memset(&tree, 0, sizeof(tree));
+		tree.lessthan_fn = node_lessthan;
+		(void)memset(nodes, 0, sizeof(nodes));
+		(void)memset(node_mask, 0, sizeof(node_mask));
+
+		rb_build_sorted(&tree, sorted, size);
+		for (i = 0; i < size; i++) {
+			set_node_mask(i, 1);
+		}
+
+		/* A balanced tree of N nodes is log2(N) + 1 levels deep */
+		zassert_true(size == 0 || (1 << (tree.max_depth - 1)) <= size);
+		zassert_true((1 << tree.max_depth) > size);
+		check_tree(size);
+
+		for (i = 0; i < size; i += 3) {
+			rb_remove(&tree, &nodes[i]);
+			set_node_mask(i, 0);
+		}
+		check_tree(size);
+
+		for (i = 0; i < size; i += 3) {
+			checked_insert(&tree, &nodes[i]);
+			set_node_mask(i, 1);
+		}
+		check_tree(size);
+	}
+}
+
+/* Node counting the nodes of its subtree, for order statistics */
+struct aug_node {
+	struct rbnode node;
+	int size;
+};
+
+static struct aug_node aug_nodes[MAX_NODES];
+
+static int aug_size(struct rbnode *n)
+{
+	return n ? CONTAINER_OF(n, struct aug_node, node)->size : 0;
+}
+
+static void aug_update(struct rbnode *n)
+{
+	CONTAINER_OF(n, struct aug_node, node)->size =
+		1 + aug_size(rb_child(n, 0)) + aug_size(rb_child(n, 1));
+}
+
+static bool aug_lessthan(struct rbnode *a, struct rbnode *b)
+{
+	return a < b;
+}
+
+static int check_aug(struct rbnode *n)
+{
+	int size;
+
+	if (!n) {
+		return 0;
+	}
+
+	size = 1 + check_aug(rb_child(n, 0)) + check_aug(rb_child(n, 1));
+	_CHECK(aug_size(n) == size);
+
+	return size;
+}
+
+/* Finds the node of given in-order rank in O(log2(N)) */
+static struct rbnode *aug_select(struct rbtree *t, int rank)
+{
+	struct rbnode *n = t->root;
+
+	while (n) {
+		int left = aug_size(rb_child(n, 0));
+
+		if (rank == left) {
+			break;
+		}
+
+		if (rank < left) {
+			n = rb_child(n, 0);
+		} else {
+			rank -= left + 1;
+			n = rb_child(n, 1);
+		}
+	}
+
+	return n;
+}
+
+/**
+ * @brief Test the augmentation callback
+ *
+ * @details Maintain the size of the subtree of each node through
+ * random insertions, removals and a bulk build, checking the sizes
+ * and selecting nodes by rank with them.
+ *
+ * @ingroup lib_rbtree_tests
+ *
+ * @see rb_insert(), rb_remove(), rb_build_sorted()
+ */
+ZTEST(rbtree_api, test_rb_augment)
+{
+	static struct rbnode *sorted[MAX_NODES];
+	struct rbtree aug_tree = {
+		.lessthan_fn = aug_lessthan,
+		.augment_fn = aug_update,
+	};
+	bool in_tree[MAX_NODES] = { false };
+	int i, j, rank, count = 0;
+
+	(void)memset(aug_nodes, 0, sizeof(aug_nodes));
+
+	for (i = 0; i < 8 * MAX_NODES; i++) {
+		j = next_rand_mod(MAX_NODES);
+
+		if (in_tree[j]) {
+			rb_remove(&aug_tree, &aug_nodes[j].node);
+			count--;
+		} else {
+			rb_insert(&aug_tree, &aug_nodes[j].node);
+			count++;
+		}
+		in_tree[j] = !in_tree[j];
+
+		zassert_equal(check_aug(aug_tree.root), count);
+	}
+
+	for (i = 0, rank = 0; i < MAX_NODES; i++) {
+		if (in_tree[i]) {
+			zassert_equal(aug_select(&aug_tree, rank),
+				      &aug_nodes[i].node);
+			rank++;
+		}
+	}
+
+	for (i = 0; i < MAX_NODES; i++) {
+		sorted[i] = &aug_nodes[i].node;
+	}
+
+	rb_build_sorted(&aug_tree, sorted, MAX_NODES);
+	zassert_equal(check_aug(aug_tree.root), MAX_NODES);
+
+	for (i = 0; i < MAX_NODES; i++) {
+		zassert_equal(aug_select(&aug_tree, i), &aug_nodes[i].node);
+	}
+}
+
 ZTEST_SUITE(rbtree_api, NULL, NULL, NULL, NULL, NULL);